@@ -0,0 +1,269 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef __tb_debug__
+#   define tb_flat_hash_map_test_dump(h)        tb_flat_hash_map_dump(h)
+#else
+#   define tb_flat_hash_map_test_dump(h)
+#endif
+
+// the default item count for benchmark
+#define TB_DEMO_ITEM_COUNT                      (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the map operations type for benchmark
+typedef struct __tb_demo_map_op_t
+{
+    // the map name
+    tb_char_t const*        name;
+
+    // init
+    tb_iterator_ref_t       (*init)(tb_size_t size, tb_element_t element_name, tb_element_t element_data);
+
+    // exit
+    tb_void_t               (*exit)(tb_iterator_ref_t map);
+
+    // get
+    tb_pointer_t            (*get)(tb_iterator_ref_t map, tb_cpointer_t name);
+
+    // insert
+    tb_size_t               (*insert)(tb_iterator_ref_t map, tb_cpointer_t name, tb_cpointer_t data);
+
+    // remove
+    tb_void_t               (*remove)(tb_iterator_ref_t map, tb_cpointer_t name);
+
+}tb_demo_map_op_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_flat_hash_map_test_s2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(8, tb_element_str(tb_true), tb_element_long());
+    tb_assert_and_check_return(hash);
+
+    // insert
+    tb_size_t i = 0;
+    tb_char_t s[256];
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_flat_hash_map_insert(hash, s, (tb_pointer_t)i);
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 1000);
+
+    // replace
+    tb_flat_hash_map_insert(hash, "10", (tb_pointer_t)10000);
+    tb_assert(tb_flat_hash_map_size(hash) == 1000);
+    tb_assert((tb_size_t)tb_flat_hash_map_get(hash, "10") == 10000);
+
+    // get
+    for (i = 0; i < 1000; i++)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_assert(tb_flat_hash_map_find(hash, s) != tb_iterator_tail(hash));
+        tb_assert(i == 10 || (tb_size_t)tb_flat_hash_map_get(hash, s) == i);
+    }
+    tb_assert(tb_flat_hash_map_find(hash, "1000") == tb_iterator_tail(hash));
+
+    // remove
+    for (i = 0; i < 1000; i += 2)
+    {
+        tb_snprintf(s, sizeof(s), "%lu", i);
+        tb_flat_hash_map_remove(hash, s);
+        tb_assert(tb_flat_hash_map_find(hash, s) == tb_iterator_tail(hash));
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 500);
+
+    // walk
+    tb_size_t count = 0;
+    tb_for_all (tb_hash_map_item_ref_t, item, hash)
+    {
+        if ((tb_size_t)tb_atoi((tb_char_t const*)item->name) & 1) count++;
+    }
+    tb_assert(count == 500);
+    tb_trace_i("s2i: size: %lu, maxn: %lu", tb_flat_hash_map_size(hash), tb_flat_hash_map_maxn(hash));
+
+    // clear
+    tb_flat_hash_map_clear(hash);
+    tb_assert(!tb_flat_hash_map_size(hash) && tb_iterator_head(hash) == tb_iterator_tail(hash));
+    tb_flat_hash_map_test_dump(hash);
+
+    // exit hash
+    tb_flat_hash_map_exit(hash);
+}
+static tb_void_t tb_flat_hash_map_test_m2m_func()
+{
+    // init hash, uses the element functions
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(0, tb_element_mem(16, tb_null, tb_null), tb_element_mem(16, tb_null, tb_null));
+    tb_assert_and_check_return(hash);
+
+    // insert
+    tb_size_t i = 0;
+    tb_byte_t item[16];
+    for (i = 0; i < 1000; i++)
+    {
+        tb_memset_u32(item, (tb_uint32_t)i, 4);
+        tb_flat_hash_map_insert(hash, item, item);
+    }
+
+    // get and remove
+    for (i = 0; i < 1000; i++)
+    {
+        tb_memset_u32(item, (tb_uint32_t)i, 4);
+        tb_assert(!tb_memcmp(item, tb_flat_hash_map_get(hash, item), sizeof(item)));
+        if (i & 1) tb_flat_hash_map_remove(hash, item);
+    }
+    tb_assert(tb_flat_hash_map_size(hash) == 500);
+    tb_trace_i("m2m: size: %lu, maxn: %lu", tb_flat_hash_map_size(hash), tb_flat_hash_map_maxn(hash));
+
+    // exit hash
+    tb_flat_hash_map_exit(hash);
+}
+static tb_bool_t tb_flat_hash_map_test_remove_pred(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
+{
+    return ((tb_size_t)((tb_hash_map_item_ref_t)item)->name % 3) == 0;
+}
+static tb_void_t tb_flat_hash_map_test_i2i_func()
+{
+    // init hash
+    tb_flat_hash_map_ref_t hash = tb_flat_hash_map_init(0, tb_element_size(), tb_element_size());
+    tb_assert_and_check_return(hash);
+
+    // insert and remove many times to make deleted slots
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (j = 0; j < 10; j++)
+    {
+        for (i = 0; i < 10000; i++) tb_flat_hash_map_insert(hash, (tb_pointer_t)(i + j * 10000), (tb_pointer_t)i);
+        for (i = 0; i < 10000; i++)
+        {
+            tb_assert((tb_size_t)tb_flat_hash_map_get(hash, (tb_pointer_t)(i + j * 10000)) == i);
+            tb_flat_hash_map_remove(hash, (tb_pointer_t)(i + j * 10000));
+        }
+        tb_assert(!tb_flat_hash_map_size(hash));
+    }
+
+    // insert items
+    for (i = 0; i < 10000; i++) tb_flat_hash_map_insert(hash, (tb_pointer_t)i, (tb_pointer_t)(i + 1));
+
+    // remove items with the iterator
+    tb_remove_if(hash, tb_flat_hash_map_test_remove_pred, tb_null);
+    tb_assert(tb_flat_hash_map_size(hash) == 10000 - 3334);
+    for (i = 0; i < 10000; i++)
+    {
+        tb_assert(((i % 3) != 0) == (tb_flat_hash_map_find(hash, (tb_pointer_t)i) != tb_iterator_tail(hash)));
+    }
+    tb_trace_i("i2i: size: %lu, maxn: %lu", tb_flat_hash_map_size(hash), tb_flat_hash_map_maxn(hash));
+
+    // exit hash
+    tb_flat_hash_map_exit(hash);
+}
+static tb_hong_t tb_flat_hash_map_test_perf(tb_demo_map_op_t const* op, tb_element_t element_name, tb_cpointer_t const* names, tb_size_t count, tb_hong_t* ptimes)
+{
+    // init map
+    tb_iterator_ref_t map = op->init(0, element_name, tb_element_size());
+    tb_assert_and_check_return_val(map, -1);
+
+    // insert
+    tb_size_t i = 0;
+    tb_hong_t t = tb_mclock();
+    for (i = 0; i < count; i++) op->insert(map, names[i], (tb_pointer_t)i);
+    ptimes[0] = tb_mclock() - t;
+
+    // get the existing names
+    tb_size_t sum = 0;
+    t = tb_mclock();
+    for (i = 0; i < count; i++) sum += (tb_size_t)op->get(map, names[i]);
+    ptimes[1] = tb_mclock() - t;
+    tb_assert(sum == (tb_size_t)((tb_hize_t)count * (count - 1) / 2));
+
+    // get the missing names, we only insert the first half names again
+    op->exit(map);
+    map = op->init(0, element_name, tb_element_size());
+    tb_assert_and_check_return_val(map, -1);
+    for (i = 0; i < count / 2; i++) op->insert(map, names[i], (tb_pointer_t)i);
+    t = tb_mclock();
+    for (i = count / 2; i < count; i++) sum += (tb_size_t)op->get(map, names[i]);
+    ptimes[2] = tb_mclock() - t;
+
+    // remove
+    t = tb_mclock();
+    for (i = 0; i < count / 2; i++) op->remove(map, names[i]);
+    ptimes[3] = tb_mclock() - t;
+
+    // exit map
+    op->exit(map);
+    return ptimes[0] + ptimes[1] + ptimes[2] + ptimes[3];
+}
+static tb_void_t tb_flat_hash_map_test_benchmark(tb_size_t count)
+{
+    // the maps
+    static tb_demo_map_op_t s_ops[] =
+    {
+        {"hash_map",        tb_hash_map_init,       tb_hash_map_exit,       tb_hash_map_get,        tb_hash_map_insert,         tb_hash_map_remove}
+    ,   {"flat_hash_map",   tb_flat_hash_map_init,  tb_flat_hash_map_exit,  tb_flat_hash_map_get,   tb_flat_hash_map_insert,    tb_flat_hash_map_remove}
+    };
+
+    // make names
+    tb_size_t       i = 0;
+    tb_cpointer_t*  numbers = tb_nalloc_type(count, tb_cpointer_t);
+    tb_cpointer_t*  strings = tb_nalloc_type(count, tb_cpointer_t);
+    tb_char_t*      buffer = (tb_char_t*)tb_malloc(count * 16);
+    tb_assert_and_check_return(numbers && strings && buffer);
+    tb_random_reset(tb_true);
+    for (i = 0; i < count; i++)
+    {
+        // the random number, all names are unique
+        tb_size_t value = (i << 8) | (tb_random_value() & 0xff);
+        numbers[i] = (tb_cpointer_t)value;
+
+        // the random string
+        tb_snprintf(buffer + i * 16, 16, "%lx", value);
+        strings[i] = buffer + i * 16;
+    }
+
+    // done
+    tb_size_t j = 0;
+    for (j = 0; j < tb_arrayn(s_ops); j++)
+    {
+        // test the integer names
+        tb_hong_t times[4];
+        tb_hong_t total = tb_flat_hash_map_test_perf(&s_ops[j], tb_element_size(), numbers, count, times);
+        tb_trace_i("%14s: i2i: count: %lu, insert: %lld ms, get: %lld ms, miss: %lld ms, remove: %lld ms, total: %lld ms", s_ops[j].name, count, times[0], times[1], times[2], times[3], total);
+
+        // test the string names
+        total = tb_flat_hash_map_test_perf(&s_ops[j], tb_element_str(tb_true), strings, count, times);
+        tb_trace_i("%14s: s2i: count: %lu, insert: %lld ms, get: %lld ms, miss: %lld ms, remove: %lld ms, total: %lld ms", s_ops[j].name, count, times[0], times[1], times[2], times[3], total);
+    }
+
+    // exit names
+    tb_free(numbers);
+    tb_free(strings);
+    tb_free(buffer);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_container_flat_hash_map_main(tb_int_t argc, tb_char_t** argv)
+{
+    // test functions
+    tb_flat_hash_map_test_s2i_func();
+    tb_flat_hash_map_test_m2m_func();
+    tb_flat_hash_map_test_i2i_func();
+
+    // test performance
+    tb_flat_hash_map_test_benchmark(argv[1]? tb_atoi(argv[1]) : TB_DEMO_ITEM_COUNT);
+    return 0;
+}
@@ -10,6 +10,9 @@
 // the switch count
 #define COUNT       (10000000)
 
+// the items count of the remote test
+#define REMOTE_COUNT    (2000)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */ 
@@ -137,6 +140,99 @@ static tb_void_t tb_demo_coroutine_channel_perf(tb_size_t size)
     }
 }
 
+static tb_void_t tb_demo_coroutine_channel_remote_send(tb_cpointer_t priv)
+{
+    // check
+    tb_co_channel_ref_t channel = (tb_co_channel_ref_t)priv;
+
+    // init the io scheduler of this thread first, it will resume the coroutines from other threads
+    tb_coroutine_sleep(1);
+
+    // send the non-null items in order
+    tb_size_t i = 0;
+    for (i = 1; i <= REMOTE_COUNT; i++) tb_co_channel_send(channel, (tb_cpointer_t)i);
+}
+static tb_void_t tb_demo_coroutine_channel_remote_recv(tb_cpointer_t priv)
+{
+    // check
+    tb_co_channel_ref_t channel = (tb_co_channel_ref_t)priv;
+
+    // init the io scheduler of this thread first, it will resume the coroutines from other threads
+    tb_coroutine_sleep(1);
+
+    // recv and check the items
+    tb_size_t i = 0;
+    tb_size_t bad = 0;
+    for (i = 1; i <= REMOTE_COUNT; i++)
+    {
+        if ((tb_size_t)tb_co_channel_recv(channel) != i) bad++;
+    }
+
+    // trace
+    tb_trace_i("remote: got %lu, bad %lu", i - 1, bad);
+    if (bad) tb_trace_e("remote: %lu items have been received with the wrong data!", bad);
+}
+static tb_int_t tb_demo_coroutine_channel_remote_loop(tb_cpointer_t priv)
+{
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // start the sending coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_channel_remote_send, priv, 0);
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+    return 0;
+}
+
+/* the remote test
+ *
+ * the items are sent from the scheduler of other thread, 
+ * and the receiving coroutine must get the sent data after resuming the sending coroutine remotely
+ */
+static tb_void_t tb_demo_coroutine_channel_remote(tb_size_t size)
+{
+    // trace
+    tb_trace_i("remote: %lu", size);
+
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // init channel
+        tb_co_channel_ref_t channel = tb_co_channel_init(size, tb_null, 0);
+        tb_assert(channel);
+
+        // start the receiving coroutine
+        tb_coroutine_start(scheduler, tb_demo_coroutine_channel_remote_recv, channel, 0);
+
+        // start the sending thread with its own scheduler
+        tb_thread_ref_t thread = tb_thread_init(tb_null, tb_demo_coroutine_channel_remote_loop, channel, 0);
+        tb_assert(thread);
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+        // wait the sending thread
+        if (thread)
+        {
+            tb_thread_wait(thread, -1, tb_null);
+            tb_thread_exit(thread);
+        }
+
+        // exit channel 
+        tb_co_channel_exit(channel);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
@@ -146,6 +242,10 @@ tb_int_t tb_demo_coroutine_channel_main(tb_int_t argc, tb_char_t** argv)
     tb_demo_coroutine_channel_test(1);
     tb_demo_coroutine_channel_test(5);
 
+    tb_demo_coroutine_channel_remote(0);
+    tb_demo_coroutine_channel_remote(1);
+    tb_demo_coroutine_channel_remote(5);
+
     tb_demo_coroutine_channel_perf(0);
     tb_demo_coroutine_channel_perf(1);
     tb_demo_coroutine_channel_perf(10);
@@ -72,12 +72,23 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
         tb_socket_ref_t client = tb_null;
         while (1)
         {
-            // accept and start client connection
-            if ((client = tb_socket_accept(sock, tb_null)))
+            // accept it, we post the accept operation directly if the completion-based poller is used
+            client = tb_socket_accept(sock, tb_null);
+            if (!client)
             {
-                if (!tb_coroutine_start(tb_null, tb_demo_coroutine_client, client, 0)) break;
+                tb_poller_op_t op = {0};
+                op.code = TB_POLLER_OP_ACPT;
+                op.sock = sock;
+                if (tb_coroutine_post(&op))
+                {
+                    if (op.result < 0) break;
+                    client = op.acpt;
+                }
+                else if (tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, -1) <= 0) break;
             }
-            else if (tb_socket_wait(sock, TB_SOCKET_EVENT_ACPT, -1) <= 0) break;
+
+            // start client connection
+            if (client && !tb_coroutine_start(tb_null, tb_demo_coroutine_client, client, 0)) break;
         }
 
     } while (0);
@@ -92,8 +103,8 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
  */ 
 tb_int_t tb_demo_coroutine_echo_server_main(tb_int_t argc, tb_char_t** argv)
 {
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    // init scheduler, uses io_uring poller if be `echo_server iouring`
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init_with_poller((argv[1] && !tb_strcmp(argv[1], "iouring"))? TB_POLLER_TYPE_IOURING : TB_POLLER_TYPE_NONE);
     if (scheduler)
     {
         // start listening
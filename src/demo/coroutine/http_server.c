@@ -13,8 +13,8 @@
 // the timeout
 #define TB_DEMO_TIMEOUT     (-1)
 
-// the cpu-core count
-#define TB_DEMO_CPU         (1)
+// the cpu-core count, uses the processor count if be zero
+#define TB_DEMO_CPU         (0)
 
 // the stack size
 #define TB_DEMO_STACKSIZE   (8192 << 2)
@@ -445,7 +445,7 @@ static tb_void_t tb_demo_coroutine_client(tb_cpointer_t priv)
 }
 static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
 {
-    // TODO: fix thundering herd issues
+    // accept and start client connections, they will be stolen by other idle threads in the scheduler group
     tb_size_t       count = 0;
     tb_socket_ref_t client = tb_null;
     tb_socket_ref_t sock = (tb_socket_ref_t)priv;
@@ -463,23 +463,6 @@ static tb_void_t tb_demo_coroutine_listen(tb_cpointer_t priv)
     // trace
     tb_trace_d("[%#x]: listened %lu", tb_thread_self(), count);
 }
-static tb_int_t tb_demo_coroutine_worker(tb_cpointer_t priv)
-{
-    // init scheduler
-    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
-    if (scheduler)
-    {
-        // start coroutines
-        tb_coroutine_start(scheduler, tb_demo_coroutine_listen, priv, 0);
-
-        // run scheduler, enable exclusive mode if be only one cpu
-        tb_co_scheduler_loop(scheduler, TB_DEMO_CPU == 1);
-
-        // exit scheduler
-        tb_co_scheduler_exit(scheduler);
-    }
-    return 0;
-}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
@@ -512,14 +495,22 @@ tb_int_t tb_demo_coroutine_http_server_main(tb_int_t argc, tb_char_t** argv)
         // trace
         tb_trace_i("%s: %s", g_onlydata? "data" : "rootdir", g_rootdir);
 
-#if TB_DEMO_CPU > 1
-        // start workers for multi-threads
-        tb_size_t count = TB_DEMO_CPU - 1;
-        while (count--) tb_thread_init(tb_null, tb_demo_coroutine_worker, sock, 0);
-#endif
+        // init scheduler group
+        tb_co_scheduler_group_ref_t group = tb_co_scheduler_group_init(TB_DEMO_CPU);
+        if (group)
+        {
+            // trace
+            tb_trace_i("threads: %lu", tb_co_scheduler_group_size(group));
+
+            // start the listener coroutine
+            tb_co_scheduler_group_start(group, tb_demo_coroutine_listen, sock, 0);
 
-        // start worker
-        tb_demo_coroutine_worker(sock);
+            // run scheduler group
+            tb_co_scheduler_group_loop(group);
+
+            // exit scheduler group
+            tb_co_scheduler_group_exit(group);
+        }
 
     } while (0);
 
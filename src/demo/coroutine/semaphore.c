@@ -3,6 +3,26 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */ 
+
+// the race test: the waiting coroutines count and the waits count of each coroutine
+#define TB_DEMO_RACE_WAITERS        (16)
+#define TB_DEMO_RACE_WAITS          (1000)
+
+// the race test: the posting threads count and the posts count of each thread
+#define TB_DEMO_RACE_POSTERS        (2)
+#define TB_DEMO_RACE_POSTS          (5000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */ 
+
+// the acquired and timeout count of the race test
+static tb_atomic_t  g_acquired = 0;
+static tb_atomic_t  g_timeout = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */ 
@@ -43,11 +63,106 @@ static tb_void_t tb_demo_coroutine_semaphore_post_func(tb_cpointer_t priv)
     }
 }
 
+static tb_void_t tb_demo_coroutine_semaphore_race_wait(tb_cpointer_t priv)
+{
+    // check
+    tb_co_semaphore_ref_t semaphore = (tb_co_semaphore_ref_t)priv;
+    tb_assert(semaphore);
+
+    // wait it with the short timeout, it will race with the posts from other threads
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_RACE_WAITS; i++)
+    {
+        tb_long_t ok = tb_co_semaphore_wait(semaphore, 1 + (i % 3));
+        if (ok > 0) tb_atomic_fetch_and_inc(&g_acquired);
+        else if (!ok) tb_atomic_fetch_and_inc(&g_timeout);
+        else break;
+    }
+}
+static tb_int_t tb_demo_coroutine_semaphore_race_post(tb_cpointer_t priv)
+{
+    // check
+    tb_co_semaphore_ref_t semaphore = (tb_co_semaphore_ref_t)priv;
+    tb_assert(semaphore);
+
+    // post it from this thread
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_RACE_POSTS; i++)
+    {
+        tb_co_semaphore_post(semaphore, 1);
+        if (!(i & 7)) tb_usleep(500);
+    }
+    return 0;
+}
+
+/* the race test
+ *
+ * the units posted from other threads must not be lost if the waiting coroutines are timed out at the same time,
+ * and every waiting coroutine must be resumed only once.
+ */
+static tb_void_t tb_demo_coroutine_semaphore_race(tb_noarg_t)
+{
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    tb_assert_and_check_return(scheduler);
+
+    // init semaphore
+    tb_co_semaphore_ref_t semaphore = tb_co_semaphore_init(0);
+    tb_assert(semaphore);
+
+    // start the waiting coroutines
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_RACE_WAITERS; i++)
+        tb_coroutine_start(scheduler, tb_demo_coroutine_semaphore_race_wait, semaphore, 0);
+
+    // start the posting threads
+    tb_thread_ref_t posters[TB_DEMO_RACE_POSTERS];
+    for (i = 0; i < TB_DEMO_RACE_POSTERS; i++)
+        posters[i] = tb_thread_init(tb_null, tb_demo_coroutine_semaphore_race_post, semaphore, 0);
+
+    // run scheduler
+    tb_hong_t time = tb_mclock();
+    tb_co_scheduler_loop(scheduler, tb_true);
+
+    // wait the posting threads
+    for (i = 0; i < TB_DEMO_RACE_POSTERS; i++)
+    {
+        if (posters[i])
+        {
+            tb_thread_wait(posters[i], -1, tb_null);
+            tb_thread_exit(posters[i]);
+        }
+    }
+
+    // check the units, acquired + left == posted, and all waits are returned
+    tb_size_t acquired  = (tb_size_t)tb_atomic_get(&g_acquired);
+    tb_size_t timeout   = (tb_size_t)tb_atomic_get(&g_timeout);
+    tb_size_t left      = tb_co_semaphore_value(semaphore);
+    tb_size_t posted    = TB_DEMO_RACE_POSTERS * TB_DEMO_RACE_POSTS;
+    tb_size_t waits     = TB_DEMO_RACE_WAITERS * TB_DEMO_RACE_WAITS;
+    tb_trace_i("race: acquired: %lu, timeout: %lu, left: %lu, posted: %lu, %lld ms", acquired, timeout, left, posted, tb_mclock() - time);
+    if (acquired + left != posted) tb_trace_e("race: %lu units have been lost!", posted - acquired - left);
+    if (acquired + timeout != waits) tb_trace_e("race: %lu waits, but %lu waits have been returned!", waits, acquired + timeout);
+
+    // exit semaphore 
+    tb_co_semaphore_exit(semaphore);
+
+    // exit scheduler
+    tb_co_scheduler_exit(scheduler);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_coroutine_semaphore_main(tb_int_t argc, tb_char_t** argv)
 {
+    // the race test? e.g. demo coroutine_semaphore race
+    if (argv[1] && !tb_strcmp(argv[1], "race"))
+    {
+        tb_demo_coroutine_semaphore_race();
+        return 0;
+    }
+
     // init scheduler
     tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
     if (scheduler)
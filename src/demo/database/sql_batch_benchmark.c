@@ -0,0 +1,206 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the insert sql
+#define TB_DEMO_INSERT_SQL          "insert into test values(?, ?, ?)"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the database url
+static tb_char_t        g_url[TB_PATH_MAXN];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_database_sql_ref_t tb_demo_sql_batch_open(tb_char_t const* url)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_database_sql_ref_t   database = tb_null;
+    do
+    {
+        // init and open database
+        database = tb_database_sql_init(url);
+        tb_assert_and_check_break(database);
+        if (!tb_database_sql_open(database)) break;
+
+        // make the test table
+        if (!tb_database_sql_done(database, "drop table if exists test")) break;
+        if (!tb_database_sql_done(database, "create table test(id integer primary key, name text, value integer)")) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? exit database
+    if (!ok && database)
+    {
+        tb_database_sql_exit(database);
+        database = tb_null;
+    }
+    return database;
+}
+static tb_size_t tb_demo_sql_batch_count(tb_database_sql_ref_t database)
+{
+    // count rows
+    tb_size_t count = 0;
+    if (tb_database_sql_done(database, "select count(*) from test"))
+    {
+        tb_iterator_ref_t result = tb_database_sql_result_load(database, tb_true);
+        if (result)
+        {
+            tb_for_all_if (tb_iterator_ref_t, row, result, row)
+            {
+                tb_database_sql_value_t const* field = (tb_database_sql_value_t const*)tb_iterator_item(row, 0);
+                if (field) count = (tb_size_t)tb_database_sql_value_int64(field);
+            }
+            tb_database_sql_result_exit(database, result);
+        }
+    }
+    return count;
+}
+static tb_size_t tb_demo_sql_batch_insert(tb_database_sql_ref_t database, tb_database_sql_value_t const** columns, tb_size_t count)
+{
+    // insert rows one by one
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // load the cached statement
+        tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, TB_DEMO_INSERT_SQL);
+        tb_assert_and_check_break(statement);
+
+        // bind arguments
+        tb_database_sql_value_t list[3];
+        list[0] = columns[0][i];
+        list[1] = columns[1][i];
+        list[2] = columns[2][i];
+        if (!tb_database_sql_statement_bind(database, statement, list, tb_arrayn(list))) break;
+
+        // done it
+        if (!tb_database_sql_statement_done(database, statement)) break;
+    }
+    return i;
+}
+static tb_void_t tb_demo_sql_batch_test_row(tb_database_sql_value_t const** columns, tb_size_t count, tb_bool_t btransaction)
+{
+    // open database
+    tb_database_sql_ref_t database = tb_demo_sql_batch_open(g_url);
+    if (database)
+    {
+        // insert rows one by one, commit it for each row if not in transaction
+        tb_hong_t time = tb_mclock();
+        if (btransaction) tb_database_sql_begin(database);
+        tb_size_t done = tb_demo_sql_batch_insert(database, columns, count);
+        if (btransaction) tb_database_sql_commit(database);
+        time = tb_max(tb_mclock() - time, 1);
+
+        // trace
+        tb_trace_i("row%s: %lu rows, %lld rows/s, inserted: %lu", btransaction? " + transaction" : "", done, (tb_hong_t)done * 1000 / time, tb_demo_sql_batch_count(database));
+
+        // exit database
+        tb_database_sql_exit(database);
+    }
+}
+static tb_bool_t tb_demo_sql_batch_progress(tb_size_t done, tb_size_t total, tb_cpointer_t priv)
+{
+    // trace
+    tb_trace_d("batch: %lu/%lu", done, total);
+
+    // cancel it at the given row
+    tb_size_t cancel = (tb_size_t)priv;
+    return !cancel || done < cancel;
+}
+static tb_void_t tb_demo_sql_batch_test_batch(tb_database_sql_value_t const** columns, tb_size_t count)
+{
+    // open database
+    tb_database_sql_ref_t database = tb_demo_sql_batch_open(g_url);
+    if (database)
+    {
+        // load the cached statement
+        tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, TB_DEMO_INSERT_SQL);
+        if (statement)
+        {
+            // insert all rows in one batch
+            tb_hong_t time = tb_mclock();
+            tb_bool_t ok = tb_database_sql_statement_done_batch(database, statement, columns, 3, count, tb_demo_sql_batch_progress, tb_null);
+            time = tb_max(tb_mclock() - time, 1);
+
+            // trace
+            tb_trace_i("batch: %lu rows, %lld rows/s, ok: %d, inserted: %lu", count, (tb_hong_t)count * 1000 / time, ok, tb_demo_sql_batch_count(database));
+        }
+
+        // cancel it at the first progress, all rows will be rollbacked
+        if (tb_database_sql_done(database, "delete from test"))
+        {
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, TB_DEMO_INSERT_SQL);
+            tb_bool_t ok = statement && tb_database_sql_statement_done_batch(database, statement, columns, 3, count, tb_demo_sql_batch_progress, (tb_cpointer_t)1);
+
+            // trace
+            tb_trace_i("batch: canceled: %d, inserted: %lu", !ok, tb_demo_sql_batch_count(database));
+        }
+
+        // exit database
+        tb_database_sql_exit(database);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_database_sql_batch_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the row count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 200000;
+    count = tb_max(count, 1);
+
+    // make the database url
+    tb_size_t size = tb_directory_temporary(g_url, sizeof(g_url));
+    tb_snprintf(g_url + size, sizeof(g_url) - size, "/tbox_sql_batch.sqlite3");
+
+    // make the column values
+    tb_database_sql_value_t*    ids = tb_nalloc0_type(count, tb_database_sql_value_t);
+    tb_database_sql_value_t*    names = tb_nalloc0_type(count, tb_database_sql_value_t);
+    tb_database_sql_value_t*    values = tb_nalloc0_type(count, tb_database_sql_value_t);
+    tb_char_t*                  texts = (tb_char_t*)tb_malloc0_bytes(count * 16);
+    if (ids && names && values && texts)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            tb_char_t* text = texts + i * 16;
+            tb_snprintf(text, 16, "name_%lu", i);
+            tb_database_sql_value_set_int32(&ids[i], (tb_int32_t)i);
+            tb_database_sql_value_set_text(&names[i], text, 0);
+            tb_database_sql_value_set_int32(&values[i], (tb_int32_t)(i * 10));
+        }
+        tb_database_sql_value_t const* columns[] = {ids, names, values};
+
+        // test the current path: commit it for each row
+        tb_demo_sql_batch_test_row(columns, tb_max(count / 200, 1), tb_false);
+
+        // test the current path: insert rows one by one in the transaction
+        tb_demo_sql_batch_test_row(columns, count, tb_true);
+
+        // test the batch
+        tb_demo_sql_batch_test_batch(columns, count);
+    }
+
+    // exit the column values
+    if (ids) tb_free(ids);
+    if (names) tb_free(names);
+    if (values) tb_free(values);
+    if (texts) tb_free(texts);
+
+    // remove the database
+    tb_file_remove(g_url);
+    return 0;
+}
@@ -0,0 +1,295 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the row count of the test table
+#define TB_DEMO_ROW_COUNT           (1000)
+
+// the query sql
+#define TB_DEMO_QUERY_SQL           "select name, value from test where id = ?"
+
+// the thread count
+#define TB_DEMO_THREAD_COUNT        (8)
+
+// the coroutine count
+#define TB_DEMO_COROUTINE_COUNT     (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the database url
+static tb_char_t        g_url[TB_PATH_MAXN];
+
+// the query count of each thread or coroutine
+static tb_size_t        g_count = 0;
+
+// the failed query count
+static tb_atomic_t      g_failed = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_bool_t tb_demo_sql_pool_make(tb_char_t const* url)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_database_sql_ref_t   database = tb_null;
+    do
+    {
+        // init and open database
+        database = tb_database_sql_init(url);
+        tb_assert_and_check_break(database);
+        if (!tb_database_sql_open(database)) break;
+
+        // make the test table
+        if (!tb_database_sql_done(database, "drop table if exists test")) break;
+        if (!tb_database_sql_done(database, "create table test(id integer primary key, name text, value integer)")) break;
+
+        // insert rows
+        if (!tb_database_sql_begin(database)) break;
+        tb_size_t i = 0;
+        for (i = 0; i < TB_DEMO_ROW_COUNT; i++)
+        {
+            // load the cached statement
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, "insert into test values(?, ?, ?)");
+            tb_assert_and_check_break(statement);
+
+            // bind arguments
+            tb_char_t name[64];
+            tb_snprintf(name, sizeof(name), "name_%lu", i);
+            tb_database_sql_value_t list[3];
+            tb_database_sql_value_set_int32(&list[0], (tb_int32_t)i);
+            tb_database_sql_value_set_text(&list[1], name, 0);
+            tb_database_sql_value_set_int32(&list[2], (tb_int32_t)(i * 10));
+            if (!tb_database_sql_statement_bind(database, statement, list, tb_arrayn(list))) break;
+
+            // done it
+            if (!tb_database_sql_statement_done(database, statement)) break;
+        }
+        if (!tb_database_sql_commit(database) || i != TB_DEMO_ROW_COUNT) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // exit database
+    if (database) tb_database_sql_exit(database);
+    return ok;
+}
+static tb_bool_t tb_demo_sql_pool_query(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_size_t id)
+{
+    // bind argument
+    tb_database_sql_value_t value;
+    tb_database_sql_value_set_int32(&value, (tb_int32_t)id);
+    if (!tb_database_sql_statement_bind(database, statement, &value, 1)) return tb_false;
+
+    // done statement
+    if (!tb_database_sql_statement_done(database, statement)) return tb_false;
+
+    // load result
+    tb_bool_t           ok = tb_false;
+    tb_iterator_ref_t   result = tb_database_sql_result_load(database, tb_false);
+    if (result)
+    {
+        // check the value
+        tb_for_all_if (tb_iterator_ref_t, row, result, row)
+        {
+            tb_database_sql_value_t const* field = (tb_database_sql_value_t const*)tb_iterator_item(row, 1);
+            ok = field && tb_database_sql_value_int32(field) == (tb_int32_t)(id * 10);
+        }
+
+        // exit result
+        tb_database_sql_result_exit(database, result);
+    }
+    return ok;
+}
+static tb_void_t tb_demo_sql_pool_test_open(tb_size_t count)
+{
+    // query it with the new connection and statement every time
+    tb_size_t failed = 0;
+    tb_size_t i = 0;
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        tb_bool_t               ok = tb_false;
+        tb_database_sql_ref_t   database = tb_database_sql_init(g_url);
+        if (database && tb_database_sql_open(database))
+        {
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_init(database, TB_DEMO_QUERY_SQL);
+            if (statement)
+            {
+                ok = tb_demo_sql_pool_query(database, statement, i % TB_DEMO_ROW_COUNT);
+                tb_database_sql_statement_exit(database, statement);
+            }
+        }
+        if (database) tb_database_sql_exit(database);
+        if (!ok) failed++;
+    }
+    time = tb_max(tb_mclock() - time, 1);
+
+    // trace
+    tb_trace_i("open + prepare: %lu queries, %lld qps, failed: %lu", count, (tb_hong_t)count * 1000 / time, failed);
+}
+static tb_void_t tb_demo_sql_pool_test_prepare(tb_size_t count)
+{
+    // init and open database
+    tb_database_sql_ref_t database = tb_database_sql_init(g_url);
+    if (database && tb_database_sql_open(database))
+    {
+        // query it with the new statement every time
+        tb_size_t failed = 0;
+        tb_size_t i = 0;
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < count; i++)
+        {
+            tb_bool_t ok = tb_false;
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_init(database, TB_DEMO_QUERY_SQL);
+            if (statement)
+            {
+                ok = tb_demo_sql_pool_query(database, statement, i % TB_DEMO_ROW_COUNT);
+                tb_database_sql_statement_exit(database, statement);
+            }
+            if (!ok) failed++;
+        }
+        time = tb_max(tb_mclock() - time, 1);
+
+        // trace
+        tb_trace_i("prepare: %lu queries, %lld qps, failed: %lu", count, (tb_hong_t)count * 1000 / time, failed);
+    }
+    if (database) tb_database_sql_exit(database);
+}
+static tb_void_t tb_demo_sql_pool_done(tb_database_sql_pool_ref_t pool, tb_size_t count, tb_bool_t byield)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < count; i++)
+    {
+        // borrow connection
+        tb_bool_t               ok = tb_false;
+        tb_database_sql_ref_t   database = tb_database_sql_pool_borrow(pool, -1);
+        if (database)
+        {
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+            // let other coroutines wait for this connection
+            if (byield) tb_coroutine_yield();
+#endif
+
+            // query it with the cached statement
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, TB_DEMO_QUERY_SQL);
+            if (statement) ok = tb_demo_sql_pool_query(database, statement, i % TB_DEMO_ROW_COUNT);
+
+            // return connection
+            tb_database_sql_pool_return(pool, database);
+        }
+        if (!ok) tb_atomic_fetch_and_add(&g_failed, 1);
+    }
+}
+static tb_int_t tb_demo_sql_pool_thread(tb_cpointer_t priv)
+{
+    tb_demo_sql_pool_done((tb_database_sql_pool_ref_t)priv, g_count, tb_false);
+    return 0;
+}
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+static tb_void_t tb_demo_sql_pool_coroutine(tb_cpointer_t priv)
+{
+    tb_demo_sql_pool_done((tb_database_sql_pool_ref_t)priv, g_count, tb_true);
+}
+#endif
+static tb_void_t tb_demo_sql_pool_test_pool(tb_size_t count)
+{
+    // init pool
+    tb_database_sql_pool_ref_t pool = tb_database_sql_pool_init(g_url, TB_DEMO_THREAD_COUNT >> 1);
+    if (pool)
+    {
+        // query it in the current thread
+        tb_atomic_set0(&g_failed);
+        tb_hong_t time = tb_mclock();
+        tb_demo_sql_pool_done(pool, count, tb_false);
+        time = tb_max(tb_mclock() - time, 1);
+        tb_trace_i("pool + cache: %lu queries, %lld qps, failed: %ld", count, (tb_hong_t)count * 1000 / time, tb_atomic_get(&g_failed));
+
+        // query it in the threads, the threads are more than the connections
+        tb_size_t       i = 0;
+        tb_thread_ref_t threads[TB_DEMO_THREAD_COUNT] = {0};
+        tb_atomic_set0(&g_failed);
+        g_count = count / TB_DEMO_THREAD_COUNT;
+        time = tb_mclock();
+        for (i = 0; i < TB_DEMO_THREAD_COUNT; i++) threads[i] = tb_thread_init(tb_null, tb_demo_sql_pool_thread, pool, 0);
+        for (i = 0; i < TB_DEMO_THREAD_COUNT; i++) 
+        {
+            if (threads[i]) 
+            {
+                tb_thread_wait(threads[i], -1, tb_null);
+                tb_thread_exit(threads[i]);
+            }
+        }
+        time = tb_max(tb_mclock() - time, 1);
+        tb_trace_i("pool + cache: %lu threads, %lu connections, %lu queries, %lld qps, failed: %ld"
+            , TB_DEMO_THREAD_COUNT, tb_database_sql_pool_size(pool), g_count * TB_DEMO_THREAD_COUNT, (tb_hong_t)g_count * TB_DEMO_THREAD_COUNT * 1000 / time, tb_atomic_get(&g_failed));
+
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+        // query it in the coroutines, the coroutines are more than the connections
+        tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+        if (scheduler)
+        {
+            tb_atomic_set0(&g_failed);
+            g_count = count / TB_DEMO_COROUTINE_COUNT;
+            time = tb_mclock();
+            for (i = 0; i < TB_DEMO_COROUTINE_COUNT; i++) tb_coroutine_start(scheduler, tb_demo_sql_pool_coroutine, pool, 0);
+            tb_co_scheduler_loop(scheduler, tb_true);
+            tb_co_scheduler_exit(scheduler);
+            time = tb_max(tb_mclock() - time, 1);
+            tb_trace_i("pool + cache: %lu coroutines, %lu connections, %lu queries, %lld qps, failed: %ld"
+                , TB_DEMO_COROUTINE_COUNT, tb_database_sql_pool_size(pool), g_count * TB_DEMO_COROUTINE_COUNT, (tb_hong_t)g_count * TB_DEMO_COROUTINE_COUNT * 1000 / time, tb_atomic_get(&g_failed));
+        }
+#endif
+
+        // reap all idle connections
+        tb_database_sql_pool_timeout_set(pool, 0, 0);
+        tb_size_t reaped = tb_database_sql_pool_reap(pool);
+        tb_trace_i("pool: reaped: %lu, left: %lu", reaped, tb_database_sql_pool_size(pool));
+
+        // exit pool
+        tb_database_sql_pool_exit(pool);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_database_sql_pool_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the query count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 100000;
+    count = tb_max(count, TB_DEMO_COROUTINE_COUNT);
+
+    // make the database url
+    tb_size_t size = tb_directory_temporary(g_url, sizeof(g_url));
+    tb_snprintf(g_url + size, sizeof(g_url) - size, "/tbox_sql_pool.sqlite3");
+
+    // make the test table
+    if (!tb_demo_sql_pool_make(g_url))
+    {
+        tb_trace_e("make %s failed!", g_url);
+        return -1;
+    }
+
+    // test the current path: open and prepare it every time
+    tb_demo_sql_pool_test_open(tb_max(count / 50, 1));
+
+    // test the current path: prepare it every time
+    tb_demo_sql_pool_test_prepare(count);
+
+    // test the pool and the statement cache
+    tb_demo_sql_pool_test_pool(count);
+
+    // remove the database
+    tb_file_remove(g_url);
+    return 0;
+}
@@ -39,6 +39,11 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(libc_stdlib)
 ,   TB_DEMO_MAIN_ITEM(libc_wcstombs)
 ,   TB_DEMO_MAIN_ITEM(libc_mbstowcs)
+,   TB_DEMO_MAIN_ITEM(libc_string_benchmark)
+,   TB_DEMO_MAIN_ITEM(libc_dtoa)
+,   TB_DEMO_MAIN_ITEM(libc_dtoa_benchmark)
+,   TB_DEMO_MAIN_ITEM(libc_s10tod)
+,   TB_DEMO_MAIN_ITEM(libc_s10tod_benchmark)
 
     // libm
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
@@ -50,11 +55,14 @@ static tb_demo_t g_demo[] =
     // database
 #ifdef TB_CONFIG_MODULE_HAVE_DATABASE
 ,   TB_DEMO_MAIN_ITEM(database_sql)
+,   TB_DEMO_MAIN_ITEM(database_sql_pool_benchmark)
+,   TB_DEMO_MAIN_ITEM(database_sql_batch_benchmark)
 #endif
 
     // xml
 #ifdef TB_CONFIG_MODULE_HAVE_XML
 ,   TB_DEMO_MAIN_ITEM(xml_reader)
+,   TB_DEMO_MAIN_ITEM(xml_reader_benchmark)
 ,   TB_DEMO_MAIN_ITEM(xml_writer)
 ,   TB_DEMO_MAIN_ITEM(xml_document)
 #endif
@@ -79,6 +87,7 @@ static tb_demo_t g_demo[] =
 #endif
 ,   TB_DEMO_MAIN_ITEM(utils_base32)
 ,   TB_DEMO_MAIN_ITEM(utils_base64)
+,   TB_DEMO_MAIN_ITEM(utils_trace_benchmark)
 
     // hash
 #ifdef TB_CONFIG_MODULE_HAVE_HASH
@@ -106,6 +115,7 @@ static tb_demo_t g_demo[] =
 #ifdef TB_CONFIG_MODULE_HAVE_OBJECT
 ,   TB_DEMO_MAIN_ITEM(object_jcat)
 ,   TB_DEMO_MAIN_ITEM(object_json)
+,   TB_DEMO_MAIN_ITEM(object_json_benchmark)
 ,   TB_DEMO_MAIN_ITEM(object_bin)
 ,   TB_DEMO_MAIN_ITEM(object_xml)
 ,   TB_DEMO_MAIN_ITEM(object_bplist)
@@ -119,6 +129,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(stream_cache)
 ,   TB_DEMO_MAIN_ITEM(stream_charset)
 ,   TB_DEMO_MAIN_ITEM(stream_zip)
+,   TB_DEMO_MAIN_ITEM(stream_zip_benchmark)
+,   TB_DEMO_MAIN_ITEM(stream_mmap_benchmark)
 
     // string
 ,   TB_DEMO_MAIN_ITEM(string_string)
@@ -128,6 +140,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_check)
 ,   TB_DEMO_MAIN_ITEM(memory_fixed_pool)
 ,   TB_DEMO_MAIN_ITEM(memory_string_pool)
+,   TB_DEMO_MAIN_ITEM(memory_string_pool_benchmark)
 ,   TB_DEMO_MAIN_ITEM(memory_large_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_small_allocator)
 ,   TB_DEMO_MAIN_ITEM(memory_default_allocator)
@@ -136,9 +149,11 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(memory_queue_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_static_buffer)
 ,   TB_DEMO_MAIN_ITEM(memory_impl_static_fixed_pool)
+,   TB_DEMO_MAIN_ITEM(memory_allocator_benchmark)
 
     // network
 ,   TB_DEMO_MAIN_ITEM(network_dns)
+,   TB_DEMO_MAIN_ITEM(network_dns_resolver)
 ,   TB_DEMO_MAIN_ITEM(network_url)
 ,   TB_DEMO_MAIN_ITEM(network_ipv4)
 ,   TB_DEMO_MAIN_ITEM(network_ipv6)
@@ -148,6 +163,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(network_http)
 ,   TB_DEMO_MAIN_ITEM(network_whois)
 ,   TB_DEMO_MAIN_ITEM(network_cookies)
+,   TB_DEMO_MAIN_ITEM(network_cookies_benchmark)
+,   TB_DEMO_MAIN_ITEM(network_http_pool_benchmark)
 ,   TB_DEMO_MAIN_ITEM(network_impl_date)
 
     // platform
@@ -167,12 +184,15 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(platform_cache_time)
 ,   TB_DEMO_MAIN_ITEM(platform_environment)
 ,   TB_DEMO_MAIN_ITEM(platform_lock)
+,   TB_DEMO_MAIN_ITEM(platform_lock_benchmark)
 ,   TB_DEMO_MAIN_ITEM(platform_timer)
 ,   TB_DEMO_MAIN_ITEM(platform_ltimer)
+,   TB_DEMO_MAIN_ITEM(platform_ltimer_benchmark)
 ,   TB_DEMO_MAIN_ITEM(platform_event)
 ,   TB_DEMO_MAIN_ITEM(platform_semaphore)
 ,   TB_DEMO_MAIN_ITEM(platform_thread)
 ,   TB_DEMO_MAIN_ITEM(platform_thread_pool)
+,   TB_DEMO_MAIN_ITEM(platform_thread_pool_benchmark)
 ,   TB_DEMO_MAIN_ITEM(platform_thread_local)
 #ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
 ,   TB_DEMO_MAIN_ITEM(platform_context)
@@ -186,6 +206,7 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(container_stack)
 ,   TB_DEMO_MAIN_ITEM(container_vector)
 ,   TB_DEMO_MAIN_ITEM(container_hash_map)
+,   TB_DEMO_MAIN_ITEM(container_flat_hash_map)
 ,   TB_DEMO_MAIN_ITEM(container_hash_set)
 ,   TB_DEMO_MAIN_ITEM(container_queue)
 ,   TB_DEMO_MAIN_ITEM(container_circle_queue)
@@ -215,6 +236,8 @@ static tb_demo_t g_demo[] =
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_server)
 ,   TB_DEMO_MAIN_ITEM(coroutine_file_client)
 ,   TB_DEMO_MAIN_ITEM(coroutine_http_server)
+,   TB_DEMO_MAIN_ITEM(network_http_server)
+,   TB_DEMO_MAIN_ITEM(network_http_server_benchmark)
 ,   TB_DEMO_MAIN_ITEM(coroutine_spider)
 
     // stackless coroutine
@@ -45,12 +45,15 @@
 
 // database
 TB_DEMO_MAIN_DECL(database_sql);
+TB_DEMO_MAIN_DECL(database_sql_pool_benchmark);
+TB_DEMO_MAIN_DECL(database_sql_batch_benchmark);
 
 // regex
 TB_DEMO_MAIN_DECL(regex);
 
 // xml
 TB_DEMO_MAIN_DECL(xml_reader);
+TB_DEMO_MAIN_DECL(xml_reader_benchmark);
 TB_DEMO_MAIN_DECL(xml_writer);
 TB_DEMO_MAIN_DECL(xml_document);
 
@@ -61,6 +64,11 @@ TB_DEMO_MAIN_DECL(libc_string);
 TB_DEMO_MAIN_DECL(libc_stdlib);
 TB_DEMO_MAIN_DECL(libc_mbstowcs);
 TB_DEMO_MAIN_DECL(libc_wcstombs);
+TB_DEMO_MAIN_DECL(libc_string_benchmark);
+TB_DEMO_MAIN_DECL(libc_dtoa);
+TB_DEMO_MAIN_DECL(libc_dtoa_benchmark);
+TB_DEMO_MAIN_DECL(libc_s10tod);
+TB_DEMO_MAIN_DECL(libc_s10tod_benchmark);
 
 // libm
 TB_DEMO_MAIN_DECL(libm_float);
@@ -78,6 +86,7 @@ TB_DEMO_MAIN_DECL(utils_dump);
 TB_DEMO_MAIN_DECL(utils_option);
 TB_DEMO_MAIN_DECL(utils_base32);
 TB_DEMO_MAIN_DECL(utils_base64);
+TB_DEMO_MAIN_DECL(utils_trace_benchmark);
 
 // hash
 TB_DEMO_MAIN_DECL(hash_md5);
@@ -100,6 +109,7 @@ TB_DEMO_MAIN_DECL(other_charset);
 // object
 TB_DEMO_MAIN_DECL(object_jcat);
 TB_DEMO_MAIN_DECL(object_json);
+TB_DEMO_MAIN_DECL(object_json_benchmark);
 TB_DEMO_MAIN_DECL(object_bin);
 TB_DEMO_MAIN_DECL(object_xml);
 TB_DEMO_MAIN_DECL(object_xplist);
@@ -112,6 +122,7 @@ TB_DEMO_MAIN_DECL(stream_async_transfer);
 TB_DEMO_MAIN_DECL(stream_async_stream);
 TB_DEMO_MAIN_DECL(stream);
 TB_DEMO_MAIN_DECL(stream_zip);
+TB_DEMO_MAIN_DECL(stream_zip_benchmark);
 TB_DEMO_MAIN_DECL(stream_null);
 TB_DEMO_MAIN_DECL(stream_cache);
 TB_DEMO_MAIN_DECL(stream_charset);
@@ -119,6 +130,7 @@ TB_DEMO_MAIN_DECL(stream_async_stream_zip);
 TB_DEMO_MAIN_DECL(stream_async_stream_null);
 TB_DEMO_MAIN_DECL(stream_async_stream_cache);
 TB_DEMO_MAIN_DECL(stream_async_stream_charset);
+TB_DEMO_MAIN_DECL(stream_mmap_benchmark);
 
 // string
 TB_DEMO_MAIN_DECL(string_string);
@@ -128,6 +140,7 @@ TB_DEMO_MAIN_DECL(string_static_string);
 TB_DEMO_MAIN_DECL(memory_check);
 TB_DEMO_MAIN_DECL(memory_fixed_pool);
 TB_DEMO_MAIN_DECL(memory_string_pool);
+TB_DEMO_MAIN_DECL(memory_string_pool_benchmark);
 TB_DEMO_MAIN_DECL(memory_large_allocator);
 TB_DEMO_MAIN_DECL(memory_small_allocator);
 TB_DEMO_MAIN_DECL(memory_default_allocator);
@@ -136,9 +149,11 @@ TB_DEMO_MAIN_DECL(memory_buffer);
 TB_DEMO_MAIN_DECL(memory_queue_buffer);
 TB_DEMO_MAIN_DECL(memory_static_buffer);
 TB_DEMO_MAIN_DECL(memory_impl_static_fixed_pool);
+TB_DEMO_MAIN_DECL(memory_allocator_benchmark);
 
 // network
 TB_DEMO_MAIN_DECL(network_dns);
+TB_DEMO_MAIN_DECL(network_dns_resolver);
 TB_DEMO_MAIN_DECL(network_url);
 TB_DEMO_MAIN_DECL(network_ipv4);
 TB_DEMO_MAIN_DECL(network_ipv6);
@@ -148,16 +163,20 @@ TB_DEMO_MAIN_DECL(network_hwaddr);
 TB_DEMO_MAIN_DECL(network_http);
 TB_DEMO_MAIN_DECL(network_whois);
 TB_DEMO_MAIN_DECL(network_cookies);
+TB_DEMO_MAIN_DECL(network_cookies_benchmark);
+TB_DEMO_MAIN_DECL(network_http_pool_benchmark);
 TB_DEMO_MAIN_DECL(network_impl_date);
 
 // platform
 TB_DEMO_MAIN_DECL(platform_file);
 TB_DEMO_MAIN_DECL(platform_lock);
+TB_DEMO_MAIN_DECL(platform_lock_benchmark);
 TB_DEMO_MAIN_DECL(platform_path);
 TB_DEMO_MAIN_DECL(platform_event);
 TB_DEMO_MAIN_DECL(platform_utils);
 TB_DEMO_MAIN_DECL(platform_timer);
 TB_DEMO_MAIN_DECL(platform_ltimer);
+TB_DEMO_MAIN_DECL(platform_ltimer_benchmark);
 TB_DEMO_MAIN_DECL(platform_atomic);
 TB_DEMO_MAIN_DECL(platform_process);
 TB_DEMO_MAIN_DECL(platform_barrier);
@@ -174,6 +193,7 @@ TB_DEMO_MAIN_DECL(platform_cache_time);
 TB_DEMO_MAIN_DECL(platform_environment);
 TB_DEMO_MAIN_DECL(platform_thread);
 TB_DEMO_MAIN_DECL(platform_thread_pool);
+TB_DEMO_MAIN_DECL(platform_thread_pool_benchmark);
 TB_DEMO_MAIN_DECL(platform_thread_local);
 TB_DEMO_MAIN_DECL(platform_context);
 
@@ -182,6 +202,7 @@ TB_DEMO_MAIN_DECL(container_heap);
 TB_DEMO_MAIN_DECL(container_stack);
 TB_DEMO_MAIN_DECL(container_vector);
 TB_DEMO_MAIN_DECL(container_hash_map);
+TB_DEMO_MAIN_DECL(container_flat_hash_map);
 TB_DEMO_MAIN_DECL(container_hash_set);
 TB_DEMO_MAIN_DECL(container_queue);
 TB_DEMO_MAIN_DECL(container_circle_queue);
@@ -211,6 +232,8 @@ TB_DEMO_MAIN_DECL(coroutine_echo_server);
 TB_DEMO_MAIN_DECL(coroutine_file_client);
 TB_DEMO_MAIN_DECL(coroutine_file_server);
 TB_DEMO_MAIN_DECL(coroutine_http_server);
+TB_DEMO_MAIN_DECL(network_http_server);
+TB_DEMO_MAIN_DECL(network_http_server_benchmark);
 
 // stackless coroutine
 TB_DEMO_MAIN_DECL(lo_coroutine_nest);
@@ -64,6 +64,7 @@ static tb_demo_hash32_entry_t g_hash32_entries[] =
 ,   { "adler32 ",   tb_adler32_make         }
 ,   { "crc32   ",   tb_crc32_make           }
 ,   { "crc32-le",   tb_crc32_le_make        }
+,   { "crc32c  ",   tb_crc32c_make          }
 ,   { "bkdr    ",   tb_demo_bkdr_make       }
 ,   { "murmur  ",   tb_demo_murmur_make     }
 ,   { "blizzard",   tb_demo_blizzard_make   }
@@ -98,7 +99,7 @@ static tb_void_t tb_demo_hash32_test()
         t = tb_mclock() - t;
 
         // trace
-        tb_trace_i("[hash(1K)]: %s: %08x %ld ms", entry->name, v, t);
+        tb_trace_i("[hash(1K)]: %s: %08x %ld ms, %lld MB/s", entry->name, v, t, (tb_hong_t)1024 * 1000 / tb_max(t, 1));
     }
 
     // trace
@@ -118,7 +119,7 @@ static tb_void_t tb_demo_hash32_test()
         t = tb_mclock() - t;
 
         // trace
-        tb_trace_i("[hash(1M)]: %s: %08x %ld ms", entry->name, v, t);
+        tb_trace_i("[hash(1M)]: %s: %08x %ld ms, %lld MB/s", entry->name, v, t, (tb_hong_t)size / tb_max(t, 1));
     }
 
     // exit data
@@ -0,0 +1,190 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the random double count
+#define TB_DEMO_DOUBLE_COUNT        (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+static tb_void_t tb_demo_dtoa_show(tb_double_t value)
+{
+    tb_char_t data[TB_DTOA_MAXN];
+    tb_dtoa(value, data, sizeof(data));
+    tb_printf("dtoa: %s, %%lf: %lf\n", data, value);
+}
+static tb_void_t tb_demo_ftoa_show(tb_float_t value)
+{
+    tb_char_t data[TB_DTOA_MAXN];
+    tb_ftoa(value, data, sizeof(data));
+    tb_printf("ftoa: %s, %%f: %f\n", data, value);
+}
+
+// the significant digits count of the formatted string
+static tb_int_t tb_demo_dtoa_digits(tb_char_t const* data)
+{
+    // skip the sign and the leading zeros
+    if (*data == '-') data++;
+    while (*data == '0' || *data == '.') data++;
+
+    // count the digits of the mantissa
+    tb_int_t n = 0;
+    tb_int_t zeros = 0;
+    for (; *data && *data != 'e'; data++)
+    {
+        if (*data == '0') zeros++;
+        else if (*data != '.')
+        {
+            n += zeros + 1;
+            zeros = 0;
+        }
+    }
+    return tb_max(n, 1);
+}
+
+/* check the round-trip and the shortest digits
+ *
+ * we use the libc strtod and snprintf as the reference implementation here
+ */
+static tb_bool_t tb_demo_ftoa_check(tb_uint32_t bits, tb_bool_t shortest)
+{
+    // format it
+    tb_ieee_float_t ieee; ieee.i = bits;
+    tb_char_t data[TB_DTOA_MAXN];
+    if (!tb_ftoa(ieee.f, data, sizeof(data))) return tb_false;
+
+    // nan or inf? only check the string
+    if (tb_isnanf(ieee.f)) return !tb_strcmp(data, "nan");
+    if (tb_isinff(ieee.f)) return !tb_strcmp(data, ieee.f < 0? "-inf" : "inf");
+
+    // parse it
+    tb_ieee_float_t real; real.f = strtof(data, tb_null);
+    if (real.i != bits)
+    {
+        tb_printf("[e] ftoa: 0x%08x => %s => 0x%08x\n", bits, data, real.i);
+        return tb_false;
+    }
+
+    // no shorter string can be parsed back?
+    tb_int_t n = tb_demo_dtoa_digits(data);
+    if (shortest && n > 1)
+    {
+        tb_char_t shorter[64];
+        snprintf(shorter, sizeof(shorter), "%.*e", n - 2, ieee.f);
+        real.f = strtof(shorter, tb_null);
+        if (real.i == bits)
+        {
+            tb_printf("[e] ftoa: 0x%08x => %s, but %s is shorter\n", bits, data, shorter);
+            return tb_false;
+        }
+    }
+    return tb_true;
+}
+static tb_bool_t tb_demo_dtoa_check(tb_uint64_t bits, tb_bool_t shortest)
+{
+    // format it
+    tb_ieee_double_t ieee; ieee.i.l = (tb_uint32_t)bits; ieee.i.h = (tb_uint32_t)(bits >> 32);
+    tb_char_t data[TB_DTOA_MAXN];
+    if (!tb_dtoa(ieee.d, data, sizeof(data))) return tb_false;
+
+    // nan or inf? only check the string
+    if (tb_isnan(ieee.d)) return !tb_strcmp(data, "nan");
+    if (tb_isinf(ieee.d)) return !tb_strcmp(data, ieee.d < 0? "-inf" : "inf");
+
+    // parse it
+    tb_double_t real = strtod(data, tb_null);
+    if (tb_memcmp(&real, &ieee.d, sizeof(tb_double_t)))
+    {
+        tb_printf("[e] dtoa: 0x%016llx => %s => %.17g\n", bits, data, real);
+        return tb_false;
+    }
+
+    // no shorter string can be parsed back?
+    tb_int_t n = tb_demo_dtoa_digits(data);
+    if (shortest && n > 1)
+    {
+        tb_char_t shorter[64];
+        snprintf(shorter, sizeof(shorter), "%.*e", n - 2, ieee.d);
+        real = strtod(shorter, tb_null);
+        if (!tb_memcmp(&real, &ieee.d, sizeof(tb_double_t)))
+        {
+            tb_printf("[e] dtoa: 0x%016llx => %s, but %s is shorter\n", bits, data, shorter);
+            return tb_false;
+        }
+    }
+    return tb_true;
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_dtoa_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // show some values
+    tb_demo_dtoa_show(0.1);
+    tb_demo_dtoa_show(-0.);
+    tb_demo_dtoa_show(100.);
+    tb_demo_dtoa_show(1. / 3.);
+    tb_demo_dtoa_show(0.0001);
+    tb_demo_dtoa_show(0.00001);
+    tb_demo_dtoa_show(123456789012345680.);
+    tb_demo_dtoa_show(1e22);
+    tb_demo_dtoa_show(5e-324);
+    tb_demo_dtoa_show(1.7976931348623157e308);
+    tb_demo_dtoa_show(TB_INF);
+    tb_demo_dtoa_show(-TB_INF);
+    tb_demo_dtoa_show(TB_NAN);
+    tb_demo_ftoa_show(0.1f);
+    tb_demo_ftoa_show(3.14159f);
+    tb_demo_ftoa_show(16777216.f);
+    tb_demo_ftoa_show(1e-45f);
+    tb_demo_ftoa_show(3.4028235e38f);
+    tb_printf("printf: |%lg|%g|%lG|%+g|%8lg|%-8lg|%08lg|\n", 0.1, 0.1f, 1e-22, 1.5f, 2.5, 2.5, -2.5);
+    tb_printf("printf: |%08lg|%08lg|%+08lg|%-8lg|\n", -TB_INF, TB_NAN, TB_INF, -TB_INF);
+
+    /* check all floats, it will take some minutes
+     *
+     * the shortest digits are checked for one of the 64 floats because snprintf is too slow,
+     * e.g. "demo libc_dtoa 97" checks one of the 97 floats only.
+     */
+    tb_size_t   step = argv[1]? tb_atoi(argv[1]) : 1;
+    tb_uint64_t bits = 0;
+    tb_size_t   count = 0;
+    tb_size_t   errors = 0;
+    tb_hong_t   time = tb_mclock();
+    step = tb_max(step, 1);
+    for (bits = 0; bits <= 0xffffffff; bits += step, count++)
+    {
+        if (!tb_demo_ftoa_check((tb_uint32_t)bits, !(count & 63))) errors++;
+        if (errors > 10) break;
+    }
+    tb_trace_i("ftoa: %lu floats, errors: %lu, %lld ms", count, errors, tb_mclock() - time);
+
+    // check random doubles, the subnormal numbers and the short mantissas
+    tb_size_t i = 0;
+    errors = 0;
+    time = tb_mclock();
+    tb_uint64_t x = 88172645463325252ULL;
+    for (i = 0; i < TB_DEMO_DOUBLE_COUNT && errors <= 10; i++)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        bits = x;
+        if ((i & 3) == 1) bits &= 0x800fffffffffffffULL;
+        else if ((i & 3) == 2) bits = (bits & 0xfff0000000000000ULL) | (x >> 40);
+        if (!tb_demo_dtoa_check(bits, tb_true)) errors++;
+    }
+    tb_trace_i("dtoa: %lu doubles, errors: %lu, %lld ms", i, errors, tb_mclock() - time);
+#endif
+    return 0;
+}
@@ -0,0 +1,126 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <stdio.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the test values count
+#define TB_DEMO_VALUE_COUNT         (1 << 16)
+
+// the default loop count
+#define TB_DEMO_LOOP_COUNT          (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+
+// the format function type
+typedef tb_long_t (*tb_demo_format_t)(tb_char_t* data, tb_size_t maxn, tb_double_t value);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the test values
+static tb_double_t                  g_values[TB_DEMO_VALUE_COUNT];
+
+// the results, avoid to optimize the calls
+static __tb_volatile__ tb_size_t    g_result = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * formats
+ */
+static tb_long_t tb_demo_format_dtoa(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return tb_dtoa(value, data, maxn);
+}
+static tb_long_t tb_demo_format_ftoa(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return tb_ftoa((tb_float_t)value, data, maxn);
+}
+static tb_long_t tb_demo_format_printf_lg(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return tb_snprintf(data, maxn, "%lg", value);
+}
+static tb_long_t tb_demo_format_printf_lf(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return tb_snprintf(data, maxn, "%lf", value);
+}
+static tb_long_t tb_demo_format_printf_f(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return tb_snprintf(data, maxn, "%f", (tb_float_t)value);
+}
+static tb_long_t tb_demo_format_libc_17g(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return snprintf(data, maxn, "%.17g", value);
+}
+static tb_long_t tb_demo_format_libc_9g(tb_char_t* data, tb_size_t maxn, tb_double_t value)
+{
+    return snprintf(data, maxn, "%.9g", (tb_float_t)value);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t tb_demo_dtoa_bench(tb_char_t const* name, tb_demo_format_t format, tb_size_t loop)
+{
+    // done
+    tb_char_t   data[256];
+    tb_size_t   size = 0;
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_hong_t   time = tb_uclock();
+    for (j = 0; j < loop; j++)
+    {
+        for (i = 0; i < TB_DEMO_VALUE_COUNT; i++)
+            size += format(data, sizeof(data), g_values[i]);
+    }
+    time = tb_max(tb_uclock() - time, 1);
+    g_result += size;
+
+    // trace
+    tb_size_t count = loop * TB_DEMO_VALUE_COUNT;
+    tb_trace_i("%-16s: %lld ns/value, %lld Mvalues/s, %lu bytes/value", name, time * 1000 / count, (tb_hong_t)count / time, size / count);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_dtoa_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // the loop count
+    tb_size_t loop = argv[1]? tb_atoi(argv[1]) : TB_DEMO_LOOP_COUNT;
+    loop = tb_max(loop, 1);
+
+    // make the random values in [1e-10, 1e10], %lf can only format them in the 64bits integer part
+    tb_size_t i = 0;
+    tb_uint64_t x = 88172645463325252ULL;
+    for (i = 0; i < TB_DEMO_VALUE_COUNT; i++)
+    {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        tb_ieee_double_t ieee;
+        ieee.i.l = (tb_uint32_t)x;
+        ieee.i.h = (tb_uint32_t)(((x >> 32) & 0x800fffff) | ((tb_uint64_t)(1023 - 33 + (x % 67)) << 20));
+        g_values[i] = ieee.d;
+    }
+
+    // the double formats
+    tb_demo_dtoa_bench("dtoa",              tb_demo_format_dtoa,        loop);
+    tb_demo_dtoa_bench("tb_snprintf(%lg)",  tb_demo_format_printf_lg,   loop);
+    tb_demo_dtoa_bench("tb_snprintf(%lf)",  tb_demo_format_printf_lf,   loop);
+    tb_demo_dtoa_bench("snprintf(%.17g)",   tb_demo_format_libc_17g,    loop);
+
+    // the float formats
+    tb_demo_dtoa_bench("ftoa",              tb_demo_format_ftoa,        loop);
+    tb_demo_dtoa_bench("tb_snprintf(%f)",   tb_demo_format_printf_f,    loop);
+    tb_demo_dtoa_bench("snprintf(%.9g)",    tb_demo_format_libc_9g,     loop);
+#endif
+    return 0;
+}
@@ -0,0 +1,164 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default random strings count
+#define TB_DEMO_STRING_COUNT        (1000000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+static tb_uint64_t tb_demo_random(tb_noarg_t)
+{
+    static tb_uint64_t x = 88172645463325252ULL;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return x;
+}
+static tb_double_t tb_demo_random_double(tb_noarg_t)
+{
+    tb_uint64_t x = tb_demo_random();
+    tb_ieee_double_t ieee;
+    ieee.i.l = (tb_uint32_t)x;
+    ieee.i.h = (tb_uint32_t)((x >> 32) & 0x7fffffff);
+    return tb_isnan(ieee.d) || tb_isinf(ieee.d)? 1. : ieee.d;
+}
+
+/* check the parsed value and the end of the string
+ *
+ * we use the libc strtod as the reference implementation here
+ */
+static tb_bool_t tb_demo_s10tod_check(tb_char_t const* data)
+{
+    // parse it
+    tb_char_t*          end1 = tb_null;
+    tb_char_t const*    end2 = tb_null;
+    tb_double_t         value1 = strtod(data, &end1);
+    tb_double_t         value2 = tb_s10ntod(data, (tb_size_t)-1, &end2);
+    if (tb_isnan(value1) && tb_isnan(value2)) return tb_true;
+    if (tb_memcmp(&value1, &value2, sizeof(tb_double_t)) || end1 != end2)
+    {
+        tb_printf("[e] s10tod: %s => %lg(%ld), but %lg(%ld)\n", data, value2, (tb_long_t)(end2 - data), value1, (tb_long_t)(end1 - data));
+        return tb_false;
+    }
+
+    // parse it from the buffer without '\0', e.g. the json tokens
+    tb_size_t   size = tb_strlen(data);
+    tb_char_t*  copy = (tb_char_t*)tb_malloc(size + 1);
+    tb_assert_and_check_return_val(copy, tb_false);
+    tb_memcpy(copy, data, size);
+    copy[size] = '9';
+    value2 = tb_s10ntod(copy, size, &end2);
+    tb_free(copy);
+    if (tb_memcmp(&value1, &value2, sizeof(tb_double_t)))
+    {
+        tb_printf("[e] s10ntod: %s => %lg, but %lg\n", data, value2, value1);
+        return tb_false;
+    }
+    return tb_true;
+}
+
+// make the random decimal string, e.g. "000123.4560e-12"
+static tb_void_t tb_demo_s10tod_make(tb_char_t* data, tb_size_t maxn)
+{
+    tb_uint64_t x = tb_demo_random();
+    tb_char_t*  p = data;
+    tb_char_t*  e = data + maxn - 16;
+    tb_size_t   n = 1 + (x % ((x >> 8) & 1? 24 : 800));
+    tb_size_t   dot = (x >> 20) % (n + 1);
+    if ((x >> 30) & 1) *p++ = '-';
+    while (n-- && p < e)
+    {
+        tb_uint64_t y = tb_demo_random();
+
+        // use more zeros and nines to make the halfway cases
+        *p++ = (y & 3) == 0? '0' : (y & 3) == 1? '9' : (tb_char_t)('0' + (y >> 8) % 10);
+        if (!dot--) *p++ = '.';
+    }
+    if ((x >> 31) & 1) p += tb_snprintf(p, 16, "e%d", (tb_int_t)((x >> 32) % 800) - 400);
+    *p = '\0';
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_s10tod_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // check some strings
+    static tb_char_t const* s_strings[] =
+    {
+        "0", "-0", "0.1", " +1.5e-07", "1e", "1e+", "1.e2", ".5", ".", "-", "e5", "1.5x", "nan", "-inf"
+    ,   "9007199254740993", "9007199254740993.0000000001", "1e23", "8.98846567431158e307"
+    ,   "1.7976931348623157e308", "1.7976931348623158e308", "1.7976931348623159e308", "1e309"
+    ,   "2.2250738585072011e-308", "2.2250738585072012e-308", "4.9406564584124654e-324"
+    ,   "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-400", "1e-99999999999", "1e99999999999"
+    ,   "0.000000000000000000000000000000000000000000000000000000000000000000000000001"
+    ,   "2.22507385850720113605740979670913197593481954635164564802342610972482222202107694551652952390813508"
+        "7914149158913039621106870086438694594645527657207407820621743379988141063267329253552286881372149012"
+        "9811224514518898490572223072852551331557550159143974763979834118019993239625482890171070818506906306"
+        "6665599493827577257201576306269066333264756530000924588831643303777979186961204949739037782970490505"
+        "1080609940730262937128958950003583799967207254304360284078895771796150945516748243471030702609144621"
+        "5722898802581825451803257070188608721131280795122334262883686223215037756666225039825343359745688844"
+        "2390026549819838548794829220689472168983109969836584681402285424333066033985088644580400103493397042"
+        "7567186443383770486037861622771738545623065874679014086723327636718751234567890123456789e-308"
+    };
+    tb_size_t i = 0;
+    tb_size_t errors = 0;
+    for (i = 0; i < tb_arrayn(s_strings); i++)
+    {
+        tb_printf("s10tod: %s => %lg\n", s_strings[i], tb_s10tod(s_strings[i]));
+        if (!tb_demo_s10tod_check(s_strings[i])) errors++;
+    }
+
+    // the strings count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_STRING_COUNT;
+    tb_hong_t time = tb_mclock();
+
+    /* check the random doubles
+     *
+     * the 17 digits, the shortest digits, and the exact halfway of two doubles
+     */
+    tb_char_t data[1024];
+    for (i = 0; i < count && errors <= 10; i++)
+    {
+        tb_double_t value = tb_demo_random_double();
+        switch (i & 3)
+        {
+        case 0: snprintf(data, sizeof(data), "%.17g", value); break;
+        case 1: snprintf(data, sizeof(data), "%.16g", value); break;
+        case 2: tb_dtoa(value, data, sizeof(data)); break;
+        default:
+            {
+                // make the halfway of value and the next double, it is exact in the long double or the 767 digits
+                tb_ieee_double_t ieee; ieee.d = value;
+                ieee.i.l++; if (!ieee.i.l) ieee.i.h++;
+                if (sizeof(long double) > sizeof(tb_double_t))
+                    snprintf(data, sizeof(data), "%.800Le", ((long double)value + (long double)ieee.d) / 2);
+                else snprintf(data, sizeof(data), "%.16e", value);
+            }
+            break;
+        }
+        if (!tb_demo_s10tod_check(data)) errors++;
+    }
+    tb_trace_i("doubles: %lu strings, errors: %lu, %lld ms", i, errors, tb_mclock() - time);
+
+    // check the random decimal strings, most of them will be handled by the slow path
+    time = tb_mclock();
+    for (i = 0; i < count && errors <= 10; i++)
+    {
+        tb_demo_s10tod_make(data, sizeof(data));
+        if (!tb_demo_s10tod_check(data)) errors++;
+    }
+    tb_trace_i("decimals: %lu strings, errors: %lu, %lld ms", i, errors, tb_mclock() - time);
+#endif
+    return 0;
+}
@@ -0,0 +1,149 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the test values count
+#define TB_DEMO_VALUE_COUNT         (1 << 16)
+
+// the default loop count
+#define TB_DEMO_LOOP_COUNT          (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+
+// the parse function type
+typedef tb_double_t (*tb_demo_parse_t)(tb_char_t const* s);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the strings
+static tb_char_t*                   g_strings[TB_DEMO_VALUE_COUNT];
+
+// the total size of the strings
+static tb_size_t                    g_strings_size = 0;
+
+// the results, avoid to optimize the calls
+static __tb_volatile__ tb_double_t  g_result = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * parsers
+ */
+static tb_double_t tb_demo_parse_s10tod(tb_char_t const* s)
+{
+    return tb_s10tod(s);
+}
+static tb_double_t tb_demo_parse_libc(tb_char_t const* s)
+{
+    return strtod(s, tb_null);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_uint64_t tb_demo_random(tb_noarg_t)
+{
+    static tb_uint64_t x = 88172645463325252ULL;
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    return x;
+}
+static tb_double_t tb_demo_random_double(tb_int_t emin, tb_int_t emax)
+{
+    tb_uint64_t x = tb_demo_random();
+    tb_ieee_double_t ieee;
+    ieee.i.l = (tb_uint32_t)x;
+    ieee.i.h = (tb_uint32_t)(((x >> 32) & 0x000fffff) | ((tb_uint64_t)(1023 + emin + (x % (emax - emin + 1))) << 20));
+    return ieee.d;
+}
+static tb_bool_t tb_demo_strings_init(tb_char_t const* corpus)
+{
+    tb_size_t i = 0;
+    g_strings_size = 0;
+    for (i = 0; i < TB_DEMO_VALUE_COUNT; i++)
+    {
+        // make string
+        tb_char_t data[64];
+        tb_long_t size = 0;
+        if (!tb_strcmp(corpus, "shortest")) size = tb_dtoa(tb_demo_random_double(-1000, 1000), data, sizeof(data));
+        else if (!tb_strcmp(corpus, "17digits")) size = snprintf(data, sizeof(data), "%.17g", tb_demo_random_double(-1000, 1000));
+        else if (!tb_strcmp(corpus, "fixed")) size = snprintf(data, sizeof(data), "%.3f", tb_demo_random_double(-10, 20));
+        else if (!tb_strcmp(corpus, "integer")) size = snprintf(data, sizeof(data), "%u", (tb_uint32_t)tb_demo_random());
+        tb_assert_and_check_return_val(size > 0, tb_false);
+
+        // save string
+        if (g_strings[i]) tb_free(g_strings[i]);
+        g_strings[i] = tb_strdup(data);
+        tb_assert_and_check_return_val(g_strings[i], tb_false);
+        g_strings_size += size;
+    }
+    return tb_true;
+}
+static tb_void_t tb_demo_strings_exit(tb_noarg_t)
+{
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_VALUE_COUNT; i++)
+    {
+        if (g_strings[i]) tb_free(g_strings[i]);
+        g_strings[i] = tb_null;
+    }
+}
+static tb_void_t tb_demo_s10tod_bench(tb_char_t const* corpus, tb_char_t const* name, tb_demo_parse_t parse, tb_size_t loop)
+{
+    // done
+    tb_double_t sum = 0;
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_hong_t   time = tb_uclock();
+    for (j = 0; j < loop; j++)
+    {
+        for (i = 0; i < TB_DEMO_VALUE_COUNT; i++)
+            sum += parse(g_strings[i]);
+    }
+    time = tb_max(tb_uclock() - time, 1);
+    g_result += sum;
+
+    // trace
+    tb_size_t count = loop * TB_DEMO_VALUE_COUNT;
+    tb_trace_i("%-8s: %-8s: %lld ns/value, %lld MB/s", corpus, name, time * 1000 / count, (tb_hong_t)g_strings_size * loop / time);
+}
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_s10tod_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // the loop count
+    tb_size_t loop = argv[1]? tb_atoi(argv[1]) : TB_DEMO_LOOP_COUNT;
+    loop = tb_max(loop, 1);
+
+    /* the corpora
+     *
+     * shortest:    the shortest round-trip strings of tb_dtoa(), e.g. the json and xml writers
+     * 17digits:    the full precision strings of "%.17g"
+     * fixed:       the fixed-point strings of "%.3f"
+     * integer:     the 32bits integers
+     */
+    static tb_char_t const* s_corpora[] = {"shortest", "17digits", "fixed", "integer"};
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(s_corpora); i++)
+    {
+        if (!tb_demo_strings_init(s_corpora[i])) break;
+        tb_demo_s10tod_bench(s_corpora[i], "s10tod",    tb_demo_parse_s10tod,   loop);
+        tb_demo_s10tod_bench(s_corpora[i], "strtod",    tb_demo_parse_libc,     loop);
+    }
+    tb_demo_strings_exit();
+#endif
+    return 0;
+}
@@ -0,0 +1,188 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#if defined(TB_ARCH_x86) || defined(TB_ARCH_x64)
+#   include "../../tbox/libc/string/impl/x86/simd.h"
+#endif
+#include <string.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum data size, 64MB
+#define TB_DEMO_SIZE_MAXN           (1 << 26)
+
+// the processed bytes for each test
+#define TB_DEMO_BYTES               (1 << 28)
+
+// the maximum loop count for each test
+#define TB_DEMO_LOOP_MAXN           (1 << 22)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the operation type
+typedef tb_void_t (*tb_demo_op_t)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+
+// the implementation type
+typedef struct __tb_demo_impl_t
+{
+    // the name
+    tb_char_t const*    name;
+
+    // need avx2?
+    tb_bool_t           avx2;
+
+    // the operations: memcpy, memset, memcmp, strlen, strcmp
+    tb_demo_op_t        ops[5];
+
+}tb_demo_impl_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the results, avoid to optimize the calls
+static __tb_volatile__ tb_long_t    g_result = 0;
+
+// the libc interfaces, avoid to be replaced by the builtin functions
+static tb_pointer_t                 (*__tb_volatile__ g_libc_memcpy)(tb_pointer_t, tb_cpointer_t, size_t) = memcpy;
+static tb_pointer_t                 (*__tb_volatile__ g_libc_memset)(tb_pointer_t, tb_int_t, size_t) = memset;
+static tb_int_t                     (*__tb_volatile__ g_libc_memcmp)(tb_cpointer_t, tb_cpointer_t, size_t) = memcmp;
+static size_t                       (*__tb_volatile__ g_libc_strlen)(tb_char_t const*) = strlen;
+static tb_int_t                     (*__tb_volatile__ g_libc_strcmp)(tb_char_t const*, tb_char_t const*) = strcmp;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * operations
+ */
+static tb_void_t tb_demo_tbox_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memcpy_(d, s, n); }
+static tb_void_t tb_demo_tbox_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memset_(d, 0xcc, n); }
+static tb_void_t tb_demo_tbox_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_memcmp_(d, s, n); }
+static tb_void_t tb_demo_tbox_strlen(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_strlen((tb_char_t const*)s); }
+static tb_void_t tb_demo_tbox_strcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_strcmp((tb_char_t const*)d, (tb_char_t const*)s); }
+static tb_void_t tb_demo_libc_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_libc_memcpy(d, s, n); }
+static tb_void_t tb_demo_libc_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_libc_memset(d, 0xcc, n); }
+static tb_void_t tb_demo_libc_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += g_libc_memcmp(d, s, n); }
+static tb_void_t tb_demo_libc_strlen(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += g_libc_strlen((tb_char_t const*)s); }
+static tb_void_t tb_demo_libc_strcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += g_libc_strcmp((tb_char_t const*)d, (tb_char_t const*)s); }
+#ifdef TB_ARCH_SSE2
+static tb_void_t tb_demo_sse2_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memcpy_simd_sse2(d, s, n); }
+static tb_void_t tb_demo_sse2_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memset_simd_sse2(d, 0xcc, n); }
+static tb_void_t tb_demo_sse2_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_memcmp_simd_sse2(d, s, n); }
+static tb_void_t tb_demo_sse2_strlen(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_strlen_simd_sse2((tb_char_t const*)s); }
+static tb_void_t tb_demo_sse2_strcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_strcmp_simd((tb_char_t const*)d, (tb_char_t const*)s); }
+#endif
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static tb_void_t tb_demo_avx2_memcpy(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memcpy_simd_avx2(d, s, n); }
+static tb_void_t tb_demo_avx2_memset(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { tb_memset_simd_avx2(d, 0xcc, n); }
+static tb_void_t tb_demo_avx2_memcmp(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_memcmp_simd_avx2(d, s, n); }
+static tb_void_t tb_demo_avx2_strlen(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)     { g_result += tb_strlen_simd_avx2((tb_char_t const*)s); }
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementations
+ */
+static tb_demo_impl_t g_impls[] =
+{
+    {"tbox", tb_false, {tb_demo_tbox_memcpy, tb_demo_tbox_memset, tb_demo_tbox_memcmp, tb_demo_tbox_strlen, tb_demo_tbox_strcmp}}
+#ifdef TB_ARCH_SSE2
+,   {"sse2", tb_false, {tb_demo_sse2_memcpy, tb_demo_sse2_memset, tb_demo_sse2_memcmp, tb_demo_sse2_strlen, tb_demo_sse2_strcmp}}
+#endif
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+,   {"avx2", tb_true,  {tb_demo_avx2_memcpy, tb_demo_avx2_memset, tb_demo_avx2_memcmp, tb_demo_avx2_strlen, tb_null}}
+#endif
+,   {"libc", tb_false, {tb_demo_libc_memcpy, tb_demo_libc_memset, tb_demo_libc_memcmp, tb_demo_libc_strlen, tb_demo_libc_strcmp}}
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_hong_t tb_demo_string_test(tb_demo_op_t op, tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // the loop count
+    tb_size_t loop = tb_max(TB_DEMO_BYTES / tb_max(n, 1), 4);
+    loop = tb_min(loop, TB_DEMO_LOOP_MAXN);
+
+    // warm up
+    op(d, s, n);
+
+    // done
+    tb_size_t i = 0;
+    tb_hong_t t = tb_uclock();
+    for (i = 0; i < loop; i++) op(d, s, n);
+    t = tb_uclock() - t;
+
+    // the speed (MB/s)
+    return (tb_hong_t)n * loop / tb_max(t, 1);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_libc_string_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the misaligned offset of the source data
+    tb_size_t offset = argv[1]? tb_atoi(argv[1]) & 63 : 0;
+
+    // the maximum data size
+    tb_size_t maxn = (argv[1] && argv[2])? tb_atoi(argv[2]) : TB_DEMO_SIZE_MAXN;
+    maxn = tb_max(tb_min(maxn, TB_DEMO_SIZE_MAXN), 1);
+
+    // the cpu supports avx2?
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+    tb_bool_t avx2 = tb_libc_string_simd_avx2();
+#else
+    tb_bool_t avx2 = tb_false;
+#endif
+
+    // make data
+    tb_byte_t* data1 = tb_malloc_bytes(maxn + 128);
+    tb_byte_t* data2 = tb_malloc_bytes(maxn + 128);
+    tb_assert_and_check_return_val(data1 && data2, -1);
+    tb_byte_t* d = data1 + 64;
+    tb_byte_t* s = data2 + 64 + offset;
+
+    // trace
+    tb_trace_i("offset: %lu, maxn: %lu, avx2: %s, speed: MB/s", offset, maxn, avx2? "ok" : "no");
+
+    // done
+    tb_size_t n = 1;
+    tb_size_t i = 0;
+    while (1)
+    {
+        // the tests
+        tb_size_t   k = 0;
+        tb_char_t   info[256];
+        tb_char_t   const* names[] = {"memcpy", "memset", "memcmp", "strlen", "strcmp"};
+        for (k = 0; k < tb_arrayn(names); k++)
+        {
+            // make the same strings
+            tb_memset_(d, 'a', n);
+            tb_memset_(s, 'a', n);
+            d[n] = '\0';
+            s[n] = '\0';
+
+            // test all implementations
+            tb_long_t size = tb_snprintf(info, sizeof(info), "%s: %8lu:", names[k], n);
+            for (i = 0; i < tb_arrayn(g_impls) && size > 0 && size < sizeof(info); i++)
+            {
+                tb_demo_impl_t const* impl = &g_impls[i];
+                if (!impl->ops[k] || (impl->avx2 && !avx2)) continue;
+                size += tb_snprintf(info + size, sizeof(info) - size, " %s: %6lld", impl->name, tb_demo_string_test(impl->ops[k], d, s, n));
+            }
+            tb_trace_i("%s", info);
+        }
+
+        // next
+        if (n >= maxn) break;
+        n = tb_min(n << 1, maxn);
+    }
+
+    // exit data
+    tb_free(data1);
+    tb_free(data2);
+    return 0;
+}
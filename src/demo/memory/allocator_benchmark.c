@@ -0,0 +1,170 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default operation count of each thread
+#define TB_DEMO_OPERATION_COUNT     (1000000)
+
+// the live data count of each thread
+#define TB_DEMO_LIVE_COUNT          (256)
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark context type
+typedef struct __tb_demo_context_t
+{
+    // the allocator
+    tb_allocator_ref_t      allocator;
+
+    // the operation count of each thread
+    tb_size_t               count;
+
+    // the data size maximum
+    tb_size_t               size_maxn;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_allocator_thread(tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t const* context = (tb_demo_context_t const*)priv;
+    tb_assert_and_check_return_val(context, -1);
+
+    // the allocator
+    tb_allocator_ref_t allocator = context->allocator;
+
+    // malloc and free the random sizes
+    tb_size_t       i = 0;
+    tb_uint32_t     seed = (tb_uint32_t)(tb_size_t)&i | 1;
+    tb_pointer_t    live[TB_DEMO_LIVE_COUNT] = {0};
+    for (i = 0; i < context->count; i++)
+    {
+        // the next random value
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        // free the previous data in this slot
+        tb_size_t slot = i & (TB_DEMO_LIVE_COUNT - 1);
+        if (live[slot]) tb_allocator_free(allocator, live[slot]);
+
+        // malloc the new data
+        tb_size_t size = (seed % context->size_maxn) + 1;
+        live[slot] = tb_allocator_malloc(allocator, size);
+        tb_assert_and_check_break(live[slot]);
+
+        // touch it
+        *((tb_byte_t*)live[slot]) = (tb_byte_t)i;
+    }
+
+    // free all
+    for (i = 0; i < TB_DEMO_LIVE_COUNT; i++)
+    {
+        if (live[i]) tb_allocator_free(allocator, live[i]);
+    }
+    return 0;
+}
+static tb_hong_t tb_demo_allocator_test(tb_allocator_ref_t allocator, tb_size_t thread_count, tb_size_t count, tb_size_t size_maxn)
+{
+    // init context
+    tb_demo_context_t context;
+    context.allocator   = allocator;
+    context.count       = count;
+    context.size_maxn   = size_maxn;
+
+    // start threads
+    tb_size_t       i = 0;
+    tb_hong_t       t = tb_mclock();
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    for (i = 0; i < thread_count; i++)
+    {
+        threads[i] = tb_thread_init(tb_null, tb_demo_allocator_thread, &context, 0);
+        tb_assert_and_check_break(threads[i]);
+    }
+
+    // wait threads
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    return tb_mclock() - t;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_allocator_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the operation count of each thread
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_OPERATION_COUNT;
+
+    // the max thread count
+    tb_size_t thread_maxn = (argv[1] && argv[2])? tb_atoi(argv[2]) : tb_processor_count();
+    thread_maxn = tb_max(tb_min(thread_maxn, TB_DEMO_THREAD_MAXN), 1);
+
+    // the small allocator without the thread cache
+    tb_allocator_ref_t small_allocator = tb_small_allocator_init(tb_null);
+    tb_assert_and_check_return_val(small_allocator, -1);
+
+    // trace
+    tb_trace_i("operations: %lu, processors: %lu", count, tb_processor_count());
+
+    // done
+    tb_size_t threads = 1;
+    while (1)
+    {
+        // the total operation count
+        tb_hong_t total = (tb_hong_t)count * threads;
+
+        // test the small sizes
+        tb_hong_t t_default = tb_demo_allocator_test(tb_allocator(), threads, count, 256);
+        tb_hong_t t_small   = tb_demo_allocator_test(small_allocator, threads, count, 256);
+        tb_hong_t t_native  = tb_demo_allocator_test(tb_native_allocator(), threads, count, 256);
+
+        // trace
+        tb_trace_i("threads: %2lu, default: %lld ms, %lld ops/s, small: %lld ms, %lld ops/s, native: %lld ms, %lld ops/s"
+                , threads
+                , t_default, total * 1000 / tb_max(t_default, 1)
+                , t_small, total * 1000 / tb_max(t_small, 1)
+                , t_native, total * 1000 / tb_max(t_native, 1));
+
+        // test the mixed sizes
+        t_default   = tb_demo_allocator_test(tb_allocator(), threads, count, TB_SMALL_ALLOCATOR_DATA_MAXN);
+        t_small     = tb_demo_allocator_test(small_allocator, threads, count, TB_SMALL_ALLOCATOR_DATA_MAXN);
+        t_native    = tb_demo_allocator_test(tb_native_allocator(), threads, count, TB_SMALL_ALLOCATOR_DATA_MAXN);
+
+        // trace
+        tb_trace_i("threads: %2lu, mixed: default: %lld ms, %lld ops/s, small: %lld ms, %lld ops/s, native: %lld ms, %lld ops/s"
+                , threads
+                , t_default, total * 1000 / tb_max(t_default, 1)
+                , t_small, total * 1000 / tb_max(t_small, 1)
+                , t_native, total * 1000 / tb_max(t_native, 1));
+
+        // next
+        if (threads >= thread_maxn) break;
+        threads = tb_min(threads << 1, thread_maxn);
+    }
+
+    // exit the small allocator
+    tb_allocator_exit(small_allocator);
+
+    // ok
+    return 0;
+}
@@ -0,0 +1,276 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default operation count of each thread
+#define TB_DEMO_OPERATION_COUNT     (1000000)
+
+// the key count, the first half keys are permanent
+#define TB_DEMO_KEY_COUNT           (8192)
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark context type
+typedef struct __tb_demo_context_t
+{
+    // the string pool, use the locked hash map if be null
+    tb_string_pool_ref_t    pool;
+
+    // the locked hash map
+    tb_hash_map_ref_t       map;
+
+    // the lock of the hash map
+    tb_spinlock_t           lock;
+
+    // the operation count of each thread
+    tb_size_t               count;
+
+    // the error count
+    tb_atomic_t             errors;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the keys
+static tb_char_t*           g_keys[TB_DEMO_KEY_COUNT];
+
+// the key sizes
+static tb_size_t            g_sizes[TB_DEMO_KEY_COUNT];
+
+// the key hashes
+static tb_uint32_t          g_hashes[TB_DEMO_KEY_COUNT];
+
+// the permanent strings
+static tb_char_t const*     g_permanents[TB_DEMO_KEY_COUNT / 2];
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_string_pool_thread(tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+    tb_assert_and_check_return_val(context && context->pool, -1);
+
+    // the pool
+    tb_string_pool_ref_t pool = context->pool;
+
+    // lookup the permanent keys and insert/remove the other keys
+    tb_size_t       i = 0;
+    tb_size_t       errors = 0;
+    tb_uint32_t     seed = (tb_uint32_t)(tb_size_t)&i | 1;
+    for (i = 0; i < context->count; i++)
+    {
+        // the next random value
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        // lookup the permanent key with the precomputed hash
+        tb_size_t k = seed % TB_DEMO_KEY_COUNT;
+        if (k < TB_DEMO_KEY_COUNT / 2)
+        {
+            if (tb_string_pool_find_with_hash(pool, g_keys[k], g_sizes[k], g_hashes[k]) != g_permanents[k]) errors++;
+        }
+        // insert and remove the key
+        else
+        {
+            tb_char_t const* cstr = tb_string_pool_insert_with_hash(pool, g_keys[k], g_sizes[k], g_hashes[k]);
+            if (!cstr || tb_strcmp(cstr, g_keys[k])) errors++;
+            if (tb_string_pool_find(pool, g_keys[k]) != cstr) errors++;
+            if (cstr) tb_string_pool_remove(pool, cstr);
+        }
+    }
+
+    // save errors
+    if (errors) tb_atomic_fetch_and_add(&context->errors, errors);
+    return 0;
+}
+static tb_int_t tb_demo_hash_map_thread(tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+    tb_assert_and_check_return_val(context && context->map, -1);
+
+    // the hash map with the external lock, it is same as the old string pool usage
+    tb_hash_map_ref_t map = context->map;
+
+    // lookup the permanent keys and insert/remove the other keys
+    tb_size_t       i = 0;
+    tb_size_t       errors = 0;
+    tb_uint32_t     seed = (tb_uint32_t)(tb_size_t)&i | 1;
+    for (i = 0; i < context->count; i++)
+    {
+        // the next random value
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        // lookup the permanent key
+        tb_size_t k = seed % TB_DEMO_KEY_COUNT;
+        tb_spinlock_enter(&context->lock);
+        if (k < TB_DEMO_KEY_COUNT / 2)
+        {
+            if (tb_hash_map_find(map, g_keys[k]) == tb_iterator_tail(map)) errors++;
+        }
+        // insert and remove the key
+        else
+        {
+            tb_size_t itor = tb_hash_map_find(map, g_keys[k]);
+            if (itor == tb_iterator_tail(map)) tb_hash_map_insert(map, g_keys[k], (tb_pointer_t)1);
+            else tb_iterator_copy(map, itor, (tb_pointer_t)((tb_size_t)tb_hash_map_get(map, g_keys[k]) + 1));
+        }
+        tb_spinlock_leave(&context->lock);
+
+        // remove the key
+        if (k >= TB_DEMO_KEY_COUNT / 2)
+        {
+            tb_spinlock_enter(&context->lock);
+            tb_size_t itor = tb_hash_map_find(map, g_keys[k]);
+            if (itor != tb_iterator_tail(map))
+            {
+                tb_size_t refn = (tb_size_t)tb_hash_map_get(map, g_keys[k]);
+                if (refn > 1) tb_iterator_copy(map, itor, (tb_pointer_t)(refn - 1));
+                else tb_iterator_remove(map, itor);
+            }
+            else errors++;
+            tb_spinlock_leave(&context->lock);
+        }
+    }
+
+    // save errors
+    if (errors) tb_atomic_fetch_and_add(&context->errors, errors);
+    return 0;
+}
+static tb_hong_t tb_demo_string_pool_test(tb_demo_context_t* context, tb_thread_func_t func, tb_size_t thread_count)
+{
+    // start threads
+    tb_size_t       i = 0;
+    tb_hong_t       t = tb_mclock();
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    for (i = 0; i < thread_count; i++)
+    {
+        threads[i] = tb_thread_init(tb_null, func, context, 0);
+        tb_assert_and_check_break(threads[i]);
+    }
+
+    // wait threads
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+    return tb_mclock() - t;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_memory_string_pool_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the operation count of each thread
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_OPERATION_COUNT;
+
+    // the max thread count
+    tb_size_t thread_maxn = (argv[1] && argv[2])? tb_atoi(argv[2]) : tb_processor_count();
+    thread_maxn = tb_max(tb_min(thread_maxn, TB_DEMO_THREAD_MAXN), 1);
+
+    // init context
+    tb_demo_context_t context;
+    tb_memset(&context, 0, sizeof(context));
+    context.count   = count;
+    context.pool    = tb_string_pool_init(tb_true);
+    context.map     = tb_hash_map_init(0, tb_element_str(tb_true), tb_element_size());
+    tb_spinlock_init(&context.lock);
+
+    // done
+    tb_size_t i = 0;
+    do
+    {
+        // check
+        tb_assert_and_check_break(context.pool && context.map);
+
+        // make keys, some keys are larger than the arena slot
+        for (i = 0; i < TB_DEMO_KEY_COUNT; i++)
+        {
+            tb_char_t data[512];
+            tb_size_t size = tb_snprintf(data, sizeof(data), "key-%lu-%s", i, (i & 63)? "name" : "a-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-long-name");
+            g_keys[i]   = tb_strdup(data);
+            g_sizes[i]  = size;
+            g_hashes[i] = tb_string_pool_hash(context.pool, data, size);
+            tb_assert_and_check_break(g_keys[i]);
+        }
+        tb_check_break(i == TB_DEMO_KEY_COUNT);
+
+        // insert the permanent keys
+        for (i = 0; i < TB_DEMO_KEY_COUNT / 2; i++)
+        {
+            g_permanents[i] = tb_string_pool_insert_permanent(context.pool, g_keys[i]);
+            tb_hash_map_insert(context.map, g_keys[i], (tb_pointer_t)1);
+        }
+
+        // trace
+        tb_trace_i("operations: %lu, keys: %lu, processors: %lu", count, (tb_size_t)TB_DEMO_KEY_COUNT, tb_processor_count());
+
+        // test
+        tb_size_t threads = 1;
+        while (1)
+        {
+            // the total operation count
+            tb_hong_t total = (tb_hong_t)count * threads;
+
+            // test them
+            tb_hong_t t_pool = tb_demo_string_pool_test(&context, tb_demo_string_pool_thread, threads);
+            tb_hong_t t_map  = tb_demo_string_pool_test(&context, tb_demo_hash_map_thread, threads);
+
+            // trace
+            tb_trace_i("threads: %2lu, string_pool: %lld ms, %lld ops/s, locked hash_map: %lld ms, %lld ops/s, errors: %ld"
+                    , threads
+                    , t_pool, total * 1000 / tb_max(t_pool, 1)
+                    , t_map, total * 1000 / tb_max(t_map, 1)
+                    , tb_atomic_get(&context.errors));
+
+            // next
+            if (threads >= thread_maxn) break;
+            threads = tb_min(threads << 1, thread_maxn);
+        }
+
+        // the permanent strings are still valid
+        for (i = 0; i < TB_DEMO_KEY_COUNT / 2; i++)
+        {
+            tb_string_pool_remove(context.pool, g_keys[i]);
+            if (tb_string_pool_find(context.pool, g_keys[i]) != g_permanents[i]) break;
+        }
+        tb_trace_i("permanent: %s", i == TB_DEMO_KEY_COUNT / 2? "ok" : "no");
+
+    } while (0);
+
+    // exit keys
+    for (i = 0; i < TB_DEMO_KEY_COUNT; i++)
+    {
+        if (g_keys[i]) tb_free(g_keys[i]);
+        g_keys[i] = tb_null;
+    }
+
+    // exit context
+    if (context.pool) tb_string_pool_exit(context.pool);
+    if (context.map) tb_hash_map_exit(context.map);
+    tb_spinlock_exit(&context.lock);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default domain count
+#define TB_DEMO_DOMAIN_COUNT        (10000)
+
+// the cookie count of each domain
+#define TB_DEMO_COOKIE_COUNT        (10)
+
+// the lookup count
+#define TB_DEMO_LOOKUP_COUNT        (100000)
+
+// the lookup count of the linear scan
+#define TB_DEMO_LINEAR_COUNT        (100)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the cookie paths
+static tb_char_t const* g_paths[] = {"/", "/a", "/a/b", "/a/b/c", "/x"};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_size_t tb_demo_cookies_count(tb_char_t const* value)
+{
+    // count "key=value; "
+    tb_size_t n = 0;
+    for (; value && *value; value++) if (*value == ';') n++;
+    return n;
+}
+static tb_size_t tb_demo_cookies_linear(tb_size_t domain_count, tb_size_t domain, tb_char_t const* path)
+{
+    /* the linear scan of all cookies, it is same as the old cookies implementation,
+     * the cookies of the parent domain: site.com, and this domain: sN.site.com
+     */
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_size_t   n = 0;
+    tb_char_t   cookie_domain[64];
+    tb_char_t   request_domain[64];
+    tb_snprintf(request_domain, sizeof(request_domain), "www.s%lu.site.com", domain);
+    for (i = 0; i < domain_count; i++)
+    {
+        tb_snprintf(cookie_domain, sizeof(cookie_domain), "s%lu.site.com", i);
+        for (j = 0; j < TB_DEMO_COOKIE_COUNT; j++)
+        {
+            // the domain is matched?
+            tb_size_t dn = tb_strlen(cookie_domain);
+            tb_size_t rn = tb_strlen(request_domain);
+            if (rn < dn || tb_strcmp(request_domain + rn - dn, cookie_domain) || (rn > dn && request_domain[rn - dn - 1] != '.')) continue;
+
+            // the path is matched?
+            tb_char_t const*    cpath = g_paths[j % tb_arrayn(g_paths)];
+            tb_size_t           pn = tb_strlen(cpath);
+            if (pn > 1 && (tb_strncmp(path, cpath, pn) || (path[pn] && path[pn] != '/'))) continue;
+            n++;
+        }
+    }
+    return n;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_cookies_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the domain count
+    tb_size_t domain_count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_DOMAIN_COUNT;
+    domain_count = tb_max(domain_count, 1);
+
+    // init cookies
+    tb_cookies_ref_t cookies = tb_cookies_init();
+    tb_assert_and_check_return_val(cookies, -1);
+
+    // set cookies
+    tb_size_t   i = 0;
+    tb_size_t   j = 0;
+    tb_char_t   value[256];
+    tb_char_t   domain[64];
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < domain_count; i++)
+    {
+        tb_snprintf(domain, sizeof(domain), "s%lu.site.com", i);
+        for (j = 0; j < TB_DEMO_COOKIE_COUNT; j++)
+        {
+            tb_snprintf(value, sizeof(value), "key%lu=value%lu; path=%s; domain=.%s; expires=Sun, 18 Jan 2038 00:00:00 GMT", j, i, g_paths[j % tb_arrayn(g_paths)], domain);
+            tb_cookies_set(cookies, tb_null, tb_null, tb_false, value);
+        }
+    }
+    tb_trace_i("set: %lu cookies, %lu domains, %lld ms", domain_count * TB_DEMO_COOKIE_COUNT, domain_count, tb_mclock() - time);
+
+    // the parent domain cookies with the expired cookies
+    tb_cookies_set(cookies, tb_null, tb_null, tb_false, "site=1; path=/; domain=.site.com; expires=Sun, 18 Jan 2038 00:00:00 GMT");
+    tb_cookies_set(cookies, tb_null, tb_null, tb_false, "old=1; path=/; domain=.site.com; expires=Thu, 01 Jan 2015 00:00:00 GMT");
+
+    // get cookies
+    tb_string_t result;
+    tb_string_init(&result);
+    tb_size_t   count = 0;
+    tb_random_reset(tb_true);
+    time = tb_mclock();
+    for (i = 0; i < TB_DEMO_LOOKUP_COUNT; i++)
+    {
+        tb_snprintf(domain, sizeof(domain), "www.s%lu.site.com", tb_random_range(0, domain_count));
+        count += tb_demo_cookies_count(tb_cookies_get(cookies, domain, "/a/b/c/index.html", tb_false, &result));
+    }
+    time = tb_mclock() - time;
+    tb_trace_i("get: %lu lookups, %lu cookies, %lld ms, %lld lookups/s", (tb_size_t)TB_DEMO_LOOKUP_COUNT, count, time, (tb_hong_t)TB_DEMO_LOOKUP_COUNT * 1000 / tb_max(time, 1));
+
+    // check the results with the linear scan, it also shows the cost of the full scan
+    tb_bool_t ok = tb_true;
+    time = tb_mclock();
+    for (i = 0; i < TB_DEMO_LINEAR_COUNT && ok; i++)
+    {
+        tb_size_t           k = tb_random_range(0, domain_count);
+        tb_char_t const*    path = g_paths[i % tb_arrayn(g_paths)];
+        tb_size_t           n = tb_demo_cookies_linear(domain_count, k, path) + 1;
+        tb_snprintf(domain, sizeof(domain), "www.s%lu.site.com", k);
+        if (tb_demo_cookies_count(tb_cookies_get(cookies, domain, path, tb_false, &result)) != n)
+        {
+            tb_trace_i("check: %s%s failed: %s", domain, path, tb_string_cstr(&result));
+            ok = tb_false;
+        }
+    }
+    time = tb_mclock() - time;
+    tb_trace_i("linear: %lu lookups, %lld ms, %lld lookups/s, check: %s", i, time, (tb_hong_t)i * 1000 / tb_max(time, 1), ok? "ok" : "no");
+
+    // exit cookies
+    tb_string_exit(&result);
+    tb_cookies_exit(cookies);
+    return 0;
+}
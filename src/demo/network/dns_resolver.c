@@ -0,0 +1,259 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the host count of the batch test
+#define TB_DEMO_HOST_COUNT          (32)
+
+// the coroutine count of the shared test
+#define TB_DEMO_COROUTINE_COUNT     (16)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the server is stopped?
+static tb_atomic_t  g_stop = 0;
+
+// the finished request count
+static tb_size_t    g_done = 0;
+
+// the failed request count
+static tb_size_t    g_fail = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+
+/* the stub dns server
+ *
+ * xxx.test:        A: 10.0.0.n, AAAA: fd00::n, ttl: 60s
+ * none.test:       NXDOMAIN
+ * drop.test:       drop the first query of each type to test retrying
+ */
+static tb_int_t tb_demo_dns_server(tb_cpointer_t priv)
+{
+    // the server socket
+    tb_socket_ref_t sock = (tb_socket_ref_t)priv;
+    tb_assert_and_check_return_val(sock, -1);
+
+    // done
+    tb_size_t   drops = 0;
+    tb_byte_t   data[512];
+    tb_ipaddr_t addr;
+    while (!tb_atomic_get(&g_stop))
+    {
+        // recv the query
+        tb_long_t size = tb_socket_urecv(sock, &addr, data, sizeof(data) - 64);
+        if (!size)
+        {
+            tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, 100);
+            continue;
+        }
+        tb_check_break(size > 12);
+
+        // get the name and the query type
+        tb_char_t   name[256];
+        tb_size_t   n = 0;
+        tb_byte_t*  p = data + 12;
+        tb_byte_t*  e = data + size;
+        while (p < e && *p && n + *p + 1 < sizeof(name))
+        {
+            if (n) name[n++] = '.';
+            tb_memcpy(name + n, p + 1, *p);
+            n += *p;
+            p += *p + 1;
+        }
+        name[n] = '\0';
+        p++;
+        tb_check_continue(p + 4 <= e);
+        tb_uint16_t type = tb_bits_get_u16_be(p);
+        p += 4;
+
+        // drop the first query of each type?
+        if (!tb_strcmp(name, "drop.test") && !(drops & (type == 1? 1 : 2)))
+        {
+            drops |= type == 1? 1 : 2;
+            continue;
+        }
+
+        // make the response header: qr, rd, ra
+        tb_size_t none = !tb_strcmp(name, "none.test");
+        tb_bits_set_u16_be(data + 2, none? 0x8183 : 0x8180);
+        tb_bits_set_u16_be(data + 6, none? 0 : 2);
+
+        // make the answers, the first answer is the cname record and it should be skipped
+        if (!none)
+        {
+            // the cname: name => alias.test
+            tb_bits_set_u16_be(p, 0xc00c);      p += 2;
+            tb_bits_set_u16_be(p, 5);           p += 2;
+            tb_bits_set_u16_be(p, 1);           p += 2;
+            tb_bits_set_u32_be(p, 60);          p += 4;
+            tb_bits_set_u16_be(p, 8);           p += 2;
+            tb_memcpy(p, "\5alias\xc0\x0c", 8); p += 8;
+
+            // the address
+            tb_size_t hash = tb_strlen(name) + name[n > 5? n - 6 : 0];
+            tb_bits_set_u16_be(p, 0xc00c);      p += 2;
+            tb_bits_set_u16_be(p, type);        p += 2;
+            tb_bits_set_u16_be(p, 1);           p += 2;
+            tb_bits_set_u32_be(p, 60);          p += 4;
+            if (type == 1)
+            {
+                tb_byte_t ipv4[4] = {10, 0, 0, (tb_byte_t)hash};
+                tb_bits_set_u16_be(p, 4);       p += 2;
+                tb_memcpy(p, ipv4, 4);          p += 4;
+            }
+            else
+            {
+                tb_byte_t ipv6[16] = {0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, (tb_byte_t)hash};
+                tb_bits_set_u16_be(p, 16);      p += 2;
+                tb_memcpy(p, ipv6, 16);         p += 16;
+            }
+        }
+
+        // send the response
+        tb_socket_usend(sock, &addr, data, p - data);
+    }
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_dns_resolver_func(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_t const* addrs, tb_size_t size, tb_cpointer_t priv)
+{
+    // trace
+    tb_size_t i = 0;
+    for (i = 0; i < size; i++) tb_trace_i("lookup: %s => %{ipaddr}", name, &addrs[i]);
+    if (!size) tb_trace_i("lookup: %s failed", name);
+
+    // the expected address count
+    tb_size_t expected = tb_p2u32(priv);
+    if (size == expected) g_done++;
+    else g_fail++;
+}
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+static tb_void_t tb_demo_dns_resolver_coroutine(tb_cpointer_t priv)
+{
+    // the resolver
+    tb_dns_resolver_ref_t resolver = (tb_dns_resolver_ref_t)priv;
+
+    // lookup the ipv4 address of the same scheduler by the shared resolver
+    tb_char_t   name[64];
+    tb_ipaddr_t addrs[4];
+    tb_snprintf(name, sizeof(name), "co%lu.test", (tb_size_t)tb_random_range(0, 1000000));
+    tb_size_t   size = tb_dns_resolver_done(resolver, name, TB_IPADDR_FAMILY_IPV4, addrs, tb_arrayn(addrs));
+    if (size == 1)
+    {
+        tb_trace_i("coroutine: %s => %{ipaddr}", name, &addrs[0]);
+        g_done++;
+    }
+    else g_fail++;
+}
+#endif
+static tb_void_t tb_demo_dns_resolver_system(tb_char_t const* name)
+{
+    // lookup it by the system dns servers
+    tb_dns_resolver_ref_t resolver = tb_dns_resolver_init();
+    if (resolver)
+    {
+        // done
+        tb_ipaddr_t addrs[8];
+        tb_hong_t   time = tb_mclock();
+        tb_size_t   size = tb_dns_resolver_done(resolver, name, TB_IPADDR_FAMILY_NONE, addrs, tb_arrayn(addrs));
+        time = tb_mclock() - time;
+
+        // trace
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) tb_trace_i("lookup: %s => %{ipaddr}, %lld ms", name, &addrs[i], time);
+        if (!size) tb_trace_i("lookup: %s failed", name);
+
+        // exit resolver
+        tb_dns_resolver_exit(resolver);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_dns_resolver_main(tb_int_t argc, tb_char_t** argv)
+{
+    // lookup the given host by the system dns servers
+    if (argv[1])
+    {
+        tb_demo_dns_resolver_system(argv[1]);
+        return 0;
+    }
+
+    // init the stub server
+    tb_ipaddr_t         addr;
+    tb_socket_ref_t     sock = tb_socket_init(TB_SOCKET_TYPE_UDP, TB_IPADDR_FAMILY_IPV4);
+    tb_thread_ref_t     thread = tb_null;
+    tb_ipaddr_set(&addr, "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+    if (sock && tb_socket_bind(sock, &addr) && tb_socket_local(sock, &addr))
+        thread = tb_thread_init(tb_null, tb_demo_dns_server, sock, 0);
+
+    // init resolver
+    tb_dns_resolver_ref_t resolver = tb_dns_resolver_init();
+    if (thread && resolver && tb_dns_resolver_server_add(resolver, &addr))
+    {
+        // post the batch requests
+        tb_size_t   i = 0;
+        tb_size_t   n = 0;
+        tb_char_t   name[64];
+        tb_hong_t   time = tb_mclock();
+        for (i = 0; i < TB_DEMO_HOST_COUNT; i++)
+        {
+            tb_snprintf(name, sizeof(name), "host%lu.test", i);
+            if (tb_dns_resolver_post(resolver, name, TB_IPADDR_FAMILY_NONE, tb_demo_dns_resolver_func, tb_u2p(2))) n++;
+        }
+        if (tb_dns_resolver_post(resolver, "none.test", TB_IPADDR_FAMILY_NONE, tb_demo_dns_resolver_func, tb_u2p(0))) n++;
+        if (tb_dns_resolver_post(resolver, "drop.test", TB_IPADDR_FAMILY_NONE, tb_demo_dns_resolver_func, tb_u2p(2))) n++;
+
+        // wait them
+        while (tb_dns_resolver_spak(resolver, -1) > 0) ;
+        tb_trace_i("batch: %lu requests, done: %lu, fail: %lu, %lld ms", n, g_done, g_fail, tb_mclock() - time);
+
+        // the cached requests will be finished directly
+        g_done = 0;
+        g_fail = 0;
+        tb_dns_resolver_post(resolver, "host1.test", TB_IPADDR_FAMILY_NONE, tb_demo_dns_resolver_func, tb_u2p(2));
+        tb_dns_resolver_post(resolver, "HOST2.test", TB_IPADDR_FAMILY_IPV6, tb_demo_dns_resolver_func, tb_u2p(1));
+        tb_trace_i("cached: done: %lu, fail: %lu, pending: %ld", g_done, g_fail, tb_dns_resolver_spak(resolver, 0));
+
+#ifdef TB_CONFIG_MODULE_HAVE_COROUTINE
+        // the coroutines share one resolver
+        g_done = 0;
+        g_fail = 0;
+        tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+        if (scheduler)
+        {
+            for (i = 0; i < TB_DEMO_COROUTINE_COUNT; i++)
+                tb_coroutine_start(scheduler, tb_demo_dns_resolver_coroutine, resolver, 0);
+            tb_co_scheduler_loop(scheduler, tb_true);
+            tb_co_scheduler_exit(scheduler);
+        }
+        tb_trace_i("coroutine: done: %lu, fail: %lu", g_done, g_fail);
+#endif
+    }
+
+    // exit resolver
+    if (resolver) tb_dns_resolver_exit(resolver);
+
+    // exit the stub server
+    tb_atomic_set(&g_stop, 1);
+    if (thread)
+    {
+        tb_thread_wait(thread, -1, tb_null);
+        tb_thread_exit(thread);
+    }
+    if (sock) tb_socket_exit(sock);
+    return 0;
+}
@@ -0,0 +1,409 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default request count
+#define TB_DEMO_REQUEST_COUNT       (200)
+
+// the pipelined request count
+#define TB_DEMO_PIPELINE_COUNT      (16)
+
+// the response content size
+#define TB_DEMO_CONTENT_SIZE        (4096)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the connection type of the local server
+typedef struct __tb_demo_connection_t
+{
+    // the socket
+    tb_socket_ref_t         sock;
+
+    // the received data
+    tb_buffer_t             data;
+
+    // is stale? it will be closed without any response for the next request
+    tb_bool_t               bstale;
+
+}tb_demo_connection_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the accepted connection count
+static tb_atomic_t          g_accepted = 0;
+
+// the opened connection count
+static tb_atomic_t          g_opened = 0;
+
+// the response content
+static tb_byte_t            g_content[TB_DEMO_CONTENT_SIZE];
+
+// is the remote server? we cannot check its response content
+static tb_bool_t            g_remote = tb_false;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+static tb_void_t tb_demo_server_respond(tb_demo_connection_t* conn, tb_char_t const* request, tb_bool_t* pclosed)
+{
+    // keep alive?
+    tb_bool_t balived = tb_strstr(request, "HTTP/1.1") && !tb_strstr(request, "Connection: close");
+    *pclosed = !balived;
+
+    /* close the stale connection without any response, like the server closing an idle kept-alive connection,
+     * the client has sent the request on the reused connection, so it need retry it on a new connection
+     */
+    if (conn->bstale)
+    {
+        *pclosed = tb_true;
+        return ;
+    }
+
+    // make it stale after responding this request?
+    conn->bstale = balived && !tb_strncmp(request, "GET /stale", 10);
+
+    // send the interim responses first, the client need skip them
+    if (!tb_strncmp(request, "GET /continue", 13))
+    {
+        tb_char_t const* interim = "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 103 Early Hints\r\nLink: </data>; rel=preload\r\n\r\n";
+        if (!tb_socket_bsend(conn->sock, (tb_byte_t const*)interim, tb_strlen(interim))) *pclosed = tb_true;
+    }
+
+    // the response head
+    tb_char_t head[256];
+    tb_bool_t bchunked = !tb_strncmp(request, "GET /chunked", 12);
+    tb_long_t size = bchunked?  tb_snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nConnection: %s\r\n\r\n", balived? "keep-alive" : "close")
+                            :   tb_snprintf(head, sizeof(head), "HTTP/1.1 200 OK\r\nContent-Length: %u\r\nConnection: %s\r\n\r\n", TB_DEMO_CONTENT_SIZE, balived? "keep-alive" : "close");
+    tb_check_return(size > 0);
+    if (!tb_socket_bsend(conn->sock, (tb_byte_t const*)head, size)) *pclosed = tb_true;
+
+    // the response content
+    if (bchunked)
+    {
+        // two chunks and the last chunk
+        tb_size_t half = TB_DEMO_CONTENT_SIZE >> 1;
+        size = tb_snprintf(head, sizeof(head), "%lx\r\n", half);
+        tb_socket_bsend(conn->sock, (tb_byte_t const*)head, size);
+        tb_socket_bsend(conn->sock, g_content, half);
+        size = tb_snprintf(head, sizeof(head), "\r\n%lx\r\n", TB_DEMO_CONTENT_SIZE - half);
+        tb_socket_bsend(conn->sock, (tb_byte_t const*)head, size);
+        tb_socket_bsend(conn->sock, g_content + half, TB_DEMO_CONTENT_SIZE - half);
+        tb_socket_bsend(conn->sock, (tb_byte_t const*)"\r\n0\r\n\r\n", 7);
+    }
+    else tb_socket_bsend(conn->sock, g_content, TB_DEMO_CONTENT_SIZE);
+}
+static tb_void_t tb_demo_server_exit(tb_poller_ref_t poller, tb_demo_connection_t* conn)
+{
+    tb_poller_remove(poller, conn->sock);
+    tb_socket_exit(conn->sock);
+    tb_buffer_exit(&conn->data);
+    tb_free(conn);
+    tb_atomic_fetch_and_dec(&g_opened);
+}
+static tb_void_t tb_demo_server_event(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // accept the new connections
+    if (!priv)
+    {
+        tb_socket_ref_t client = tb_null;
+        while ((client = tb_socket_accept(sock, tb_null)))
+        {
+            tb_demo_connection_t* conn = tb_malloc0_type(tb_demo_connection_t);
+            if (conn && tb_buffer_init(&conn->data))
+            {
+                conn->sock = client;
+                tb_poller_insert(poller, client, TB_POLLER_EVENT_RECV, conn);
+                tb_atomic_fetch_and_inc(&g_accepted);
+                tb_atomic_fetch_and_inc(&g_opened);
+            }
+            else
+            {
+                if (conn) tb_free(conn);
+                tb_socket_exit(client);
+            }
+        }
+        return ;
+    }
+
+    // read the requests
+    tb_demo_connection_t*   conn = (tb_demo_connection_t*)priv;
+    tb_byte_t               data[TB_STREAM_BLOCK_MAXN];
+    tb_long_t               real = tb_socket_recv(sock, data, sizeof(data));
+
+    // closed by the client? it is readable but no data
+    if (real <= 0)
+    {
+        tb_demo_server_exit(poller, conn);
+        return ;
+    }
+    tb_buffer_memncat(&conn->data, data, real);
+
+    // respond all received requests, they may be pipelined
+    tb_bool_t closed = tb_false;
+    while (!closed)
+    {
+        // the request head end
+        tb_char_t const*    request = (tb_char_t const*)tb_buffer_data(&conn->data);
+        tb_size_t           size = tb_buffer_size(&conn->data);
+        tb_size_t           end = 4;
+        while (end <= size && tb_strncmp(request + end - 4, "\r\n\r\n", 4)) end++;
+        tb_check_break(end <= size);
+
+        // respond it
+        tb_demo_server_respond(conn, request, &closed);
+
+        // remove this request
+        if (end < size) tb_buffer_memmov(&conn->data, end);
+        else tb_buffer_clear(&conn->data);
+    }
+
+    // close it
+    if (closed) tb_demo_server_exit(poller, conn);
+}
+static tb_int_t tb_demo_server_loop(tb_cpointer_t priv)
+{
+    // loop
+    tb_poller_ref_t poller = (tb_poller_ref_t)priv;
+    while (tb_poller_wait(poller, tb_demo_server_event, -1) >= 0) ;
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * client
+ */
+static tb_bool_t tb_demo_client_pipeline_func(tb_size_t index, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(status->code == 200 && size == TB_DEMO_CONTENT_SIZE && !tb_memcmp(data, g_content, size), tb_false);
+    return tb_true;
+}
+static tb_bool_t tb_demo_client_get(tb_http_ref_t http, tb_char_t const* url)
+{
+    // open it
+    tb_http_ctrl(http, TB_HTTP_OPTION_SET_URL, url);
+    if (!tb_http_open(http)) return tb_false;
+
+    // read the whole content
+    tb_bool_t ok = tb_false;
+    tb_byte_t data[TB_DEMO_CONTENT_SIZE];
+    tb_long_t real = 0;
+    tb_size_t read = 0;
+    do
+    {
+        // read the content of the remote server until the end
+        if (g_remote)
+        {
+            tb_http_status_t const* status = tb_http_status(http);
+            while ((status->bchunked || status->content_size < 0 || read < status->content_size) && (real = tb_http_read(http, data, sizeof(data))) >= 0)
+            {
+                if (real) read += real;
+                else if (tb_http_wait(http, TB_SOCKET_EVENT_RECV, -1) <= 0) break;
+            }
+            ok = status->code == 200;
+            break;
+        }
+
+        // read the content of the local server
+        while (read < sizeof(data) && (real = tb_http_read(http, data + read, sizeof(data) - read)) >= 0)
+        {
+            if (real) read += real;
+            else if (tb_http_wait(http, TB_SOCKET_EVENT_RECV, -1) <= 0) break;
+        }
+        tb_check_break(read == sizeof(data) && !tb_memcmp(data, g_content, read));
+
+        // read the end of the chunked content
+        if (tb_http_status(http)->bchunked && tb_http_read(http, data, sizeof(data)) > 0) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // close it
+    tb_http_clos(http);
+    return ok;
+}
+static tb_void_t tb_demo_client_test(tb_char_t const** urls, tb_size_t urls_size, tb_size_t count, tb_bool_t balived)
+{
+    // init http
+    tb_http_ref_t http = tb_http_init();
+    tb_assert_and_check_return(http);
+
+    // keep alive?
+    tb_http_ctrl(http, TB_HTTP_OPTION_SET_KEEP_ALIVE, balived);
+
+    // get it
+    tb_size_t i = 0;
+    tb_size_t accepted = tb_atomic_get(&g_accepted);
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        if (!tb_demo_client_get(http, urls[i % urls_size])) break;
+    }
+    time = tb_max(tb_mclock() - time, 1);
+
+    // trace
+    tb_trace_i("%s: hosts: %lu, keep-alive: %s, requests: %lu/%lu, connections: %lu, time: %lld ms, %lld requests/s"
+            ,   urls[0], urls_size, balived? "on" : "off", i, count, tb_atomic_get(&g_accepted) - accepted, time, (tb_hong_t)i * 1000 / time);
+
+    // exit http
+    tb_http_exit(http);
+}
+static tb_void_t tb_demo_client_pipeline(tb_char_t const** urls_pipelined, tb_size_t urls_pipelined_size, tb_size_t count)
+{
+    // init http
+    tb_http_ref_t http = tb_http_init();
+    tb_assert_and_check_return(http);
+
+    // the urls
+    tb_size_t           i = 0;
+    tb_char_t const*    urls[TB_DEMO_PIPELINE_COUNT];
+    for (i = 0; i < tb_arrayn(urls); i++) urls[i] = urls_pipelined[i % urls_pipelined_size];
+
+    // get them
+    tb_size_t done = 0;
+    tb_size_t accepted = tb_atomic_get(&g_accepted);
+    tb_hong_t time = tb_mclock();
+    for (i = 0; i < count; i++)
+    {
+        tb_size_t real = tb_http_pipeline(http, urls, tb_arrayn(urls), tb_demo_client_pipeline_func, tb_null);
+        done += real;
+        tb_check_break(real == tb_arrayn(urls));
+    }
+    time = tb_max(tb_mclock() - time, 1);
+
+    // trace
+    tb_trace_i("pipeline: requests: %lu/%lu, connections: %lu, time: %lld ms, %lld requests/s"
+            ,   done, count * tb_arrayn(urls), tb_atomic_get(&g_accepted) - accepted, time, (tb_hong_t)done * 1000 / time);
+
+    // exit http
+    tb_http_exit(http);
+}
+
+static tb_void_t tb_demo_client_remote(tb_char_t const* url, tb_size_t count)
+{
+    // we cannot check the content and the connection count of the remote server
+    g_remote = tb_true;
+
+    /* the first connection need the full ssl handshake,
+     * and the next short connections will resume the ssl session of this host
+     */
+    tb_http_pool_clear(tb_http_pool());
+    tb_demo_client_test(&url, 1, 1, tb_false);
+    tb_demo_client_test(&url, 1, count, tb_false);
+
+    // the kept-alive connections from the pool
+    tb_demo_client_test(&url, 1, count, tb_true);
+    g_remote = tb_false;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_http_pool_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the request count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_REQUEST_COUNT;
+    count = tb_max(count, 1);
+
+    // init content
+    tb_size_t i = 0;
+    for (i = 0; i < sizeof(g_content); i++) g_content[i] = (tb_byte_t)('a' + (i % 26));
+
+    // done
+    tb_socket_ref_t socks[2] = {tb_null};
+    tb_poller_ref_t poller = tb_null;
+    tb_thread_ref_t thread = tb_null;
+    do
+    {
+        // init poller
+        poller = tb_poller_init(tb_null);
+        tb_assert_and_check_break(poller);
+
+        // init the local servers of two hosts with the different ports
+        tb_ipaddr_t addrs[2];
+        for (i = 0; i < tb_arrayn(socks); i++)
+        {
+            socks[i] = tb_socket_init(TB_SOCKET_TYPE_TCP, TB_IPADDR_FAMILY_IPV4);
+            tb_assert_and_check_break(socks[i]);
+            tb_ipaddr_set(&addrs[i], "127.0.0.1", 0, TB_IPADDR_FAMILY_IPV4);
+            if (!tb_socket_bind(socks[i], &addrs[i]) || !tb_socket_listen(socks[i], 64) || !tb_socket_local(socks[i], &addrs[i])) break;
+            if (!tb_poller_insert(poller, socks[i], TB_POLLER_EVENT_ACPT, tb_null)) break;
+        }
+        tb_check_break(i == tb_arrayn(socks));
+
+        // init the server thread
+        thread = tb_thread_init(tb_null, tb_demo_server_loop, poller, 0);
+        tb_assert_and_check_break(thread);
+
+        // the urls
+        tb_char_t url[64];
+        tb_char_t url_other[64];
+        tb_char_t url_chunked[64];
+        tb_char_t url_stale[64];
+        tb_char_t url_continue[64];
+        tb_snprintf(url, sizeof(url), "http://127.0.0.1:%u/data", tb_ipaddr_port(&addrs[0]));
+        tb_snprintf(url_other, sizeof(url_other), "http://127.0.0.1:%u/data", tb_ipaddr_port(&addrs[1]));
+        tb_snprintf(url_chunked, sizeof(url_chunked), "http://127.0.0.1:%u/chunked", tb_ipaddr_port(&addrs[0]));
+        tb_snprintf(url_stale, sizeof(url_stale), "http://127.0.0.1:%u/stale", tb_ipaddr_port(&addrs[0]));
+        tb_snprintf(url_continue, sizeof(url_continue), "http://127.0.0.1:%u/continue", tb_ipaddr_port(&addrs[0]));
+        tb_char_t const* urls[] = {url, url_other};
+        tb_char_t const* urls_chunked[] = {url_chunked};
+        tb_char_t const* urls_stale[] = {url_stale};
+        tb_char_t const* urls_pipelined[] = {url, url_chunked, url_continue};
+
+        // test the short connections and the kept-alive connections from the pool
+        tb_demo_client_test(urls, 1, count, tb_false);
+        tb_demo_client_test(urls, 1, count, tb_true);
+        tb_demo_client_test(urls_chunked, 1, count, tb_false);
+        tb_demo_client_test(urls_chunked, 1, count, tb_true);
+
+        // test the alternate hosts, each host will reuse its own kept-alive connection
+        tb_demo_client_test(urls, tb_arrayn(urls), count, tb_true);
+
+        /* test the stale kept-alive connections closed by the server,
+         * each request will be retried on a new connection after the reused connection has been closed
+         */
+        tb_demo_client_test(urls_stale, 1, count, tb_true);
+
+        // test the pipelining, the interim responses of the continue url must not be returned as its response
+        tb_demo_client_pipeline(urls_pipelined, tb_arrayn(urls_pipelined), tb_max(count / TB_DEMO_PIPELINE_COUNT, 1));
+
+        // test the remote server, e.g. resume the ssl sessions of https://host/path
+        if (argv[1] && argv[2]) tb_demo_client_remote(argv[2], count);
+
+        // close all idle connections
+#ifdef __tb_debug__
+        tb_http_pool_dump(tb_http_pool());
+#endif
+        tb_http_pool_clear(tb_http_pool());
+
+        // wait the server to close all connections
+        tb_size_t tryn = 100;
+        while (tb_atomic_get(&g_opened) && tryn--) tb_msleep(10);
+
+    } while (0);
+
+    // exit the server
+    if (thread)
+    {
+        tb_poller_kill(poller);
+        tb_thread_wait(thread, -1, tb_null);
+        tb_thread_exit(thread);
+    }
+    if (poller) tb_poller_exit(poller);
+    for (i = 0; i < tb_arrayn(socks); i++)
+    {
+        if (socks[i]) tb_socket_exit(socks[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the port
+#define TB_DEMO_PORT        (8080)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_bool_t tb_demo_http_server_handler(tb_http_server_session_ref_t session, tb_http_server_request_t const* request, tb_cpointer_t priv)
+{
+    // hello
+    if (!tb_strcmp(request->path, "/hello"))
+        return tb_http_server_response_data(session, TB_HTTP_CODE_OK, "text/plain", (tb_byte_t const*)"hello world!", 12);
+
+    // echo the request body
+    if (!tb_strcmp(request->path, "/echo"))
+    {
+        tb_char_t const* type = tb_http_server_request_head(request, "Content-Type");
+        return tb_http_server_response_data(session, TB_HTTP_CODE_OK, type? type : "application/octet-stream", request->body, request->body_size);
+    }
+
+    // the chunked response
+    if (!tb_strcmp(request->path, "/chunk"))
+    {
+        tb_size_t i = 0;
+        tb_char_t line[64];
+        if (!tb_http_server_response_chunk_init(session, TB_HTTP_CODE_OK, "text/plain")) return tb_true;
+        for (i = 0; i < 100; i++)
+        {
+            tb_long_t n = tb_snprintf(line, sizeof(line), "line: %lu, args: %s\n", i, request->args? request->args : "");
+            if (n <= 0 || !tb_http_server_response_chunk_writ(session, (tb_byte_t const*)line, n)) break;
+        }
+        return tb_http_server_response_chunk_exit(session);
+    }
+
+    // respond the static file
+    return tb_false;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_http_server_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init server
+    tb_http_server_ref_t server = tb_http_server_init(tb_null, TB_DEMO_PORT, argv[1] && argv[2]? tb_atoi(argv[2]) : 0);
+    if (server)
+    {
+        // init the root directory
+        tb_char_t rootdir[TB_PATH_MAXN];
+        if (argv[1]) tb_strlcpy(rootdir, argv[1], sizeof(rootdir));
+        else tb_directory_current(rootdir, sizeof(rootdir));
+
+        // init server
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_FUNC, tb_demo_http_server_handler, tb_null);
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_ROOTDIR, rootdir);
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_GZIP, tb_true);
+
+        // trace
+        tb_trace_i("listening: %u, rootdir: %s", TB_DEMO_PORT, rootdir);
+
+        // run server
+        tb_http_server_loop(server);
+
+        // exit server
+        tb_http_server_exit(server);
+    }
+    return 0;
+}
@@ -0,0 +1,444 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default connection count
+#define TB_DEMO_CONNECTION_COUNT    (64)
+
+// the default duration, seconds
+#define TB_DEMO_DURATION            (5)
+
+// the thread maxn
+#define TB_DEMO_THREAD_MAXN         (64)
+
+// the timeout
+#define TB_DEMO_TIMEOUT             (10000)
+
+// the response content
+#define TB_DEMO_CONTENT             "hello world!"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the connection type
+typedef struct __tb_demo_connection_t
+{
+    // the finished request count
+    tb_size_t               requests;
+
+    // the failed request count
+    tb_size_t               errors;
+
+    // the latency sum of all batches, us
+    tb_hong_t               latency;
+
+    // the max latency, us
+    tb_hong_t               latency_max;
+
+    // the batch count
+    tb_size_t               batches;
+
+    // the response size of the current response, zero if the head is not finished
+    tb_size_t               need;
+
+    // the received size
+    tb_size_t               size;
+
+    // the received data
+    tb_byte_t               data[65536];
+
+}tb_demo_connection_t;
+
+// the client thread type
+typedef struct __tb_demo_client_t
+{
+    // the connections
+    tb_demo_connection_t*   conns;
+
+    // the connection count
+    tb_size_t               count;
+
+    // the thread
+    tb_thread_ref_t         thread;
+
+}tb_demo_client_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the server address
+static tb_ipaddr_t          g_addr;
+
+// the pipelined request count
+static tb_size_t            g_pipeline = 1;
+
+// the stop time, ms
+static tb_hong_t            g_stoptime = 0;
+
+// the requests
+static tb_char_t            g_requests[8192];
+
+// the requests size
+static tb_size_t            g_requests_size = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * server
+ */
+static tb_bool_t tb_demo_server_handler(tb_http_server_session_ref_t session, tb_http_server_request_t const* request, tb_cpointer_t priv)
+{
+    /* check the post request, the path, arguments and heads must be still valid after the large body is received
+     *
+     * the body is filled by the index of every byte
+     */
+    if (request->method == TB_HTTP_METHOD_POST)
+    {
+        tb_char_t const*    check = tb_http_server_request_head(request, "X-Check");
+        tb_bool_t           ok = !tb_strcmp(request->path, "/post") && request->args && !tb_strcmp(request->args, "a=1") && check && !tb_strcmp(check, "body");
+        tb_size_t           i = 0;
+
+        // the path and heads must be in the same request data before the body, the freed data may be still readable
+        if (ok && request->body_size)
+        {
+            tb_byte_t const* head = request->body - 65536;
+            ok = (tb_byte_t const*)request->path < request->body && (tb_byte_t const*)request->path >= head
+                && (tb_byte_t const*)check < request->body && (tb_byte_t const*)check >= head;
+        }
+        for (i = 0; ok && i < request->body_size; i++)
+            ok = request->body[i] == (tb_byte_t)i;
+        return tb_http_server_response_data(session, ok? TB_HTTP_CODE_OK : TB_HTTP_CODE_BAD_REQUEST, "text/plain", (tb_byte_t const*)TB_DEMO_CONTENT, sizeof(TB_DEMO_CONTENT) - 1);
+    }
+    return tb_http_server_response_data(session, TB_HTTP_CODE_OK, "text/plain", (tb_byte_t const*)TB_DEMO_CONTENT, sizeof(TB_DEMO_CONTENT) - 1);
+}
+static tb_int_t tb_demo_server_loop(tb_cpointer_t priv)
+{
+    tb_http_server_loop((tb_http_server_ref_t)priv);
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * client
+ */
+static tb_bool_t tb_demo_client_recv(tb_demo_connection_t* conn, tb_socket_ref_t sock)
+{
+    tb_long_t wait = 0;
+    while (1)
+    {
+        // parse the response head
+        if (!conn->need)
+        {
+            tb_size_t i = 0;
+            for (i = 0; i + 3 < conn->size; i++)
+            {
+                if (conn->data[i] == '\r' && conn->data[i + 1] == '\n' && conn->data[i + 2] == '\r' && conn->data[i + 3] == '\n')
+                    break;
+            }
+            if (i + 3 < conn->size)
+            {
+                // get the content size
+                conn->data[i] = '\0';
+                tb_char_t const* p = tb_stristr((tb_char_t const*)conn->data, "Content-Length:");
+                conn->need = i + 4 + (p? tb_atoi(p + 15) : 0);
+                tb_assert_and_check_return_val(conn->need <= sizeof(conn->data), tb_false);
+
+                // failed?
+                if (tb_strncmp((tb_char_t const*)conn->data + 9, "200", 3)) conn->errors++;
+            }
+        }
+
+        // the response has been finished?
+        if (conn->need && conn->size >= conn->need)
+        {
+            if (conn->size > conn->need) tb_memmov(conn->data, conn->data + conn->need, conn->size - conn->need);
+            conn->size -= conn->need;
+            conn->need = 0;
+            return tb_true;
+        }
+
+        // recv it
+        tb_long_t real = tb_socket_recv(sock, conn->data + conn->size, sizeof(conn->data) - conn->size);
+        if (real > 0)
+        {
+            conn->size += real;
+            wait = 0;
+        }
+        else if (!real && !wait)
+        {
+            wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, TB_DEMO_TIMEOUT);
+            tb_check_break(wait > 0);
+        }
+        else break;
+    }
+    return tb_false;
+}
+static tb_void_t tb_demo_client_connection(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_connection_t* conn = (tb_demo_connection_t*)priv;
+    tb_assert_and_check_return(conn);
+
+    // init socket
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&g_addr));
+    tb_assert_and_check_return(sock);
+
+    // done
+    do
+    {
+        // connect it
+        tb_long_t ok = -1;
+        while (!(ok = tb_socket_connect(sock, &g_addr)))
+        {
+            if (tb_socket_wait(sock, TB_SOCKET_EVENT_CONN, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        tb_check_break(ok > 0);
+
+        // send the pipelined requests and recv all responses until the stop time
+        while (tb_mclock() < g_stoptime)
+        {
+            // send requests
+            tb_hong_t time = tb_uclock();
+            if (!tb_socket_bsend(sock, (tb_byte_t const*)g_requests, g_requests_size)) break;
+
+            // recv responses
+            tb_size_t i = 0;
+            for (i = 0; i < g_pipeline; i++)
+            {
+                if (!tb_demo_client_recv(conn, sock)) break;
+                conn->requests++;
+            }
+            tb_check_break(i == g_pipeline);
+
+            // update the latency
+            time = tb_uclock() - time;
+            conn->latency += time;
+            if (time > conn->latency_max) conn->latency_max = time;
+            conn->batches++;
+        }
+
+    } while (0);
+
+    // exit socket
+    tb_socket_exit(sock);
+}
+static tb_bool_t tb_demo_client_post(tb_size_t size)
+{
+    // init socket
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(&g_addr));
+    tb_assert_and_check_return_val(sock, tb_false);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_byte_t*              body = tb_null;
+    tb_demo_connection_t*   conn = tb_null;
+    do
+    {
+        // connect it
+        tb_long_t conn_ok = -1;
+        while (!(conn_ok = tb_socket_connect(sock, &g_addr)))
+        {
+            if (tb_socket_wait(sock, TB_SOCKET_EVENT_CONN, TB_DEMO_TIMEOUT) <= 0) break;
+        }
+        tb_check_break(conn_ok > 0);
+
+        // make body
+        body = tb_malloc_bytes(size);
+        tb_assert_and_check_break(body);
+        tb_size_t i = 0;
+        for (i = 0; i < size; i++) body[i] = (tb_byte_t)i;
+
+        // send the head and body
+        tb_char_t head[256];
+        tb_long_t n = tb_snprintf(head, sizeof(head), "POST /post?a=1 HTTP/1.1\r\nHost: %{ipaddr}\r\nX-Check: body\r\nContent-Length: %lu\r\n\r\n", &g_addr, size);
+        tb_assert_and_check_break(n > 0);
+        if (!tb_socket_bsend(sock, (tb_byte_t const*)head, n) || !tb_socket_bsend(sock, body, size)) break;
+
+        // recv response
+        conn = tb_malloc0_type(tb_demo_connection_t);
+        tb_assert_and_check_break(conn);
+        if (!tb_demo_client_recv(conn, sock)) break;
+
+        // ok?
+        ok = !conn->errors;
+
+    } while (0);
+
+    // trace
+    tb_trace_i("post: %lu bytes: %s", size, ok? "ok" : "failed");
+
+    // exit it
+    if (conn) tb_free(conn);
+    if (body) tb_free(body);
+    tb_socket_exit(sock);
+    return ok;
+}
+static tb_int_t tb_demo_client_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_client_t* client = (tb_demo_client_t*)priv;
+    tb_assert_and_check_return_val(client, -1);
+
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    if (scheduler)
+    {
+        // start all connections
+        tb_size_t i = 0;
+        for (i = 0; i < client->count; i++)
+            tb_coroutine_start(scheduler, tb_demo_client_connection, &client->conns[i], 0);
+
+        // run scheduler
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+        // exit scheduler
+        tb_co_scheduler_exit(scheduler);
+    }
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_network_http_server_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the connection count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_CONNECTION_COUNT;
+    count = tb_max(count, 1);
+
+    // the duration
+    tb_size_t duration = (argv[1] && argv[2])? tb_atoi(argv[2]) : TB_DEMO_DURATION;
+    duration = tb_max(duration, 1);
+
+    // the pipelined request count
+    g_pipeline = (argv[1] && argv[2] && argv[3])? tb_atoi(argv[3]) : 1;
+    g_pipeline = tb_max(g_pipeline, 1);
+
+    // the external server address, e.g. 127.0.0.1:8080 of "demo coroutine_http_server hello"
+    tb_char_t const* external = (argv[1] && argv[2] && argv[3])? argv[4] : tb_null;
+
+    // done
+    tb_http_server_ref_t    server = tb_null;
+    tb_thread_ref_t         server_thread = tb_null;
+    tb_demo_client_t        clients[TB_DEMO_THREAD_MAXN];
+    tb_demo_connection_t*   conns = tb_null;
+    tb_size_t               threads = 0;
+    tb_memset(clients, 0, sizeof(clients));
+    do
+    {
+        // init the server address
+        if (external)
+        {
+            tb_char_t host[256];
+            tb_strlcpy(host, external, sizeof(host));
+            tb_char_t* port = tb_strchr(host, ':');
+            if (port) *port++ = '\0';
+            if (!tb_ipaddr_set(&g_addr, host, port? tb_atoi(port) : 80, TB_IPADDR_FAMILY_IPV4)) break;
+        }
+        // run the library server in process
+        else
+        {
+            server = tb_http_server_init("127.0.0.1", 0, 0);
+            tb_assert_and_check_break(server);
+            tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_FUNC, tb_demo_server_handler, tb_null);
+
+            // disable the keep-alive timeout like the demo server for comparing them
+            tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_TIMEOUT, (tb_long_t)-1);
+
+            tb_uint16_t port = 0;
+            tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_GET_PORT, &port);
+            tb_ipaddr_set(&g_addr, "127.0.0.1", port, TB_IPADDR_FAMILY_IPV4);
+
+            server_thread = tb_thread_init(tb_null, tb_demo_server_loop, server, 0);
+            tb_assert_and_check_break(server_thread);
+
+            // check the small and large post requests, the request buffer will be grown for the large body
+            static tb_size_t s_sizes[] = {16, 8192, 200 * 1024, 1 << 20};
+            tb_size_t j = 0;
+            for (j = 0; j < tb_arrayn(s_sizes); j++) tb_demo_client_post(s_sizes[j]);
+        }
+
+        // make the pipelined requests
+        tb_size_t i = 0;
+        for (i = 0; i < g_pipeline; i++)
+        {
+            tb_long_t n = tb_snprintf(g_requests + g_requests_size, sizeof(g_requests) - g_requests_size, "GET / HTTP/1.1\r\nHost: %{ipaddr}\r\nConnection: keep-alive\r\n\r\n", &g_addr);
+            tb_assert_and_check_break(n > 0 && g_requests_size + n < sizeof(g_requests));
+            g_requests_size += n;
+        }
+        tb_check_break(i == g_pipeline);
+
+        // init connections
+        conns = tb_nalloc0_type(count, tb_demo_connection_t);
+        tb_assert_and_check_break(conns);
+
+        // init the client threads
+        threads = tb_min(tb_min(tb_processor_count(), count), TB_DEMO_THREAD_MAXN);
+        threads = tb_max(threads, 1);
+        g_stoptime = tb_mclock() + duration * 1000;
+        for (i = 0; i < threads; i++)
+        {
+            clients[i].conns = conns + i * (count / threads);
+            clients[i].count = (i + 1 < threads)? count / threads : count - i * (count / threads);
+            clients[i].thread = tb_thread_init(tb_null, tb_demo_client_loop, &clients[i], 0);
+            tb_assert_and_check_break(clients[i].thread);
+        }
+
+        // wait the client threads
+        tb_hong_t time = tb_mclock();
+        for (i = 0; i < threads; i++)
+        {
+            if (clients[i].thread)
+            {
+                tb_thread_wait(clients[i].thread, -1, tb_null);
+                tb_thread_exit(clients[i].thread);
+                clients[i].thread = tb_null;
+            }
+        }
+        time = tb_max(tb_mclock() - time, 1);
+
+        // sum the results
+        tb_size_t requests = 0;
+        tb_size_t errors = 0;
+        tb_size_t batches = 0;
+        tb_hong_t latency = 0;
+        tb_hong_t latency_max = 0;
+        for (i = 0; i < count; i++)
+        {
+            requests += conns[i].requests;
+            errors += conns[i].errors;
+            batches += conns[i].batches;
+            latency += conns[i].latency;
+            if (conns[i].latency_max > latency_max) latency_max = conns[i].latency_max;
+        }
+
+        // trace
+        tb_trace_i("%s: threads: %lu, connections: %lu, pipeline: %lu, requests: %lu, errors: %lu, time: %lld ms, %lld requests/s, latency: avg %lld us, max %lld us"
+                ,   external? external : "http_server"
+                ,   threads, count, g_pipeline, requests, errors, time
+                ,   (tb_hong_t)requests * 1000 / time
+                ,   batches? latency / batches : 0
+                ,   latency_max);
+
+    } while (0);
+
+    // exit the library server
+    if (server)
+    {
+        tb_http_server_kill(server);
+        if (server_thread)
+        {
+            tb_thread_wait(server_thread, -1, tb_null);
+            tb_thread_exit(server_thread);
+        }
+        tb_http_server_exit(server);
+    }
+
+    // exit connections
+    if (conns) tb_free(conns);
+    return 0;
+}
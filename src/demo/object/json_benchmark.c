@@ -0,0 +1,125 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include "../../tbox/object/impl/reader/json.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default record count, about 8MB json data
+#define TB_DEMO_RECORD_COUNT        (20000)
+
+// the test loop count
+#define TB_DEMO_LOOP_COUNT          (5)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_json_make(tb_string_ref_t json, tb_size_t count)
+{
+    // make records
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    tb_string_cstrcat(json, "[\n");
+    for (i = 0; i < count; i++)
+    {
+        tb_size_t value = tb_random_value();
+        tb_string_cstrfcat(json, "    {\n");
+        tb_string_cstrfcat(json, "        \"id\": %lu,\n", i);
+        tb_string_cstrfcat(json, "        \"offset\": -%lu,\n", value & 0xffffff);
+        tb_string_cstrfcat(json, "        \"score\": %lu.%lu,\n", value % 100, value % 1000);
+        tb_string_cstrfcat(json, "        \"name\": \"record-%lx-abcdefghijklmnopqrstuvwxyz-0123456789\",\n", value);
+        tb_string_cstrfcat(json, "        \"text\": \"quoted \\\"%lu\\\", escaped \\\\ path, unicode \\u00e9\\u4e2d\",\n", value);
+        tb_string_cstrfcat(json, "        \"enabled\": %s,\n", (value & 1)? "true" : "false");
+        tb_string_cstrfcat(json, "        \"parent\": null,\n");
+        tb_string_cstrfcat(json, "        \"tags\": [\"alpha\", \"beta\", %lu, %lu, []],\n", value & 0xff, value & 0xffff);
+        tb_string_cstrfcat(json, "        \"point\": {\"x\": %lu, \"y\": -%lu, \"z\": {}}\n", value & 0xfff, (value >> 12) & 0xfff);
+        tb_string_cstrfcat(json, "    }%s\n", i + 1 < count? "," : "");
+    }
+    tb_string_cstrcat(json, "]\n");
+}
+static tb_object_ref_t tb_demo_json_read(tb_string_ref_t json, tb_size_t mode, tb_hong_t* ptime)
+{
+    // set mode
+    tb_oc_json_reader_mode_set(mode);
+
+    // read it
+    tb_size_t       i = 0;
+    tb_object_ref_t object = tb_null;
+    tb_hong_t       time = tb_mclock();
+    for (i = 0; i < TB_DEMO_LOOP_COUNT; i++)
+    {
+        if (object) tb_object_exit(object);
+        object = tb_object_read_from_data((tb_byte_t const*)tb_string_cstr(json), tb_string_size(json));
+        tb_assert_and_check_break(object);
+    }
+    *ptime = (tb_mclock() - time) / TB_DEMO_LOOP_COUNT;
+
+    // restore the default mode
+    tb_oc_json_reader_mode_set(TB_OC_JSON_READER_MODE_BUFFER);
+    return object;
+}
+static tb_bool_t tb_demo_json_equal(tb_object_ref_t object1, tb_object_ref_t object2, tb_size_t size)
+{
+    // done
+    tb_bool_t   ok = tb_false;
+    tb_byte_t*  data1 = tb_null;
+    tb_byte_t*  data2 = tb_null;
+    do
+    {
+        // make data
+        size = (size << 1) + 4096;
+        data1 = tb_malloc_bytes(size);
+        data2 = tb_malloc_bytes(size);
+        tb_assert_and_check_break(data1 && data2);
+
+        // writ them as the binary format
+        tb_long_t size1 = tb_object_writ_to_data(object1, data1, size, TB_OBJECT_FORMAT_BIN);
+        tb_long_t size2 = tb_object_writ_to_data(object2, data2, size, TB_OBJECT_FORMAT_BIN);
+        tb_check_break(size1 > 0 && size1 == size2);
+
+        // equal?
+        ok = !tb_memcmp(data1, data2, size1);
+
+    } while (0);
+
+    // exit data
+    if (data1) tb_free(data1);
+    if (data2) tb_free(data2);
+    return ok;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_object_json_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init json
+    tb_string_t json;
+    if (!tb_string_init(&json)) return -1;
+
+    // make json
+    tb_demo_json_make(&json, argv[1]? tb_atoi(argv[1]) : TB_DEMO_RECORD_COUNT);
+    tb_size_t size = tb_string_size(&json);
+
+    // read it
+    tb_hong_t       t_stream = 0;
+    tb_hong_t       t_buffer = 0;
+    tb_object_ref_t object_stream = tb_demo_json_read(&json, TB_OC_JSON_READER_MODE_STREAM, &t_stream);
+    tb_object_ref_t object_buffer = tb_demo_json_read(&json, TB_OC_JSON_READER_MODE_BUFFER, &t_buffer);
+
+    // trace
+    tb_trace_i("size: %lu bytes, equal: %s", size, (object_stream && object_buffer && tb_demo_json_equal(object_stream, object_buffer, size))? "ok" : "no");
+    tb_trace_i("stream: %lld ms, %lld MB/s", t_stream, (tb_hong_t)size * 1000 / tb_max(t_stream, 1) / (1024 * 1024));
+    tb_trace_i("buffer: %lld ms, %lld MB/s", t_buffer, (tb_hong_t)size * 1000 / tb_max(t_buffer, 1) / (1024 * 1024));
+
+    // exit objects
+    if (object_stream) tb_object_exit(object_stream);
+    if (object_buffer) tb_object_exit(object_buffer);
+
+    // exit json
+    tb_string_exit(&json);
+    return 0;
+}
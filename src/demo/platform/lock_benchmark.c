@@ -0,0 +1,197 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+#include <time.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the thread maxn
+#define TB_DEMO_THREAD_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the lock type
+typedef enum __tb_demo_lock_type_e
+{
+    TB_DEMO_LOCK_TYPE_SPINLOCK      = 0     //!< the spin-then-park spinlock
+,   TB_DEMO_LOCK_TYPE_YIELD         = 1     //!< the old spinlock, spin and yield forever
+,   TB_DEMO_LOCK_TYPE_MUTEX         = 2     //!< the mutex
+
+}tb_demo_lock_type_e;
+
+// the benchmark type
+typedef struct __tb_demo_lock_benchmark_t
+{
+    // the lock type
+    tb_size_t           type;
+
+    // the loop count of each thread
+    tb_size_t           loop;
+
+    // the hold time (us), only spin it if be zero
+    tb_size_t           hold;
+
+    // the spinlock
+    tb_spinlock_t       spinlock;
+
+    // the mutex
+    tb_mutex_ref_t      mutex;
+
+    // the value
+    tb_size_t           value;
+
+}tb_demo_lock_benchmark_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_lock_yield_enter(tb_spinlock_ref_t lock)
+{
+    // spin it five times and yield the processor forever
+    tb_size_t tryn = 5;
+    while (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
+    {
+        if (!tryn--)
+        {
+            tb_sched_yield();
+            tryn = 5;
+        }
+    }
+}
+static tb_void_t tb_demo_lock_yield_leave(tb_spinlock_ref_t lock)
+{
+    tb_atomic_set0((tb_atomic_t*)lock);
+}
+static tb_void_t tb_demo_lock_work(tb_size_t count)
+{
+    __tb_volatile__ tb_size_t i = 0;
+    for (i = 0; i < count; i++) ;
+}
+static tb_int_t tb_demo_lock_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_demo_lock_benchmark_t* benchmark = (tb_demo_lock_benchmark_t*)priv;
+    tb_assert_and_check_return_val(benchmark, -1);
+
+    // loop
+    tb_size_t n = benchmark->loop;
+    while (n--)
+    {
+        // enter
+        switch (benchmark->type)
+        {
+        case TB_DEMO_LOCK_TYPE_SPINLOCK:    tb_spinlock_enter(&benchmark->spinlock);        break;
+        case TB_DEMO_LOCK_TYPE_YIELD:       tb_demo_lock_yield_enter(&benchmark->spinlock); break;
+        case TB_DEMO_LOCK_TYPE_MUTEX:       tb_mutex_enter(benchmark->mutex);               break;
+        default: break;
+        }
+
+        // hold it
+        benchmark->value++;
+        if (benchmark->hold) tb_usleep(benchmark->hold);
+        else tb_demo_lock_work(100);
+
+        // leave
+        switch (benchmark->type)
+        {
+        case TB_DEMO_LOCK_TYPE_SPINLOCK:    tb_spinlock_leave(&benchmark->spinlock);        break;
+        case TB_DEMO_LOCK_TYPE_YIELD:       tb_demo_lock_yield_leave(&benchmark->spinlock); break;
+        case TB_DEMO_LOCK_TYPE_MUTEX:       tb_mutex_leave(benchmark->mutex);               break;
+        default: break;
+        }
+
+        // do some works without lock
+        tb_demo_lock_work(200);
+    }
+    return 0;
+}
+static tb_void_t tb_demo_lock_test(tb_size_t type, tb_size_t count, tb_size_t loop, tb_size_t hold)
+{
+    // init benchmark
+    tb_demo_lock_benchmark_t benchmark;
+    tb_memset(&benchmark, 0, sizeof(benchmark));
+    benchmark.type  = type;
+    benchmark.loop  = loop;
+    benchmark.hold  = hold;
+    benchmark.mutex = tb_mutex_init();
+    tb_spinlock_init(&benchmark.spinlock);
+#ifdef TB_LOCK_PROFILER_ENABLE
+    if (type == TB_DEMO_LOCK_TYPE_SPINLOCK) tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&benchmark.spinlock, "benchmark");
+#endif
+
+    // init time
+    tb_hong_t   time = tb_mclock();
+    clock_t     cpu = clock();
+
+    // init threads
+    tb_size_t       i = 0;
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    for (i = 0; i < count; i++)
+    {
+        threads[i] = tb_thread_init(tb_null, tb_demo_lock_loop, &benchmark, 0);
+        tb_assert_and_check_break(threads[i]);
+    }
+
+    // exit threads
+    for (i = 0; i < count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+
+    // exit time
+    time = tb_max(tb_mclock() - time, 1);
+    cpu = clock() - cpu;
+
+    // trace
+    static tb_char_t const* s_names[] = {"spinlock", "yield", "mutex"};
+    tb_trace_i("%s: hold: %lu us, threads: %lu, value: %lu/%lu, time: %lld ms, cpu: %lld ms, %lld ops/s"
+            ,   s_names[type], hold, count, benchmark.value, count * loop, time
+            ,   (tb_hong_t)cpu * 1000 / CLOCKS_PER_SEC, (tb_hong_t)benchmark.value * 1000 / time);
+
+    // exit lock
+    tb_spinlock_exit(&benchmark.spinlock);
+    if (benchmark.mutex) tb_mutex_exit(benchmark.mutex);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_platform_lock_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the thread count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 8;
+    count = tb_max(tb_min(count, TB_DEMO_THREAD_MAXN), 1);
+
+    // the loop count
+    tb_size_t loop = (argv[1] && argv[2])? tb_atoi(argv[2]) : 100000;
+    loop = tb_max(loop, 1);
+
+    // test the short critical section
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_SPINLOCK, count, loop, 0);
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_YIELD, count, loop, 0);
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_MUTEX, count, loop, 0);
+
+    // test the long critical section
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_SPINLOCK, count, tb_max(loop / 100, 1), 100);
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_YIELD, count, tb_max(loop / 100, 1), 100);
+    tb_demo_lock_test(TB_DEMO_LOCK_TYPE_MUTEX, count, tb_max(loop / 100, 1), 100);
+
+#ifdef TB_LOCK_PROFILER_ENABLE
+    // dump the lock profiler to the json file
+    if (argv[1] && argv[2] && argv[3])
+    {
+        tb_bool_t ok = tb_lock_profiler_dump_json(tb_lock_profiler(), argv[3]);
+        tb_trace_i("dump: %s: %s", argv[3], ok? "ok" : "failed");
+    }
+#endif
+    return 0;
+}
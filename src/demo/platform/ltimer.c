@@ -46,7 +46,7 @@ tb_int_t tb_demo_platform_ltimer_main(tb_int_t argc, tb_char_t** argv)
     {
         // the limit and delay
         tb_size_t limit         = tb_ltimer_limit(timer);
-        tb_size_t delay         = tb_ltimer_delay(timer);
+        tb_size_t delay         = TB_LTIMER_TICK_S;
 
         // trace
         tb_trace_i("limit: %lu, delay: %lu", limit, delay);
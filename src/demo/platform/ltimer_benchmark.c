@@ -0,0 +1,145 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the min timeout, ms
+#define TB_DEMO_TIMEOUT_MIN         (100)
+
+// the max timeout, ms
+#define TB_DEMO_TIMEOUT_MAX         (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the expired count
+static tb_size_t    g_expired = 0;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_ltimer_benchmark_func(tb_bool_t killed, tb_cpointer_t priv)
+{
+    g_expired++;
+}
+static tb_void_t tb_demo_ltimer_benchmark_trace(tb_char_t const* name, tb_char_t const* op, tb_size_t count, tb_hong_t time)
+{
+    tb_trace_i("%s: %s: %lu tasks, %lld us, %lld ns/task", name, op, count, time, count? time * 1000 / count : 0);
+}
+static tb_void_t tb_demo_ltimer_benchmark_ltimer(tb_size_t count, tb_size_t const* timeouts, tb_cpointer_t* tasks)
+{
+    // init timer with the millisecond tick
+    tb_ltimer_ref_t timer = tb_ltimer_init(count, TB_LTIMER_TICK_MS, tb_false);
+    if (timer)
+    {
+        // arm tasks
+        tb_size_t i = 0;
+        tb_hong_t time = tb_uclock();
+        for (i = 0; i < count; i++) tasks[i] = tb_ltimer_task_init(timer, timeouts[i], tb_false, tb_demo_ltimer_benchmark_func, tb_null);
+        tb_demo_ltimer_benchmark_trace("ltimer", "arm", count, tb_uclock() - time);
+
+        // cancel the half of tasks
+        time = tb_uclock();
+        for (i = 0; i < count; i += 2) tb_ltimer_task_exit(timer, (tb_ltimer_task_ref_t)tasks[i]);
+        tb_demo_ltimer_benchmark_trace("ltimer", "cancel", (count + 1) >> 1, tb_uclock() - time);
+
+        // expire the other tasks
+        g_expired = 0;
+        time = 0;
+        while (g_expired < (count >> 1))
+        {
+            // wait the next expired tick
+            tb_size_t delay = tb_ltimer_delay(timer);
+            tb_check_break(delay != -1);
+            if (delay) tb_msleep(delay);
+
+            // spak it
+            tb_hong_t spak = tb_uclock();
+            if (!tb_ltimer_spak(timer)) break;
+            time += tb_uclock() - spak;
+        }
+        tb_demo_ltimer_benchmark_trace("ltimer", "expire", g_expired, time);
+
+        // exit the expired tasks
+        for (i = 1; i < count; i += 2) tb_ltimer_task_exit(timer, (tb_ltimer_task_ref_t)tasks[i]);
+
+        // exit timer
+        tb_ltimer_exit(timer);
+    }
+}
+static tb_void_t tb_demo_ltimer_benchmark_timer(tb_size_t count, tb_size_t const* timeouts, tb_cpointer_t* tasks)
+{
+    // init timer
+    tb_timer_ref_t timer = tb_timer_init(count, tb_false);
+    if (timer)
+    {
+        // arm tasks
+        tb_size_t i = 0;
+        tb_hong_t time = tb_uclock();
+        for (i = 0; i < count; i++) tasks[i] = tb_timer_task_init(timer, timeouts[i], tb_false, tb_demo_ltimer_benchmark_func, tb_null);
+        tb_demo_ltimer_benchmark_trace("timer", "arm", count, tb_uclock() - time);
+
+        // cancel the half of tasks
+        time = tb_uclock();
+        for (i = 0; i < count; i += 2) tb_timer_task_exit(timer, (tb_timer_task_ref_t)tasks[i]);
+        tb_demo_ltimer_benchmark_trace("timer", "cancel", (count + 1) >> 1, tb_uclock() - time);
+
+        // expire the other tasks
+        g_expired = 0;
+        time = 0;
+        while (g_expired < (count >> 1))
+        {
+            // wait the next expired task
+            tb_size_t delay = tb_timer_delay(timer);
+            tb_check_break(delay != -1);
+            if (delay) tb_msleep(delay);
+
+            // spak it
+            tb_hong_t spak = tb_uclock();
+            if (!tb_timer_spak(timer)) break;
+            time += tb_uclock() - spak;
+        }
+        tb_demo_ltimer_benchmark_trace("timer", "expire", g_expired, time);
+
+        // exit the expired tasks
+        for (i = 1; i < count; i += 2) tb_timer_task_exit(timer, (tb_timer_task_ref_t)tasks[i]);
+
+        // exit timer
+        tb_timer_exit(timer);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_platform_ltimer_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the task count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : 1000000;
+    count = tb_max(count, 2);
+
+    // make the sub-second timeouts
+    tb_size_t*      timeouts = tb_nalloc_type(count, tb_size_t);
+    tb_cpointer_t*  tasks = tb_nalloc_type(count, tb_cpointer_t);
+    if (timeouts && tasks)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++) timeouts[i] = (tb_size_t)tb_random_range(TB_DEMO_TIMEOUT_MIN, TB_DEMO_TIMEOUT_MAX);
+
+        // test the hierarchical timing wheel
+        tb_demo_ltimer_benchmark_ltimer(count, timeouts, tasks);
+
+        // test the heap timer
+        tb_demo_ltimer_benchmark_timer(count, timeouts, tasks);
+    }
+
+    // exit data
+    if (timeouts) tb_free(timeouts);
+    if (tasks) tb_free(tasks);
+    return 0;
+}
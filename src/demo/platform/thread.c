@@ -3,6 +3,13 @@
  */ 
 #include "../demo.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the threads count of the leak test
+#define TB_DEMO_LEAK_THREADS        (200)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -24,11 +31,58 @@ static tb_int_t tb_demo_thread_func(tb_cpointer_t priv)
     return 0;
 }
 
+static tb_int_t tb_demo_thread_leak_func(tb_cpointer_t priv)
+{
+    // malloc and free some data on this thread? it will make the thread cache of the allocator
+    tb_size_t i = 0;
+    tb_size_t n = tb_p2u32(priv) & 1? 16 : 0;
+    for (i = 0; i < n; i++)
+    {
+        tb_pointer_t data = tb_malloc(16 + (i << 4));
+        if (data) tb_free(data);
+    }
+
+    /* only free the thread arguments in tb_thread_func() if do not malloc anything,
+     * it is freed after all thread locals have been freed
+     */
+    return 0;
+}
+
+/* the leak test, it should be run with the leak checker, e.g. valgrind or -fsanitize=address
+ *
+ * the thread caches of the allocator must be exited with all threads
+ */
+static tb_void_t tb_demo_thread_leak(tb_noarg_t)
+{
+    // create and exit the threads one by one
+    tb_size_t i = 0;
+    tb_size_t exited = 0;
+    for (i = 0; i < TB_DEMO_LEAK_THREADS; i++)
+    {
+        tb_thread_ref_t thread = tb_thread_init(tb_null, tb_demo_thread_leak_func, tb_u2p(i), 0);
+        if (thread)
+        {
+            if (tb_thread_wait(thread, -1, tb_null) > 0) exited++;
+            tb_thread_exit(thread);
+        }
+    }
+
+    // trace
+    tb_trace_i("leak: %lu/%lu threads have been exited", exited, (tb_size_t)TB_DEMO_LEAK_THREADS);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * main
  */ 
 tb_int_t tb_demo_platform_thread_main(tb_int_t argc, tb_char_t** argv)
 {
+    // the leak test? e.g. demo platform_thread leak
+    if (argv[1] && !tb_strcmp(argv[1], "leak"))
+    {
+        tb_demo_thread_leak();
+        return 0;
+    }
+
     // init thread
     tb_thread_ref_t thread = tb_thread_init(tb_null, tb_demo_thread_func, "hello", 0);
     if (thread)
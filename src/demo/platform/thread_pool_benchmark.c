@@ -0,0 +1,143 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default task count
+#define TB_DEMO_TASK_COUNT          (100000)
+
+// the subtask count of the nested task
+#define TB_DEMO_TASK_NESTED_COUNT   (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the benchmark context type
+typedef struct __tb_demo_context_t
+{
+    // the thread pool
+    tb_thread_pool_ref_t    pool;
+
+    // the left task count
+    tb_atomic_t             left;
+
+    // the finished event
+    tb_event_ref_t          event;
+
+    // the work result
+    tb_atomic_t             result;
+
+}tb_demo_context_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_task_work_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+
+    // do some small work
+    tb_uint32_t i = 0;
+    tb_uint32_t v = 2166136261u;
+    for (i = 0; i < 256; i++) v = (v ^ i) * 16777619u;
+    if (!v) tb_atomic_fetch_and_inc(&context->result);
+
+    // finished?
+    if (!tb_atomic_dec_and_fetch(&context->left)) tb_event_post(context->event);
+}
+static tb_void_t tb_demo_task_nested_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // the context
+    tb_demo_context_t* context = (tb_demo_context_t*)priv;
+
+    // post subtasks from the worker
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DEMO_TASK_NESTED_COUNT - 1; i++)
+        tb_thread_pool_task_post(context->pool, tb_null, tb_demo_task_work_done, tb_null, context, tb_false);
+
+    // do work
+    tb_demo_task_work_done(worker, priv);
+}
+static tb_hong_t tb_demo_thread_pool_test(tb_size_t mode, tb_size_t worker_maxn, tb_size_t count, tb_bool_t nested)
+{
+    // init context
+    tb_demo_context_t context = {0};
+    context.pool    = tb_thread_pool_init_with_mode(worker_maxn, 0, mode);
+    context.event   = tb_event_init();
+    context.left    = count;
+    tb_assert_and_check_return_val(context.pool && context.event, -1);
+
+    // post tasks
+    tb_size_t i = 0;
+    tb_hong_t t = tb_mclock();
+    if (nested)
+    {
+        for (i = 0; i < count / TB_DEMO_TASK_NESTED_COUNT; i++)
+            tb_thread_pool_task_post(context.pool, tb_null, tb_demo_task_nested_done, tb_null, &context, tb_false);
+    }
+    else
+    {
+        for (i = 0; i < count; i++)
+            tb_thread_pool_task_post(context.pool, tb_null, tb_demo_task_work_done, tb_null, &context, !(i & 1023)? tb_true : tb_false);
+    }
+
+    // wait all tasks
+    if (tb_event_wait(context.event, -1) <= 0) t = -1;
+    else t = tb_mclock() - t;
+
+    // exit context
+    tb_thread_pool_exit(context.pool);
+    tb_event_exit(context.event);
+    return t;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_platform_thread_pool_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the task count
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_TASK_COUNT;
+    count = tb_align(count, TB_DEMO_TASK_NESTED_COUNT);
+
+    // the max worker count
+    tb_size_t worker_maxn = (argv[1] && argv[2])? tb_atoi(argv[2]) : tb_processor_count();
+    if (!worker_maxn) worker_maxn = 1;
+
+    // trace
+    tb_trace_i("tasks: %lu, processors: %lu", count, tb_processor_count());
+
+    // done
+    tb_size_t workers = 1;
+    while (1)
+    {
+        // test the shared and stealing mode
+        tb_hong_t shared_flat       = tb_demo_thread_pool_test(TB_THREAD_POOL_MODE_SHARED, workers, count, tb_false);
+        tb_hong_t stealing_flat     = tb_demo_thread_pool_test(TB_THREAD_POOL_MODE_STEALING, workers, count, tb_false);
+        tb_hong_t shared_nested     = tb_demo_thread_pool_test(TB_THREAD_POOL_MODE_SHARED, workers, count, tb_true);
+        tb_hong_t stealing_nested   = tb_demo_thread_pool_test(TB_THREAD_POOL_MODE_STEALING, workers, count, tb_true);
+
+        // trace
+        tb_trace_i("workers: %2lu, flat: shared: %lld ms, %lld tasks/s, stealing: %lld ms, %lld tasks/s"
+                , workers
+                , shared_flat, (tb_hong_t)count * 1000 / tb_max(shared_flat, 1)
+                , stealing_flat, (tb_hong_t)count * 1000 / tb_max(stealing_flat, 1));
+        tb_trace_i("workers: %2lu, nested: shared: %lld ms, %lld tasks/s, stealing: %lld ms, %lld tasks/s"
+                , workers
+                , shared_nested, (tb_hong_t)count * 1000 / tb_max(shared_nested, 1)
+                , stealing_nested, (tb_hong_t)count * 1000 / tb_max(stealing_nested, 1));
+
+        // next
+        if (workers >= worker_maxn) break;
+        workers = tb_min(workers << 1, worker_maxn);
+    }
+
+    // ok
+    return 0;
+}
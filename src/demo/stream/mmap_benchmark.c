@@ -0,0 +1,184 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default file size (MB)
+#define TB_DEMO_FILE_SIZE           (256)
+
+// the block size for reading
+#define TB_DEMO_BLOCK_READ          (1 << 16)
+
+// the block size for needing
+#define TB_DEMO_BLOCK_NEED          (1 << 12)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_uint64_t tb_demo_mmap_sum(tb_byte_t const* data, tb_size_t size, tb_uint64_t sum)
+{
+    // sum all 64-bits words
+    tb_size_t i = 0;
+    tb_size_t n = size >> 3;
+    for (i = 0; i < n; i++) sum += tb_bits_get_u64_ne(data + (i << 3));
+    for (i = n << 3; i < size; i++) sum += data[i];
+    return sum;
+}
+static tb_bool_t tb_demo_mmap_make(tb_char_t const* path, tb_hize_t size)
+{
+    // init file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+    tb_assert_and_check_return_val(file, tb_false);
+
+    // make data
+    tb_byte_t data[TB_DEMO_BLOCK_READ];
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    for (i = 0; i < sizeof(data); i++) data[i] = (tb_byte_t)tb_random_value();
+
+    // writ data
+    tb_hize_t writ = 0;
+    while (writ < size)
+    {
+        // modify some data for each block
+        tb_bits_set_u64_ne(data, writ);
+
+        // writ it
+        tb_size_t need = (tb_size_t)tb_min(size - writ, sizeof(data));
+        tb_long_t real = tb_file_writ(file, data, need);
+        tb_check_break(real > 0);
+        writ += real;
+    }
+
+    // exit file
+    tb_file_exit(file);
+    return writ == size;
+}
+static tb_hong_t tb_demo_mmap_read(tb_char_t const* path, tb_bool_t bmmap, tb_bool_t bneed, tb_uint64_t* psum)
+{
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init_from_file(path, TB_FILE_MODE_RO);
+    tb_assert_and_check_return_val(stream, -1);
+
+    // done
+    tb_hong_t       time = -1;
+    tb_uint64_t     sum = 0;
+    tb_byte_t*      data = tb_null;
+    do
+    {
+        // enable to map file
+        if (!tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_SET_MMAP, bmmap)) break;
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // is the mapping mode?
+        tb_bool_t mapped = tb_false;
+        if (!tb_stream_ctrl(stream, TB_STREAM_CTRL_FILE_GET_MMAP, &mapped) || mapped != bmmap)
+            tb_trace_i("%s: the mapping mode is not supported", path);
+
+        // read data
+        tb_hong_t   t = tb_mclock();
+        tb_hize_t   left = tb_stream_left(stream);
+        if (bneed)
+        {
+            // need data and skip it, it will be not copied for the mapping mode
+            while (left)
+            {
+                tb_size_t need = (tb_size_t)tb_min(left, TB_DEMO_BLOCK_NEED);
+                if (!tb_stream_need(stream, &data, need)) break;
+                sum = tb_demo_mmap_sum(data, need, sum);
+                if (!tb_stream_skip(stream, need)) break;
+                left -= need;
+            }
+        }
+        else
+        {
+            // make buffer
+            data = tb_malloc_bytes(TB_DEMO_BLOCK_READ);
+            tb_assert_and_check_break(data);
+
+            // read data to the buffer
+            while (left)
+            {
+                tb_size_t need = (tb_size_t)tb_min(left, TB_DEMO_BLOCK_READ);
+                if (!tb_stream_bread(stream, data, need)) break;
+                sum = tb_demo_mmap_sum(data, need, sum);
+                left -= need;
+            }
+
+            // exit buffer
+            tb_free(data);
+        }
+        tb_assert_and_check_break(!left);
+
+        // ok
+        time = tb_mclock() - t;
+
+    } while (0);
+
+    // exit stream
+    tb_stream_exit(stream);
+
+    // ok?
+    *psum = sum;
+    return time;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_stream_mmap_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the file path, we will make a temporary file with the given size (MB) if it is not an existing file
+    tb_char_t       path[TB_PATH_MAXN];
+    tb_file_info_t  info = {0};
+    tb_bool_t       bmake = !(argv[1] && tb_file_info(argv[1], &info) && info.type == TB_FILE_TYPE_FILE);
+    if (bmake)
+    {
+        // the temporary file path
+        tb_size_t size = tb_directory_temporary(path, sizeof(path));
+        tb_assert_and_check_return_val(size && size + 32 < sizeof(path), -1);
+        tb_strlcpy(path + size, "/tbox_mmap_benchmark.bin", sizeof(path) - size);
+
+        // make file
+        tb_hize_t filesize = (tb_hize_t)(argv[1]? tb_atoi(argv[1]) : TB_DEMO_FILE_SIZE) << 20;
+        if (!tb_demo_mmap_make(path, filesize))
+        {
+            tb_trace_i("make %s failed!", path);
+            return -1;
+        }
+    }
+    else tb_strlcpy(path, argv[1], sizeof(path));
+
+    // the file size
+    if (!tb_file_info(path, &info)) return -1;
+    tb_trace_i("file: %s, size: %llu MB", path, info.size >> 20);
+
+    // read it
+    tb_uint64_t sum_read_buffer = 0;
+    tb_uint64_t sum_read_mmap   = 0;
+    tb_uint64_t sum_need_buffer = 0;
+    tb_uint64_t sum_need_mmap   = 0;
+    tb_hong_t   t_read_buffer   = tb_demo_mmap_read(path, tb_false, tb_false, &sum_read_buffer);
+    tb_hong_t   t_read_mmap     = tb_demo_mmap_read(path, tb_true, tb_false, &sum_read_mmap);
+    tb_hong_t   t_need_buffer   = tb_demo_mmap_read(path, tb_false, tb_true, &sum_need_buffer);
+    tb_hong_t   t_need_mmap     = tb_demo_mmap_read(path, tb_true, tb_true, &sum_need_mmap);
+
+    // trace
+    tb_trace_i("equal: %s", (sum_read_buffer == sum_read_mmap && sum_read_buffer == sum_need_buffer && sum_read_buffer == sum_need_mmap)? "ok" : "no");
+    tb_trace_i("read: buffer: %lld ms, %lld MB/s, mmap: %lld ms, %lld MB/s"
+            , t_read_buffer, (tb_hong_t)(info.size >> 20) * 1000 / tb_max(t_read_buffer, 1)
+            , t_read_mmap, (tb_hong_t)(info.size >> 20) * 1000 / tb_max(t_read_mmap, 1));
+    tb_trace_i("need: buffer: %lld ms, %lld MB/s, mmap: %lld ms, %lld MB/s"
+            , t_need_buffer, (tb_hong_t)(info.size >> 20) * 1000 / tb_max(t_need_buffer, 1)
+            , t_need_mmap, (tb_hong_t)(info.size >> 20) * 1000 / tb_max(t_need_mmap, 1));
+
+    // remove the temporary file
+    if (bmake) tb_file_remove(path);
+    return 0;
+}
@@ -28,6 +28,8 @@ tb_int_t tb_demo_stream_zip_main(tb_int_t argc, tb_char_t** argv)
     tb_stream_ref_t fstream = tb_stream_init_filter_from_zip(iostream, TB_ZIP_ALGO_GZIP, TB_ZIP_ACTION_DEFLATE);   
 //  tb_stream_ref_t fstream = tb_stream_init_filter_from_zip(iostream, TB_ZIP_ALGO_ZLIBRAW, TB_ZIP_ACTION_INFLATE);
 //  tb_stream_ref_t fstream = tb_stream_init_filter_from_zip(iostream, TB_ZIP_ALGO_ZLIBRAW, TB_ZIP_ACTION_DEFLATE);
+//  tb_stream_ref_t fstream = tb_stream_init_filter_from_zip(iostream, TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_INFLATE);
+//  tb_stream_ref_t fstream = tb_stream_init_filter_from_zip(iostream, TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_DEFLATE);
 
     // done
     if (istream && ostream && fstream) 
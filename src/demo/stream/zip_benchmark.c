@@ -0,0 +1,266 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default data size
+#define TB_DEMO_DATA_SIZE           (16 << 20)
+
+// the chunk size of the streaming test
+#define TB_DEMO_CHUNK_SIZE          (1000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+#ifdef TB_CONFIG_MODULE_HAVE_ZIP
+static tb_void_t tb_demo_zip_make(tb_byte_t* data, tb_size_t size, tb_size_t type)
+{
+    // the words of the text 
+    static tb_char_t const* s_words[] = 
+    {
+        "the ", "tbox ", "stream ", "filter ", "zip ", "data ", "compress ", "block ", "frame ", "window "
+    ,   "<item name=\"", "\"/>\n", "{\"key\": ", "1024, ", "\"value\"}, ", "http://tboox.org/", "GET ", "HTTP/1.1\r\n"
+    };
+
+    // make data
+    tb_size_t   i = 0;
+    tb_uint32_t seed = 2166136261ul;
+    while (i < size)
+    {
+        // the next random value
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+
+        switch (type)
+        {
+        case 0:
+            {
+                // the text
+                tb_char_t const*    word = s_words[seed % tb_arrayn(s_words)];
+                tb_size_t           n = tb_min(tb_strlen(word), size - i);
+                tb_memcpy(data + i, word, n);
+                i += n;
+            }
+            break;
+        case 1:
+            // the random data
+            data[i++] = (tb_byte_t)(seed >> 7);
+            break;
+        default:
+            // the zero data
+            data[i++] = 0;
+            break;
+        }
+    }
+}
+static tb_size_t tb_demo_zip_spak(tb_size_t algo, tb_size_t action, tb_byte_t const* idata, tb_size_t isize, tb_byte_t* odata, tb_size_t omaxn, tb_size_t chunk)
+{
+    // init zip
+    tb_zip_ref_t zip = tb_zip_init(algo, action);
+    tb_assert_and_check_return_val(zip, 0);
+
+    // spak the chunks
+    tb_size_t ipos = 0;
+    tb_size_t opos = 0;
+    while (1)
+    {
+        // init the input and output chunk, sync the last input chunk
+        tb_static_stream_t  ist;
+        tb_static_stream_t  ost;
+        tb_size_t           isize_chunk = tb_min(chunk, isize - ipos);
+        tb_size_t           osize_chunk = tb_min(chunk, omaxn - opos);
+        tb_long_t           sync = (ipos + isize_chunk == isize)? -1 : 0;
+        tb_static_stream_init(&ist, (tb_byte_t*)idata + ipos, isize_chunk);
+        tb_static_stream_init(&ost, odata + opos, osize_chunk);
+
+        // spak it
+        tb_long_t real = tb_zip_spak(zip, &ist, &ost, sync);
+        tb_size_t read = ist.p - (idata + ipos);
+        ipos += read;
+        opos += ost.p - (odata + opos);
+
+        // end or no more data?
+        if (real < 0 || (!real && (ipos == isize || !read))) break;
+    }
+
+    // exit zip
+    tb_zip_exit(zip);
+    return opos;
+}
+static tb_void_t tb_demo_zip_test(tb_char_t const* name, tb_size_t algo, tb_byte_t const* data, tb_size_t size, tb_byte_t* zdata, tb_byte_t* odata)
+{
+    // deflate it
+    tb_size_t   zmaxn = size + (size >> 2) + 4096;
+    tb_hong_t   time = tb_mclock();
+    tb_size_t   zsize = tb_demo_zip_spak(algo, TB_ZIP_ACTION_DEFLATE, data, size, zdata, zmaxn, zmaxn);
+    tb_hong_t   dtime = tb_max(tb_mclock() - time, 1);
+
+    // inflate it
+    time = tb_mclock();
+    tb_size_t   osize = tb_demo_zip_spak(algo, TB_ZIP_ACTION_INFLATE, zdata, zsize, odata, size, size);
+    tb_hong_t   itime = tb_max(tb_mclock() - time, 1);
+
+    // trace
+    tb_bool_t ok = osize == size && !tb_memcmp(data, odata, size);
+    tb_trace_i("%-8s %8s: %lu => %lu bytes, %lu%%, deflate: %lld MB/s, inflate: %lld MB/s, check: %s"
+            , algo == TB_ZIP_ALGO_LZ4? "lz4" : "zlib"
+            , name
+            , size
+            , zsize
+            , zsize * 100 / tb_max(size, 1)
+            , ((tb_hong_t)size * 1000 / dtime) >> 20
+            , ((tb_hong_t)size * 1000 / itime) >> 20
+            , ok? "ok" : "no");
+}
+static tb_bool_t tb_demo_zip_stream(tb_byte_t const* data, tb_size_t size, tb_byte_t* zdata, tb_byte_t* odata)
+{
+    // deflate and inflate it with the small chunks
+    tb_size_t zmaxn = size + (size >> 2) + 4096;
+    tb_size_t zsize = tb_demo_zip_spak(TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_DEFLATE, data, size, zdata, zmaxn, TB_DEMO_CHUNK_SIZE);
+    tb_size_t osize = tb_demo_zip_spak(TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_INFLATE, zdata, zsize, odata, size, TB_DEMO_CHUNK_SIZE);
+    return osize == size && !tb_memcmp(data, odata, size);
+}
+static tb_bool_t tb_demo_zip_transfer(tb_byte_t const* data, tb_size_t size, tb_byte_t* zdata, tb_byte_t* odata)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_stream_ref_t istream = tb_null;
+    tb_stream_ref_t fstream = tb_null;
+    do
+    {
+        // deflate it by the zip filter stream
+        tb_size_t zmaxn = size + (size >> 2) + 4096;
+        istream = tb_stream_init_from_data(data, size);
+        fstream = istream? tb_stream_init_filter_from_zip(istream, TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_DEFLATE) : tb_null;
+        tb_assert_and_check_break(fstream);
+        tb_hong_t zsize = tb_transfer_to_data(fstream, zdata, zmaxn, 0, tb_null, tb_null);
+        tb_check_break(zsize > 0);
+        tb_stream_exit(fstream);
+        tb_stream_exit(istream);
+
+        // inflate it by the zip filter stream
+        istream = tb_stream_init_from_data(zdata, (tb_size_t)zsize);
+        fstream = istream? tb_stream_init_filter_from_zip(istream, TB_ZIP_ALGO_LZ4, TB_ZIP_ACTION_INFLATE) : tb_null;
+        tb_assert_and_check_break(fstream);
+        tb_hong_t osize = tb_transfer_to_data(fstream, odata, size, 0, tb_null, tb_null);
+
+        // ok?
+        ok = osize == size && !tb_memcmp(data, odata, size);
+
+    } while (0);
+
+    // exit streams
+    if (fstream) tb_stream_exit(fstream);
+    if (istream) tb_stream_exit(istream);
+    return ok;
+}
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+static tb_void_t tb_demo_zip_parallel(tb_char_t const* name, tb_size_t algo, tb_size_t workers, tb_byte_t const* data, tb_size_t size, tb_byte_t* zdata, tb_byte_t* odata)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_hong_t       dtime = 1;
+    tb_hong_t       zsize = 0;
+    tb_stream_ref_t istream = tb_null;
+    tb_stream_ref_t fstream = tb_null;
+    do
+    {
+        // deflate it by the parallel zip filter stream
+        tb_size_t zmaxn = size + (size >> 2) + 4096;
+        istream = tb_stream_init_from_data(data, size);
+        fstream = istream? tb_stream_init_filter_from_zip_parallel(istream, algo, TB_ZIP_ACTION_DEFLATE, workers) : tb_null;
+        tb_assert_and_check_break(fstream);
+        tb_hong_t time = tb_mclock();
+        zsize = tb_transfer_to_data(fstream, zdata, zmaxn, 0, tb_null, tb_null);
+        dtime = tb_max(tb_mclock() - time, 1);
+        tb_check_break(zsize > 0);
+        tb_stream_exit(fstream);
+        tb_stream_exit(istream);
+
+        // inflate it by the serial zip filter stream
+        istream = tb_stream_init_from_data(zdata, (tb_size_t)zsize);
+        fstream = istream? tb_stream_init_filter_from_zip(istream, algo, TB_ZIP_ACTION_INFLATE) : tb_null;
+        tb_assert_and_check_break(fstream);
+        tb_hong_t osize = tb_transfer_to_data(fstream, odata, size, 0, tb_null, tb_null);
+
+        // ok?
+        ok = osize == size && !tb_memcmp(data, odata, size);
+
+    } while (0);
+
+    // exit streams
+    if (fstream) tb_stream_exit(fstream);
+    if (istream) tb_stream_exit(istream);
+
+    // trace
+    tb_trace_i("%-8s %8s: workers: %lu, %lu => %lld bytes, deflate: %lld MB/s, check: %s"
+            , algo == TB_ZIP_ALGO_GZIP? "gzip" : "zlib"
+            , name
+            , workers
+            , size
+            , zsize
+            , ((tb_hong_t)size * 1000 / dtime) >> 20
+            , ok? "ok" : "no");
+}
+#endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_stream_zip_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+#ifdef TB_CONFIG_MODULE_HAVE_ZIP
+    // the data size
+    tb_size_t size = argv[1]? tb_atoi(argv[1]) : TB_DEMO_DATA_SIZE;
+    size = tb_max(size, 1);
+
+    // init data
+    tb_byte_t* data = tb_malloc_bytes(size);
+    tb_byte_t* zdata = tb_malloc_bytes(size + (size >> 2) + 4096);
+    tb_byte_t* odata = tb_malloc_bytes(size);
+    if (data && zdata && odata)
+    {
+        // test them
+        tb_size_t type = 0;
+        tb_char_t const* names[] = {"text", "random", "zero"};
+        for (type = 0; type < tb_arrayn(names); type++)
+        {
+            // make data
+            tb_demo_zip_make(data, size, type);
+
+            // test the throughput and the round trip
+            tb_demo_zip_test(names[type], TB_ZIP_ALGO_LZ4, data, size, zdata, odata);
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+            tb_demo_zip_test(names[type], TB_ZIP_ALGO_ZLIBRAW, data, size, zdata, odata);
+#endif
+
+            // test the streaming round trip with the small chunks and tb_transfer
+            tb_trace_i("%-8s %8s: stream: %s, transfer: %s", "lz4", names[type]
+                    , tb_demo_zip_stream(data, tb_min(size, 1 << 20), zdata, odata)? "ok" : "no"
+                    , tb_demo_zip_transfer(data, size, zdata, odata)? "ok" : "no");
+        }
+
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+        // test the throughput scaling of the parallel deflate with the worker count
+        tb_size_t workers = 1;
+        tb_size_t workers_maxn = tb_max(tb_processor_count(), 4);
+        tb_demo_zip_make(data, size, 0);
+        for (workers = 1; workers <= workers_maxn; workers <<= 1)
+            tb_demo_zip_parallel(names[0], TB_ZIP_ALGO_GZIP, workers, data, size, zdata, odata);
+        tb_demo_zip_parallel(names[0], TB_ZIP_ALGO_ZLIBRAW, workers_maxn, data, size, zdata, odata);
+#endif
+    }
+
+    // exit data
+    if (data) tb_free(data);
+    if (zdata) tb_free(zdata);
+    if (odata) tb_free(odata);
+#endif
+    return 0;
+}
@@ -0,0 +1,133 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default line count of each thread
+#define TB_DEMO_LINE_COUNT          (100000)
+
+// the thread maximum count
+#define TB_DEMO_THREAD_MAXN         (64)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_int_t tb_demo_trace_thread(tb_cpointer_t priv)
+{
+    // trace lines
+    tb_size_t i = 0;
+    tb_size_t count = (tb_size_t)priv;
+    for (i = 0; i < count; i++)
+        tb_trace_done("demo", "trace", "line: %lu, value: %lx, text: %s" __tb_newline__, i, (tb_size_t)&i, "abcdefghijklmnopqrstuvwxyz0123456789");
+    return 0;
+}
+static tb_hong_t tb_demo_trace_test(tb_char_t const* path, tb_size_t thread_count, tb_size_t count, tb_long_t policy, tb_size_t* plines)
+{
+    // init the trace file
+    if (!tb_trace_file_set_path(path, tb_false)) return -1;
+
+    // only write lines to file
+    tb_size_t mode = tb_trace_mode();
+    tb_trace_mode_set(TB_TRACE_MODE_FILE);
+
+    // enable the async mode
+    if (policy >= 0) tb_trace_async_init(0, policy);
+
+    // start threads
+    tb_size_t       i = 0;
+    tb_hong_t       t = tb_mclock();
+    tb_thread_ref_t threads[TB_DEMO_THREAD_MAXN] = {0};
+    for (i = 0; i < thread_count; i++)
+    {
+        threads[i] = tb_thread_init(tb_null, tb_demo_trace_thread, (tb_cpointer_t)count, 0);
+        tb_assert_and_check_break(threads[i]);
+    }
+
+    // wait threads
+    for (i = 0; i < thread_count; i++)
+    {
+        if (threads[i])
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+    }
+
+    // write all pending lines
+    if (policy >= 0) tb_trace_async_exit();
+    t = tb_mclock() - t;
+
+    // restore the trace mode
+    tb_trace_mode_set(mode);
+
+    // count the written lines
+    *plines = 0;
+    tb_stream_ref_t stream = tb_stream_init_from_file(path, TB_FILE_MODE_RO);
+    if (stream && tb_stream_open(stream))
+    {
+        tb_char_t line[8192];
+        while (tb_stream_bread_line(stream, line, sizeof(line)) >= 0) (*plines)++;
+    }
+    if (stream) tb_stream_exit(stream);
+    return t;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_utils_trace_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // the line count of each thread
+    tb_size_t count = argv[1]? tb_atoi(argv[1]) : TB_DEMO_LINE_COUNT;
+
+    // the max thread count
+    tb_size_t thread_maxn = (argv[1] && argv[2])? tb_atoi(argv[2]) : tb_processor_count();
+    thread_maxn = tb_max(tb_min(thread_maxn, TB_DEMO_THREAD_MAXN), 1);
+
+    // the trace file path
+    tb_char_t path[TB_PATH_MAXN];
+    tb_size_t size = tb_directory_temporary(path, sizeof(path));
+    tb_assert_and_check_return_val(size && size + 32 < sizeof(path), -1);
+    tb_strlcpy(path + size, "/tbox_trace_benchmark.log", sizeof(path) - size);
+
+    // trace
+    tb_trace_i("lines: %lu, processors: %lu, file: %s", count, tb_processor_count(), path);
+
+    // done
+    tb_size_t threads = 1;
+    while (1)
+    {
+        // the total line count
+        tb_hong_t total = (tb_hong_t)count * threads;
+
+        // test the sync and async mode
+        tb_size_t lines_sync    = 0;
+        tb_size_t lines_drop    = 0;
+        tb_size_t lines_block   = 0;
+        tb_hong_t t_sync        = tb_demo_trace_test(path, threads, count, -1, &lines_sync);
+        tb_hong_t t_drop        = tb_demo_trace_test(path, threads, count, TB_TRACE_ASYNC_POLICY_DROP, &lines_drop);
+        tb_hong_t t_block       = tb_demo_trace_test(path, threads, count, TB_TRACE_ASYNC_POLICY_BLOCK, &lines_block);
+
+        // trace
+        tb_trace_i("threads: %2lu, sync: %lld ms, %lld lines/s, async(drop): %lld ms, %lld lines/s, async(block): %lld ms, %lld lines/s"
+                , threads
+                , t_sync, total * 1000 / tb_max(t_sync, 1)
+                , t_drop, total * 1000 / tb_max(t_drop, 1)
+                , t_block, total * 1000 / tb_max(t_block, 1));
+        tb_trace_i("threads: %2lu, written lines: sync: %lu, async(drop): %lu, async(block): %lu", threads, lines_sync, lines_drop, lines_block);
+
+        // next
+        if (threads >= thread_maxn) break;
+        threads = tb_min(threads << 1, thread_maxn);
+    }
+
+    // remove the trace file
+    tb_file_remove(path);
+
+    // ok
+    return 0;
+}
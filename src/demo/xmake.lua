@@ -27,8 +27,10 @@ target("demo")
     add_files("container/*.c") 
     add_files("algorithm/*.c") 
     add_files("stream/stream.c") 
+    add_files("stream/mmap_benchmark.c") 
+    add_files("stream/zip_benchmark.c") 
     add_files("stream/stream/*.c") 
-    add_files("network/**.c") 
+    add_files("network/**.c|http_server*.c") 
 
     -- add the source files for the hash module
     if has_config("hash") then
@@ -46,6 +48,7 @@ target("demo")
     if has_config("coroutine") then
         add_files("coroutine/**.c") 
         add_files("platform/context.c") 
+        add_files("network/http_server*.c") 
     end
 
     -- add the source files for the exception module
@@ -73,5 +76,5 @@ target("demo")
     if has_config("charset") then add_files("other/charset.c") end
 
     -- add the source files for the database module
-    if has_config("database") then add_files("database/sql.c") end
+    if has_config("database") then add_files("database/sql.c", "database/sql_pool_benchmark.c", "database/sql_batch_benchmark.c") end
     
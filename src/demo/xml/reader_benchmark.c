@@ -0,0 +1,211 @@
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "../demo.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default record count, about 20MB xml data
+#define TB_DEMO_RECORD_COUNT        (40000)
+
+// the test loop count
+#define TB_DEMO_LOOP_COUNT          (3)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * test
+ */
+static tb_void_t tb_demo_xml_make(tb_string_ref_t xml, tb_size_t count)
+{
+    // make records
+    tb_size_t i = 0;
+    tb_random_reset(tb_true);
+    tb_string_cstrcat(xml, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<feed>\n");
+    for (i = 0; i < count; i++)
+    {
+        tb_size_t value = tb_random_value();
+        tb_string_cstrfcat(xml, "    <entry id=\"%lu\" type=\"record\" score=\"%lu.%lu\">\n", i, value % 100, value % 1000);
+        tb_string_cstrfcat(xml, "        <title>record-%lx-abcdefghijklmnopqrstuvwxyz-0123456789</title>\n", value);
+        tb_string_cstrfcat(xml, "        <link href=\"http://www.example.com/feed/%lx?a=1&amp;b=2\" rel=\"alternate\"/>\n", value);
+        tb_string_cstrfcat(xml, "        <summary>the summary of the record %lu, it has some long text for the benchmark &lt;%lu&gt;</summary>\n", i, value);
+        tb_string_cstrfcat(xml, "        <!-- the comment of the record %lu -->\n", i);
+        tb_string_cstrfcat(xml, "        <content><![CDATA[<p>the content of the record %lu</p>]]></content>\n", i);
+        tb_string_cstrfcat(xml, "    </entry>\n");
+    }
+    tb_string_cstrcat(xml, "</feed>\n");
+}
+static tb_size_t tb_demo_xml_hash(tb_size_t hash, tb_char_t const* data, tb_size_t size)
+{
+    while (size--) hash = (hash * 31) + (tb_byte_t)*data++;
+    return hash;
+}
+static tb_hong_t tb_demo_xml_read(tb_string_ref_t xml, tb_size_t mode, tb_bool_t slice, tb_size_t* phash)
+{
+    // done
+    tb_size_t   i = 0;
+    tb_size_t   hash = 0;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < TB_DEMO_LOOP_COUNT; i++)
+    {
+        // init reader
+        tb_xml_reader_ref_t reader = tb_xml_reader_init();
+        tb_assert_and_check_break(reader);
+
+        // set mode
+        tb_xml_reader_mode_set(reader, mode);
+
+        // open reader
+        hash = 0;
+        if (tb_xml_reader_open(reader, tb_stream_init_from_data((tb_byte_t const*)tb_string_cstr(xml), tb_string_size(xml)), tb_true))
+        {
+            // walk the events and hash the element names, attributes and texts
+            tb_size_t event = TB_XML_READER_EVENT_NONE;
+            while ((event = tb_xml_reader_next(reader)))
+            {
+                hash = hash * 31 + event;
+                if (slice)
+                {
+                    tb_xml_slice_t data;
+                    switch (event)
+                    {
+                    case TB_XML_READER_EVENT_ELEMENT_BEG:
+                    case TB_XML_READER_EVENT_ELEMENT_EMPTY:
+                        {
+                            tb_size_t                       n = 0;
+                            tb_size_t                       j = 0;
+                            tb_xml_attribute_slice_t const* attrs = tb_xml_reader_attribute_slices(reader, &n);
+                            if (tb_xml_reader_element_slice(reader, &data)) hash = tb_demo_xml_hash(hash, data.data, data.size);
+                            for (j = 0; j < n; j++)
+                            {
+                                hash = tb_demo_xml_hash(hash, attrs[j].name.data, attrs[j].name.size);
+                                hash = tb_demo_xml_hash(hash, attrs[j].data.data, attrs[j].data.size);
+                            }
+                        }
+                        break;
+                    case TB_XML_READER_EVENT_TEXT:
+                        if (tb_xml_reader_text_slice(reader, &data)) hash = tb_demo_xml_hash(hash, data.data, data.size);
+                        break;
+                    default:
+                        break;
+                    }
+                }
+                else
+                {
+                    tb_char_t const* data = tb_null;
+                    switch (event)
+                    {
+                    case TB_XML_READER_EVENT_ELEMENT_BEG:
+                    case TB_XML_READER_EVENT_ELEMENT_EMPTY:
+                        {
+                            tb_xml_node_ref_t attr = tb_xml_reader_attributes(reader);
+                            if ((data = tb_xml_reader_element(reader))) hash = tb_demo_xml_hash(hash, data, tb_strlen(data));
+                            for (; attr; attr = attr->next)
+                            {
+                                hash = tb_demo_xml_hash(hash, tb_string_cstr(&attr->name), tb_string_size(&attr->name));
+                                hash = tb_demo_xml_hash(hash, tb_string_cstr(&attr->data), tb_string_size(&attr->data));
+                            }
+                        }
+                        break;
+                    case TB_XML_READER_EVENT_TEXT:
+                        if ((data = tb_xml_reader_text(reader))) hash = tb_demo_xml_hash(hash, data, tb_strlen(data));
+                        break;
+                    default:
+                        break;
+                    }
+                }
+            }
+        }
+
+        // exit reader
+        tb_xml_reader_exit(reader);
+    }
+
+    // ok
+    *phash = hash;
+    return (tb_mclock() - time) / TB_DEMO_LOOP_COUNT;
+}
+static tb_size_t tb_demo_xml_node_hash(tb_size_t hash, tb_xml_node_ref_t node)
+{
+    // hash the node names, attributes and texts
+    for (; node; node = node->next)
+    {
+        tb_xml_node_ref_t attr = node->ahead;
+        hash = tb_demo_xml_hash(hash, tb_string_cstr(&node->name), tb_string_size(&node->name));
+        if (node->type == TB_XML_NODE_TYPE_TEXT) hash = tb_demo_xml_hash(hash, tb_string_cstr(&node->data), tb_string_size(&node->data));
+        for (; attr; attr = attr->next) hash = tb_demo_xml_hash(hash, tb_string_cstr(&attr->data), tb_string_size(&attr->data));
+        hash = tb_demo_xml_node_hash(hash, node->chead);
+    }
+    return hash;
+}
+static tb_hong_t tb_demo_xml_load(tb_string_ref_t xml, tb_bool_t arena, tb_size_t* phash)
+{
+    // done
+    tb_size_t   i = 0;
+    tb_size_t   hash = 0;
+    tb_hong_t   time = tb_mclock();
+    for (i = 0; i < TB_DEMO_LOOP_COUNT; i++)
+    {
+        // init reader
+        tb_xml_reader_ref_t reader = tb_xml_reader_init();
+        tb_assert_and_check_break(reader);
+
+        // load and walk the document, exit it
+        hash = 0;
+        if (tb_xml_reader_open(reader, tb_stream_init_from_data((tb_byte_t const*)tb_string_cstr(xml), tb_string_size(xml)), tb_true))
+        {
+            tb_xml_node_ref_t document = arena? tb_xml_reader_load_arena(reader, tb_true) : tb_xml_reader_load(reader);
+            if (document)
+            {
+                hash = tb_demo_xml_node_hash(hash, document->chead);
+                tb_xml_node_exit(document);
+            }
+        }
+
+        // exit reader
+        tb_xml_reader_exit(reader);
+    }
+
+    // ok
+    *phash = hash;
+    return (tb_mclock() - time) / TB_DEMO_LOOP_COUNT;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * main
+ */
+tb_int_t tb_demo_xml_reader_benchmark_main(tb_int_t argc, tb_char_t** argv)
+{
+    // init xml
+    tb_string_t xml;
+    if (!tb_string_init(&xml)) return -1;
+
+    // make xml
+    tb_demo_xml_make(&xml, argv[1]? tb_atoi(argv[1]) : TB_DEMO_RECORD_COUNT);
+    tb_size_t size = tb_string_size(&xml);
+
+    // read it, the slices will decode the entities, so the hash is different from the strings
+    tb_size_t hash_stream = 0;
+    tb_size_t hash_buffer = 0;
+    tb_size_t hash_slice = 0;
+    tb_hong_t t_stream = tb_demo_xml_read(&xml, TB_XML_READER_MODE_STREAM, tb_false, &hash_stream);
+    tb_hong_t t_buffer = tb_demo_xml_read(&xml, TB_XML_READER_MODE_BUFFER, tb_false, &hash_buffer);
+    tb_hong_t t_slice = tb_demo_xml_read(&xml, TB_XML_READER_MODE_BUFFER, tb_true, &hash_slice);
+
+    // load it
+    tb_size_t hash_heap = 0;
+    tb_size_t hash_arena = 0;
+    tb_hong_t t_heap = tb_demo_xml_load(&xml, tb_false, &hash_heap);
+    tb_hong_t t_arena = tb_demo_xml_load(&xml, tb_true, &hash_arena);
+
+    // trace
+    tb_trace_i("size: %lu bytes, equal: %s", size, hash_stream == hash_buffer? "ok" : "no");
+    tb_trace_i("stream: %lld ms, %lld MB/s", t_stream, (tb_hong_t)size * 1000 / tb_max(t_stream, 1) / (1024 * 1024));
+    tb_trace_i("buffer: %lld ms, %lld MB/s", t_buffer, (tb_hong_t)size * 1000 / tb_max(t_buffer, 1) / (1024 * 1024));
+    tb_trace_i("slice: %lld ms, %lld MB/s, hash: %lx", t_slice, (tb_hong_t)size * 1000 / tb_max(t_slice, 1) / (1024 * 1024), hash_slice);
+    tb_trace_i("load: heap: %lld ms, arena: %lld ms, equal: %s", t_heap, t_arena, hash_heap == hash_arena? "ok" : "no");
+
+    // exit xml
+    tb_string_exit(&xml);
+    return 0;
+}
@@ -0,0 +1,789 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.c
+ * @ingroup     container
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "flat_hash_map"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "flat_hash_map.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../platform/platform.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the group width of the control bytes
+#ifdef TB_ARCH_SSE2
+#   define TB_FLAT_HASH_MAP_GROUP_WIDTH             (16)
+#else
+#   define TB_FLAT_HASH_MAP_GROUP_WIDTH             (8)
+#endif
+
+// the control bytes
+#define TB_FLAT_HASH_MAP_CTRL_EMPTY                 (0x80)
+#define TB_FLAT_HASH_MAP_CTRL_DELETED               (0xfe)
+
+// is full control byte?
+#define tb_flat_hash_map_ctrl_is_full(ctrl)         (!((ctrl) & 0x80))
+
+// the default item maxn
+#ifdef __tb_small__
+#   define TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT       (16)
+#else
+#   define TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT       (64)
+#endif
+
+// the growth limit for the given capacity, the max load factor: 7/8
+#define tb_flat_hash_map_growth_limit(capacity)     ((capacity) - ((capacity) >> 3))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the name mode enum
+typedef enum __tb_flat_hash_map_name_mode_e
+{
+    TB_FLAT_HASH_MAP_NAME_MODE_NONE     = 0     //!< uses the element functions
+,   TB_FLAT_HASH_MAP_NAME_MODE_STR      = 1     //!< the case string, inlined
+,   TB_FLAT_HASH_MAP_NAME_MODE_SIZE     = 2     //!< the long or size integer, inlined
+
+}tb_flat_hash_map_name_mode_e;
+
+// the group match mask type, each bit (sse2) or each byte (portable) is one slot
+#ifdef TB_ARCH_SSE2
+typedef tb_uint32_t                         tb_flat_hash_map_mask_t;
+#else
+typedef tb_uint64_t                         tb_flat_hash_map_mask_t;
+#endif
+
+// the flat hash map type
+typedef struct __tb_flat_hash_map_t
+{
+    // the item itor
+    tb_iterator_t                   itor;
+
+    // the control list, capacity + group width (the head group is mirrored to the tail)
+    tb_byte_t*                      ctrl_list;
+
+    // the slot list
+    tb_byte_t*                      slot_list;
+
+    // the slot step
+    tb_size_t                       slot_step;
+
+    // the capacity, pow2
+    tb_size_t                       capacity;
+
+    // the item size
+    tb_size_t                       item_size;
+
+    // the left item count before growing
+    tb_size_t                       growth_left;
+
+    // the name mode
+    tb_size_t                       name_mode;
+
+    // the current item for iterator
+    tb_hash_map_item_t              item;
+
+    // the element for name
+    tb_element_t                    element_name;
+
+    // the element for data
+    tb_element_t                    element_data;
+
+}tb_flat_hash_map_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+#ifdef TB_ARCH_SSE2
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    __m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+    return (tb_flat_hash_map_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((tb_char_t)h2), group));
+}
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match_empty(tb_byte_t const* ctrl)
+{
+    __m128i group = _mm_loadu_si128((__m128i const*)ctrl);
+    return (tb_flat_hash_map_mask_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((tb_char_t)TB_FLAT_HASH_MAP_CTRL_EMPTY), group));
+}
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match_free(tb_byte_t const* ctrl)
+{
+    // the empty and deleted control bytes have the sign bit
+    return (tb_flat_hash_map_mask_t)_mm_movemask_epi8(_mm_loadu_si128((__m128i const*)ctrl));
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_mask_head(tb_flat_hash_map_mask_t mask)
+{
+    // the index of the first matched slot
+    return tb_bits_fb1_u32_le(mask);
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_mask_tail(tb_flat_hash_map_mask_t mask)
+{
+    // the count of the unmatched slots at the tail of group
+    return tb_bits_fb1_u32_be(mask) - 16;
+}
+#else
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match(tb_byte_t const* ctrl, tb_byte_t h2)
+{
+    /* match the zero bytes with swar
+     *
+     * @note it may match a false positive full slot, but we will compare the name
+     */
+    tb_uint64_t x = tb_bits_get_u64_le(ctrl) ^ (0x0101010101010101ULL * h2);
+    return (x - 0x0101010101010101ULL) & ~x & 0x8080808080808080ULL;
+}
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match_empty(tb_byte_t const* ctrl)
+{
+    tb_uint64_t group = tb_bits_get_u64_le(ctrl);
+    return group & (~group << 6) & 0x8080808080808080ULL;
+}
+static __tb_inline__ tb_flat_hash_map_mask_t tb_flat_hash_map_group_match_free(tb_byte_t const* ctrl)
+{
+    tb_uint64_t group = tb_bits_get_u64_le(ctrl);
+    return group & (~group << 7) & 0x8080808080808080ULL;
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_mask_head(tb_flat_hash_map_mask_t mask)
+{
+    tb_uint32_t low = (tb_uint32_t)mask;
+    return (low? tb_bits_fb1_u32_le(low) : 32 + tb_bits_fb1_u32_le((tb_uint32_t)(mask >> 32))) >> 3;
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_mask_tail(tb_flat_hash_map_mask_t mask)
+{
+    tb_uint32_t high = (tb_uint32_t)(mask >> 32);
+    return (high? tb_bits_fb1_u32_be(high) : 32 + tb_bits_fb1_u32_be((tb_uint32_t)mask)) >> 3;
+}
+#endif
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash_mix(tb_size_t hash)
+{
+#if TB_CPU_BIT64
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+#else
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+#endif
+    return hash;
+}
+static __tb_inline__ tb_size_t tb_flat_hash_map_hash(tb_flat_hash_map_t* hash_map, tb_cpointer_t name)
+{
+    switch (hash_map->name_mode)
+    {
+    case TB_FLAT_HASH_MAP_NAME_MODE_SIZE:
+        return tb_flat_hash_map_hash_mix((tb_size_t)name);
+    case TB_FLAT_HASH_MAP_NAME_MODE_STR:
+        {
+            // the fnv-1a hash
+            tb_size_t           hash = 2166136261ul;
+            tb_byte_t const*    p = (tb_byte_t const*)name;
+            while (*p) hash = (hash ^ *p++) * 16777619ul;
+            return tb_flat_hash_map_hash_mix(hash);
+        }
+    default:
+        return tb_flat_hash_map_hash_mix(hash_map->element_name.hash(&hash_map->element_name, name, (tb_size_t)-1, 0));
+    }
+}
+static __tb_inline__ tb_bool_t tb_flat_hash_map_slot_equal(tb_flat_hash_map_t* hash_map, tb_byte_t const* slot, tb_cpointer_t name)
+{
+    switch (hash_map->name_mode)
+    {
+    case TB_FLAT_HASH_MAP_NAME_MODE_SIZE:
+        return *((tb_size_t const*)slot) == (tb_size_t)name;
+    case TB_FLAT_HASH_MAP_NAME_MODE_STR:
+        {
+            tb_char_t const* cstr = *((tb_char_t const**)slot);
+            return cstr == (tb_char_t const*)name || !tb_strcmp(cstr, (tb_char_t const*)name);
+        }
+    default:
+        return !hash_map->element_name.comp(&hash_map->element_name, name, hash_map->element_name.data(&hash_map->element_name, slot));
+    }
+}
+static __tb_inline__ tb_void_t tb_flat_hash_map_ctrl_set(tb_byte_t* ctrl_list, tb_size_t capacity, tb_size_t index, tb_byte_t ctrl)
+{
+    // set it
+    ctrl_list[index] = ctrl;
+
+    // mirror the head group to the tail
+    if (index < TB_FLAT_HASH_MAP_GROUP_WIDTH) ctrl_list[capacity + index] = ctrl;
+}
+static tb_size_t tb_flat_hash_map_slot_find(tb_flat_hash_map_t* hash_map, tb_cpointer_t name, tb_size_t hash)
+{
+    // the probe position and fingerprint
+    tb_size_t   mask = hash_map->capacity - 1;
+    tb_size_t   pos = (hash >> 7) & mask;
+    tb_size_t   step = 0;
+    tb_byte_t   h2 = (tb_byte_t)(hash & 0x7f);
+
+    // probe groups
+    while (1)
+    {
+        // compare the names of the matched slots
+        tb_byte_t const*        ctrl = hash_map->ctrl_list + pos;
+        tb_flat_hash_map_mask_t matched = tb_flat_hash_map_group_match(ctrl, h2);
+        while (matched)
+        {
+            // the slot index
+            tb_size_t index = (pos + tb_flat_hash_map_mask_head(matched)) & mask;
+
+            // found?
+            if (tb_flat_hash_map_slot_equal(hash_map, hash_map->slot_list + index * hash_map->slot_step, name)) return index;
+
+            // next
+            matched &= matched - 1;
+        }
+
+        // this group has empty slot? not found
+        if (tb_flat_hash_map_group_match_empty(ctrl)) break;
+
+        // next group, the triangular probing will visit all groups
+        step += TB_FLAT_HASH_MAP_GROUP_WIDTH;
+        tb_check_break(step <= mask);
+        pos = (pos + step) & mask;
+    }
+
+    // not found
+    return (tb_size_t)-1;
+}
+static tb_size_t tb_flat_hash_map_slot_free(tb_byte_t const* ctrl_list, tb_size_t capacity, tb_size_t hash)
+{
+    // the probe position
+    tb_size_t   mask = capacity - 1;
+    tb_size_t   pos = (hash >> 7) & mask;
+    tb_size_t   step = 0;
+
+    // probe groups
+    while (1)
+    {
+        // find the first empty or deleted slot
+        tb_flat_hash_map_mask_t matched = tb_flat_hash_map_group_match_free(ctrl_list + pos);
+        if (matched) return (pos + tb_flat_hash_map_mask_head(matched)) & mask;
+
+        // next group
+        step += TB_FLAT_HASH_MAP_GROUP_WIDTH;
+        tb_assert_and_check_break(step <= mask);
+        pos = (pos + step) & mask;
+    }
+
+    // no free slot
+    return (tb_size_t)-1;
+}
+static tb_bool_t tb_flat_hash_map_resize(tb_flat_hash_map_t* hash_map, tb_size_t capacity)
+{
+    // check
+    tb_assert_and_check_return_val(hash_map && tb_ispow2(capacity) && capacity >= TB_FLAT_HASH_MAP_GROUP_WIDTH, tb_false);
+    tb_assert_and_check_return_val(tb_flat_hash_map_growth_limit(capacity) >= hash_map->item_size, tb_false);
+
+    // done
+    tb_bool_t   ok = tb_false;
+    tb_byte_t*  ctrl_list = tb_null;
+    tb_byte_t*  slot_list = tb_null;
+    do
+    {
+        // make the new control list
+        ctrl_list = (tb_byte_t*)tb_malloc(capacity + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+        tb_assert_and_check_break(ctrl_list);
+        tb_memset(ctrl_list, TB_FLAT_HASH_MAP_CTRL_EMPTY, capacity + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+
+        // make the new slot list
+        slot_list = (tb_byte_t*)tb_nalloc(capacity, hash_map->slot_step);
+        tb_assert_and_check_break(slot_list);
+
+        // move the old items, we need not duplicate them
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->ctrl_list? hash_map->capacity : 0;
+        tb_size_t step = hash_map->slot_step;
+        for (i = 0; i < n; i++)
+        {
+            // full?
+            tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl_list[i]));
+
+            // the slot
+            tb_byte_t const* slot = hash_map->slot_list + i * step;
+
+            // find a free slot in the new list
+            tb_size_t hash = tb_flat_hash_map_hash(hash_map, hash_map->element_name.data(&hash_map->element_name, slot));
+            tb_size_t index = tb_flat_hash_map_slot_free(ctrl_list, capacity, hash);
+            tb_assert_and_check_break(index < capacity);
+
+            // move it
+            tb_flat_hash_map_ctrl_set(ctrl_list, capacity, index, (tb_byte_t)(hash & 0x7f));
+            tb_memcpy(slot_list + index * step, slot, step);
+        }
+        tb_check_break(i == n);
+
+        // free the old lists
+        if (hash_map->ctrl_list) tb_free(hash_map->ctrl_list);
+        if (hash_map->slot_list) tb_free(hash_map->slot_list);
+
+        // update lists
+        hash_map->ctrl_list     = ctrl_list;
+        hash_map->slot_list     = slot_list;
+        hash_map->capacity      = capacity;
+        hash_map->growth_left   = tb_flat_hash_map_growth_limit(capacity) - hash_map->item_size;
+        ctrl_list = tb_null;
+        slot_list = tb_null;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? 
+    if (ctrl_list) tb_free(ctrl_list);
+    if (slot_list) tb_free(slot_list);
+
+    // ok?
+    return ok;
+}
+static tb_void_t tb_flat_hash_map_slot_remove(tb_flat_hash_map_t* hash_map, tb_size_t index)
+{
+    // check
+    tb_assert(index < hash_map->capacity && tb_flat_hash_map_ctrl_is_full(hash_map->ctrl_list[index]));
+
+    // free item
+    tb_byte_t* slot = hash_map->slot_list + index * hash_map->slot_step;
+    if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, slot);
+    if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, slot + hash_map->element_name.size);
+
+    /* we can mark it as empty directly if all groups containing this slot have empty slots,
+     * because no probing has passed this slot, otherwise mark it as deleted.
+     */
+    tb_size_t               mask = hash_map->capacity - 1;
+    tb_flat_hash_map_mask_t empty_after = tb_flat_hash_map_group_match_empty(hash_map->ctrl_list + index);
+    tb_flat_hash_map_mask_t empty_before = tb_flat_hash_map_group_match_empty(hash_map->ctrl_list + ((index - TB_FLAT_HASH_MAP_GROUP_WIDTH) & mask));
+    if (empty_after && empty_before && tb_flat_hash_map_mask_head(empty_after) + tb_flat_hash_map_mask_tail(empty_before) < TB_FLAT_HASH_MAP_GROUP_WIDTH)
+    {
+        tb_flat_hash_map_ctrl_set(hash_map->ctrl_list, hash_map->capacity, index, TB_FLAT_HASH_MAP_CTRL_EMPTY);
+        hash_map->growth_left++;
+    }
+    else tb_flat_hash_map_ctrl_set(hash_map->ctrl_list, hash_map->capacity, index, TB_FLAT_HASH_MAP_CTRL_DELETED);
+
+    // update the item size
+    hash_map->item_size--;
+}
+static tb_size_t tb_flat_hash_map_slot_next(tb_flat_hash_map_t* hash_map, tb_size_t index)
+{
+    // find the next full slot
+    tb_size_t n = hash_map->capacity;
+    tb_byte_t const* ctrl_list = hash_map->ctrl_list;
+    while (index < n)
+    {
+        // skip the free slots of the whole group
+        if (index + TB_FLAT_HASH_MAP_GROUP_WIDTH <= n)
+        {
+            tb_flat_hash_map_mask_t freed = tb_flat_hash_map_group_match_free(ctrl_list + index);
+#ifdef TB_ARCH_SSE2
+            if (freed == 0xffff)
+#else
+            if (freed == 0x8080808080808080ULL)
+#endif
+            {
+                index += TB_FLAT_HASH_MAP_GROUP_WIDTH;
+                continue;
+            }
+        }
+
+        // full?
+        if (tb_flat_hash_map_ctrl_is_full(ctrl_list[index])) return index + 1;
+        index++;
+    }
+
+    // tail
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_size(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // the size
+    return hash_map->item_size;
+}
+static tb_size_t tb_flat_hash_map_itor_head(tb_iterator_ref_t iterator)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map);
+
+    // find the head
+    return hash_map->item_size? tb_flat_hash_map_slot_next(hash_map, 0) : 0;
+}
+static tb_size_t tb_flat_hash_map_itor_tail(tb_iterator_ref_t iterator)
+{
+    return 0;
+}
+static tb_size_t tb_flat_hash_map_itor_next(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && itor && itor <= hash_map->capacity);
+
+    // find the next from the next slot, itor = index + 1
+    return tb_flat_hash_map_slot_next(hash_map, itor);
+}
+static tb_pointer_t tb_flat_hash_map_itor_item(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return_val(hash_map && itor && itor <= hash_map->capacity, tb_null);
+
+    // the slot
+    tb_byte_t const* slot = hash_map->slot_list + (itor - 1) * hash_map->slot_step;
+
+    // get item
+    hash_map->item.name = hash_map->element_name.data(&hash_map->element_name, slot);
+    hash_map->item.data = hash_map->element_data.data(&hash_map->element_data, slot + hash_map->element_name.size);
+    return &(hash_map->item);
+}
+static tb_void_t tb_flat_hash_map_itor_copy(tb_iterator_ref_t iterator, tb_size_t itor, tb_cpointer_t item)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return(hash_map && itor && itor <= hash_map->capacity);
+
+    // note: copy data only, will destroy hash_map index if copy name
+    hash_map->element_data.copy(&hash_map->element_data, hash_map->slot_list + (itor - 1) * hash_map->slot_step + hash_map->element_name.size, item);
+}
+static tb_long_t tb_flat_hash_map_itor_comp(tb_iterator_ref_t iterator, tb_cpointer_t lelement, tb_cpointer_t relement)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert(hash_map && hash_map->element_name.comp && lelement && relement);
+    
+    // done
+    return hash_map->element_name.comp(&hash_map->element_name, ((tb_hash_map_item_ref_t)lelement)->name, ((tb_hash_map_item_ref_t)relement)->name);
+}
+static tb_void_t tb_flat_hash_map_itor_remove(tb_iterator_ref_t iterator, tb_size_t itor)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return(hash_map && itor && itor <= hash_map->capacity);
+
+    // remove it, the other slots will not be moved
+    tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+}
+static tb_void_t tb_flat_hash_map_itor_nremove(tb_iterator_ref_t iterator, tb_size_t prev, tb_size_t next, tb_size_t size)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)iterator;
+    tb_assert_and_check_return(hash_map);
+
+    // remove items: [prev + 1, next)
+    tb_size_t itor = prev? tb_flat_hash_map_itor_next(iterator, prev) : tb_flat_hash_map_itor_head(iterator);
+    while (itor && itor != next && size--)
+    {
+        // save the next itor first
+        tb_size_t itor_next = tb_flat_hash_map_itor_next(iterator, itor);
+
+        // remove it
+        tb_flat_hash_map_slot_remove(hash_map, itor - 1);
+
+        // next
+        itor = itor_next;
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_flat_hash_map_ref_t tb_flat_hash_map_init(tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data)
+{
+    // check
+    tb_assert_and_check_return_val(element_name.size && element_name.hash && element_name.comp && element_name.data && element_name.dupl, tb_null);
+    tb_assert_and_check_return_val(element_data.data && element_data.dupl && element_data.repl, tb_null);
+
+    // check item maxn
+    if (!item_maxn) item_maxn = TB_FLAT_HASH_MAP_ITEM_MAXN_DEFAULT;
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_flat_hash_map_t* hash_map = tb_null;
+    do
+    {
+        // make hash map
+        hash_map = tb_malloc0_type(tb_flat_hash_map_t);
+        tb_assert_and_check_break(hash_map);
+
+        // init element
+        hash_map->element_name = element_name;
+        hash_map->element_data = element_data;
+        hash_map->slot_step    = element_name.size + element_data.size;
+
+        // init name mode, the inlined names must be compatible with the element functions
+        if (element_name.type == TB_ELEMENT_TYPE_STR && element_name.flag)
+            hash_map->name_mode = TB_FLAT_HASH_MAP_NAME_MODE_STR;
+        else if ((element_name.type == TB_ELEMENT_TYPE_LONG || element_name.type == TB_ELEMENT_TYPE_SIZE) && element_name.size == sizeof(tb_size_t))
+            hash_map->name_mode = TB_FLAT_HASH_MAP_NAME_MODE_SIZE;
+        else hash_map->name_mode = TB_FLAT_HASH_MAP_NAME_MODE_NONE;
+
+        // init operation
+        static tb_iterator_op_t op = 
+        {
+            tb_flat_hash_map_itor_size
+        ,   tb_flat_hash_map_itor_head
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_tail
+        ,   tb_null
+        ,   tb_flat_hash_map_itor_next
+        ,   tb_flat_hash_map_itor_item
+        ,   tb_flat_hash_map_itor_comp
+        ,   tb_flat_hash_map_itor_copy
+        ,   tb_flat_hash_map_itor_remove
+        ,   tb_flat_hash_map_itor_nremove
+        };
+
+        // init iterator
+        hash_map->itor.priv = tb_null;
+        hash_map->itor.step = sizeof(tb_hash_map_item_t);
+        hash_map->itor.mode = TB_ITERATOR_MODE_FORWARD | TB_ITERATOR_MODE_MUTABLE;
+        hash_map->itor.op   = &op;
+
+        // init slots
+        tb_size_t capacity = tb_align_pow2(item_maxn + (item_maxn >> 3) + 1);
+        if (capacity < TB_FLAT_HASH_MAP_GROUP_WIDTH) capacity = TB_FLAT_HASH_MAP_GROUP_WIDTH;
+        if (!tb_flat_hash_map_resize(hash_map, capacity)) break;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (hash_map) tb_flat_hash_map_exit((tb_flat_hash_map_ref_t)hash_map);
+        hash_map = tb_null;
+    }
+
+    // ok?
+    return (tb_flat_hash_map_ref_t)hash_map;
+}
+tb_void_t tb_flat_hash_map_exit(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // clear it
+    tb_flat_hash_map_clear(self);
+
+    // free lists
+    if (hash_map->ctrl_list) tb_free(hash_map->ctrl_list);
+    if (hash_map->slot_list) tb_free(hash_map->slot_list);
+
+    // free it
+    tb_free(hash_map);
+}
+tb_void_t tb_flat_hash_map_clear(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // no lists?
+    tb_check_return(hash_map->ctrl_list && hash_map->slot_list);
+
+    // free items
+    if (hash_map->item_size && (hash_map->element_name.free || hash_map->element_data.free))
+    {
+        tb_size_t i = 0;
+        tb_size_t n = hash_map->capacity;
+        for (i = 0; i < n; i++)
+        {
+            // full?
+            tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl_list[i]));
+
+            // free it
+            tb_byte_t* slot = hash_map->slot_list + i * hash_map->slot_step;
+            if (hash_map->element_name.free) hash_map->element_name.free(&hash_map->element_name, slot);
+            if (hash_map->element_data.free) hash_map->element_data.free(&hash_map->element_data, slot + hash_map->element_name.size);
+        }
+    }
+
+    // clear the control list
+    tb_memset(hash_map->ctrl_list, TB_FLAT_HASH_MAP_CTRL_EMPTY, hash_map->capacity + TB_FLAT_HASH_MAP_GROUP_WIDTH);
+
+    // reset info
+    hash_map->item_size     = 0;
+    hash_map->growth_left   = tb_flat_hash_map_growth_limit(hash_map->capacity);
+    tb_memset(&hash_map->item, 0, sizeof(tb_hash_map_item_t));
+}
+tb_pointer_t tb_flat_hash_map_get(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, tb_null);
+
+    // find it
+    tb_size_t index = tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+    tb_check_return_val(index != (tb_size_t)-1, tb_null);
+
+    // get data
+    return hash_map->element_data.data(&hash_map->element_data, hash_map->slot_list + index * hash_map->slot_step + hash_map->element_name.size);
+}
+tb_size_t tb_flat_hash_map_find(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tb_size_t index = tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+    return index != (tb_size_t)-1? index + 1 : 0;
+}
+tb_size_t tb_flat_hash_map_insert(tb_flat_hash_map_ref_t self, tb_cpointer_t name, tb_cpointer_t data)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // find it
+    tb_size_t hash  = tb_flat_hash_map_hash(hash_map, name);
+    tb_size_t index = tb_flat_hash_map_slot_find(hash_map, name, hash);
+    if (index != (tb_size_t)-1)
+    {
+        // replace data
+        hash_map->element_data.repl(&hash_map->element_data, hash_map->slot_list + index * hash_map->slot_step + hash_map->element_name.size, data);
+        return index + 1;
+    }
+
+    // no free slot? grow it or only drop the deleted slots
+    if (!hash_map->growth_left)
+    {
+        tb_size_t capacity = hash_map->capacity;
+        if (hash_map->item_size >= (tb_flat_hash_map_growth_limit(capacity) >> 1)) capacity <<= 1;
+        if (!tb_flat_hash_map_resize(hash_map, capacity)) return 0;
+    }
+
+    // find a free slot
+    index = tb_flat_hash_map_slot_free(hash_map->ctrl_list, hash_map->capacity, hash);
+    tb_assert_and_check_return_val(index < hash_map->capacity, 0);
+
+    // the deleted slot will not consume the growth
+    if (hash_map->ctrl_list[index] == TB_FLAT_HASH_MAP_CTRL_EMPTY) hash_map->growth_left--;
+    tb_flat_hash_map_ctrl_set(hash_map->ctrl_list, hash_map->capacity, index, (tb_byte_t)(hash & 0x7f));
+
+    // dupl item
+    tb_byte_t* slot = hash_map->slot_list + index * hash_map->slot_step;
+    hash_map->element_name.dupl(&hash_map->element_name, slot, name);
+    hash_map->element_data.dupl(&hash_map->element_data, slot + hash_map->element_name.size, data);
+
+    // update the item size
+    hash_map->item_size++;
+
+    // ok
+    return index + 1;
+}
+tb_void_t tb_flat_hash_map_remove(tb_flat_hash_map_ref_t self, tb_cpointer_t name)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map);
+
+    // find it
+    tb_size_t index = tb_flat_hash_map_slot_find(hash_map, name, tb_flat_hash_map_hash(hash_map, name));
+    if (index != (tb_size_t)-1) tb_flat_hash_map_slot_remove(hash_map, index);
+}
+tb_size_t tb_flat_hash_map_size(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the size
+    return hash_map->item_size;
+}
+tb_size_t tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t const* hash_map = (tb_flat_hash_map_t const*)self;
+    tb_assert_and_check_return_val(hash_map, 0);
+
+    // the maxn
+    return hash_map->capacity;
+}
+#ifdef __tb_debug__
+tb_void_t tb_flat_hash_map_dump(tb_flat_hash_map_ref_t self)
+{
+    // check
+    tb_flat_hash_map_t* hash_map = (tb_flat_hash_map_t*)self;
+    tb_assert_and_check_return(hash_map && hash_map->ctrl_list);
+
+    // trace
+    tb_trace_i("");
+    tb_trace_i("self: size: %lu, maxn: %lu, growth_left: %lu", hash_map->item_size, hash_map->capacity, hash_map->growth_left);
+
+    // done
+    tb_size_t i = 0;
+    tb_char_t name[4096];
+    tb_char_t data[4096];
+    for (i = 0; i < hash_map->capacity; i++)
+    {
+        // full?
+        tb_check_continue(tb_flat_hash_map_ctrl_is_full(hash_map->ctrl_list[i]));
+
+        // the item name and data
+        tb_byte_t const*    slot = hash_map->slot_list + i * hash_map->slot_step;
+        tb_pointer_t        element_name = hash_map->element_name.data(&hash_map->element_name, slot);
+        tb_pointer_t        element_data = hash_map->element_data.data(&hash_map->element_data, slot + hash_map->element_name.size);
+
+        // trace
+        if (hash_map->element_name.cstr && hash_map->element_data.cstr)
+        {
+            tb_trace_i("    [%lu]: %s => %s", i, hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
+        }
+        else if (hash_map->element_name.cstr) 
+        {
+            tb_trace_i("    [%lu]: %s => %p", i, hash_map->element_name.cstr(&hash_map->element_name, element_name, name, sizeof(name)), element_data);
+        }
+        else if (hash_map->element_data.cstr) 
+        {
+            tb_trace_i("    [%lu]: %p => %s", i, element_name, hash_map->element_data.cstr(&hash_map->element_data, element_data, data, sizeof(data)));
+        }
+        else 
+        {
+            tb_trace_i("    [%lu]: %p => %p", i, element_name, element_data);
+        }
+    }
+}
+#endif
@@ -0,0 +1,168 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        flat_hash_map.h
+ * @ingroup     container
+ *
+ */
+#ifndef TB_CONTAINER_FLAT_HASH_MAP_H
+#define TB_CONTAINER_FLAT_HASH_MAP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "element.h"
+#include "iterator.h"
+#include "hash_map.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the flat hash map ref type
+ *
+ * an open-addressing hash map (swiss table), all items are stored in one flat slot array 
+ * and each slot has a control byte with the 7-bits fingerprint of the item hash.
+ *
+ * <pre>
+ *
+ *                    group: 16 control bytes (sse2) or 8 control bytes (portable)
+ *                  |-------------------------------|
+ * ctrl_list: |e|d|5|e|17|e|...|63|e|e|...                   |mirror of the head group|
+ *                 |     |        |
+ * slot_list: | | |x| |x | |...|x | | |...
+ *
+ * e: empty, d: deleted, 0-127: the fingerprint of the full slot
+ *
+ * </pre>
+ *
+ * lookup probes one group of control bytes at once, 
+ * compares the fingerprints with sse2 and compares only the matched names.
+ *
+ * the string (case), long and size names are inlined without calling the element functions.
+ *
+ * the iterator item is tb_hash_map_item_t, so it is compatible with tb_hash_map for tb_walk, tb_remove_if, ..
+ *
+ * @note the itor of the same item is mutable
+ */
+typedef tb_iterator_ref_t tb_flat_hash_map_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init flat hash map
+ *
+ * @param item_maxn     the initial item maxn, using the default size if be zero
+ * @param element_name  the item for name
+ * @param element_data  the item for data
+ *
+ * @return              the flat hash map
+ */
+tb_flat_hash_map_ref_t  tb_flat_hash_map_init(tb_size_t item_maxn, tb_element_t element_name, tb_element_t element_data);
+
+/*! exit flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_exit(tb_flat_hash_map_ref_t hash_map);
+
+/*! clear flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_clear(tb_flat_hash_map_ref_t hash_map);
+
+/*! get item data from name
+ *
+ * @note the return value may be zero if the item type is integer, see tb_hash_map_get()
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item data
+ */
+tb_pointer_t            tb_flat_hash_map_get(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! find item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_find(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! insert item data from name
+ *
+ * @note the pair (name => data) is unique
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ * @param data          the item data
+ *
+ * @return              the item itor, @note: the itor of the same item is mutable
+ */
+tb_size_t               tb_flat_hash_map_insert(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name, tb_cpointer_t data);
+
+/*! remove item from name
+ *
+ * @param hash_map      the flat hash map
+ * @param name          the item name
+ */
+tb_void_t               tb_flat_hash_map_remove(tb_flat_hash_map_ref_t hash_map, tb_cpointer_t name);
+
+/*! the flat hash map size
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map size
+ */
+tb_size_t               tb_flat_hash_map_size(tb_flat_hash_map_ref_t hash_map);
+
+/*! the flat hash map maxn
+ *
+ * @param hash_map      the flat hash map
+ *
+ * @return              the flat hash map maxn (the slot count)
+ */
+tb_size_t               tb_flat_hash_map_maxn(tb_flat_hash_map_ref_t hash_map);
+
+#ifdef __tb_debug__
+/*! dump flat hash map
+ *
+ * @param hash_map      the flat hash map
+ */
+tb_void_t               tb_flat_hash_map_dump(tb_flat_hash_map_ref_t hash_map);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
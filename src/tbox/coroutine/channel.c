@@ -83,6 +83,9 @@ typedef struct __tb_co_channel_t
     // the waiting recv coroutines 
     tb_single_list_entry_head_t     waiting_recv;
 
+    // the lock, the channel may be shared by the coroutines on different threads
+    tb_spinlock_t                   lock;
+
 }tb_co_channel_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -105,13 +108,17 @@ static tb_bool_t tb_co_channel_send_resume(tb_co_channel_t* channel, tb_pointer_
         tb_single_list_entry_remove_head(&channel->waiting_send);
 
         // get the waiting send coroutine
-        tb_coroutine_ref_t waiting = (tb_coroutine_ref_t)tb_single_list_entry(&channel->waiting_send, entry);
+        tb_coroutine_t* waiting = (tb_coroutine_t*)tb_single_list_entry(&channel->waiting_send, entry);
 
-        // resume this coroutine and recv data
-        tb_pointer_t data = tb_coroutine_resume(waiting, tb_null);
+        /* recv the sent data under the lock before resuming it
+         *
+         * @note we cannot get it from tb_coroutine_resume(), 
+         * it returns nothing if the waiting coroutine is resumed from other thread
+         */
+        if (pdata) *pdata = (tb_pointer_t)waiting->rs_priv;
 
-        // save data
-        if (pdata) *pdata = data;
+        // resume this coroutine
+        tb_coroutine_resume((tb_coroutine_ref_t)waiting, tb_null);
 
         // ok
         ok = tb_true;
@@ -151,11 +158,16 @@ static tb_void_t tb_co_channel_send_suspend(tb_co_channel_t* channel, tb_cpointe
     tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
     tb_assert(running);
 
+    // save the sent data first, it may be resumed from other threads before suspending
+    running->rs_priv = data;
+
     // save this coroutine to the waiting send coroutines
     tb_single_list_entry_insert_tail(&channel->waiting_send, &running->rs.single_entry);
 
     // send data and wait it
+    tb_spinlock_leave(&channel->lock);
     tb_coroutine_suspend(data);
+    tb_spinlock_enter(&channel->lock);
 }
 static tb_void_t tb_co_channel_recv_suspend(tb_co_channel_t* channel)
 {
@@ -166,11 +178,16 @@ static tb_void_t tb_co_channel_recv_suspend(tb_co_channel_t* channel)
     tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
     tb_assert(running);
 
+    // clear the passed data first, it may be resumed from other threads before suspending
+    running->rs_priv = tb_null;
+
     // save this coroutine to the waiting recv coroutines
     tb_single_list_entry_insert_tail(&channel->waiting_recv, &running->rs.single_entry);
 
     // wait data
+    tb_spinlock_leave(&channel->lock);
     tb_coroutine_suspend(tb_null);
+    tb_spinlock_enter(&channel->lock);
 }
 static tb_void_t tb_co_channel_send_buffer(tb_co_channel_t* channel, tb_cpointer_t data)
 {
@@ -377,6 +394,9 @@ tb_co_channel_ref_t tb_co_channel_init(tb_size_t size, tb_co_channel_free_func_t
         // init waiting recv coroutines
         tb_single_list_entry_init(&channel->waiting_recv, tb_coroutine_t, rs.single_entry, tb_null);
 
+        // init lock
+        if (!tb_spinlock_init(&channel->lock)) break;
+
         // init free function and data
         channel->free = free;
         channel->priv = priv;
@@ -444,6 +464,9 @@ tb_void_t tb_co_channel_exit(tb_co_channel_ref_t self)
     tb_single_list_entry_exit(&channel->waiting_send);
     tb_single_list_entry_exit(&channel->waiting_recv);
 
+    // exit lock
+    tb_spinlock_exit(&channel->lock);
+
     // exit the channel
     tb_free(channel);
 }
@@ -454,8 +477,10 @@ tb_void_t tb_co_channel_send(tb_co_channel_ref_t self, tb_cpointer_t data)
     tb_assert_and_check_return(channel);
 
     // send it
+    tb_spinlock_enter(&channel->lock);
     if (channel->queue.data) tb_co_channel_send_buffer(channel, data);
     else tb_co_channel_send_buffer0(channel, data);
+    tb_spinlock_leave(&channel->lock);
 }
 tb_pointer_t tb_co_channel_recv(tb_co_channel_ref_t self)
 {
@@ -464,7 +489,12 @@ tb_pointer_t tb_co_channel_recv(tb_co_channel_ref_t self)
     tb_assert_and_check_return_val(channel, tb_null);
 
     // recv it
-    return channel->queue.data? tb_co_channel_recv_buffer(channel) : tb_co_channel_recv_buffer0(channel);
+    tb_spinlock_enter(&channel->lock);
+    tb_pointer_t data = channel->queue.data? tb_co_channel_recv_buffer(channel) : tb_co_channel_recv_buffer0(channel);
+    tb_spinlock_leave(&channel->lock);
+
+    // ok
+    return data;
 }
 tb_bool_t tb_co_channel_send_try(tb_co_channel_ref_t self, tb_cpointer_t data)
 {
@@ -473,7 +503,12 @@ tb_bool_t tb_co_channel_send_try(tb_co_channel_ref_t self, tb_cpointer_t data)
     tb_assert_and_check_return_val(channel, tb_false);
 
     // try sending it
-    return channel->queue.data? tb_co_channel_send_buffer_try(channel, data) : tb_false;
+    tb_spinlock_enter(&channel->lock);
+    tb_bool_t ok = channel->queue.data? tb_co_channel_send_buffer_try(channel, data) : tb_false;
+    tb_spinlock_leave(&channel->lock);
+
+    // ok?
+    return ok;
 }
 tb_bool_t tb_co_channel_recv_try(tb_co_channel_ref_t self, tb_pointer_t* pdata)
 {
@@ -482,6 +517,11 @@ tb_bool_t tb_co_channel_recv_try(tb_co_channel_ref_t self, tb_pointer_t* pdata)
     tb_assert_and_check_return_val(channel && pdata, tb_false);
 
     // try recving it
-    return channel->queue.data? tb_co_channel_recv_buffer_try(channel, pdata) : tb_false;
+    tb_spinlock_enter(&channel->lock);
+    tb_bool_t ok = channel->queue.data? tb_co_channel_recv_buffer_try(channel, pdata) : tb_false;
+    tb_spinlock_leave(&channel->lock);
+
+    // ok?
+    return ok;
 }
 
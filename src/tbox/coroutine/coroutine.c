@@ -56,13 +56,21 @@ tb_bool_t tb_coroutine_yield()
     // yield the current coroutine
     return scheduler? tb_co_scheduler_yield(scheduler) : tb_false;
 }
-tb_pointer_t tb_coroutine_resume(tb_coroutine_ref_t coroutine, tb_cpointer_t priv)
+tb_pointer_t tb_coroutine_resume(tb_coroutine_ref_t self, tb_cpointer_t priv)
 {
+    // check
+    tb_coroutine_t* coroutine = (tb_coroutine_t*)self;
+    tb_assert_and_check_return_val(coroutine, tb_null);
+
     // get current scheduler
     tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+
+    // this coroutine is owned by the scheduler of other thread? resume it in its io loop
+    if (coroutine->scheduler != (tb_co_scheduler_ref_t)scheduler)
+        return tb_co_scheduler_resume_remote((tb_co_scheduler_t*)coroutine->scheduler, coroutine, priv);
         
     // resume the given coroutine
-    return scheduler? tb_co_scheduler_resume(scheduler, (tb_coroutine_t*)coroutine, priv) : tb_null;
+    return scheduler? tb_co_scheduler_resume(scheduler, coroutine, priv) : tb_null;
 }
 tb_pointer_t tb_coroutine_suspend(tb_cpointer_t priv)
 {
@@ -88,6 +96,14 @@ tb_long_t tb_coroutine_waitio(tb_socket_ref_t sock, tb_size_t events, tb_long_t
     // wait events
     return scheduler? tb_co_scheduler_wait(scheduler, sock, events, timeout) : -1;
 }
+tb_bool_t tb_coroutine_post(tb_poller_op_ref_t op)
+{
+    // get current scheduler
+    tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_self();
+
+    // post it
+    return scheduler? tb_co_scheduler_post(scheduler, op) : tb_false;
+}
 tb_coroutine_ref_t tb_coroutine_self()
 {
     // get coroutine
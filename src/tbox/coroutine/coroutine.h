@@ -34,6 +34,7 @@
 #include "semaphore.h"
 #include "scheduler.h"
 #include "stackless/stackless.h"
+#include "../platform/poller.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -72,11 +73,14 @@ tb_bool_t               tb_coroutine_start(tb_co_scheduler_ref_t scheduler, tb_c
 tb_bool_t               tb_coroutine_yield(tb_noarg_t);
 
 /*! resume the given coroutine (suspended)
+ *
+ * the coroutine can also be resumed from other threads, 
+ * it will be resumed in the io loop of its own scheduler later.
  *
  * @param coroutine     the suspended coroutine
  * @param priv          the user private data as the return value of suspend() or sleep()
  *
- * @return              the user private data from suspend(priv)
+ * @return              the user private data from suspend(priv), always be null if it is resumed from other threads
  */
 tb_pointer_t            tb_coroutine_resume(tb_coroutine_ref_t coroutine, tb_cpointer_t priv);
 
@@ -106,6 +110,30 @@ tb_pointer_t            tb_coroutine_sleep(tb_long_t interval);
  */
 tb_long_t               tb_coroutine_waitio(tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout);
 
+/*! post an io operation to the completion-based poller (e.g. io_uring) and wait it until it has been completed
+ *
+ * @code
+    tb_poller_op_t op = {0};
+    op.code = TB_POLLER_OP_RECV;
+    op.sock = sock;
+    op.data = data;
+    op.size = size;
+    if (tb_coroutine_post(&op)) 
+    {
+        // op.result: > 0: the real size, 0: closed, < 0: failed
+    }
+    else
+    {
+        // not supported, we need wait events with tb_coroutine_waitio()
+    }
+ * @endcode
+ *
+ * @param op            the operation
+ *
+ * @return              tb_true or tb_false (the poller of the current scheduler does not support it)
+ */
+tb_bool_t               tb_coroutine_post(tb_poller_op_ref_t op);
+
 /*! get the current coroutine
  *
  * @return              the current coroutine
@@ -117,4 +145,11 @@ tb_coroutine_ref_t      tb_coroutine_self(tb_noarg_t);
  */
 __tb_extern_c_leave__
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+// the scheduler group depends on the coroutine function type
+#include "scheduler_group.h"
+
 #endif
@@ -64,11 +64,7 @@ typedef struct __tb_coroutine_rs_func_t
 // the coroutine wait type
 typedef struct __tb_coroutine_rs_wait_t
 {
-    /* the timer task pointer for ltimer or timer
-     *
-     * for ltimer:  task
-     * for timer:   task & 0x1
-     */
+    // the timer task pointer of ltimer
     tb_cpointer_t                   task;
 
     // the socket
@@ -123,6 +119,12 @@ typedef struct __tb_coroutine_t
 
     }                               rs;
 
+    // the single entry for the remote coroutines which are resumed from other threads
+    tb_single_list_entry_t          remote_entry;
+
+    // the passed user private data of the remote resume(priv)
+    tb_cpointer_t                   remote_priv;
+
     // the guard
     tb_uint16_t                     guard;
 
@@ -36,6 +36,7 @@
 #include "scheduler.h"
 #include "coroutine.h"
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -160,8 +161,13 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
         if (!coroutine) coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
         tb_assert_and_check_break(coroutine);
 
+        /* in the scheduler group? push it to the fresh coroutines 
+         *
+         * it will be made as ready in the io loop or be stolen by other idle schedulers
+         */
+        if (scheduler->group) tb_co_scheduler_group_push(scheduler->group, scheduler, coroutine);
         // ready coroutine
-        tb_co_scheduler_make_ready(scheduler, coroutine);
+        else tb_co_scheduler_make_ready(scheduler, coroutine);
 
         // the dead coroutines is too much? free some coroutines
         while (tb_list_entry_size(&scheduler->coroutines_dead) > TB_SCHEDULER_DEAD_CACHE_MAXN)
@@ -188,6 +194,17 @@ tb_bool_t tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_
     // ok?
     return ok;
 }
+tb_void_t tb_co_scheduler_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(scheduler && coroutine);
+
+    // it must be owned by this scheduler
+    tb_assert(coroutine->scheduler == (tb_co_scheduler_ref_t)scheduler);
+
+    // make it as ready
+    tb_co_scheduler_make_ready(scheduler, coroutine);
+}
 tb_bool_t tb_co_scheduler_yield(tb_co_scheduler_t* scheduler)
 {
     // check
@@ -248,6 +265,67 @@ tb_pointer_t tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t
     // return it
     return retval;
 }
+tb_pointer_t tb_co_scheduler_resume_remote(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv)
+{
+    // check
+    tb_assert(scheduler && coroutine);
+
+    // trace
+    tb_trace_d("resume remote coroutine(%p)", coroutine);
+
+    /* enter lock
+     *
+     * @note we cannot get the passed private data from suspend(priv) here, 
+     * because the coroutine may be still running on its own thread and has not been suspended now
+     */
+    tb_spinlock_enter(&scheduler->lock);
+
+    // save the user private data, it will be passed to suspend() in the io loop 
+    coroutine->remote_priv = priv;
+
+    // append it to the remote coroutines
+    tb_single_list_entry_insert_tail(&scheduler->coroutines_remote, &coroutine->remote_entry);
+
+    // leave lock
+    tb_spinlock_leave(&scheduler->lock);
+
+    // wake up the io loop of this scheduler 
+    if (scheduler->scheduler_io && (!scheduler->group || tb_atomic_fetch_and_pset(&scheduler->idle, 1, 0)))
+        tb_poller_spak(tb_co_scheduler_io(scheduler)->poller);
+
+    // ok
+    return tb_null;
+}
+tb_size_t tb_co_scheduler_resume_remotes(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler);
+
+    // no remote coroutines? 
+    tb_check_return_val(tb_single_list_entry_size(&scheduler->coroutines_remote), 0);
+
+    // resume all remote coroutines
+    tb_size_t count = 0;
+    tb_spinlock_enter(&scheduler->lock);
+    while (tb_single_list_entry_size(&scheduler->coroutines_remote))
+    {
+        // get the next entry from head
+        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&scheduler->coroutines_remote);
+        tb_assert_and_check_break(entry);
+
+        // remove it from the remote coroutines
+        tb_single_list_entry_remove_head(&scheduler->coroutines_remote);
+
+        // resume this coroutine
+        tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_single_list_entry(&scheduler->coroutines_remote, entry);
+        tb_co_scheduler_resume(scheduler, coroutine, coroutine->remote_priv);
+        count++;
+    }
+    tb_spinlock_leave(&scheduler->lock);
+
+    // ok
+    return count;
+}
 tb_pointer_t tb_co_scheduler_suspend(tb_co_scheduler_t* scheduler, tb_cpointer_t priv)
 {
     // check
@@ -306,6 +384,10 @@ tb_void_t tb_co_scheduler_finish(tb_co_scheduler_t* scheduler)
     tb_coroutine_check(scheduler->running);
 #endif
 
+    // finish it in the scheduler group, but the io loop coroutine is not counted
+    if (scheduler->group && (!scheduler->scheduler_io || scheduler->running != tb_co_scheduler_io(scheduler)->loop))
+        tb_co_scheduler_group_finish(scheduler->group);
+
     // get the next ready coroutine first
     tb_coroutine_t* coroutine_next = tb_co_scheduler_next_ready(scheduler);
 
@@ -384,4 +466,18 @@ tb_long_t tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t soc
     // sleep it
     return tb_co_scheduler_io_wait(scheduler->scheduler_io, sock, events, timeout);
 }
+tb_bool_t tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_poller_op_ref_t op)
+{
+    // check
+    tb_assert(scheduler && scheduler->running);
+    tb_assert(scheduler->running == (tb_coroutine_t*)tb_coroutine_self());
 
+    // have been stopped? 
+    tb_check_return_val(!scheduler->stopped, tb_false);
+
+    // need io scheduler
+    if (!tb_co_scheduler_io_need(scheduler)) return tb_false;
+
+    // post it
+    return tb_co_scheduler_io_post(scheduler->scheduler_io, op);
+}
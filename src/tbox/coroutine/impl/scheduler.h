@@ -60,6 +60,9 @@ __tb_extern_c_enter__
 // the io scheduler type
 struct __tb_co_scheduler_io_t;
 
+// the scheduler group type
+struct __tb_co_scheduler_group_t;
+
 // the scheduler type
 typedef struct __tb_co_scheduler_t
 {   
@@ -78,6 +81,9 @@ typedef struct __tb_co_scheduler_t
     // the io scheduler
     struct __tb_co_scheduler_io_t*  scheduler_io;
 
+    // the poller type of the io scheduler
+    tb_size_t                       poller_type;
+
     // the dead coroutines
     tb_list_entry_head_t            coroutines_dead;
 
@@ -92,6 +98,21 @@ typedef struct __tb_co_scheduler_t
     // the suspend coroutines
     tb_list_entry_head_t            coroutines_suspend;
 
+    // the scheduler group, be null if this scheduler is not in any group
+    struct __tb_co_scheduler_group_t* group;
+
+    // is idle? it is waiting io events in the scheduler group
+    tb_atomic_t                     idle;
+
+    // the lock for the fresh and remote coroutines, they may be accessed by other threads
+    tb_spinlock_t                   lock;
+
+    // the fresh coroutines which have not been started, they can be stolen by other schedulers in the group
+    tb_list_entry_head_t            coroutines_fresh;
+
+    // the remote coroutines which are resumed from other threads
+    tb_single_list_entry_head_t     coroutines_remote;
+
 }tb_co_scheduler_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +130,13 @@ typedef struct __tb_co_scheduler_t
  */
 tb_bool_t                   tb_co_scheduler_start(tb_co_scheduler_t* scheduler, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
 
+/* make the given fresh coroutine as ready
+ *
+ * @param scheduler         the scheduler
+ * @param coroutine         the fresh coroutine
+ */
+tb_void_t                   tb_co_scheduler_ready(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
 /* yield the current coroutine
  *
  * @param scheduler         the scheduler
@@ -127,6 +155,26 @@ tb_bool_t                   tb_co_scheduler_yield(tb_co_scheduler_t* scheduler);
  */
 tb_pointer_t                tb_co_scheduler_resume(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv);
 
+/* resume the given suspended coroutine from other threads
+ *
+ * the coroutine will be resumed in the io loop of its scheduler later
+ *
+ * @param scheduler         the scheduler of the given coroutine
+ * @param coroutine         the suspended coroutine
+ * @param priv              the user private data as the return value of suspend() or sleep()
+ *
+ * @return                  always be null, the coroutine may have not been suspended now
+ */
+tb_pointer_t                tb_co_scheduler_resume_remote(tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine, tb_cpointer_t priv);
+
+/* resume all remote coroutines which were resumed from other threads
+ *
+ * @param scheduler         the scheduler
+ *
+ * @return                  the resumed coroutines count
+ */
+tb_size_t                   tb_co_scheduler_resume_remotes(tb_co_scheduler_t* scheduler);
+
 /* suspend the current coroutine
  *
  * @param scheduler         the scheduler
@@ -169,6 +217,15 @@ tb_void_t                   tb_co_scheduler_switch(tb_co_scheduler_t* scheduler,
  */
 tb_long_t                   tb_co_scheduler_wait(tb_co_scheduler_t* scheduler, tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout);
 
+/* post an io operation and wait it until it has been completed
+ *
+ * @param scheduler         the scheduler
+ * @param op                the operation
+ *
+ * @return                  tb_true or tb_false (the poller does not support it)
+ */
+tb_bool_t                   tb_co_scheduler_post(tb_co_scheduler_t* scheduler, tb_poller_op_ref_t op);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,195 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     coroutine
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "scheduler_io.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_co_scheduler_group_wake(tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(scheduler && scheduler->scheduler_io);
+
+    // wake up the io loop of this scheduler
+    tb_poller_spak(tb_co_scheduler_io(scheduler)->poller);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_co_scheduler_group_push(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine)
+{
+    // check
+    tb_assert(group && group->schedulers && scheduler && coroutine);
+
+    // trace
+    tb_trace_d("push coroutine(%p) to scheduler(%p)", coroutine, scheduler);
+
+    // this coroutine is alive now
+    tb_atomic_fetch_and_inc(&group->alive);
+
+    // append it to the fresh coroutines
+    tb_spinlock_enter(&scheduler->lock);
+    tb_list_entry_insert_tail(&scheduler->coroutines_fresh, (tb_list_entry_ref_t)coroutine);
+    tb_spinlock_leave(&scheduler->lock);
+
+    /* wake up one idle scheduler to run or steal it
+     *
+     * we try the owner scheduler first, it may be idle if this coroutine is started from the outside
+     */
+    tb_size_t i = 0;
+    tb_size_t n = group->count;
+    tb_size_t index = 0;
+    for (index = 0; index < n && group->schedulers[index] != scheduler; index++) ;
+    for (i = 0; i < n; i++)
+    {
+        tb_co_scheduler_t* idle = group->schedulers[(index + i) % n];
+        if (tb_atomic_get(&idle->idle) && tb_atomic_fetch_and_pset(&idle->idle, 1, 0))
+        {
+            tb_co_scheduler_group_wake(idle);
+            break;
+        }
+    }
+}
+tb_size_t tb_co_scheduler_group_pull(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group && scheduler);
+
+    // no fresh coroutines?
+    tb_check_return_val(tb_list_entry_size(&scheduler->coroutines_fresh), 0);
+
+    // make all fresh coroutines as ready
+    tb_size_t count = 0;
+    tb_spinlock_enter(&scheduler->lock);
+    while (tb_list_entry_size(&scheduler->coroutines_fresh))
+    {
+        // get the next entry from head
+        tb_list_entry_ref_t entry = tb_list_entry_head(&scheduler->coroutines_fresh);
+        tb_assert_and_check_break(entry);
+
+        // remove it from the fresh coroutines
+        tb_list_entry_remove_head(&scheduler->coroutines_fresh);
+
+        // make it as ready
+        tb_co_scheduler_ready(scheduler, (tb_coroutine_t*)tb_list_entry0(entry));
+        count++;
+    }
+    tb_spinlock_leave(&scheduler->lock);
+
+    // trace
+    tb_trace_d("scheduler(%p): pull %lu coroutines", scheduler, count);
+
+    // ok
+    return count;
+}
+tb_size_t tb_co_scheduler_group_steal(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler)
+{
+    // check
+    tb_assert(group && group->schedulers && scheduler);
+
+    // only one scheduler? 
+    tb_size_t n = group->count;
+    tb_check_return_val(n > 1, 0);
+
+    // get the index of the current scheduler
+    tb_size_t index = 0;
+    for (index = 0; index < n && group->schedulers[index] != scheduler; index++) ;
+
+    // steal the older half of the fresh coroutines from the first busy scheduler
+    tb_size_t i = 0;
+    tb_size_t count = 0;
+    for (i = 1; i < n && !count; i++)
+    {
+        // the victim scheduler
+        tb_co_scheduler_t* victim = group->schedulers[(index + i) % n];
+
+        // no fresh coroutines? 
+        tb_check_continue(tb_list_entry_size(&victim->coroutines_fresh));
+
+        // steal them
+        tb_spinlock_enter(&victim->lock);
+        tb_size_t steal = (tb_list_entry_size(&victim->coroutines_fresh) + 1) >> 1;
+        while (steal-- && tb_list_entry_size(&victim->coroutines_fresh))
+        {
+            // get the next entry from head
+            tb_list_entry_ref_t entry = tb_list_entry_head(&victim->coroutines_fresh);
+            tb_assert_and_check_break(entry);
+
+            // remove it from the fresh coroutines of the victim
+            tb_list_entry_remove_head(&victim->coroutines_fresh);
+
+            /* move it to the current scheduler
+             *
+             * @note it is safe because the fresh coroutine has not been run and it have not any io and timer state
+             */
+            tb_coroutine_t* coroutine = (tb_coroutine_t*)tb_list_entry0(entry);
+            coroutine->scheduler = (tb_co_scheduler_ref_t)scheduler;
+
+            // make it as ready
+            tb_co_scheduler_ready(scheduler, coroutine);
+            count++;
+        }
+        tb_spinlock_leave(&victim->lock);
+    }
+
+    // trace
+    tb_trace_d("scheduler(%p): steal %lu coroutines", scheduler, count);
+
+    // ok
+    return count;
+}
+tb_void_t tb_co_scheduler_group_finish(tb_co_scheduler_group_t* group)
+{
+    // check
+    tb_assert(group && group->schedulers);
+
+    // all coroutines have been finished? notify all schedulers to exit the loop
+    if (!tb_atomic_dec_and_fetch(&group->alive))
+    {
+        // trace
+        tb_trace_d("finished");
+
+        // mark as finished
+        tb_atomic_set(&group->finished, 1);
+
+        // wake up all schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+            tb_co_scheduler_group_wake(group->schedulers[i]);
+    }
+}
@@ -0,0 +1,104 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+#define TB_COROUTINE_IMPL_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the scheduler group type
+typedef struct __tb_co_scheduler_group_t
+{
+    // the schedulers, one scheduler per thread
+    tb_co_scheduler_t**     schedulers;
+
+    // the scheduler count
+    tb_size_t               count;
+
+    // the alive coroutines count (started and not finished)
+    tb_atomic_t             alive;
+
+    // the next scheduler index for starting coroutines from the outside
+    tb_atomic_t             next;
+
+    // is finished? all coroutines have been finished
+    tb_atomic_t             finished;
+
+}tb_co_scheduler_group_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* push the fresh coroutine to the given scheduler of the group
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the scheduler
+ * @param coroutine         the fresh coroutine which has not been started
+ */
+tb_void_t                   tb_co_scheduler_group_push(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler, tb_coroutine_t* coroutine);
+
+/* make all fresh coroutines of the given scheduler as ready
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current scheduler
+ *
+ * @return                  the ready coroutines count
+ */
+tb_size_t                   tb_co_scheduler_group_pull(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler);
+
+/* steal some fresh coroutines from other schedulers and make them as ready
+ *
+ * @param group             the scheduler group
+ * @param scheduler         the current scheduler
+ *
+ * @return                  the stolen coroutines count
+ */
+tb_size_t                   tb_co_scheduler_group_steal(tb_co_scheduler_group_t* group, tb_co_scheduler_t* scheduler);
+
+/* finish one coroutine of the scheduler group
+ *
+ * @param group             the scheduler group
+ */
+tb_void_t                   tb_co_scheduler_group_finish(tb_co_scheduler_group_t* group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
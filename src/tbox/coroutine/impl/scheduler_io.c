@@ -34,6 +34,7 @@
  * includes
  */
 #include "scheduler_io.h"
+#include "scheduler_group.h"
 #include "coroutine.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -47,9 +48,6 @@
 #   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
 #endif
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -63,15 +61,8 @@ static tb_void_t tb_co_scheduler_io_resume(tb_co_scheduler_t* scheduler, tb_coro
         tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io(scheduler);
         tb_assert(scheduler_io && scheduler_io->poller);
 
-        // is high-precision timer?
-        tb_size_t is_timer = (tb_size_t)(task) & 0x1;
-
-        // check
-        tb_assert((tb_size_t)task & (tb_size_t)~0x1);
-
         // remove the timer task
-        if (__tb_unlikely__(is_timer)) tb_timer_task_exit(scheduler_io->timer, (tb_timer_task_ref_t)((tb_size_t)task & (tb_size_t)~0x1));
-        else tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
+        tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
         coroutine->rs.wait.task = tb_null;
     }
 
@@ -99,6 +90,22 @@ static tb_void_t tb_co_scheduler_io_timeout(tb_bool_t killed, tb_cpointer_t priv
 }
 static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
+    // the posted operation has been completed? resume the coroutine which is waiting for it
+    if (events & TB_POLLER_EVENT_POST)
+    {
+        // check
+        tb_poller_op_ref_t op = (tb_poller_op_ref_t)priv;
+        tb_assert(op && op->priv);
+
+        // trace
+        tb_trace_d("coroutine(%p): socket: %p, operation %lu: %ld", op->priv, sock, op->code, op->result);
+
+        // resume it
+        tb_coroutine_t* coroutine = (tb_coroutine_t*)op->priv;
+        tb_co_scheduler_io_resume((tb_co_scheduler_t*)tb_coroutine_scheduler(coroutine), coroutine, op);
+        return ;
+    }
+
     // check
     tb_coroutine_t* coroutine = (tb_coroutine_t*)priv;
     tb_assert(coroutine && poller && sock);
@@ -130,14 +137,11 @@ static tb_void_t tb_co_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
 static tb_bool_t tb_co_scheduler_io_timer_spak(tb_co_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->ltimer);
 
     // spak ctime
     tb_cache_time_spak();
 
-    // spak timer
-    if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
-
     // spak ltimer
     if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
 
@@ -148,7 +152,7 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
 {
     // check
     tb_co_scheduler_io_ref_t scheduler_io = (tb_co_scheduler_io_ref_t)priv;
-    tb_assert_and_check_return(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert_and_check_return(scheduler_io && scheduler_io->ltimer);
 
     // the scheduler
     tb_co_scheduler_t* scheduler = scheduler_io->scheduler;
@@ -158,6 +162,12 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
     tb_poller_ref_t poller = scheduler_io->poller;
     tb_assert_and_check_return(poller);
 
+    // the scheduler group
+    tb_co_scheduler_group_t* group = scheduler->group;
+
+    // save the io loop coroutine
+    scheduler_io->loop = tb_co_scheduler_running(scheduler);
+
     // loop
     while (!scheduler->stopped)
     {
@@ -166,22 +176,56 @@ static tb_void_t tb_co_scheduler_io_loop(tb_cpointer_t priv)
         {
             // spak timer
             if (!tb_co_scheduler_io_timer_spak(scheduler_io)) break;
+
+            // resume the remote coroutines from other threads
+            tb_co_scheduler_resume_remotes(scheduler);
+
+            // make the fresh coroutines as ready in the scheduler group
+            if (group) tb_co_scheduler_group_pull(group, scheduler);
         }
 
+        // resume the remote coroutines and continue to run them 
+        if (tb_co_scheduler_resume_remotes(scheduler)) continue;
+
+        // in the scheduler group?
+        if (group)
+        {
+            // pull or steal fresh coroutines and continue to run them
+            if (tb_co_scheduler_group_pull(group, scheduler) || tb_co_scheduler_group_steal(group, scheduler)) continue;
+
+            // all coroutines in the group have been finished? loop end
+            tb_check_break(!tb_atomic_get(&group->finished));
+
+            /* mark this scheduler as idle and check it again
+             *
+             * the other threads will wake up it if new coroutines are pushed or resumed
+             */
+            tb_atomic_set(&scheduler->idle, 1);
+            if (    tb_single_list_entry_size(&scheduler->coroutines_remote)
+                ||  tb_co_scheduler_group_pull(group, scheduler) 
+                ||  tb_co_scheduler_group_steal(group, scheduler))
+            {
+                tb_atomic_set(&scheduler->idle, 0);
+                continue;
+            }
+        }
         // no more suspended coroutines? loop end
-        tb_check_break(tb_co_scheduler_suspend_count(scheduler));
+        else tb_check_break(tb_co_scheduler_suspend_count(scheduler));
 
         // the delay
-        tb_size_t delay = tb_timer_delay(scheduler_io->timer);
-
-        // the ldelay
-        tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
+        tb_size_t delay = tb_ltimer_delay(scheduler_io->ltimer);
 
         // trace
-        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", tb_min(delay, ldelay), tb_co_scheduler_suspend_count(scheduler));
+        tb_trace_d("loop: wait %lu ms, %lu pending coroutines ..", delay, tb_co_scheduler_suspend_count(scheduler));
 
         // no more ready coroutines? wait io events and timers
-        if (tb_poller_wait(poller, tb_co_scheduler_io_events, tb_min(delay, ldelay)) < 0) break;
+        tb_long_t wait = tb_poller_wait(poller, tb_co_scheduler_io_events, delay);
+
+        // not idle now
+        if (group) tb_atomic_set(&scheduler->idle, 0);
+
+        // failed?
+        if (wait < 0) break;
 
         // trace
         tb_trace_d("loop: wait ok, left %lu pending coroutines ..", tb_co_scheduler_suspend_count(scheduler));
@@ -208,16 +252,12 @@ tb_co_scheduler_io_ref_t tb_co_scheduler_io_init(tb_co_scheduler_t* scheduler)
         // save scheduler
         scheduler_io->scheduler = (tb_co_scheduler_t*)scheduler;
 
-        // init timer and using cache time
-        scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
-        tb_assert_and_check_break(scheduler_io->timer);
-
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
+        // init ltimer with the millisecond tick and using cache time
+        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_MS, tb_true);
         tb_assert_and_check_break(scheduler_io->ltimer);
 
         // init poller
-        scheduler_io->poller = tb_poller_init(tb_null);
+        scheduler_io->poller = tb_poller_init_with_type(tb_null, scheduler->poller_type);
         tb_assert_and_check_break(scheduler_io->poller);
 
         // start the io loop coroutine
@@ -248,10 +288,6 @@ tb_void_t tb_co_scheduler_io_exit(tb_co_scheduler_io_ref_t scheduler_io)
     if (scheduler_io->poller) tb_poller_exit(scheduler_io->poller);
     scheduler_io->poller = tb_null;
 
-    // exit timer
-    if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
-    scheduler_io->timer = tb_null;
-
     // exit ltimer
     if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
     scheduler_io->ltimer = tb_null;
@@ -285,9 +321,6 @@ tb_void_t tb_co_scheduler_io_kill(tb_co_scheduler_io_ref_t scheduler_io)
     // trace
     tb_trace_d("kill: ..");
 
-    // kill timer
-    if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
-
     // kill ltimer
     if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
 
@@ -315,18 +348,8 @@ tb_pointer_t tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t scheduler_io, tb_
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
-        }
+        // post task to ltimer
+        tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_co_scheduler_io_timeout, coroutine);
     }
 
     // suspend it
@@ -413,33 +436,15 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
 
     // exists timeout?
     tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for ltimer
+        task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
-    // check
-    tb_assert(!((tb_size_t)(task) & 0x1));
-
     // save the timer task to coroutine
-    coroutine->rs.wait.task = (is_ltimer || !task)? task : (tb_cpointer_t)((tb_size_t)(task) | 0x1);
+    coroutine->rs.wait.task = task;
 
     // save the socket to coroutine for the timer function
     coroutine->rs.wait.sock = sock;
@@ -454,6 +459,63 @@ tb_long_t tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_sock
     // suspend the current coroutine and return the waited result
     return (tb_long_t)tb_co_scheduler_suspend(scheduler_io->scheduler, tb_null);
 }
+tb_bool_t tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_op_ref_t op)
+{
+    // check
+    tb_assert(scheduler_io && op && op->sock && scheduler_io->poller && scheduler_io->scheduler);
+
+    // get the poller
+    tb_poller_ref_t poller = scheduler_io->poller;
+    tb_assert(poller);
+
+    // the posted operation is not supported for this poller?
+    tb_check_return_val(tb_poller_support(poller, TB_POLLER_EVENT_POST), tb_false);
+
+    // get the current coroutine
+    tb_coroutine_t* coroutine = tb_co_scheduler_running(scheduler_io->scheduler);
+    tb_assert(coroutine);
+
+    // trace
+    tb_trace_d("coroutine(%p): post operation(%lu) for socket(%p) ..", coroutine, op->code, op->sock);
+
+    // remove the previous waited socket first, we need not its events now
+    tb_socket_ref_t sock_prev = coroutine->rs.wait.sock;
+    if (sock_prev)
+    {
+        // remove it
+        if (!tb_poller_remove(poller, sock_prev))
+        {
+            // trace
+            tb_trace_e("failed to remove sock(%p) to poller on coroutine(%p)!", sock_prev, coroutine);
+
+            // failed
+            return tb_false;
+        }
+
+        // clear it
+        coroutine->rs.wait.sock         = tb_null;
+        coroutine->rs.wait.events       = 0;
+        coroutine->rs.wait.events_cache = 0;
+    }
+
+    // post this operation to poller
+    op->priv = coroutine;
+    if (!tb_poller_post(poller, op))
+    {
+        // trace
+        tb_trace_e("failed to post operation(%lu) to poller on coroutine(%p)!", op->code, coroutine);
+
+        // failed
+        return tb_false;
+    }
+
+    // no timer task, the operation will be always completed or canceled by poller
+    coroutine->rs.wait.task = tb_null;
+
+    // suspend the current coroutine until this operation has been completed
+    tb_co_scheduler_suspend(scheduler_io->scheduler, tb_null);
+    return tb_true;
+}
 tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_socket_ref_t sock)
 {
     // check
@@ -466,6 +528,28 @@ tb_bool_t tb_co_scheduler_io_cancel(tb_co_scheduler_io_ref_t scheduler_io, tb_so
     // trace
     tb_trace_d("coroutine(%p): cancel socket(%p) ..", coroutine, sock);
 
+    /* cancel the posted operations of this socket from all coroutines before closing it,
+     * the waiting coroutines will be resumed with the canceled operations
+     */
+    if (tb_poller_support(scheduler_io->poller, TB_POLLER_EVENT_POST))
+    {
+        // remove it
+        if (!tb_poller_remove(scheduler_io->poller, sock))
+        {
+            // trace
+            tb_trace_e("failed to cancel the posted operations of sock(%p) on coroutine(%p)!", sock, coroutine);
+
+            // failed
+            return tb_false;
+        }
+
+        // clear waited socket
+        if (coroutine->rs.wait.sock == sock) coroutine->rs.wait.sock = tb_null;
+
+        // remove ok
+        return tb_true;
+    }
+
     // remove the this socket from poller
     if (coroutine->rs.wait.sock == sock)
     {
@@ -52,12 +52,12 @@ typedef struct __tb_co_scheduler_io_t
     // the poller
     tb_poller_ref_t     poller;
 
-    // the timer
-    tb_timer_ref_t      timer;
-
-    // the low-precision timer (faster)
+    // the timer for all timeouts, the hierarchical timing wheel with the millisecond tick
     tb_ltimer_ref_t     ltimer;
 
+    // the io loop coroutine
+    tb_coroutine_t*     loop;
+
 }tb_co_scheduler_io_t, *tb_co_scheduler_io_ref_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -114,6 +114,15 @@ tb_pointer_t                tb_co_scheduler_io_sleep(tb_co_scheduler_io_ref_t sc
  */
 tb_long_t                   tb_co_scheduler_io_wait(tb_co_scheduler_io_ref_t scheduler_io, tb_socket_ref_t sock, tb_size_t events, tb_long_t timeout);
 
+/*! post an io operation and wait it until it has been completed
+ *
+ * @param scheduler_io      the io scheduler
+ * @param op                the operation, the result will be saved to op->result
+ *
+ * @return                  tb_true or tb_false (the poller does not support it)
+ */
+tb_bool_t                   tb_co_scheduler_io_post(tb_co_scheduler_io_ref_t scheduler_io, tb_poller_op_ref_t op);
+
 /*! cancel io events for the given socket 
  *
  * @param scheduler_io      the io scheduler
@@ -43,11 +43,7 @@ __tb_extern_c_enter__
 typedef struct __tb_lo_coroutine_rs_wait_t
 {
 #ifndef TB_CONFIG_MICRO_ENABLE
-    /* the timer task pointer for ltimer or timer
-     *
-     * for ltimer:  task
-     * for timer:   task & 0x1
-     */
+    // the timer task pointer of ltimer
     tb_cpointer_t               task;
 #endif
 
@@ -48,14 +48,26 @@
 #   define TB_SCHEDULER_IO_LTIMER_GROW      (4096)
 #endif
 
-// the timer grow
-#define TB_SCHEDULER_IO_TIMER_GROW          (TB_SCHEDULER_IO_LTIMER_GROW >> 4)
-
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
 static tb_void_t tb_lo_scheduler_io_resume(tb_lo_scheduler_t* scheduler, tb_lo_coroutine_t* coroutine, tb_size_t events)
 {
+#ifndef TB_CONFIG_MICRO_ENABLE
+    // exists the timer task? remove it
+    tb_cpointer_t task = coroutine->rs.wait.task;
+    if (task) 
+    {
+        // get io scheduler
+        tb_lo_scheduler_io_ref_t scheduler_io = tb_lo_scheduler_io(scheduler);
+        tb_assert(scheduler_io && scheduler_io->ltimer);
+
+        // remove the timer task
+        tb_ltimer_task_exit(scheduler_io->ltimer, (tb_ltimer_task_ref_t)task);
+        coroutine->rs.wait.task = tb_null;
+    }
+#endif
+
     // clear waiting state
     coroutine->rs.wait.waiting = 0;
 
@@ -117,14 +129,11 @@ static tb_void_t tb_lo_scheduler_io_events(tb_poller_ref_t poller, tb_socket_ref
 static tb_bool_t tb_lo_scheduler_io_timer_spak(tb_lo_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->ltimer);
 
     // spak ctime
     tb_cache_time_spak();
 
-    // spak timer
-    if (!tb_timer_spak(scheduler_io->timer)) return tb_false;
-
     // spak ltimer
     if (!tb_ltimer_spak(scheduler_io->ltimer)) return tb_false;
 
@@ -134,16 +143,10 @@ static tb_bool_t tb_lo_scheduler_io_timer_spak(tb_lo_scheduler_io_ref_t schedule
 static tb_long_t tb_lo_scheduler_io_timer_delay(tb_lo_scheduler_io_ref_t scheduler_io)
 {
     // check
-    tb_assert(scheduler_io && scheduler_io->timer && scheduler_io->ltimer);
-
-    // the delay
-    tb_size_t delay = tb_timer_delay(scheduler_io->timer);
-
-    // the ldelay
-    tb_size_t ldelay = tb_ltimer_delay(scheduler_io->ltimer);
+    tb_assert(scheduler_io && scheduler_io->ltimer);
 
     // return the timer delay
-    return tb_min(delay, ldelay);
+    return (tb_long_t)tb_ltimer_delay(scheduler_io->ltimer);
 }
 #else
 static __tb_inline__ tb_long_t tb_lo_scheduler_io_timer_delay(tb_lo_scheduler_io_ref_t scheduler_io)
@@ -218,12 +221,8 @@ tb_lo_scheduler_io_ref_t tb_lo_scheduler_io_init(tb_lo_scheduler_t* scheduler)
         tb_assert_and_check_break(scheduler_io->poller);
 
 #ifndef TB_CONFIG_MICRO_ENABLE
-        // init timer and using cache time
-        scheduler_io->timer = tb_timer_init(TB_SCHEDULER_IO_TIMER_GROW, tb_true);
-        tb_assert_and_check_break(scheduler_io->timer);
-
-        // init ltimer and using cache time
-        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_S, tb_true);
+        // init ltimer with the millisecond tick and using cache time
+        scheduler_io->ltimer = tb_ltimer_init(TB_SCHEDULER_IO_LTIMER_GROW, TB_LTIMER_TICK_MS, tb_true);
         tb_assert_and_check_break(scheduler_io->ltimer);
 #endif
 
@@ -256,10 +255,6 @@ tb_void_t tb_lo_scheduler_io_exit(tb_lo_scheduler_io_ref_t scheduler_io)
     scheduler_io->poller = tb_null;
 
 #ifndef TB_CONFIG_MICRO_ENABLE
-    // exit timer
-    if (scheduler_io->timer) tb_timer_exit(scheduler_io->timer);
-    scheduler_io->timer = tb_null;
-
     // exit ltimer
     if (scheduler_io->ltimer) tb_ltimer_exit(scheduler_io->ltimer);
     scheduler_io->ltimer = tb_null;
@@ -295,9 +290,6 @@ tb_void_t tb_lo_scheduler_io_kill(tb_lo_scheduler_io_ref_t scheduler_io)
     tb_trace_d("kill: ..");
 
 #ifndef TB_CONFIG_MICRO_ENABLE
-    // kill timer
-    if (scheduler_io->timer) tb_timer_kill(scheduler_io->timer);
-
     // kill ltimer
     if (scheduler_io->ltimer) tb_ltimer_kill(scheduler_io->ltimer);
 #endif
@@ -318,21 +310,14 @@ tb_void_t tb_lo_scheduler_io_sleep(tb_lo_scheduler_io_ref_t scheduler_io, tb_lon
     // trace
     tb_trace_d("coroutine(%p): sleep %ld ms ..", coroutine, interval);
 
+    // clear waiting task first
+    coroutine->rs.wait.task = tb_null;
+
     // infinity?
     if (interval > 0)
     {
-        // high-precision interval?
-        if (interval % 1000)
-        {
-            // post task to timer
-            tb_timer_task_post(scheduler_io->timer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-        }
-        // low-precision interval?
-        else
-        {
-            // post task to ltimer (faster)
-            tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-        }
+        // post task to ltimer
+        tb_ltimer_task_post(scheduler_io->ltimer, interval, tb_false, tb_lo_scheduler_io_timeout, coroutine);
     }
 #else
     // not impl
@@ -422,33 +407,15 @@ tb_bool_t tb_lo_scheduler_io_wait(tb_lo_scheduler_io_ref_t scheduler_io, tb_sock
 #ifndef TB_CONFIG_MICRO_ENABLE
     // exists timeout?
     tb_cpointer_t   task = tb_null;
-    tb_bool_t       is_ltimer = tb_false;
     if (timeout >= 0)
     {
-        // high-precision interval?
-        if (timeout % 1000)
-        {
-            // init task for timer
-            task = tb_timer_task_init(scheduler_io->timer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-        }
-        // low-precision interval?
-        else
-        {
-            // init task for ltimer (faster)
-            task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
-            tb_assert_and_check_return_val(task, tb_false);
-
-            // mark as low-precision timer
-            is_ltimer = tb_true;
-        }
+        // init task for ltimer
+        task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_lo_scheduler_io_timeout, coroutine);
+        tb_assert_and_check_return_val(task, tb_false);
     }
 
-    // check
-    tb_assert(!((tb_size_t)(task) & 0x1));
-
     // save the timer task to coroutine
-    coroutine->rs.wait.task = (is_ltimer || !task)? task : (tb_cpointer_t)((tb_size_t)(task) | 0x1);
+    coroutine->rs.wait.task = task;
 #endif
 
     // save the socket to coroutine for the timer function
@@ -53,10 +53,7 @@ typedef struct __tb_lo_scheduler_io_t
     tb_poller_ref_t     poller;
 
 #ifndef TB_CONFIG_MICRO_ENABLE
-    // the timer
-    tb_timer_ref_t      timer;
-
-    // the low-precision timer (faster)
+    // the timer for all timeouts, the hierarchical timing wheel with the millisecond tick
     tb_ltimer_ref_t     ltimer;
 #endif
 
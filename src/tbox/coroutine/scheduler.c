@@ -80,6 +80,10 @@ static tb_void_t tb_co_scheduler_free(tb_list_entry_head_ref_t coroutines)
  * implementation
  */
 tb_co_scheduler_ref_t tb_co_scheduler_init()
+{
+    return tb_co_scheduler_init_with_poller(TB_POLLER_TYPE_NONE);
+}
+tb_co_scheduler_ref_t tb_co_scheduler_init_with_poller(tb_size_t poller_type)
 {
     // done
     tb_bool_t           ok = tb_false;
@@ -99,12 +103,24 @@ tb_co_scheduler_ref_t tb_co_scheduler_init()
         // init suspend coroutines
         tb_list_entry_init(&scheduler->coroutines_suspend, tb_coroutine_t, entry, tb_null);
 
+        // init fresh coroutines
+        tb_list_entry_init(&scheduler->coroutines_fresh, tb_coroutine_t, entry, tb_null);
+
+        // init remote coroutines
+        tb_single_list_entry_init(&scheduler->coroutines_remote, tb_coroutine_t, remote_entry, tb_null);
+
+        // init lock
+        if (!tb_spinlock_init(&scheduler->lock)) break;
+
         // init original coroutine
         scheduler->original.scheduler = (tb_co_scheduler_ref_t)scheduler;
 
         // init running
         scheduler->running = &scheduler->original;
 
+        // init poller type
+        scheduler->poller_type = poller_type;
+
         // ok
         ok = tb_true;
 
@@ -150,6 +166,9 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // free all suspend coroutines 
     tb_co_scheduler_free(&scheduler->coroutines_suspend);
 
+    // free all fresh coroutines 
+    tb_co_scheduler_free(&scheduler->coroutines_fresh);
+
     // exit dead coroutines
     tb_list_entry_exit(&scheduler->coroutines_dead);
 
@@ -159,6 +178,15 @@ tb_void_t tb_co_scheduler_exit(tb_co_scheduler_ref_t self)
     // exit suspend coroutines
     tb_list_entry_exit(&scheduler->coroutines_suspend);
 
+    // exit fresh coroutines
+    tb_list_entry_exit(&scheduler->coroutines_fresh);
+
+    // exit remote coroutines
+    tb_single_list_entry_exit(&scheduler->coroutines_remote);
+
+    // exit lock
+    tb_spinlock_exit(&scheduler->lock);
+
     // exit the scheduler
     tb_free(scheduler);
 }
@@ -53,6 +53,17 @@ typedef __tb_typeref__(co_scheduler);
  */
 tb_co_scheduler_ref_t   tb_co_scheduler_init(tb_noarg_t);
 
+/*! init scheduler with the given poller type
+ *
+ * the io operations (e.g. tb_socket_brecv, tb_socket_bsend) will be posted to the poller directly 
+ * if the given poller is completion-based (e.g. TB_POLLER_TYPE_IOURING)
+ *
+ * @param poller_type   the poller type, uses the default poller if be TB_POLLER_TYPE_NONE or not supported
+ *
+ * @return              the scheduler 
+ */
+tb_co_scheduler_ref_t   tb_co_scheduler_init_with_poller(tb_size_t poller_type);
+
 /*! exit scheduler
  *
  * @param scheduler     the scheduler
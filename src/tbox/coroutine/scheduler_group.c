@@ -0,0 +1,234 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.c
+ * @ingroup     scheduler
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "scheduler_group"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "scheduler_group.h"
+#include "impl/impl.h"
+#include "impl/scheduler_group.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_int_t tb_co_scheduler_group_worker(tb_cpointer_t priv)
+{
+    // check
+    tb_co_scheduler_ref_t scheduler = (tb_co_scheduler_ref_t)priv;
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // run scheduler loop on this thread
+    tb_co_scheduler_loop(scheduler, tb_false);
+
+    // ok
+    return 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_co_scheduler_group_t*    group = tb_null;
+    do
+    {
+        // uses the processor count if be zero
+        if (!count) count = tb_processor_count();
+        if (!count) count = 1;
+
+        // make group
+        group = tb_malloc0_type(tb_co_scheduler_group_t);
+        tb_assert_and_check_break(group);
+
+        // make schedulers
+        group->schedulers = tb_nalloc0_type(count, tb_co_scheduler_t*);
+        tb_assert_and_check_break(group->schedulers);
+
+        // init schedulers
+        tb_size_t i = 0;
+        for (i = 0; i < count; i++)
+        {
+            // init scheduler
+            tb_co_scheduler_t* scheduler = (tb_co_scheduler_t*)tb_co_scheduler_init();
+            tb_assert_and_check_break(scheduler);
+
+            // save it
+            group->schedulers[i] = scheduler;
+            group->count++;
+
+            /* init io scheduler and start the io loop coroutine first
+             *
+             * @note the io loop coroutine is not counted and stolen, because the group has not been bound now
+             */
+            if (!tb_co_scheduler_io_need(scheduler)) break;
+
+            // bind this scheduler to the group
+            scheduler->group = group;
+        }
+        tb_assert_and_check_break(i == count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (group) tb_co_scheduler_group_exit((tb_co_scheduler_group_ref_t)group);
+        group = tb_null;
+    }
+
+    // ok?
+    return (tb_co_scheduler_group_ref_t)group;
+}
+tb_void_t tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group);
+
+    // exit schedulers
+    if (group->schedulers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < group->count; i++)
+        {
+            // exit scheduler
+            tb_co_scheduler_t* scheduler = group->schedulers[i];
+            if (scheduler) tb_co_scheduler_exit((tb_co_scheduler_ref_t)scheduler);
+        }
+        tb_free(group->schedulers);
+    }
+    group->schedulers = tb_null;
+    group->count = 0;
+
+    // exit the group
+    tb_free(group);
+}
+tb_void_t tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->schedulers);
+
+    // kill all schedulers
+    tb_size_t i = 0;
+    for (i = 0; i < group->count; i++)
+        tb_co_scheduler_kill((tb_co_scheduler_ref_t)group->schedulers[i]);
+}
+tb_bool_t tb_co_scheduler_group_start(tb_co_scheduler_group_ref_t self, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group && group->schedulers && group->count && func, tb_false);
+
+    // have been finished? do not continue to start new coroutines
+    tb_check_return_val(!tb_atomic_get(&group->finished), tb_false);
+
+    // get the next scheduler
+    tb_co_scheduler_t* scheduler = group->schedulers[(tb_size_t)tb_atomic_fetch_and_inc(&group->next) % group->count];
+    tb_assert_and_check_return_val(scheduler, tb_false);
+
+    // have been stopped? 
+    tb_check_return_val(!scheduler->stopped, tb_false);
+
+    /* init coroutine
+     *
+     * @note we cannot reuse the dead coroutines here, because the dead cache is not thread-safe
+     */
+    tb_coroutine_t* coroutine = tb_coroutine_init((tb_co_scheduler_ref_t)scheduler, func, priv, stacksize);
+    tb_assert_and_check_return_val(coroutine, tb_false);
+
+    // push it to the fresh coroutines of this scheduler
+    tb_co_scheduler_group_push(group, scheduler, coroutine);
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return(group && group->schedulers && group->count);
+
+    // no coroutines? mark as finished and all io loops will exit directly
+    if (!tb_atomic_get(&group->alive)) tb_atomic_set(&group->finished, 1);
+
+    // make threads for the other schedulers
+    tb_size_t           i = 0;
+    tb_size_t           count = group->count;
+    tb_thread_ref_t*    threads = count > 1? tb_nalloc0_type(count - 1, tb_thread_ref_t) : tb_null;
+    if (threads)
+    {
+        // start threads
+        for (i = 1; i < count; i++)
+        {
+            threads[i - 1] = tb_thread_init(tb_null, tb_co_scheduler_group_worker, group->schedulers[i], 0);
+            if (!threads[i - 1])
+            {
+                // trace
+                tb_trace_e("start thread for scheduler(%lu) failed!", i);
+
+                // kill the group
+                tb_co_scheduler_group_kill(self);
+                break;
+            }
+        }
+    }
+
+    // run the first scheduler on the current thread
+    tb_co_scheduler_loop((tb_co_scheduler_ref_t)group->schedulers[0], tb_false);
+
+    // wait and exit threads
+    if (threads)
+    {
+        for (i = 0; i < count - 1 && threads[i]; i++)
+        {
+            tb_thread_wait(threads[i], -1, tb_null);
+            tb_thread_exit(threads[i]);
+        }
+        tb_free(threads);
+    }
+}
+tb_size_t tb_co_scheduler_group_size(tb_co_scheduler_group_ref_t self)
+{
+    // check
+    tb_co_scheduler_group_t* group = (tb_co_scheduler_group_t*)self;
+    tb_assert_and_check_return_val(group, 0);
+
+    // get the scheduler count
+    return group->count;
+}
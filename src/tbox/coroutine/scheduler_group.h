@@ -0,0 +1,110 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        scheduler_group.h
+ * @ingroup     coroutine
+ *
+ */
+#ifndef TB_COROUTINE_SCHEDULER_GROUP_H
+#define TB_COROUTINE_SCHEDULER_GROUP_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "coroutine.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/*! the coroutine scheduler group ref type
+ *
+ * run coroutines on a fixed set of threads (M:N), each thread has its own scheduler, poller and timers.
+ *
+ * - the new coroutines which have not been started can be stolen by other idle schedulers
+ * - the started coroutines are always run on the same thread, because they may wait io events on its poller
+ * - channel, lock and semaphore can be shared between the coroutines on different threads
+ */
+typedef __tb_typeref__(co_scheduler_group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init scheduler group
+ *
+ * @param count         the scheduler (thread) count, uses the processor count if be zero
+ *
+ * @return              the scheduler group
+ */
+tb_co_scheduler_group_ref_t tb_co_scheduler_group_init(tb_size_t count);
+
+/*! exit scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_exit(tb_co_scheduler_group_ref_t group);
+
+/*! kill the scheduler group
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_kill(tb_co_scheduler_group_ref_t group);
+
+/*! start coroutine in the scheduler group, it can be called from any thread
+ *
+ * @param group         the scheduler group
+ * @param func          the coroutine function
+ * @param priv          the passed user private data as the argument of function
+ * @param stacksize     the stack size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_co_scheduler_group_start(tb_co_scheduler_group_ref_t group, tb_coroutine_func_t func, tb_cpointer_t priv, tb_size_t stacksize);
+
+/*! run the scheduler group loop until all coroutines have been finished or it has been killed
+ *
+ * the first scheduler is run on the current thread and others are run on the new threads
+ *
+ * @param group         the scheduler group
+ */
+tb_void_t               tb_co_scheduler_group_loop(tb_co_scheduler_group_ref_t group);
+
+/*! get the scheduler count of the group
+ *
+ * @param group         the scheduler group
+ *
+ * @return              the scheduler count
+ */
+tb_size_t               tb_co_scheduler_group_size(tb_co_scheduler_group_ref_t group);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
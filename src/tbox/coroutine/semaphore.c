@@ -43,17 +43,82 @@
  * types
  */
 
+// the waiter state
+typedef enum __tb_co_semaphore_waiter_state_e
+{
+    TB_CO_SEMAPHORE_WAITER_STATE_WAITING    = 0
+,   TB_CO_SEMAPHORE_WAITER_STATE_POSTED     = 1
+,   TB_CO_SEMAPHORE_WAITER_STATE_TIMEOUT    = 2
+
+}tb_co_semaphore_waiter_state_e;
+
+/* the semaphore waiter type, it is placed on the stack of the waiting coroutine
+ *
+ * the post and the timer may race on different threads, so the state is only changed
+ * under the semaphore lock and only the first one changing it from waiting will resume the coroutine.
+ */
+typedef struct __tb_co_semaphore_waiter_t
+{
+    // the list entry
+    tb_list_entry_t                 entry;
+
+    // the waiting coroutine
+    tb_coroutine_ref_t              coroutine;
+
+    // the semaphore
+    struct __tb_co_semaphore_t*     semaphore;
+
+    // the state
+    tb_size_t                       state;
+
+}tb_co_semaphore_waiter_t;
+
 // the coroutine semaphore type
 typedef struct __tb_co_semaphore_t
 {
     // the semaphore value
     tb_size_t                       value;
 
-    // the waiting coroutines
-    tb_single_list_entry_head_t     waiting;
+    // the waiters
+    tb_list_entry_head_t            waiting;
+
+    // the lock, the semaphore may be shared by the coroutines on different threads
+    tb_spinlock_t                   lock;
 
 }tb_co_semaphore_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_co_semaphore_timeout(tb_bool_t killed, tb_cpointer_t priv)
+{
+    // check
+    tb_co_semaphore_waiter_t* waiter = (tb_co_semaphore_waiter_t*)priv;
+    tb_assert_and_check_return(waiter && waiter->semaphore);
+
+    // enter lock
+    tb_co_semaphore_t* semaphore = waiter->semaphore;
+    tb_spinlock_enter(&semaphore->lock);
+
+    /* still waiting? remove it and mark it as timeout
+     *
+     * otherwise it has been posted and the coroutine will be resumed by the post later
+     */
+    tb_bool_t timeout = tb_false;
+    if (waiter->state == TB_CO_SEMAPHORE_WAITER_STATE_WAITING)
+    {
+        tb_list_entry_remove(&semaphore->waiting, &waiter->entry);
+        waiter->state = TB_CO_SEMAPHORE_WAITER_STATE_TIMEOUT;
+        timeout = tb_true;
+    }
+
+    // leave lock
+    tb_spinlock_leave(&semaphore->lock);
+
+    // resume the waiting coroutine, the timer is always spaked in the io loop of its own scheduler
+    if (timeout) tb_coroutine_resume(waiter->coroutine, (tb_cpointer_t)tb_false);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -71,8 +136,11 @@ tb_co_semaphore_ref_t tb_co_semaphore_init(tb_size_t value)
         // init value
         semaphore->value = value;
 
-        // init waiting coroutines
-        tb_single_list_entry_init(&semaphore->waiting, tb_coroutine_t, rs.single_entry, tb_null);
+        // init waiters
+        tb_list_entry_init(&semaphore->waiting, tb_co_semaphore_waiter_t, entry, tb_null);
+
+        // init lock
+        if (!tb_spinlock_init(&semaphore->lock)) break;
 
         // ok
         ok = tb_true;
@@ -96,11 +164,14 @@ tb_void_t tb_co_semaphore_exit(tb_co_semaphore_ref_t self)
     tb_co_semaphore_t* semaphore = (tb_co_semaphore_t*)self;
     tb_assert_and_check_return(semaphore);
 
-    // check waiting coroutines
-    tb_assert(!tb_single_list_entry_size(&semaphore->waiting));
+    // check waiters
+    tb_assert(!tb_list_entry_size(&semaphore->waiting));
+
+    // exit waiters
+    tb_list_entry_exit(&semaphore->waiting);
 
-    // exit waiting coroutines
-    tb_single_list_entry_exit(&semaphore->waiting);
+    // exit lock
+    tb_spinlock_exit(&semaphore->lock);
 
     // exit the semaphore
     tb_free(semaphore);
@@ -111,24 +182,32 @@ tb_void_t tb_co_semaphore_post(tb_co_semaphore_ref_t self, tb_size_t post)
     tb_co_semaphore_t* semaphore = (tb_co_semaphore_t*)self;
     tb_assert_and_check_return(semaphore);
 
+    // enter lock
+    tb_spinlock_enter(&semaphore->lock);
+
     // add the semaphore value
     tb_size_t value = semaphore->value + post;
 
-    // resume the waiting coroutines
-    while (value && tb_single_list_entry_size(&semaphore->waiting))
+    // resume the waiters
+    while (value && tb_list_entry_size(&semaphore->waiting))
     {
         // get the next entry from head
-        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&semaphore->waiting);
+        tb_list_entry_ref_t entry = tb_list_entry_head(&semaphore->waiting);
         tb_assert_and_check_break(entry);
 
-        // remove it from the waiting coroutines
-        tb_single_list_entry_remove_head(&semaphore->waiting);
+        // remove it from the waiters
+        tb_list_entry_remove_head(&semaphore->waiting);
 
-        // get the waiting coroutine
-        tb_coroutine_ref_t coroutine = (tb_coroutine_ref_t)tb_single_list_entry(&semaphore->waiting, entry);
+        /* mark it as posted, the timer of this waiter will do nothing now
+         *
+         * the timed out waiters have been removed from the waiting list, so it must be waiting here
+         */
+        tb_co_semaphore_waiter_t* waiter = (tb_co_semaphore_waiter_t*)tb_list_entry(&semaphore->waiting, entry);
+        tb_assert(waiter->state == TB_CO_SEMAPHORE_WAITER_STATE_WAITING);
+        waiter->state = TB_CO_SEMAPHORE_WAITER_STATE_POSTED;
 
         // resume this coroutine
-        tb_coroutine_resume(coroutine, (tb_cpointer_t)tb_true);
+        tb_coroutine_resume(waiter->coroutine, (tb_cpointer_t)tb_true);
 
         // decrease the semaphore value
         value--;
@@ -136,6 +215,9 @@ tb_void_t tb_co_semaphore_post(tb_co_semaphore_ref_t self, tb_size_t post)
 
     // update the semaphore value
     semaphore->value = value;
+
+    // leave lock
+    tb_spinlock_leave(&semaphore->lock);
 }
 tb_size_t tb_co_semaphore_value(tb_co_semaphore_ref_t self)
 {
@@ -152,24 +234,62 @@ tb_long_t tb_co_semaphore_wait(tb_co_semaphore_ref_t self, tb_long_t timeout)
     tb_co_semaphore_t* semaphore = (tb_co_semaphore_t*)self;
     tb_assert_and_check_return_val(semaphore, -1);
 
+    // enter lock
+    tb_spinlock_enter(&semaphore->lock);
+
     // attempt to get the semaphore value
     tb_long_t ok = 1;
-    if (semaphore->value) semaphore->value--;
+    if (semaphore->value) 
+    {
+        semaphore->value--;
+        tb_spinlock_leave(&semaphore->lock);
+    }
     // no semaphore? 
     else if (timeout)
     {
-        // get the running coroutine 
-        tb_coroutine_t* running = (tb_coroutine_t*)tb_coroutine_self();
-        tb_assert(running);
+        // init waiter
+        tb_co_semaphore_waiter_t waiter;
+        waiter.coroutine = tb_coroutine_self();
+        waiter.semaphore = semaphore;
+        waiter.state     = TB_CO_SEMAPHORE_WAITER_STATE_WAITING;
+        tb_assert(waiter.coroutine);
+
+        // get the io scheduler
+        tb_co_scheduler_io_ref_t scheduler_io = tb_co_scheduler_io_need(tb_null);
+        tb_assert(scheduler_io && scheduler_io->ltimer);
+
+        /* post the timer task of this waiter before it is visible to other threads
+         *
+         * @note we do not use sleep(timeout), because its timer can not be canceled 
+         * if this coroutine is resumed by the post
+         */
+        tb_ltimer_task_ref_t task = tb_null;
+        if (timeout > 0) task = tb_ltimer_task_init(scheduler_io->ltimer, timeout, tb_false, tb_co_semaphore_timeout, &waiter);
+
+        // save this waiter to the waiting list
+        tb_list_entry_insert_tail(&semaphore->waiting, &waiter.entry);
 
-        // save this coroutine to the waiting coroutines
-        tb_single_list_entry_insert_tail(&semaphore->waiting, &running->rs.single_entry);
+        // leave lock
+        tb_spinlock_leave(&semaphore->lock);
 
-        // wait semaphore 
-        ok = (tb_long_t)tb_coroutine_sleep(timeout);
+        /* wait semaphore
+         *
+         * it will be resumed only once by the post or the timer, which one changes the waiter state first
+         */
+        tb_coroutine_suspend(tb_null);
+
+        // exit the timer task, it has been expired or will be canceled
+        if (task) tb_ltimer_task_exit(scheduler_io->ltimer, task);
+
+        // ok?
+        ok = waiter.state == TB_CO_SEMAPHORE_WAITER_STATE_POSTED? 1 : 0;
     }
     // timeout and no waiting
-    else ok = 0;
+    else 
+    {
+        ok = 0;
+        tb_spinlock_leave(&semaphore->lock);
+    }
 
     // ok?
     return ok;
@@ -30,6 +30,7 @@
  */
 #include "prefix.h"
 #include "sql.h"
+#include "pool.h"
 
 
 
@@ -32,6 +32,8 @@
 #include "../sql.h"
 #include "sqlite3.h"
 #include "mysql.h"
+#include "../../container/hash_map.h"
+#include "../../container/list_entry.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -52,6 +54,9 @@ typedef struct __tb_database_sql_impl_t
     // is opened?
     tb_bool_t                       bopened;
 
+    // is in transaction?
+    tb_bool_t                       btransaction;
+
     // open
     tb_bool_t                       (*open)(struct __tb_database_sql_impl_t* database);
 
@@ -91,6 +96,25 @@ typedef struct __tb_database_sql_impl_t
     // statement bind
     tb_bool_t                       (*statement_bind)(struct __tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size);
 
+    /* statement done batch, optional
+     *
+     * bind and done the rows [row_offset, row_offset + row_count) of the column-wise value arrays,
+     * return the done row count
+     */
+    tb_size_t                       (*statement_done_batch)(struct __tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const** columns, tb_size_t column_count, tb_size_t row_offset, tb_size_t row_count);
+
+    // statement reset for reusing the cached statement, optional
+    tb_bool_t                       (*statement_reset)(struct __tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement);
+
+    // the cached statements, sql => tb_database_sql_statement_cache_t*
+    tb_hash_map_ref_t               statement_cache;
+
+    // the lru list of the cached statements, the recently used statement is at the head
+    tb_list_entry_head_t            statement_lru;
+
+    // the maximum count of the cached statements
+    tb_size_t                       statement_cache_maxn;
+
 }tb_database_sql_impl_t;
 
 
@@ -686,6 +686,79 @@ static tb_void_t tb_database_sqlite3_statement_bind_exit(tb_pointer_t data)
     // exit it
     if (data) tb_free(data);
 }
+static tb_int_t tb_database_sqlite3_statement_bind_value(sqlite3_stmt* statement, tb_int_t index, tb_database_sql_value_t const* value)
+{
+    // done
+    tb_int_t ok = SQLITE_ERROR;
+    switch (value->type)
+    {
+    case TB_DATABASE_SQL_VALUE_TYPE_TEXT:
+        ok = sqlite3_bind_text(statement, index, value->u.text.data, (tb_int_t)tb_database_sql_value_size(value), tb_null);
+        break;
+    case TB_DATABASE_SQL_VALUE_TYPE_INT64:
+    case TB_DATABASE_SQL_VALUE_TYPE_UINT64:
+        ok = sqlite3_bind_int64(statement, index, tb_database_sql_value_int64(value));
+        break;
+    case TB_DATABASE_SQL_VALUE_TYPE_INT32:
+    case TB_DATABASE_SQL_VALUE_TYPE_INT16:
+    case TB_DATABASE_SQL_VALUE_TYPE_INT8:
+    case TB_DATABASE_SQL_VALUE_TYPE_UINT32:
+    case TB_DATABASE_SQL_VALUE_TYPE_UINT16:
+    case TB_DATABASE_SQL_VALUE_TYPE_UINT8:
+        ok = sqlite3_bind_int(statement, index, (tb_int_t)tb_database_sql_value_int32(value));
+        break;
+    case TB_DATABASE_SQL_VALUE_TYPE_BLOB16:
+    case TB_DATABASE_SQL_VALUE_TYPE_BLOB8:
+        ok = sqlite3_bind_blob(statement, index, value->u.blob.data, (tb_int_t)value->u.blob.size, tb_null);
+        break;
+    case TB_DATABASE_SQL_VALUE_TYPE_BLOB32:
+        {
+            if (value->u.blob.stream)
+            {
+                // done
+                tb_byte_t* data = tb_null;
+                do
+                {
+                    // the stream size
+                    tb_hong_t size = tb_stream_size(value->u.blob.stream);
+                    tb_assert_and_check_break(size >= 0);
+
+                    // make data
+                    data = tb_malloc0_bytes((tb_size_t)size);
+                    tb_assert_and_check_break(data);
+
+                    // read data
+                    if (!tb_stream_bread(value->u.blob.stream, data, (tb_size_t)size)) break;
+
+                    // bind it, the data will be freed by sqlite3
+                    ok = sqlite3_bind_blob(statement, index, data, (tb_int_t)size, tb_database_sqlite3_statement_bind_exit);
+                    data = tb_null;
+
+                } while (0);
+
+                // exit data if failed
+                if (data) tb_free(data);
+            }
+            else ok = sqlite3_bind_blob(statement, index, value->u.blob.data, (tb_int_t)value->u.blob.size, tb_null);
+        }
+        break;
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    case TB_DATABASE_SQL_VALUE_TYPE_FLOAT:
+    case TB_DATABASE_SQL_VALUE_TYPE_DOUBLE:
+        ok = sqlite3_bind_double(statement, index, (tb_double_t)tb_database_sql_value_double(value));
+        break;
+#endif
+    case TB_DATABASE_SQL_VALUE_TYPE_NULL:
+        ok = sqlite3_bind_null(statement, index);
+        break;
+    default:
+        tb_trace_e("statement: bind: unknown value type: %lu", value->type);
+        break;
+    }
+
+    // ok?
+    return ok;
+}
 static tb_bool_t tb_database_sqlite3_statement_bind(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size)
 {
     // check
@@ -700,94 +773,91 @@ static tb_bool_t tb_database_sqlite3_statement_bind(tb_database_sql_impl_t* data
     tb_size_t i = 0;
     for (i = 0; i < size; i++)
     {
-        // the value
-        tb_database_sql_value_t const* value = &list[i];
-
-        // done
-        tb_int_t    ok = SQLITE_ERROR;
-        tb_byte_t*  data = tb_null;
-        switch (value->type)
+        // bind value
+        if (SQLITE_OK != tb_database_sqlite3_statement_bind_value((sqlite3_stmt*)statement, (tb_int_t)(i + 1), &list[i]))
         {
-        case TB_DATABASE_SQL_VALUE_TYPE_TEXT:
-            tb_trace_i("sqlite3: test %lu %s", i, value->u.text.data);
-            ok = sqlite3_bind_text((sqlite3_stmt*)statement, (tb_int_t)(i + 1), value->u.text.data, (tb_int_t)tb_database_sql_value_size(value), tb_null);
-            break;
-        case TB_DATABASE_SQL_VALUE_TYPE_INT64:
-        case TB_DATABASE_SQL_VALUE_TYPE_UINT64:
-            ok = sqlite3_bind_int64((sqlite3_stmt*)statement, (tb_int_t)(i + 1), tb_database_sql_value_int64(value));
-            break;
-        case TB_DATABASE_SQL_VALUE_TYPE_INT32:
-        case TB_DATABASE_SQL_VALUE_TYPE_INT16:
-        case TB_DATABASE_SQL_VALUE_TYPE_INT8:
-        case TB_DATABASE_SQL_VALUE_TYPE_UINT32:
-        case TB_DATABASE_SQL_VALUE_TYPE_UINT16:
-        case TB_DATABASE_SQL_VALUE_TYPE_UINT8:
-            ok = sqlite3_bind_int((sqlite3_stmt*)statement, (tb_int_t)(i + 1), (tb_int_t)tb_database_sql_value_int32(value));
-            break;
-        case TB_DATABASE_SQL_VALUE_TYPE_BLOB16:
-        case TB_DATABASE_SQL_VALUE_TYPE_BLOB8:
-            ok = sqlite3_bind_blob((sqlite3_stmt*)statement, (tb_int_t)(i + 1), value->u.blob.data, (tb_int_t)value->u.blob.size, tb_null);
+            // save state
+            sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
+
+            // trace
+            tb_trace_e("statement: bind value[%lu] failed, error[%d]: %s", i, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
             break;
-        case TB_DATABASE_SQL_VALUE_TYPE_BLOB32:
-            {
-                if (value->u.blob.stream)
-                {
-                    // done
-                    do
-                    {
-                        // the stream size
-                        tb_hong_t size = tb_stream_size(value->u.blob.stream);
-                        tb_assert_and_check_break(size >= 0);
+        }
+    }
 
-                        // make data
-                        data = tb_malloc0_bytes((tb_size_t)size);
-                        tb_assert_and_check_break(data);
+    // ok?
+    return (i == size)? tb_true : tb_false;
+}
+static tb_size_t tb_database_sqlite3_statement_done_batch(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const** columns, tb_size_t column_count, tb_size_t row_offset, tb_size_t row_count)
+{
+    // check
+    tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
+    tb_assert_and_check_return_val(sqlite && sqlite->database && statement && columns && column_count, 0);
 
-                        // read data
-                        if (!tb_stream_bread(value->u.blob.stream, data, (tb_size_t)size)) break;
+    // the param count
+    tb_size_t param_count = (tb_size_t)sqlite3_bind_parameter_count((sqlite3_stmt*)statement);
+    tb_assert_and_check_return_val(column_count == param_count, 0);
 
-                        // bind it
-                        ok = sqlite3_bind_blob((sqlite3_stmt*)statement, (tb_int_t)(i + 1), data, (tb_int_t)size, tb_database_sqlite3_statement_bind_exit);
+    // exit result first if exists
+    if (sqlite->result.result) sqlite3_free_table(sqlite->result.result);
+    sqlite->result.result       = tb_null;
+    sqlite->result.statement    = tb_null;
+    sqlite->result.count        = 0;
+    sqlite->result.row.count    = 0;
 
-                    } while (0);
-                }
-                else ok = sqlite3_bind_blob((sqlite3_stmt*)statement, (tb_int_t)(i + 1), value->u.blob.data, (tb_int_t)value->u.blob.size, tb_null);
-            }
-            break;
-#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-        case TB_DATABASE_SQL_VALUE_TYPE_FLOAT:
-        case TB_DATABASE_SQL_VALUE_TYPE_DOUBLE:
-            ok = sqlite3_bind_double((sqlite3_stmt*)statement, (tb_int_t)(i + 1), (tb_double_t)tb_database_sql_value_double(value));
-            break;
-#endif
-        case TB_DATABASE_SQL_VALUE_TYPE_NULL:
-            ok = sqlite3_bind_null((sqlite3_stmt*)statement, (tb_int_t)(i + 1));
-            break;
-        default:
-            tb_trace_e("statement: bind: unknown value type: %lu", value->type);
-            break;
+    // done rows, bind the column values directly without making the row values
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < row_count; i++)
+    {
+        // bind values
+        tb_size_t row = row_offset + i;
+        for (j = 0; j < column_count; j++)
+        {
+            if (SQLITE_OK != tb_database_sqlite3_statement_bind_value((sqlite3_stmt*)statement, (tb_int_t)(j + 1), &columns[j][row])) break;
         }
 
-        // failed?
-        if (SQLITE_OK != ok)
+        // step and reset it for the next row, the batch statement should not have any result
+        tb_int_t ok = (j == column_count)? sqlite3_step((sqlite3_stmt*)statement) : SQLITE_ERROR;
+        if (SQLITE_OK != sqlite3_reset((sqlite3_stmt*)statement) || ok != SQLITE_DONE)
         {
-            // exit data
-            if (data) tb_free(data);
-            data = tb_null;
-
             // save state
             sqlite->base.state = tb_database_sqlite3_state_from_errno(sqlite3_errcode(sqlite->database));
 
             // trace
-            tb_trace_e("statement: bind value[%lu] failed, error[%d]: %s", i, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
+            tb_trace_e("statement: done row[%lu] failed, error[%d]: %s", row, sqlite3_errcode(sqlite->database), sqlite3_errmsg(sqlite->database));
             break;
         }
     }
 
     // ok?
-    return (i == size)? tb_true : tb_false;
+    return i;
 }
 
+static tb_bool_t tb_database_sqlite3_statement_reset(tb_database_sql_impl_t* database, tb_database_sql_statement_ref_t statement)
+{
+    // check
+    tb_database_sqlite3_t* sqlite = tb_database_sqlite3_cast(database);
+    tb_assert_and_check_return_val(sqlite && sqlite->database && statement, tb_false);
+
+    // clear the result if it is iterating this statement
+    if (sqlite->result.statement == (sqlite3_stmt*)statement)
+    {
+        sqlite->result.statement    = tb_null;
+        sqlite->result.count        = 0;
+        sqlite->result.row.count    = 0;
+    }
+
+    /* reset it
+     *
+     * @note sqlite3_reset() returns the error of the last step, 
+     * but the statement has been reset and can be reused
+     */
+    sqlite3_reset((sqlite3_stmt*)statement);
+
+    // clear the bound arguments
+    return SQLITE_OK == sqlite3_clear_bindings((sqlite3_stmt*)statement);
+}
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -880,6 +950,8 @@ tb_database_sql_ref_t tb_database_sqlite3_init(tb_url_ref_t url)
         sqlite->base.statement_exit = tb_database_sqlite3_statement_exit;
         sqlite->base.statement_done = tb_database_sqlite3_statement_done;
         sqlite->base.statement_bind = tb_database_sqlite3_statement_bind;
+        sqlite->base.statement_done_batch = tb_database_sqlite3_statement_done_batch;
+        sqlite->base.statement_reset = tb_database_sqlite3_statement_reset;
 
         // init row operation
         static tb_iterator_op_t row_op = 
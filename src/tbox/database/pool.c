@@ -0,0 +1,437 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ *
+ * @author      ruki
+ * @file        pool.c
+ * @ingroup     database
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "database_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "pool.h"
+#include "../platform/platform.h"
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../coroutine/coroutine.h"
+#   define TB_DATABASE_SQL_POOL_HAVE_COROUTINE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the idle connection type
+typedef struct __tb_database_sql_pool_idle_t
+{
+    // the database
+    tb_database_sql_ref_t           database;
+
+    // the returned time
+    tb_hong_t                       time;
+
+}tb_database_sql_pool_idle_t;
+
+// the database sql pool type
+typedef struct __tb_database_sql_pool_t
+{
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the semaphore for waking up the waiting threads
+    tb_semaphore_ref_t              semaphore;
+
+    // the url
+    tb_char_t*                      url;
+
+    // the idle connections, the recently returned connection is at the top
+    tb_database_sql_pool_idle_t*    idle;
+
+    // the idle connection count
+    tb_size_t                       idle_size;
+
+    // the connection count, including the borrowed and idle connections
+    tb_size_t                       size;
+
+    // the maximum connection count
+    tb_size_t                       maxn;
+
+    // the waiting thread count
+    tb_size_t                       waiting;
+
+    // the idle timeout
+    tb_long_t                       idle_timeout;
+
+    // the check timeout
+    tb_long_t                       check_timeout;
+
+}tb_database_sql_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_database_sql_ref_t tb_database_sql_pool_open(tb_database_sql_pool_t* pool)
+{
+    // init database
+    tb_database_sql_ref_t database = tb_database_sql_init(pool->url);
+    tb_assert_and_check_return_val(database, tb_null);
+
+    // open it
+    if (!tb_database_sql_open(database))
+    {
+        // trace
+        tb_trace_e("open %s failed, error: %s", pool->url, tb_state_cstr(tb_database_sql_state(database)));
+
+        // exit it
+        tb_database_sql_exit(database);
+        return tb_null;
+    }
+
+    // trace
+    tb_trace_d("open: %p", database);
+    return database;
+}
+static tb_bool_t tb_database_sql_pool_check(tb_database_sql_ref_t database)
+{
+    // ping it
+    tb_check_return_val(tb_database_sql_done(database, "select 1"), tb_false);
+
+    // exit the result
+    tb_iterator_ref_t result = tb_database_sql_result_load(database, tb_true);
+    if (result) tb_database_sql_result_exit(database, result);
+    return tb_true;
+}
+static tb_bool_t tb_database_sql_pool_wait(tb_database_sql_pool_t* pool, tb_bool_t bcoroutine, tb_long_t timeout)
+{
+#ifdef TB_DATABASE_SQL_POOL_HAVE_COROUTINE
+    /* wait it in coroutine
+     *
+     * the connection may be returned by other threads, so we cannot resume this coroutine directly,
+     * and we poll it instead of blocking the scheduler thread
+     */
+    if (bcoroutine) 
+    {
+        tb_coroutine_sleep(timeout >= 0? tb_min(timeout, 1) : 1);
+        return tb_true;
+    }
+#endif
+
+    // wait it in thread, the waiting count has been increased when borrowing it
+    tb_long_t wait = tb_semaphore_wait(pool->semaphore, timeout);
+    tb_spinlock_enter(&pool->lock);
+    pool->waiting--;
+    tb_spinlock_leave(&pool->lock);
+    return wait >= 0;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_database_sql_pool_ref_t tb_database_sql_pool_init(tb_char_t const* url, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(url && maxn, tb_null);
+
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_database_sql_pool_t* pool = tb_null;
+    do
+    {
+        // make pool
+        pool = tb_malloc0_type(tb_database_sql_pool_t);
+        tb_assert_and_check_break(pool);
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+
+        // init semaphore
+        pool->semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(pool->semaphore);
+
+        // init url
+        pool->url = tb_strdup(url);
+        tb_assert_and_check_break(pool->url);
+
+        // init idle connections
+        pool->idle = tb_nalloc0_type(maxn, tb_database_sql_pool_idle_t);
+        tb_assert_and_check_break(pool->idle);
+
+        // init pool
+        pool->maxn          = maxn;
+        pool->idle_timeout  = TB_DATABASE_SQL_POOL_IDLE_TIMEOUT;
+        pool->check_timeout = TB_DATABASE_SQL_POOL_CHECK_TIMEOUT;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_database_sql_pool_exit((tb_database_sql_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_database_sql_pool_ref_t)pool;
+}
+tb_void_t tb_database_sql_pool_exit(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // exit the idle connections
+    tb_size_t i = 0;
+    for (i = 0; i < pool->idle_size; i++)
+    {
+        tb_database_sql_clos(pool->idle[i].database);
+        tb_database_sql_exit(pool->idle[i].database);
+    }
+
+    // some connections have not been returned?
+    tb_assertf(pool->size == pool->idle_size, "%lu connections have not been returned!", pool->size - pool->idle_size);
+
+    // exit idle connections
+    if (pool->idle) tb_free(pool->idle);
+    pool->idle = tb_null;
+
+    // exit url
+    if (pool->url) tb_free(pool->url);
+    pool->url = tb_null;
+
+    // exit semaphore
+    if (pool->semaphore) tb_semaphore_exit(pool->semaphore);
+    pool->semaphore = tb_null;
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+tb_void_t tb_database_sql_pool_timeout_set(tb_database_sql_pool_ref_t self, tb_long_t idle_timeout, tb_long_t check_timeout)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // set timeouts
+    tb_spinlock_enter(&pool->lock);
+    pool->idle_timeout  = idle_timeout;
+    pool->check_timeout = check_timeout;
+    tb_spinlock_leave(&pool->lock);
+}
+tb_database_sql_ref_t tb_database_sql_pool_borrow(tb_database_sql_pool_ref_t self, tb_long_t timeout)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return_val(pool, tb_null);
+
+    // is coroutine?
+    tb_bool_t bcoroutine = tb_false;
+#ifdef TB_DATABASE_SQL_POOL_HAVE_COROUTINE
+    bcoroutine = tb_coroutine_self()? tb_true : tb_false;
+#endif
+
+    // done
+    tb_hong_t               time = tb_mclock();
+    tb_database_sql_ref_t   database = tb_null;
+    while (!database)
+    {
+        // pop the recently returned connection
+        tb_hong_t   now = tb_mclock();
+        tb_bool_t   bopen = tb_false;
+        tb_bool_t   bcheck = tb_false;
+        tb_bool_t   bwait = tb_false;
+        tb_spinlock_enter(&pool->lock);
+        if (pool->idle_size)
+        {
+            tb_database_sql_pool_idle_t* idle = &pool->idle[--pool->idle_size];
+            database = idle->database;
+            bcheck = pool->check_timeout >= 0 && now >= idle->time + pool->check_timeout;
+        }
+        // open a new connection if the pool is not full
+        else if (pool->size < pool->maxn)
+        {
+            pool->size++;
+            bopen = tb_true;
+        }
+        // wait the returned connection, increase the waiting count in this lock for not losing the wakeup
+        else if (!bcoroutine) 
+        {
+            pool->waiting++;
+            bwait = tb_true;
+        }
+        tb_spinlock_leave(&pool->lock);
+
+        // check the idle connection and reopen it if it has been broken
+        if (database && bcheck && !tb_database_sql_pool_check(database))
+        {
+            // trace
+            tb_trace_d("check: %p failed, reopen it", database);
+
+            // reopen it
+            tb_database_sql_clos(database);
+            if (!tb_database_sql_open(database))
+            {
+                // exit it
+                tb_database_sql_exit(database);
+                database = tb_null;
+
+                // release this slot
+                tb_spinlock_enter(&pool->lock);
+                pool->size--;
+                tb_spinlock_leave(&pool->lock);
+
+                /* try to open a new connection under the limit at the next loop
+                 *
+                 * @note we cannot wait here, because the waiting count has not been increased
+                 */
+                continue;
+            }
+        }
+
+        // open a new connection
+        if (bopen)
+        {
+            database = tb_database_sql_pool_open(pool);
+            if (!database)
+            {
+                // failed
+                tb_spinlock_enter(&pool->lock);
+                pool->size--;
+                tb_spinlock_leave(&pool->lock);
+                break;
+            }
+        }
+
+        // ok?
+        tb_check_break(!database);
+
+        // wait the returned connection
+        tb_long_t left = timeout >= 0? (tb_long_t)(time + timeout - now) : -1;
+        if (timeout >= 0 && left <= 0) 
+        {
+            // cancel waiting
+            if (bwait)
+            {
+                tb_spinlock_enter(&pool->lock);
+                pool->waiting--;
+                tb_spinlock_leave(&pool->lock);
+            }
+            break;
+        }
+        tb_assert(bwait || bcoroutine);
+        if (!tb_database_sql_pool_wait(pool, bcoroutine, left)) break;
+    }
+
+    // trace
+    tb_trace_d("borrow: %p", database);
+
+    // ok?
+    return database;
+}
+tb_void_t tb_database_sql_pool_return(tb_database_sql_pool_ref_t self, tb_database_sql_ref_t database)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return(pool && database);
+
+    // trace
+    tb_trace_d("return: %p", database);
+
+    // push it to the top of the idle connections
+    tb_hong_t now = tb_mclock();
+    tb_bool_t wakeup = tb_false;
+    tb_spinlock_enter(&pool->lock);
+    tb_assert(pool->idle_size < pool->size);
+    if (pool->idle_size < pool->maxn)
+    {
+        tb_database_sql_pool_idle_t* idle = &pool->idle[pool->idle_size++];
+        idle->database  = database;
+        idle->time      = now;
+        wakeup          = pool->waiting > 0;
+    }
+    tb_spinlock_leave(&pool->lock);
+
+    // wake up one waiting thread
+    if (wakeup) tb_semaphore_post(pool->semaphore, 1);
+
+    // close the idle connections
+    tb_database_sql_pool_reap(self);
+}
+tb_size_t tb_database_sql_pool_reap(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // close the oldest idle connections at the bottom
+    tb_size_t count = 0;
+    tb_hong_t now = tb_mclock();
+    while (1)
+    {
+        // pop the oldest idle connection if timeout
+        tb_database_sql_ref_t database = tb_null;
+        tb_spinlock_enter(&pool->lock);
+        if (pool->idle_size && pool->idle_timeout >= 0 && now >= pool->idle[0].time + pool->idle_timeout)
+        {
+            database = pool->idle[0].database;
+            pool->idle_size--;
+            if (pool->idle_size) tb_memmov(pool->idle, pool->idle + 1, pool->idle_size * sizeof(tb_database_sql_pool_idle_t));
+            pool->size--;
+        }
+        tb_spinlock_leave(&pool->lock);
+        tb_check_break(database);
+
+        // trace
+        tb_trace_d("reap: %p", database);
+
+        // exit it
+        tb_database_sql_clos(database);
+        tb_database_sql_exit(database);
+        count++;
+    }
+
+    // ok?
+    return count;
+}
+tb_size_t tb_database_sql_pool_size(tb_database_sql_pool_ref_t self)
+{
+    // check
+    tb_database_sql_pool_t* pool = (tb_database_sql_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // the connection count
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t size = pool->size;
+    tb_spinlock_leave(&pool->lock);
+    return size;
+}
@@ -0,0 +1,151 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ *
+ * @author      ruki
+ * @file        pool.h
+ * @ingroup     database
+ */
+#ifndef TB_DATABASE_POOL_H
+#define TB_DATABASE_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "sql.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default idle timeout (ms), the idle connection will be closed after this timeout
+#define TB_DATABASE_SQL_POOL_IDLE_TIMEOUT       (60000)
+
+/// the default check timeout (ms), the idle connection will be checked before borrowing it after this timeout
+#define TB_DATABASE_SQL_POOL_CHECK_TIMEOUT      (5000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the database sql pool ref type
+typedef __tb_typeref__(database_sql_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the database connection pool
+ *
+ * the connections will be opened lazily and shared by the threads and coroutines
+ *
+ * @code
+    tb_database_sql_pool_ref_t pool = tb_database_sql_pool_init("/home/file.sqlite3", 8);
+    if (pool)
+    {
+        // borrow one connection
+        tb_database_sql_ref_t database = tb_database_sql_pool_borrow(pool, -1);
+        if (database)
+        {
+            // load the cached statement
+            tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, "select * from table where id=?");
+            // ...
+
+            // return it
+            tb_database_sql_pool_return(pool, database);
+        }
+
+        // exit pool
+        tb_database_sql_pool_exit(pool);
+    }
+ * @endcode
+ *
+ * @param url                       the database url, see tb_database_sql_init()
+ * @param maxn                      the maximum count of the connections
+ * @return                          the pool
+ */
+tb_database_sql_pool_ref_t          tb_database_sql_pool_init(tb_char_t const* url, tb_size_t maxn);
+
+/*! exit the database connection pool
+ *
+ * @note all borrowed connections must be returned before exiting it
+ *
+ * @param pool                      the pool
+ */
+tb_void_t                           tb_database_sql_pool_exit(tb_database_sql_pool_ref_t pool);
+
+/*! set the timeouts of the database connection pool
+ *
+ * @param pool                      the pool
+ * @param idle_timeout              the idle timeout (ms), never close the idle connections if be -1
+ * @param check_timeout             the check timeout (ms), check it every time before borrowing it if be zero
+ */
+tb_void_t                           tb_database_sql_pool_timeout_set(tb_database_sql_pool_ref_t pool, tb_long_t idle_timeout, tb_long_t check_timeout);
+
+/*! borrow one opened connection from the pool
+ *
+ * the recently returned connection will be borrowed first, 
+ * and it will be checked and reopened if it has been idle for a long time.
+ *
+ * it will suspend the current coroutine instead of blocking the thread if be called in coroutine
+ *
+ * @param pool                      the pool
+ * @param timeout                   the timeout (ms) of waiting for the busy connections, infinity: -1
+ * @return                          the database handle, return null if timeout or failed
+ */
+tb_database_sql_ref_t               tb_database_sql_pool_borrow(tb_database_sql_pool_ref_t pool, tb_long_t timeout);
+
+/*! return the borrowed connection to the pool
+ *
+ * @note please do not close it, and the transaction and the result must be finished before returning it
+ *
+ * @param pool                      the pool
+ * @param database                  the database handle
+ */
+tb_void_t                           tb_database_sql_pool_return(tb_database_sql_pool_ref_t pool, tb_database_sql_ref_t database);
+
+/*! close the connections which have been idle for the idle timeout
+ *
+ * it will be called automatically when returning the connection
+ *
+ * @param pool                      the pool
+ * @return                          the closed connection count
+ */
+tb_size_t                           tb_database_sql_pool_reap(tb_database_sql_pool_ref_t pool);
+
+/*! the connection count of the pool, including the borrowed and idle connections
+ *
+ * @param pool                      the pool
+ * @return                          the connection count
+ */
+tb_size_t                           tb_database_sql_pool_size(tb_database_sql_pool_ref_t pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
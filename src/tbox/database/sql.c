@@ -35,6 +35,83 @@
 #include "sql.h"
 #include "impl/prefix.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached statement type
+typedef struct __tb_database_sql_statement_cache_t
+{
+    // the lru list entry
+    tb_list_entry_t                 entry;
+
+    // the statement
+    tb_database_sql_statement_ref_t statement;
+
+    // the sql, the data is appended to this item
+    tb_char_t const*                sql;
+
+}tb_database_sql_statement_cache_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_database_sql_statement_cache_remove(tb_database_sql_impl_t* impl, tb_database_sql_statement_cache_t* cache)
+{
+    // remove it from the lru list
+    tb_list_entry_remove(&impl->statement_lru, &cache->entry);
+
+    // remove it from the cache, the sql will be freed after removing it
+    tb_hash_map_remove(impl->statement_cache, cache->sql);
+
+    // exit statement
+    if (cache->statement && impl->statement_exit) impl->statement_exit(impl, cache->statement);
+
+    // exit it
+    tb_free(cache);
+}
+static tb_void_t tb_database_sql_statement_cache_clear(tb_database_sql_impl_t* impl)
+{
+    // no cache?
+    tb_check_return(impl->statement_cache);
+
+    // exit all cached statements
+    while (tb_list_entry_size(&impl->statement_lru))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&impl->statement_lru);
+        tb_database_sql_statement_cache_remove(impl, (tb_database_sql_statement_cache_t*)tb_list_entry(&impl->statement_lru, entry));
+    }
+
+    // exit cache
+    tb_hash_map_exit(impl->statement_cache);
+    impl->statement_cache = tb_null;
+}
+
+static tb_size_t tb_database_sql_statement_done_rows(tb_database_sql_impl_t* impl, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const** columns, tb_size_t column_count, tb_size_t row_offset, tb_size_t row_count)
+{
+    // the row values
+    tb_database_sql_value_t  row_data[TB_DATABASE_SQL_BATCH_COLUMN_MAXN];
+    tb_database_sql_value_t* row = column_count <= tb_arrayn(row_data)? row_data : tb_nalloc_type(column_count, tb_database_sql_value_t);
+    tb_assert_and_check_return_val(row, 0);
+
+    // bind and done it row by row
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < row_count; i++)
+    {
+        // make row
+        for (j = 0; j < column_count; j++) row[j] = columns[j][row_offset + i];
+
+        // bind and done it
+        if (!impl->statement_bind(impl, statement, row, column_count)) break;
+        if (!impl->statement_done(impl, statement)) break;
+    }
+
+    // exit row
+    if (row != row_data) tb_free(row);
+    return i;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -114,6 +191,9 @@ tb_database_sql_ref_t tb_database_sql_init(tb_char_t const* url)
         database = s_init[m](&database_url);
         tb_assert_and_check_break(database);
 
+        // init the maximum count of the cached statements
+        ((tb_database_sql_impl_t*)database)->statement_cache_maxn = TB_DATABASE_SQL_STATEMENT_CACHE_MAXN;
+
         // trace
         tb_trace_d("init: %s: ok", url);
 
@@ -148,6 +228,9 @@ tb_void_t tb_database_sql_exit(tb_database_sql_ref_t database)
     // trace
     tb_trace_d("exit: ..");
 
+    // exit the cached statements before closing it
+    tb_database_sql_statement_cache_clear(impl);
+
     // exit it
     if (impl->exit) impl->exit(impl);
 
@@ -193,11 +276,15 @@ tb_void_t tb_database_sql_clos(tb_database_sql_ref_t database)
     // opened?
     tb_check_return(impl->bopened);
 
+    // exit the cached statements, the statements will be invalid after closing it
+    tb_database_sql_statement_cache_clear(impl);
+
     // clos it
     if (impl->clos) impl->clos(impl);
     
     // closed
     impl->bopened = tb_false;
+    impl->btransaction = tb_false;
     
     // clear state
     impl->state = TB_STATE_OK;
@@ -227,7 +314,11 @@ tb_bool_t tb_database_sql_begin(tb_database_sql_ref_t database)
     tb_bool_t ok = impl->begin(impl);
 
     // save state
-    if (ok) impl->state = TB_STATE_OK;
+    if (ok) 
+    {
+        impl->state = TB_STATE_OK;
+        impl->btransaction = tb_true;
+    }
 
     // ok?
     return ok;
@@ -248,7 +339,11 @@ tb_bool_t tb_database_sql_commit(tb_database_sql_ref_t database)
     tb_bool_t ok = impl->commit(impl);
 
     // save state
-    if (ok) impl->state = TB_STATE_OK;
+    if (ok) 
+    {
+        impl->state = TB_STATE_OK;
+        impl->btransaction = tb_false;
+    }
 
     // ok?
     return ok;
@@ -269,7 +364,11 @@ tb_bool_t tb_database_sql_rollback(tb_database_sql_ref_t database)
     tb_bool_t ok = impl->rollback(impl);
 
     // save state
-    if (ok) impl->state = TB_STATE_OK;
+    if (ok) 
+    {
+        impl->state = TB_STATE_OK;
+        impl->btransaction = tb_false;
+    }
 
     // ok?
     return ok;
@@ -412,3 +511,164 @@ tb_bool_t tb_database_sql_statement_bind(tb_database_sql_ref_t database, tb_data
     // ok?
     return ok;
 }
+tb_database_sql_statement_ref_t tb_database_sql_statement_load(tb_database_sql_ref_t database, tb_char_t const* sql)
+{
+    // check
+    tb_database_sql_impl_t* impl = (tb_database_sql_impl_t*)database;
+    tb_assert_and_check_return_val(impl && impl->statement_init && sql, tb_null);
+
+    // init state
+    impl->state = TB_STATE_DATABASE_UNKNOWN_ERROR;
+
+    // opened?
+    tb_assert_and_check_return_val(impl->bopened, tb_null);
+
+    // done
+    tb_database_sql_statement_ref_t statement = tb_null;
+    do
+    {
+        // init cache
+        if (!impl->statement_cache)
+        {
+            impl->statement_cache = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_null, tb_null));
+            tb_assert_and_check_break(impl->statement_cache);
+
+            // init lru list
+            tb_list_entry_init(&impl->statement_lru, tb_database_sql_statement_cache_t, entry, tb_null);
+        }
+
+        // hit the cached statement?
+        tb_database_sql_statement_cache_t* cache = (tb_database_sql_statement_cache_t*)tb_hash_map_get(impl->statement_cache, sql);
+        if (cache)
+        {
+            // reset it, remove it if failed
+            if (impl->statement_reset && !impl->statement_reset(impl, cache->statement))
+            {
+                tb_database_sql_statement_cache_remove(impl, cache);
+                cache = tb_null;
+            }
+            else
+            {
+                // move it to the head of the lru list
+                tb_list_entry_moveto_head(&impl->statement_lru, &cache->entry);
+
+                // ok
+                statement = cache->statement;
+                break;
+            }
+        }
+
+        // init statement
+        statement = impl->statement_init(impl, sql);
+        tb_check_break(statement);
+
+        // remove the least recently used statement if the cache is full
+        while (tb_list_entry_size(&impl->statement_lru) >= impl->statement_cache_maxn)
+        {
+            tb_list_entry_ref_t last = tb_list_entry_last(&impl->statement_lru);
+            tb_database_sql_statement_cache_remove(impl, (tb_database_sql_statement_cache_t*)tb_list_entry(&impl->statement_lru, last));
+        }
+
+        // make cache
+        tb_size_t size = tb_strlen(sql);
+        cache = (tb_database_sql_statement_cache_t*)tb_malloc(sizeof(tb_database_sql_statement_cache_t) + size + 1);
+        if (!cache)
+        {
+            impl->statement_exit(impl, statement);
+            statement = tb_null;
+            break;
+        }
+        tb_memcpy((tb_char_t*)(cache + 1), sql, size + 1);
+        cache->sql          = (tb_char_t const*)(cache + 1);
+        cache->statement    = statement;
+
+        // cache it
+        tb_hash_map_insert(impl->statement_cache, cache->sql, cache);
+        tb_list_entry_insert_head(&impl->statement_lru, &cache->entry);
+
+    } while (0);
+
+    // save state
+    if (statement) impl->state = TB_STATE_OK;
+
+    // ok?
+    return statement;
+}
+tb_void_t tb_database_sql_statement_cache_maxn_set(tb_database_sql_ref_t database, tb_size_t maxn)
+{
+    // check
+    tb_database_sql_impl_t* impl = (tb_database_sql_impl_t*)database;
+    tb_assert_and_check_return(impl && maxn);
+
+    // set the maximum count of the cached statements
+    impl->statement_cache_maxn = maxn;
+
+    // remove the least recently used statements
+    while (impl->statement_cache && tb_list_entry_size(&impl->statement_lru) > maxn)
+    {
+        tb_list_entry_ref_t last = tb_list_entry_last(&impl->statement_lru);
+        tb_database_sql_statement_cache_remove(impl, (tb_database_sql_statement_cache_t*)tb_list_entry(&impl->statement_lru, last));
+    }
+}
+tb_bool_t tb_database_sql_statement_done_batch(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const** columns, tb_size_t column_count, tb_size_t row_count, tb_database_sql_batch_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_database_sql_impl_t* impl = (tb_database_sql_impl_t*)database;
+    tb_assert_and_check_return_val(impl && impl->statement_bind && impl->statement_done && statement && columns && column_count, tb_false);
+
+    // init state
+    impl->state = TB_STATE_DATABASE_UNKNOWN_ERROR;
+
+    // opened?
+    tb_assert_and_check_return_val(impl->bopened, tb_false);
+
+    // begin the transaction if not in transaction
+    tb_bool_t bauto = !impl->btransaction;
+    if (bauto && !tb_database_sql_begin(database)) return tb_false;
+
+    // done it
+    tb_bool_t   ok = tb_true;
+    tb_size_t   done = 0;
+    while (done < row_count)
+    {
+        // done the rows of this step
+        tb_size_t count = tb_min(row_count - done, TB_DATABASE_SQL_BATCH_STEP);
+        tb_size_t real = impl->statement_done_batch? impl->statement_done_batch(impl, statement, columns, column_count, done, count) 
+                                                  : tb_database_sql_statement_done_rows(impl, statement, columns, column_count, done, count);
+        done += real;
+
+        // failed?
+        if (real != count) 
+        {
+            // trace
+            tb_trace_e("done batch: failed at row: %lu, error: %s", done, tb_state_cstr(impl->state));
+            ok = tb_false;
+            break;
+        }
+
+        // notify the progress, cancel it if return false
+        if (func && !func(done, row_count, priv)) 
+        {
+            // trace
+            tb_trace_d("done batch: canceled at row: %lu", done);
+            ok = tb_false;
+            break;
+        }
+    }
+
+    // save the failed state
+    tb_size_t state = impl->state;
+
+    // end the transaction
+    if (bauto)
+    {
+        if (ok) ok = tb_database_sql_commit(database);
+        else tb_database_sql_rollback(database);
+    }
+
+    // save state
+    impl->state = ok? TB_STATE_OK : (state != TB_STATE_OK? state : TB_STATE_DATABASE_UNKNOWN_ERROR);
+
+    // ok?
+    return ok;
+}
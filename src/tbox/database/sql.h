@@ -31,6 +31,27 @@
 #include "prefix.h"
 #include "value.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/// the default maximum count of the cached statements for each database
+#ifdef __tb_small__
+#   define TB_DATABASE_SQL_STATEMENT_CACHE_MAXN     (16)
+#else
+#   define TB_DATABASE_SQL_STATEMENT_CACHE_MAXN     (64)
+#endif
+
+/// the row count of each step for the batch statement, the progress will be notified after each step
+#ifdef __tb_small__
+#   define TB_DATABASE_SQL_BATCH_STEP               (256)
+#else
+#   define TB_DATABASE_SQL_BATCH_STEP               (4096)
+#endif
+
+/// the column count of the batch statement without allocating the row values
+#define TB_DATABASE_SQL_BATCH_COLUMN_MAXN           (16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -55,6 +76,16 @@ typedef __tb_typeref__(database_sql);
 /// the database sql statement ref type
 typedef __tb_typeref__(database_sql_statement);
 
+/*! the batch progress func type
+ *
+ * @param done                      the done row count
+ * @param total                     the total row count
+ * @param priv                      the user private data
+ *
+ * @return                          tb_true: continue it, tb_false: cancel it
+ */
+typedef tb_bool_t                   (*tb_database_sql_batch_func_t)(tb_size_t done, tb_size_t total, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -331,6 +362,81 @@ tb_bool_t                           tb_database_sql_statement_done(tb_database_s
  */
 tb_bool_t                           tb_database_sql_statement_bind(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const* list, tb_size_t size);
 
+/*! bind and done the database statement with the column-wise value arrays
+ *
+ * the statement will be reused for all rows, and all rows will be done in one transaction
+ * if the database is not in transaction, it will be rollbacked if failed or canceled.
+ *
+ * @code
+    tb_int32_t          ids[1000];
+    tb_char_t const*    names[1000];
+    // ...
+
+    // make columns
+    tb_database_sql_value_t* id_values = tb_nalloc_type(1000, tb_database_sql_value_t);
+    tb_database_sql_value_t* name_values = tb_nalloc_type(1000, tb_database_sql_value_t);
+    for (i = 0; i < 1000; i++)
+    {
+        tb_database_sql_value_set_int32(&id_values[i], ids[i]);
+        tb_database_sql_value_set_text(&name_values[i], names[i], 0);
+    }
+    tb_database_sql_value_t const* columns[] = {id_values, name_values};
+
+    // insert rows
+    tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, "insert into table values(?, ?)");
+    if (statement) tb_database_sql_statement_done_batch(database, statement, columns, 2, 1000, tb_null, tb_null);
+ * @endcode
+ *
+ * @param database                  the database handle
+ * @param statement                 the statement handle
+ * @param columns                   the column value arrays, columns[column][row]
+ * @param column_count              the column count
+ * @param row_count                 the row count
+ * @param func                      the progress func, optional
+ * @param priv                      the user private data
+ * @return                          tb_true or tb_false
+ */
+tb_bool_t                           tb_database_sql_statement_done_batch(tb_database_sql_ref_t database, tb_database_sql_statement_ref_t statement, tb_database_sql_value_t const** columns, tb_size_t column_count, tb_size_t row_count, tb_database_sql_batch_func_t func, tb_cpointer_t priv);
+
+/*! load the cached database statement 
+ *
+ * the statement will be prepared and cached if it has not been cached,
+ * and the least recently used statement will be removed if the cache is full.
+ *
+ * @code
+    tb_database_sql_statement_ref_t statement = tb_database_sql_statement_load(database, "select * from table where id=?");
+    if (statement)
+    {
+        // bind arguments
+        // ...
+
+        // done statement
+        if (tb_database_sql_statement_done(database, statement))
+        {
+            // load result
+            // ...
+        }
+
+        // need not exit statement
+    }
+ * @endcode
+ *
+ * @note the statement is owned by the database, please do not exit it,
+ * it will be reset when loading it again and be exited when closing the database
+ *
+ * @param database                  the database handle
+ * @param sql                       the sql command
+ * @return                          the statement handle
+ */
+tb_database_sql_statement_ref_t     tb_database_sql_statement_load(tb_database_sql_ref_t database, tb_char_t const* sql);
+
+/*! set the maximum count of the cached statements
+ *
+ * @param database                  the database handle
+ * @param maxn                      the maximum count, must be larger than zero
+ */
+tb_void_t                           tb_database_sql_statement_cache_maxn_set(tb_database_sql_ref_t database, tb_size_t maxn);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
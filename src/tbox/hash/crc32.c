@@ -28,6 +28,48 @@
  * includes
  */
 #include "crc32.h"
+#include "../utils/bits.h"
+#include "../platform/atomic.h"
+#include "../platform/thread.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the table count of the slicing kernel
+#ifdef __tb_small__
+#   define TB_CRC32_SLICE_N             (8)
+#else
+#   define TB_CRC32_SLICE_N             (16)
+#endif
+
+// the crc32c (castagnoli) polynomial (reflected)
+#define TB_CRC32C_POLY                  (0x82f63b78)
+
+// the x86 kernels (sse4.2 and pclmulqdq) can be compiled? we will select them at runtime
+#if defined(TB_ARCH_SSE2) && \
+        (defined(TB_COMPILER_IS_CLANG) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9)))
+#   define TB_CRC32_HAVE_X86
+#   define __tb_crc32_sse42__           __attribute__((target("sse4.2")))
+#   define __tb_crc32_pclmul__          __attribute__((target("pclmul")))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#ifdef TB_CRC32_HAVE_X86
+#   include <cpuid.h>
+#   include <emmintrin.h>
+#   include <nmmintrin.h>
+#   include <wmmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the crc32 kernel type
+typedef tb_uint32_t (*tb_crc32_func_t)(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size);
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
@@ -136,6 +178,18 @@ tb_uint32_t const g_crc32_le_table[] =
 ,	0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
+// the once lock of the slicing tables and the kernels
+static tb_atomic_t          g_crc32_once = 0;
+
+// the slicing tables, table[k][i]: the crc of the byte i and the following k zero bytes
+static tb_uint32_t          g_crc32_slice_table[TB_CRC32_SLICE_N][256];
+static tb_uint32_t          g_crc32_le_slice_table[TB_CRC32_SLICE_N][256];
+static tb_uint32_t          g_crc32c_slice_table[TB_CRC32_SLICE_N][256];
+
+// the hardware kernels
+static tb_crc32_func_t      g_crc32_le_func = tb_null;
+static tb_crc32_func_t      g_crc32c_func = tb_null;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -153,6 +207,170 @@ static tb_uint32_t tb_crc32_make_impl(tb_uint32_t crc32, tb_byte_t const* data,
     // ok
     return crc32;
 }
+static tb_uint32_t tb_crc32_make_slice(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size, tb_uint32_t const (*table)[256])
+{
+    // make crc for each 8 or 16 bytes
+    while (size >= TB_CRC32_SLICE_N)
+    {
+        tb_uint32_t a = tb_bits_get_u32_le(data) ^ crc32;
+        tb_uint32_t b = tb_bits_get_u32_le(data + 4);
+#if TB_CRC32_SLICE_N == 16
+        tb_uint32_t c = tb_bits_get_u32_le(data + 8);
+        tb_uint32_t d = tb_bits_get_u32_le(data + 12);
+        crc32 = table[15][a & 0xff] ^ table[14][(a >> 8) & 0xff] ^ table[13][(a >> 16) & 0xff] ^ table[12][a >> 24]
+            ^   table[11][b & 0xff] ^ table[10][(b >> 8) & 0xff] ^ table[9][(b >> 16) & 0xff] ^ table[8][b >> 24]
+            ^   table[7][c & 0xff] ^ table[6][(c >> 8) & 0xff] ^ table[5][(c >> 16) & 0xff] ^ table[4][c >> 24]
+            ^   table[3][d & 0xff] ^ table[2][(d >> 8) & 0xff] ^ table[1][(d >> 16) & 0xff] ^ table[0][d >> 24];
+#else
+        crc32 = table[7][a & 0xff] ^ table[6][(a >> 8) & 0xff] ^ table[5][(a >> 16) & 0xff] ^ table[4][a >> 24]
+            ^   table[3][b & 0xff] ^ table[2][(b >> 8) & 0xff] ^ table[1][(b >> 16) & 0xff] ^ table[0][b >> 24];
+#endif
+        data += TB_CRC32_SLICE_N;
+        size -= TB_CRC32_SLICE_N;
+    }
+
+    // make crc for the left bytes
+    while (size--) crc32 = table[0][((tb_uint8_t)crc32) ^ *data++] ^ (crc32 >> 8);
+    return crc32;
+}
+static tb_void_t tb_crc32_make_slice_table(tb_uint32_t (*table)[256])
+{
+    // make the tables from the first table
+    tb_size_t i = 0;
+    tb_size_t k = 0;
+    for (k = 1; k < TB_CRC32_SLICE_N; k++)
+    {
+        for (i = 0; i < 256; i++)
+            table[k][i] = table[0][table[k - 1][i] & 0xff] ^ (table[k - 1][i] >> 8);
+    }
+}
+#ifdef TB_CRC32_HAVE_X86
+static __tb_crc32_sse42__ tb_uint32_t tb_crc32c_make_sse42(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // align the data address
+    for (; size && ((tb_size_t)data & 7); size--)
+        crc32 = _mm_crc32_u8(crc32, *data++);
+
+    // make crc for each 8 bytes
+#if TB_CPU_BIT64
+    tb_uint64_t crc64 = crc32;
+    for (; size >= 8; size -= 8, data += 8)
+        crc64 = _mm_crc32_u64(crc64, tb_bits_get_u64_ne(data));
+    crc32 = (tb_uint32_t)crc64;
+#else
+    for (; size >= 4; size -= 4, data += 4)
+        crc32 = _mm_crc32_u32(crc32, tb_bits_get_u32_ne(data));
+#endif
+
+    // make crc for the left bytes
+    while (size--) crc32 = _mm_crc32_u8(crc32, *data++);
+    return crc32;
+}
+
+/* make crc32 (IEEE LE) by folding with the carry-less multiplication
+ *
+ * the data size must be a multiple of 16 and larger than 64,
+ * see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" from intel
+ */
+static __tb_crc32_pclmul__ tb_uint32_t tb_crc32_le_make_pclmul(tb_uint32_t crc32, tb_byte_t const* data, tb_size_t size)
+{
+    // load the first 64 bytes and xor the crc value
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128((__m128i const*)data), _mm_cvtsi32_si128((tb_int_t)crc32));
+    __m128i x1 = _mm_loadu_si128((__m128i const*)(data + 16));
+    __m128i x2 = _mm_loadu_si128((__m128i const*)(data + 32));
+    __m128i x3 = _mm_loadu_si128((__m128i const*)(data + 48));
+    __m128i t0;
+    __m128i t1;
+    __m128i t2;
+    __m128i t3;
+    data += 64;
+    size -= 64;
+
+    // fold by 4 x 128 bits
+    __m128i k = _mm_set_epi64x(0x1c6e41596, 0x154442bd4);
+    for (; size >= 64; size -= 64, data += 64)
+    {
+        t0 = _mm_clmulepi64_si128(x0, k, 0x11);
+        t1 = _mm_clmulepi64_si128(x1, k, 0x11);
+        t2 = _mm_clmulepi64_si128(x2, k, 0x11);
+        t3 = _mm_clmulepi64_si128(x3, k, 0x11);
+        x0 = _mm_clmulepi64_si128(x0, k, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+        x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+        x3 = _mm_clmulepi64_si128(x3, k, 0x00);
+        x0 = _mm_xor_si128(_mm_xor_si128(x0, t0), _mm_loadu_si128((__m128i const*)data));
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, t1), _mm_loadu_si128((__m128i const*)(data + 16)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, t2), _mm_loadu_si128((__m128i const*)(data + 32)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, t3), _mm_loadu_si128((__m128i const*)(data + 48)));
+    }
+
+    // fold into 128 bits
+    k = _mm_set_epi64x(0x0ccaa009e, 0x1751997d0);
+    t0 = _mm_clmulepi64_si128(x0, k, 0x11);
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, k, 0x00), t0), x1);
+    t0 = _mm_clmulepi64_si128(x0, k, 0x11);
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, k, 0x00), t0), x2);
+    t0 = _mm_clmulepi64_si128(x0, k, 0x11);
+    x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, k, 0x00), t0), x3);
+
+    // fold the left 16 bytes blocks
+    for (; size >= 16; size -= 16, data += 16)
+    {
+        t0 = _mm_clmulepi64_si128(x0, k, 0x11);
+        x0 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x0, k, 0x00), t0), _mm_loadu_si128((__m128i const*)data));
+    }
+
+    // fold 128 bits into 64 bits
+    __m128i mask = _mm_set_epi32(0, 0, 0, -1);
+    x0 = _mm_xor_si128(_mm_srli_si128(x0, 8), _mm_clmulepi64_si128(k, x0, 0x01));
+    x0 = _mm_xor_si128(_mm_srli_si128(x0, 4), _mm_clmulepi64_si128(_mm_and_si128(x0, mask), _mm_set_epi64x(0, 0x163cd6124), 0x00));
+
+    // reduce 64 bits into 32 bits by the barrett reduction
+    k = _mm_set_epi64x(0x1f7011641, 0x1db710641);
+    x1 = _mm_and_si128(_mm_clmulepi64_si128(_mm_and_si128(x0, mask), k, 0x10), mask);
+    x0 = _mm_xor_si128(x0, _mm_clmulepi64_si128(x1, k, 0x00));
+    return (tb_uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(x0, 4));
+}
+#endif
+static tb_bool_t tb_crc32_init(tb_cpointer_t priv)
+{
+    // make the first table of crc32c
+    tb_size_t i = 0;
+    tb_size_t j = 0;
+    for (i = 0; i < 256; i++)
+    {
+        tb_uint32_t crc32 = (tb_uint32_t)i;
+        for (j = 0; j < 8; j++) crc32 = (crc32 & 1)? (crc32 >> 1) ^ TB_CRC32C_POLY : (crc32 >> 1);
+        g_crc32c_slice_table[0][i] = crc32;
+    }
+
+    // make the slicing tables
+    tb_memcpy_(g_crc32_slice_table[0], g_crc32_table, sizeof(g_crc32_slice_table[0]));
+    tb_memcpy_(g_crc32_le_slice_table[0], g_crc32_le_table, sizeof(g_crc32_le_slice_table[0]));
+    tb_crc32_make_slice_table(g_crc32_slice_table);
+    tb_crc32_make_slice_table(g_crc32_le_slice_table);
+    tb_crc32_make_slice_table(g_crc32c_slice_table);
+
+    // select the hardware kernels
+#ifdef TB_CRC32_HAVE_X86
+    tb_uint32_t eax = 0;
+    tb_uint32_t ebx = 0;
+    tb_uint32_t ecx = 0;
+    tb_uint32_t edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        if (ecx & (1 << 1)) g_crc32_le_func = tb_crc32_le_make_pclmul;
+        if (ecx & (1 << 20)) g_crc32c_func = tb_crc32c_make_sse42;
+    }
+#endif
+
+    // ok
+    return tb_true;
+}
+static __tb_inline__ tb_void_t tb_crc32_need(tb_noarg_t)
+{
+    if (tb_atomic_get(&g_crc32_once) != 2) tb_thread_once(&g_crc32_once, tb_crc32_init, tb_null);
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -163,6 +381,15 @@ tb_uint32_t tb_crc32_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t see
     // check
     tb_assert_and_check_return_val(data, 0);
 
+    // the small data? calculate it directly
+#if !defined(TB_ARCH_ARM) || defined(TB_ARCH_ARM64)
+    if (size >= TB_CRC32_SLICE_N)
+    {
+        tb_crc32_need();
+        return tb_crc32_make_slice(seed, data, size, g_crc32_slice_table);
+    }
+#endif
+
     // calculate it
     return tb_crc32_make_impl(seed, data, size, g_crc32_table);
 }
@@ -179,6 +406,24 @@ tb_uint32_t tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t
     // check
     tb_assert_and_check_return_val(data, 0);
 
+    // the small data? calculate it directly
+#if !defined(TB_ARCH_ARM) || defined(TB_ARCH_ARM64)
+    if (size >= TB_CRC32_SLICE_N)
+    {
+        tb_crc32_need();
+
+        // fold the 16 bytes blocks by the hardware kernel
+        if (g_crc32_le_func && size >= 128)
+        {
+            tb_size_t n = size & ~(tb_size_t)15;
+            seed = g_crc32_le_func(seed, data, n);
+            data += n;
+            size -= n;
+        }
+        return tb_crc32_make_slice(seed, data, size, g_crc32_le_slice_table);
+    }
+#endif
+
     // calculate it
     return tb_crc32_make_impl(seed, data, size, g_crc32_le_table);
 }
@@ -190,3 +435,22 @@ tb_uint32_t tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
     // make it
     return tb_crc32_le_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
 }
+tb_uint32_t tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(data, 0);
+
+    // init the tables and kernels
+    tb_crc32_need();
+
+    // calculate it
+    return g_crc32c_func? g_crc32c_func(seed, data, size) : tb_crc32_make_slice(seed, data, size, g_crc32c_slice_table);
+}
+tb_uint32_t tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed)
+{
+    // check
+    tb_assert_and_check_return_val(cstr, 0);
+
+    // make it
+    return tb_crc32c_make((tb_byte_t const*)cstr, tb_strlen(cstr) + 1, seed);
+}
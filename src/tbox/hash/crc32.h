@@ -85,6 +85,29 @@ tb_uint32_t         tb_crc32_le_make(tb_byte_t const* data, tb_size_t size, tb_u
  */
 tb_uint32_t         tb_crc32_le_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
 
+/*! make crc32c (castagnoli)
+ *
+ * uses the sse4.2 crc32 instruction if the cpu supports it
+ *
+ * @note the standard crc32c value is ~tb_crc32c_make(data, size, 0xffffffff)
+ *
+ * @param data      the input data
+ * @param size      the input size
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make(tb_byte_t const* data, tb_size_t size, tb_uint32_t seed);
+
+/*! make crc32c (castagnoli) for cstr
+ *
+ * @param cstr      the input cstr
+ * @param seed      uses this seed if be non-zero
+ *
+ * @return          the crc value
+ */
+tb_uint32_t         tb_crc32c_make_from_cstr(tb_char_t const* cstr, tb_uint32_t seed);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
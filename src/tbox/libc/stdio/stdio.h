@@ -154,19 +154,18 @@ tb_long_t           tb_wputs(tb_wchar_t const* string);
  *   - f/F:     Print a double in normal (fixed-point) notation. 
  *              'f' and 'F' only differs in how the strings for an infinite number or NaN are printed 
  *              ('inf', 'infinity' and 'nan' for 'f', 'INF', 'INFINITY' and 'NAN' for 'F').
- *   - g/G:     print a double in either normal or exponential notation, whichever is more appropriate for its magnitude. 
- *              'g' uses lower-case letters, 'G' uses upper-case letters. 
- *              This type differs slightly from fixed-point notation in 
- *              that insignificant zeroes to the right of the decimal point are not included. 
- *              Also, the decimal point is not included on whole numbers.
+ *   - g/G:     print a double in the shortest form which is parsed back to the same value, see tb_dtoa().
+ *              it uses the normal notation if the decimal exponent is in [-4, 16), otherwise the exponential notation.
+ *              'g' uses lower-case letters, 'G' uses upper-case letters, the precision is ignored.
+ *              e.g. 0.1, 100.0, 1.0e+22
  *   - c:       print a char (character).
  *   - s:       print a character string
  *   - p:       print a void * (pointer to void) in an implementation-defined format.
  *   - n:       print nothing, but write number of characters successfully written so far into an integer pointer parameter.
  *   - %:       %
  *
- * @note support        d, i, u, o, u, x/X, b/B, f/F, c, s
- * @note not support    e/E, g/G, p, n
+ * @note support        d, i, u, o, u, x/X, b/B, f/F, g/G, c, s
+ * @note not support    e/E, p, n
  *
  * @code
  * tb_printf("|hello world|\n");
@@ -183,6 +182,7 @@ tb_long_t           tb_wputs(tb_wchar_t const* string);
  * tb_printf("|%016.9f|\n", 3.14159);
  * tb_printf("|%lf|\n", 1.0 / 6.0);
  * tb_printf("|%lf|\n", 0.0003141596);
+ * tb_printf("|%lg|%g|%lg|\n", 0.1, 0.1f, 1e22);
  * tb_printf("|%F|\n", tb_float_to_fixed(3.1415));
  * tb_printf("|%{object_name}|\n", object);
  * @endcode
@@ -33,6 +33,7 @@
 #include "../../libm/libm.h"
 #include "../../utils/utils.h"
 #include "../string/string.h"
+#include "../stdlib/stdlib.h"
 #include "printf_object.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -64,6 +65,7 @@ typedef enum __tb_printf_extra_t
 ,   TB_PRINTF_EXTRA_UPPER           = 2     // upper case for %X %B
 ,   TB_PRINTF_EXTRA_PERCENT         = 4     // percent char: %
 ,   TB_PRINTF_EXTRA_EXP             = 8     // exponent form: [-]d.ddd e[+/-]ddd
+,   TB_PRINTF_EXTRA_SHORTEST        = 16    // the shortest round-trip form for %g %G
 
 }tb_printf_extra_t;
 
@@ -746,6 +748,55 @@ static tb_char_t* tb_printf_double(tb_char_t* pb, tb_char_t* pe, tb_printf_entry
 
     return pb;
 }
+static tb_char_t* tb_printf_shortest(tb_char_t* pb, tb_char_t* pe, tb_printf_entry_t e, tb_char_t const* data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(size, pb);
+
+    // sign: + -
+    tb_char_t sign = 0;
+    if (*data == '-')
+    {
+        sign = '-';
+        data++;
+        size--;
+    }
+    else if ((e.flags & TB_PRINTF_FLAG_PLUS) && *data != 'n') sign = '+';
+
+    // fill 0 after the sign? but inf and nan are padded with spaces, e.g. "    -inf"
+    tb_bool_t bzero = (e.flags & TB_PRINTF_FLAG_ZERO) && tb_isdigit10(*data);
+
+    // fill spaces at left side, e.g. "   0.1"
+    e.width -= (tb_int_t)(size + (sign? 1 : 0));
+    if (!(e.flags & TB_PRINTF_FLAG_LEFT) && !bzero)
+    {
+        while (--e.width >= 0)
+            if (pb < pe) *pb++ = ' ';
+    }
+
+    // append sign: + / -
+    if (sign && (pb < pe)) *pb++ = sign;
+
+    // fill 0, e.g. "00001.5"
+    if (!(e.flags & TB_PRINTF_FLAG_LEFT) && bzero)
+    {
+        while (--e.width >= 0)
+            if (pb < pe) *pb++ = '0';
+    }
+
+    // append digits
+    while (size--)
+    {
+        tb_char_t c = *data++;
+        if (pb < pe) *pb++ = (e.extra & TB_PRINTF_EXTRA_UPPER)? tb_toupper(c) : c;
+    }
+
+    // trailing space padding for left-justified flags, e.g. "0.1   "
+    while (--e.width >= 0)
+        if (pb < pe) *pb++ = ' ';
+
+    return pb;
+}
 #endif
 // get a printf format entry
 static tb_int_t tb_printf_entry(tb_char_t const* fmt, tb_printf_entry_t* e)
@@ -931,6 +982,13 @@ get_qualifier:
         e->extra |= TB_PRINTF_EXTRA_SIGNED;
         e->extra |= TB_PRINTF_EXTRA_EXP;
         break;
+    case 'G':
+        e->extra |= TB_PRINTF_EXTRA_UPPER;
+    case 'g':
+        e->type = TB_PRINTF_TYPE_FLOAT;
+        e->extra |= TB_PRINTF_EXTRA_SIGNED;
+        e->extra |= TB_PRINTF_EXTRA_SHORTEST;
+        break;
 #endif
     case '{':
         {
@@ -1086,8 +1144,15 @@ tb_long_t tb_vsnprintf(tb_char_t* s, tb_size_t n, tb_char_t const* fmt, tb_va_li
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
         case TB_PRINTF_TYPE_FLOAT:
             {
+                // the shortest round-trip form? the precision is ignored
+                if (e.extra & TB_PRINTF_EXTRA_SHORTEST)
+                {
+                    tb_char_t data[TB_DTOA_MAXN];
+                    tb_size_t size = (e.qual == TB_PRINTF_QUAL_L)? tb_dtoa(tb_va_arg(args, tb_double_t), data, sizeof(data)) : tb_ftoa((tb_float_t)tb_va_arg(args, tb_double_t), data, sizeof(data));
+                    pb = tb_printf_shortest(pb, pe, e, data, size);
+                }
                 // double?
-                if (e.qual == TB_PRINTF_QUAL_L)
+                else if (e.qual == TB_PRINTF_QUAL_L)
                 {
                     tb_double_t num = tb_va_arg(args, tb_double_t);
                     pb = tb_printf_double(pb, pe, e, num);
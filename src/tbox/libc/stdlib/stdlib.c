@@ -434,95 +434,6 @@ tb_double_t tb_s8tod(tb_char_t const* s)
     // merge 
     return (sign? ((tb_double_t)lhs + rhs) * -1. : ((tb_double_t)lhs + rhs));
 }
-tb_double_t tb_s10tod(tb_char_t const* s)
-{
-    // check
-    tb_assert_and_check_return_val(s, 0);
-
-    // skip space
-    while (tb_isspace(*s)) s++;
-
-    // has sign?
-    tb_int_t sign = 0;
-    if (*s == '-') 
-    {
-        sign = 1;
-        s++;
-    }
-    // skip '+'
-    else if (*s == '+') s++;
-
-    // nan?
-    if (s[0] == 'n' && s[1] == 'a' && s[2] == 'n')
-        return TB_NAN;
-
-    // inf or -inf?
-    if (s[0] == 'i' && s[1] == 'n' && s[2] == 'f')
-        return sign? -TB_INF : TB_INF;
-
-    // skip '0'
-    while ((*s) == '0') s++;
-
-    // compute double: lhs.rhs
-    tb_int_t    dec = 0;
-    tb_uint64_t lhs = 0;
-    tb_double_t rhs = 0.;
-    tb_int_t    zeros = 0;
-    tb_int8_t   decimals[256];
-    tb_int8_t*  d = decimals;
-    tb_int8_t*  e = decimals + 256;
-    while (*s)
-    {
-        tb_char_t ch = *s;
-
-        // is the part of decimal?
-        if (ch == '.')
-        {
-            if (!dec) 
-            {
-                dec = 1;
-                s++;
-                continue ;
-            }
-            else break;
-        }
-
-        // parse integer & decimal
-        if (tb_isdigit10(ch))
-        {
-            // save decimals
-            if (dec) 
-            {
-                if (d < e)
-                {
-                    if (ch != '0')
-                    {
-                        // fill '0'
-                        while (zeros--) *d++ = 0;
-                        zeros = 0;
-
-                        // save decimal
-                        *d++ = ch - '0';
-                    }
-                    else zeros++;
-                }
-            }
-            else lhs = lhs * 10 + (ch - '0');
-        }
-        else break;
-    
-        s++;
-    }
-
-    // check
-    tb_assert_and_check_return_val(d <= decimals + 256, 0);
-
-    // compute decimal
-    while (d-- > decimals) rhs = (rhs + *d) / 10;
-
-    // merge 
-    return (sign? ((tb_double_t)lhs + rhs) * -1. : ((tb_double_t)lhs + rhs));
-}
 tb_double_t tb_s16tod(tb_char_t const* s)
 {
     // check
@@ -674,9 +585,12 @@ tb_double_t tb_stod(tb_char_t const* s)
             return tb_s16tod(s);
         else if (*p == 'b' || *p == 'B')
             return tb_s2tod(s);
-        else return tb_s8tod(s);
+        else if (tb_isdigit8(*p))
+            return tb_s8tod(s);
     }
-    else return tb_s10tod(s);
+
+    // is decimal? e.g. 0.1, 0e10, 1.5
+    return tb_s10tod(s);
 }
 tb_double_t tb_sbtod(tb_char_t const* s, tb_int_t base)
 {
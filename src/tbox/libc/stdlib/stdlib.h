@@ -100,6 +100,9 @@ __tb_extern_c_enter__
 #define tb_rand()                   (tb_int_t)tb_random()
 #define tb_srand(seed)              tb_srandom(seed)
 
+// the maximum string size of tb_dtoa() and tb_ftoa(), e.g. "-1.2345678901234567e-308"
+#define TB_DTOA_MAXN                (32)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -218,7 +221,7 @@ tb_double_t         tb_s8tod(tb_char_t const* s);
 
 /*! convert the decimal string to double
  *
- * .e.g "9" => 9
+ * .e.g "9" => 9, "1.5e-07" => 0.00000015
  *
  * @param s         the string
  *
@@ -226,6 +229,19 @@ tb_double_t         tb_s8tod(tb_char_t const* s);
  */
 tb_double_t         tb_s10tod(tb_char_t const* s);
 
+/*! convert the decimal string with the given length to double
+ *
+ * the result is correctly rounded, and the string need not be terminated by '\0',
+ * .e.g parse "1.5" from the buffer "[1.5,2.5]" with n: 4
+ *
+ * @param s         the string
+ * @param n         the string length, (tb_size_t)-1 if it is terminated by '\0'
+ * @param pend      return the end of the parsed string if be not null, it is s if no number is parsed
+ *
+ * @return          the double number
+ */
+tb_double_t         tb_s10ntod(tb_char_t const* s, tb_size_t n, tb_char_t const** pend);
+
 /*! convert the hex string to double
  *
  * <pre>
@@ -249,6 +265,7 @@ tb_double_t         tb_s16tod(tb_char_t const* s);
  * "0b1001" => 9
  * "011"    => 9
  * "9"      => 9
+ * "0.5"    => 0.5
  * "0x9"    => 9
  * </pre>
  *
@@ -266,6 +283,39 @@ tb_double_t         tb_stod(tb_char_t const* s);
  */
 tb_double_t         tb_sbtod(tb_char_t const* s, tb_int_t base);
 
+/*! convert double to the shortest decimal string which is parsed back to the same double
+ *
+ * <pre>
+ * .e.g 
+ *
+ * 0.1      => "0.1"
+ * 100      => "100.0"
+ * 1e22     => "1.0e+22"
+ * 5e-324   => "5.0e-324"
+ * </pre>
+ *
+ * the string always contains '.' and uses the exponent notation if the decimal exponent is not in [-4, 16)
+ *
+ * @param value     the double number
+ * @param data      the string data
+ * @param maxn      the string maxn, TB_DTOA_MAXN is enough
+ *
+ * @return          the string size, zero if the data is too small
+ */
+tb_size_t           tb_dtoa(tb_double_t value, tb_char_t* data, tb_size_t maxn);
+
+/*! convert float to the shortest decimal string which is parsed back to the same float
+ *
+ * .e.g 0.1f => "0.1", not "0.100000001490116"
+ *
+ * @param value     the float number
+ * @param data      the string data
+ * @param maxn      the string maxn, TB_DTOA_MAXN is enough
+ *
+ * @return          the string size, zero if the data is too small
+ */
+tb_size_t           tb_ftoa(tb_float_t value, tb_char_t* data, tb_size_t maxn);
+
 #endif
 
 /*! mbstowcs, convert string to wstring
@@ -27,21 +27,24 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
-//#     define TB_LIBC_STRING_IMPL_MEMCMP
+#if defined(TB_ARCH_SSE2)
+#   define TB_LIBC_STRING_IMPL_MEMCMP
 #endif
 
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_ARCH_SSE2)
 static tb_long_t tb_memcmp_impl(tb_cpointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
-
+    tb_assert_and_check_return_val(s1 && s2, 0);
+    if (s1 == s2 || !n) return 0;
+    return tb_memcmp_simd((tb_byte_t const*)s1, (tb_byte_t const*)s2, n);
 }
 #endif
@@ -27,11 +27,13 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ARCH_SSE2) || \
+        (defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32)
 #   define TB_LIBC_STRING_IMPL_MEMCPY
 #endif
 
@@ -39,7 +41,14 @@
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#ifdef TB_ASSEMBLER_IS_GAS
+#if defined(TB_ARCH_SSE2)
+static tb_pointer_t tb_memcpy_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
+{
+    tb_assert_and_check_return_val(s1 && s2, tb_null);
+    tb_memcpy_simd((tb_byte_t*)s1, (tb_byte_t const*)s2, n);
+    return s1;
+}
+#elif defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
 static tb_pointer_t tb_memcpy_impl(tb_pointer_t s1, tb_cpointer_t s2, tb_size_t n)
 {
     tb_assert_and_check_return_val(s1 && s2, tb_null);
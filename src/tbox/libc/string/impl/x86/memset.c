@@ -27,9 +27,7 @@
  * includes
  */
 #include "prefix.h"
-#ifdef TB_ARCH_SSE2
-#   include <emmintrin.h>
-#endif
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -45,7 +43,7 @@
  * implementation
  */
 
-#if defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
+#if defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32 && !defined(TB_ARCH_SSE2)
 static __tb_inline__ tb_void_t tb_memset_impl_u8_opt_v1(tb_byte_t* s, tb_byte_t c, tb_size_t n)
 {
     tb_size_t edi;
@@ -73,45 +71,16 @@ static __tb_inline__ tb_void_t tb_memset_impl_u8_opt_v1(tb_byte_t* s, tb_byte_t
 }
 #endif
 
-#ifdef TB_ARCH_SSE2
-static __tb_inline__ tb_void_t tb_memset_impl_u8_opt_v2(tb_byte_t* s, tb_byte_t c, tb_size_t n)
-{
-    if (n >= 64) 
-    {
-        // aligned by 16-bytes
-        for (; ((tb_size_t)s) & 0x0f; --n) *s++ = c;
-
-        // l = n % 64
-        tb_size_t l = n & 0x3f; n = (n - l) >> 6;
-
-        // fill 4 x 16 bytes
-        __m128i*    d = (__m128i*)(s);
-        __m128i     v = _mm_set1_epi8(c);
-        while (n) 
-        {
-            _mm_store_si128(d++, v);
-            _mm_store_si128(d++, v);
-            _mm_store_si128(d++, v);
-            _mm_store_si128(d++, v);
-            --n;
-        }
-        s = (tb_byte_t*)(d);
-        n = l;
-    }
-    while (n--) *s++ = c;
-}
-#endif
-
 #ifdef TB_LIBC_STRING_IMPL_MEMSET_U8
 static tb_pointer_t tb_memset_impl(tb_pointer_t s, tb_byte_t c, tb_size_t n)
 {
     tb_assert_and_check_return_val(s, tb_null);
     if (!n) return s;
 
-#   if defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
+#   if defined(TB_ARCH_SSE2)
+    tb_memset_simd((tb_byte_t*)s, c, n);
+#   elif defined(TB_ASSEMBLER_IS_GAS) && TB_CPU_BIT32
     tb_memset_impl_u8_opt_v1(s, c, n);
-#   elif defined(TB_ARCH_SSE2)
-    tb_memset_impl_u8_opt_v2(s, c, n);
 #   else
 #       error
 #   endif
@@ -0,0 +1,760 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        simd.h
+ *
+ */
+#ifndef TB_LIBC_STRING_IMPL_x86_SIMD_H
+#define TB_LIBC_STRING_IMPL_x86_SIMD_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../../../../utils/bits.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+#ifdef TB_ARCH_SSE2
+
+/* the minimum size for the non-temporal stores
+ *
+ * the huge copies and fills will bypass the cache and do not evict the hot data
+ */
+#ifndef TB_LIBC_STRING_SIMD_NT_MINN
+#   define TB_LIBC_STRING_SIMD_NT_MINN          (1 << 22)
+#endif
+
+// the avx2 kernels can be compiled? we will select them at runtime if the cpu supports it
+#if defined(TB_ARCH_AVX2)
+#   define TB_LIBC_STRING_SIMD_AVX2
+#   define __tb_libc_string_avx2__
+#elif defined(TB_COMPILER_IS_CLANG) || (defined(TB_COMPILER_IS_GCC) && TB_COMPILER_VERSION_BE(4, 9))
+#   define TB_LIBC_STRING_SIMD_AVX2
+#   define __tb_libc_string_avx2__              __attribute__((target("avx2")))
+#elif defined(TB_COMPILER_IS_MSVC) && TB_COMPILER_VERSION_BE(18, 0)
+#   define TB_LIBC_STRING_SIMD_AVX2
+#   define __tb_libc_string_avx2__
+#endif
+
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+#   include <immintrin.h>
+#   if defined(TB_COMPILER_IS_MSVC)
+#       include <intrin.h>
+#   elif !defined(TB_ARCH_AVX2)
+#       include <cpuid.h>
+#   endif
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the memcpy kernel type
+typedef tb_void_t   (*tb_memcpy_simd_func_t)(tb_byte_t* d, tb_byte_t const* s, tb_size_t n);
+
+// the memset kernel type
+typedef tb_void_t   (*tb_memset_simd_func_t)(tb_byte_t* d, tb_byte_t c, tb_size_t n);
+
+// the memcmp kernel type
+typedef tb_long_t   (*tb_memcmp_simd_func_t)(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n);
+
+// the strlen kernel type
+typedef tb_size_t   (*tb_strlen_simd_func_t)(tb_char_t const* s);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * cpu
+ */
+
+// the cpu and os support avx2?
+static __tb_inline__ tb_bool_t tb_libc_string_simd_avx2(tb_noarg_t)
+{
+#if defined(TB_ARCH_AVX2)
+    return tb_true;
+#elif defined(TB_LIBC_STRING_SIMD_AVX2)
+    tb_uint32_t ebx = 0;
+    tb_uint32_t ecx = 0;
+    tb_uint64_t xcr0 = 0;
+#   ifdef TB_COMPILER_IS_MSVC
+    tb_int_t info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return tb_false;
+    __cpuid(info, 1);
+    ecx = (tb_uint32_t)info[2];
+#   else
+    tb_uint32_t eax = 0;
+    tb_uint32_t edx = 0;
+    if (__get_cpuid_max(0, tb_null) < 7) return tb_false;
+    __cpuid(1, eax, ebx, ecx, edx);
+#   endif
+
+    // the os has enabled xsave and the cpu supports avx?
+    if ((ecx & ((1 << 27) | (1 << 28))) != ((1 << 27) | (1 << 28))) return tb_false;
+
+    // the os will save the xmm and ymm registers?
+#   ifdef TB_COMPILER_IS_MSVC
+    xcr0 = _xgetbv(0);
+#   else
+    {
+        tb_uint32_t lo = 0;
+        tb_uint32_t hi = 0;
+        __tb_asm__ __tb_volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        xcr0 = ((tb_uint64_t)hi << 32) | lo;
+    }
+#   endif
+    if ((xcr0 & 0x6) != 0x6) return tb_false;
+
+    // the cpu supports avx2?
+#   ifdef TB_COMPILER_IS_MSVC
+    __cpuidex(info, 7, 0);
+    ebx = (tb_uint32_t)info[1];
+#   else
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#   endif
+    return (ebx & (1 << 5))? tb_true : tb_false;
+#else
+    return tb_false;
+#endif
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * memcpy
+ */
+
+// copy 0 ~ 32 bytes with the overlapped loads and stores
+static __tb_inline_force__ tb_void_t tb_memcpy_simd_small(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    if (n >= 16)
+    {
+        __m128i a = _mm_loadu_si128((__m128i const*)s);
+        __m128i b = _mm_loadu_si128((__m128i const*)(s + n - 16));
+        _mm_storeu_si128((__m128i*)d, a);
+        _mm_storeu_si128((__m128i*)(d + n - 16), b);
+    }
+    else if (n >= 8)
+    {
+        __m128i a = _mm_loadl_epi64((__m128i const*)s);
+        __m128i b = _mm_loadl_epi64((__m128i const*)(s + n - 8));
+        _mm_storel_epi64((__m128i*)d, a);
+        _mm_storel_epi64((__m128i*)(d + n - 8), b);
+    }
+    else if (n >= 4)
+    {
+        tb_uint32_t a = tb_bits_get_u32_ne(s);
+        tb_uint32_t b = tb_bits_get_u32_ne(s + n - 4);
+        tb_bits_set_u32_ne(d, a);
+        tb_bits_set_u32_ne(d + n - 4, b);
+    }
+    else if (n)
+    {
+        tb_byte_t a = s[0];
+        tb_byte_t b = s[n >> 1];
+        tb_byte_t c = s[n - 1];
+        d[0]        = a;
+        d[n >> 1]   = b;
+        d[n - 1]    = c;
+    }
+}
+static __tb_inline__ tb_void_t tb_memcpy_simd_sse2(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // small?
+    if (n <= 32)
+    {
+        tb_memcpy_simd_small(d, s, n);
+        return ;
+    }
+
+    // save the unaligned head and tail, we will write them at last
+    __m128i     head = _mm_loadu_si128((__m128i const*)s);
+    __m128i     tail = _mm_loadu_si128((__m128i const*)(s + n - 16));
+    tb_byte_t*  e = d + n - 16;
+    tb_byte_t*  p = d;
+
+    // align the destination by 16-bytes
+    tb_size_t skip = 16 - ((tb_size_t)p & 15);
+    p += skip; s += skip; n -= skip;
+
+    // copy 4 x 16 bytes
+    if (n >= TB_LIBC_STRING_SIMD_NT_MINN)
+    {
+        for (; n > 64; n -= 64, p += 64, s += 64)
+        {
+            __m128i a0 = _mm_loadu_si128((__m128i const*)s);
+            __m128i a1 = _mm_loadu_si128((__m128i const*)(s + 16));
+            __m128i a2 = _mm_loadu_si128((__m128i const*)(s + 32));
+            __m128i a3 = _mm_loadu_si128((__m128i const*)(s + 48));
+            _mm_stream_si128((__m128i*)p, a0);
+            _mm_stream_si128((__m128i*)(p + 16), a1);
+            _mm_stream_si128((__m128i*)(p + 32), a2);
+            _mm_stream_si128((__m128i*)(p + 48), a3);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 64; n -= 64, p += 64, s += 64)
+        {
+            __m128i a0 = _mm_loadu_si128((__m128i const*)s);
+            __m128i a1 = _mm_loadu_si128((__m128i const*)(s + 16));
+            __m128i a2 = _mm_loadu_si128((__m128i const*)(s + 32));
+            __m128i a3 = _mm_loadu_si128((__m128i const*)(s + 48));
+            _mm_store_si128((__m128i*)p, a0);
+            _mm_store_si128((__m128i*)(p + 16), a1);
+            _mm_store_si128((__m128i*)(p + 32), a2);
+            _mm_store_si128((__m128i*)(p + 48), a3);
+        }
+    }
+
+    // copy the left 16 bytes blocks
+    for (; n > 16; n -= 16, p += 16, s += 16)
+        _mm_store_si128((__m128i*)p, _mm_loadu_si128((__m128i const*)s));
+
+    // write the head and tail
+    _mm_storeu_si128((__m128i*)e, tail);
+    _mm_storeu_si128((__m128i*)d, head);
+}
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static __tb_inline__ __tb_libc_string_avx2__ tb_void_t tb_memcpy_simd_avx2(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // small?
+    if (n <= 32)
+    {
+        tb_memcpy_simd_small(d, s, n);
+        return ;
+    }
+    else if (n <= 64)
+    {
+        __m256i a = _mm256_loadu_si256((__m256i const*)s);
+        __m256i b = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+        _mm256_storeu_si256((__m256i*)d, a);
+        _mm256_storeu_si256((__m256i*)(d + n - 32), b);
+        return ;
+    }
+
+    // save the unaligned head and tail, we will write them at last
+    __m256i     head = _mm256_loadu_si256((__m256i const*)s);
+    __m256i     tail = _mm256_loadu_si256((__m256i const*)(s + n - 32));
+    tb_byte_t*  e = d + n - 32;
+    tb_byte_t*  p = d;
+
+    // align the destination by 32-bytes
+    tb_size_t skip = 32 - ((tb_size_t)p & 31);
+    p += skip; s += skip; n -= skip;
+
+    // copy 4 x 32 bytes
+    if (n >= TB_LIBC_STRING_SIMD_NT_MINN)
+    {
+        for (; n > 128; n -= 128, p += 128, s += 128)
+        {
+            __m256i a0 = _mm256_loadu_si256((__m256i const*)s);
+            __m256i a1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+            __m256i a2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+            __m256i a3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+            _mm256_stream_si256((__m256i*)p, a0);
+            _mm256_stream_si256((__m256i*)(p + 32), a1);
+            _mm256_stream_si256((__m256i*)(p + 64), a2);
+            _mm256_stream_si256((__m256i*)(p + 96), a3);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 128; n -= 128, p += 128, s += 128)
+        {
+            __m256i a0 = _mm256_loadu_si256((__m256i const*)s);
+            __m256i a1 = _mm256_loadu_si256((__m256i const*)(s + 32));
+            __m256i a2 = _mm256_loadu_si256((__m256i const*)(s + 64));
+            __m256i a3 = _mm256_loadu_si256((__m256i const*)(s + 96));
+            _mm256_store_si256((__m256i*)p, a0);
+            _mm256_store_si256((__m256i*)(p + 32), a1);
+            _mm256_store_si256((__m256i*)(p + 64), a2);
+            _mm256_store_si256((__m256i*)(p + 96), a3);
+        }
+    }
+
+    // copy the left 32 bytes blocks
+    for (; n > 32; n -= 32, p += 32, s += 32)
+        _mm256_store_si256((__m256i*)p, _mm256_loadu_si256((__m256i const*)s));
+
+    // write the head and tail
+    _mm256_storeu_si256((__m256i*)e, tail);
+    _mm256_storeu_si256((__m256i*)d, head);
+}
+#endif
+static __tb_inline__ tb_void_t tb_memcpy_simd(tb_byte_t* d, tb_byte_t const* s, tb_size_t n)
+{
+    // small? copy it directly
+    if (n <= 32)
+    {
+        tb_memcpy_simd_small(d, s, n);
+        return ;
+    }
+
+    // select the kernel at the first time
+    static tb_memcpy_simd_func_t s_func = tb_null;
+    if (!s_func)
+    {
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+        s_func = tb_libc_string_simd_avx2()? tb_memcpy_simd_avx2 : tb_memcpy_simd_sse2;
+#else
+        s_func = tb_memcpy_simd_sse2;
+#endif
+    }
+    s_func(d, s, n);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * memset
+ */
+
+// fill 0 ~ 32 bytes with the overlapped stores
+static __tb_inline_force__ tb_void_t tb_memset_simd_small(tb_byte_t* d, tb_byte_t c, tb_size_t n)
+{
+    if (n >= 16)
+    {
+        __m128i v = _mm_set1_epi8((tb_char_t)c);
+        _mm_storeu_si128((__m128i*)d, v);
+        _mm_storeu_si128((__m128i*)(d + n - 16), v);
+    }
+    else if (n >= 8)
+    {
+        tb_uint64_t v = (tb_uint64_t)c * 0x0101010101010101ULL;
+        tb_bits_set_u64_ne(d, v);
+        tb_bits_set_u64_ne(d + n - 8, v);
+    }
+    else if (n >= 4)
+    {
+        tb_uint32_t v = (tb_uint32_t)c * 0x01010101;
+        tb_bits_set_u32_ne(d, v);
+        tb_bits_set_u32_ne(d + n - 4, v);
+    }
+    else if (n)
+    {
+        d[0]        = c;
+        d[n >> 1]   = c;
+        d[n - 1]    = c;
+    }
+}
+static __tb_inline__ tb_void_t tb_memset_simd_sse2(tb_byte_t* d, tb_byte_t c, tb_size_t n)
+{
+    // small?
+    if (n <= 32)
+    {
+        tb_memset_simd_small(d, c, n);
+        return ;
+    }
+
+    // fill the unaligned head and tail
+    __m128i v = _mm_set1_epi8((tb_char_t)c);
+    _mm_storeu_si128((__m128i*)d, v);
+    _mm_storeu_si128((__m128i*)(d + n - 16), v);
+
+    // align the destination by 16-bytes
+    tb_byte_t*  p = d;
+    tb_size_t   skip = 16 - ((tb_size_t)p & 15);
+    p += skip; n -= skip;
+
+    // fill 4 x 16 bytes
+    if (n >= TB_LIBC_STRING_SIMD_NT_MINN)
+    {
+        for (; n > 64; n -= 64, p += 64)
+        {
+            _mm_stream_si128((__m128i*)p, v);
+            _mm_stream_si128((__m128i*)(p + 16), v);
+            _mm_stream_si128((__m128i*)(p + 32), v);
+            _mm_stream_si128((__m128i*)(p + 48), v);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 64; n -= 64, p += 64)
+        {
+            _mm_store_si128((__m128i*)p, v);
+            _mm_store_si128((__m128i*)(p + 16), v);
+            _mm_store_si128((__m128i*)(p + 32), v);
+            _mm_store_si128((__m128i*)(p + 48), v);
+        }
+    }
+
+    // fill the left 16 bytes blocks, the tail has been filled
+    for (; n > 16; n -= 16, p += 16)
+        _mm_store_si128((__m128i*)p, v);
+}
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static __tb_inline__ __tb_libc_string_avx2__ tb_void_t tb_memset_simd_avx2(tb_byte_t* d, tb_byte_t c, tb_size_t n)
+{
+    // small?
+    if (n <= 32)
+    {
+        tb_memset_simd_small(d, c, n);
+        return ;
+    }
+
+    // fill the unaligned head and tail
+    __m256i v = _mm256_set1_epi8((tb_char_t)c);
+    _mm256_storeu_si256((__m256i*)d, v);
+    _mm256_storeu_si256((__m256i*)(d + n - 32), v);
+    if (n <= 64) return ;
+
+    // align the destination by 32-bytes
+    tb_byte_t*  p = d;
+    tb_size_t   skip = 32 - ((tb_size_t)p & 31);
+    p += skip; n -= skip;
+
+    // fill 4 x 32 bytes
+    if (n >= TB_LIBC_STRING_SIMD_NT_MINN)
+    {
+        for (; n > 128; n -= 128, p += 128)
+        {
+            _mm256_stream_si256((__m256i*)p, v);
+            _mm256_stream_si256((__m256i*)(p + 32), v);
+            _mm256_stream_si256((__m256i*)(p + 64), v);
+            _mm256_stream_si256((__m256i*)(p + 96), v);
+        }
+        _mm_sfence();
+    }
+    else
+    {
+        for (; n > 128; n -= 128, p += 128)
+        {
+            _mm256_store_si256((__m256i*)p, v);
+            _mm256_store_si256((__m256i*)(p + 32), v);
+            _mm256_store_si256((__m256i*)(p + 64), v);
+            _mm256_store_si256((__m256i*)(p + 96), v);
+        }
+    }
+
+    // fill the left 32 bytes blocks, the tail has been filled
+    for (; n > 32; n -= 32, p += 32)
+        _mm256_store_si256((__m256i*)p, v);
+}
+#endif
+static __tb_inline__ tb_void_t tb_memset_simd(tb_byte_t* d, tb_byte_t c, tb_size_t n)
+{
+    // small? fill it directly
+    if (n <= 32)
+    {
+        tb_memset_simd_small(d, c, n);
+        return ;
+    }
+
+    // select the kernel at the first time
+    static tb_memset_simd_func_t s_func = tb_null;
+    if (!s_func)
+    {
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+        s_func = tb_libc_string_simd_avx2()? tb_memset_simd_avx2 : tb_memset_simd_sse2;
+#else
+        s_func = tb_memset_simd_sse2;
+#endif
+    }
+    s_func(d, c, n);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * memcmp
+ */
+
+// compare 0 ~ 31 bytes
+static __tb_inline_force__ tb_long_t tb_memcmp_simd_small(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    if (n >= 16)
+    {
+        // compare the head and the overlapped tail
+        tb_uint32_t m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p1), _mm_loadu_si128((__m128i const*)p2))) ^ 0xffff;
+        if (!m)
+        {
+            p1 += n - 16;
+            p2 += n - 16;
+            m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p1), _mm_loadu_si128((__m128i const*)p2))) ^ 0xffff;
+            if (!m) return 0;
+        }
+        m = (tb_uint32_t)tb_bits_cl0_u32_le(m);
+        return (tb_long_t)p1[m] - p2[m];
+    }
+    else if (n >= 8)
+    {
+        // compare the head and the overlapped tail
+        tb_uint64_t x = tb_bits_get_u64_ne(p1) ^ tb_bits_get_u64_ne(p2);
+        if (!x)
+        {
+            p1 += n - 8;
+            p2 += n - 8;
+            x = tb_bits_get_u64_ne(p1) ^ tb_bits_get_u64_ne(p2);
+            if (!x) return 0;
+        }
+        x = tb_bits_cl0_u64_le(x) >> 3;
+        return (tb_long_t)p1[x] - p2[x];
+    }
+    else
+    {
+        tb_long_t r = 0;
+        while (n-- && ((r = ((tb_long_t)(*p1++)) - *p2++) == 0)) ;
+        return r;
+    }
+}
+// get the different byte from the block mask
+static __tb_inline_force__ tb_long_t tb_memcmp_simd_diff(tb_byte_t const* p1, tb_byte_t const* p2, tb_uint32_t m)
+{
+    m = (tb_uint32_t)tb_bits_cl0_u32_le(~m);
+    return (tb_long_t)p1[m] - p2[m];
+}
+static __tb_inline__ tb_long_t tb_memcmp_simd_sse2(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // small?
+    if (n < 32) return tb_memcmp_simd_small(p1, p2, n);
+
+    // compare 4 x 16 bytes
+    tb_uint32_t         m = 0;
+    tb_byte_t const*    e = p1 + n;
+    for (; p1 + 64 <= e; p1 += 64, p2 += 64)
+    {
+        __m128i a0 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p1), _mm_loadu_si128((__m128i const*)p2));
+        __m128i a1 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + 16)), _mm_loadu_si128((__m128i const*)(p2 + 16)));
+        __m128i a2 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + 32)), _mm_loadu_si128((__m128i const*)(p2 + 32)));
+        __m128i a3 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(p1 + 48)), _mm_loadu_si128((__m128i const*)(p2 + 48)));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(a0, a1), _mm_and_si128(a2, a3))) != 0xffff)
+        {
+            if ((m = _mm_movemask_epi8(a0) | 0xffff0000) != 0xffffffff) return tb_memcmp_simd_diff(p1, p2, m);
+            if ((m = _mm_movemask_epi8(a1) | 0xffff0000) != 0xffffffff) return tb_memcmp_simd_diff(p1 + 16, p2 + 16, m);
+            if ((m = _mm_movemask_epi8(a2) | 0xffff0000) != 0xffffffff) return tb_memcmp_simd_diff(p1 + 32, p2 + 32, m);
+            return tb_memcmp_simd_diff(p1 + 48, p2 + 48, _mm_movemask_epi8(a3) | 0xffff0000);
+        }
+    }
+
+    // compare the left bytes with the overlapped 16 bytes blocks
+    while (p1 < e)
+    {
+        if (p1 + 16 > e)
+        {
+            p2 -= p1 + 16 - e;
+            p1 = e - 16;
+        }
+        m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)p1), _mm_loadu_si128((__m128i const*)p2))) | 0xffff0000;
+        if (m != 0xffffffff) return tb_memcmp_simd_diff(p1, p2, m);
+        p1 += 16;
+        p2 += 16;
+    }
+    return 0;
+}
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static __tb_inline__ __tb_libc_string_avx2__ tb_long_t tb_memcmp_simd_avx2(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // small?
+    if (n < 32) return tb_memcmp_simd_small(p1, p2, n);
+
+    // compare 4 x 32 bytes
+    tb_uint32_t         m = 0;
+    tb_byte_t const*    e = p1 + n;
+    for (; p1 + 128 <= e; p1 += 128, p2 += 128)
+    {
+        __m256i a0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)p1), _mm256_loadu_si256((__m256i const*)p2));
+        __m256i a1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + 32)), _mm256_loadu_si256((__m256i const*)(p2 + 32)));
+        __m256i a2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + 64)), _mm256_loadu_si256((__m256i const*)(p2 + 64)));
+        __m256i a3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(p1 + 96)), _mm256_loadu_si256((__m256i const*)(p2 + 96)));
+        if ((tb_uint32_t)_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(a0, a1), _mm256_and_si256(a2, a3))) != 0xffffffff)
+        {
+            if ((m = (tb_uint32_t)_mm256_movemask_epi8(a0)) != 0xffffffff) return tb_memcmp_simd_diff(p1, p2, m);
+            if ((m = (tb_uint32_t)_mm256_movemask_epi8(a1)) != 0xffffffff) return tb_memcmp_simd_diff(p1 + 32, p2 + 32, m);
+            if ((m = (tb_uint32_t)_mm256_movemask_epi8(a2)) != 0xffffffff) return tb_memcmp_simd_diff(p1 + 64, p2 + 64, m);
+            return tb_memcmp_simd_diff(p1 + 96, p2 + 96, (tb_uint32_t)_mm256_movemask_epi8(a3));
+        }
+    }
+
+    // compare the left bytes with the overlapped 32 bytes blocks
+    while (p1 < e)
+    {
+        if (p1 + 32 > e)
+        {
+            p2 -= p1 + 32 - e;
+            p1 = e - 32;
+        }
+        m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)p1), _mm256_loadu_si256((__m256i const*)p2)));
+        if (m != 0xffffffff) return tb_memcmp_simd_diff(p1, p2, m);
+        p1 += 32;
+        p2 += 32;
+    }
+    return 0;
+}
+#endif
+static __tb_inline__ tb_long_t tb_memcmp_simd(tb_byte_t const* p1, tb_byte_t const* p2, tb_size_t n)
+{
+    // small? compare it directly
+    if (n < 32) return tb_memcmp_simd_small(p1, p2, n);
+
+    // select the kernel at the first time
+    static tb_memcmp_simd_func_t s_func = tb_null;
+    if (!s_func)
+    {
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+        s_func = tb_libc_string_simd_avx2()? tb_memcmp_simd_avx2 : tb_memcmp_simd_sse2;
+#else
+        s_func = tb_memcmp_simd_sse2;
+#endif
+    }
+    return s_func(p1, p2, n);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * strlen
+ *
+ * we only load the aligned blocks, so it will never cross the page boundary
+ */
+static __tb_inline__ tb_size_t tb_strlen_simd_sse2(tb_char_t const* s)
+{
+    // find 0 in the first aligned block
+    __m128i             z = _mm_setzero_si128();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)15);
+    tb_uint32_t         m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), z)) >> (s - p);
+    if (m) return tb_bits_cl0_u32_le(m);
+
+    // align the address by 64-bytes
+    for (p += 16; (tb_size_t)p & 63; p += 16)
+    {
+        m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), z));
+        if (m) return p - s + tb_bits_cl0_u32_le(m);
+    }
+
+    // find 0 in 4 x 16 bytes
+    while (1)
+    {
+        __m128i a0 = _mm_load_si128((__m128i const*)p);
+        __m128i a1 = _mm_load_si128((__m128i const*)(p + 16));
+        __m128i a2 = _mm_load_si128((__m128i const*)(p + 32));
+        __m128i a3 = _mm_load_si128((__m128i const*)(p + 48));
+        __m128i a = _mm_min_epu8(_mm_min_epu8(a0, a1), _mm_min_epu8(a2, a3));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, z))) break;
+        p += 64;
+    }
+
+    // get the position of 0
+    for (;; p += 16)
+    {
+        m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), z));
+        if (m) return p - s + tb_bits_cl0_u32_le(m);
+    }
+    return 0;
+}
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+static __tb_inline__ __tb_libc_string_avx2__ tb_size_t tb_strlen_simd_avx2(tb_char_t const* s)
+{
+    // find 0 in the first aligned block
+    __m256i             z = _mm256_setzero_si256();
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)31);
+    tb_uint32_t         m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), z)) >> (s - p);
+    if (m) return tb_bits_cl0_u32_le(m);
+
+    // align the address by 128-bytes
+    for (p += 32; (tb_size_t)p & 127; p += 32)
+    {
+        m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), z));
+        if (m) return p - s + tb_bits_cl0_u32_le(m);
+    }
+
+    // find 0 in 4 x 32 bytes
+    while (1)
+    {
+        __m256i a0 = _mm256_load_si256((__m256i const*)p);
+        __m256i a1 = _mm256_load_si256((__m256i const*)(p + 32));
+        __m256i a2 = _mm256_load_si256((__m256i const*)(p + 64));
+        __m256i a3 = _mm256_load_si256((__m256i const*)(p + 96));
+        __m256i a = _mm256_min_epu8(_mm256_min_epu8(a0, a1), _mm256_min_epu8(a2, a3));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, z))) break;
+        p += 128;
+    }
+
+    // get the position of 0
+    for (;; p += 32)
+    {
+        m = (tb_uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((__m256i const*)p), z));
+        if (m) return p - s + tb_bits_cl0_u32_le(m);
+    }
+    return 0;
+}
+#endif
+static __tb_inline__ tb_size_t tb_strlen_simd(tb_char_t const* s)
+{
+    // find 0 in the first aligned block directly, most strings are short
+    tb_char_t const*    p = (tb_char_t const*)((tb_size_t)s & ~(tb_size_t)15);
+    tb_uint32_t         m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((__m128i const*)p), _mm_setzero_si128())) >> (s - p);
+    if (m) return tb_bits_cl0_u32_le(m);
+
+    // select the kernel at the first time
+    static tb_strlen_simd_func_t s_func = tb_null;
+    if (!s_func)
+    {
+#ifdef TB_LIBC_STRING_SIMD_AVX2
+        s_func = tb_libc_string_simd_avx2()? tb_strlen_simd_avx2 : tb_strlen_simd_sse2;
+#else
+        s_func = tb_strlen_simd_sse2;
+#endif
+    }
+    return s_func(s);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * strcmp
+ *
+ * only sse2, the compared strings are usually short
+ */
+static __tb_inline__ tb_long_t tb_strcmp_simd(tb_char_t const* s1, tb_char_t const* s2)
+{
+    tb_uint32_t         m = 0;
+    __m128i             z = _mm_setzero_si128();
+    tb_byte_t const*    p1 = (tb_byte_t const*)s1;
+    tb_byte_t const*    p2 = (tb_byte_t const*)s2;
+    while (1)
+    {
+        // the 16 bytes blocks before the next page boundary, we cannot load data across it
+        tb_size_t l1 = 4096 - ((tb_size_t)p1 & 4095);
+        tb_size_t l2 = 4096 - ((tb_size_t)p2 & 4095);
+        tb_size_t l = tb_min(l1, l2);
+        tb_size_t n = l >> 4;
+
+        // compare the 16 bytes blocks, a == b ? a : 0, and find the first 0
+        for (; n; n--, p1 += 16, p2 += 16)
+        {
+            __m128i a = _mm_loadu_si128((__m128i const*)p1);
+            __m128i b = _mm_loadu_si128((__m128i const*)p2);
+            m = (tb_uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, b), a), z));
+            if (m)
+            {
+                m = (tb_uint32_t)tb_bits_cl0_u32_le(m);
+                return (tb_long_t)p1[m] - p2[m];
+            }
+        }
+
+        // compare the left bytes before the page boundary
+        for (n = l & 15; n; n--, p1++, p2++)
+        {
+            tb_long_t r = (tb_long_t)*p1 - *p2;
+            if (r || !*p1) return r;
+        }
+    }
+    return 0;
+}
+#endif
+#endif
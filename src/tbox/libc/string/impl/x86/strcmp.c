@@ -27,18 +27,26 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
-//#     define TB_LIBC_STRING_IMPL_STRCMP
+#if defined(TB_ARCH_SSE2)
+#   define TB_LIBC_STRING_IMPL_STRCMP
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_ARCH_SSE2)
+static tb_long_t tb_strcmp_impl(tb_char_t const* s1, tb_char_t const* s2)
+{
+    tb_assert_and_check_return_val(s1 && s2, 0);
+    if (s1 == s2) return 0;
+    return tb_strcmp_simd(s1, s2);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_long_t tb_strcmp_impl(tb_char_t const* s1, tb_char_t const* s2)
 {
     tb_assert_and_check_return_val(s1 && s2, 0);
@@ -27,18 +27,25 @@
  * includes
  */
 #include "prefix.h"
+#include "simd.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
-#ifdef TB_ASSEMBLER_IS_GAS
-//#     define TB_LIBC_STRING_IMPL_STRLEN
+#if defined(TB_ARCH_SSE2)
+#   define TB_LIBC_STRING_IMPL_STRLEN
 #endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-#if 0//def TB_ASSEMBLER_IS_GAS
+#if defined(TB_ARCH_SSE2)
+static tb_size_t tb_strlen_impl(tb_char_t const* s)
+{
+    tb_assert_and_check_return_val(s, 0);
+    return tb_strlen_simd(s);
+}
+#elif 0//def TB_ASSEMBLER_IS_GAS
 static tb_size_t tb_strlen_impl(tb_char_t const* s)
 {
     tb_assert_and_check_return_val(s, 0);
@@ -32,6 +32,8 @@
 #ifndef TB_CONFIG_LIBC_HAVE_MEMCMP
 #   if defined(TB_ARCH_x86)
 #       include "impl/x86/memcmp.c"
+#   elif defined(TB_ARCH_x64)
+#       include "impl/x86/memcmp.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/memcmp.c"
 #   elif defined(TB_ARCH_SH4)
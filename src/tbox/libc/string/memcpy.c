@@ -32,6 +32,8 @@
 #ifndef TB_CONFIG_LIBC_HAVE_MEMCPY
 #   if defined(TB_ARCH_x86)
 #       include "impl/x86/memcpy.c"
+#   elif defined(TB_ARCH_x64)
+#       include "impl/x86/memcpy.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/memcpy.c"
 #   elif defined(TB_ARCH_SH4)
@@ -31,6 +31,8 @@
 #ifndef TB_CONFIG_LIBC_HAVE_STRCMP
 #   if defined(TB_ARCH_x86)
 #       include "impl/x86/strcmp.c"
+#   elif defined(TB_ARCH_x64)
+#       include "impl/x86/strcmp.c"
 #   elif defined(TB_ARCH_ARM)
 #       include "impl/arm/strcmp.c"
 #   elif defined(TB_ARCH_SH4)
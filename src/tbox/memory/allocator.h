@@ -83,12 +83,23 @@ typedef enum __tb_allocator_type_e
 
 }tb_allocator_type_e;
 
+/// the allocator flag enum
+typedef enum __tb_allocator_flag_e
+{
+    TB_ALLOCATOR_FLAG_NONE      = 0
+,   TB_ALLOCATOR_FLAG_NOLOCK    = 1     //!< the allocator is thread-safe and manages its lock internally
+
+}tb_allocator_flag_e;
+
 /// the allocator type
 typedef struct __tb_allocator_t
 {
     /// the type
     tb_size_t               type;
 
+    /// the flag
+    tb_size_t               flag;
+
     /// the lock
     tb_spinlock_t           lock;
 
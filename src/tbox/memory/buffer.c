@@ -65,8 +65,8 @@ tb_void_t tb_buffer_exit(tb_buffer_ref_t buffer)
     // clear it
     tb_buffer_clear(buffer);
 
-    // exit data
-    if (buffer->data && buffer->data != buffer->buff) tb_free(buffer->data);
+    // exit data, the readonly data refered by the buffer is not owned
+    if (buffer->data && buffer->data != buffer->buff && buffer->maxn) tb_free(buffer->data);
     buffer->data = buffer->buff;
 
     // exit size
@@ -104,6 +104,13 @@ tb_void_t tb_buffer_clear(tb_buffer_ref_t buffer)
 
     // clear it
     buffer->size = 0;
+
+    // detach the readonly data refered by the buffer, it may be written after clearing, e.g. tb_string_clear
+    if (!buffer->maxn)
+    {
+        buffer->data = buffer->buff;
+        buffer->maxn = sizeof(buffer->buff);
+    }
 }
 tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
 {
@@ -120,8 +127,31 @@ tb_byte_t* tb_buffer_resize(tb_buffer_ref_t buffer, tb_size_t size)
         // check
         tb_assert_and_check_break(buff_data);
 
+        // refer to the readonly data? copy it to the own storage first
+        if (!buff_maxn)
+        {
+            // make the own storage
+            buff_maxn = tb_max(size, buff_size);
+            if (buff_maxn <= sizeof(buffer->buff))
+            {
+                buff_data = buffer->buff;
+                buff_maxn = sizeof(buffer->buff);
+            }
+            else
+            {
+                buff_maxn = tb_align8(buff_maxn + TB_BUFFER_GROW_SIZE);
+                buff_data = tb_malloc_bytes(buff_maxn);
+                tb_assert_and_check_break(buff_data);
+            }
+
+            // copy data, we need copy all old data because tb_buffer_memnmovp may move it after resizing
+            tb_memcpy(buff_data, buffer->data, buff_size);
+
+            // update the size
+            buff_size = size;
+        }
         // using static buffer?
-        if (buff_data == buffer->buff)
+        else if (buff_data == buffer->buff)
         {
             // grow?
             if (size > buff_maxn)
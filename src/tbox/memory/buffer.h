@@ -49,7 +49,11 @@ typedef struct __tb_buffer_t
     /// the buffer size
     tb_size_t       size;
 
-    /// the buffer maxn
+    /*! the buffer maxn
+     *
+     * it is zero if the buffer only refers to the readonly data which is not owned by it,
+     * the data will be copied to the own storage before it is modified
+     */
     tb_size_t       maxn;
 
     /// the static buffer
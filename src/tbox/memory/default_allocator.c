@@ -57,6 +57,11 @@ typedef struct __tb_default_allocator_t
 
 }tb_default_allocator_t, *tb_default_allocator_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_void_t tb_small_allocator_cache_enable_(tb_allocator_ref_t allocator);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -321,6 +326,7 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_DEFAULT;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_default_allocator_malloc;
         allocator->base.ralloc          = tb_default_allocator_ralloc;
         allocator->base.free            = tb_default_allocator_free;
@@ -358,4 +364,12 @@ tb_allocator_ref_t tb_default_allocator_init(tb_allocator_ref_t large_allocator)
     // ok?
     return (tb_allocator_ref_t)allocator;
 }
+tb_void_t tb_default_allocator_cache_enable_(tb_allocator_ref_t self)
+{
+    // check
+    tb_default_allocator_ref_t allocator = (tb_default_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->base.type == TB_ALLOCATOR_DEFAULT && allocator->small_allocator);
 
+    // enable the thread cache of the small allocator
+    tb_small_allocator_cache_enable_(allocator->small_allocator);
+}
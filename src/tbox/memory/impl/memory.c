@@ -44,6 +44,11 @@
 // the allocator 
 __tb_extern_c__ extern tb_allocator_ref_t   g_allocator;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+__tb_extern_c__ tb_void_t tb_default_allocator_cache_enable_(tb_allocator_ref_t allocator);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -87,3 +92,15 @@ tb_void_t tb_memory_exit_env()
     // exit page
     tb_page_exit();
 }
+tb_void_t tb_memory_init_cache()
+{
+    /* enable the thread cache of the default allocator
+     *
+     * the global allocator will be alive until tb_exit(), 
+     * and the thread cache of the main thread will be flushed when the thread local envirnoment is exited.
+     */
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if (g_allocator && tb_allocator_type(g_allocator) == TB_ALLOCATOR_DEFAULT) 
+        tb_default_allocator_cache_enable_(g_allocator);
+#endif
+}
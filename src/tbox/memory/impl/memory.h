@@ -51,6 +51,12 @@ tb_bool_t               tb_memory_init_env(tb_allocator_ref_t allocator);
 // exit memory envirnoment
 tb_void_t               tb_memory_exit_env(tb_noarg_t);
 
+/* init the thread cache of the global allocator
+ *
+ * @note it depends on the thread local envirnoment, so we need init it after the platform envirnoment
+ */
+tb_void_t               tb_memory_init_cache(tb_noarg_t);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -37,6 +37,30 @@
 #include "large_allocator.h"
 #include "fixed_pool.h"
 #include "impl/prefix.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+/* enable the thread cache?
+ *
+ * the debug mode need check all data in the fixed pools (magic, underflow, double free and leaks),
+ * so we only enable it for the release mode.
+ */
+#if defined(__tb_thread_local__) && !defined(__tb_debug__) && !defined(TB_CONFIG_MICRO_ENABLE)
+#   define TB_SMALL_ALLOCATOR_CACHE_ENABLE
+#endif
+
+// the cached item maximum count for each fixed pool
+#ifdef __tb_small__
+#   define TB_SMALL_ALLOCATOR_CACHE_ITEM_MAXN       (32)
+#else
+#   define TB_SMALL_ALLOCATOR_CACHE_ITEM_MAXN       (64)
+#endif
+
+// the cached space maximum size for each fixed pool
+#define TB_SMALL_ALLOCATOR_CACHE_SPACE_MAXN         (32 * 1024)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -54,8 +78,68 @@ typedef struct __tb_small_allocator_t
     // the fixed pool
     tb_fixed_pool_ref_t     fixed_pool[12];
 
+    // enable the thread cache?
+    tb_bool_t               cached;
+
+    // the clear generation, the thread caches of the old generation will be dropped on their next access
+    tb_atomic_t             generation;
+
+    /* the thread caches of all threads
+     *
+     * the caches of the threads exited after the thread locals will be exited with the allocator,
+     * e.g. the workers of the global thread pool in tb_exit()
+     */
+    tb_list_entry_head_t    caches;
+
 }tb_small_allocator_t, *tb_small_allocator_ref_t;
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+/* the thread cache type
+ *
+ * the freed items are cached in the current thread and linked by the first pointer of the item data,
+ * we refill or flush half of them from the fixed pool with the lock only if the cache is empty or full.
+ */
+typedef struct __tb_small_allocator_cache_t
+{
+    // the list entry of the owner allocator
+    tb_list_entry_t             entry;
+
+    // the owner allocator
+    tb_small_allocator_ref_t    allocator;
+
+    // the clear generation of the owner allocator when the items are cached
+    tb_long_t                   generation;
+
+    // the cached items for each fixed pool
+    tb_pointer_t                items[12];
+
+    // the cached item count for each fixed pool
+    tb_uint16_t                 count[12];
+
+    // the cached item maximum count for each fixed pool
+    tb_uint16_t                 maxn[12];
+
+}tb_small_allocator_cache_t;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+
+// the thread cache of the current thread
+static __tb_thread_local__ tb_small_allocator_cache_t*  g_cache = tb_null;
+
+// the thread cache of the current thread has been exited?
+static __tb_thread_local__ tb_bool_t                    g_cache_exited = tb_false;
+
+// the thread local for flushing the thread cache when the thread is exited
+static tb_thread_local_t                                g_cache_local = TB_THREAD_LOCAL_INIT;
+
+// the item space of each fixed pool
+static tb_uint16_t const                                g_cache_space[12] = {16, 32, 64, 96, 128, 192, 256, 384, 512, 1024, 2048, 3072};
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * declaration
  */
@@ -64,93 +148,108 @@ __tb_extern_c__ tb_fixed_pool_ref_t tb_fixed_pool_init_(tb_allocator_ref_t large
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
-static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+static tb_size_t tb_small_allocator_find_index(tb_size_t size, tb_size_t* pspace)
 {
     // check
-    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
+    tb_assert(size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
 
-    // done
-    tb_fixed_pool_ref_t fixed_pool = tb_null;
-    do
+    // the fixed pool index
+    tb_size_t index = 0;
+    tb_size_t space = 0;
+    if (size > 64 && size < 193)
     {
-        // the fixed pool index
-        tb_size_t index = 0;
-        tb_size_t space = 0;
-        if (size > 64 && size < 193)
+        if (size < 97)
+        {
+            index = 3;
+            space = 96;
+        }
+        else if (size > 128)
+        {
+            index = 5;
+            space = 192;
+        }
+        else 
+        {
+            index = 4;
+            space = 128;
+        }
+    }
+    else if (size > 192 && size < 513)
+    {
+        if (size < 257)
+        {
+            index = 6;
+            space = 256;
+        }
+        else if (size > 384)
+        {
+            index = 8;
+            space = 512;
+        }
+        else 
+        {
+            index = 7;
+            space = 384;
+        }
+    }
+    else if (size < 65)
+    {
+        if (size < 17)
+        {
+            index = 0;
+            space = 16;
+        }
+        else if (size > 32)
         {
-            if (size < 97)
-            {
-                index = 3;
-                space = 96;
-            }
-            else if (size > 128)
-            {
-                index = 5;
-                space = 192;
-            }
-            else 
-            {
-                index = 4;
-                space = 128;
-            }
+            index = 2;
+            space = 64;
         }
-        else if (size > 192 && size < 513)
+        else 
+        {
+            index = 1;
+            space = 32;
+        }
+    }
+    else 
+    {
+        if (size < 1025)
         {
-            if (size < 257)
-            {
-                index = 6;
-                space = 256;
-            }
-            else if (size > 384)
-            {
-                index = 8;
-                space = 512;
-            }
-            else 
-            {
-                index = 7;
-                space = 384;
-            }
+            index = 9;
+            space = 1024;
         }
-        else if (size < 65)
+        else if (size > 2048)
         {
-            if (size < 17)
-            {
-                index = 0;
-                space = 16;
-            }
-            else if (size > 32)
-            {
-                index = 2;
-                space = 64;
-            }
-            else 
-            {
-                index = 1;
-                space = 32;
-            }
+            index = 11;
+            space = 3072;
         }
         else 
         {
-            if (size < 1025)
-            {
-                index = 9;
-                space = 1024;
-            }
-            else if (size > 2048)
-            {
-                index = 11;
-                space = 3072;
-            }
-            else 
-            {
-                index = 10;
-                space = 2048;
-            }
+            index = 10;
+            space = 2048;
         }
+    }
+
+    // trace
+    tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
+
+    // save the space
+    if (pspace) *pspace = space;
+
+    // ok
+    return index;
+}
+static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_t allocator, tb_size_t size)
+{
+    // check
+    tb_assert(allocator && size && size <= TB_SMALL_ALLOCATOR_DATA_MAXN);
 
-        // trace
-        tb_trace_d("find: size: %lu => index: %lu, space: %lu", size, index, space);
+    // done
+    tb_fixed_pool_ref_t fixed_pool = tb_null;
+    do
+    {
+        // the fixed pool index
+        tb_size_t space = 0;
+        tb_size_t index = tb_small_allocator_find_index(size, &space);
 
         // make fixed pool if not exists
         if (!allocator->fixed_pool[index]) allocator->fixed_pool[index] = tb_fixed_pool_init_(allocator->large_allocator, 0, space, tb_true, tb_null, tb_null, tb_null);
@@ -164,6 +263,234 @@ static tb_fixed_pool_ref_t tb_small_allocator_find_fixed(tb_small_allocator_ref_
     // ok?
     return fixed_pool;
 }
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+static tb_bool_t tb_small_allocator_cache_check(tb_small_allocator_cache_t* cache)
+{
+    // check
+    tb_assert(cache && cache->allocator);
+
+    // the allocator has not been cleared after caching the items?
+    tb_long_t generation = (tb_long_t)tb_atomic_get(&cache->allocator->generation);
+    tb_check_return_val(cache->generation != generation, tb_true);
+
+    // drop all cached items, they have been released by clearing the fixed pools
+    tb_memset_(cache->items, 0, sizeof(cache->items));
+    tb_memset_(cache->count, 0, sizeof(cache->count));
+    cache->generation = generation;
+    return tb_false;
+}
+static tb_void_t tb_small_allocator_cache_flush(tb_small_allocator_cache_t* cache, tb_size_t index, tb_size_t count)
+{
+    // check
+    tb_assert(cache && cache->allocator && index < tb_arrayn(cache->items));
+
+    // the fixed pool
+    tb_fixed_pool_ref_t fixed_pool = cache->allocator->fixed_pool[index];
+    tb_assert_and_check_return(fixed_pool);
+
+    // the cached items have been dropped if the allocator has been cleared by the other thread
+    tb_check_return(tb_small_allocator_cache_check(cache));
+
+    // free the cached items to the fixed pool
+    while (count-- && cache->items[index])
+    {
+        // pop it
+        tb_pointer_t data = cache->items[index];
+        cache->items[index] = *((tb_pointer_t*)data);
+        cache->count[index]--;
+
+        // free it
+        tb_fixed_pool_free(fixed_pool, data);
+    }
+}
+static tb_bool_t tb_small_allocator_cache_refill(tb_small_allocator_cache_t* cache, tb_size_t index, tb_size_t size)
+{
+    // check
+    tb_assert(cache && cache->allocator && index < tb_arrayn(cache->items));
+
+    // the allocator
+    tb_small_allocator_ref_t allocator = cache->allocator;
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+    // drop the old cached items if the allocator has been cleared by the other thread
+    tb_small_allocator_cache_check(cache);
+
+    // the fixed pool
+    tb_fixed_pool_ref_t fixed_pool = tb_small_allocator_find_fixed(allocator, size);
+    if (fixed_pool)
+    {
+        // refill the half of cache from the fixed pool
+        tb_size_t count = tb_max(cache->maxn[index] >> 1, 1);
+        while (count--)
+        {
+            // malloc it
+            tb_pointer_t data = tb_fixed_pool_malloc(fixed_pool);
+            tb_check_break(data);
+
+            // push it
+            *((tb_pointer_t*)data) = cache->items[index];
+            cache->items[index] = data;
+            cache->count[index]++;
+        }
+    }
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
+    // ok?
+    return cache->items[index] != tb_null;
+}
+static tb_void_t tb_small_allocator_cache_exit(tb_cpointer_t priv)
+{
+    // check
+    tb_small_allocator_cache_t* cache = (tb_small_allocator_cache_t*)priv;
+    tb_assert_and_check_return(cache);
+
+    // flush all cached items to the fixed pools
+    tb_small_allocator_ref_t allocator = cache->allocator;
+    if (allocator)
+    {
+        // enter
+        tb_spinlock_enter(&allocator->base.lock);
+
+        // flush them
+        tb_size_t i = 0;
+        tb_size_t n = tb_arrayn(cache->items);
+        for (i = 0; i < n; i++) tb_small_allocator_cache_flush(cache, i, cache->count[i]);
+
+        // remove it from the allocator
+        tb_list_entry_remove(&allocator->caches, &cache->entry);
+
+        // leave
+        tb_spinlock_leave(&allocator->base.lock);
+    }
+
+    // exit it
+    tb_native_memory_free(cache);
+
+    // this thread cache has been exited, we will not make it again
+    g_cache         = tb_null;
+    g_cache_exited  = tb_true;
+}
+static tb_small_allocator_cache_t* tb_small_allocator_cache_init(tb_small_allocator_ref_t allocator)
+{
+    // check
+    tb_assert(allocator && !g_cache);
+
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_small_allocator_cache_t* cache = tb_null;
+    do
+    {
+        // init the thread local for exiting the cache
+        if (!tb_thread_local_init(&g_cache_local, tb_small_allocator_cache_exit)) break;
+
+        // make cache, we cannot use the allocator self here
+        cache = (tb_small_allocator_cache_t*)tb_native_memory_malloc0(sizeof(tb_small_allocator_cache_t));
+        tb_assert_and_check_break(cache);
+
+        // init cache
+        tb_size_t i = 0;
+        tb_size_t n = tb_arrayn(cache->maxn);
+        for (i = 0; i < n; i++) 
+            cache->maxn[i] = (tb_uint16_t)tb_max(tb_min(TB_SMALL_ALLOCATOR_CACHE_ITEM_MAXN, TB_SMALL_ALLOCATOR_CACHE_SPACE_MAXN / g_cache_space[i]), 2);
+        cache->allocator = allocator;
+        cache->generation = (tb_long_t)tb_atomic_get(&allocator->generation);
+
+        // save cache
+        if (!tb_thread_local_set(&g_cache_local, cache)) break;
+        g_cache = cache;
+
+        // save it to the allocator
+        tb_spinlock_enter(&allocator->base.lock);
+        tb_list_entry_insert_tail(&allocator->caches, &cache->entry);
+        tb_spinlock_leave(&allocator->base.lock);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed? we will not try it again for this thread
+    if (!ok)
+    {
+        if (cache) tb_native_memory_free(cache);
+        cache = tb_null;
+        g_cache_exited = tb_true;
+    }
+
+    // ok?
+    return cache;
+}
+static __tb_inline__ tb_small_allocator_cache_t* tb_small_allocator_cache(tb_small_allocator_ref_t allocator, tb_bool_t bmake)
+{
+    // this allocator has not the thread cache?
+    tb_check_return_val(allocator->cached, tb_null);
+
+    // get the thread cache of the current thread
+    tb_small_allocator_cache_t* cache = g_cache;
+    if (cache)
+    {
+        // not the owner allocator?
+        tb_check_return_val(cache->allocator == allocator, tb_null);
+
+        // drop the cached items if the allocator has been cleared
+        tb_small_allocator_cache_check(cache);
+        return cache;
+    }
+
+    /* make a new thread cache if not exists
+     *
+     * @note we do not make it for freeing data, because the data may be freed after the thread locals have been freed,
+     * e.g. the thread arguments in tb_thread_func(), and the new cache will be never exited
+     */
+    return bmake && !g_cache_exited? tb_small_allocator_cache_init(allocator) : tb_null;
+}
+static tb_pointer_t tb_small_allocator_cache_malloc(tb_small_allocator_cache_t* cache, tb_size_t size)
+{
+    // the fixed pool index
+    tb_size_t index = tb_small_allocator_find_index(size, tb_null);
+
+    // no cached item? refill it
+    if (!cache->items[index] && !tb_small_allocator_cache_refill(cache, index, size)) return tb_null;
+
+    // pop it
+    tb_pointer_t data = cache->items[index];
+    cache->items[index] = *((tb_pointer_t*)data);
+    cache->count[index]--;
+
+    // update size
+    ((tb_pool_data_head_t*)data)[-1].size = size;
+
+    // ok
+    return data;
+}
+static tb_void_t tb_small_allocator_cache_free(tb_small_allocator_cache_t* cache, tb_pointer_t data)
+{
+    // the fixed pool index
+    tb_size_t index = tb_small_allocator_find_index(((tb_pool_data_head_t*)data)[-1].size, tb_null);
+
+    // the cache is full? flush the half of cache to the fixed pool
+    if (cache->count[index] >= cache->maxn[index])
+    {
+        // enter
+        tb_spinlock_enter(&cache->allocator->base.lock);
+
+        // flush it
+        tb_small_allocator_cache_flush(cache, index, cache->maxn[index] >> 1);
+
+        // leave
+        tb_spinlock_leave(&cache->allocator->base.lock);
+    }
+
+    // push it
+    *((tb_pointer_t*)data) = cache->items[index];
+    cache->items[index] = data;
+    cache->count[index]++;
+}
+#endif
 #ifdef __tb_debug__
 static tb_bool_t tb_small_allocator_item_check(tb_pointer_t data, tb_cpointer_t priv)
 {
@@ -204,6 +531,17 @@ static tb_void_t tb_small_allocator_exit(tb_allocator_ref_t self)
     // enter
     tb_spinlock_enter(&allocator->base.lock);
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    // exit the thread caches of the exited threads, their cached items will be released with the fixed pools
+    while (tb_list_entry_size(&allocator->caches))
+    {
+        tb_list_entry_ref_t entry = tb_list_entry_head(&allocator->caches);
+        tb_list_entry_remove_head(&allocator->caches);
+        tb_native_memory_free(tb_list_entry(&allocator->caches, entry));
+    }
+    tb_list_entry_exit(&allocator->caches);
+#endif
+
     // exit fixed pool
     tb_size_t i = 0;
     tb_size_t n = tb_arrayn(allocator->fixed_pool);
@@ -229,6 +567,20 @@ static tb_void_t tb_small_allocator_clear(tb_allocator_ref_t self)
     tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
     tb_assert_and_check_return(allocator && allocator->large_allocator);
 
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    /* drop the thread caches of all threads, all cached items will be cleared
+     *
+     * the other threads will drop their caches on their next access after increasing the generation,
+     * and they cannot use the allocated or cached items in the clearing time.
+     */
+    tb_atomic_fetch_and_add(&allocator->generation, 1);
+    tb_small_allocator_cache_t* cache = g_cache;
+    if (cache && cache->allocator == allocator) tb_small_allocator_cache_check(cache);
+#endif
+
     // clear fixed pool
     tb_size_t i = 0;
     tb_size_t n = tb_arrayn(allocator->fixed_pool);
@@ -237,6 +589,9 @@ static tb_void_t tb_small_allocator_clear(tb_allocator_ref_t self)
         // clear it
         if (allocator->fixed_pool[i]) tb_fixed_pool_clear(allocator->fixed_pool[i]);
     }
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
 }
 static tb_pointer_t tb_small_allocator_malloc(tb_allocator_ref_t self, tb_size_t size __tb_debug_decl__)
 {
@@ -245,6 +600,15 @@ static tb_pointer_t tb_small_allocator_malloc(tb_allocator_ref_t self, tb_size_t
     tb_assert_and_check_return_val(allocator && allocator->large_allocator && size, tb_null);
     tb_assert_and_check_return_val(size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    // malloc it from the thread cache first
+    tb_small_allocator_cache_t* cache = tb_small_allocator_cache(allocator, tb_true);
+    if (cache) return tb_small_allocator_cache_malloc(cache, size);
+#endif
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
     // done
     tb_pointer_t data = tb_null;
     do
@@ -271,6 +635,9 @@ static tb_pointer_t tb_small_allocator_malloc(tb_allocator_ref_t self, tb_size_t
 
     } while (0);
 
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
     // check
     tb_assertf(data, "malloc(%lu) failed!", size);
 
@@ -284,6 +651,37 @@ static tb_pointer_t tb_small_allocator_ralloc(tb_allocator_ref_t self, tb_pointe
     tb_assert_and_check_return_val(allocator && allocator->large_allocator && data && size, tb_null);
     tb_assert_and_check_return_val(size <= TB_SMALL_ALLOCATOR_DATA_MAXN, tb_null);
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    // ralloc it with the thread cache
+    tb_small_allocator_cache_t* cache = tb_small_allocator_cache(allocator, tb_true);
+    if (cache)
+    {
+        // the old data head
+        tb_pool_data_head_t* data_head_old = &(((tb_pool_data_head_t*)data)[-1]);
+
+        // same space? only update size
+        if (tb_small_allocator_find_index(data_head_old->size, tb_null) == tb_small_allocator_find_index(size, tb_null))
+        {
+            data_head_old->size = size;
+            return data;
+        }
+
+        // make the new data
+        tb_pointer_t data_new = tb_small_allocator_cache_malloc(cache, size);
+        tb_assert_and_check_return_val(data_new, tb_null);
+
+        // copy the old data
+        tb_memcpy_(data_new, data, tb_min(data_head_old->size, size));
+
+        // free the old data
+        tb_small_allocator_cache_free(cache, data);
+        return data_new;
+    }
+#endif
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
     // done
     tb_pointer_t data_new = tb_null;
     do
@@ -346,6 +744,9 @@ static tb_pointer_t tb_small_allocator_ralloc(tb_allocator_ref_t self, tb_pointe
 
     } while (0);
 
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
     // ok
     return data_new;
 }
@@ -355,6 +756,19 @@ static tb_bool_t tb_small_allocator_free(tb_allocator_ref_t self, tb_pointer_t d
     tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
     tb_assert_and_check_return_val(allocator && allocator->large_allocator && data, tb_false);
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    // free it to the thread cache first if exists, otherwise free it to the fixed pool directly
+    tb_small_allocator_cache_t* cache = tb_small_allocator_cache(allocator, tb_false);
+    if (cache)
+    {
+        tb_small_allocator_cache_free(cache, data);
+        return tb_true;
+    }
+#endif
+
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
     // done
     tb_bool_t ok = tb_false;
     do
@@ -379,6 +793,9 @@ static tb_bool_t tb_small_allocator_free(tb_allocator_ref_t self, tb_pointer_t d
 
     } while (0);
 
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
+
     // ok?
     return ok;
 }
@@ -389,6 +806,9 @@ static tb_void_t tb_small_allocator_dump(tb_allocator_ref_t self)
     tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
     tb_assert_and_check_return(allocator && allocator->large_allocator);
 
+    // enter
+    tb_spinlock_enter(&allocator->base.lock);
+
     // trace
     tb_trace_i("");
 
@@ -407,6 +827,9 @@ static tb_void_t tb_small_allocator_dump(tb_allocator_ref_t self)
             tb_fixed_pool_dump(allocator->fixed_pool[i]);
         }
     }
+
+    // leave
+    tb_spinlock_leave(&allocator->base.lock);
 }static tb_bool_t tb_small_allocator_have(tb_allocator_ref_t self, tb_cpointer_t data)
 {
     // check
@@ -441,6 +864,7 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
 
         // init base
         allocator->base.type            = TB_ALLOCATOR_SMALL;
+        allocator->base.flag            = TB_ALLOCATOR_FLAG_NOLOCK;
         allocator->base.malloc          = tb_small_allocator_malloc;
         allocator->base.ralloc          = tb_small_allocator_ralloc;
         allocator->base.free            = tb_small_allocator_free;
@@ -454,6 +878,11 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
         // init lock
         if (!tb_spinlock_init(&allocator->base.lock)) break;
 
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+        // init the thread caches
+        tb_list_entry_init(&allocator->caches, tb_small_allocator_cache_t, entry, tb_null);
+#endif
+
         // ok
         ok = tb_true;
 
@@ -469,4 +898,14 @@ tb_allocator_ref_t tb_small_allocator_init(tb_allocator_ref_t large_allocator)
     // ok?
     return (tb_allocator_ref_t)allocator;
 }
+tb_void_t tb_small_allocator_cache_enable_(tb_allocator_ref_t self)
+{
+    // check
+    tb_small_allocator_ref_t allocator = (tb_small_allocator_ref_t)self;
+    tb_assert_and_check_return(allocator && allocator->base.type == TB_ALLOCATOR_SMALL);
 
+    // enable the thread cache
+#ifdef TB_SMALL_ALLOCATOR_CACHE_ENABLE
+    allocator->cached = tb_true;
+#endif
+}
@@ -38,21 +38,356 @@
 #include "../libc/libc.h"
 #include "../utils/utils.h"
 #include "../platform/platform.h"
-#include "../container/container.h"
-#include "../algorithm/algorithm.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the shard count, must be power of 2
+#ifdef __tb_small__
+#   define TB_STRING_POOL_SHARDN            (4)
+#else
+#   define TB_STRING_POOL_SHARDN            (16)
+#endif
+
+// the initial bucket count of each shard, must be power of 2
+#ifdef __tb_small__
+#   define TB_STRING_POOL_BUCKET_GROW       (16)
+#else
+#   define TB_STRING_POOL_BUCKET_GROW       (64)
+#endif
+
+// the arena block size
+#ifdef __tb_small__
+#   define TB_STRING_POOL_BLOCK_SIZE        (2048)
+#else
+#   define TB_STRING_POOL_BLOCK_SIZE        (4096)
+#endif
+
+// the slot alignment of the arena block
+#define TB_STRING_POOL_SLOT_ALIGN           (16)
+
+// the maximum slot size in the arena block, the larger item will be allocated from the allocator directly
+#define TB_STRING_POOL_SLOT_MAXN            (256)
+
+// the slot class count
+#define TB_STRING_POOL_CLASS_MAXN           (TB_STRING_POOL_SLOT_MAXN / TB_STRING_POOL_SLOT_ALIGN)
+
+// the reference count of the permanent string
+#define TB_STRING_POOL_REFN_PERMANENT       ((tb_size_t)-1)
+
+// the item data
+#define tb_string_pool_item_cstr(item)      ((tb_char_t*)((tb_string_pool_item_t*)(item) + 1))
+
+// the item slot size
+#define tb_string_pool_item_slot(size)      tb_align(sizeof(tb_string_pool_item_t) + (size) + 1, TB_STRING_POOL_SLOT_ALIGN)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the string pool item type, the string data is stored after it
+typedef struct __tb_string_pool_item_t
+{
+    // the next item of the bucket or the free list
+    struct __tb_string_pool_item_t* next;
+
+    // the string hash
+    tb_uint32_t                     hash;
+
+    // the string size
+    tb_uint32_t                     size;
+
+    // the reference count
+    tb_size_t                       refn;
+
+}tb_string_pool_item_t;
+
+// the string pool block type, the slots are stored after it
+typedef struct __tb_string_pool_block_t
+{
+    // the next block
+    struct __tb_string_pool_block_t*    next;
+
+}__tb_aligned__(TB_STRING_POOL_SLOT_ALIGN) tb_string_pool_block_t;
+
+// the string pool shard type
+typedef struct __tb_string_pool_shard_t
+{
+    // the lock
+    tb_spinlock_t                   lock;
+
+    // the buckets
+    tb_string_pool_item_t**         buckets;
+
+    // the bucket count
+    tb_size_t                       bucket_size;
+
+    // the item count
+    tb_size_t                       item_size;
+
+    // the arena blocks
+    tb_string_pool_block_t*         blocks;
+
+    // the free data of the current block
+    tb_byte_t*                      block_data;
+
+    // the free size of the current block
+    tb_size_t                       block_left;
+
+    // the free slots of each class
+    tb_string_pool_item_t*          frees[TB_STRING_POOL_CLASS_MAXN];
+
+}__tb_cacheline_aligned__ tb_string_pool_shard_t;
+
 // the string pool type
 typedef struct __tb_string_pool_t
 {
-    // the cache
-    tb_hash_map_ref_t           cache;
+    // the shards
+    tb_string_pool_shard_t*         shards;
+
+    // is case?
+    tb_bool_t                       bcase;
 
 }tb_string_pool_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_uint32_t tb_string_pool_hash_impl(tb_bool_t bcase, tb_char_t const* data, tb_size_t size)
+{
+    // fnv32-1a, ignore the case if the pool is not case-sensitive
+    tb_uint32_t         hash = 2166136261ul;
+    tb_char_t const*    e = data + size;
+    if (bcase)
+    {
+        for (; data < e; data++)
+        {
+            hash ^= (tb_byte_t)*data;
+            hash *= 16777619ul;
+        }
+    }
+    else
+    {
+        for (; data < e; data++)
+        {
+            tb_char_t ch = *data;
+            hash ^= (tb_byte_t)tb_tolower(ch);
+            hash *= 16777619ul;
+        }
+    }
+    return hash;
+}
+static __tb_inline__ tb_string_pool_shard_t* tb_string_pool_shard(tb_string_pool_t* pool, tb_uint32_t hash)
+{
+    // the low bits are used for the buckets, so we use the high bits for the shards
+    return &pool->shards[(hash >> 24) & (TB_STRING_POOL_SHARDN - 1)];
+}
+static tb_string_pool_item_t** tb_string_pool_shard_find(tb_string_pool_t* pool, tb_string_pool_shard_t* shard, tb_char_t const* data, tb_size_t size, tb_uint32_t hash)
+{
+    // no buckets?
+    tb_check_return_val(shard->buckets, tb_null);
+
+    // find the item link of the bucket
+    tb_string_pool_item_t** plink = &shard->buckets[hash & (shard->bucket_size - 1)];
+    for (; *plink; plink = &(*plink)->next)
+    {
+        // is this?
+        tb_string_pool_item_t* item = *plink;
+        if (    item->hash == hash
+            &&  item->size == size
+            &&  !(pool->bcase? tb_memcmp(tb_string_pool_item_cstr(item), data, size) : tb_strnicmp(tb_string_pool_item_cstr(item), data, size)))
+            return plink;
+    }
+
+    // not found
+    return tb_null;
+}
+static tb_bool_t tb_string_pool_shard_grow(tb_string_pool_shard_t* shard)
+{
+    // make the new buckets
+    tb_size_t                   bucket_size = shard->bucket_size? (shard->bucket_size << 1) : TB_STRING_POOL_BUCKET_GROW;
+    tb_string_pool_item_t**     buckets = tb_nalloc0_type(bucket_size, tb_string_pool_item_t*);
+    tb_assert_and_check_return_val(buckets, tb_false);
+
+    // relink all items to the new buckets, the items will be not moved
+    tb_size_t i = 0;
+    for (i = 0; i < shard->bucket_size; i++)
+    {
+        tb_string_pool_item_t* item = shard->buckets[i];
+        while (item)
+        {
+            tb_string_pool_item_t* next = item->next;
+            tb_size_t index = item->hash & (bucket_size - 1);
+            item->next = buckets[index];
+            buckets[index] = item;
+            item = next;
+        }
+    }
+
+    // update the buckets
+    if (shard->buckets) tb_free(shard->buckets);
+    shard->buckets      = buckets;
+    shard->bucket_size  = bucket_size;
+    return tb_true;
+}
+static tb_string_pool_item_t* tb_string_pool_shard_malloc(tb_string_pool_shard_t* shard, tb_size_t size)
+{
+    // too large? allocate it from the allocator directly
+    tb_size_t slot = tb_string_pool_item_slot(size);
+    if (slot > TB_STRING_POOL_SLOT_MAXN) return (tb_string_pool_item_t*)tb_malloc(sizeof(tb_string_pool_item_t) + size + 1);
+
+    // reuse the free slot of this class
+    tb_size_t               index = slot / TB_STRING_POOL_SLOT_ALIGN - 1;
+    tb_string_pool_item_t*  item = shard->frees[index];
+    if (item)
+    {
+        shard->frees[index] = item->next;
+        return item;
+    }
+
+    // no enough space in the current block? 
+    if (shard->block_left < slot)
+    {
+        // put the left space of the current block to the free slots
+        if (shard->block_left)
+        {
+            item = (tb_string_pool_item_t*)shard->block_data;
+            index = shard->block_left / TB_STRING_POOL_SLOT_ALIGN - 1;
+            item->next = shard->frees[index];
+            shard->frees[index] = item;
+            item = tb_null;
+        }
+
+        // make a new block
+        tb_string_pool_block_t* block = (tb_string_pool_block_t*)tb_malloc(TB_STRING_POOL_BLOCK_SIZE);
+        tb_assert_and_check_return_val(block, tb_null);
+
+        // append it
+        block->next         = shard->blocks;
+        shard->blocks       = block;
+        shard->block_data   = (tb_byte_t*)(block + 1);
+        shard->block_left   = TB_STRING_POOL_BLOCK_SIZE - sizeof(tb_string_pool_block_t);
+    }
+
+    // allocate it from the current block
+    item = (tb_string_pool_item_t*)shard->block_data;
+    shard->block_data += slot;
+    shard->block_left -= slot;
+    return item;
+}
+static tb_void_t tb_string_pool_shard_free(tb_string_pool_shard_t* shard, tb_string_pool_item_t* item)
+{
+    // too large? free it directly
+    tb_size_t slot = tb_string_pool_item_slot(item->size);
+    if (slot > TB_STRING_POOL_SLOT_MAXN) 
+    {
+        tb_free(item);
+        return ;
+    }
+
+    // put it to the free slots
+    tb_size_t index = slot / TB_STRING_POOL_SLOT_ALIGN - 1;
+    item->next = shard->frees[index];
+    shard->frees[index] = item;
+}
+static tb_void_t tb_string_pool_shard_clear(tb_string_pool_shard_t* shard, tb_bool_t all)
+{
+    // free all large items
+    tb_size_t i = 0;
+    for (i = 0; i < shard->bucket_size; i++)
+    {
+        tb_string_pool_item_t* item = shard->buckets[i];
+        while (item)
+        {
+            tb_string_pool_item_t* next = item->next;
+            if (tb_string_pool_item_slot(item->size) > TB_STRING_POOL_SLOT_MAXN) tb_free(item);
+            item = next;
+        }
+        shard->buckets[i] = tb_null;
+    }
+
+    // free all blocks
+    while (shard->blocks)
+    {
+        tb_string_pool_block_t* next = shard->blocks->next;
+        tb_free(shard->blocks);
+        shard->blocks = next;
+    }
+
+    // free the buckets?
+    if (all && shard->buckets)
+    {
+        tb_free(shard->buckets);
+        shard->buckets = tb_null;
+        shard->bucket_size = 0;
+    }
+
+    // reset it
+    shard->item_size    = 0;
+    shard->block_data   = tb_null;
+    shard->block_left   = 0;
+    tb_memset(shard->frees, 0, sizeof(shard->frees));
+}
+static tb_char_t const* tb_string_pool_insert_impl(tb_string_pool_t* pool, tb_char_t const* data, tb_size_t size, tb_uint32_t hash, tb_bool_t permanent)
+{
+    // check
+    tb_assert_and_check_return_val(size <= TB_MAXU32, tb_null);
+
+    // enter
+    tb_string_pool_shard_t* shard = tb_string_pool_shard(pool, hash);
+    tb_spinlock_enter(&shard->lock);
+
+    // done
+    tb_char_t const* cstr = tb_null;
+    do
+    {
+        // exists?
+        tb_string_pool_item_t** plink = tb_string_pool_shard_find(pool, shard, data, size, hash);
+        if (plink)
+        {
+            // refn++, the permanent string has no reference count
+            tb_string_pool_item_t* item = *plink;
+            if (permanent) item->refn = TB_STRING_POOL_REFN_PERMANENT;
+            else if (item->refn != TB_STRING_POOL_REFN_PERMANENT) item->refn++;
+
+            // save the cstr
+            cstr = tb_string_pool_item_cstr(item);
+            break;
+        }
+
+        // grow the buckets?
+        if (shard->item_size >= shard->bucket_size && !tb_string_pool_shard_grow(shard)) break;
+
+        // make item
+        tb_string_pool_item_t* item = tb_string_pool_shard_malloc(shard, size);
+        tb_assert_and_check_break(item);
+
+        // init item
+        item->hash = hash;
+        item->size = (tb_uint32_t)size;
+        item->refn = permanent? TB_STRING_POOL_REFN_PERMANENT : 1;
+        tb_memcpy(tb_string_pool_item_cstr(item), data, size);
+        tb_string_pool_item_cstr(item)[size] = '\0';
+
+        // insert it to the bucket
+        tb_size_t index = hash & (shard->bucket_size - 1);
+        item->next = shard->buckets[index];
+        shard->buckets[index] = item;
+        shard->item_size++;
+
+        // save the cstr
+        cstr = tb_string_pool_item_cstr(item);
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave(&shard->lock);
+
+    // ok?
+    return cstr;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -67,9 +402,20 @@ tb_string_pool_ref_t tb_string_pool_init(tb_bool_t bcase)
         pool = tb_malloc0_type(tb_string_pool_t);
         tb_assert_and_check_break(pool);
 
-        // init hash
-        pool->cache = tb_hash_map_init(0, tb_element_str(bcase), tb_element_size());
-        tb_assert_and_check_break(pool->cache);
+        // init case
+        pool->bcase = bcase;
+
+        // init shards
+        pool->shards = (tb_string_pool_shard_t*)tb_align_malloc0(TB_STRING_POOL_SHARDN * sizeof(tb_string_pool_shard_t), TB_SMP_CACHE_BYTES);
+        tb_assert_and_check_break(pool->shards);
+
+        // init locks
+        tb_size_t i = 0;
+        for (i = 0; i < TB_STRING_POOL_SHARDN; i++)
+        {
+            if (!tb_spinlock_init(&pool->shards[i].lock)) break;
+        }
+        tb_assert_and_check_break(i == TB_STRING_POOL_SHARDN);
 
         // ok
         ok = tb_true;
@@ -93,9 +439,22 @@ tb_void_t tb_string_pool_exit(tb_string_pool_ref_t self)
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return(pool);
 
-    // exit cache
-    if (pool->cache) tb_hash_map_exit(pool->cache);
-    pool->cache = tb_null;
+    // exit shards
+    if (pool->shards)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < TB_STRING_POOL_SHARDN; i++)
+        {
+            // clear all
+            tb_string_pool_shard_t* shard = &pool->shards[i];
+            tb_string_pool_shard_clear(shard, tb_true);
+
+            // exit lock
+            tb_spinlock_exit(&shard->lock);
+        }
+        tb_align_free(pool->shards);
+        pool->shards = tb_null;
+    }
 
     // exit it
     tb_free(pool);
@@ -104,55 +463,85 @@ tb_void_t tb_string_pool_clear(tb_string_pool_ref_t self)
 {
     // check
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
-    tb_assert_and_check_return(pool);
+    tb_assert_and_check_return(pool && pool->shards);
 
-    // clear cache
-    if (pool->cache) tb_hash_map_clear(pool->cache);
+    // clear shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_STRING_POOL_SHARDN; i++)
+    {
+        tb_string_pool_shard_t* shard = &pool->shards[i];
+        tb_spinlock_enter(&shard->lock);
+        tb_string_pool_shard_clear(shard, tb_false);
+        tb_spinlock_leave(&shard->lock);
+    }
+}
+tb_uint32_t tb_string_pool_hash(tb_string_pool_ref_t self, tb_char_t const* data, tb_size_t size)
+{
+    // check
+    tb_string_pool_t* pool = (tb_string_pool_t*)self;
+    tb_assert_and_check_return_val(pool && data, 0);
+
+    // compute hash
+    return tb_string_pool_hash_impl(pool->bcase, data, size);
 }
 tb_char_t const* tb_string_pool_insert(tb_string_pool_ref_t self, tb_char_t const* data)
+{
+    // check
+    tb_string_pool_t* pool = (tb_string_pool_t*)self;
+    tb_assert_and_check_return_val(pool && pool->shards && data, tb_null);
+
+    // insert it
+    tb_size_t size = tb_strlen(data);
+    return tb_string_pool_insert_impl(pool, data, size, tb_string_pool_hash_impl(pool->bcase, data, size), tb_false);
+}
+tb_char_t const* tb_string_pool_insert_with_hash(tb_string_pool_ref_t self, tb_char_t const* data, tb_size_t size, tb_uint32_t hash)
+{
+    // check
+    tb_string_pool_t* pool = (tb_string_pool_t*)self;
+    tb_assert_and_check_return_val(pool && pool->shards && data, tb_null);
+
+    // check hash
+    tb_assert(hash == tb_string_pool_hash_impl(pool->bcase, data, size));
+
+    // insert it
+    return tb_string_pool_insert_impl(pool, data, size, hash, tb_false);
+}
+tb_char_t const* tb_string_pool_insert_permanent(tb_string_pool_ref_t self, tb_char_t const* data)
+{
+    // check
+    tb_string_pool_t* pool = (tb_string_pool_t*)self;
+    tb_assert_and_check_return_val(pool && pool->shards && data, tb_null);
+
+    // insert it
+    tb_size_t size = tb_strlen(data);
+    return tb_string_pool_insert_impl(pool, data, size, tb_string_pool_hash_impl(pool->bcase, data, size), tb_true);
+}
+tb_char_t const* tb_string_pool_find(tb_string_pool_ref_t self, tb_char_t const* data)
 {
     // check
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
     tb_assert_and_check_return_val(pool && data, tb_null);
 
-    // done
-    tb_char_t const* cstr = tb_null;
-    if (pool->cache)
-    {
-        // exists?
-        tb_size_t               itor;
-        tb_hash_map_item_ref_t  item = tb_null;
-        if (    ((itor = tb_hash_map_find(pool->cache, data)) != tb_iterator_tail(pool->cache))
-            &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor)))
-        {
-            // refn
-            tb_size_t refn = (tb_size_t)item->data;
+    // find it
+    tb_size_t size = tb_strlen(data);
+    return tb_string_pool_find_with_hash(self, data, size, tb_string_pool_hash_impl(pool->bcase, data, size));
+}
+tb_char_t const* tb_string_pool_find_with_hash(tb_string_pool_ref_t self, tb_char_t const* data, tb_size_t size, tb_uint32_t hash)
+{
+    // check
+    tb_string_pool_t* pool = (tb_string_pool_t*)self;
+    tb_assert_and_check_return_val(pool && pool->shards && data, tb_null);
 
-            // refn++
-            if (refn) tb_iterator_copy(pool->cache, itor, (tb_pointer_t)(refn + 1));
-            // no refn? remove it
-            else
-            {
-                // assert
-                tb_assert(0);
+    // enter
+    tb_string_pool_shard_t* shard = tb_string_pool_shard(pool, hash);
+    tb_spinlock_enter(&shard->lock);
 
-                // del it
-                tb_iterator_remove(pool->cache, itor);
-                item = tb_null;
-            }
-        }
-        
-        // no item? insert it
-        if (!item)
-        {
-            // insert it
-            if ((itor = tb_hash_map_insert(pool->cache, data, (tb_pointer_t)1)) != tb_iterator_tail(pool->cache))
-                item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor);
-        }
+    // find it
+    tb_string_pool_item_t** plink = tb_string_pool_shard_find(pool, shard, data, size, hash);
+    tb_char_t const*        cstr = plink? tb_string_pool_item_cstr(*plink) : tb_null;
 
-        // save the cstr
-        if (item) cstr = (tb_char_t const*)item->name;
-    }
+    // leave
+    tb_spinlock_leave(&shard->lock);
 
     // ok?
     return cstr;
@@ -161,39 +550,79 @@ tb_void_t tb_string_pool_remove(tb_string_pool_ref_t self, tb_char_t const* data
 {
     // check
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
-    tb_assert_and_check_return(pool && data);
+    tb_assert_and_check_return(pool && pool->shards && data);
 
-    // done
-    tb_hash_map_item_ref_t item = tb_null;
-    if (pool->cache)
+    // the hash
+    tb_size_t   size = tb_strlen(data);
+    tb_uint32_t hash = tb_string_pool_hash_impl(pool->bcase, data, size);
+
+    // enter
+    tb_string_pool_shard_t* shard = tb_string_pool_shard(pool, hash);
+    tb_spinlock_enter(&shard->lock);
+
+    // exists?
+    tb_string_pool_item_t** plink = tb_string_pool_shard_find(pool, shard, data, size, hash);
+    if (plink)
     {
-        // exists?
-        tb_size_t itor;
-        if (    ((itor = tb_hash_map_find(pool->cache, data)) != tb_iterator_tail(pool->cache))
-            &&  (item = (tb_hash_map_item_ref_t)tb_iterator_item(pool->cache, itor)))
+        // refn--, the permanent string will be not removed
+        tb_string_pool_item_t* item = *plink;
+        if (item->refn != TB_STRING_POOL_REFN_PERMANENT && !--item->refn)
         {
-            // refn
-            tb_size_t refn = (tb_size_t)item->data;
-
-            // refn--
-            if (refn > 1) tb_iterator_copy(pool->cache, itor, (tb_pointer_t)(refn - 1));
             // del it
-            else tb_iterator_remove(pool->cache, itor);
+            *plink = item->next;
+            shard->item_size--;
+            tb_string_pool_shard_free(shard, item);
         }
     }
+
+    // leave
+    tb_spinlock_leave(&shard->lock);
 }
 #ifdef __tb_debug__
 tb_void_t tb_string_pool_dump(tb_string_pool_ref_t self)
 {
     // check
     tb_string_pool_t* pool = (tb_string_pool_t*)self;
-    tb_assert_and_check_return(pool && pool->cache);
+    tb_assert_and_check_return(pool && pool->shards);
 
-    // dump cache
-    tb_for_all_if (tb_hash_map_item_ref_t, item, pool->cache, item)
+    // dump shards
+    tb_size_t i = 0;
+    for (i = 0; i < TB_STRING_POOL_SHARDN; i++)
     {
+        // enter
+        tb_string_pool_shard_t* shard = &pool->shards[i];
+        tb_spinlock_enter(&shard->lock);
+
+        // empty?
+        if (!shard->item_size) 
+        {
+            tb_spinlock_leave(&shard->lock);
+            continue;
+        }
+
+        // the block count
+        tb_size_t                   blockn = 0;
+        tb_string_pool_block_t*     block = shard->blocks;
+        for (; block; block = block->next) blockn++;
+
         // trace
-        tb_trace_i("item: refn: %lu, cstr: %s", (tb_size_t)item->data, item->name);
+        tb_trace_i("shard[%lu]: items: %lu, buckets: %lu, blocks: %lu", i, shard->item_size, shard->bucket_size, blockn);
+
+        // dump items
+        tb_size_t j = 0;
+        for (j = 0; j < shard->bucket_size; j++)
+        {
+            tb_string_pool_item_t* item = shard->buckets[j];
+            for (; item; item = item->next)
+            {
+                // trace
+                if (item->refn == TB_STRING_POOL_REFN_PERMANENT) tb_trace_i("item: refn: permanent, cstr: %s", tb_string_pool_item_cstr(item));
+                else tb_trace_i("item: refn: %lu, cstr: %s", item->refn, tb_string_pool_item_cstr(item));
+            }
+        }
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
     }
 }
 #endif
@@ -51,6 +51,9 @@ typedef __tb_typeref__(string_pool);
  *
  * readonly, strip repeat strings and decrease memory fragmens
  *
+ * the pool is thread-safe and sharded by the string hash, 
+ * the strings are packed into the append-only arena blocks of each shard
+ *
  * @param bcase             is case?
  *
  * @return                  the string pool
@@ -64,11 +67,25 @@ tb_string_pool_ref_t        tb_string_pool_init(tb_bool_t bcase);
 tb_void_t                   tb_string_pool_exit(tb_string_pool_ref_t pool);
 
 /*! clear the string pool
+ *
+ * @note all strings (including the permanent strings) will be invalid
  *
  * @param pool              the string pool
  */
 tb_void_t                   tb_string_pool_clear(tb_string_pool_ref_t pool);
 
+/*! compute the string hash of the pool
+ *
+ * the hash can be cached by the caller and passed to the xxx_with_hash interfaces
+ *
+ * @param pool              the string pool
+ * @param data              the string data
+ * @param size              the string size
+ *
+ * @return                  the string hash
+ */
+tb_uint32_t                 tb_string_pool_hash(tb_string_pool_ref_t pool, tb_char_t const* data, tb_size_t size);
+
 /*! insert string to the pool and increase the reference count
  *
  * @param pool              the string pool
@@ -78,7 +95,54 @@ tb_void_t                   tb_string_pool_clear(tb_string_pool_ref_t pool);
  */
 tb_char_t const*            tb_string_pool_insert(tb_string_pool_ref_t pool, tb_char_t const* data);
 
+/*! insert string with the precomputed hash and increase the reference count
+ *
+ * @param pool              the string pool
+ * @param data              the string data, need not be null-terminated
+ * @param size              the string size
+ * @param hash              the string hash from tb_string_pool_hash()
+ *
+ * @return                  the null-terminated string data in the pool
+ */
+tb_char_t const*            tb_string_pool_insert_with_hash(tb_string_pool_ref_t pool, tb_char_t const* data, tb_size_t size, tb_uint32_t hash);
+
+/*! insert the permanent string to the pool
+ *
+ * the permanent string has no reference count, 
+ * it will be not removed and always be valid until the pool is cleared or exited
+ *
+ * @param pool              the string pool
+ * @param data              the string data
+ *
+ * @return                  the string data
+ */
+tb_char_t const*            tb_string_pool_insert_permanent(tb_string_pool_ref_t pool, tb_char_t const* data);
+
+/*! find string from the pool and not change the reference count
+ *
+ * @note the returned string is only valid while it is referenced or permanent
+ *
+ * @param pool              the string pool
+ * @param data              the string data
+ *
+ * @return                  the string data in the pool, return tb_null if not found
+ */
+tb_char_t const*            tb_string_pool_find(tb_string_pool_ref_t pool, tb_char_t const* data);
+
+/*! find string with the precomputed hash and not change the reference count
+ *
+ * @param pool              the string pool
+ * @param data              the string data, need not be null-terminated
+ * @param size              the string size
+ * @param hash              the string hash from tb_string_pool_hash()
+ *
+ * @return                  the string data in the pool, return tb_null if not found
+ */
+tb_char_t const*            tb_string_pool_find_with_hash(tb_string_pool_ref_t pool, tb_char_t const* data, tb_size_t size, tb_uint32_t hash);
+
 /*! remove string from the pool if the reference count be zero
+ *
+ * @note the permanent string will be not removed
  *
  * @param pool              the string pool
  * @param data              the string data
@@ -44,6 +44,22 @@
 #include "../algorithm/algorithm.h"
 #include "../container/container.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the writer has entered the cookies lock
+#define TB_COOKIES_LOCK_WRITER          (0x40000000)
+
+// the writer is waiting for the readers to leave the cookies lock
+#define TB_COOKIES_LOCK_WAITING         (0x20000000)
+
+// some threads are parked on the cookies lock
+#define TB_COOKIES_LOCK_PARKED          (0x10000000)
+
+// the reader count mask of the cookies lock
+#define TB_COOKIES_LOCK_READERS         (0x0fffffff)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -51,6 +67,9 @@
 // the cookies entry type
 typedef struct __tb_cookies_entry_t
 {
+    // the list entry of the path
+    tb_list_entry_t         entry;
+
     // the domain 
     tb_char_t const*        domain;
 
@@ -77,26 +96,124 @@ typedef struct __tb_cookies_entry_t
 
 }tb_cookies_entry_t, *tb_cookies_entry_ref_t;
 
+// the cookies path type
+typedef struct __tb_cookies_path_t
+{
+    // the list entry of the domain
+    tb_list_entry_t         entry;
+
+    // the path
+    tb_char_t const*        path;
+
+    // the path size
+    tb_size_t               size;
+
+    // the entries
+    tb_list_entry_head_t    entries;
+
+}tb_cookies_path_t, *tb_cookies_path_ref_t;
+
+// the cookies domain type
+typedef struct __tb_cookies_domain_t
+{
+    // the paths, the longer paths are in front of the shorter paths
+    tb_list_entry_head_t    paths;
+
+}tb_cookies_domain_t, *tb_cookies_domain_ref_t;
+
 // the cookies type
 typedef struct __tb_cookies_t
 {
-    // the lock
-    tb_spinlock_t           lock;
-
-    // the string element
-    tb_element_t            string_element;
+    /* the lock
+     *
+     * the readers only increase the reader count, 
+     * the writer waits for all readers to leave and blocks the new readers
+     */
+    tb_atomic_t             lock;
 
     // the string pool
     tb_string_pool_ref_t    string_pool;
     
-    // the cookie pool, key: "domain+path+name"
-    tb_hash_set_ref_t       cookie_pool;
+    /* the domains, domain => paths => entries
+     *
+     * we only look up the parent domains of the given domain, 
+     * .e.g www.space.baidu.com => space.baidu.com => baidu.com
+     */
+    tb_hash_map_ref_t       domains;
+
+    // the entry count
+    tb_size_t               size;
 
 }tb_cookies_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static tb_void_t tb_cookies_lock_wait(tb_cookies_t* cookies, tb_long_t lock, tb_bool_t* poccupied, tb_size_t* ptryn)
+{
+#ifdef TB_LOCK_PROFILER_ENABLE
+    // occupied
+    if (!*poccupied)
+    {
+        *poccupied = tb_true;
+        tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)&cookies->lock);
+    }
+#endif
+
+    // park the current thread after spinning some times, the lock leaver will wake up it
+    if (!(*ptryn)--)
+    {
+        tb_long_t parked = lock | TB_COOKIES_LOCK_PARKED;
+        if (lock == parked || tb_atomic_fetch_and_pset(&cookies->lock, lock, parked) == lock)
+            tb_sched_wait(&cookies->lock, parked, -1);
+        *ptryn = 5;
+    }
+}
+static tb_void_t tb_cookies_lock_wake(tb_cookies_t* cookies)
+{
+    // wake up all parked threads
+    if (tb_atomic_fetch_and_and(&cookies->lock, ~TB_COOKIES_LOCK_PARKED) & TB_COOKIES_LOCK_PARKED)
+        tb_sched_wake(&cookies->lock, TB_MAXS32);
+}
+static tb_void_t tb_cookies_enter_read(tb_cookies_t* cookies)
+{
+    // increase the reader count if no writers
+    tb_size_t tryn = 5;
+    tb_bool_t occupied = tb_false;
+    while (1)
+    {
+        tb_long_t lock = tb_atomic_get(&cookies->lock);
+        if (!(lock & (TB_COOKIES_LOCK_WRITER | TB_COOKIES_LOCK_WAITING)) && tb_atomic_fetch_and_pset(&cookies->lock, lock, lock + 1) == lock) break;
+        tb_cookies_lock_wait(cookies, lock, &occupied, &tryn);
+    }
+}
+static tb_void_t tb_cookies_leave_read(tb_cookies_t* cookies)
+{
+    // the last reader will wake up the parked writers and readers
+    tb_long_t lock = tb_atomic_fetch_and_dec(&cookies->lock);
+    if ((lock & TB_COOKIES_LOCK_PARKED) && (lock & TB_COOKIES_LOCK_READERS) == 1) tb_cookies_lock_wake(cookies);
+}
+static tb_void_t tb_cookies_enter_write(tb_cookies_t* cookies)
+{
+    // wait for all readers and writers to leave, the new readers will be blocked if we are waiting
+    tb_size_t tryn = 5;
+    tb_bool_t occupied = tb_false;
+    while (1)
+    {
+        tb_long_t lock = tb_atomic_get(&cookies->lock);
+        if (!(lock & ~(TB_COOKIES_LOCK_WAITING | TB_COOKIES_LOCK_PARKED)))
+        {
+            if (tb_atomic_fetch_and_pset(&cookies->lock, lock, TB_COOKIES_LOCK_WRITER | (lock & TB_COOKIES_LOCK_PARKED)) == lock) break;
+        }
+        else if (!(lock & TB_COOKIES_LOCK_WAITING)) tb_atomic_fetch_and_or(&cookies->lock, TB_COOKIES_LOCK_WAITING);
+        tb_cookies_lock_wait(cookies, lock, &occupied, &tryn);
+    }
+}
+static tb_void_t tb_cookies_leave_write(tb_cookies_t* cookies)
+{
+    // clear the writer flag and keep the waiting flag of the other writers
+    if (tb_atomic_fetch_and_and(&cookies->lock, ~TB_COOKIES_LOCK_WRITER) & TB_COOKIES_LOCK_PARKED) tb_cookies_lock_wake(cookies);
+}
 static tb_bool_t tb_cookies_get_domain_and_path_from_url(tb_char_t const* url, tb_char_t* pdomain, tb_size_t ndomain, tb_char_t* ppath, tb_size_t npath, tb_bool_t* psecure)
 {
     // check
@@ -156,30 +273,6 @@ static tb_bool_t tb_cookies_get_domain_and_path_from_url(tb_char_t const* url, t
     // ok?
     return *pdomain? tb_true : tb_false;
 }
-static tb_bool_t tb_cookies_is_child_domain(tb_char_t const* parent, tb_char_t const* child)
-{
-    // check
-    tb_assert_and_check_return_val(parent && child, tb_false);
-
-    // init
-    tb_char_t const*    pb = parent;
-    tb_char_t const*    cb = child;
-    tb_size_t           pn = tb_strlen(pb);
-    tb_size_t           cn = tb_strlen(cb);
-    tb_assert_and_check_return_val(pn && cn, tb_false);
-
-    // is child?
-    tb_size_t           n = 0;
-    tb_char_t const*    pe = pb + pn - 1;
-    tb_char_t const*    ce = cb + cn - 1;
-    for (; pe >= pb && ce >= cb && *pe == *ce; pe--, ce--)
-    {
-        if (*ce == '.') n++;
-    }
-
-    // ok?
-    return (pe < pb && n >= 1 && (ce < cb || *ce == '.'))? tb_true : tb_false;
-}
 static tb_bool_t tb_cookies_is_child_path(tb_char_t const* parent, tb_char_t const* child)
 {
     // check
@@ -192,7 +285,7 @@ static tb_bool_t tb_cookies_is_child_path(tb_char_t const* parent, tb_char_t con
     tb_char_t const*    p = parent;
     tb_char_t const*    c = child;
     tb_size_t           n = tb_strlen(parent);
-    while (n-- && *p && *c && *p++ == *c++) ; 
+    for (; n && *p && *c && *p == *c; n--, p++, c++) ;
 
     // ok?
     return (!*p && (!*c || *c == '/'))? tb_true : tb_false;
@@ -218,55 +311,232 @@ static tb_void_t tb_cookies_entry_exit(tb_cookies_t* cookies, tb_cookies_entry_r
     if (entry->value) tb_string_pool_remove(cookies->string_pool, entry->value);
     entry->value = tb_null;
 }
-static tb_void_t tb_cookies_entry_free(tb_element_ref_t element, tb_pointer_t buff)
+static tb_void_t tb_cookies_entry_free(tb_cookies_t* cookies, tb_cookies_entry_ref_t entry)
 {
     // check
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)buff;
-    tb_assert_and_check_return(element && entry);
-
-    // the cookies
-    tb_cookies_t* cookies = (tb_cookies_t*)element->priv;
-    tb_assert_and_check_return(cookies && cookies->string_pool);
+    tb_assert_and_check_return(cookies && entry);
 
     // exit it
     tb_cookies_entry_exit(cookies, entry);
+    tb_free(entry);
+
+    // update size
+    tb_assert(cookies->size);
+    cookies->size--;
+}
+static tb_void_t tb_cookies_path_free(tb_cookies_t* cookies, tb_cookies_path_ref_t path)
+{
+    // check
+    tb_assert_and_check_return(cookies && path);
+
+    // exit entries
+    while (!tb_list_entry_is_null(&path->entries))
+    {
+        tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)tb_list_entry(&path->entries, tb_list_entry_head(&path->entries));
+        tb_list_entry_remove_head(&path->entries);
+        tb_cookies_entry_free(cookies, entry);
+    }
+
+    // exit path
+    if (path->path) tb_string_pool_remove(cookies->string_pool, path->path);
+    path->path = tb_null;
+
+    // exit it
+    tb_free(path);
 }
-static tb_size_t tb_cookies_entry_hash(tb_element_ref_t element, tb_cpointer_t data, tb_size_t mask, tb_size_t index)
+static tb_void_t tb_cookies_domain_free(tb_element_ref_t element, tb_pointer_t buff)
 {
     // check
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)data;
-    tb_assert_and_check_return_val(element && entry && entry->domain, 0);
+    tb_cookies_domain_ref_t domain = buff? *((tb_cookies_domain_ref_t*)buff) : tb_null;
+    tb_assert_and_check_return(element && domain);
 
     // the cookies
     tb_cookies_t* cookies = (tb_cookies_t*)element->priv;
-    tb_assert_and_check_return_val(cookies && cookies->string_element.hash, 0);
+    tb_assert_and_check_return(cookies && cookies->string_pool);
+
+    // exit paths
+    while (!tb_list_entry_is_null(&domain->paths))
+    {
+        tb_cookies_path_ref_t path = (tb_cookies_path_ref_t)tb_list_entry(&domain->paths, tb_list_entry_head(&domain->paths));
+        tb_list_entry_remove_head(&domain->paths);
+        tb_cookies_path_free(cookies, path);
+    }
+
+    // exit it
+    tb_free(domain);
+}
+static tb_cookies_path_ref_t tb_cookies_path_find(tb_cookies_domain_ref_t domain, tb_char_t const* path, tb_list_entry_ref_t* pnext)
+{
+    // find the path, the paths are sorted by the path size
+    tb_size_t           size = tb_strlen(path);
+    tb_list_entry_ref_t item = tb_list_entry_head(&domain->paths);
+    for (; item != tb_list_entry_tail(&domain->paths); item = tb_list_entry_next(item))
+    {
+        // the path
+        tb_cookies_path_ref_t cpath = (tb_cookies_path_ref_t)tb_list_entry(&domain->paths, item);
 
-    // compute the three hash values
-    tb_size_t v0 = cookies->string_element.hash(&cookies->string_element, entry->domain, mask, index);
-    tb_size_t v1 = entry->path? cookies->string_element.hash(&cookies->string_element, entry->path, mask, index) : 0;
-    tb_size_t v2 = entry->name? cookies->string_element.hash(&cookies->string_element, entry->name, mask, index) : 0;
+        // found?
+        if (cpath->size == size && !tb_strcmp(cpath->path, path)) return cpath;
 
-    // the hash value
-    return (v0 ^ v1 ^ v2) & mask;
+        // the next path is shorter? insert it before this path
+        tb_check_break(cpath->size >= size);
+    }
+
+    // save the insert position
+    if (pnext) *pnext = item;
+    return tb_null;
+}
+static tb_cookies_entry_ref_t tb_cookies_entry_find(tb_cookies_path_ref_t path, tb_char_t const* name)
+{
+    // find the entry with the given name
+    tb_list_entry_ref_t item = tb_list_entry_head(&path->entries);
+    for (; item != tb_list_entry_tail(&path->entries); item = tb_list_entry_next(item))
+    {
+        tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)tb_list_entry(&path->entries, item);
+        if (!tb_strcmp(entry->name, name)) return entry;
+    }
+    return tb_null;
 }
-static tb_long_t tb_cookies_entry_comp(tb_element_ref_t element, tb_cpointer_t ldata, tb_cpointer_t rdata)
+static tb_size_t tb_cookies_path_clean(tb_cookies_t* cookies, tb_cookies_path_ref_t path, tb_time_t now)
+{
+    // remove the expired entries
+    tb_size_t           size = 0;
+    tb_list_entry_ref_t item = tb_list_entry_head(&path->entries);
+    while (item != tb_list_entry_tail(&path->entries))
+    {
+        tb_list_entry_ref_t     next = tb_list_entry_next(item);
+        tb_cookies_entry_ref_t  entry = (tb_cookies_entry_ref_t)tb_list_entry(&path->entries, item);
+        if (entry->expires && now >= entry->expires)
+        {
+            // trace
+            tb_trace_d("expired: %s%s%s: %s = %s", entry->secure? "https://" : "http://", entry->domain, entry->path, entry->name, entry->value? entry->value : "");
+
+            // remove it
+            tb_list_entry_remove(&path->entries, item);
+            tb_cookies_entry_free(cookies, entry);
+            size++;
+        }
+        item = next;
+    }
+    return size;
+}
+static tb_void_t tb_cookies_domain_clean(tb_cookies_t* cookies, tb_char_t const* name, tb_time_t now)
+{
+    // the domain
+    tb_cookies_domain_ref_t domain = (tb_cookies_domain_ref_t)tb_hash_map_get(cookies->domains, name);
+    tb_check_return(domain);
+
+    // remove the expired entries and the empty paths
+    tb_list_entry_ref_t item = tb_list_entry_head(&domain->paths);
+    while (item != tb_list_entry_tail(&domain->paths))
+    {
+        tb_list_entry_ref_t     next = tb_list_entry_next(item);
+        tb_cookies_path_ref_t   path = (tb_cookies_path_ref_t)tb_list_entry(&domain->paths, item);
+        tb_cookies_path_clean(cookies, path, now);
+        if (tb_list_entry_is_null(&path->entries))
+        {
+            tb_list_entry_remove(&domain->paths, item);
+            tb_cookies_path_free(cookies, path);
+        }
+        item = next;
+    }
+
+    // remove the empty domain
+    if (tb_list_entry_is_null(&domain->paths)) tb_hash_map_remove(cookies->domains, name);
+}
+/* save the entry to the domain index
+ *
+ * the entry will be owned by the cookies if be saved, 
+ * the caller need exit it if it is removed (maxage: 0) or failed
+ */
+static tb_bool_t tb_cookies_entry_save(tb_cookies_t* cookies, tb_cookies_entry_ref_t entry)
 {
     // check
-    tb_cookies_entry_ref_t lentry = (tb_cookies_entry_ref_t)ldata;
-    tb_cookies_entry_ref_t rentry = (tb_cookies_entry_ref_t)rdata;
-    tb_assert_and_check_return_val(lentry && lentry->domain, 0);
-    tb_assert_and_check_return_val(rentry && rentry->domain, 0);
+    tb_assert_and_check_return_val(cookies && cookies->domains && entry && entry->domain && entry->path && entry->name, tb_false);
+
+    // remove it if maxage is zero
+    tb_bool_t remove = (!entry->maxage && !entry->storage)? tb_true : tb_false;
+
+    // get the domain
+    tb_cookies_domain_ref_t domain = (tb_cookies_domain_ref_t)tb_hash_map_get(cookies->domains, entry->domain);
+    if (!domain)
+    {
+        // no this domain? need not remove it
+        tb_check_return_val(!remove, tb_true);
+
+        // make domain
+        domain = tb_malloc0_type(tb_cookies_domain_t);
+        tb_assert_and_check_return_val(domain, tb_false);
+        tb_list_entry_init(&domain->paths, tb_cookies_path_t, entry, tb_null);
+
+        // save domain
+        if (tb_hash_map_insert(cookies->domains, entry->domain, domain) == tb_iterator_tail(cookies->domains))
+        {
+            tb_free(domain);
+            return tb_false;
+        }
+    }
+
+    // get the path
+    tb_list_entry_ref_t     next = tb_null;
+    tb_cookies_path_ref_t   path = tb_cookies_path_find(domain, entry->path, &next);
+    if (!path)
+    {
+        // no this path? need not remove it
+        tb_check_return_val(!remove, tb_true);
+
+        // make path
+        path = tb_malloc0_type(tb_cookies_path_t);
+        tb_assert_and_check_return_val(path, tb_false);
+        tb_list_entry_init(&path->entries, tb_cookies_entry_t, entry, tb_null);
+        path->path = tb_string_pool_insert(cookies->string_pool, entry->path);
+        path->size = tb_strlen(entry->path);
+
+        // save path before the shorter paths
+        tb_list_entry_insert_prev(&domain->paths, next, &path->entry);
+    }
+
+    // remove the expired entries of this path
+    tb_cookies_path_clean(cookies, path, tb_cache_time());
 
-    // compare domain
-    tb_long_t ok = tb_strcmp(lentry->domain, rentry->domain);
-    tb_check_return_val(!ok, ok);
+    // get the entry
+    tb_cookies_entry_ref_t found = tb_cookies_entry_find(path, entry->name);
+    if (remove)
+    {
+        // remove the found entry
+        if (found)
+        {
+            tb_list_entry_remove(&path->entries, &found->entry);
+            tb_cookies_entry_free(cookies, found);
+        }
+    }
+    else
+    {
+        // make entry
+        tb_cookies_entry_ref_t saved = tb_malloc_type(tb_cookies_entry_t);
+        tb_assert_and_check_return_val(saved, tb_false);
+        *saved = *entry;
+        cookies->size++;
+
+        // replace the found entry or append a new entry
+        if (found)
+        {
+            tb_list_entry_replace(&path->entries, &found->entry, &saved->entry);
+            tb_cookies_entry_free(cookies, found);
+        }
+        else tb_list_entry_insert_tail(&path->entries, &saved->entry);
+    }
 
-    // compare domain
-    ok = tb_strcmp(lentry->path? lentry->path : "", rentry->path? rentry->path : "");
-    tb_check_return_val(!ok, ok);
+    // remove the empty path and domain
+    if (tb_list_entry_is_null(&path->entries))
+    {
+        tb_list_entry_remove(&domain->paths, &path->entry);
+        tb_cookies_path_free(cookies, path);
+    }
+    if (tb_list_entry_is_null(&domain->paths)) tb_hash_map_remove(cookies->domains, entry->domain);
 
-    // compare name
-    return tb_strcmp(lentry->name? lentry->name : "", rentry->name? rentry->name : "");
+    // ok
+    return tb_true;
 }
 static tb_bool_t tb_cookies_entry_init(tb_cookies_t* cookies, tb_cookies_entry_ref_t entry, tb_char_t const* domain, tb_char_t const* path, tb_bool_t secure, tb_char_t const* value)
 {
@@ -431,52 +701,6 @@ static tb_bool_t tb_cookies_entry_init(tb_cookies_t* cookies, tb_cookies_entry_r
     // ok
     return tb_true;
 }
-static tb_bool_t tb_cookies_entry_walk(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
-{
-    // check
-    tb_value_t* tuple = (tb_value_t*)value;
-    tb_assert(item && tuple);
-
-    // the entry
-    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)item;
-    tb_assert(entry && entry->domain);
-
-    // the domain
-    tb_char_t const* domain = tuple[0].cstr;
-
-    // the path
-    tb_char_t const* path = tuple[1].cstr;
-
-    // the secure
-    tb_size_t secure = tuple[2].ul;
-
-    // the value of key
-    tb_string_ref_t kvalue = (tb_string_ref_t)tuple[3].ptr;
-    tb_assert(kvalue);
-
-    // expired?
-    if (entry->expires && tb_cache_time() >= entry->expires)
-    {
-        // trace
-        tb_trace_d("expired: %s%s%s: %s = %s", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "");
-
-        // remove it
-        return tb_true;
-    }
-
-    // this cookies is at domain/path?
-    if (    tb_cookies_is_child_domain(entry->domain, domain)
-        &&  entry->path && entry->name 
-        &&  tb_cookies_is_child_path(entry->path, path)
-        &&  entry->secure == secure)
-    {
-        // append "key=value; "
-        tb_string_cstrfcat(kvalue, "%s=%s; ", entry->name, entry->value? entry->value : "");
-    }
-
-    // continue 
-    return tb_false;
-}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
@@ -514,22 +738,13 @@ tb_cookies_ref_t tb_cookies_init()
         cookies = tb_malloc0_type(tb_cookies_t);
         tb_assert_and_check_break(cookies);
 
-        // init lock
-        if (!tb_spinlock_init(&cookies->lock)) break;
-
         // init string pool
         cookies->string_pool = tb_string_pool_init(tb_true);
         tb_assert_and_check_break(cookies->string_pool);
 
-        // init cookie pool
-        tb_element_t element = tb_element_mem(sizeof(tb_cookies_entry_t), tb_cookies_entry_free, cookies);
-        element.hash = tb_cookies_entry_hash;
-        element.comp = tb_cookies_entry_comp;
-        cookies->cookie_pool = tb_hash_set_init(TB_HASH_SET_BUCKET_SIZE_MICRO, element);
-        tb_assert_and_check_break(cookies->cookie_pool);
-
-        // init string element
-        cookies->string_element = tb_element_str(tb_true);
+        // init domains
+        cookies->domains = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_str(tb_true), tb_element_ptr(tb_cookies_domain_free, cookies));
+        tb_assert_and_check_break(cookies->domains);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -559,21 +774,18 @@ tb_void_t tb_cookies_exit(tb_cookies_ref_t self)
     tb_assert_and_check_return(cookies);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_cookies_enter_write(cookies);
 
-    // exit cookie pool
-    if (cookies->cookie_pool) tb_hash_set_exit(cookies->cookie_pool);
-    cookies->cookie_pool = tb_null;
+    // exit domains
+    if (cookies->domains) tb_hash_map_exit(cookies->domains);
+    cookies->domains = tb_null;
     
     // exit string pool
     if (cookies->string_pool) tb_string_pool_exit(cookies->string_pool);
     cookies->string_pool = tb_null;
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
-
-    // exit lock
-    tb_spinlock_exit(&cookies->lock);
+    tb_cookies_leave_write(cookies);
 
     // exit it
     tb_free(cookies);
@@ -585,16 +797,17 @@ tb_void_t tb_cookies_clear(tb_cookies_ref_t self)
     tb_assert_and_check_return(cookies);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_cookies_enter_write(cookies);
 
-    // clear cookie pool
-    if (cookies->cookie_pool) tb_hash_set_clear(cookies->cookie_pool);
+    // clear domains
+    if (cookies->domains) tb_hash_map_clear(cookies->domains);
+    cookies->size = 0;
     
     // clear string pool
     if (cookies->string_pool) tb_string_pool_clear(cookies->string_pool);
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_cookies_leave_write(cookies);
 }
 tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char_t const* path, tb_bool_t secure, tb_char_t const* value)
 {
@@ -603,30 +816,32 @@ tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char
     tb_assert_and_check_return_val(cookies, tb_false);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_cookies_enter_write(cookies);
 
     // done
     tb_bool_t           ok = tb_false;
-    tb_cookies_entry_t  entry = {0};
+    tb_cookies_entry_t  entry = {{0}};
     do
     {
         // check
-        tb_assert_and_check_break(cookies->string_pool && cookies->cookie_pool);
+        tb_assert_and_check_break(cookies->string_pool && cookies->domains);
 
         // init entry
         if (!tb_cookies_entry_init(cookies, &entry, domain, path, secure, value)) break;
 
-        // maxage is zero? remove it
-        if (!entry.maxage && !entry.storage)
+        // no name? it will be never sent, ignore it
+        if (!entry.name)
         {
-            // remove it
-            tb_hash_set_remove(cookies->cookie_pool, &entry);
-
-            // exit it
             tb_cookies_entry_exit(cookies, &entry);
+            ok = tb_true;
+            break;
         }
-        // set entry
-        else tb_hash_set_insert(cookies->cookie_pool, &entry);
+
+        // save it to the domain index
+        if (!tb_cookies_entry_save(cookies, &entry)) break;
+
+        // maxage is zero? it has been removed, exit it
+        if (!entry.maxage && !entry.storage) tb_cookies_entry_exit(cookies, &entry);
 
         // storage to file?
         if (entry.storage)
@@ -648,7 +863,7 @@ tb_bool_t tb_cookies_set(tb_cookies_ref_t self, tb_char_t const* domain, tb_char
     }
     
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_cookies_leave_write(cookies);
 
     // ok?
     return ok;
@@ -684,43 +899,78 @@ tb_char_t const* tb_cookies_get(tb_cookies_ref_t self, tb_char_t const* domain,
     // clear value first
     tb_string_clear(value);
 
-    // enter
-    tb_spinlock_enter(&cookies->lock);
+    // no path? using the root path
+    if (!path || !path[0]) path = "/";
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
+    // skip '.'
+    if (*domain == '.') domain++;
+
+    // spak the cached time
+    tb_cache_time_spak();
+    tb_time_t now = tb_cache_time();
+
+    // enter
+    tb_cookies_enter_read(cookies);
+
+    /* get the matched values from this domain and all parent domains
+     *
+     * the parent domain must have one dot at least, .e.g www.space.baidu.com => space.baidu.com => baidu.com
+     */
+    tb_size_t           expired = 0;
+    tb_char_t const*    name = domain;
+    tb_char_t const*    dot = tb_null;
+    while (cookies->domains && (dot = tb_strchr(name, '.')))
     {
-        // check
-        tb_assert_and_check_break(cookies->string_pool && cookies->cookie_pool);
-    
-        // no path? using the root path
-        if (!path || !path[0]) path = "/";
+        // get the domain
+        tb_cookies_domain_ref_t cdomain = (tb_cookies_domain_ref_t)tb_hash_map_get(cookies->domains, name);
+        if (cdomain)
+        {
+            // walk the matched paths
+            tb_list_entry_ref_t item = tb_list_entry_head(&cdomain->paths);
+            for (; item != tb_list_entry_tail(&cdomain->paths); item = tb_list_entry_next(item))
+            {
+                // this path is matched?
+                tb_cookies_path_ref_t cpath = (tb_cookies_path_ref_t)tb_list_entry(&cdomain->paths, item);
+                tb_check_continue(tb_cookies_is_child_path(cpath->path, path));
 
-        // skip '.'
-        if (*domain == '.') domain++;
+                // walk the entries
+                tb_list_entry_ref_t node = tb_list_entry_head(&cpath->entries);
+                for (; node != tb_list_entry_tail(&cpath->entries); node = tb_list_entry_next(node))
+                {
+                    // expired? it will be removed later
+                    tb_cookies_entry_ref_t entry = (tb_cookies_entry_ref_t)tb_list_entry(&cpath->entries, node);
+                    if (entry->expires && now >= entry->expires)
+                    {
+                        expired++;
+                        continue;
+                    }
+
+                    // append "key=value; "
+                    if (entry->secure == (secure? 1 : 0)) tb_string_cstrfcat(value, "%s=%s; ", entry->name, entry->value? entry->value : "");
+                }
+            }
+        }
 
-        // spak the cached time
-        tb_cache_time_spak();
+        // the parent domain
+        name = dot + 1;
+    }
 
-        // get the matched values
-        tb_value_t tuple[4];
-        tuple[0].cstr   = domain;
-        tuple[1].cstr   = path;
-        tuple[2].ul     = secure? 1 : 0;
-        tuple[3].ptr    = value;
-        tb_remove_if(cookies->cookie_pool, tb_cookies_entry_walk, tuple);
+    // leave
+    tb_cookies_leave_read(cookies);
 
-        // ok
-        ok = tb_true;
+    // remove the expired entries of these domains
+    if (expired)
+    {
+        // enter
+        tb_cookies_enter_write(cookies);
 
-    } while (0);
+        // clean these domains
+        for (name = domain; cookies->domains && (dot = tb_strchr(name, '.')); name = dot + 1)
+            tb_cookies_domain_clean(cookies, name, now);
 
-    // failed?
-    if (!ok) tb_string_clear(value);
-    
-    // leave
-    tb_spinlock_leave(&cookies->lock);
+        // leave
+        tb_cookies_leave_write(cookies);
+    }
 
     // ok?
     return tb_string_size(value)? tb_string_cstr(value) : tb_null;
@@ -748,29 +998,37 @@ tb_void_t tb_cookies_dump(tb_cookies_ref_t self)
 {
     // check
     tb_cookies_t* cookies = (tb_cookies_t*)self;
-    tb_assert_and_check_return(cookies && cookies->cookie_pool);
+    tb_assert_and_check_return(cookies && cookies->domains);
 
     // enter
-    tb_spinlock_enter(&cookies->lock);
+    tb_cookies_enter_read(cookies);
 
     // dump
     tb_trace_i("");
-    tb_trace_i("cookie: size: %lu", tb_hash_set_size(cookies->cookie_pool));
-    tb_for_all_if (tb_cookies_entry_ref_t, entry, cookies->cookie_pool, entry)
+    tb_trace_i("cookie: size: %lu, domains: %lu", cookies->size, tb_hash_map_size(cookies->domains));
+    tb_for_all_if (tb_hash_map_item_ref_t, item, cookies->domains, item)
     {
-        // the entry
-        tb_assert_and_check_continue(entry->domain);
+        // the domain
+        tb_cookies_domain_ref_t domain = (tb_cookies_domain_ref_t)item->data;
+        tb_assert_and_check_continue(domain);
 
-        // the date
-        tb_tm_t date = {0};
-        tb_gmtime(entry->expires, &date);
+        // walk paths
+        tb_for_all_if (tb_cookies_path_ref_t, path, tb_list_entry_itor(&domain->paths), path)
+        {
+            tb_for_all_if (tb_cookies_entry_ref_t, entry, tb_list_entry_itor(&path->entries), entry)
+            {
+                // the date
+                tb_tm_t date = {0};
+                tb_gmtime(entry->expires, &date);
 
-        // trace
-        tb_trace_i("%s%s%s: %s = %s, expires: %04ld-%02ld-%02ld %02ld:%02ld:%02ld GMT, week: %d", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "", date.year, date.month, date.mday, date.hour, date.minute, date.second, date.week);
+                // trace
+                tb_trace_i("%s%s%s: %s = %s, expires: %04ld-%02ld-%02ld %02ld:%02ld:%02ld GMT, week: %d", entry->secure? "https://" : "http://", entry->domain, entry->path? entry->path : "", entry->name? entry->name : "", entry->value? entry->value : "", date.year, date.month, date.mday, date.hour, date.minute, date.second, date.week);
+            }
+        }
     }
 
     // leave
-    tb_spinlock_leave(&cookies->lock);
+    tb_cookies_leave_read(cookies);
 }
 #endif
 
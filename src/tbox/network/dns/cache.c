@@ -42,51 +42,86 @@
  * macros
  */
 
-// the cache maxn
+// the cache maxn and the shard count
 #ifdef __tb_small__
 #   define TB_DNS_CACHE_MAXN        (64)
+#   define TB_DNS_CACHE_SHARDN      (1)
 #else
-#   define TB_DNS_CACHE_MAXN        (256)
+#   define TB_DNS_CACHE_MAXN        (4096)
+#   define TB_DNS_CACHE_SHARDN      (16)
 #endif
 
+// the cache maxn of each shard
+#define TB_DNS_CACHE_SHARD_MAXN     (TB_DNS_CACHE_MAXN / TB_DNS_CACHE_SHARDN)
+
+// the address maxn of each family
+#ifdef __tb_small__
+#   define TB_DNS_CACHE_ADDR_MAXN   (2)
+#else
+#   define TB_DNS_CACHE_ADDR_MAXN   (4)
+#endif
+
+// the default ttl (s)
+#define TB_DNS_CACHE_TTL_DEFAULT    (600)
+
+// the maximum ttl (s)
+#define TB_DNS_CACHE_TTL_MAXN       (86400)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
-// the dns cache type
-typedef struct __tb_dns_cache_t
+// the dns cache address list type
+typedef struct __tb_dns_cache_list_t
 {
-    // the hash
-    tb_hash_map_ref_t       hash;
+    // the expired time (s)
+    tb_size_t               expired;
 
-    // the times
-    tb_hize_t               times;
+    // the address count, 0: not cached
+    tb_size_t               size;
 
-    // the expired
-    tb_size_t               expired;
+    // the addresses
+    tb_ipaddr_t             addrs[TB_DNS_CACHE_ADDR_MAXN];
 
-}tb_dns_cache_t;
+}tb_dns_cache_list_t;
 
 // the dns cache addr type
 typedef struct __tb_dns_cache_addr_t
 {
-    // the addr
-    tb_ipaddr_t             addr;
+    // the ipv4 and ipv6 address lists
+    tb_dns_cache_list_t     lists[2];
 
-    // the time
+    // the last access time
     tb_size_t               time;
 
 }tb_dns_cache_addr_t;
 
+// the dns cache shard type
+typedef struct __tb_dns_cache_shard_t
+{
+    // the lock
+    tb_spinlock_t           lock;
+
+    // the hash
+    tb_hash_map_ref_t       hash;
+
+    // the times
+    tb_hize_t               times;
+
+    // the expired access time for removing the old items
+    tb_size_t               expired;
+
+    // the current time for removing the expired items
+    tb_size_t               now;
+
+}__tb_cacheline_aligned__ tb_dns_cache_shard_t;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
 
-// the lock
-static tb_spinlock_t        g_lock = TB_SPINLOCK_INIT;
-
-// the cache
-static tb_dns_cache_t       g_cache = {0};
+// the cache shards
+static tb_dns_cache_shard_t g_shards[TB_DNS_CACHE_SHARDN];
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * helper
@@ -95,28 +130,46 @@ static __tb_inline__ tb_size_t tb_dns_cache_now()
 {
     return (tb_size_t)(tb_cache_time_spak() / 1000);
 }
+static __tb_inline__ tb_dns_cache_shard_t* tb_dns_cache_shard(tb_char_t const* name)
+{
+#if TB_DNS_CACHE_SHARDN > 1
+    // the hash of the host name, the host name is case-insensitive
+    tb_size_t hash = 0;
+    for (; *name; name++) hash = (hash * 131) + tb_tolower(*name);
+    return &g_shards[hash % TB_DNS_CACHE_SHARDN];
+#else
+    return &g_shards[0];
+#endif
+}
+static __tb_inline__ tb_size_t tb_dns_cache_index(tb_size_t family)
+{
+    return family == TB_IPADDR_FAMILY_IPV6? 1 : 0;
+}
 static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t item, tb_cpointer_t value)
 {
     // check
-    tb_assert(item);
+    tb_dns_cache_shard_t* shard = (tb_dns_cache_shard_t*)value;
+    tb_assert(item && shard);
 
     // the dns cache address
     tb_dns_cache_addr_t const* caddr = (tb_dns_cache_addr_t const*)((tb_hash_map_item_ref_t)item)->data;
     tb_assert(caddr);
 
-    // is expired?
+    // is expired? all address lists have been expired or it is not accessed recently
     tb_bool_t ok = tb_false;
-    if (caddr->time < g_cache.expired)
+    if (    caddr->time < shard->expired 
+        ||  (   (!caddr->lists[0].size || caddr->lists[0].expired <= shard->now)
+            &&  (!caddr->lists[1].size || caddr->lists[1].expired <= shard->now)))
     {
         // remove it
         ok = tb_true;
 
         // trace
-        tb_trace_d("del: %s => %{ipaddr}, time: %u, size: %u", (tb_char_t const*)item->name, &caddr->addr, caddr->time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("del: %s, time: %u, size: %u", (tb_char_t const*)((tb_hash_map_item_ref_t)item)->name, caddr->time, tb_hash_map_size(shard->hash));
 
         // update times
-        tb_assert(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
+        tb_assert(shard->times >= caddr->time);
+        shard->times -= caddr->time;
     }
 
     // ok?
@@ -128,24 +181,24 @@ static tb_bool_t tb_dns_cache_clear(tb_iterator_ref_t iterator, tb_cpointer_t it
  */
 tb_bool_t tb_dns_cache_init()
 {
-    // enter
-    tb_spinlock_enter(&g_lock);
-
     // done
-    tb_bool_t ok = tb_false;
-    do
+    tb_bool_t ok = tb_true;
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDN && ok; i++)
     {
-        // init hash
-        if (!g_cache.hash) g_cache.hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
-        tb_assert_and_check_break(g_cache.hash);
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
 
-        // ok
-        ok = tb_true;
+        // enter
+        tb_spinlock_enter(&shard->lock);
 
-    } while (0);
+        // init hash
+        if (!shard->hash) shard->hash = tb_hash_map_init(tb_align8(tb_isqrti(TB_DNS_CACHE_SHARD_MAXN) + 1), tb_element_str(tb_false), tb_element_mem(sizeof(tb_dns_cache_addr_t), tb_null, tb_null));
+        if (!shard->hash) ok = tb_false;
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
 
     // failed? exit it
     if (!ok) tb_dns_cache_exit();
@@ -155,21 +208,28 @@ tb_bool_t tb_dns_cache_init()
 }
 tb_void_t tb_dns_cache_exit()
 {
-    // enter
-    tb_spinlock_enter(&g_lock);
+    tb_size_t i = 0;
+    for (i = 0; i < TB_DNS_CACHE_SHARDN; i++)
+    {
+        // the shard
+        tb_dns_cache_shard_t* shard = &g_shards[i];
 
-    // exit hash
-    if (g_cache.hash) tb_hash_map_exit(g_cache.hash);
-    g_cache.hash = tb_null;
+        // enter
+        tb_spinlock_enter(&shard->lock);
 
-    // exit times
-    g_cache.times = 0;
+        // exit hash
+        if (shard->hash) tb_hash_map_exit(shard->hash);
+        shard->hash = tb_null;
 
-    // exit expired 
-    g_cache.expired = 0;
+        // exit times
+        shard->times = 0;
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+        // exit expired 
+        shard->expired = 0;
+
+        // leave
+        tb_spinlock_leave(&shard->lock);
+    }
 }
 tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
 {
@@ -195,98 +255,147 @@ tb_bool_t tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr)
     // clear address
     tb_ipaddr_clear(addr);
 
+    // get the ipv4 address first and get the ipv6 address if no ipv4
+    return (    tb_dns_cache_get_list(name, TB_IPADDR_FAMILY_IPV4, addr, 1)
+            ||  tb_dns_cache_get_list(name, TB_IPADDR_FAMILY_IPV6, addr, 1))? tb_true : tb_false;
+}
+tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_assert_and_check_return(name && addr);
+
+    // check address
+    tb_assert(!tb_ipaddr_ip_is_empty(addr));
+
+    // set it with the default ttl
+    tb_dns_cache_set_list(name, tb_ipaddr_family(addr), addr, 1, 0);
+}
+tb_size_t tb_dns_cache_get_list(tb_char_t const* name, tb_size_t family, tb_ipaddr_t* addrs, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(name && addrs && maxn, 0);
+
+    // the shard
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(name);
+
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_spinlock_enter(&shard->lock);
 
     // done
-    tb_bool_t ok = tb_false;
+    tb_size_t size = 0;
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
+        tb_assert_and_check_break(shard->hash);
 
         // get the host address
-        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(g_cache.hash, name);
+        tb_dns_cache_addr_t* caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, name);
         tb_check_break(caddr);
 
+        // expired?
+        tb_size_t               now = tb_dns_cache_now();
+        tb_dns_cache_list_t*    list = &caddr->lists[tb_dns_cache_index(family)];
+        tb_check_break(list->size && list->expired > now);
+
         // trace
-        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &caddr->addr, caddr->time, tb_dns_cache_now(), tb_hash_map_size(g_cache.hash));
+        tb_trace_d("get: %s => %{ipaddr}, time: %u => %u, size: %u", name, &list->addrs[0], caddr->time, now, tb_hash_map_size(shard->hash));
 
         // update time
-        tb_assert_and_check_break(g_cache.times >= caddr->time);
-        g_cache.times -= caddr->time;
-        caddr->time = tb_dns_cache_now();
-        g_cache.times += caddr->time;
-
-        // save address
-        tb_ipaddr_copy(addr, &caddr->addr);
+        tb_assert_and_check_break(shard->times >= caddr->time);
+        shard->times -= caddr->time;
+        caddr->time = now;
+        shard->times += caddr->time;
 
-        // ok
-        ok = tb_true;
+        // save addresses
+        for (size = 0; size < list->size && size < maxn; size++)
+            tb_ipaddr_copy(&addrs[size], &list->addrs[size]);
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave(&shard->lock);
 
     // ok?
-    return ok;
+    return size;
 }
-tb_void_t tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr)
+tb_void_t tb_dns_cache_set_list(tb_char_t const* name, tb_size_t family, tb_ipaddr_t const* addrs, tb_size_t size, tb_size_t ttl)
 {
     // check
-    tb_assert_and_check_return(name && addr);
-
-    // check address
-    tb_assert(!tb_ipaddr_ip_is_empty(addr));
+    tb_assert_and_check_return(name && addrs && size);
+    tb_assert_and_check_return(family == TB_IPADDR_FAMILY_IPV4 || family == TB_IPADDR_FAMILY_IPV6);
 
     // trace
-    tb_trace_d("set: %s => %{ipaddr}", name, addr);
+    tb_trace_d("set: %s => %{ipaddr}, size: %lu, ttl: %lu", name, &addrs[0], size, ttl);
+
+    // the shard
+    tb_dns_cache_shard_t* shard = tb_dns_cache_shard(name);
 
-    // init addr
-    tb_dns_cache_addr_t caddr;
-    caddr.time = tb_dns_cache_now();
-    tb_ipaddr_copy(&caddr.addr, addr);
+    // the time to live
+    if (!ttl) ttl = TB_DNS_CACHE_TTL_DEFAULT;
+    else if (ttl > TB_DNS_CACHE_TTL_MAXN) ttl = TB_DNS_CACHE_TTL_MAXN;
 
     // enter
-    tb_spinlock_enter(&g_lock);
+    tb_spinlock_enter(&shard->lock);
 
     // done
     do
     {
         // check
-        tb_assert_and_check_break(g_cache.hash);
+        tb_assert_and_check_break(shard->hash);
 
-        // remove the expired items if full
-        if (tb_hash_map_size(g_cache.hash) >= TB_DNS_CACHE_MAXN)
+        // get the host address
+        tb_size_t               now = tb_dns_cache_now();
+        tb_dns_cache_addr_t*    caddr = (tb_dns_cache_addr_t*)tb_hash_map_get(shard->hash, name);
+        if (!caddr)
         {
-            // the expired time
-            g_cache.expired = ((tb_size_t)(g_cache.times / tb_hash_map_size(g_cache.hash)) + 1);
-
-            // check
-            tb_assert_and_check_break(g_cache.expired);
+            // remove the expired and old items if full
+            if (tb_hash_map_size(shard->hash) >= TB_DNS_CACHE_SHARD_MAXN)
+            {
+                // the expired time
+                shard->now = now;
+                shard->expired = ((tb_size_t)(shard->times / tb_hash_map_size(shard->hash)) + 1);
 
-            // trace
-            tb_trace_d("expired: %lu", g_cache.expired);
+                // check
+                tb_assert_and_check_break(shard->expired);
 
-            // remove the expired times
-            tb_remove_if(g_cache.hash, tb_dns_cache_clear, tb_null);
-        }
+                // trace
+                tb_trace_d("expired: %lu", shard->expired);
 
-        // check
-        tb_assert_and_check_break(tb_hash_map_size(g_cache.hash) < TB_DNS_CACHE_MAXN);
+                // remove the expired items
+                tb_remove_if(shard->hash, tb_dns_cache_clear, shard);
+            }
 
-        // save addr
-        tb_hash_map_insert(g_cache.hash, name, &caddr);
+            // check
+            tb_assert_and_check_break(tb_hash_map_size(shard->hash) < TB_DNS_CACHE_SHARD_MAXN);
+
+            // insert a new address
+            tb_dns_cache_addr_t addr;
+            tb_memset(&addr, 0, sizeof(tb_dns_cache_addr_t));
+            addr.time = now;
+            tb_size_t itor = tb_hash_map_insert(shard->hash, name, &addr);
+            tb_assert_and_check_break(itor != tb_iterator_tail(shard->hash));
+
+            // the inserted address
+            caddr = (tb_dns_cache_addr_t*)((tb_hash_map_item_ref_t)tb_iterator_item(shard->hash, itor))->data;
+            tb_assert_and_check_break(caddr);
+            
+            // update times
+            shard->times += caddr->time;
+        }
 
-        // update times
-        g_cache.times += caddr.time;
+        // save addresses
+        tb_size_t               i = 0;
+        tb_dns_cache_list_t*    list = &caddr->lists[tb_dns_cache_index(family)];
+        for (i = 0; i < size && i < TB_DNS_CACHE_ADDR_MAXN; i++)
+            tb_ipaddr_copy(&list->addrs[i], (tb_ipaddr_ref_t)&addrs[i]);
+        list->size      = i;
+        list->expired   = now + ttl;
 
         // trace
-        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &caddr.addr, caddr.time, tb_hash_map_size(g_cache.hash));
+        tb_trace_d("set: %s => %{ipaddr}, time: %u, size: %u", name, &list->addrs[0], caddr->time, tb_hash_map_size(shard->hash));
 
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave(&shard->lock);
 }
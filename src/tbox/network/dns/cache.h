@@ -42,7 +42,7 @@ __tb_extern_c_enter__
 
 /*! init the cache list
  *
- * not using ctime default
+ * the cache is sharded by the host names and the entries will be expired by the ttl of the dns records
  *
  * @return          tb_true or tb_false
  */
@@ -52,6 +52,8 @@ tb_bool_t           tb_dns_cache_init(tb_noarg_t);
 tb_void_t           tb_dns_cache_exit(tb_noarg_t);
 
 /*! get addr from cache 
+ *
+ * the ipv4 address will be returned first if exists
  *
  * @param name      the host name 
  * @param addr      the host addr
@@ -60,13 +62,34 @@ tb_void_t           tb_dns_cache_exit(tb_noarg_t);
  */
 tb_bool_t           tb_dns_cache_get(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
-/*! set addr to cache 
+/*! set addr to cache with the default ttl
  *
  * @param name      the host name 
  * @param addr      the host addr
  */
 tb_void_t           tb_dns_cache_set(tb_char_t const* name, tb_ipaddr_ref_t addr);
 
+/*! get the address list of the given family from cache 
+ *
+ * @param name      the host name 
+ * @param family    the address family, TB_IPADDR_FAMILY_IPV4 or TB_IPADDR_FAMILY_IPV6
+ * @param addrs     the host addresses
+ * @param maxn      the maximum address count
+ *
+ * @return          the address count, 0: not found or expired
+ */
+tb_size_t           tb_dns_cache_get_list(tb_char_t const* name, tb_size_t family, tb_ipaddr_t* addrs, tb_size_t maxn);
+
+/*! set the address list of the given family to cache 
+ *
+ * @param name      the host name 
+ * @param family    the address family, TB_IPADDR_FAMILY_IPV4 or TB_IPADDR_FAMILY_IPV6
+ * @param addrs     the host addresses
+ * @param size      the address count
+ * @param ttl       the time to live (s) of the dns records, uses the default ttl if be zero
+ */
+tb_void_t           tb_dns_cache_set_list(tb_char_t const* name, tb_size_t family, tb_ipaddr_t const* addrs, tb_size_t size, tb_size_t ttl);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
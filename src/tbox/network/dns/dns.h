@@ -33,5 +33,6 @@
 #include "cache.h"
 #include "server.h"
 #include "looker.h"
+#include "resolver.h"
 
 #endif
@@ -0,0 +1,911 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        resolver.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME        "dns_resolver"
+#define TB_TRACE_MODULE_DEBUG       (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "resolver.h"
+#include "cache.h"
+#include "server.h"
+#include "../../libc/libc.h"
+#include "../../utils/utils.h"
+#include "../../math/math.h"
+#include "../../memory/memory.h"
+#include "../../container/container.h"
+#include "../../platform/platform.h"
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../../coroutine/coroutine.h"
+#   include "../../coroutine/impl/impl.h"
+#   define TB_DNS_RESOLVER_HAVE_COROUTINE
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the timeout (ms) of each try
+#define TB_DNS_RESOLVER_TIMEOUT             (2000)
+
+// the try count of each server
+#define TB_DNS_RESOLVER_TRYN                (2)
+
+// the maximum server count
+#define TB_DNS_RESOLVER_SERVER_MAXN         (4)
+
+// the maximum address count of each family
+#ifdef __tb_small__
+#   define TB_DNS_RESOLVER_ADDR_MAXN        (2)
+#else
+#   define TB_DNS_RESOLVER_ADDR_MAXN        (4)
+#endif
+
+// the maximum packet size (udp without edns)
+#define TB_DNS_RESOLVER_RPKT_MAXN           (512)
+
+// the maximum compression pointer hops of the name
+#define TB_DNS_RESOLVER_NAME_HOPS           (16)
+
+// the record types
+#define TB_DNS_RESOLVER_TYPE_A              (1)
+#define TB_DNS_RESOLVER_TYPE_AAAA           (28)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the dns resolver query state enum
+typedef enum __tb_dns_resolver_query_state_e
+{
+    TB_DNS_RESOLVER_QUERY_STATE_NONE        = 0     //!< not be used
+,   TB_DNS_RESOLVER_QUERY_STATE_CACHED      = 1     //!< the addresses are cached
+,   TB_DNS_RESOLVER_QUERY_STATE_SEND        = 2     //!< waiting to be sent
+,   TB_DNS_RESOLVER_QUERY_STATE_WAIT        = 3     //!< waiting for the response
+,   TB_DNS_RESOLVER_QUERY_STATE_DONE        = 4     //!< finished
+
+}tb_dns_resolver_query_state_e;
+
+// the dns resolver query type
+typedef struct __tb_dns_resolver_query_t
+{
+    // the list entry
+    tb_list_entry_t                         entry;
+
+    // the request
+    struct __tb_dns_resolver_request_t*     request;
+
+    // the sent time
+    tb_hong_t                               time;
+
+    // the minimum ttl of the answers
+    tb_uint32_t                             ttl;
+
+    // the query id
+    tb_uint16_t                             id;
+
+    // the record type
+    tb_uint16_t                             type;
+
+    // the server index
+    tb_uint16_t                             server;
+
+    // the try count
+    tb_uint16_t                             tryn;
+
+    // the state
+    tb_size_t                               state;
+
+    // the address count
+    tb_size_t                               size;
+
+    // the addresses
+    tb_ipaddr_t                             addrs[TB_DNS_RESOLVER_ADDR_MAXN];
+
+}tb_dns_resolver_query_t;
+
+// the dns resolver request type
+typedef struct __tb_dns_resolver_request_t
+{
+    // the queries: A and AAAA
+    tb_dns_resolver_query_t                 queries[2];
+
+    // the pending query count
+    tb_size_t                               pending;
+
+    // the func
+    tb_dns_resolver_func_t                  func;
+
+    // the user private data
+    tb_cpointer_t                           priv;
+
+    // the host name
+    tb_char_t                               name[TB_DNS_NAME_MAXN];
+
+}tb_dns_resolver_request_t;
+
+// the dns resolver type
+typedef struct __tb_dns_resolver_t
+{
+    // the socket
+    tb_socket_ref_t                         sock;
+
+    // the servers
+    tb_ipaddr_t                             servers[TB_DNS_RESOLVER_SERVER_MAXN];
+
+    // the server count
+    tb_size_t                               server_size;
+
+    // the queries waiting to be sent
+    tb_list_entry_head_t                    queries_send;
+
+    // the sent queries, sorted by the sent time
+    tb_list_entry_head_t                    queries_wait;
+
+    // the in-flight queries: id => query
+    tb_hash_map_ref_t                       ids;
+
+    // the pending request count
+    tb_size_t                               pending;
+
+    // the coroutine waiters of tb_dns_resolver_done()
+    tb_list_entry_head_t                    waiters;
+
+    // is one coroutine reading the responses?
+    tb_bool_t                               reading;
+
+    // the packet data
+    tb_byte_t                               data[TB_DNS_RESOLVER_RPKT_MAXN];
+
+}tb_dns_resolver_t;
+
+// the dns resolver waiter type of tb_dns_resolver_done()
+typedef struct __tb_dns_resolver_waiter_t
+{
+    // the list entry
+    tb_list_entry_t                         entry;
+
+    // the coroutine
+    tb_cpointer_t                           coroutine;
+
+    // is suspended?
+    tb_bool_t                               suspended;
+
+    // is finished?
+    tb_bool_t                               finished;
+
+    // the addresses
+    tb_ipaddr_t*                            addrs;
+
+    // the maximum address count
+    tb_size_t                               maxn;
+
+    // the address count
+    tb_size_t                               size;
+
+}tb_dns_resolver_waiter_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_size_t tb_dns_resolver_name_encode(tb_byte_t* data, tb_size_t maxn, tb_char_t const* name)
+{
+    // encode the labels, .e.g www.tboox.org => 3www5tboox3org0
+    tb_byte_t* p = data;
+    tb_byte_t* e = data + maxn;
+    while (*name)
+    {
+        // the label size
+        tb_char_t const* q = name;
+        while (*q && *q != '.') q++;
+        tb_size_t n = q - name;
+        tb_check_return_val(n && n < 64 && p + n + 1 < e, 0);
+
+        // save the label
+        *p++ = (tb_byte_t)n;
+        tb_memcpy(p, name, n);
+        p += n;
+
+        // the next label
+        name = *q? q + 1 : q;
+    }
+
+    // end
+    tb_check_return_val(p < e, 0);
+    *p++ = '\0';
+    return p - data;
+}
+static tb_byte_t const* tb_dns_resolver_name_skip(tb_byte_t const* p, tb_byte_t const* e)
+{
+    while (p < e)
+    {
+        // end?
+        tb_size_t n = *p;
+        if (!n) return p + 1;
+
+        // the compression pointer? it is the end of the name
+        if ((n & 0xc0) == 0xc0) return p + 2 <= e? p + 2 : tb_null;
+
+        // the label
+        tb_check_break(!(n & 0xc0));
+        p += n + 1;
+    }
+    return tb_null;
+}
+static tb_bool_t tb_dns_resolver_name_equal(tb_byte_t const* b, tb_byte_t const* e, tb_byte_t const* p, tb_char_t const* name)
+{
+    tb_size_t hops = 0;
+    while (p < e)
+    {
+        // end? the name must be end too
+        tb_size_t n = *p++;
+        if (!n) return (!name[0] || (name[0] == '.' && !name[1]))? tb_true : tb_false;
+
+        // the compression pointer? jump it
+        if ((n & 0xc0) == 0xc0)
+        {
+            tb_check_return_val(p < e && hops++ < TB_DNS_RESOLVER_NAME_HOPS, tb_false);
+            p = b + (((n & 0x3f) << 8) | *p);
+            continue;
+        }
+
+        // compare the label
+        tb_check_return_val(!(n & 0xc0) && p + n <= e, tb_false);
+        tb_check_return_val(!tb_strnicmp((tb_char_t const*)p, name, n), tb_false);
+        name += n;
+        p += n;
+
+        // the next label
+        if (*name == '.') name++;
+        else if (*name) return tb_false;
+    }
+    return tb_false;
+}
+static tb_bool_t tb_dns_resolver_server_from(tb_dns_resolver_t* resolver, tb_ipaddr_ref_t addr)
+{
+    // the response may be sent from the previous server after retrying
+    tb_size_t i = 0;
+    for (i = 0; i < resolver->server_size; i++)
+        if (tb_ipaddr_is_equal(&resolver->servers[i], addr)) return tb_true;
+    return tb_false;
+}
+static tb_bool_t tb_dns_resolver_server_load(tb_dns_resolver_t* resolver)
+{
+    // have servers?
+    tb_check_return_val(!resolver->server_size, tb_true);
+
+    // load the fastest servers of the system
+    tb_size_t   i = 0;
+    tb_ipaddr_t addrs[2];
+    tb_size_t   size = tb_dns_server_get(addrs);
+    for (i = 0; i < size; i++) tb_dns_resolver_server_add((tb_dns_resolver_ref_t)resolver, &addrs[i]);
+
+    // ok?
+    return resolver->server_size? tb_true : tb_false;
+}
+static tb_bool_t tb_dns_resolver_query_init(tb_dns_resolver_t* resolver, tb_dns_resolver_query_t* query)
+{
+    // too many in-flight queries?
+    tb_check_return_val(tb_hash_map_size(resolver->ids) < TB_MAXU16, tb_false);
+
+    // make a random id which is not used by other in-flight queries
+    tb_uint16_t id = 0;
+    do
+    {
+        id = (tb_uint16_t)tb_random_range(0, TB_MAXU16 + 1);
+
+    } while (tb_hash_map_get(resolver->ids, tb_u2p(id)));
+
+    // save the query
+    query->id       = id;
+    query->tryn     = 0;
+    query->server   = (tb_uint16_t)(id % resolver->server_size);
+    query->state    = TB_DNS_RESOLVER_QUERY_STATE_SEND;
+    tb_hash_map_insert(resolver->ids, tb_u2p(id), query);
+    tb_list_entry_insert_tail(&resolver->queries_send, &query->entry);
+    return tb_true;
+}
+static tb_void_t tb_dns_resolver_request_done(tb_dns_resolver_t* resolver, tb_dns_resolver_request_t* request)
+{
+    // merge the addresses, the ipv4 addresses are in front of the ipv6 addresses
+    tb_size_t   i = 0;
+    tb_size_t   size = 0;
+    tb_ipaddr_t addrs[TB_DNS_RESOLVER_ADDR_MAXN << 1];
+    for (i = 0; i < tb_arrayn(request->queries); i++)
+    {
+        // the query
+        tb_dns_resolver_query_t* query = &request->queries[i];
+        tb_check_continue(query->state != TB_DNS_RESOLVER_QUERY_STATE_NONE && query->size);
+
+        // save the new addresses to cache
+        if (query->state == TB_DNS_RESOLVER_QUERY_STATE_DONE)
+            tb_dns_cache_set_list(request->name, i? TB_IPADDR_FAMILY_IPV6 : TB_IPADDR_FAMILY_IPV4, query->addrs, query->size, query->ttl);
+
+        // save the addresses
+        tb_memcpy(addrs + size, query->addrs, query->size * sizeof(tb_ipaddr_t));
+        size += query->size;
+    }
+
+    // trace
+    tb_trace_d("done: %s, size: %lu", request->name, size);
+
+    // done func
+    if (request->func) request->func((tb_dns_resolver_ref_t)resolver, request->name, addrs, size, request->priv);
+
+    // exit request
+    tb_free(request);
+}
+static tb_void_t tb_dns_resolver_query_done(tb_dns_resolver_t* resolver, tb_dns_resolver_query_t* query)
+{
+    // remove it from the send or wait list
+    tb_assert_and_check_return(query->state == TB_DNS_RESOLVER_QUERY_STATE_SEND || query->state == TB_DNS_RESOLVER_QUERY_STATE_WAIT);
+    tb_list_entry_remove(query->state == TB_DNS_RESOLVER_QUERY_STATE_SEND? &resolver->queries_send : &resolver->queries_wait, &query->entry);
+
+    // remove the id
+    tb_hash_map_remove(resolver->ids, tb_u2p(query->id));
+    query->state = TB_DNS_RESOLVER_QUERY_STATE_DONE;
+
+    // the request has been finished?
+    tb_dns_resolver_request_t* request = query->request;
+    tb_assert(request->pending);
+    if (!--request->pending)
+    {
+        // done request
+        tb_assert(resolver->pending);
+        resolver->pending--;
+        tb_dns_resolver_request_done(resolver, request);
+    }
+}
+static tb_void_t tb_dns_resolver_query_retry(tb_dns_resolver_t* resolver, tb_dns_resolver_query_t* query)
+{
+    // too many tries? failed
+    if (++query->tryn >= resolver->server_size * TB_DNS_RESOLVER_TRYN)
+    {
+        // trace
+        tb_trace_d("failed: %s, type: %u", query->request->name, query->type);
+
+        // done it
+        query->size = 0;
+        tb_dns_resolver_query_done(resolver, query);
+        return ;
+    }
+
+    // trace
+    tb_trace_d("retry: %s, type: %u, tryn: %u", query->request->name, query->type, query->tryn);
+
+    // move it to the send list and try the next server
+    if (query->state == TB_DNS_RESOLVER_QUERY_STATE_WAIT)
+    {
+        tb_list_entry_remove(&resolver->queries_wait, &query->entry);
+        tb_list_entry_insert_tail(&resolver->queries_send, &query->entry);
+        query->state = TB_DNS_RESOLVER_QUERY_STATE_SEND;
+    }
+    query->server = (tb_uint16_t)((query->server + 1) % resolver->server_size);
+}
+static tb_void_t tb_dns_resolver_send(tb_dns_resolver_t* resolver)
+{
+    // send the pending queries
+    while (!tb_list_entry_is_null(&resolver->queries_send))
+    {
+        // the query
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->queries_send, tb_list_entry_head(&resolver->queries_send));
+
+        /* make the query packet
+         *
+         * id: 16 bits
+         * flags: rd = 1
+         * qdcount: 1, ancount: 0, nscount: 0, arcount: 0
+         * question: qname, qtype, qclass (in)
+         */
+        tb_byte_t* p = resolver->data;
+        tb_bits_set_u16_be(p, query->id);   p += 2;
+        tb_bits_set_u16_be(p, 0x0100);      p += 2;
+        tb_bits_set_u16_be(p, 1);           p += 2;
+        tb_bits_set_u16_be(p, 0);           p += 2;
+        tb_bits_set_u16_be(p, 0);           p += 2;
+        tb_bits_set_u16_be(p, 0);           p += 2;
+        tb_size_t n = tb_dns_resolver_name_encode(p, resolver->data + sizeof(resolver->data) - p - 4, query->request->name);
+        if (!n)
+        {
+            // invalid name? failed
+            query->size = 0;
+            tb_dns_resolver_query_done(resolver, query);
+            continue;
+        }
+        p += n;
+        tb_bits_set_u16_be(p, query->type); p += 2;
+        tb_bits_set_u16_be(p, 1);           p += 2;
+
+        // send it
+        tb_long_t real = tb_socket_usend(resolver->sock, &resolver->servers[query->server], resolver->data, p - resolver->data);
+
+        // no space now? continue to send it after the socket is writable
+        tb_check_break(real);
+
+        // failed? try the next server
+        if (real < 0)
+        {
+            tb_dns_resolver_query_retry(resolver, query);
+            continue;
+        }
+
+        // trace
+        tb_trace_d("send: %s, type: %u, id: %u, server: %{ipaddr}", query->request->name, query->type, query->id, &resolver->servers[query->server]);
+
+        // wait the response
+        query->time     = tb_mclock();
+        query->state    = TB_DNS_RESOLVER_QUERY_STATE_WAIT;
+        tb_list_entry_remove(&resolver->queries_send, &query->entry);
+        tb_list_entry_insert_tail(&resolver->queries_wait, &query->entry);
+    }
+}
+static tb_void_t tb_dns_resolver_resp(tb_dns_resolver_t* resolver, tb_ipaddr_ref_t from, tb_byte_t const* data, tb_size_t size)
+{
+    // check the header
+    tb_check_return(size >= 12);
+
+    /* parse the header
+     *
+     * id: 16 bits
+     * flags: qr: 1, opcode: 4, aa: 1, tc: 1, rd: 1, ra: 1, z: 3, rcode: 4
+     * qdcount, ancount, nscount, arcount: 16 bits
+     */
+    tb_uint16_t id      = tb_bits_get_u16_be(data);
+    tb_uint16_t flags   = tb_bits_get_u16_be(data + 2);
+    tb_uint16_t qdcount = tb_bits_get_u16_be(data + 4);
+    tb_uint16_t ancount = tb_bits_get_u16_be(data + 6);
+    tb_check_return((flags & 0x8000) && qdcount == 1);
+
+    // the query
+    tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_hash_map_get(resolver->ids, tb_u2p(id));
+    tb_check_return(query && query->state == TB_DNS_RESOLVER_QUERY_STATE_WAIT);
+
+    // from the server?
+    tb_check_return(tb_dns_resolver_server_from(resolver, from));
+
+    // check the question
+    tb_byte_t const*    e = data + size;
+    tb_byte_t const*    p = data + 12;
+    tb_check_return(tb_dns_resolver_name_equal(data, e, p, query->request->name));
+    p = tb_dns_resolver_name_skip(p, e);
+    tb_check_return(p && p + 4 <= e);
+    tb_check_return(tb_bits_get_u16_be(p) == query->type && tb_bits_get_u16_be(p + 2) == 1);
+    p += 4;
+
+    // trace
+    tb_trace_d("resp: %s, type: %u, id: %u, rcode: %u, ancount: %u", query->request->name, query->type, id, flags & 0xf, ancount);
+
+    // the name does not exist? done it
+    tb_size_t rcode = flags & 0xf;
+    if (rcode == 3)
+    {
+        query->size = 0;
+        tb_dns_resolver_query_done(resolver, query);
+        return ;
+    }
+
+    // the server failed or refused? try the next server
+    if (rcode)
+    {
+        tb_dns_resolver_query_retry(resolver, query);
+        return ;
+    }
+
+    // parse the answers, the cname records will be skipped
+    tb_size_t   i = 0;
+    tb_size_t   rdlen = query->type == TB_DNS_RESOLVER_TYPE_A? 4 : 16;
+    tb_uint32_t ttl = TB_MAXU32;
+    query->size = 0;
+    for (i = 0; i < ancount && query->size < TB_DNS_RESOLVER_ADDR_MAXN; i++)
+    {
+        // skip the name
+        p = tb_dns_resolver_name_skip(p, e);
+        tb_check_break(p && p + 10 <= e);
+
+        // the type, class, ttl and rdlength
+        tb_uint16_t rtype   = tb_bits_get_u16_be(p);
+        tb_uint16_t rclass  = tb_bits_get_u16_be(p + 2);
+        tb_uint32_t rttl    = tb_bits_get_u32_be(p + 4);
+        tb_size_t   rsize   = tb_bits_get_u16_be(p + 8);
+        p += 10;
+        tb_check_break(p + rsize <= e);
+
+        // save the address
+        if (rtype == query->type && rclass == 1 && rsize == rdlen)
+        {
+            tb_ipaddr_ref_t addr = &query->addrs[query->size++];
+            if (rtype == TB_DNS_RESOLVER_TYPE_A)
+            {
+                tb_ipv4_t ipv4;
+                tb_memcpy(ipv4.u8, p, 4);
+                tb_ipaddr_ipv4_set(addr, &ipv4);
+            }
+            else
+            {
+                tb_ipv6_t ipv6;
+                ipv6.scope_id = 0;
+                tb_memcpy(ipv6.addr.u8, p, 16);
+                tb_ipaddr_ipv6_set(addr, &ipv6);
+            }
+            tb_ipaddr_port_set(addr, 0);
+            if (rttl < ttl) ttl = rttl;
+        }
+        p += rsize;
+    }
+
+    // done it
+    query->ttl = query->size? ttl : 0;
+    tb_dns_resolver_query_done(resolver, query);
+}
+static tb_void_t tb_dns_resolver_recv(tb_dns_resolver_t* resolver)
+{
+    // recv the responses
+    tb_ipaddr_t from;
+    while (1)
+    {
+        // recv it
+        tb_long_t real = tb_socket_urecv(resolver->sock, &from, resolver->data, sizeof(resolver->data));
+
+        // no data or failed? the timed out queries will be retried
+        tb_check_break(real > 0);
+
+        // handle it
+        tb_dns_resolver_resp(resolver, &from, resolver->data, real);
+    }
+}
+static tb_void_t tb_dns_resolver_timeout(tb_dns_resolver_t* resolver)
+{
+    // retry the timed out queries, the wait list is sorted by the sent time
+    tb_hong_t now = tb_mclock();
+    while (!tb_list_entry_is_null(&resolver->queries_wait))
+    {
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->queries_wait, tb_list_entry_head(&resolver->queries_wait));
+        tb_check_break(query->time + TB_DNS_RESOLVER_TIMEOUT <= now);
+        tb_dns_resolver_query_retry(resolver, query);
+    }
+}
+static tb_void_t tb_dns_resolver_cancel(tb_dns_resolver_t* resolver)
+{
+    // finish all queries as failed
+    while (!tb_list_entry_is_null(&resolver->queries_send))
+    {
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->queries_send, tb_list_entry_head(&resolver->queries_send));
+        query->size = 0;
+        tb_dns_resolver_query_done(resolver, query);
+    }
+    while (!tb_list_entry_is_null(&resolver->queries_wait))
+    {
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->queries_wait, tb_list_entry_head(&resolver->queries_wait));
+        query->size = 0;
+        tb_dns_resolver_query_done(resolver, query);
+    }
+}
+static tb_void_t tb_dns_resolver_waiter_func(tb_dns_resolver_ref_t self, tb_char_t const* name, tb_ipaddr_t const* addrs, tb_size_t size, tb_cpointer_t priv)
+{
+    // the waiter
+    tb_dns_resolver_waiter_t* waiter = (tb_dns_resolver_waiter_t*)priv;
+    tb_assert_and_check_return(waiter);
+
+    // save the addresses
+    waiter->size = tb_min(size, waiter->maxn);
+    if (waiter->size) tb_memcpy(waiter->addrs, addrs, waiter->size * sizeof(tb_ipaddr_t));
+    waiter->finished = tb_true;
+
+#ifdef TB_DNS_RESOLVER_HAVE_COROUTINE
+    // resume the suspended coroutine
+    if (waiter->suspended)
+    {
+        tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+        tb_list_entry_remove(&resolver->waiters, &waiter->entry);
+        waiter->suspended = tb_false;
+        tb_coroutine_resume((tb_coroutine_ref_t)waiter->coroutine, tb_null);
+    }
+#endif
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_dns_resolver_ref_t tb_dns_resolver_init()
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_dns_resolver_t*  resolver = tb_null;
+    do
+    {
+        // make resolver
+        resolver = tb_malloc0_type(tb_dns_resolver_t);
+        tb_assert_and_check_break(resolver);
+
+        // init the query lists
+        tb_list_entry_init(&resolver->queries_send, tb_dns_resolver_query_t, entry, tb_null);
+        tb_list_entry_init(&resolver->queries_wait, tb_dns_resolver_query_t, entry, tb_null);
+
+        // init the waiters
+        tb_list_entry_init(&resolver->waiters, tb_dns_resolver_waiter_t, entry, tb_null);
+
+        // init ids
+        resolver->ids = tb_hash_map_init(TB_HASH_MAP_BUCKET_SIZE_MICRO, tb_element_size(), tb_element_ptr(tb_null, tb_null));
+        tb_assert_and_check_break(resolver->ids);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (resolver) tb_dns_resolver_exit((tb_dns_resolver_ref_t)resolver);
+        resolver = tb_null;
+    }
+
+    // ok?
+    return (tb_dns_resolver_ref_t)resolver;
+}
+tb_void_t tb_dns_resolver_exit(tb_dns_resolver_ref_t self)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return(resolver);
+
+    // finish the pending requests
+    tb_dns_resolver_cancel(resolver);
+
+    // exit ids
+    if (resolver->ids) tb_hash_map_exit(resolver->ids);
+    resolver->ids = tb_null;
+
+    // exit sock
+    if (resolver->sock) tb_socket_exit(resolver->sock);
+    resolver->sock = tb_null;
+
+    // exit it
+    tb_free(resolver);
+}
+tb_bool_t tb_dns_resolver_server_add(tb_dns_resolver_ref_t self, tb_ipaddr_ref_t addr)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && addr && !tb_ipaddr_is_empty(addr), tb_false);
+
+    // full?
+    tb_check_return_val(resolver->server_size < TB_DNS_RESOLVER_SERVER_MAXN, tb_false);
+
+    // all queries are sent by one socket, so the server family must be same as the first server
+    if (resolver->server_size && tb_ipaddr_family(addr) != tb_ipaddr_family(&resolver->servers[0])) return tb_false;
+
+    // init sock
+    if (!resolver->sock)
+    {
+        resolver->sock = tb_socket_init(TB_SOCKET_TYPE_UDP, tb_ipaddr_family(addr));
+        tb_assert_and_check_return_val(resolver->sock, tb_false);
+    }
+
+    // save server
+    tb_ipaddr_ref_t server = &resolver->servers[resolver->server_size++];
+    tb_ipaddr_copy(server, addr);
+    if (!tb_ipaddr_port(server)) tb_ipaddr_port_set(server, TB_DNS_HOST_PORT);
+
+    // trace
+    tb_trace_d("server: %{ipaddr}", server);
+
+    // ok
+    return tb_true;
+}
+tb_bool_t tb_dns_resolver_post(tb_dns_resolver_ref_t self, tb_char_t const* name, tb_size_t family, tb_dns_resolver_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && name && func, tb_false);
+
+    // check the name
+    tb_size_t size = tb_strlen(name);
+    tb_check_return_val(size && size < 254, tb_false);
+
+    // is addr or localhost?
+    tb_ipaddr_t addr;
+    if (tb_ipaddr_ip_cstr_set(&addr, name, (tb_uint8_t)family) || (family != TB_IPADDR_FAMILY_IPV6 && !tb_stricmp(name, "localhost") && tb_dns_cache_get(name, &addr)))
+    {
+        func(self, name, &addr, 1, priv);
+        return tb_true;
+    }
+
+    // make request
+    tb_dns_resolver_request_t* request = tb_malloc0_type(tb_dns_resolver_request_t);
+    tb_assert_and_check_return_val(request, tb_false);
+    tb_strlcpy(request->name, name, sizeof(request->name));
+    request->func = func;
+    request->priv = priv;
+
+    // get the cached addresses of the given family, only query the missing families
+    tb_size_t i = 0;
+    tb_size_t queryn = 0;
+    for (i = 0; i < tb_arrayn(request->queries); i++)
+    {
+        // the query family
+        tb_size_t query_family = i? TB_IPADDR_FAMILY_IPV6 : TB_IPADDR_FAMILY_IPV4;
+        tb_check_continue(family == TB_IPADDR_FAMILY_NONE || family == query_family);
+
+        // init query
+        tb_dns_resolver_query_t* query = &request->queries[i];
+        query->request  = request;
+        query->type     = i? TB_DNS_RESOLVER_TYPE_AAAA : TB_DNS_RESOLVER_TYPE_A;
+        query->size     = tb_dns_cache_get_list(name, query_family, query->addrs, TB_DNS_RESOLVER_ADDR_MAXN);
+        if (query->size) query->state = TB_DNS_RESOLVER_QUERY_STATE_CACHED;
+        else queryn++;
+    }
+
+    // all addresses are cached? done it directly
+    if (!queryn)
+    {
+        tb_dns_resolver_request_done(resolver, request);
+        return tb_true;
+    }
+
+    // no servers?
+    if (!tb_dns_resolver_server_load(resolver))
+    {
+        tb_free(request);
+        return tb_false;
+    }
+
+    // post the missing queries
+    for (i = 0; i < tb_arrayn(request->queries); i++)
+    {
+        tb_dns_resolver_query_t* query = &request->queries[i];
+        if (query->request && query->state == TB_DNS_RESOLVER_QUERY_STATE_NONE)
+        {
+            if (tb_dns_resolver_query_init(resolver, query)) request->pending++;
+            else query->request = tb_null;
+        }
+    }
+
+    // failed?
+    if (!request->pending)
+    {
+        tb_free(request);
+        return tb_false;
+    }
+
+    // trace
+    tb_trace_d("post: %s, queries: %lu", name, request->pending);
+
+    // ok
+    resolver->pending++;
+    return tb_true;
+}
+tb_long_t tb_dns_resolver_spak(tb_dns_resolver_ref_t self, tb_long_t timeout)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver, -1);
+
+    // no pending requests?
+    tb_check_return_val(resolver->pending, 0);
+    tb_assert_and_check_return_val(resolver->sock, -1);
+
+    // send the pending queries
+    tb_dns_resolver_send(resolver);
+
+    // wait until the first sent query is timed out
+    tb_long_t wait = timeout;
+    if (!tb_list_entry_is_null(&resolver->queries_wait))
+    {
+        tb_dns_resolver_query_t* query = (tb_dns_resolver_query_t*)tb_list_entry(&resolver->queries_wait, tb_list_entry_head(&resolver->queries_wait));
+        tb_long_t left = (tb_long_t)(query->time + TB_DNS_RESOLVER_TIMEOUT - tb_mclock());
+        if (left < 0) left = 0;
+        if (wait < 0 || wait > left) wait = left;
+    }
+
+    // wait events
+    tb_size_t events = TB_SOCKET_EVENT_RECV;
+    if (!tb_list_entry_is_null(&resolver->queries_send)) events |= TB_SOCKET_EVENT_SEND;
+    tb_long_t real = tb_socket_wait(resolver->sock, events, wait);
+
+    // failed? finish all requests
+    if (real < 0)
+    {
+        tb_dns_resolver_cancel(resolver);
+        return -1;
+    }
+
+    // recv the responses
+    if (real & TB_SOCKET_EVENT_RECV) tb_dns_resolver_recv(resolver);
+
+    // retry the timed out queries
+    tb_dns_resolver_timeout(resolver);
+
+    // ok
+    return (tb_long_t)resolver->pending;
+}
+tb_size_t tb_dns_resolver_done(tb_dns_resolver_ref_t self, tb_char_t const* name, tb_size_t family, tb_ipaddr_t* addrs, tb_size_t maxn)
+{
+    // check
+    tb_dns_resolver_t* resolver = (tb_dns_resolver_t*)self;
+    tb_assert_and_check_return_val(resolver && name && addrs && maxn, 0);
+
+    // init waiter
+    tb_dns_resolver_waiter_t waiter;
+    tb_memset(&waiter, 0, sizeof(waiter));
+    waiter.addrs = addrs;
+    waiter.maxn  = maxn;
+#ifdef TB_DNS_RESOLVER_HAVE_COROUTINE
+    waiter.coroutine = (tb_cpointer_t)tb_coroutine_self();
+#endif
+
+    // post it
+    if (!tb_dns_resolver_post(self, name, family, tb_dns_resolver_waiter_func, &waiter)) return 0;
+
+    // wait it
+    while (!waiter.finished)
+    {
+#ifdef TB_DNS_RESOLVER_HAVE_COROUTINE
+        /* another coroutine is reading the responses?
+         *
+         * suspend and wait to be resumed after our request has been finished
+         * or the reader hands off the socket to us
+         */
+        if (waiter.coroutine && resolver->reading)
+        {
+            tb_list_entry_insert_tail(&resolver->waiters, &waiter.entry);
+            waiter.suspended = tb_true;
+            tb_coroutine_suspend(tb_null);
+            continue;
+        }
+#endif
+
+        // read the responses until our request has been finished
+        resolver->reading = tb_true;
+        while (!waiter.finished && tb_dns_resolver_spak(self, -1) > 0) ;
+        resolver->reading = tb_false;
+
+#ifdef TB_DNS_RESOLVER_HAVE_COROUTINE
+        // the socket is still bound to the poller of this coroutine, cancel it for the next reader
+        tb_co_scheduler_io_ref_t scheduler_io = tb_null;
+        if (waiter.coroutine && resolver->sock && (scheduler_io = tb_co_scheduler_io_self()))
+            tb_co_scheduler_io_cancel(scheduler_io, resolver->sock);
+
+        // hand off the socket to the next waiter
+        if (!tb_list_entry_is_null(&resolver->waiters))
+        {
+            tb_dns_resolver_waiter_t* next = (tb_dns_resolver_waiter_t*)tb_list_entry(&resolver->waiters, tb_list_entry_head(&resolver->waiters));
+            tb_list_entry_remove(&resolver->waiters, &next->entry);
+            next->suspended = tb_false;
+            tb_coroutine_resume((tb_coroutine_ref_t)next->coroutine, tb_null);
+        }
+#endif
+    }
+
+    // ok?
+    return waiter.size;
+}
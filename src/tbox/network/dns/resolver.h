@@ -0,0 +1,135 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ *
+ * @author      ruki
+ * @file        resolver.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_DNS_RESOLVER_H
+#define TB_NETWORK_DNS_RESOLVER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the dns resolver type
+typedef __tb_typeref__(dns_resolver);
+
+/*! the dns resolver func type
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param addrs     the host addresses, the ipv4 addresses are in front of the ipv6 addresses
+ * @param size      the address count, 0: failed
+ * @param priv      the user private data
+ */
+typedef tb_void_t   (*tb_dns_resolver_func_t)(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_ipaddr_t const* addrs, tb_size_t size, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the dns resolver
+ *
+ * all queries are multiplexed over one udp socket and matched by the query id,
+ * the timed out queries will be retried across the dns servers.
+ *
+ * @note the resolver is not thread-safe, please use one resolver for each thread or coroutine scheduler
+ *
+ * @return          the resolver
+ */
+tb_dns_resolver_ref_t   tb_dns_resolver_init(tb_noarg_t);
+
+/*! exit the dns resolver, the pending requests will be finished as failed
+ *
+ * @param resolver  the resolver
+ */
+tb_void_t               tb_dns_resolver_exit(tb_dns_resolver_ref_t resolver);
+
+/*! add the dns server
+ *
+ * the servers of tb_dns_server_get() will be used if no servers are added
+ *
+ * @param resolver  the resolver
+ * @param addr      the server address, the port is 53 if not be set
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_dns_resolver_server_add(tb_dns_resolver_ref_t resolver, tb_ipaddr_ref_t addr);
+
+/*! post a lookup request
+ *
+ * the func will be called in tb_dns_resolver_spak() after the request has been finished, 
+ * or be called in this function directly if the addresses are cached.
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param family    the address family, TB_IPADDR_FAMILY_NONE: ipv4 and ipv6 (A and AAAA queries)
+ * @param func      the func
+ * @param priv      the user private data
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_dns_resolver_post(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_size_t family, tb_dns_resolver_func_t func, tb_cpointer_t priv);
+
+/*! send the pending queries, wait and handle the responses and the timed out queries
+ *
+ * it will suspend the current coroutine instead of blocking the thread if be called in coroutine
+ *
+ * @param resolver  the resolver
+ * @param timeout   the timeout, infinity: -1
+ *
+ * @return          > 0: the pending request count, 0: all requests have been finished, -1: failed
+ */
+tb_long_t               tb_dns_resolver_spak(tb_dns_resolver_ref_t resolver, tb_long_t timeout);
+
+/*! lookup the host addresses
+ *
+ * it will suspend the current coroutine instead of blocking the thread if be called in coroutine,
+ * and the coroutines of the same scheduler can share one resolver.
+ *
+ * @param resolver  the resolver
+ * @param name      the host name
+ * @param family    the address family, TB_IPADDR_FAMILY_NONE: ipv4 and ipv6
+ * @param addrs     the host addresses, the ipv4 addresses are in front of the ipv6 addresses
+ * @param maxn      the maximum address count
+ *
+ * @return          the address count, 0: failed
+ */
+tb_size_t               tb_dns_resolver_done(tb_dns_resolver_ref_t resolver, tb_char_t const* name, tb_size_t family, tb_ipaddr_t* addrs, tb_size_t maxn);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -34,6 +34,7 @@
  * includes
  */
 #include "http.h"
+#include "http_pool.h"
 #include "impl/http/date.h"
 #include "impl/http/option.h"
 #include "impl/http/status.h"
@@ -76,9 +77,24 @@ typedef struct __tb_http_t
     // the head
     tb_hash_map_ref_t   head;
 
+    // the body offset of the sstream
+    tb_hize_t           body;
+
     // is opened?
     tb_bool_t           bopened;
 
+    // is the kept-alive connection reused from the pool?
+    tb_bool_t           breused;
+
+    // is the sstream loaded from the pool?
+    tb_bool_t           bpooled;
+
+    // has been killed?
+    tb_bool_t           bkilled;
+
+    // the lock of the stream for killing it from the other thread
+    tb_spinlock_t       lock;
+
     // the request data
     tb_string_t         request;
 
@@ -93,32 +109,133 @@ typedef struct __tb_http_t
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_bool_t tb_http_reusable(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http, tb_false);
+
+    // keep-alive and the response head has been finished?
+    tb_check_return_val(http->sstream && http->body && http->option.balived && http->status.balived, tb_false);
+
+    // no response body?
+    tb_size_t code = http->status.code;
+    if (http->option.method == TB_HTTP_METHOD_HEAD || code == 204 || code == 304) return tb_true;
+
+    // chunked? all chunks have been read
+    if (http->status.bchunked)
+    {
+        tb_filter_ref_t filter = tb_null;
+        return (    http->cstream
+                &&  tb_stream_ctrl(http->cstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)
+                &&  filter
+                &&  tb_filter_beof(filter))? tb_true : tb_false;
+    }
+
+    // the whole content has been read? 
+    return (    http->status.content_size >= 0
+            &&  tb_stream_offset(http->sstream) == http->body + http->status.content_size)? tb_true : tb_false;
+}
+static tb_void_t tb_http_release(tb_http_t* http, tb_bool_t balived)
+{
+    // check
+    tb_assert_and_check_return(http);
+
+    // trace
+    tb_trace_d("release: alived: %d, pooled: %d", balived, http->bpooled);
+
+    // keep the connection alive after closing it?
+    if (http->sstream) tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, balived);
+
+    // close stream, the sstream will also be closed by the chunked and zip stream
+    if (http->stream) tb_stream_clos(http->stream);
+    if (http->sstream) tb_stream_clos(http->sstream);
+
+    // switch to sstream
+    tb_spinlock_enter(&http->lock);
+    http->stream = http->sstream;
+
+    /* detach the pooled sstream with the lock before saving it to the pool,
+     * so tb_http_kill() will not kill it after it has been reused by the other http
+     */
+    tb_stream_ref_t sstream = tb_null;
+    if (http->bpooled && http->sstream)
+    {
+        sstream = http->sstream;
+        http->sstream = tb_null;
+        http->stream = tb_null;
+    }
+
+    // the killed connection cannot be kept alive
+    if (http->bkilled) balived = tb_false;
+    tb_spinlock_leave(&http->lock);
+
+    // save it to the pool, will close it directly if not be kept alive
+    if (sstream) tb_http_pool_save(tb_http_pool(), sstream, balived);
+}
+static tb_void_t tb_http_unkill(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return(http);
+
+    // clear the killed state after closing it, it can be opened again
+    tb_spinlock_enter(&http->lock);
+    http->bkilled = tb_false;
+    tb_spinlock_leave(&http->lock);
+}
 static tb_bool_t tb_http_connect(tb_http_t* http)
 {
     // check
-    tb_assert_and_check_return_val(http && http->stream, tb_false);
+    tb_assert_and_check_return_val(http, tb_false);
     
     // done
     tb_bool_t ok = tb_false;
     do
     {
-        // the host is changed?
-        tb_bool_t           host_changed = tb_true;
-        tb_char_t const*    host_old = tb_null;
-        tb_char_t const*    host_new = tb_url_host(&http->option.url);
-        tb_stream_ctrl(http->stream, TB_STREAM_CTRL_GET_HOST, &host_old);
-        if (host_old && host_new && !tb_stricmp(host_old, host_new)) host_changed = tb_false;
+        // clear status
+        tb_http_status_cler(&http->status, tb_true);
+
+        // clear body
+        http->body = 0;
+
+        // keep-alive? load the idle connection of this host from the pool
+        http->breused = tb_false;
+        tb_stream_ref_t sstream = http->sstream;
+        if (http->option.balived)
+        {
+            // exit the previous sock stream
+            if (sstream) tb_stream_exit(sstream);
+            sstream = tb_http_pool_load(tb_http_pool(), &http->option.url, &http->breused);
+            http->bpooled = tb_true;
+        }
+        // init sock stream
+        else if (!sstream)
+        {
+            sstream = tb_stream_init_sock();
+            http->bpooled = tb_false;
+        }
+
+        // using sstream, it may be killed now
+        tb_spinlock_enter(&http->lock);
+        http->sstream = sstream;
+        http->stream = sstream;
+        tb_bool_t bkilled = http->bkilled;
+        tb_spinlock_leave(&http->lock);
+        tb_assert_and_check_break(sstream);
+
+        // has been killed before connecting?
+        if (bkilled)
+        {
+            http->status.state = TB_STATE_KILLED;
+            break;
+        }
 
         // trace
-        tb_trace_d("connect: host: %s", host_changed? "changed" : "keep");
+        tb_trace_d("connect: %s", http->breused? "reuse" : "new");
 
         // set url and timeout
         if (!tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SET_URL, tb_url_cstr(&http->option.url))) break;
         if (!tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SET_TIMEOUT, http->option.timeout)) break;
 
-        // reset keep-alive and close socket first before connecting anthor host
-        if (host_changed && !tb_stream_ctrl(http->stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false)) break;
-
         // dump option
 #if defined(__tb_debug__) && TB_TRACE_MODULE_DEBUG
         tb_http_option_dump(&http->option);
@@ -127,9 +244,6 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
         // trace
         tb_trace_d("connect: ..");
 
-        // clear status
-        tb_http_status_cler(&http->status, host_changed);
-
         // open stream
         if (!tb_stream_open(http->stream)) break;
 
@@ -138,9 +252,8 @@ static tb_bool_t tb_http_connect(tb_http_t* http)
 
     } while (0);
 
-
     // failed? save state
-    if (!ok) http->status.state = tb_stream_state(http->stream);
+    if (!ok && !http->status.state) http->status.state = http->stream? tb_stream_state(http->stream) : TB_STATE_SOCK_CONNECT_FAILED;
 
     // trace
     tb_trace_d("connect: %s, state: %s", ok? "ok" : "failed", tb_state_cstr(http->status.state));
@@ -202,7 +315,7 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         tb_hash_map_insert(http->head, "Accept", "*/*");
 
         // init connection
-        tb_hash_map_insert(http->head, "Connection", http->status.balived? "keep-alive" : "close");
+        tb_hash_map_insert(http->head, "Connection", http->option.balived? "keep-alive" : "close");
 
         // init cookies
         tb_bool_t cookie = tb_false;
@@ -332,7 +445,7 @@ static tb_bool_t tb_http_request(tb_http_t* http)
         tb_string_chrcat(&http->request, ' ');
 
         // append version, HTTP/1.1
-        tb_string_cstrfcat(&http->request, "HTTP/1.%1u\r\n", http->status.balived? http->status.version : http->option.version);
+        tb_string_cstrfcat(&http->request, "HTTP/1.%1u\r\n", http->option.version);
 
         // append key: value
         tb_for_all (tb_hash_map_item_ref_t, item, http->head)
@@ -441,8 +554,8 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
             http->status.state = TB_STATE_HTTP_RESPONSE_500 + (http->status.code - 500);
         else http->status.state = TB_STATE_HTTP_RESPONSE_UNK;
 
-        // check state code: 4xx & 5xx
-        if (http->status.code >= 400 && http->status.code < 600) return tb_false;
+        // keep alive by default for HTTP/1.1
+        http->status.balived = http->status.version? 1 : 0;
     }
     // key: value?
     else
@@ -524,10 +637,8 @@ static tb_bool_t tb_http_response_done(tb_http_t* http, tb_char_t const* line, t
         else if (!tb_strnicmp(line, "Connection", 10))
         {
             // keep alive?
-            http->status.balived = !tb_stricmp(p, "close")? 0 : 1;
-
-            // ctrl stream for sock
-            if (!tb_stream_ctrl(http->sstream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, http->status.balived? tb_true : tb_false)) return tb_false;
+            if (!tb_stricmp(p, "close")) http->status.balived = 0;
+            else if (!tb_stricmp(p, "keep-alive")) http->status.balived = 1;
         }
         // parse cookies
         else if (http->option.cookies && !tb_strnicmp(line, "Set-Cookie", 10))
@@ -564,17 +675,34 @@ static tb_bool_t tb_http_response(tb_http_t* http)
         // read line
         tb_long_t real = 0;
         tb_size_t indx = 0;
+        tb_bool_t skip = tb_false;
         while ((real = tb_stream_bread_line(http->stream, http->data, sizeof(http->data) - 1)) >= 0)
         {
             // trace
             tb_trace_d("response: %s", http->data);
  
+            // skip the left crlf of the last response on the kept-alive connection
+            if (!real && !indx && !skip)
+            {
+                skip = tb_true;
+                continue ;
+            }
+
             // do callback
             if (http->option.head_func && !http->option.head_func(http->data, http->option.head_priv)) break;
             
             // end?
             if (!real)
             {
+                // no status line?
+                tb_check_break(indx);
+
+                // save the body offset
+                http->body = tb_stream_offset(http->sstream);
+
+                // check state code: 4xx & 5xx
+                if (http->status.code >= 400 && http->status.code < 600) break;
+
                 // switch to cstream if chunked
                 if (http->status.bchunked)
                 {
@@ -659,6 +787,36 @@ static tb_bool_t tb_http_response(tb_http_t* http)
     // ok?
     return ok;
 }
+static tb_bool_t tb_http_send(tb_http_t* http)
+{
+    // check
+    tb_assert_and_check_return_val(http, tb_false);
+
+    // done
+    tb_bool_t ok = tb_false;
+    while (1)
+    {
+        // connect, request and response it
+        ok = tb_http_connect(http) && tb_http_request(http) && tb_http_response(http);
+        tb_check_break(!ok);
+
+        /* the reused connection may have been closed by the server before sending the request,
+         * so retry it if there is no response, but we cannot retry the non-idempotent post request
+         *
+         * it will not retry it forever, because the reused connection will be closed and removed from the pool
+         */
+        tb_check_break(http->breused && !http->status.code && http->option.method != TB_HTTP_METHOD_POST);
+
+        // trace
+        tb_trace_d("send: retry it for the closed connection");
+
+        // close this connection
+        tb_http_release(http, tb_false);
+    }
+
+    // ok?
+    return ok;
+}
 static tb_bool_t tb_http_redirect(tb_http_t* http)
 {
     // check
@@ -691,11 +849,8 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             tb_assert_pass_and_check_break(read == size);
         }
 
-        // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        // close stream and keep it alive if the redirect content has been read
+        tb_http_release(http, tb_http_reusable(http));
 
         // get location url
         tb_char_t const* location = tb_string_cstr(&http->status.location);
@@ -720,20 +875,138 @@ static tb_bool_t tb_http_redirect(tb_http_t* http)
             break;
         }
 
-        // connect it
-        if (!(ok = tb_http_connect(http))) break;
-
-        // request it
-        if (!(ok = tb_http_request(http))) break;
-
-        // response it
-        if (!(ok = tb_http_response(http))) break;
+        // send it
+        if (!(ok = tb_http_send(http))) break;
     }
 
     // ok?
     return ok && !tb_string_size(&http->status.location);
 }
 
+static tb_bool_t tb_http_pipeline_response(tb_http_t* http, tb_buffer_ref_t content)
+{
+    // check
+    tb_assert_and_check_return_val(http && http->sstream && content, tb_false);
+
+    // clear content
+    tb_buffer_clear(content);
+
+    // read the response head, the interim 1xx responses are skipped and only the final response is returned
+    tb_long_t       real = 0;
+    tb_size_t       code = 0;
+    tb_bool_t       skip = tb_false;
+    tb_stream_ref_t stream = http->sstream;
+    while (1)
+    {
+        // clear status
+        tb_http_status_cler(&http->status, tb_true);
+
+        // read the head lines
+        tb_size_t indx = 0;
+        while ((real = tb_stream_bread_line(stream, http->data, sizeof(http->data) - 1)) >= 0)
+        {
+            // trace
+            tb_trace_d("pipeline: response: %s", http->data);
+
+            // skip the left crlf of the last response
+            if (!real && !indx && !skip)
+            {
+                skip = tb_true;
+                continue ;
+            }
+
+            // do callback
+            if (http->option.head_func && !http->option.head_func(http->data, http->option.head_priv)) return tb_false;
+
+            // end?
+            tb_check_break(real);
+
+            // done it
+            if (!tb_http_response_done(http, http->data, indx++)) return tb_false;
+        }
+
+        // no status line?
+        tb_check_return_val(real >= 0 && indx, tb_false);
+
+        // the final response?
+        code = http->status.code;
+        tb_check_break(code >= 100 && code < 200);
+
+        /* the interim response has no content, read the next response of this request
+         *
+         * but we cannot pipeline the next requests after switching protocols
+         */
+        tb_check_return_val(code != 101, tb_false);
+        skip = tb_true;
+    }
+
+    // no content?
+    if (code == 204 || code == 304) return tb_true;
+
+    // read the chunked content
+    if (http->status.bchunked)
+    {
+        while (1)
+        {
+            // read the chunk size
+            if (tb_stream_bread_line(stream, http->data, sizeof(http->data) - 1) <= 0) return tb_false;
+            tb_size_t size = tb_s16tou32(http->data);
+
+            // the last chunk? read the trailer until the empty line
+            if (!size)
+            {
+                while ((real = tb_stream_bread_line(stream, http->data, sizeof(http->data) - 1)) > 0) ;
+                return !real? tb_true : tb_false;
+            }
+
+            // read the chunk data
+            tb_size_t   offset = tb_buffer_size(content);
+            tb_byte_t*  data = tb_buffer_resize(content, offset + size);
+            tb_assert_and_check_return_val(data, tb_false);
+            if (!tb_stream_bread(stream, data + offset, size)) return tb_false;
+
+            // read the chunk tail: "\r\n"
+            tb_byte_t tail[2];
+            if (!tb_stream_bread(stream, tail, 2) || tail[0] != '\r' || tail[1] != '\n') return tb_false;
+        }
+    }
+    // read the content with the given size
+    else if (http->status.content_size >= 0)
+    {
+        tb_size_t   size = (tb_size_t)http->status.content_size;
+        tb_byte_t*  data = size? tb_buffer_resize(content, size) : tb_null;
+        tb_assert_and_check_return_val(!size || data, tb_false);
+        if (size && !tb_stream_bread(stream, data, size)) return tb_false;
+    }
+    // read the content until the connection is closed
+    else
+    {
+        // this connection cannot be reused
+        http->status.balived = 0;
+
+        // read it
+        while (1)
+        {
+            // read data
+            real = tb_stream_read(stream, (tb_byte_t*)http->data, sizeof(http->data));
+
+            // save data
+            if (real > 0) tb_buffer_memncat(content, (tb_byte_t const*)http->data, real);
+            // no data? wait it
+            else if (!real)
+            {
+                tb_long_t wait = tb_stream_wait(stream, TB_STREAM_WAIT_READ, http->option.timeout);
+                tb_check_break(wait > 0);
+            }
+            // end
+            else break;
+        }
+    }
+
+    // ok
+    return tb_true;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -748,9 +1021,8 @@ tb_http_ref_t tb_http_init()
         http = tb_malloc0_type(tb_http_t);
         tb_assert_and_check_break(http);
 
-        // init stream
-        http->stream = http->sstream = tb_stream_init_sock();
-        tb_assert_and_check_break(http->stream);
+        // init lock
+        if (!tb_spinlock_init(&http->lock)) break;
 
         // init head
         http->head = tb_hash_map_init(8, tb_element_str(tb_false), tb_element_str(tb_false));
@@ -789,8 +1061,15 @@ tb_void_t tb_http_kill(tb_http_ref_t self)
     tb_http_t* http = (tb_http_t*)self;
     tb_assert_and_check_return(http);
 
-    // kill stream
+    /* kill stream with the lock
+     *
+     * the sstream may be being saved to the pool and reused by the other http, 
+     * so we only kill it if it is still owned by this http
+     */
+    tb_spinlock_enter(&http->lock);
+    http->bkilled = tb_true;
     if (http->stream) tb_stream_kill(http->stream);
+    tb_spinlock_leave(&http->lock);
 }
 tb_void_t tb_http_exit(tb_http_ref_t self)
 {
@@ -832,6 +1111,9 @@ tb_void_t tb_http_exit(tb_http_ref_t self)
     if (http->head) tb_hash_map_exit(http->head);
     http->head = tb_null;
 
+    // exit lock
+    tb_spinlock_exit(&http->lock);
+
     // free it
     tb_free(http);
 }
@@ -866,14 +1148,8 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
     tb_bool_t ok = tb_false;
     do
     {
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // send it
+        if (!tb_http_send(http)) break;
 
         // redirect it
         if (!tb_http_redirect(http)) break;
@@ -883,14 +1159,11 @@ tb_bool_t tb_http_open(tb_http_ref_t self)
 
     } while (0);
 
-    // failed? close it
+    // failed? close it and keep it alive if the error response has been finished
     if (!ok) 
     {
-        // close stream
-        if (http->stream) tb_stream_clos(http->stream);
-
-        // switch to sstream
-        http->stream = http->sstream;
+        tb_http_release(http, tb_http_reusable(http));
+        tb_http_unkill(http);
     }
 
     // is opened?
@@ -908,11 +1181,9 @@ tb_bool_t tb_http_clos(tb_http_ref_t self)
     // opened?
     tb_check_return_val(http->bopened, tb_true);
 
-    // close stream
-    if (http->stream && !tb_stream_clos(http->stream)) return tb_false;
-
-    // switch to sstream
-    http->stream = http->sstream;
+    // close stream and keep it alive if the response has been finished
+    tb_http_release(http, tb_http_reusable(http));
+    tb_http_unkill(http);
 
     // clear opened
     http->bopened = tb_false;
@@ -936,11 +1207,8 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
     tb_bool_t ok = tb_false;
     do
     {
-        // close stream
-        if (http->stream && !tb_stream_clos(http->stream)) break;
-
-        // switch to sstream
-        http->stream = http->sstream;
+        // close stream and keep it alive if the response has been finished
+        tb_http_release(http, tb_http_reusable(http));
 
         // trace
         tb_trace_d("seek: %llu", offset);
@@ -949,14 +1217,8 @@ tb_bool_t tb_http_seek(tb_http_ref_t self, tb_hize_t offset)
         http->option.range.bof = offset;
         http->option.range.eof = http->status.document_size > 0? http->status.document_size - 1 : 0;
 
-        // connect it
-        if (!tb_http_connect(http)) break;
-
-        // request it
-        if (!tb_http_request(http)) break;
-
-        // response it
-        if (!tb_http_response(http)) break;
+        // send it
+        if (!tb_http_send(http)) break;
 
         // ok
         ok = tb_true;
@@ -1052,3 +1314,99 @@ tb_http_status_t const* tb_http_status(tb_http_ref_t self)
     return &http->status;
 }
 
+tb_size_t tb_http_pipeline(tb_http_ref_t self, tb_char_t const** urls, tb_size_t count, tb_http_pipeline_func_t func, tb_cpointer_t priv)
+{
+    // check
+    tb_http_t* http = (tb_http_t*)self;
+    tb_assert_and_check_return_val(http && urls && count && func, 0);
+
+    // opened?
+    tb_assert_and_check_return_val(!http->bopened, 0);
+
+    // init content
+    tb_buffer_t content;
+    if (!tb_buffer_init(&content)) return 0;
+
+    // save the method and keep-alive option
+    tb_size_t method    = http->option.method;
+    tb_size_t balived   = http->option.balived;
+
+    // using the kept-alive GET requests
+    http->option.method     = TB_HTTP_METHOD_GET;
+    http->option.balived    = 1;
+
+    // done
+    tb_size_t done = 0;
+    tb_bool_t stop = tb_false;
+    while (done < count && !stop)
+    {
+        // connect the host of the first unfinished url
+        if (!tb_url_cstr_set(&http->option.url, urls[done])) break;
+        if (!tb_http_connect(http))
+        {
+            tb_http_release(http, tb_false);
+            break;
+        }
+
+        // send the requests of the following urls with the same host without waiting the responses
+        tb_size_t sent = done;
+        tb_url_ref_t url = tb_stream_url(http->sstream);
+        while (sent < count)
+        {
+            if (!tb_url_cstr_set(&http->option.url, urls[sent])) break;
+            if (!tb_http_pool_match(url, &http->option.url)) break;
+            if (!tb_http_request(http)) break;
+            sent++;
+        }
+
+        // trace
+        tb_trace_d("pipeline: sent: %lu requests", sent - done);
+
+        // read the responses in order
+        tb_size_t read = done;
+        while (read < sent)
+        {
+            // using the current url for the cookies of this response
+            if (!tb_url_cstr_set(&http->option.url, urls[read])) break;
+
+            // read the response
+            if (!tb_http_pipeline_response(http, &content)) break;
+
+            // done func
+            if (!func(read++, &http->status, tb_buffer_data(&content), tb_buffer_size(&content), priv)) 
+            {
+                stop = tb_true;
+                break;
+            }
+
+            // the server will close this connection?
+            tb_check_break(http->status.balived);
+        }
+
+        // trace
+        tb_trace_d("pipeline: read: %lu responses", read - done);
+
+        // close this connection and keep it alive if all responses have been read
+        tb_http_release(http, read == sent && http->status.balived);
+
+        /* no progress? failed
+         *
+         * only retry it for the reused connection which may have been closed by the server,
+         * it will not retry it forever, because the reused connection has been removed from the pool
+         */
+        if (read == done && !http->breused) break;
+
+        // next
+        done = read;
+    }
+
+    // restore the method and keep-alive option
+    http->option.method     = method;
+    http->option.balived    = balived;
+
+    // exit content
+    tb_buffer_exit(&content);
+
+    // ok?
+    return done;
+}
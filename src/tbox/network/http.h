@@ -154,6 +154,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_GET_POST_FUNC        = TB_HTTP_OPTION_CODE_GET(18)
 ,   TB_HTTP_OPTION_GET_POST_PRIV        = TB_HTTP_OPTION_CODE_GET(19)
 ,   TB_HTTP_OPTION_GET_POST_LRATE       = TB_HTTP_OPTION_CODE_GET(20)
+,   TB_HTTP_OPTION_GET_KEEP_ALIVE       = TB_HTTP_OPTION_CODE_GET(21)
 
 ,   TB_HTTP_OPTION_SET_SSL              = TB_HTTP_OPTION_CODE_SET(1)
 ,   TB_HTTP_OPTION_SET_URL              = TB_HTTP_OPTION_CODE_SET(2)
@@ -175,6 +176,7 @@ typedef enum __tb_http_option_e
 ,   TB_HTTP_OPTION_SET_POST_FUNC        = TB_HTTP_OPTION_CODE_SET(18)
 ,   TB_HTTP_OPTION_SET_POST_PRIV        = TB_HTTP_OPTION_CODE_SET(19)
 ,   TB_HTTP_OPTION_SET_POST_LRATE       = TB_HTTP_OPTION_CODE_SET(20)
+,   TB_HTTP_OPTION_SET_KEEP_ALIVE       = TB_HTTP_OPTION_CODE_SET(21)
 
 }tb_http_option_e;
 
@@ -228,6 +230,9 @@ typedef struct __tb_http_option_t
     /// the redirect maxn
     tb_uint16_t         redirect    : 10;
 
+    /// keep alive and reuse the connection from the http pool?
+    tb_uint8_t          balived     : 1;
+
     /// the url
     tb_url_t            url;
 
@@ -310,6 +315,18 @@ typedef struct __tb_http_status_t
 
 }tb_http_status_t;
 
+/*! the http pipeline func type
+ *
+ * @param index         the request index
+ * @param status        the response status
+ * @param data          the whole response content, it has been dechunked but not decompressed for gzip
+ * @param size          the response content size
+ * @param priv          the func private data
+ *
+ * @return              tb_true: ok and continue it, tb_false: break it
+ */
+typedef tb_bool_t       (*tb_http_pipeline_func_t)(tb_size_t index, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -407,6 +424,35 @@ tb_bool_t               tb_http_ctrl(tb_http_ref_t http, tb_size_t option, ...);
  */
 tb_http_status_t const* tb_http_status(tb_http_ref_t http);
 
+/*! get multiple urls using the http/1.1 pipelining 
+ *
+ * send the GET requests of the consecutive urls with the same host on one kept-alive connection 
+ * without waiting the responses, and read the responses in order. the remaining requests will be 
+ * sent again on a new connection if the server closes the connection before all responses have been read.
+ *
+ * @code
+    static tb_bool_t tb_http_pipeline_func(tb_size_t index, tb_http_status_t const* status, tb_byte_t const* data, tb_size_t size, tb_cpointer_t priv)
+    {
+        tb_trace_i("[%lu]: code: %lu, size: %lu", index, status->code, size);
+        return tb_true;
+    }
+
+    tb_char_t const* urls[] = {"http://host/a.js", "http://host/b.css", "http://host/c.png"};
+    tb_http_pipeline(http, urls, tb_arrayn(urls), tb_http_pipeline_func, tb_null);
+ * @endcode
+ *
+ * @note the http must not be opened, and the connection will be saved to the http pool after finishing it
+ *
+ * @param http          the http 
+ * @param urls          the urls
+ * @param count         the url count
+ * @param func          the response func
+ * @param priv          the func private data
+ *
+ * @return              the count of the finished responses 
+ */
+tb_size_t               tb_http_pipeline(tb_http_ref_t http, tb_char_t const** urls, tb_size_t count, tb_http_pipeline_func_t func, tb_cpointer_t priv);
+
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
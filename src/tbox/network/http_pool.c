@@ -0,0 +1,608 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_pool.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_pool"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "http_pool.h"
+#include "ssl.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../platform/platform.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the session key maxn
+#define TB_HTTP_POOL_KEY_MAXN           (512)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the idle connection type
+typedef struct __tb_http_pool_idle_t
+{
+    // the kept-alive sock stream
+    tb_stream_ref_t             stream;
+
+    // the saved time
+    tb_hong_t                   time;
+
+}tb_http_pool_idle_t;
+
+#ifdef TB_SSL_ENABLE
+// the ssl session type
+typedef struct __tb_http_pool_session_t
+{
+    // the key: "scheme://host:port"
+    tb_char_t*                  key;
+
+    // the session
+    tb_ssl_session_ref_t        session;
+
+    // the saved time
+    tb_hong_t                   time;
+
+}tb_http_pool_session_t;
+#endif
+
+// the http pool type
+typedef struct __tb_http_pool_t
+{
+    // the lock
+    tb_spinlock_t               lock;
+
+    // the idle connections, the recently saved connection is at the top
+    tb_http_pool_idle_t*        idle;
+
+    // the idle connection count
+    tb_size_t                   idle_size;
+
+    // the idle connection maxn
+    tb_size_t                   maxn;
+
+    // the idle connection maxn of each host
+    tb_size_t                   host_maxn;
+
+    // the idle timeout
+    tb_long_t                   timeout;
+
+#ifdef TB_SSL_ENABLE
+    // the ssl sessions of hosts
+    tb_http_pool_session_t*     sessions;
+
+    // the ssl session count
+    tb_size_t                   sessions_size;
+#endif
+
+}tb_http_pool_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_void_t tb_http_pool_remove(tb_http_pool_t* pool, tb_size_t index)
+{
+    // check
+    tb_assert_and_check_return(pool && index < pool->idle_size);
+
+    // remove it and keep the order of the idle connections
+    if (index + 1 < pool->idle_size) tb_memmov(&pool->idle[index], &pool->idle[index + 1], (pool->idle_size - index - 1) * sizeof(tb_http_pool_idle_t));
+    pool->idle_size--;
+}
+
+#ifdef TB_SSL_ENABLE
+static tb_bool_t tb_http_pool_key(tb_url_ref_t url, tb_char_t* data, tb_size_t maxn)
+{
+    // check
+    tb_assert_and_check_return_val(url && data && maxn, tb_false);
+
+    // the host
+    tb_char_t const* host = tb_url_host(url);
+    tb_check_return_val(host, tb_false);
+
+    // make key
+    tb_long_t size = tb_snprintf(data, maxn, "%s://%s:%u", tb_url_ssl(url)? "https" : "http", host, tb_url_port(url));
+    return size > 0 && (tb_size_t)size < maxn;
+}
+static tb_ssl_session_ref_t tb_http_pool_session_take(tb_http_pool_t* pool, tb_url_ref_t url)
+{
+    // check
+    tb_assert_and_check_return_val(pool && url, tb_null);
+
+    // only for ssl
+    tb_check_return_val(tb_url_ssl(url), tb_null);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    if (!tb_http_pool_key(url, key, sizeof(key))) return tb_null;
+
+    /* take the session of this host
+     *
+     * the session is only used once, e.g. the single-use session ticket of tls1.3,
+     * and the new session will be saved after the new connection has been closed
+     */
+    tb_size_t               i = 0;
+    tb_ssl_session_ref_t    session = tb_null;
+    tb_char_t*              session_key = tb_null;
+    tb_spinlock_enter(&pool->lock);
+    for (i = 0; i < pool->sessions_size; i++)
+    {
+        if (!tb_strcmp(pool->sessions[i].key, key))
+        {
+            session     = pool->sessions[i].session;
+            session_key = pool->sessions[i].key;
+            pool->sessions[i] = pool->sessions[--pool->sessions_size];
+            break;
+        }
+    }
+    tb_spinlock_leave(&pool->lock);
+
+    // exit the session key
+    if (session_key) tb_free(session_key);
+
+    // trace
+    tb_trace_d("session: take: %s: %p", key, session);
+
+    // ok?
+    return session;
+}
+static tb_void_t tb_http_pool_session_save(tb_http_pool_t* pool, tb_url_ref_t url, tb_ssl_session_ref_t session)
+{
+    // check
+    tb_assert_and_check_return(pool && url && session);
+
+    // make key
+    tb_char_t key[TB_HTTP_POOL_KEY_MAXN];
+    tb_char_t* session_key = tb_http_pool_key(url, key, sizeof(key))? tb_strdup(key) : tb_null;
+    if (!session_key)
+    {
+        tb_ssl_session_exit(session);
+        return ;
+    }
+
+    // trace
+    tb_trace_d("session: save: %s: %p", key, session);
+
+    // save it
+    tb_size_t               i = 0;
+    tb_hong_t               now = tb_mclock();
+    tb_ssl_session_ref_t    session_old = tb_null;
+    tb_char_t*              session_key_old = tb_null;
+    tb_spinlock_enter(&pool->lock);
+    do
+    {
+        // replace the session of the same host
+        for (i = 0; i < pool->sessions_size; i++)
+        {
+            if (!tb_strcmp(pool->sessions[i].key, key)) break;
+        }
+
+        // no this host? append it or replace the oldest session if full
+        if (i == pool->sessions_size && pool->sessions_size < pool->maxn) i = pool->sessions_size++;
+        else
+        {
+            // find the oldest session if full
+            if (i == pool->sessions_size)
+            {
+                tb_size_t j = 0;
+                for (i = 0, j = 1; j < pool->sessions_size; j++)
+                {
+                    if (pool->sessions[j].time < pool->sessions[i].time) i = j;
+                }
+            }
+            tb_assert_and_check_break(i < pool->sessions_size);
+
+            // save the old session
+            session_old     = pool->sessions[i].session;
+            session_key_old = pool->sessions[i].key;
+        }
+
+        // save the new session
+        pool->sessions[i].key       = session_key;
+        pool->sessions[i].session   = session;
+        pool->sessions[i].time      = now;
+        session_key                 = tb_null;
+        session                     = tb_null;
+
+    } while (0);
+    tb_spinlock_leave(&pool->lock);
+
+    // exit the old session
+    if (session_old) tb_ssl_session_exit(session_old);
+    if (session_key_old) tb_free(session_key_old);
+
+    // failed? exit the new session
+    if (session) tb_ssl_session_exit(session);
+    if (session_key) tb_free(session_key);
+}
+#endif
+
+static tb_void_t tb_http_pool_close(tb_http_pool_t* pool, tb_stream_ref_t stream)
+{
+    // check
+    tb_assert_and_check_return(pool && stream);
+
+#ifdef TB_SSL_ENABLE
+    // save the ssl session of this connection
+    tb_url_ref_t url = tb_stream_url(stream);
+    if (url && tb_url_ssl(url))
+    {
+        tb_pointer_t session = tb_null;
+        if (tb_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_GET_SSL_SESSION, &session) && session)
+            tb_http_pool_session_save(pool, url, (tb_ssl_session_ref_t)session);
+    }
+#endif
+
+    // trace
+    tb_trace_d("close: %p", stream);
+
+    // close the kept-alive socket and exit it
+    tb_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+    tb_stream_exit(stream);
+}
+static tb_void_t tb_http_pool_reap(tb_http_pool_t* pool)
+{
+    // check
+    tb_assert_and_check_return(pool);
+
+    // close the oldest idle connections at the bottom
+    tb_hong_t now = tb_mclock();
+    while (1)
+    {
+        // pop the oldest idle connection if timeout
+        tb_stream_ref_t stream = tb_null;
+        tb_spinlock_enter(&pool->lock);
+        if (pool->idle_size && pool->timeout >= 0 && now >= pool->idle[0].time + pool->timeout)
+        {
+            stream = pool->idle[0].stream;
+            tb_http_pool_remove(pool, 0);
+        }
+        tb_spinlock_leave(&pool->lock);
+
+        // no more timeout connections?
+        tb_check_break(stream);
+
+        // close it
+        tb_http_pool_close(pool, stream);
+    }
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * instance implementation
+ */
+static tb_handle_t tb_http_pool_instance_init(tb_cpointer_t* ppriv)
+{
+    return (tb_handle_t)tb_http_pool_init(0, 0, 0);
+}
+static tb_void_t tb_http_pool_instance_exit(tb_handle_t pool, tb_cpointer_t priv)
+{
+    // dump it
+#ifdef __tb_debug__
+    tb_http_pool_dump((tb_http_pool_ref_t)pool);
+#endif
+
+    // exit it
+    tb_http_pool_exit((tb_http_pool_ref_t)pool);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_http_pool_ref_t tb_http_pool()
+{
+    return (tb_http_pool_ref_t)tb_singleton_instance(TB_SINGLETON_TYPE_HTTP_POOL, tb_http_pool_instance_init, tb_http_pool_instance_exit, tb_null, tb_null);
+}
+tb_http_pool_ref_t tb_http_pool_init(tb_size_t maxn, tb_size_t host_maxn, tb_long_t timeout)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_http_pool_t* pool = tb_null;
+    do
+    {
+        // make pool
+        pool = tb_malloc0_type(tb_http_pool_t);
+        tb_assert_and_check_break(pool);
+
+        // init lock
+        if (!tb_spinlock_init(&pool->lock)) break;
+
+        // init pool
+        pool->maxn      = maxn? maxn : TB_HTTP_POOL_DEFAULT_MAXN;
+        pool->host_maxn = host_maxn? host_maxn : TB_HTTP_POOL_DEFAULT_HOST_MAXN;
+        pool->timeout   = timeout? timeout : TB_HTTP_POOL_DEFAULT_TIMEOUT;
+
+        // init idle connections
+        pool->idle = tb_nalloc0_type(pool->maxn, tb_http_pool_idle_t);
+        tb_assert_and_check_break(pool->idle);
+
+#ifdef TB_SSL_ENABLE
+        // init ssl sessions
+        pool->sessions = tb_nalloc0_type(pool->maxn, tb_http_pool_session_t);
+        tb_assert_and_check_break(pool->sessions);
+#endif
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (pool) tb_http_pool_exit((tb_http_pool_ref_t)pool);
+        pool = tb_null;
+    }
+
+    // ok?
+    return (tb_http_pool_ref_t)pool;
+}
+tb_void_t tb_http_pool_exit(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // clear it
+    tb_http_pool_clear(self);
+
+    // exit idle connections
+    if (pool->idle) tb_free(pool->idle);
+    pool->idle = tb_null;
+
+#ifdef TB_SSL_ENABLE
+    // exit ssl sessions
+    if (pool->sessions) tb_free(pool->sessions);
+    pool->sessions = tb_null;
+#endif
+
+    // exit lock
+    tb_spinlock_exit(&pool->lock);
+
+    // exit it
+    tb_free(pool);
+}
+tb_void_t tb_http_pool_clear(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // close all idle connections
+    while (1)
+    {
+        // pop the idle connection
+        tb_stream_ref_t stream = tb_null;
+        tb_spinlock_enter(&pool->lock);
+        if (pool->idle_size) stream = pool->idle[--pool->idle_size].stream;
+        tb_spinlock_leave(&pool->lock);
+        tb_check_break(stream);
+
+        // close it
+        tb_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, tb_false);
+        tb_stream_exit(stream);
+    }
+
+#ifdef TB_SSL_ENABLE
+    // exit all ssl sessions
+    while (1)
+    {
+        // pop the ssl session
+        tb_http_pool_session_t session = {0};
+        tb_spinlock_enter(&pool->lock);
+        if (pool->sessions_size) session = pool->sessions[--pool->sessions_size];
+        tb_spinlock_leave(&pool->lock);
+        tb_check_break(session.key);
+
+        // exit it
+        if (session.session) tb_ssl_session_exit(session.session);
+        tb_free(session.key);
+    }
+#endif
+}
+tb_size_t tb_http_pool_size(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return_val(pool, 0);
+
+    // the idle connection count
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t size = pool->idle_size;
+    tb_spinlock_leave(&pool->lock);
+    return size;
+}
+tb_bool_t tb_http_pool_match(tb_url_ref_t url, tb_url_ref_t other)
+{
+    // check
+    tb_assert_and_check_return_val(url && other, tb_false);
+
+    // the hosts
+    tb_char_t const* host = tb_url_host(url);
+    tb_char_t const* host_other = tb_url_host(other);
+
+    // is the same scheme, host and port?
+    return      host && host_other
+            &&  tb_url_ssl(url) == tb_url_ssl(other)
+            &&  tb_url_port(url) == tb_url_port(other)
+            &&  !tb_stricmp(host, host_other);
+}
+tb_stream_ref_t tb_http_pool_load(tb_http_pool_ref_t self, tb_url_ref_t url, tb_bool_t* preused)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return_val(pool && url, tb_null);
+
+    // close the timeout idle connections first
+    tb_http_pool_reap(pool);
+
+    // take the recently saved connection of this host
+    tb_stream_ref_t stream = tb_null;
+    tb_spinlock_enter(&pool->lock);
+    tb_size_t i = pool->idle_size;
+    while (i--)
+    {
+        if (tb_http_pool_match(tb_stream_url(pool->idle[i].stream), url))
+        {
+            stream = pool->idle[i].stream;
+            tb_http_pool_remove(pool, i);
+            break;
+        }
+    }
+    tb_spinlock_leave(&pool->lock);
+
+    // trace
+    tb_trace_d("load: %s://%s:%u: %p", tb_url_ssl(url)? "https" : "http", tb_url_host(url), tb_url_port(url), stream);
+
+    // reused?
+    if (preused) *preused = stream? tb_true : tb_false;
+
+    // ok?
+    tb_check_return_val(!stream, stream);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // init a new sock stream
+        stream = tb_stream_init_sock();
+        tb_assert_and_check_break(stream);
+
+        // set url
+        if (!tb_stream_ctrl(stream, TB_STREAM_CTRL_SET_URL, tb_url_cstr(url))) break;
+
+#ifdef TB_SSL_ENABLE
+        // resume the last ssl session of this host
+        tb_ssl_session_ref_t session = tb_http_pool_session_take(pool, url);
+        if (session && !tb_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_SET_SSL_SESSION, session))
+            tb_ssl_session_exit(session);
+#endif
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        if (stream) tb_stream_exit(stream);
+        stream = tb_null;
+    }
+
+    // ok?
+    return stream;
+}
+tb_void_t tb_http_pool_save(tb_http_pool_ref_t self, tb_stream_ref_t stream, tb_bool_t balived)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool && stream);
+
+    // the url
+    tb_url_ref_t url = tb_stream_url(stream);
+    tb_assert(url);
+
+    // trace
+    tb_trace_d("save: %p, alived: %d", stream, balived);
+
+    // not keep-alive? close it
+    if (!balived || !url)
+    {
+        tb_http_pool_close(pool, stream);
+        return ;
+    }
+
+    // close the timeout idle connections first
+    tb_http_pool_reap(pool);
+
+    // push it to the top of the idle connections
+    tb_size_t       i = 0;
+    tb_size_t       host_size = 0;
+    tb_size_t       host_oldest = 0;
+    tb_stream_ref_t evicted = tb_null;
+    tb_spinlock_enter(&pool->lock);
+    for (i = 0; i < pool->idle_size; i++)
+    {
+        if (tb_http_pool_match(tb_stream_url(pool->idle[i].stream), url))
+        {
+            if (!host_size) host_oldest = i;
+            host_size++;
+        }
+    }
+
+    // evict the oldest connection of this host or the oldest connection if full
+    if (host_size >= pool->host_maxn || pool->idle_size >= pool->maxn)
+    {
+        i = host_size >= pool->host_maxn? host_oldest : 0;
+        evicted = pool->idle[i].stream;
+        tb_http_pool_remove(pool, i);
+    }
+    pool->idle[pool->idle_size].stream  = stream;
+    pool->idle[pool->idle_size].time    = tb_mclock();
+    pool->idle_size++;
+    tb_spinlock_leave(&pool->lock);
+
+    // close the evicted connection
+    if (evicted) tb_http_pool_close(pool, evicted);
+}
+#ifdef __tb_debug__
+tb_void_t tb_http_pool_dump(tb_http_pool_ref_t self)
+{
+    // check
+    tb_http_pool_t* pool = (tb_http_pool_t*)self;
+    tb_assert_and_check_return(pool);
+
+    // enter
+    tb_spinlock_enter(&pool->lock);
+
+    // dump
+    tb_size_t i = 0;
+    tb_hong_t now = tb_mclock();
+    tb_trace_i("");
+    tb_trace_i("http_pool: idle: %lu/%lu, host_maxn: %lu, timeout: %ld ms", pool->idle_size, pool->maxn, pool->host_maxn, pool->timeout);
+    for (i = 0; i < pool->idle_size; i++)
+    {
+        tb_url_ref_t url = tb_stream_url(pool->idle[i].stream);
+        tb_trace_i("http_pool: idle: %s://%s:%u, %lld ms", tb_url_ssl(url)? "https" : "http", tb_url_host(url), tb_url_port(url), now - pool->idle[i].time);
+    }
+#ifdef TB_SSL_ENABLE
+    for (i = 0; i < pool->sessions_size; i++)
+        tb_trace_i("http_pool: session: %s, %lld ms", pool->sessions[i].key, now - pool->sessions[i].time);
+#endif
+
+    // leave
+    tb_spinlock_leave(&pool->lock);
+}
+#endif
@@ -0,0 +1,169 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_pool.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_HTTP_POOL_H
+#define TB_NETWORK_HTTP_POOL_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "url.h"
+#include "../stream/stream.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the default idle connection maxn of the http pool
+#ifdef __tb_small__
+#   define TB_HTTP_POOL_DEFAULT_MAXN            (16)
+#else
+#   define TB_HTTP_POOL_DEFAULT_MAXN            (64)
+#endif
+
+// the default idle connection maxn of each host
+#define TB_HTTP_POOL_DEFAULT_HOST_MAXN          (6)
+
+// the default idle timeout, ms
+#define TB_HTTP_POOL_DEFAULT_TIMEOUT            (30000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the http pool ref type
+typedef __tb_typeref__(http_pool);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! the http pool instance, all http connections will be reused from it
+ *
+ * @return          the http pool
+ */
+tb_http_pool_ref_t  tb_http_pool(tb_noarg_t);
+
+/*! init the http pool of the kept-alive connections
+ *
+ * the idle connections are keyed by the scheme, host and port,
+ * and the ssl session of each host will be resumed for the next new connection
+ *
+ * @param maxn      the idle connection maxn, using the default maxn if be zero
+ * @param host_maxn the idle connection maxn of each host, using the default maxn if be zero
+ * @param timeout   the idle timeout (ms), using the default timeout if be zero
+ *
+ * @return          the http pool
+ */
+tb_http_pool_ref_t  tb_http_pool_init(tb_size_t maxn, tb_size_t host_maxn, tb_long_t timeout);
+
+/*! exit the http pool and close all idle connections
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_exit(tb_http_pool_ref_t pool);
+
+/*! close all idle connections and clear all ssl sessions
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_clear(tb_http_pool_ref_t pool);
+
+/*! the idle connection count
+ *
+ * @param pool      the http pool
+ *
+ * @return          the count
+ */
+tb_size_t           tb_http_pool_size(tb_http_pool_ref_t pool);
+
+/*! can the connection of the given url be reused for the other url?
+ *
+ * @param url       the url
+ * @param other     the other url
+ *
+ * @return          tb_true if they have the same scheme, host and port
+ */
+tb_bool_t           tb_http_pool_match(tb_url_ref_t url, tb_url_ref_t other);
+
+/*! load a sock stream for the given url
+ *
+ * @code
+    // load a connection
+    tb_stream_ref_t stream = tb_http_pool_load(tb_http_pool(), url, tb_null);
+    if (stream)
+    {
+        // open it, it will be connected directly if be a new connection
+        if (tb_stream_open(stream))
+        {
+            // ...
+        }
+
+        // keep it alive if the response has been finished, and save it to the pool after closing it
+        tb_stream_ctrl(stream, TB_STREAM_CTRL_SOCK_KEEP_ALIVE, balived);
+        tb_stream_clos(stream);
+        tb_http_pool_save(tb_http_pool(), stream, balived);
+    }
+ * @endcode
+ *
+ * @param pool      the http pool
+ * @param url       the url
+ * @param preused   return whether it is a kept-alive idle connection, optional
+ *
+ * @return          the kept-alive idle connection of the same scheme, host and port,
+ *                  or a new sock stream which will resume the last ssl session of this host
+ */
+tb_stream_ref_t     tb_http_pool_load(tb_http_pool_ref_t pool, tb_url_ref_t url, tb_bool_t* preused);
+
+/*! save the closed sock stream to the pool
+ *
+ * the ssl session will be saved for the next new connection even if it is not kept alive
+ *
+ * @param pool      the http pool
+ * @param stream    the closed sock stream from tb_http_pool_load()
+ * @param balived   keep it alive? it will be exited directly if be false or the pool is full
+ */
+tb_void_t           tb_http_pool_save(tb_http_pool_ref_t pool, tb_stream_ref_t stream, tb_bool_t balived);
+
+#ifdef __tb_debug__
+/*! dump the http pool
+ *
+ * @param pool      the http pool
+ */
+tb_void_t           tb_http_pool_dump(tb_http_pool_ref_t pool);
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
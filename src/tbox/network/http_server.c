@@ -0,0 +1,1439 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_server.c
+ * @ingroup     network
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME            "http_server"
+#define TB_TRACE_MODULE_DEBUG           (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "http_server.h"
+#include "impl/http/method.h"
+#include "../zip/zip.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+#include "../memory/memory.h"
+#include "../stream/stream.h"
+#include "../platform/platform.h"
+#include "../coroutine/coroutine.h"
+#include "../container/container.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the listen backlog
+#define TB_HTTP_SERVER_BACKLOG              (1024)
+
+// the stack size of the session coroutine
+#define TB_HTTP_SERVER_STACKSIZE            (8192 << 3)
+
+// the grow size of the receiving buffer
+#define TB_HTTP_SERVER_DATA_GROW            (8192)
+
+// the max size of the request head
+#define TB_HTTP_SERVER_HEAD_DATA_MAXN       (65536)
+
+// the max size of the request body
+#ifdef __tb_small__
+#   define TB_HTTP_SERVER_BODY_MAXN         (1 << 20)
+#else
+#   define TB_HTTP_SERVER_BODY_MAXN         (1 << 23)
+#endif
+
+// the max size of the buffered responses, flush them if be full
+#define TB_HTTP_SERVER_SEND_MAXN            (16384)
+
+// the min size of the gzip data
+#define TB_HTTP_SERVER_GZIP_MINN            (256)
+
+// the max size of the gzip file
+#define TB_HTTP_SERVER_GZIP_FILE_MAXN       (1 << 20)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the http server type
+struct __tb_http_server_t;
+
+// the http server worker type
+typedef struct __tb_http_server_worker_t
+{
+    // the server
+    struct __tb_http_server_t*  server;
+
+    // the listening socket
+    tb_socket_ref_t             sock;
+
+    // is the shared listening socket of the worker 0?
+    tb_bool_t                   bshared;
+
+    // the thread, null for the worker 0
+    tb_thread_ref_t             thread;
+
+    // the lock of the sessions
+    tb_spinlock_t               lock;
+
+    // the sessions
+    tb_list_entry_head_t        sessions;
+
+}tb_http_server_worker_t;
+
+// the http server type
+typedef struct __tb_http_server_t
+{
+    // the request handler
+    tb_http_server_func_t       func;
+
+    // the request handler private data
+    tb_cpointer_t               priv;
+
+    // the root directory of the static files
+    tb_char_t                   rootdir[TB_PATH_MAXN];
+
+    // enable gzip?
+    tb_bool_t                   bgzip;
+
+    // the timeout
+    tb_long_t                   timeout;
+
+    // the port
+    tb_uint16_t                 port;
+
+    // is stopped?
+    tb_atomic_t                 stopped;
+
+    // the workers
+    tb_http_server_worker_t*    workers;
+
+    // the worker count
+    tb_size_t                   count;
+
+}tb_http_server_t;
+
+// the http server session type
+typedef struct __tb_http_server_session_t
+{
+    // the list entry
+    tb_list_entry_t             entry;
+
+    // the worker
+    tb_http_server_worker_t*    worker;
+
+    // the socket
+    tb_socket_ref_t             sock;
+
+    // the receiving data
+    tb_byte_t*                  data;
+
+    // the receiving size
+    tb_size_t                   size;
+
+    // the receiving maxn
+    tb_size_t                   maxn;
+
+    // the scanned size for finding the head end
+    tb_size_t                   scan;
+
+    // the head size of the current request
+    tb_size_t                   head_size;
+
+    // the request
+    tb_http_server_request_t    request;
+
+    // the buffered responses
+    tb_buffer_t                 out;
+
+    // the response heads
+    tb_buffer_t                 heads;
+
+    // the gzip data
+    tb_buffer_t                 zdata;
+
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    // the gzip filter
+    tb_filter_ref_t             zip;
+#endif
+
+    // has been responded?
+    tb_uint8_t                  bresponded  : 1;
+
+    // is chunked response?
+    tb_uint8_t                  bchunked    : 1;
+
+    // is raw chunked response for HTTP/1.0? it will be ended by closing connection
+    tb_uint8_t                  braw        : 1;
+
+    // is gzip chunked response?
+    tb_uint8_t                  bzip        : 1;
+
+    // is failed?
+    tb_uint8_t                  bfailed     : 1;
+
+    // the line
+    tb_char_t                   line[1024];
+
+    // the file path
+    tb_char_t                   path[TB_PATH_MAXN];
+
+}tb_http_server_session_t;
+
+// the mime type
+typedef struct __tb_http_server_mime_t
+{
+    // the extension
+    tb_char_t const*            extension;
+
+    // the content type
+    tb_char_t const*            type;
+
+}tb_http_server_mime_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the mime types
+static tb_http_server_mime_t const g_mimes[] =
+{
+    { "html",   "text/html"                 }
+,   { "htm",    "text/html"                 }
+,   { "css",    "text/css"                  }
+,   { "txt",    "text/plain"                }
+,   { "js",     "application/javascript"    }
+,   { "json",   "application/json"          }
+,   { "xml",    "text/xml"                  }
+,   { "svg",    "image/svg+xml"             }
+,   { "png",    "image/png"                 }
+,   { "jpg",    "image/jpeg"                }
+,   { "jpeg",   "image/jpeg"                }
+,   { "gif",    "image/gif"                 }
+,   { "ico",    "image/x-icon"              }
+,   { "pdf",    "application/pdf"           }
+,   { "zip",    "application/zip"           }
+,   { "gz",     "application/gzip"          }
+};
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_char_t const* tb_http_server_code_cstr(tb_size_t code)
+{
+    // done
+    switch (code)
+    {
+    case TB_HTTP_CODE_CONTINUE:                 return "Continue";
+    case TB_HTTP_CODE_OK:                       return "OK";
+    case TB_HTTP_CODE_CREATED:                  return "Created";
+    case TB_HTTP_CODE_ACCEPTED:                 return "Accepted";
+    case TB_HTTP_CODE_NO_CONTENT:               return "No Content";
+    case TB_HTTP_CODE_PARTIAL_CONTENT:          return "Partial Content";
+    case TB_HTTP_CODE_MOVED_PERMANENTLY:        return "Moved Permanently";
+    case TB_HTTP_CODE_MOVED_TEMPORARILY:        return "Found";
+    case TB_HTTP_CODE_SEE_OTHER:                return "See Other";
+    case TB_HTTP_CODE_NOT_MODIFIED:             return "Not Modified";
+    case TB_HTTP_CODE_TEMPORARY_REDIRECT:       return "Temporary Redirect";
+    case TB_HTTP_CODE_BAD_REQUEST:              return "Bad Request";
+    case TB_HTTP_CODE_UNAUTHORIZED:             return "Unauthorized";
+    case TB_HTTP_CODE_FORBIDDEN:                return "Forbidden";
+    case TB_HTTP_CODE_NOT_FOUND:                return "Not Found";
+    case TB_HTTP_CODE_METHOD_NOT_ALLOWED:       return "Method Not Allowed";
+    case TB_HTTP_CODE_REQUEST_TIMEOUT:          return "Request Timeout";
+    case TB_HTTP_CODE_LENGTH_REQUIRED:          return "Length Required";
+    case TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG:  return "Payload Too Large";
+    case TB_HTTP_CODE_REQUEST_URI_TOO_LONG:     return "URI Too Long";
+    case TB_HTTP_CODE_INTERNAL_SERVER_ERROR:    return "Internal Server Error";
+    case TB_HTTP_CODE_NOT_IMPLEMENTED:          return "Not Implemented";
+    case TB_HTTP_CODE_BAD_GATEWAY:              return "Bad Gateway";
+    case TB_HTTP_CODE_SERVICE_UNAVAILABLE:      return "Service Unavailable";
+    case TB_HTTP_CODE_GATEWAY_TIMEOUT:          return "Gateway Timeout";
+    default: break;
+    }
+    return "Unknown";
+}
+static tb_char_t const* tb_http_server_mime_type(tb_char_t const* path)
+{
+    // the extension
+    tb_char_t const* extension = tb_strrchr(path, '.');
+    if (extension && !tb_strchr(extension, '/'))
+    {
+        // find the content type
+        tb_size_t i = 0;
+        extension++;
+        for (i = 0; i < tb_arrayn(g_mimes); i++)
+        {
+            if (!tb_stricmp(g_mimes[i].extension, extension))
+                return g_mimes[i].type;
+        }
+    }
+    return "application/octet-stream";
+}
+static tb_bool_t tb_http_server_mime_compressible(tb_char_t const* type)
+{
+    return type && (    !tb_strnicmp(type, "text/", 5)
+                    ||  tb_stristr(type, "json")
+                    ||  tb_stristr(type, "javascript")
+                    ||  tb_stristr(type, "xml"));
+}
+static tb_bool_t tb_http_server_session_send(tb_http_server_session_t* session, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(session && session->sock && data, tb_false);
+
+    // send data
+    tb_size_t send = 0;
+    tb_long_t wait = 0;
+    tb_long_t timeout = session->worker->server->timeout;
+    while (send < size)
+    {
+        // send it
+        tb_long_t real = tb_socket_send(session->sock, data + send, size - send);
+
+        // has data?
+        if (real > 0)
+        {
+            send += real;
+            wait = 0;
+        }
+        // no data? wait it
+        else if (!real && !wait)
+        {
+            wait = tb_socket_wait(session->sock, TB_SOCKET_EVENT_SEND, timeout);
+            tb_check_break(wait > 0);
+        }
+        // failed or end?
+        else break;
+    }
+
+    // failed?
+    if (send != size) session->bfailed = 1;
+    return send == size;
+}
+static tb_bool_t tb_http_server_session_flush(tb_http_server_session_t* session)
+{
+    // check
+    tb_check_return_val(!session->bfailed, tb_false);
+
+    // send the buffered responses
+    tb_size_t size = tb_buffer_size(&session->out);
+    tb_check_return_val(size, tb_true);
+    tb_bool_t ok = tb_http_server_session_send(session, tb_buffer_data(&session->out), size);
+    tb_buffer_clear(&session->out);
+    return ok;
+}
+static tb_bool_t tb_http_server_session_writ(tb_http_server_session_t* session, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(!session->bfailed, tb_false);
+    tb_check_return_val(size, tb_true);
+
+    // buffer it for sending it together with the next pipelined responses
+    if (tb_buffer_size(&session->out) + size <= TB_HTTP_SERVER_SEND_MAXN)
+        return tb_buffer_memncat(&session->out, data, size)? tb_true : tb_false;
+
+    // flush the buffered responses first
+    if (!tb_http_server_session_flush(session)) return tb_false;
+
+    // buffer the small data or send the large data directly
+    if (size < TB_HTTP_SERVER_SEND_MAXN) return tb_buffer_memncat(&session->out, data, size)? tb_true : tb_false;
+    return tb_http_server_session_send(session, data, size);
+}
+static tb_bool_t tb_http_server_session_gzip_able(tb_http_server_session_t* session, tb_char_t const* type, tb_size_t size)
+{
+    return      session->worker->server->bgzip
+            &&  session->request.bgzip
+            &&  size >= TB_HTTP_SERVER_GZIP_MINN
+            &&  tb_http_server_mime_compressible(type);
+}
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+static tb_bool_t tb_http_server_session_gzip_open(tb_http_server_session_t* session)
+{
+    // init the gzip filter, it will be reused for the next responses
+    if (!session->zip) session->zip = tb_filter_init_from_zip(TB_ZIP_ALGO_GZIP, TB_ZIP_ACTION_DEFLATE);
+    tb_assert_and_check_return_val(session->zip, tb_false);
+
+    // open it
+    return tb_filter_open(session->zip);
+}
+static tb_byte_t const* tb_http_server_session_gzip(tb_http_server_session_t* session, tb_byte_t const* data, tb_size_t size, tb_size_t* psize)
+{
+    // open the gzip filter
+    tb_check_return_val(tb_http_server_session_gzip_open(session), tb_null);
+
+    // compress all data
+    tb_byte_t const* odata = tb_null;
+    tb_buffer_clear(&session->zdata);
+    tb_long_t real = tb_filter_spak(session->zip, data, size, &odata, 0, -1);
+    while (real > 0)
+    {
+        tb_buffer_memncat(&session->zdata, odata, real);
+        real = tb_filter_spak(session->zip, tb_null, 0, &odata, 0, -1);
+    }
+
+    // close it for resetting the gzip stream
+    tb_filter_clos(session->zip);
+
+    // ok?
+    *psize = tb_buffer_size(&session->zdata);
+    return *psize? tb_buffer_data(&session->zdata) : tb_null;
+}
+#endif
+static tb_char_t* tb_http_server_head_cat(tb_char_t* p, tb_char_t const* e, tb_char_t const* data, tb_size_t size)
+{
+    // check
+    tb_check_return_val(p && p + size < e, tb_null);
+
+    // append it
+    tb_memcpy(p, data, size);
+    return p + size;
+}
+static tb_char_t* tb_http_server_head_catu(tb_char_t* p, tb_char_t const* e, tb_hize_t value, tb_size_t base)
+{
+    // make digits in reverse order
+    tb_char_t   digits[32];
+    tb_size_t   n = 0;
+    do
+    {
+        digits[n++] = "0123456789abcdef"[value % base];
+        value /= base;
+
+    } while (value);
+
+    // check
+    tb_check_return_val(p && p + n < e, tb_null);
+
+    // append it
+    while (n) *p++ = digits[--n];
+    return p;
+}
+static tb_bool_t tb_http_server_session_head_writ(tb_http_server_session_t* session, tb_size_t code, tb_char_t const* type, tb_hize_t size, tb_bool_t bchunked, tb_bool_t bzip)
+{
+    // the request
+    tb_http_server_request_t* request = &session->request;
+
+    // the status line, we make it without formatting because it is the hot path of the small responses
+    tb_char_t*          p = session->line;
+    tb_char_t const*    e = session->line + sizeof(session->line);
+    tb_char_t const*    reason = tb_http_server_code_cstr(code);
+    p = tb_http_server_head_cat(p, e, "HTTP/1.1 ", 9);
+    p = tb_http_server_head_catu(p, e, code, 10);
+    p = tb_http_server_head_cat(p, e, " ", 1);
+    p = tb_http_server_head_cat(p, e, reason, tb_strlen(reason));
+    p = tb_http_server_head_cat(p, e, "\r\nServer: " TB_VERSION_SHORT_STRING "\r\n", sizeof("\r\nServer: " TB_VERSION_SHORT_STRING "\r\n") - 1);
+
+    // the content heads
+    if (type)
+    {
+        p = tb_http_server_head_cat(p, e, "Content-Type: ", 14);
+        p = tb_http_server_head_cat(p, e, type, tb_strlen(type));
+        p = tb_http_server_head_cat(p, e, "\r\n", 2);
+    }
+    if (bchunked) p = tb_http_server_head_cat(p, e, "Transfer-Encoding: chunked\r\n", 28);
+    else if (size != (tb_hize_t)-1)
+    {
+        p = tb_http_server_head_cat(p, e, "Content-Length: ", 16);
+        p = tb_http_server_head_catu(p, e, size, 10);
+        p = tb_http_server_head_cat(p, e, "\r\n", 2);
+    }
+    if (bzip) p = tb_http_server_head_cat(p, e, "Content-Encoding: gzip\r\nVary: Accept-Encoding\r\n", 47);
+    if (request->balived) p = tb_http_server_head_cat(p, e, "Connection: keep-alive\r\n", 24);
+    else p = tb_http_server_head_cat(p, e, "Connection: close\r\n", 19);
+    tb_assert_and_check_return_val(p, tb_false);
+
+    // write them
+    if (!tb_http_server_session_writ(session, (tb_byte_t const*)session->line, p - session->line)) return tb_false;
+
+    // write the user heads
+    if (tb_buffer_size(&session->heads))
+    {
+        if (!tb_http_server_session_writ(session, tb_buffer_data(&session->heads), tb_buffer_size(&session->heads))) return tb_false;
+        tb_buffer_clear(&session->heads);
+    }
+
+    // end
+    return tb_http_server_session_writ(session, (tb_byte_t const*)"\r\n", 2);
+}
+static tb_bool_t tb_http_server_session_chunk_send(tb_http_server_session_t* session, tb_byte_t const* data, tb_size_t size)
+{
+    // no body for HEAD
+    tb_check_return_val(session->request.method != TB_HTTP_METHOD_HEAD && size, tb_true);
+
+    // send the raw data for HTTP/1.0
+    if (session->braw) return tb_http_server_session_writ(session, data, size);
+
+    // send the chunk
+    tb_char_t* p = tb_http_server_head_catu(session->line, session->line + sizeof(session->line), size, 16);
+    p = tb_http_server_head_cat(p, session->line + sizeof(session->line), "\r\n", 2);
+    return      p
+            &&  tb_http_server_session_writ(session, (tb_byte_t const*)session->line, p - session->line)
+            &&  tb_http_server_session_writ(session, data, size)
+            &&  tb_http_server_session_writ(session, (tb_byte_t const*)"\r\n", 2);
+}
+static tb_size_t tb_http_server_session_head_parse(tb_http_server_session_t* session, tb_hize_t* pbody_size)
+{
+    // the request
+    tb_http_server_request_t* request = &session->request;
+
+    // the head data, the last line must be terminated by "\r\n\r\n"
+    tb_char_t*  p = (tb_char_t*)session->data;
+    tb_char_t*  e = p + session->head_size;
+    tb_char_t*  line = tb_null;
+    tb_bool_t   bclose = tb_false;
+    tb_bool_t   balive = tb_false;
+    tb_size_t   index = 0;
+    while (p < e)
+    {
+        // get the line and terminate it
+        line = p;
+        while (p < e && *p != '\n') p++;
+        tb_assert_and_check_return_val(p < e, TB_HTTP_CODE_BAD_REQUEST);
+        if (p > line && p[-1] == '\r') p[-1] = '\0';
+        *p++ = '\0';
+
+        // the end line?
+        tb_check_break(*line);
+
+        // the request line, e.g. GET /path?args HTTP/1.1
+        if (!index++)
+        {
+            // the method
+            tb_char_t* target = tb_strchr(line, ' ');
+            tb_check_return_val(target, TB_HTTP_CODE_BAD_REQUEST);
+            *target++ = '\0';
+
+            // the version
+            tb_char_t* version = tb_strchr(target, ' ');
+            tb_check_return_val(version, TB_HTTP_CODE_BAD_REQUEST);
+            *version++ = '\0';
+
+            // parse method
+            tb_size_t method = TB_HTTP_METHOD_GET;
+            for (method = TB_HTTP_METHOD_GET; method <= TB_HTTP_METHOD_CONNECT; method++)
+            {
+                if (!tb_strcmp(line, tb_http_method_cstr(method))) break;
+            }
+            tb_check_return_val(method <= TB_HTTP_METHOD_CONNECT, TB_HTTP_CODE_NOT_IMPLEMENTED);
+            request->method = (tb_uint16_t)method;
+
+            // parse version
+            if (!tb_strcmp(version, "HTTP/1.1")) request->version = 1;
+            else if (!tb_strcmp(version, "HTTP/1.0")) request->version = 0;
+            else return TB_HTTP_CODE_BAD_REQUEST;
+
+            // parse path and arguments
+            tb_check_return_val(*target == '/' || !tb_strcmp(target, "*"), TB_HTTP_CODE_BAD_REQUEST);
+            tb_char_t* args = tb_strchr(target, '?');
+            if (args) *args++ = '\0';
+            request->path = target;
+            request->args = args;
+        }
+        // key: value
+        else
+        {
+            // the name
+            tb_char_t* value = tb_strchr(line, ':');
+            tb_check_return_val(value && value > line, TB_HTTP_CODE_BAD_REQUEST);
+            *value++ = '\0';
+
+            // trim the value
+            while (*value == ' ' || *value == '\t') value++;
+            tb_char_t* end = value + tb_strlen(value);
+            while (end > value && (end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+
+            // too many heads?
+            tb_check_return_val(request->heads_size < TB_HTTP_SERVER_HEAD_MAXN, TB_HTTP_CODE_BAD_REQUEST);
+
+            // save it
+            request->heads[request->heads_size].name = line;
+            request->heads[request->heads_size].value = value;
+            request->heads_size++;
+
+            // parse content-length
+            if (!tb_stricmp(line, "Content-Length"))
+            {
+                tb_hize_t           size = 0;
+                tb_char_t const*    digit = value;
+                tb_check_return_val(*digit, TB_HTTP_CODE_BAD_REQUEST);
+                for (; *digit; digit++)
+                {
+                    tb_check_return_val(tb_isdigit(*digit), TB_HTTP_CODE_BAD_REQUEST);
+                    tb_check_return_val(size <= TB_HTTP_SERVER_BODY_MAXN, TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+                    size = size * 10 + (*digit - '0');
+                }
+                tb_check_return_val(size <= TB_HTTP_SERVER_BODY_MAXN, TB_HTTP_CODE_REQUEST_ENTITY_TOO_LONG);
+                *pbody_size = size;
+            }
+            // parse connection
+            else if (!tb_stricmp(line, "Connection"))
+            {
+                if (tb_stristr(value, "close")) bclose = tb_true;
+                else if (tb_stristr(value, "keep-alive")) balive = tb_true;
+            }
+            // the chunked request body is not supported
+            else if (!tb_stricmp(line, "Transfer-Encoding"))
+            {
+                tb_check_return_val(!tb_stricmp(value, "identity"), TB_HTTP_CODE_NOT_IMPLEMENTED);
+            }
+            // parse accept-encoding
+            else if (!tb_stricmp(line, "Accept-Encoding"))
+                request->bgzip = tb_stristr(value, "gzip")? 1 : 0;
+        }
+    }
+
+    // no request line?
+    tb_check_return_val(request->path, TB_HTTP_CODE_BAD_REQUEST);
+
+    // keep alive? it is enabled by default for HTTP/1.1
+    request->balived = !bclose && (request->version || balive);
+
+    // ok
+    return TB_HTTP_CODE_OK;
+}
+static tb_void_t tb_http_server_session_head_rebase(tb_http_server_session_t* session, tb_size_t from, tb_size_t to)
+{
+    // the request
+    tb_http_server_request_t* request = &session->request;
+
+    // rebase the path, arguments and heads which point to the head data
+#define tb_http_server_rebase(ptr)      if (ptr) (ptr) = (tb_char_t const*)((tb_size_t)(ptr) - from + to)
+    tb_http_server_rebase(request->path);
+    tb_http_server_rebase(request->args);
+    tb_size_t i = 0;
+    for (i = 0; i < request->heads_size; i++)
+    {
+        tb_http_server_rebase(request->heads[i].name);
+        tb_http_server_rebase(request->heads[i].value);
+    }
+#undef tb_http_server_rebase
+}
+static tb_bool_t tb_http_server_session_data_grow(tb_http_server_session_t* session, tb_size_t need)
+{
+    // enough?
+    tb_check_return_val(session->maxn < need, tb_true);
+
+    /* the head has been parsed? save the offsets of its strings 
+     *
+     * the data may be moved after growing, e.g. for the large request body
+     */
+    if (session->head_size) tb_http_server_session_head_rebase(session, (tb_size_t)session->data, 0);
+
+    // grow it
+    tb_size_t maxn = tb_align(need, TB_HTTP_SERVER_DATA_GROW);
+    tb_byte_t* data = tb_ralloc_bytes(session->data, maxn);
+    if (data)
+    {
+        session->data = data;
+        session->maxn = maxn;
+    }
+
+    // restore the strings of the head to the new data, the old data is still valid if failed
+    if (session->head_size) tb_http_server_session_head_rebase(session, 0, (tb_size_t)session->data);
+
+    // ok?
+    tb_assert_and_check_return_val(data, tb_false);
+    return tb_true;
+}
+static tb_size_t tb_http_server_session_recv(tb_http_server_session_t* session)
+{
+    // init request
+    tb_http_server_request_t* request = &session->request;
+    request->path       = tb_null;
+    request->args       = tb_null;
+    request->body       = tb_null;
+    request->body_size  = 0;
+    request->heads_size = 0;
+    request->bgzip      = 0;
+    session->head_size  = 0;
+
+    // recv the request
+    tb_hize_t   body_size = 0;
+    tb_long_t   wait = 0;
+    tb_long_t   timeout = session->worker->server->timeout;
+    while (1)
+    {
+        // find the head end, we need not scan the scanned data again for the pipelined requests
+        if (!session->head_size && session->size)
+        {
+            tb_size_t   i = session->scan > 3? session->scan - 3 : 0;
+            tb_byte_t*  p = session->data;
+            for (; i + 3 < session->size; i++)
+            {
+                if (p[i] == '\r' && p[i + 1] == '\n' && p[i + 2] == '\r' && p[i + 3] == '\n')
+                    break;
+            }
+
+            // found? parse it
+            if (i + 3 < session->size)
+            {
+                session->head_size = i + 4;
+                tb_size_t code = tb_http_server_session_head_parse(session, &body_size);
+                tb_check_return_val(code == TB_HTTP_CODE_OK, code);
+            }
+            else
+            {
+                session->scan = session->size;
+                tb_check_return_val(session->size < TB_HTTP_SERVER_HEAD_DATA_MAXN, TB_HTTP_CODE_BAD_REQUEST);
+            }
+        }
+
+        // the request has been finished?
+        if (session->head_size)
+        {
+            tb_size_t need = session->head_size + (tb_size_t)body_size;
+            if (session->size >= need)
+            {
+                request->body       = body_size? session->data + session->head_size : tb_null;
+                request->body_size  = (tb_size_t)body_size;
+                return TB_HTTP_CODE_OK;
+            }
+
+            // grow data for the whole body
+            if (!tb_http_server_session_data_grow(session, need)) return TB_HTTP_CODE_INTERNAL_SERVER_ERROR;
+        }
+        // grow data for the head
+        else if (session->size == session->maxn && !tb_http_server_session_data_grow(session, session->maxn + TB_HTTP_SERVER_DATA_GROW))
+            return TB_HTTP_CODE_INTERNAL_SERVER_ERROR;
+
+        // recv it
+        tb_long_t real = tb_socket_recv(session->sock, session->data + session->size, session->maxn - session->size);
+
+        // has data?
+        if (real > 0)
+        {
+            session->size += real;
+            wait = 0;
+        }
+        // no data? flush the buffered responses and wait it
+        else if (!real && !wait)
+        {
+            if (!tb_http_server_session_flush(session)) break;
+            wait = tb_socket_wait(session->sock, TB_SOCKET_EVENT_RECV, timeout);
+            tb_check_break(wait > 0);
+        }
+        // failed or closed?
+        else break;
+    }
+
+    // closed
+    return 0;
+}
+static tb_bool_t tb_http_server_session_error(tb_http_server_session_t* session, tb_size_t code)
+{
+    // make the error page
+    tb_long_t n = tb_snprintf(session->path, sizeof(session->path), "%lu %s", code, tb_http_server_code_cstr(code));
+    tb_assert_and_check_return_val(n > 0, tb_false);
+
+    // respond it
+    return tb_http_server_response_data((tb_http_server_session_ref_t)session, code, "text/plain", (tb_byte_t const*)session->path, n);
+}
+static tb_bool_t tb_http_server_session_file(tb_http_server_session_t* session)
+{
+    // the request
+    tb_http_server_request_t* request = &session->request;
+
+    // no root directory?
+    tb_http_server_t* server = session->worker->server;
+    tb_check_return_val(server->rootdir[0], tb_http_server_session_error(session, TB_HTTP_CODE_NOT_FOUND));
+
+    // only get and head
+    if (request->method != TB_HTTP_METHOD_GET && request->method != TB_HTTP_METHOD_HEAD)
+        return tb_http_server_session_error(session, TB_HTTP_CODE_METHOD_NOT_ALLOWED);
+
+    // make the file path
+    tb_size_t n = tb_strlcpy(session->path, server->rootdir, sizeof(session->path));
+    tb_assert_and_check_return_val(n < sizeof(session->path), tb_false);
+    n += tb_url_decode(request->path, tb_strlen(request->path), session->path + n, sizeof(session->path) - n - 1);
+
+    // forbid the parent directory
+    if (tb_strstr(session->path, "..")) return tb_http_server_session_error(session, TB_HTTP_CODE_FORBIDDEN);
+
+    // the index file
+    if (n && session->path[n - 1] == '/') tb_strlcpy(session->path + n, "index.html", sizeof(session->path) - n);
+
+    // respond it
+    return tb_http_server_response_file((tb_http_server_session_ref_t)session, session->path);
+}
+static tb_bool_t tb_http_server_session_done(tb_http_server_session_t* session)
+{
+    // trace
+    tb_trace_d("request: %s %s", tb_http_method_cstr(session->request.method), session->request.path);
+
+    // handle it
+    tb_http_server_t* server = session->worker->server;
+    session->bresponded = 0;
+    tb_bool_t ok = tb_false;
+    if (server->func) ok = server->func((tb_http_server_session_ref_t)session, &session->request, server->priv);
+
+    // respond the static file if not be handled
+    if (!ok && !session->bresponded) tb_http_server_session_file(session);
+    // no response?
+    else if (!session->bresponded) tb_http_server_session_error(session, TB_HTTP_CODE_INTERNAL_SERVER_ERROR);
+
+    // end the chunked response
+    if (session->bchunked) tb_http_server_response_chunk_exit((tb_http_server_session_ref_t)session);
+
+    // clear the unused response heads
+    tb_buffer_clear(&session->heads);
+
+    // ok?
+    return !session->bfailed;
+}
+static tb_void_t tb_http_server_session_exit(tb_http_server_session_t* session)
+{
+    // check
+    tb_assert_and_check_return(session);
+
+    // remove it from the worker
+    tb_http_server_worker_t* worker = session->worker;
+    tb_spinlock_enter(&worker->lock);
+    tb_list_entry_remove(&worker->sessions, &session->entry);
+    tb_spinlock_leave(&worker->lock);
+
+    // exit socket
+    if (session->sock) tb_socket_exit(session->sock);
+    session->sock = tb_null;
+
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    // exit the gzip filter
+    if (session->zip) tb_filter_exit(session->zip);
+    session->zip = tb_null;
+#endif
+
+    // exit data
+    if (session->data) tb_free(session->data);
+    session->data = tb_null;
+
+    // exit buffers
+    tb_buffer_exit(&session->out);
+    tb_buffer_exit(&session->heads);
+    tb_buffer_exit(&session->zdata);
+
+    // exit it
+    tb_free(session);
+}
+static tb_http_server_session_t* tb_http_server_session_init(tb_http_server_worker_t* worker, tb_socket_ref_t sock)
+{
+    // check
+    tb_assert_and_check_return_val(worker && sock, tb_null);
+
+    // make session
+    tb_http_server_session_t* session = tb_malloc0_type(tb_http_server_session_t);
+    tb_assert_and_check_return_val(session, tb_null);
+
+    // init session
+    session->worker = worker;
+    session->sock   = sock;
+    tb_buffer_init(&session->out);
+    tb_buffer_init(&session->heads);
+    tb_buffer_init(&session->zdata);
+
+    // add it to the worker, we need not add it if the server has been killed
+    tb_bool_t ok = tb_false;
+    tb_spinlock_enter(&worker->lock);
+    if (!tb_atomic_get(&worker->server->stopped))
+    {
+        tb_list_entry_insert_tail(&worker->sessions, &session->entry);
+        ok = tb_true;
+    }
+    tb_spinlock_leave(&worker->lock);
+
+    // failed?
+    if (!ok)
+    {
+        tb_buffer_exit(&session->out);
+        tb_buffer_exit(&session->heads);
+        tb_buffer_exit(&session->zdata);
+        tb_free(session);
+        session = tb_null;
+    }
+    return session;
+}
+static tb_void_t tb_http_server_session_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)priv;
+    tb_assert_and_check_return(session);
+
+    // done
+    while (!tb_atomic_get(&session->worker->server->stopped))
+    {
+        // recv the request
+        tb_size_t code = tb_http_server_session_recv(session);
+        tb_check_break(code);
+
+        // bad request? respond it and close the connection
+        if (code != TB_HTTP_CODE_OK)
+        {
+            session->request.balived = 0;
+            session->request.method = TB_HTTP_METHOD_GET;
+            tb_http_server_session_error(session, code);
+            break;
+        }
+
+        // handle the request
+        if (!tb_http_server_session_done(session)) break;
+
+        // close it?
+        tb_check_break(session->request.balived);
+
+        // move the pipelined requests to the head
+        tb_size_t used = session->head_size + session->request.body_size;
+        tb_assert_and_check_break(used <= session->size);
+        if (used < session->size) tb_memmov(session->data, session->data + used, session->size - used);
+        session->size -= used;
+        session->scan = 0;
+    }
+
+    // flush the left responses
+    tb_http_server_session_flush(session);
+
+    // exit session
+    tb_http_server_session_exit(session);
+}
+static tb_void_t tb_http_server_worker_listen(tb_cpointer_t priv)
+{
+    // check
+    tb_http_server_worker_t* worker = (tb_http_server_worker_t*)priv;
+    tb_assert_and_check_return(worker && worker->sock);
+
+    // accept and start the connections on the current scheduler
+    tb_socket_ref_t sock = tb_null;
+    while (!tb_atomic_get(&worker->server->stopped))
+    {
+        // accept it
+        if ((sock = tb_socket_accept(worker->sock, tb_null)))
+        {
+            // init session
+            tb_http_server_session_t* session = tb_http_server_session_init(worker, sock);
+            if (!session)
+            {
+                tb_socket_exit(sock);
+                continue;
+            }
+
+            // start session
+            if (!tb_coroutine_start(tb_null, tb_http_server_session_loop, session, TB_HTTP_SERVER_STACKSIZE))
+                tb_http_server_session_exit(session);
+        }
+        // wait it
+        else if (tb_socket_wait(worker->sock, TB_SOCKET_EVENT_ACPT, -1) <= 0) break;
+    }
+}
+static tb_int_t tb_http_server_worker_loop(tb_cpointer_t priv)
+{
+    // check
+    tb_http_server_worker_t* worker = (tb_http_server_worker_t*)priv;
+    tb_assert_and_check_return_val(worker && worker->sock, -1);
+
+    // init scheduler
+    tb_co_scheduler_ref_t scheduler = tb_co_scheduler_init();
+    tb_assert_and_check_return_val(scheduler, -1);
+
+    // start the listener and run it until all connections are closed
+    if (tb_coroutine_start(scheduler, tb_http_server_worker_listen, worker, 0))
+        tb_co_scheduler_loop(scheduler, tb_true);
+
+    // exit scheduler
+    tb_co_scheduler_exit(scheduler);
+    return 0;
+}
+static tb_socket_ref_t tb_http_server_listen(tb_ipaddr_ref_t addr)
+{
+    // init socket
+    tb_socket_ref_t sock = tb_socket_init(TB_SOCKET_TYPE_TCP, tb_ipaddr_family(addr));
+    tb_assert_and_check_return_val(sock, tb_null);
+
+    // bind and listen it, SO_REUSEPORT will be enabled for the non-zero port
+    if (!tb_socket_bind(sock, addr) || !tb_socket_listen(sock, TB_HTTP_SERVER_BACKLOG))
+    {
+        tb_socket_exit(sock);
+        sock = tb_null;
+    }
+    return sock;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_http_server_ref_t tb_http_server_init(tb_char_t const* host, tb_uint16_t port, tb_size_t count)
+{
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_http_server_t*   server = tb_null;
+    do
+    {
+        // make server
+        server = tb_malloc0_type(tb_http_server_t);
+        tb_assert_and_check_break(server);
+
+        // init server
+        server->timeout = TB_HTTP_SERVER_DEFAULT_TIMEOUT;
+        server->count   = count? count : tb_processor_count();
+        server->count   = tb_max(server->count, 1);
+
+        // init address
+        tb_ipaddr_t addr;
+        if (!tb_ipaddr_set(&addr, host, port, host? TB_IPADDR_FAMILY_NONE : TB_IPADDR_FAMILY_IPV4)) break;
+
+        // get a random port first, we need bind all listeners with SO_REUSEPORT on the same non-zero port
+        if (!port)
+        {
+            tb_socket_ref_t probe = tb_http_server_listen(&addr);
+            tb_assert_and_check_break(probe);
+
+            tb_ipaddr_t local;
+            if (tb_socket_local(probe, &local)) port = tb_ipaddr_port(&local);
+            tb_socket_exit(probe);
+            tb_assert_and_check_break(port);
+            tb_ipaddr_port_set(&addr, port);
+        }
+        server->port = port;
+
+        // init workers
+        server->workers = tb_nalloc0_type(server->count, tb_http_server_worker_t);
+        tb_assert_and_check_break(server->workers);
+
+        // init listeners
+        tb_size_t i = 0;
+        for (i = 0; i < server->count; i++)
+        {
+            // init worker
+            tb_http_server_worker_t* worker = &server->workers[i];
+            worker->server = server;
+            tb_spinlock_init(&worker->lock);
+            tb_list_entry_init(&worker->sessions, tb_http_server_session_t, entry, tb_null);
+
+            // listen it, share the listener of the worker 0 if SO_REUSEPORT is not supported
+            worker->sock = tb_http_server_listen(&addr);
+            if (!worker->sock && i)
+            {
+                worker->sock    = server->workers[0].sock;
+                worker->bshared = tb_true;
+            }
+            tb_check_break(worker->sock);
+        }
+        tb_check_break(i == server->count);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // trace
+        tb_trace_e("init: %s:%u failed!", host? host : "any", port);
+
+        // exit it
+        if (server) tb_http_server_exit((tb_http_server_ref_t)server);
+        server = tb_null;
+    }
+    return (tb_http_server_ref_t)server;
+}
+tb_void_t tb_http_server_exit(tb_http_server_ref_t self)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return(server);
+
+    // exit workers
+    if (server->workers)
+    {
+        tb_size_t i = 0;
+        for (i = 0; i < server->count; i++)
+        {
+            // the worker
+            tb_http_server_worker_t* worker = &server->workers[i];
+            tb_check_continue(worker->server);
+            tb_assert(!worker->thread);
+
+            // exit the listener
+            if (worker->sock && !worker->bshared) tb_socket_exit(worker->sock);
+            worker->sock = tb_null;
+
+            // exit sessions
+            tb_list_entry_exit(&worker->sessions);
+            tb_spinlock_exit(&worker->lock);
+        }
+        tb_free(server->workers);
+        server->workers = tb_null;
+    }
+
+    // exit it
+    tb_free(server);
+}
+tb_bool_t tb_http_server_ctrl(tb_http_server_ref_t self, tb_size_t ctrl, ...)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return_val(server, tb_false);
+
+    // init args
+    tb_va_list_t args;
+    tb_va_start(args, ctrl);
+
+    // done
+    tb_bool_t ok = tb_true;
+    switch (ctrl)
+    {
+    case TB_HTTP_SERVER_CTRL_SET_FUNC:
+        {
+            server->func = (tb_http_server_func_t)tb_va_arg(args, tb_http_server_func_t);
+            server->priv = (tb_cpointer_t)tb_va_arg(args, tb_cpointer_t);
+        }
+        break;
+    case TB_HTTP_SERVER_CTRL_SET_ROOTDIR:
+        {
+            // save the root directory without the trailing '/'
+            tb_char_t const* rootdir = (tb_char_t const*)tb_va_arg(args, tb_char_t const*);
+            tb_size_t n = rootdir? tb_strlcpy(server->rootdir, rootdir, sizeof(server->rootdir)) : 0;
+            if (n >= sizeof(server->rootdir)) ok = tb_false;
+            else
+            {
+                while (n && server->rootdir[n - 1] == '/') n--;
+                server->rootdir[n] = '\0';
+            }
+        }
+        break;
+    case TB_HTTP_SERVER_CTRL_SET_GZIP:
+        {
+            // gzip is supported only if the zip module and zlib are enabled
+            tb_bool_t bgzip = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+            server->bgzip = bgzip;
+#else
+            ok = !bgzip;
+#endif
+        }
+        break;
+    case TB_HTTP_SERVER_CTRL_SET_TIMEOUT:
+        {
+            tb_long_t timeout = (tb_long_t)tb_va_arg(args, tb_long_t);
+            server->timeout = timeout? timeout : TB_HTTP_SERVER_DEFAULT_TIMEOUT;
+        }
+        break;
+    case TB_HTTP_SERVER_CTRL_GET_PORT:
+        {
+            tb_uint16_t* pport = (tb_uint16_t*)tb_va_arg(args, tb_uint16_t*);
+            if (pport) *pport = server->port;
+            else ok = tb_false;
+        }
+        break;
+    default:
+        ok = tb_false;
+        break;
+    }
+
+    // exit args
+    tb_va_end(args);
+    return ok;
+}
+tb_void_t tb_http_server_loop(tb_http_server_ref_t self)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return(server && server->workers);
+
+    // run the other workers
+    tb_size_t i = 0;
+    for (i = 1; i < server->count; i++)
+    {
+        server->workers[i].thread = tb_thread_init(tb_null, tb_http_server_worker_loop, &server->workers[i], 0);
+        tb_assert(server->workers[i].thread);
+    }
+
+    // run the worker 0 on the current thread
+    tb_http_server_worker_loop(&server->workers[0]);
+
+    // wait the other workers
+    for (i = 1; i < server->count; i++)
+    {
+        tb_http_server_worker_t* worker = &server->workers[i];
+        if (worker->thread)
+        {
+            tb_thread_wait(worker->thread, -1, tb_null);
+            tb_thread_exit(worker->thread);
+            worker->thread = tb_null;
+        }
+    }
+}
+tb_void_t tb_http_server_kill(tb_http_server_ref_t self)
+{
+    // check
+    tb_http_server_t* server = (tb_http_server_t*)self;
+    tb_assert_and_check_return(server && server->workers);
+
+    // stop it
+    if (tb_atomic_fetch_and_set(&server->stopped, 1)) return ;
+
+    // shutdown all listeners and connections to wake up the waiting coroutines
+    tb_size_t i = 0;
+    for (i = 0; i < server->count; i++)
+    {
+        tb_http_server_worker_t* worker = &server->workers[i];
+        tb_spinlock_enter(&worker->lock);
+        if (worker->sock && !worker->bshared) tb_socket_kill(worker->sock, TB_SOCKET_KILL_RW);
+        tb_list_entry_ref_t entry = tb_list_entry_head(&worker->sessions);
+        tb_list_entry_ref_t tail = tb_list_entry_tail(&worker->sessions);
+        for (; entry != tail; entry = tb_list_entry_next(entry))
+        {
+            tb_http_server_session_t* session = (tb_http_server_session_t*)tb_list_entry0(entry);
+            tb_socket_kill(session->sock, TB_SOCKET_KILL_RW);
+        }
+        tb_spinlock_leave(&worker->lock);
+    }
+}
+tb_char_t const* tb_http_server_request_head(tb_http_server_request_t const* request, tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(request && name, tb_null);
+
+    // find it
+    tb_size_t i = 0;
+    for (i = 0; i < request->heads_size; i++)
+    {
+        if (!tb_stricmp(request->heads[i].name, name))
+            return request->heads[i].value;
+    }
+    return tb_null;
+}
+tb_bool_t tb_http_server_response_head(tb_http_server_session_ref_t self, tb_char_t const* name, tb_char_t const* value)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && name && value && !session->bresponded, tb_false);
+
+    // append it
+    return      tb_buffer_memncat(&session->heads, (tb_byte_t const*)name, tb_strlen(name))
+            &&  tb_buffer_memncat(&session->heads, (tb_byte_t const*)": ", 2)
+            &&  tb_buffer_memncat(&session->heads, (tb_byte_t const*)value, tb_strlen(value))
+            &&  tb_buffer_memncat(&session->heads, (tb_byte_t const*)"\r\n", 2);
+}
+tb_bool_t tb_http_server_response_data(tb_http_server_session_ref_t self, tb_size_t code, tb_char_t const* type, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && !session->bresponded && (data || !size), tb_false);
+
+    // responded
+    session->bresponded = 1;
+
+    // compress it
+    tb_bool_t bzip = tb_false;
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    if (tb_http_server_session_gzip_able(session, type, size))
+    {
+        tb_size_t           zsize = 0;
+        tb_byte_t const*    zdata = tb_http_server_session_gzip(session, data, size, &zsize);
+        if (zdata)
+        {
+            data = zdata;
+            size = zsize;
+            bzip = tb_true;
+        }
+    }
+#endif
+
+    // write the head
+    if (!tb_http_server_session_head_writ(session, code, type, size, tb_false, bzip)) return tb_false;
+
+    // write the body
+    if (session->request.method != TB_HTTP_METHOD_HEAD && size)
+        return tb_http_server_session_writ(session, data, size);
+    return tb_true;
+}
+tb_bool_t tb_http_server_response_file(tb_http_server_session_ref_t self, tb_char_t const* path)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && path && !session->bresponded, tb_false);
+
+    // not found?
+    tb_file_info_t info;
+    if (!tb_file_info(path, &info) || info.type != TB_FILE_TYPE_FILE)
+        return tb_http_server_session_error(session, TB_HTTP_CODE_NOT_FOUND);
+
+    // open file
+    tb_file_ref_t file = tb_file_init(path, TB_FILE_MODE_RO);
+    if (!file) return tb_http_server_session_error(session, TB_HTTP_CODE_NOT_FOUND);
+
+    // done
+    tb_bool_t           ok = tb_false;
+    tb_char_t const*    type = tb_http_server_mime_type(path);
+    do
+    {
+        // read and compress the small file
+        if (info.size <= TB_HTTP_SERVER_GZIP_FILE_MAXN && tb_http_server_session_gzip_able(session, type, (tb_size_t)info.size))
+        {
+            // read it
+            tb_size_t size = (tb_size_t)info.size;
+            tb_buffer_t data;
+            if (!tb_buffer_init(&data)) break;
+            if (tb_buffer_resize(&data, size) && tb_file_read(file, tb_buffer_data(&data), size) == (tb_long_t)size)
+                ok = tb_http_server_response_data(self, TB_HTTP_CODE_OK, type, tb_buffer_data(&data), size);
+            tb_buffer_exit(&data);
+            break;
+        }
+
+        // write the head
+        session->bresponded = 1;
+        if (!tb_http_server_session_head_writ(session, TB_HTTP_CODE_OK, type, info.size, tb_false, tb_false)) break;
+
+        // no body?
+        if (session->request.method == TB_HTTP_METHOD_HEAD || !info.size)
+        {
+            ok = tb_true;
+            break;
+        }
+
+        // flush the head
+        if (!tb_http_server_session_flush(session)) break;
+
+        // send file
+        tb_hize_t send = 0;
+        tb_long_t wait = 0;
+        while (send < info.size)
+        {
+            // send it
+            tb_hong_t real = tb_socket_sendf(session->sock, file, send, info.size - send);
+
+            // has data?
+            if (real > 0)
+            {
+                send += real;
+                wait = 0;
+            }
+            // no data? wait it
+            else if (!real && !wait)
+            {
+                wait = tb_socket_wait(session->sock, TB_SOCKET_EVENT_SEND, session->worker->server->timeout);
+                tb_check_break(wait > 0);
+            }
+            // failed or end?
+            else break;
+        }
+
+        // ok?
+        ok = send == info.size;
+        if (!ok) session->bfailed = 1;
+
+    } while (0);
+
+    // exit file
+    tb_file_exit(file);
+    return ok;
+}
+tb_bool_t tb_http_server_response_chunk_init(tb_http_server_session_ref_t self, tb_size_t code, tb_char_t const* type)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && !session->bresponded, tb_false);
+
+    // init chunked response
+    session->bresponded = 1;
+    session->bchunked   = 1;
+    session->braw       = 0;
+    session->bzip       = 0;
+
+    // HTTP/1.0 does not support chunked, we send the raw data and close the connection
+    if (!session->request.version)
+    {
+        session->request.balived = 0;
+        session->braw = 1;
+    }
+
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    // compress it?
+    if (    tb_http_server_session_gzip_able(session, type, TB_HTTP_SERVER_GZIP_MINN)
+        &&  tb_http_server_session_gzip_open(session))
+        session->bzip = 1;
+#endif
+
+    // write the head
+    return tb_http_server_session_head_writ(session, code, type, (tb_hize_t)-1, !session->braw, session->bzip);
+}
+tb_bool_t tb_http_server_response_chunk_writ(tb_http_server_session_ref_t self, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && session->bchunked && data, tb_false);
+
+    // write it
+    tb_bool_t ok = tb_true;
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    if (session->bzip)
+    {
+        // compress and sync it for sending it immediately
+        tb_byte_t const*    odata = tb_null;
+        tb_long_t           real = tb_filter_spak(session->zip, data, size, &odata, 0, 1);
+        while (ok && real > 0)
+        {
+            ok = tb_http_server_session_chunk_send(session, odata, real);
+            real = tb_filter_spak(session->zip, tb_null, 0, &odata, 0, 1);
+        }
+    }
+    else
+#endif
+    ok = tb_http_server_session_chunk_send(session, data, size);
+
+    // send it immediately
+    return ok && tb_http_server_session_flush(session);
+}
+tb_bool_t tb_http_server_response_chunk_exit(tb_http_server_session_ref_t self)
+{
+    // check
+    tb_http_server_session_t* session = (tb_http_server_session_t*)self;
+    tb_assert_and_check_return_val(session && session->bchunked, tb_false);
+
+    // end it
+    tb_bool_t ok = tb_true;
+    session->bchunked = 0;
+#if defined(TB_CONFIG_PACKAGE_HAVE_ZLIB) && defined(TB_CONFIG_MODULE_HAVE_ZIP)
+    if (session->bzip)
+    {
+        // finish the gzip stream
+        tb_byte_t const*    odata = tb_null;
+        tb_long_t           real = tb_filter_spak(session->zip, tb_null, 0, &odata, 0, -1);
+        while (ok && real > 0)
+        {
+            ok = tb_http_server_session_chunk_send(session, odata, real);
+            real = tb_filter_spak(session->zip, tb_null, 0, &odata, 0, -1);
+        }
+        tb_filter_clos(session->zip);
+        session->bzip = 0;
+    }
+#endif
+
+    // write the last chunk
+    if (ok && !session->braw && session->request.method != TB_HTTP_METHOD_HEAD)
+        ok = tb_http_server_session_writ(session, (tb_byte_t const*)"0\r\n\r\n", 5);
+    return ok && !session->bfailed;
+}
@@ -0,0 +1,286 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        http_server.h
+ * @ingroup     network
+ *
+ */
+#ifndef TB_NETWORK_HTTP_SERVER_H
+#define TB_NETWORK_HTTP_SERVER_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "http.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the request head maxn
+#define TB_HTTP_SERVER_HEAD_MAXN                (64)
+
+// the default keep-alive timeout, ms
+#define TB_HTTP_SERVER_DEFAULT_TIMEOUT          (30000)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// the http server ref type
+typedef __tb_typeref__(http_server);
+
+/// the http server session ref type
+typedef __tb_typeref__(http_server_session);
+
+/// the http server ctrl enum
+typedef enum __tb_http_server_ctrl_e
+{
+    TB_HTTP_SERVER_CTRL_NONE                = 0
+,   TB_HTTP_SERVER_CTRL_SET_FUNC            = 1     //!< set the request handler: tb_http_server_func_t func, tb_cpointer_t priv
+,   TB_HTTP_SERVER_CTRL_SET_ROOTDIR         = 2     //!< set the root directory of the static files: tb_char_t const* rootdir
+,   TB_HTTP_SERVER_CTRL_SET_GZIP            = 3     //!< enable gzip for the compressible responses: tb_bool_t bgzip
+,   TB_HTTP_SERVER_CTRL_SET_TIMEOUT         = 4     //!< set the keep-alive and io timeout: tb_long_t timeout (ms)
+,   TB_HTTP_SERVER_CTRL_GET_PORT            = 5     //!< get the listening port: tb_uint16_t* pport
+
+}tb_http_server_ctrl_e;
+
+/// the http server request head type
+typedef struct __tb_http_server_head_t
+{
+    /// the name
+    tb_char_t const*        name;
+
+    /// the value
+    tb_char_t const*        value;
+
+}tb_http_server_head_t;
+
+/*! the http server request type
+ *
+ * all strings are parsed in place and terminated in the receiving buffer of the connection,
+ * so they are only valid in the request handler.
+ */
+typedef struct __tb_http_server_request_t
+{
+    /// the method, TB_HTTP_METHOD_XXX
+    tb_uint16_t             method;
+
+    /// the minor version, 0: HTTP/1.0, 1: HTTP/1.1
+    tb_uint16_t             version     : 8;
+
+    /// keep alive?
+    tb_uint16_t             balived     : 1;
+
+    /// accept gzip?
+    tb_uint16_t             bgzip       : 1;
+
+    /// the path, not decoded
+    tb_char_t const*        path;
+
+    /// the query arguments after '?', null if no arguments
+    tb_char_t const*        args;
+
+    /// the heads
+    tb_http_server_head_t   heads[TB_HTTP_SERVER_HEAD_MAXN];
+
+    /// the heads count
+    tb_size_t               heads_size;
+
+    /// the body
+    tb_byte_t const*        body;
+
+    /// the body size
+    tb_size_t               body_size;
+
+}tb_http_server_request_t, *tb_http_server_request_ref_t;
+
+/*! the http server request handler type
+ *
+ * @param session   the session
+ * @param request   the request
+ * @param priv      the user private data
+ *
+ * @return          tb_true if it has been handled, otherwise the static file or 404 will be responded
+ */
+typedef tb_bool_t   (*tb_http_server_func_t)(tb_http_server_session_ref_t session, tb_http_server_request_t const* request, tb_cpointer_t priv);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/*! init the http server
+ *
+ * each worker thread runs its own coroutine scheduler and its own listener on the same port with SO_REUSEPORT,
+ * so the connections are balanced by the kernel and never migrate between threads.
+ *
+ * @code
+    static tb_bool_t tb_demo_http_handler(tb_http_server_session_ref_t session, tb_http_server_request_t const* request, tb_cpointer_t priv)
+    {
+        // handle it
+        if (!tb_strcmp(request->path, "/hello"))
+            return tb_http_server_response_data(session, TB_HTTP_CODE_OK, "text/plain", (tb_byte_t const*)"hello", 5);
+
+        // respond the static file
+        return tb_false;
+    }
+
+    tb_http_server_ref_t server = tb_http_server_init(tb_null, 8080, 0);
+    if (server)
+    {
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_FUNC, tb_demo_http_handler, tb_null);
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_ROOTDIR, "/var/www");
+        tb_http_server_ctrl(server, TB_HTTP_SERVER_CTRL_SET_GZIP, tb_true);
+
+        // run it until tb_http_server_kill() is called
+        tb_http_server_loop(server);
+        tb_http_server_exit(server);
+    }
+ * @endcode
+ *
+ * @param host      the listening host, any address if be null
+ * @param port      the listening port, using a random port if be zero
+ * @param count     the worker thread count, using the processor count if be zero
+ *
+ * @return          the server
+ */
+tb_http_server_ref_t    tb_http_server_init(tb_char_t const* host, tb_uint16_t port, tb_size_t count);
+
+/*! exit the http server
+ *
+ * @param server    the server
+ */
+tb_void_t               tb_http_server_exit(tb_http_server_ref_t server);
+
+/*! ctrl the http server, it must be called before tb_http_server_loop()
+ *
+ * @param server    the server
+ * @param ctrl      the ctrl code
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_ctrl(tb_http_server_ref_t server, tb_size_t ctrl, ...);
+
+/*! run all workers and wait them until the server is killed
+ *
+ * the worker 0 runs on the current thread
+ *
+ * @param server    the server
+ */
+tb_void_t               tb_http_server_loop(tb_http_server_ref_t server);
+
+/*! kill the http server, it is safe to call it from other threads
+ *
+ * all listeners and connections will be shut down and tb_http_server_loop() will return
+ *
+ * @param server    the server
+ */
+tb_void_t               tb_http_server_kill(tb_http_server_ref_t server);
+
+/*! get the request head value, the name is case-insensitive
+ *
+ * @param request   the request
+ * @param name      the head name
+ *
+ * @return          the head value, null if not found
+ */
+tb_char_t const*        tb_http_server_request_head(tb_http_server_request_t const* request, tb_char_t const* name);
+
+/*! add a response head before responding
+ *
+ * @param session   the session
+ * @param name      the head name
+ * @param value     the head value
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_response_head(tb_http_server_session_ref_t session, tb_char_t const* name, tb_char_t const* value);
+
+/*! respond the data, it will be compressed by gzip if the client and the content type accept it
+ *
+ * the small responses are buffered and sent together with the pipelined responses
+ *
+ * @param session   the session
+ * @param code      the http code, TB_HTTP_CODE_XXX
+ * @param type      the content type, optional
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_response_data(tb_http_server_session_ref_t session, tb_size_t code, tb_char_t const* type, tb_byte_t const* data, tb_size_t size);
+
+/*! respond the file by sendfile, the content type is guessed from the file extension
+ *
+ * @param session   the session
+ * @param path      the file path
+ *
+ * @return          tb_true or tb_false, it will respond 404 if the file does not exist
+ */
+tb_bool_t               tb_http_server_response_file(tb_http_server_session_ref_t session, tb_char_t const* path);
+
+/*! begin a chunked response
+ *
+ * @code
+    tb_http_server_response_chunk_init(session, TB_HTTP_CODE_OK, "text/plain");
+    tb_http_server_response_chunk_writ(session, data, size);
+    tb_http_server_response_chunk_writ(session, data, size);
+    tb_http_server_response_chunk_exit(session);
+ * @endcode
+ *
+ * @param session   the session
+ * @param code      the http code, TB_HTTP_CODE_XXX
+ * @param type      the content type, optional
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_response_chunk_init(tb_http_server_session_ref_t session, tb_size_t code, tb_char_t const* type);
+
+/*! write a chunk
+ *
+ * @param session   the session
+ * @param data      the data
+ * @param size      the size
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_response_chunk_writ(tb_http_server_session_ref_t session, tb_byte_t const* data, tb_size_t size);
+
+/*! end the chunked response, it will be ended automatically after the handler returns
+ *
+ * @param session   the session
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t               tb_http_server_response_chunk_exit(tb_http_server_session_ref_t session);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -48,6 +48,7 @@ tb_bool_t tb_http_option_init(tb_http_option_t* option)
     option->timeout    = TB_HTTP_DEFAULT_TIMEOUT;
     option->version    = 1; // HTTP/1.1
     option->bunzip     = 0;
+    option->balived    = 1;
     option->cookies    = tb_null;
 
     // init url
@@ -538,6 +539,27 @@ tb_bool_t tb_http_option_ctrl(tb_http_option_t* option, tb_size_t code, tb_va_li
             return tb_true;
         }
         break;
+    case TB_HTTP_OPTION_SET_KEEP_ALIVE:
+        {   
+            // balived
+            tb_bool_t balived = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+
+            // set balived
+            option->balived = balived? 1 : 0;
+            return tb_true;
+        }
+        break;
+    case TB_HTTP_OPTION_GET_KEEP_ALIVE:
+        {
+            // pbalived
+            tb_bool_t* pbalived = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(pbalived, tb_false);
+
+            // get balived
+            *pbalived = option->balived? tb_true : tb_false;
+            return tb_true;
+        }
+        break;
     case TB_HTTP_OPTION_SET_AUTO_UNZIP:
         {   
             // bunzip
@@ -624,6 +646,7 @@ tb_void_t tb_http_option_dump(tb_http_option_t* option)
     tb_trace_i("option: redirect: %d",          option->redirect);
     tb_trace_i("option: range: %llu-%llu",      option->range.bof, option->range.eof);
     tb_trace_i("option: bunzip: %s",            option->bunzip? "true" : "false");
+    tb_trace_i("option: balived: %s",           option->balived? "true" : "false");
 
     // dump head 
     tb_char_t const*    head_data = (tb_char_t const*)tb_buffer_data(&option->head_data);
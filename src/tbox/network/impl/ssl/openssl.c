@@ -846,3 +846,29 @@ tb_size_t tb_ssl_state(tb_ssl_ref_t self)
     return ssl->state;
 }
 
+tb_ssl_session_ref_t tb_ssl_session_get(tb_ssl_ref_t self)
+{
+    // the ssl
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && ssl->ssl, tb_null);
+
+    // not opened?
+    tb_check_return_val(ssl->bopened, tb_null);
+
+    // get session and increase its reference count
+    return (tb_ssl_session_ref_t)SSL_get1_session(ssl->ssl);
+}
+tb_bool_t tb_ssl_session_set(tb_ssl_ref_t self, tb_ssl_session_ref_t session)
+{
+    // the ssl
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && ssl->ssl && session, tb_false);
+
+    // set session, it will be referenced by ssl
+    return SSL_set_session(ssl->ssl, (SSL_SESSION*)session) == 1? tb_true : tb_false;
+}
+tb_void_t tb_ssl_session_exit(tb_ssl_session_ref_t session)
+{
+    // decrease the reference count of session
+    if (session) SSL_SESSION_free((SSL_SESSION*)session);
+}
@@ -676,3 +676,58 @@ tb_size_t tb_ssl_state(tb_ssl_ref_t self)
     // the state
     return ssl->state;
 }
+tb_ssl_session_ref_t tb_ssl_session_get(tb_ssl_ref_t self)
+{
+    // check
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl, tb_null);
+
+    // not opened?
+    tb_check_return_val(ssl->bopened, tb_null);
+
+    // make session
+    ssl_session* session = tb_malloc0_type(ssl_session);
+    tb_assert_and_check_return_val(session, tb_null);
+
+    // copy session
+    tb_long_t error = 0;
+    if ((error = ssl_get_session(&ssl->ssl, session)))
+    {
+        // trace
+        tb_ssl_error("ssl_get_session() failed", error);
+
+        // exit session
+        tb_ssl_session_exit((tb_ssl_session_ref_t)session);
+        session = tb_null;
+    }
+
+    // ok?
+    return (tb_ssl_session_ref_t)session;
+}
+tb_bool_t tb_ssl_session_set(tb_ssl_ref_t self, tb_ssl_session_ref_t session)
+{
+    // check
+    tb_ssl_t* ssl = (tb_ssl_t*)self;
+    tb_assert_and_check_return_val(ssl && session, tb_false);
+
+    // set session, it will be copied to ssl
+    tb_long_t error = 0;
+    if ((error = ssl_set_session(&ssl->ssl, (ssl_session const*)session)))
+    {
+        // trace
+        tb_ssl_error("ssl_set_session() failed", error);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+tb_void_t tb_ssl_session_exit(tb_ssl_session_ref_t session)
+{
+    // check
+    tb_check_return(session);
+
+    // exit session
+    ssl_session_free((ssl_session*)session);
+    tb_free(session);
+}
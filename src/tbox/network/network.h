@@ -37,6 +37,8 @@
 #include "ipaddr.h"
 #include "hwaddr.h"
 #include "http.h"
+#include "http_pool.h"
+#include "http_server.h"
 #include "cookies.h"
 #include "dns/dns.h"
 
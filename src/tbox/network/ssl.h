@@ -85,6 +85,9 @@ typedef tb_long_t   (*tb_ssl_func_wait_t)(tb_cpointer_t priv, tb_size_t code, tb
 /// the ssl ref type
 typedef __tb_typeref__(ssl);
 
+/// the ssl session ref type
+typedef __tb_typeref__(ssl_session);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -225,6 +228,31 @@ tb_long_t           tb_ssl_wait(tb_ssl_ref_t ssl, tb_size_t events, tb_long_t ti
  */
 tb_size_t           tb_ssl_state(tb_ssl_ref_t ssl);
 
+/*! get the session of the opened ssl for resuming it on the next connection
+ *
+ * @param ssl       the ssl
+ *
+ * @return          the new session, need be exited by tb_ssl_session_exit(), failed or not supported: tb_null
+ */
+tb_ssl_session_ref_t tb_ssl_session_get(tb_ssl_ref_t ssl);
+
+/*! set the session to resume it before opening ssl
+ *
+ * @note the session will be copied or referenced, so it can be exited after setting it
+ *
+ * @param ssl       the ssl
+ * @param session   the session
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_ssl_session_set(tb_ssl_ref_t ssl, tb_ssl_session_ref_t session);
+
+/*! exit the session
+ *
+ * @param session   the session
+ */
+tb_void_t           tb_ssl_session_exit(tb_ssl_session_ref_t session);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
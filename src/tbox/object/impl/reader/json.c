@@ -35,6 +35,12 @@
  */
 #include "json.h"
 #include "reader.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+#ifdef TB_ARCH_AVX2
+#   include <immintrin.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -47,9 +53,95 @@
 #   define TB_OC_JSON_READER_ARRAY_GROW             (256)
 #endif
 
+// the maximum buffered data size for the buffer mode
+#ifdef __tb_small__
+#   define TB_OC_JSON_READER_BUFFER_MAXN            (1 << 24)
+#else
+#   define TB_OC_JSON_READER_BUFFER_MAXN            (1 << 28)
+#endif
+
+// the maximum key size, the same as the key buffer of the stream mode
+#define TB_OC_JSON_READER_KEY_MAXN                  (8192)
+
+// the maximum token size, the same as the token buffer of the stream mode
+#define TB_OC_JSON_READER_TOKEN_MAXN                (256)
+
+// the swar mask of the matched bytes in the 64-bits data
+#define tb_oc_json_reader_swar_match(x, c)          tb_oc_json_reader_swar_zero((x) ^ (0x0101010101010101ULL * (tb_uint8_t)(c)))
+#define tb_oc_json_reader_swar_zero(x)              (((x) - 0x0101010101010101ULL) & ~(x) & 0x8080808080808080ULL)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the json buffer reader type
+typedef struct __tb_oc_json_buffer_reader_t
+{
+    // the current data
+    tb_byte_t const*            p;
+
+    // the data end
+    tb_byte_t const*            e;
+
+    // the key stack, the nested dictionaries push their keys to the top
+    tb_char_t*                  keys;
+
+    // the key stack size
+    tb_size_t                   keys_size;
+
+    // the key stack maxn
+    tb_size_t                   keys_maxn;
+
+    // the escaped string data
+    tb_buffer_t                 data;
+
+}tb_oc_json_buffer_reader_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the reader mode
+static tb_size_t                g_mode = TB_OC_JSON_READER_MODE_BUFFER;
+
+// have the hooked reader funcs?
+static tb_bool_t                g_hooked = tb_false;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
+static tb_object_ref_t tb_oc_json_reader_number_init(tb_bool_t bs, tb_uint64_t value)
+{
+    // init number 
+    tb_object_ref_t number = tb_null;
+    if (bs) 
+    {
+        tb_size_t bytes = tb_object_need_bytes(-(tb_sint64_t)value);
+        switch (bytes)
+        {
+        case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)value); break;
+        case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)value); break;
+        case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)value); break;
+        case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)value); break;
+        default: break;
+        }
+    }
+    else 
+    {
+        tb_size_t bytes = tb_object_need_bytes(value);
+        switch (bytes)
+        {
+        case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
+        case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
+        case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
+        case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
+        default: break;
+        }
+    }
+
+    // ok?
+    return number;
+}
 static tb_object_ref_t tb_oc_json_reader_func_null(tb_oc_json_reader_t* reader, tb_char_t type)
 {
     // check
@@ -293,37 +385,11 @@ static tb_object_ref_t tb_oc_json_reader_func_number(tb_oc_json_reader_t* reader
 
         // init number 
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
-        if (bf) number = tb_oc_number_init_from_float(tb_stof(tb_static_string_cstr(&data)));
+        if (bf) number = tb_oc_number_init_from_double(tb_stod(tb_static_string_cstr(&data)));
 #else
         if (bf) tb_trace_noimpl();
 #endif
-        else if (bs) 
-        {
-            tb_sint64_t value = tb_stoi64(tb_static_string_cstr(&data));
-            tb_size_t   bytes = tb_object_need_bytes(-value);
-            switch (bytes)
-            {
-            case 1: number = tb_oc_number_init_from_sint8((tb_sint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_sint16((tb_sint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_sint32((tb_sint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_sint64((tb_sint64_t)value); break;
-            default: break;
-            }
-            
-        }
-        else 
-        {
-            tb_uint64_t value = tb_stou64(tb_static_string_cstr(&data));
-            tb_size_t   bytes = tb_object_need_bytes(value);
-            switch (bytes)
-            {
-            case 1: number = tb_oc_number_init_from_uint8((tb_uint8_t)value); break;
-            case 2: number = tb_oc_number_init_from_uint16((tb_uint16_t)value); break;
-            case 4: number = tb_oc_number_init_from_uint32((tb_uint32_t)value); break;
-            case 8: number = tb_oc_number_init_from_uint64((tb_uint64_t)value); break;
-            default: break;
-            }
-        }
+        else number = tb_oc_json_reader_number_init(bs, tb_stou64(tb_static_string_cstr(&data)));
 
     } while (0);
 
@@ -473,11 +539,561 @@ static tb_object_ref_t tb_oc_json_reader_func_dictionary(tb_oc_json_reader_t* re
     // ok?
     return dictionary;
 }
+static __tb_inline__ tb_byte_t const* tb_oc_json_buffer_reader_skip(tb_byte_t const* p, tb_byte_t const* e)
+{
+    // no spaces? it is the common case for the compact data
+    if (p < e && !tb_isspace(*p) && *p != ',') return p;
+
+#ifdef TB_ARCH_SSE2
+    // skip the spaces and ',' for the indented data
+    __m128i space = _mm_set1_epi8(' ');
+    __m128i comma = _mm_set1_epi8(',');
+    __m128i ctrl0 = _mm_set1_epi8('\t');
+    __m128i ctrln = _mm_set1_epi8('\r' - '\t');
+    while (p + 16 <= e)
+    {
+        // ctrl: '\t' <= ch <= '\r'
+        __m128i data = _mm_loadu_si128((__m128i const*)p);
+        __m128i ctrl = _mm_sub_epi8(data, ctrl0);
+        __m128i mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, space), _mm_cmpeq_epi8(data, comma)), _mm_cmpeq_epi8(_mm_min_epu8(ctrl, ctrln), ctrl));
+
+        // find the first non-space character
+        tb_uint32_t bits = ~(tb_uint32_t)_mm_movemask_epi8(mask) & 0xffff;
+        if (bits) return p + tb_bits_fb1_u32_le(bits);
+        p += 16;
+    }
+#endif
+
+    // skip the left spaces and ','
+    while (p < e && (tb_isspace(*p) || *p == ',')) p++;
+    return p;
+}
+static __tb_inline__ tb_byte_t const* tb_oc_json_buffer_reader_find(tb_byte_t const* p, tb_byte_t const* e)
+{
+#if defined(TB_ARCH_AVX2)
+    // find the quotes or escaped character, 32 bytes per step
+    __m256i dquote = _mm256_set1_epi8('\"');
+    __m256i squote = _mm256_set1_epi8('\'');
+    __m256i escape = _mm256_set1_epi8('\\');
+    while (p + 32 <= e)
+    {
+        __m256i     data = _mm256_loadu_si256((__m256i const*)p);
+        __m256i     mask = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, dquote), _mm256_cmpeq_epi8(data, squote)), _mm256_cmpeq_epi8(data, escape));
+        tb_uint32_t bits = (tb_uint32_t)_mm256_movemask_epi8(mask);
+        if (bits) return p + tb_bits_fb1_u32_le(bits);
+        p += 32;
+    }
+#endif
+
+#if defined(TB_ARCH_SSE2)
+    // find the quotes or escaped character, 16 bytes per step
+    __m128i dquote16 = _mm_set1_epi8('\"');
+    __m128i squote16 = _mm_set1_epi8('\'');
+    __m128i escape16 = _mm_set1_epi8('\\');
+    while (p + 16 <= e)
+    {
+        __m128i     data = _mm_loadu_si128((__m128i const*)p);
+        __m128i     mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, dquote16), _mm_cmpeq_epi8(data, squote16)), _mm_cmpeq_epi8(data, escape16));
+        tb_uint32_t bits = (tb_uint32_t)_mm_movemask_epi8(mask);
+        if (bits) return p + tb_bits_fb1_u32_le(bits);
+        p += 16;
+    }
+#else
+    /* find the quotes or escaped character, 8 bytes per step
+     *
+     * the false positives only appear after the first matched byte, 
+     * so the lowest bit of the mask is always exact
+     */
+    while (p + 8 <= e)
+    {
+        tb_uint64_t data = tb_bits_get_u64_le(p);
+        tb_uint64_t mask = tb_oc_json_reader_swar_match(data, '\"') | tb_oc_json_reader_swar_match(data, '\'') | tb_oc_json_reader_swar_match(data, '\\');
+        if (mask) return p + (tb_bits_fb1_u64_le(mask) >> 3);
+        p += 8;
+    }
+#endif
+
+    // find the left data
+    while (p < e && *p != '\"' && *p != '\'' && *p != '\\') p++;
+    return p;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_read(tb_oc_json_buffer_reader_t* reader, tb_char_t type);
+static tb_bool_t tb_oc_json_buffer_reader_keys_grow(tb_oc_json_buffer_reader_t* reader, tb_size_t size)
+{
+    // enough?
+    tb_check_return_val(size > reader->keys_maxn, tb_true);
+
+    // grow it
+    tb_size_t   maxn = tb_align8(size + TB_OC_JSON_READER_KEY_MAXN);
+    tb_char_t*  keys = (tb_char_t*)tb_ralloc(reader->keys, maxn);
+    tb_assert_and_check_return_val(keys, tb_false);
+
+    // save keys
+    reader->keys        = keys;
+    reader->keys_maxn   = maxn;
+    return tb_true;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_null(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader, tb_null);
+
+    // the alpha characters, the type has been skipped
+    tb_byte_t const* b = reader->p - 1;
+    tb_byte_t const* p = reader->p;
+    while (p < reader->e && tb_isalpha(*p)) p++;
+    reader->p = p;
+
+    // null?
+    return ((p - b) == 4 && !tb_strnicmp((tb_char_t const*)b, "null", 4))? tb_oc_null_init() : tb_null;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_boolean(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader, tb_null);
+
+    // the alpha characters, the type has been skipped
+    tb_byte_t const* b = reader->p - 1;
+    tb_byte_t const* p = reader->p;
+    while (p < reader->e && tb_isalpha(*p)) p++;
+    reader->p = p;
+
+    // true?
+    tb_object_ref_t boolean = tb_null;
+    if ((p - b) == 4 && !tb_strnicmp((tb_char_t const*)b, "true", 4)) boolean = tb_oc_boolean_init(tb_true);
+    // false?
+    else if ((p - b) == 5 && !tb_strnicmp((tb_char_t const*)b, "false", 5)) boolean = tb_oc_boolean_init(tb_false);
+
+    // ok?
+    return boolean;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_number(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader, tb_null);
+
+    // walk the number characters, the type has been skipped
+    tb_byte_t const*    b = reader->p - 1;
+    tb_byte_t const*    p = reader->p;
+    tb_byte_t const*    e = reader->e;
+    tb_bool_t           bs = (type == '-')? tb_true : tb_false;
+    tb_bool_t           bf = (type == '.')? tb_true : tb_false;
+    for (; p < e; p++)
+    {
+        // the character
+        tb_byte_t ch = *p;
+
+        // is float?
+        if (ch == '.')
+        {
+            // too many dots? failed
+            if (bf)
+            {
+                reader->p = p;
+                return tb_null;
+            }
+            bf = tb_true;
+        }
+        else if (!tb_isdigit10(ch) && ch != 'e' && ch != 'E' && ch != '-' && ch != '+') break;
+    }
+    reader->p = p;
+
+    // the token end, the stream mode only keeps the limited characters
+    if (p - b > TB_OC_JSON_READER_TOKEN_MAXN - 1) p = b + TB_OC_JSON_READER_TOKEN_MAXN - 1;
+
+    // trace
+    tb_trace_d("number: %.*s", (tb_int_t)(p - b), b);
+
+    // the decimal integer? convert it directly
+    tb_byte_t const* q = b;
+    if (*q == '-' || *q == '+') q++;
+    if (!bf && q < p && *q != '0' && tb_isdigit10(*q))
+    {
+        tb_uint64_t value = 0;
+        while (q < p && tb_isdigit10(*q)) value = value * 10 + (*q++ - '0');
+        return tb_oc_json_reader_number_init(bs, (*b == '-')? ~value + 1 : value);
+    }
+    // zero?
+    else if (!bf && q < p && *q == '0' && (q + 1 == p || !tb_isdigit10(q[1])))
+        return tb_oc_json_reader_number_init(bs, 0);
+
+    // init number
+    tb_object_ref_t number = tb_null;
+#ifdef TB_CONFIG_TYPE_HAVE_FLOAT
+    // the float? parse the whole token from the buffer directly
+    if (bf) number = tb_oc_number_init_from_double(tb_s10ntod((tb_char_t const*)b, reader->p - b, tb_null));
+#else
+    if (bf) tb_trace_noimpl();
+#endif
+    else
+    {
+        // make the number string for the octal or the invalid number
+        tb_char_t data[TB_OC_JSON_READER_TOKEN_MAXN];
+        tb_memcpy(data, b, p - b);
+        data[p - b] = '\0';
+        number = tb_oc_json_reader_number_init(bs, tb_stou64(data));
+    }
+
+    // ok?
+    return number;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_string(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && (type == '\"' || type == '\''), tb_null);
+
+    // find the string end or the first escaped character
+    tb_byte_t const* p = reader->p;
+    tb_byte_t const* e = reader->e;
+    tb_byte_t const* q = tb_oc_json_buffer_reader_find(p, e);
+
+    // no escaped characters? make string from the data directly
+    if (q == e || *q != '\\')
+    {
+        reader->p = q < e? q + 1 : e;
+        return tb_oc_string_init_from_cstrn((tb_char_t const*)p, q - p);
+    }
+
+    // walk the escaped string
+    tb_buffer_clear(&reader->data);
+    while (1)
+    {
+        // append the string data
+        if (q > p) tb_buffer_memncat(&reader->data, p, q - p);
+
+        // end?
+        if (q == e) 
+        {
+            p = e;
+            break;
+        }
+        else if (*q != '\\') 
+        {
+            p = q + 1;
+            break;
+        }
+
+        // no escaped character?
+        p = q + 1;
+        tb_check_break(p < e);
+
+        // unicode?
+        tb_char_t ch = (tb_char_t)*p++;
+        if (ch == 'u')
+        {
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+            // no enough data? 
+            if (p + 4 > e)
+            {
+                p = e;
+                break;
+            }
+
+            // the unicode string
+            tb_char_t unicode_str[5];
+            tb_memcpy(unicode_str, p, 4);
+            unicode_str[4] = '\0';
+            p += 4;
+
+            // the unicode value
+            tb_uint16_t unicode_val = tb_s16toi32(unicode_str);
+
+            // the utf8 stream
+            tb_char_t           utf8_data[16] = {0};
+            tb_static_stream_t  utf8_stream;
+            tb_static_stream_init(&utf8_stream, (tb_byte_t*)utf8_data, sizeof(utf8_data));
+
+            // the unicode stream
+            tb_static_stream_t  unicode_stream = {0};
+            tb_static_stream_init(&unicode_stream, (tb_byte_t*)&unicode_val, 2);
+
+            // unicode to utf8
+            tb_long_t utf8_size = tb_charset_conv_bst(TB_CHARSET_TYPE_UCS2 | TB_CHARSET_TYPE_NE, TB_CHARSET_TYPE_UTF8, &unicode_stream, &utf8_stream);
+            if (utf8_size > 0) tb_buffer_memncat(&reader->data, (tb_byte_t const*)utf8_data, utf8_size);
+#else
+            // trace
+            tb_trace1_e("unicode type is not supported, please enable charset module config if you want to use it!");
+
+            // only append it
+            tb_buffer_memncat(&reader->data, (tb_byte_t const*)&ch, 1);
+#endif
+        }
+        // append escaped character
+        else tb_buffer_memncat(&reader->data, (tb_byte_t const*)&ch, 1);
+
+        // find the next escaped character or the string end
+        q = tb_oc_json_buffer_reader_find(p, e);
+    }
+    reader->p = p;
+
+    // make string, it will be truncated at the null character like the stream mode
+    tb_buffer_memncat(&reader->data, (tb_byte_t const*)"", 1);
+    return tb_oc_string_init_from_cstr((tb_char_t const*)tb_buffer_data(&reader->data));
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_array(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && type == '[', tb_null);
+
+    // init array
+    tb_object_ref_t array = tb_oc_array_init(TB_OC_JSON_READER_ARRAY_GROW, tb_false);
+    tb_assert_and_check_return_val(array, tb_null);
+
+    // done
+    tb_bool_t ok = tb_true;
+    while (ok) 
+    {
+        // skip spaces and ','
+        reader->p = tb_oc_json_buffer_reader_skip(reader->p, reader->e);
+        tb_check_break(reader->p < reader->e);
+
+        // end?
+        tb_char_t ch = (tb_char_t)*reader->p++;
+        if (ch == ']') break;
+
+        // read item
+        tb_object_ref_t item = tb_oc_json_buffer_reader_read(reader, ch);
+        tb_assert_and_check_break_state(item, ok, tb_false);
+
+        // append item
+        tb_oc_array_append(array, item);
+    }
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (array) tb_object_exit(array);
+        array = tb_null;
+    }
+
+    // ok?
+    return array;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_func_dictionary(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && type == '{', tb_null);
+
+    // init dictionary
+    tb_object_ref_t dictionary = tb_oc_dictionary_init(0, tb_false);
+    tb_assert_and_check_return_val(dictionary, tb_null);
+
+    // walk
+    tb_bool_t ok = tb_true;
+    tb_bool_t bkey = tb_false;
+    tb_size_t bstr = 0;
+    tb_size_t kbase = reader->keys_size;
+    tb_size_t ksize = 0;
+    while (ok) 
+    {
+        // skip spaces and ',', they are also ignored in the key like the stream mode
+        reader->p = tb_oc_json_buffer_reader_skip(reader->p, reader->e);
+        tb_check_break(reader->p < reader->e);
+
+        // end?
+        tb_char_t ch = (tb_char_t)*reader->p++;
+        if (ch == '}') break;
+
+        // no key?
+        if (!bkey)
+        {
+            // is str?
+            if (ch == '\"' || ch == '\'') bstr = !bstr;
+            // is key end?
+            else if (!bstr && ch == ':') 
+            {
+                // grow the key stack
+                if (!tb_oc_json_buffer_reader_keys_grow(reader, kbase + ksize + 1))
+                {
+                    ok = tb_false;
+                    break;
+                }
+
+                // push key
+                reader->keys[kbase + ksize] = '\0';
+                reader->keys_size = kbase + ksize + 1;
+                bkey = tb_true;
+            }
+            // append key
+            else if (bstr && ksize < TB_OC_JSON_READER_KEY_MAXN - 1) 
+            {
+                // grow the key stack
+                if (!tb_oc_json_buffer_reader_keys_grow(reader, kbase + ksize + 1))
+                {
+                    ok = tb_false;
+                    break;
+                }
+                reader->keys[kbase + ksize++] = ch;
+            }
+        }
+        // key ok? read val
+        else
+        {
+            // trace
+            tb_trace_d("key: %s", reader->keys + kbase);
+
+            // read val
+            tb_object_ref_t val = tb_oc_json_buffer_reader_read(reader, ch);
+            tb_assert_and_check_break_state(val, ok, tb_false);
+
+            // set key => val, the key stack may be changed after reading the nested dictionaries
+            tb_oc_dictionary_insert(dictionary, reader->keys + kbase, val);
+
+            // pop key
+            bstr = 0;
+            bkey = tb_false;
+            ksize = 0;
+            reader->keys_size = kbase;
+        }
+    }
+
+    // pop key
+    reader->keys_size = kbase;
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (dictionary) tb_object_exit(dictionary);
+        dictionary = tb_null;
+    }
+
+    // ok?
+    return dictionary;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_hook_done(tb_oc_json_buffer_reader_t* reader, tb_oc_json_reader_func_t func, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader && func && reader->p < reader->e, tb_null);
+
+    // done
+    tb_object_ref_t object = tb_null;
+    tb_stream_ref_t stream = tb_null;
+    do
+    {
+        // init stream for the left data
+        stream = tb_stream_init_from_data(reader->p, reader->e - reader->p);
+        tb_assert_and_check_break(stream);
+
+        // open stream
+        if (!tb_stream_open(stream)) break;
+
+        // read it with the hooked func
+        tb_oc_json_reader_t hooked = {0};
+        hooked.stream = stream;
+        object = func(&hooked, type);
+
+        // skip the read data
+        reader->p += (tb_size_t)tb_stream_offset(stream);
+
+    } while (0);
+
+    // exit stream
+    if (stream) tb_stream_exit(stream);
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_oc_json_buffer_reader_read(tb_oc_json_buffer_reader_t* reader, tb_char_t type)
+{
+    // check
+    tb_assert_and_check_return_val(reader, tb_null);
+
+    // hooked? find the reader func from the hooker
+    if (g_hooked)
+    {
+        // the func
+        tb_oc_json_reader_func_t func = tb_oc_json_reader_func(type);
+        tb_assert_and_check_return_val(func, tb_null);
+
+        // read it
+        if (func == tb_oc_json_reader_func_null) return tb_oc_json_buffer_reader_func_null(reader, type);
+        else if (func == tb_oc_json_reader_func_array) return tb_oc_json_buffer_reader_func_array(reader, type);
+        else if (func == tb_oc_json_reader_func_string) return tb_oc_json_buffer_reader_func_string(reader, type);
+        else if (func == tb_oc_json_reader_func_number) return tb_oc_json_buffer_reader_func_number(reader, type);
+        else if (func == tb_oc_json_reader_func_boolean) return tb_oc_json_buffer_reader_func_boolean(reader, type);
+        else if (func == tb_oc_json_reader_func_dictionary) return tb_oc_json_buffer_reader_func_dictionary(reader, type);
+        else return tb_oc_json_buffer_reader_hook_done(reader, func, type);
+    }
+
+    // read it
+    tb_object_ref_t object = tb_null;
+    switch (type)
+    {
+    case '{':
+        object = tb_oc_json_buffer_reader_func_dictionary(reader, type);
+        break;
+    case '\"':
+    case '\'':
+        object = tb_oc_json_buffer_reader_func_string(reader, type);
+        break;
+    case '[':
+        object = tb_oc_json_buffer_reader_func_array(reader, type);
+        break;
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+    case '.': case '-': case '+': case 'e': case 'E':
+        object = tb_oc_json_buffer_reader_func_number(reader, type);
+        break;
+    case 't': case 'T': case 'f': case 'F':
+        object = tb_oc_json_buffer_reader_func_boolean(reader, type);
+        break;
+    case 'n': case 'N':
+        object = tb_oc_json_buffer_reader_func_null(reader, type);
+        break;
+    default:
+        // unknown type
+        tb_assert_and_check_break(0);
+        break;
+    }
+
+    // ok?
+    return object;
+}
+static tb_object_ref_t tb_oc_json_reader_done_buffer(tb_stream_ref_t stream, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(stream && data && size, tb_null);
+
+    // init reader
+    tb_oc_json_buffer_reader_t reader = {0};
+    reader.p = data;
+    reader.e = data + size;
+    if (!tb_buffer_init(&reader.data)) return tb_null;
+
+    // skip spaces
+    while (reader.p < reader.e && tb_isspace(*reader.p)) reader.p++;
+
+    // read it, the type need be followed by the other characters like the stream mode
+    tb_object_ref_t object = tb_null;
+    if (reader.p + 1 < reader.e) 
+    {
+        tb_char_t type = (tb_char_t)*reader.p++;
+        object = tb_oc_json_buffer_reader_read(&reader, type);
+    }
+
+    // skip the read data
+    tb_stream_skip(stream, reader.p - data);
+
+    // exit reader
+    if (reader.keys) tb_free(reader.keys);
+    tb_buffer_exit(&reader.data);
+
+    // ok?
+    return object;
+}
 static tb_object_ref_t tb_oc_json_reader_done(tb_stream_ref_t stream)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
 
+    // buffer the whole left data and parse it directly if the stream size is known
+    tb_byte_t*  data = tb_null;
+    tb_hize_t   left = tb_stream_left(stream);
+    if (g_mode == TB_OC_JSON_READER_MODE_BUFFER && left && left <= TB_OC_JSON_READER_BUFFER_MAXN && tb_stream_need(stream, &data, (tb_size_t)left) && data)
+        return tb_oc_json_reader_done_buffer(stream, data, (tb_size_t)left);
+
     // init reader
     tb_oc_json_reader_t reader = {0};
     reader.stream = stream;
@@ -589,6 +1205,9 @@ tb_bool_t tb_oc_json_reader_hook(tb_char_t type, tb_oc_json_reader_func_t func)
     // hook it
     tb_hash_map_insert(reader->hooker, (tb_pointer_t)(tb_size_t)type, func);
 
+    // the buffer mode need find the reader funcs from the hooker now
+    g_hooked = tb_true;
+
     // ok
     return tb_true;
 }
@@ -604,4 +1223,7 @@ tb_oc_json_reader_func_t tb_oc_json_reader_func(tb_char_t type)
     // the func
     return (tb_oc_json_reader_func_t)tb_hash_map_get(reader->hooker, (tb_pointer_t)(tb_size_t)type);
 }
-
+tb_void_t tb_oc_json_reader_mode_set(tb_size_t mode)
+{
+    g_mode = mode;
+}
@@ -40,6 +40,14 @@ __tb_extern_c_enter__
  * types
  */
 
+/// the json reader mode enum
+typedef enum __tb_oc_json_reader_mode_e
+{
+    TB_OC_JSON_READER_MODE_STREAM   = 0 //!< read characters from the stream one by one
+,   TB_OC_JSON_READER_MODE_BUFFER   = 1 //!< parse the whole buffered data if the stream size is known, default
+
+}tb_oc_json_reader_mode_e;
+
 /// the json reader type
 typedef struct __tb_oc_json_reader_t
 {
@@ -78,6 +86,14 @@ tb_bool_t                       tb_oc_json_reader_hook(tb_char_t type, tb_oc_jso
  */
 tb_oc_json_reader_func_t        tb_oc_json_reader_func(tb_char_t type);
 
+/*! set the json reader mode
+ *
+ * the buffer mode will fall back to the stream mode if the stream size is unknown
+ *
+ * @param mode                  the reader mode
+ */
+tb_void_t                       tb_oc_json_reader_mode_set(tb_size_t mode);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
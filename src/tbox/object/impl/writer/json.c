@@ -160,11 +160,11 @@ static tb_bool_t tb_oc_json_writer_func_number(tb_oc_json_writer_t* writer, tb_o
         break;
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_OC_NUMBER_TYPE_FLOAT:
-        if (tb_stream_printf(writer->stream, "%f", tb_oc_number_float(object)) < 0) return tb_false;
+        if (tb_stream_printf(writer->stream, "%g", tb_oc_number_float(object)) < 0) return tb_false;
         if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
-        if (tb_stream_printf(writer->stream, "%lf", tb_oc_number_double(object)) < 0) return tb_false;
+        if (tb_stream_printf(writer->stream, "%lg", tb_oc_number_double(object)) < 0) return tb_false;
         if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #endif
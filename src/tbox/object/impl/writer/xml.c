@@ -266,12 +266,12 @@ static tb_bool_t tb_oc_xml_writer_func_number(tb_oc_xml_writer_t* writer, tb_obj
 #ifdef TB_CONFIG_TYPE_HAVE_FLOAT
     case TB_OC_NUMBER_TYPE_FLOAT:
         if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%f</number>", tb_oc_number_float(object)) < 0) return tb_false;
+        if (tb_stream_printf(writer->stream, "<number>%g</number>", tb_oc_number_float(object)) < 0) return tb_false;
         if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
     case TB_OC_NUMBER_TYPE_DOUBLE:
         if (!tb_oc_writer_tab(writer->stream, writer->deflate, level)) return tb_false;
-        if (tb_stream_printf(writer->stream, "<number>%lf</number>", tb_oc_number_double(object)) < 0) return tb_false;
+        if (tb_stream_printf(writer->stream, "<number>%lg</number>", tb_oc_number_double(object)) < 0) return tb_false;
         if (!tb_oc_writer_newline(writer->stream, writer->deflate)) return tb_false;
         break;
 #endif
@@ -166,6 +166,46 @@ tb_object_ref_t tb_oc_string_init_from_cstr(tb_char_t const* cstr)
     // ok?
     return (tb_object_ref_t)string;
 }
+tb_object_ref_t tb_oc_string_init_from_cstrn(tb_char_t const* cstr, tb_size_t size)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_oc_string_t* string = tb_null;
+    do
+    {
+        // make string
+        string = tb_oc_string_init_base();
+        tb_assert_and_check_break(string);
+
+        // init str
+        if (!tb_string_init(&string->str)) break;
+
+        // copy string, the c-string may be not terminated
+        if (cstr && size)
+        {
+            tb_char_t* data = (tb_char_t*)tb_buffer_resize(&string->str, size + 1);
+            tb_assert_and_check_break(data);
+
+            tb_memcpy(data, cstr, size);
+            data[size] = '\0';
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        tb_oc_string_exit((tb_object_ref_t)string);
+        string = tb_null;
+    }
+
+    // ok?
+    return (tb_object_ref_t)string;
+}
 tb_object_ref_t tb_oc_string_init_from_str(tb_string_ref_t str)
 {
     // done
@@ -48,6 +48,15 @@ __tb_extern_c_enter__
  */
 tb_object_ref_t     tb_oc_string_init_from_cstr(tb_char_t const* cstr);
 
+/*! init string from c-string with the given size
+ *
+ * @param cstr      the c-string
+ * @param size      the c-string size
+ *
+ * @return          the string object
+ */
+tb_object_ref_t     tb_oc_string_init_from_cstrn(tb_char_t const* cstr, tb_size_t size);
+
 /*! init string from string
  *
  * @param str       the string
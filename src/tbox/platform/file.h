@@ -76,6 +76,16 @@ typedef enum __tb_file_seek_flag_t
 
 }tb_file_seek_flag_t;
 
+/// the file mmap advice type
+typedef enum __tb_file_advice_t
+{
+    TB_FILE_ADVICE_NORMAL       = 0     //!< no special treatment
+,   TB_FILE_ADVICE_SEQUENTIAL   = 1     //!< expect sequential accesses, read ahead aggressively
+,   TB_FILE_ADVICE_RANDOM       = 2     //!< expect random accesses, disable read ahead
+,   TB_FILE_ADVICE_WILLNEED     = 3     //!< expect accesses in the near future, read it ahead now
+
+}tb_file_advice_t;
+
 /// the file type
 typedef enum __tb_file_type_t
 {
@@ -220,6 +230,40 @@ tb_long_t               tb_file_preadv(tb_file_ref_t file, tb_iovec_t const* lis
  */
 tb_long_t               tb_file_pwritv(tb_file_ref_t file, tb_iovec_t const* list, tb_size_t size, tb_hize_t offset);
 
+/*! map the file data to the memory for reading
+ *
+ * the offset need not be aligned by the page size. 
+ *
+ * @note the mapped data will be invalid if the file is truncated by others
+ * 
+ * @param file          the file 
+ * @param offset        the file offset
+ * @param size          the mapped size, must be not larger than the left file size
+ * @param advice        the access advice, e.g. TB_FILE_ADVICE_SEQUENTIAL
+ *
+ * @return              the mapped data or tb_null if not supported or failed
+ */
+tb_byte_t const*        tb_file_mmap(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice);
+
+/*! unmap the mapped file data
+ * 
+ * @param data          the mapped data 
+ * @param size          the mapped size
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_file_munmap(tb_byte_t const* data, tb_size_t size);
+
+/*! give the access advice for the mapped file data
+ * 
+ * @param data          the mapped data, or the part of it
+ * @param size          the data size
+ * @param advice        the access advice, e.g. TB_FILE_ADVICE_RANDOM
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_file_madvise(tb_byte_t const* data, tb_size_t size, tb_size_t advice);
+
 /*! seek the file offset
  * 
  * @param file          the file 
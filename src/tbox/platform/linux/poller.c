@@ -0,0 +1,167 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "poller_epoll.c"
+#ifdef TB_CONFIG_LINUX_HAVE_IO_URING_SETUP
+#   include "poller_iouring.c"
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the poller type, it is the first field of all linux pollers
+#define tb_poller_linux_type(poller)                (*((tb_size_t const*)(poller)))
+
+// call the poller function for the given poller type
+#ifdef TB_CONFIG_LINUX_HAVE_IO_URING_SETUP
+#   define tb_poller_linux_call(poller, func, ...)  ((tb_poller_linux_type(poller) == TB_POLLER_TYPE_IOURING)? tb_poller_iouring_##func(poller, ##__VA_ARGS__) : tb_poller_epoll_##func(poller, ##__VA_ARGS__))
+#else
+#   define tb_poller_linux_call(poller, func, ...)  tb_poller_epoll_##func(poller, ##__VA_ARGS__)
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+{
+    return tb_poller_epoll_init(priv);
+}
+tb_poller_ref_t tb_poller_init_with_type(tb_cpointer_t priv, tb_size_t type)
+{
+#ifdef TB_CONFIG_LINUX_HAVE_IO_URING_SETUP
+    // init io_uring poller
+    if (type == TB_POLLER_TYPE_IOURING)
+    {
+        // ok?
+        tb_poller_ref_t poller = tb_poller_iouring_init(priv);
+        if (poller) return poller;
+
+        // trace
+        tb_trace_d("io_uring is not available, uses epoll now!");
+    }
+#endif
+
+    // init the default poller
+    return tb_poller_epoll_init(priv);
+}
+tb_void_t tb_poller_exit(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+    // exit it
+    tb_poller_linux_call(poller, exit);
+}
+tb_size_t tb_poller_type(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return_val(poller, TB_POLLER_TYPE_NONE);
+
+    // get the poller type
+    return tb_poller_linux_type(poller);
+}
+tb_cpointer_t tb_poller_priv(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_null);
+
+    // get the user private data
+    return tb_poller_linux_call(poller, priv);
+}
+tb_void_t tb_poller_kill(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+    // kill it
+    tb_poller_linux_call(poller, kill);
+}
+tb_void_t tb_poller_spak(tb_poller_ref_t poller)
+{
+    // check
+    tb_assert_and_check_return(poller);
+
+    // spak it
+    tb_poller_linux_call(poller, spak);
+}
+tb_bool_t tb_poller_support(tb_poller_ref_t poller, tb_size_t events)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // is supported?
+    return tb_poller_linux_call(poller, support, events);
+}
+tb_bool_t tb_poller_insert(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // insert it
+    return tb_poller_linux_call(poller, insert, sock, events, priv);
+}
+tb_bool_t tb_poller_remove(tb_poller_ref_t poller, tb_socket_ref_t sock)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // remove it
+    return tb_poller_linux_call(poller, remove, sock);
+}
+tb_bool_t tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // modify it
+    return tb_poller_linux_call(poller, modify, sock, events, priv);
+}
+tb_bool_t tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    // check
+    tb_assert_and_check_return_val(poller && op, tb_false);
+
+#ifdef TB_CONFIG_LINUX_HAVE_IO_URING_SETUP
+    // post it, only for io_uring
+    if (tb_poller_linux_type(poller) == TB_POLLER_TYPE_IOURING)
+        return tb_poller_iouring_post(poller, op);
+#endif
+
+    // not supported
+    return tb_false;
+}
+tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_assert_and_check_return_val(poller, -1);
+
+    // wait it
+    return tb_poller_linux_call(poller, wait, func, timeout);
+}
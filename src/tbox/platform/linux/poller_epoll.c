@@ -41,6 +41,9 @@
 // the epoll poller type
 typedef struct __tb_poller_epoll_t
 {
+    // the poller type, must be the first field
+    tb_size_t               type;
+
     // the maxn
     tb_size_t               maxn;
 
@@ -64,6 +67,12 @@ typedef struct __tb_poller_epoll_t
     
 }tb_poller_epoll_t, *tb_poller_epoll_ref_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * declaration
+ */
+static tb_void_t tb_poller_epoll_exit(tb_poller_ref_t self);
+static tb_bool_t tb_poller_epoll_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
@@ -92,7 +101,7 @@ static tb_size_t tb_poller_maxfds()
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
-tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
+static tb_poller_ref_t tb_poller_epoll_init(tb_cpointer_t priv)
 {
     // done
     tb_bool_t               ok = tb_false;
@@ -106,6 +115,9 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
         // init socket data
         tb_sockdata_init(&poller->sockdata);
 
+        // init type
+        poller->type = TB_POLLER_TYPE_EPOLL;
+
         // init maxn
         poller->maxn = tb_poller_maxfds();
         tb_assert_and_check_break(poller->maxn);
@@ -121,7 +133,7 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
         if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
 
         // insert pair socket first
-        if (!tb_poller_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
+        if (!tb_poller_epoll_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
 
         // ok
         ok = tb_true;
@@ -132,14 +144,14 @@ tb_poller_ref_t tb_poller_init(tb_cpointer_t priv)
     if (!ok)
     {
         // exit it
-        if (poller) tb_poller_exit((tb_poller_ref_t)poller);
+        if (poller) tb_poller_epoll_exit((tb_poller_ref_t)poller);
         poller = tb_null;
     }
 
     // ok?
     return (tb_poller_ref_t)poller;
 }
-tb_void_t tb_poller_exit(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_exit(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -166,11 +178,7 @@ tb_void_t tb_poller_exit(tb_poller_ref_t self)
     // free it
     tb_free(poller);
 }
-tb_size_t tb_poller_type(tb_poller_ref_t poller)
-{
-    return TB_POLLER_TYPE_EPOLL;
-}
-tb_cpointer_t tb_poller_priv(tb_poller_ref_t self)
+static tb_cpointer_t tb_poller_epoll_priv(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -179,7 +187,7 @@ tb_cpointer_t tb_poller_priv(tb_poller_ref_t self)
     // get the user private data
     return poller->priv;
 }
-tb_void_t tb_poller_kill(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_kill(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -188,7 +196,7 @@ tb_void_t tb_poller_kill(tb_poller_ref_t self)
     // kill it
     if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
 }
-tb_void_t tb_poller_spak(tb_poller_ref_t self)
+static tb_void_t tb_poller_epoll_spak(tb_poller_ref_t self)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -197,7 +205,7 @@ tb_void_t tb_poller_spak(tb_poller_ref_t self)
     // post it
     if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
 }
-tb_bool_t tb_poller_support(tb_poller_ref_t self, tb_size_t events)
+static tb_bool_t tb_poller_epoll_support(tb_poller_ref_t self, tb_size_t events)
 {
     // all supported events 
 #ifdef EPOLLONESHOT 
@@ -209,7 +217,7 @@ tb_bool_t tb_poller_support(tb_poller_ref_t self, tb_size_t events)
     // is supported?
     return (events_supported & events) == events;
 }
-tb_bool_t tb_poller_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+static tb_bool_t tb_poller_epoll_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -252,7 +260,7 @@ tb_bool_t tb_poller_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
     // ok
     return tb_true;
 }
-tb_bool_t tb_poller_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+static tb_bool_t tb_poller_epoll_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -276,7 +284,7 @@ tb_bool_t tb_poller_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
     // ok
     return tb_true;
 }
-tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+static tb_bool_t tb_poller_epoll_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
@@ -319,7 +327,7 @@ tb_bool_t tb_poller_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t
     // ok
     return tb_true;
 }
-tb_long_t tb_poller_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+static tb_long_t tb_poller_epoll_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
 {
     // check
     tb_poller_epoll_ref_t poller = (tb_poller_epoll_ref_t)self;
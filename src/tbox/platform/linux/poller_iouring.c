@@ -0,0 +1,747 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        poller_iouring.c
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../barrier.h"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <errno.h>
+#include <unistd.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the submission queue entries count
+#ifdef __tb_small__
+#   define TB_POLLER_IOURING_SQ_ENTRIES         (128)
+#else
+#   define TB_POLLER_IOURING_SQ_ENTRIES         (1024)
+#endif
+
+// the completion queue entries count
+#define TB_POLLER_IOURING_CQ_ENTRIES            (TB_POLLER_IOURING_SQ_ENTRIES << 2)
+
+// the sockets grow
+#define TB_POLLER_IOURING_SOCKS_GROW            (256)
+
+/* the user data of the poll operation, | gen: 32bits | fd: 31bits | 1 |
+ *
+ * the posted operation uses the operation address as the user data, the lowest bit is always zero
+ */
+#define tb_poller_iouring_udata(fd, gen)        (((tb_uint64_t)(gen) << 32) | ((tb_uint64_t)(fd) << 1) | 1)
+#define tb_poller_iouring_udata_fd(udata)       ((tb_long_t)(((udata) & 0xffffffff) >> 1))
+#define tb_poller_iouring_udata_gen(udata)      ((tb_uint32_t)((udata) >> 32))
+
+// the user data of the ignored completion, e.g. poll remove
+#define TB_POLLER_IOURING_UDATA_NONE            (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the io_uring poller socket type
+typedef struct __tb_poller_iouring_sock_t
+{
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the generation of the poll operation, we will ignore the stale completions
+    tb_uint32_t                 gen;
+
+    // the waited events
+    tb_uint16_t                 events;
+
+    // is the poll operation armed?
+    tb_uint16_t                 armed;
+
+    // the posted operations, 0: recv and acpt, 1: send
+    tb_poller_op_ref_t          ops[2];
+
+}tb_poller_iouring_sock_t;
+
+// the io_uring poller type
+typedef struct __tb_poller_iouring_t
+{
+    // the poller type, must be the first field
+    tb_size_t                   type;
+
+    // the user private data
+    tb_cpointer_t               priv;
+
+    // the pair sockets for spak, kill ..
+    tb_socket_ref_t             pair[2];
+
+    // the ring fd
+    tb_long_t                   ringfd;
+
+    // is the multishot poll supported?
+    tb_bool_t                   multishot;
+
+    // the submission queue
+    tb_uint32_t volatile*       sq_head;
+    tb_uint32_t volatile*       sq_tail;
+    tb_uint32_t*                sq_array;
+    tb_uint32_t                 sq_mask;
+    tb_uint32_t                 sq_entries;
+
+    // the submission queue entries
+    struct io_uring_sqe*        sqes;
+
+    // the completion queue
+    tb_uint32_t volatile*       cq_head;
+    tb_uint32_t volatile*       cq_tail;
+    tb_uint32_t                 cq_mask;
+
+    // the completion queue entries
+    struct io_uring_cqe*        cqes;
+
+    // the mapped submission ring
+    tb_pointer_t                sq_ring;
+    tb_size_t                   sq_ring_size;
+
+    // the mapped completion ring, it is equal to sq_ring if the single mmap is supported
+    tb_pointer_t                cq_ring;
+    tb_size_t                   cq_ring_size;
+
+    // the mapped submission queue entries size
+    tb_size_t                   sqes_size;
+
+    // the sockets, indexed by fd
+    tb_poller_iouring_sock_t*   socks;
+
+    // the sockets count
+    tb_size_t                   socks_count;
+
+}tb_poller_iouring_t, *tb_poller_iouring_ref_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static __tb_inline__ tb_long_t tb_poller_iouring_setup(tb_uint32_t entries, struct io_uring_params* params)
+{
+    return (tb_long_t)syscall(__NR_io_uring_setup, entries, params);
+}
+static __tb_inline__ tb_long_t tb_poller_iouring_enter(tb_long_t ringfd, tb_uint32_t submit, tb_uint32_t complete, tb_uint32_t flags, tb_cpointer_t arg, tb_size_t argsz)
+{
+    return (tb_long_t)syscall(__NR_io_uring_enter, (tb_int_t)ringfd, submit, complete, flags, arg, argsz);
+}
+static tb_poller_iouring_sock_t* tb_poller_iouring_sock(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_bool_t grow)
+{
+    // check
+    tb_assert_and_check_return_val(poller && fd >= 0 && fd < TB_MAXS32, tb_null);
+
+    // grow sockets
+    if (fd >= poller->socks_count)
+    {
+        // need not grow it?
+        tb_check_return_val(grow, tb_null);
+
+        // grow it
+        tb_size_t count = tb_align(fd + 1, TB_POLLER_IOURING_SOCKS_GROW);
+        poller->socks = (tb_poller_iouring_sock_t*)tb_ralloc(poller->socks, count * sizeof(tb_poller_iouring_sock_t));
+        tb_assert_and_check_return_val(poller->socks, tb_null);
+
+        // clear the new sockets
+        tb_memset(poller->socks + poller->socks_count, 0, (count - poller->socks_count) * sizeof(tb_poller_iouring_sock_t));
+        poller->socks_count = count;
+    }
+
+    // get it
+    return poller->socks + fd;
+}
+static tb_bool_t tb_poller_iouring_submit(tb_poller_iouring_ref_t poller)
+{
+    // the pending entries count
+    tb_uint32_t pending = *poller->sq_tail - *poller->sq_head;
+    tb_check_return_val(pending, tb_true);
+
+    // submit them
+    tb_long_t ok = tb_poller_iouring_enter(poller->ringfd, pending, 0, 0, tb_null, 0);
+    if (ok < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+    {
+        // trace
+        tb_trace_e("submit %u entries failed, errno: %d", pending, errno);
+        return tb_false;
+    }
+
+    // ok
+    return tb_true;
+}
+static struct io_uring_sqe* tb_poller_iouring_sqe(tb_poller_iouring_ref_t poller)
+{
+    // the submission queue is full? submit the pending entries first
+    tb_uint32_t tail = *poller->sq_tail;
+    if (tail - *poller->sq_head >= poller->sq_entries)
+    {
+        if (!tb_poller_iouring_submit(poller) || tail - *poller->sq_head >= poller->sq_entries)
+            return tb_null;
+    }
+
+    // get a free entry
+    tb_uint32_t             index = tail & poller->sq_mask;
+    struct io_uring_sqe*    sqe = poller->sqes + index;
+    tb_memset_(sqe, 0, sizeof(struct io_uring_sqe));
+    poller->sq_array[index] = index;
+
+    /* commit it, the kernel will read it only in the next io_uring_enter()
+     * because we do not use the submission queue polling thread
+     */
+    tb_barrier();
+    *poller->sq_tail = tail + 1;
+    return sqe;
+}
+static tb_bool_t tb_poller_iouring_poll_add(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_sock_t* sock)
+{
+    // get a free entry
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init poll events
+    tb_size_t   events = sock->events;
+    tb_uint32_t poll_events = 0;
+    if (events & TB_POLLER_EVENT_RECV) poll_events |= POLLIN;
+    if (events & TB_POLLER_EVENT_SEND) poll_events |= POLLOUT;
+    if (events & TB_POLLER_EVENT_CLEAR) poll_events |= POLLRDHUP;
+#ifdef TB_WORDS_BIGENDIAN
+    poll_events = (poll_events << 16) | (poll_events >> 16);
+#endif
+
+    // init poll operation, we use the multishot poll for the edge trigger
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = (tb_int_t)fd;
+    sqe->poll32_events  = poll_events;
+    sqe->user_data      = tb_poller_iouring_udata(fd, sock->gen);
+    if ((events & TB_POLLER_EVENT_CLEAR) && !(events & TB_POLLER_EVENT_ONESHOT))
+    {
+        tb_assert(poller->multishot);
+        sqe->len = IORING_POLL_ADD_MULTI;
+    }
+
+    // armed
+    sock->armed = 1;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_poll_remove(tb_poller_iouring_ref_t poller, tb_long_t fd, tb_poller_iouring_sock_t* sock)
+{
+    // not armed? 
+    if (sock->armed)
+    {
+        // get a free entry
+        struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+
+        // remove the armed poll operation
+        sqe->opcode     = IORING_OP_POLL_REMOVE;
+        sqe->fd         = -1;
+        sqe->addr       = tb_poller_iouring_udata(fd, sock->gen);
+        sqe->user_data  = TB_POLLER_IOURING_UDATA_NONE;
+        sock->armed     = 0;
+    }
+
+    // the stale completions will be ignored
+    sock->gen++;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_post_cancel(tb_poller_iouring_ref_t poller, tb_poller_iouring_sock_t* sock)
+{
+    // cancel all posted operations of this socket
+    tb_size_t i = 0;
+    for (i = 0; i < tb_arrayn(sock->ops); i++)
+    {
+        // no posted operation?
+        tb_poller_op_ref_t op = sock->ops[i];
+        tb_check_continue(op);
+
+        // get a free entry
+        struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+        tb_assert_and_check_return_val(sqe, tb_false);
+
+        /* cancel it, the posted operation will be completed with -ECANCELED
+         *
+         * the pending operation holds the file reference, so it will be never completed after closing the socket fd
+         */
+        sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+        sqe->fd         = -1;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)op;
+        sqe->user_data  = TB_POLLER_IOURING_UDATA_NONE;
+        sock->ops[i]    = tb_null;
+    }
+    return tb_true;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+static tb_void_t tb_poller_iouring_exit(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // close ring fd, all pending operations will be canceled
+    if (poller->ringfd >= 0) close(poller->ringfd);
+    poller->ringfd = -1;
+
+    // exit the mapped rings
+    if (poller->sqes) munmap(poller->sqes, poller->sqes_size);
+    if (poller->cq_ring && poller->cq_ring != poller->sq_ring) munmap(poller->cq_ring, poller->cq_ring_size);
+    if (poller->sq_ring) munmap(poller->sq_ring, poller->sq_ring_size);
+    poller->sqes    = tb_null;
+    poller->cq_ring = tb_null;
+    poller->sq_ring = tb_null;
+
+    // exit pair sockets
+    if (poller->pair[0]) tb_socket_exit(poller->pair[0]);
+    if (poller->pair[1]) tb_socket_exit(poller->pair[1]);
+    poller->pair[0] = tb_null;
+    poller->pair[1] = tb_null;
+
+    // exit sockets
+    if (poller->socks) tb_free(poller->socks);
+    poller->socks       = tb_null;
+    poller->socks_count = 0;
+
+    // free it
+    tb_free(poller);
+}
+static tb_bool_t tb_poller_iouring_insert(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && sock, tb_false);
+
+    // get socket
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_iouring_sock_t*   item = tb_poller_iouring_sock(poller, fd, tb_true);
+    tb_assert_and_check_return_val(item, tb_false);
+
+    // remove the previous poll operation of the closed socket with the same fd
+    if (!tb_poller_iouring_poll_remove(poller, fd, item)) return tb_false;
+
+    // add poll operation
+    item->priv      = priv;
+    item->events    = (tb_uint16_t)events;
+    return tb_poller_iouring_poll_add(poller, fd, item);
+}
+static tb_bool_t tb_poller_iouring_remove(tb_poller_ref_t self, tb_socket_ref_t sock)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && sock, tb_false);
+
+    // get socket, it may be not inserted and only has the posted operations
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_iouring_sock_t*   item = tb_poller_iouring_sock(poller, fd, tb_false);
+    tb_check_return_val(item, tb_true);
+
+    // remove poll operation
+    if (!tb_poller_iouring_poll_remove(poller, fd, item)) return tb_false;
+
+    // cancel the posted operations before closing this socket
+    if (!tb_poller_iouring_post_cancel(poller, item)) return tb_false;
+
+    // clear it
+    item->priv      = tb_null;
+    item->events    = 0;
+    return tb_true;
+}
+static tb_bool_t tb_poller_iouring_modify(tb_poller_ref_t self, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && sock, tb_false);
+
+    // get socket
+    tb_long_t                   fd = tb_sock2fd(sock);
+    tb_poller_iouring_sock_t*   item = tb_poller_iouring_sock(poller, fd, tb_false);
+    tb_assert_and_check_return_val(item, tb_false);
+
+    // update the user private data
+    item->priv = priv;
+
+    // the same events and the poll operation is still armed? we need not re-arm it
+    if (item->armed && item->events == (tb_uint16_t)events) return tb_true;
+
+    // re-arm poll operation
+    if (!tb_poller_iouring_poll_remove(poller, fd, item)) return tb_false;
+    item->events = (tb_uint16_t)events;
+    return tb_poller_iouring_poll_add(poller, fd, item);
+}
+static tb_poller_ref_t tb_poller_iouring_init(tb_cpointer_t priv)
+{
+    // done
+    tb_bool_t               ok = tb_false;
+    tb_poller_iouring_ref_t poller = tb_null;
+    do
+    {
+        // make poller
+        poller = tb_malloc0_type(tb_poller_iouring_t);
+        tb_assert_and_check_break(poller);
+
+        // init poller
+        poller->type    = TB_POLLER_TYPE_IOURING;
+        poller->priv    = priv;
+        poller->ringfd  = -1;
+
+        // init io_uring
+        struct io_uring_params params;
+        tb_memset(&params, 0, sizeof(params));
+        params.flags        = IORING_SETUP_CQSIZE;
+        params.cq_entries   = TB_POLLER_IOURING_CQ_ENTRIES;
+        poller->ringfd = tb_poller_iouring_setup(TB_POLLER_IOURING_SQ_ENTRIES, &params);
+        if (poller->ringfd < 0)
+        {
+            // trace
+            tb_trace_d("init io_uring failed, errno: %d", errno);
+            break;
+        }
+
+        // we need wait the completions with timeout and never drop them, linux >= 5.11
+        if (!(params.features & IORING_FEAT_EXT_ARG) || !(params.features & IORING_FEAT_NODROP))
+        {
+            // trace
+            tb_trace_d("io_uring features(%#x) are not supported!", params.features);
+            break;
+        }
+
+        /* is the multishot poll supported? linux >= 5.13
+         *
+         * there is no feature flag for it, but IORING_FEAT_RSRC_TAGS is added in the same version
+         */
+#ifdef IORING_FEAT_RSRC_TAGS
+        poller->multishot = (params.features & IORING_FEAT_RSRC_TAGS)? tb_true : tb_false;
+#endif
+
+        // map the submission and completion rings
+        poller->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(tb_uint32_t);
+        poller->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            poller->sq_ring_size = tb_max(poller->sq_ring_size, poller->cq_ring_size);
+            poller->cq_ring_size = poller->sq_ring_size;
+        }
+        poller->sq_ring = mmap(tb_null, poller->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQ_RING);
+        if (poller->sq_ring == MAP_FAILED) poller->sq_ring = tb_null;
+        tb_assert_and_check_break(poller->sq_ring);
+        if (params.features & IORING_FEAT_SINGLE_MMAP) poller->cq_ring = poller->sq_ring;
+        else
+        {
+            poller->cq_ring = mmap(tb_null, poller->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_CQ_RING);
+            if (poller->cq_ring == MAP_FAILED) poller->cq_ring = tb_null;
+            tb_assert_and_check_break(poller->cq_ring);
+        }
+
+        // map the submission queue entries
+        poller->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+        poller->sqes = (struct io_uring_sqe*)mmap(tb_null, poller->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, poller->ringfd, IORING_OFF_SQES);
+        if (poller->sqes == MAP_FAILED) poller->sqes = tb_null;
+        tb_assert_and_check_break(poller->sqes);
+
+        // init the submission queue
+        tb_byte_t* sq_ring = (tb_byte_t*)poller->sq_ring;
+        poller->sq_head     = (tb_uint32_t volatile*)(sq_ring + params.sq_off.head);
+        poller->sq_tail     = (tb_uint32_t volatile*)(sq_ring + params.sq_off.tail);
+        poller->sq_array    = (tb_uint32_t*)(sq_ring + params.sq_off.array);
+        poller->sq_mask     = *(tb_uint32_t*)(sq_ring + params.sq_off.ring_mask);
+        poller->sq_entries  = *(tb_uint32_t*)(sq_ring + params.sq_off.ring_entries);
+
+        // init the completion queue
+        tb_byte_t* cq_ring = (tb_byte_t*)poller->cq_ring;
+        poller->cq_head     = (tb_uint32_t volatile*)(cq_ring + params.cq_off.head);
+        poller->cq_tail     = (tb_uint32_t volatile*)(cq_ring + params.cq_off.tail);
+        poller->cq_mask     = *(tb_uint32_t*)(cq_ring + params.cq_off.ring_mask);
+        poller->cqes        = (struct io_uring_cqe*)(cq_ring + params.cq_off.cqes);
+
+        // init pair sockets
+        if (!tb_socket_pair(TB_SOCKET_TYPE_TCP, poller->pair)) break;
+
+        // insert pair socket first
+        if (!tb_poller_iouring_insert((tb_poller_ref_t)poller, poller->pair[1], TB_POLLER_EVENT_RECV, tb_null)) break;  
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (poller) tb_poller_iouring_exit((tb_poller_ref_t)poller);
+        poller = tb_null;
+    }
+
+    // ok?
+    return (tb_poller_ref_t)poller;
+}
+static tb_cpointer_t tb_poller_iouring_priv(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller, tb_null);
+
+    // get the user private data
+    return poller->priv;
+}
+static tb_void_t tb_poller_iouring_kill(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // kill it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"k", 1);
+}
+static tb_void_t tb_poller_iouring_spak(tb_poller_ref_t self)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return(poller);
+
+    // post it
+    if (poller->pair[0]) tb_socket_send(poller->pair[0], (tb_byte_t const*)"p", 1);
+}
+static tb_bool_t tb_poller_iouring_support(tb_poller_ref_t self, tb_size_t events)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller, tb_false);
+
+    // all supported events, the edge trigger need the multishot poll
+    tb_size_t events_supported = TB_POLLER_EVENT_EALL | TB_POLLER_EVENT_ONESHOT | TB_POLLER_EVENT_POST;
+    if (poller->multishot) events_supported |= TB_POLLER_EVENT_CLEAR;
+
+    // is supported?
+    return (events_supported & events) == events;
+}
+static tb_bool_t tb_poller_iouring_post(tb_poller_ref_t self, tb_poller_op_ref_t op)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && op && op->sock, tb_false);
+    tb_assert_and_check_return_val(!((tb_size_t)op & 1), tb_false);
+
+    // check operation
+    tb_size_t code = op->code;
+    tb_assert_and_check_return_val(code == TB_POLLER_OP_ACPT || (op->data && op->size), tb_false);
+
+    // get socket
+    tb_long_t                   fd = tb_sock2fd(op->sock);
+    tb_poller_iouring_sock_t*   item = tb_poller_iouring_sock(poller, fd, tb_true);
+    tb_assert_and_check_return_val(item, tb_false);
+
+    // only one operation can be posted for each direction, we need cancel it when removing this socket
+    tb_size_t slot = code == TB_POLLER_OP_SEND? 1 : 0;
+    tb_check_return_val(!item->ops[slot], tb_false);
+
+    // get a free entry
+    struct io_uring_sqe* sqe = tb_poller_iouring_sqe(poller);
+    tb_assert_and_check_return_val(sqe, tb_false);
+
+    // init operation, it will be submitted in the next tb_poller_wait()
+    sqe->fd         = (tb_int_t)fd;
+    sqe->user_data  = (tb_uint64_t)(tb_size_t)op;
+    switch (code)
+    {
+    case TB_POLLER_OP_RECV:
+        sqe->opcode     = IORING_OP_RECV;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)op->data;
+        sqe->len        = (tb_uint32_t)tb_min(op->size, TB_MAXU32);
+        break;
+    case TB_POLLER_OP_SEND:
+        sqe->opcode     = IORING_OP_SEND;
+        sqe->addr       = (tb_uint64_t)(tb_size_t)op->data;
+        sqe->len        = (tb_uint32_t)tb_min(op->size, TB_MAXU32);
+        sqe->msg_flags  = MSG_NOSIGNAL;
+        break;
+    case TB_POLLER_OP_ACPT:
+        sqe->opcode         = IORING_OP_ACCEPT;
+        sqe->accept_flags   = SOCK_NONBLOCK | SOCK_CLOEXEC;
+        break;
+    default:
+        // unknown operation, we only make it as a nop operation
+        sqe->opcode     = IORING_OP_NOP;
+        tb_assertf(0, "unknown poller operation: %lu", code);
+        break;
+    }
+
+    // reset the result
+    op->result  = 0;
+    op->acpt    = tb_null;
+
+    // save the posted operation
+    item->ops[slot] = op;
+    return tb_true;
+}
+static tb_long_t tb_poller_iouring_wait(tb_poller_ref_t self, tb_poller_event_func_t func, tb_long_t timeout)
+{
+    // check
+    tb_poller_iouring_ref_t poller = (tb_poller_iouring_ref_t)self;
+    tb_assert_and_check_return_val(poller && poller->ringfd >= 0 && func, -1);
+
+    // init the timeout argument
+    struct __kernel_timespec        ts;
+    struct io_uring_getevents_arg   arg;
+    tb_memset(&arg, 0, sizeof(arg));
+    if (timeout >= 0)
+    {
+        ts.tv_sec   = timeout / 1000;
+        ts.tv_nsec  = (timeout % 1000) * 1000000;
+        arg.ts      = (tb_uint64_t)(tb_size_t)&ts;
+    }
+
+    // submit all pending entries and wait completions in one system call
+    tb_uint32_t head = *poller->cq_head;
+    tb_uint32_t pending = *poller->sq_tail - *poller->sq_head;
+    tb_uint32_t complete = (head == *poller->cq_tail && timeout)? 1 : 0;
+    if (pending || complete)
+    {
+        tb_long_t ok = tb_poller_iouring_enter(poller->ringfd, pending, complete, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+        // interrupted?(for gdb?) continue it
+        if (ok < 0 && errno == EINTR) return 0;
+
+        // failed? timeout or busy is ok, we only handle the completed events
+        if (ok < 0 && errno != ETIME && errno != EBUSY && errno != EAGAIN)
+        {
+            // trace
+            tb_trace_e("wait failed, errno: %d", errno);
+            return -1;
+        }
+    }
+
+    // handle completions
+    tb_size_t       wait = 0;
+    tb_uint32_t     tail = *poller->cq_tail;
+    tb_socket_ref_t pair = poller->pair[1];
+    tb_barrier();
+    while (head != tail)
+    {
+        // get the completion entry
+        struct io_uring_cqe*    cqe = poller->cqes + (head & poller->cq_mask);
+        tb_uint64_t             udata = cqe->user_data;
+        tb_int32_t              res = cqe->res;
+        tb_uint32_t             flags = cqe->flags;
+
+        // release it
+        head++;
+        tb_barrier();
+        *poller->cq_head = head;
+
+        // ignored?
+        tb_check_continue(udata != TB_POLLER_IOURING_UDATA_NONE);
+
+        // the posted operation has been completed?
+        if (!(udata & 1))
+        {
+            // save result
+            tb_poller_op_ref_t op = (tb_poller_op_ref_t)(tb_size_t)udata;
+            op->result = res;
+
+            /* remove it from the socket, 
+             * the slot may have been canceled and reused by the new socket with the same fd
+             */
+            tb_poller_iouring_sock_t* item = tb_poller_iouring_sock(poller, tb_sock2fd(op->sock), tb_false);
+            tb_size_t slot = op->code == TB_POLLER_OP_SEND? 1 : 0;
+            if (item && item->ops[slot] == op) item->ops[slot] = tb_null;
+
+            // accepted? disable the nagle's algorithm for the accepted socket, be same as tb_socket_accept()
+            if (op->code == TB_POLLER_OP_ACPT && res > 0)
+            {
+                tb_int_t enable = 1;
+                setsockopt(res, IPPROTO_TCP, TCP_NODELAY, (tb_char_t*)&enable, sizeof(enable));
+                op->acpt = tb_fd2sock(res);
+            }
+
+            // call event function
+            func(self, op->sock, TB_POLLER_EVENT_POST, op);
+            wait++;
+            continue;
+        }
+
+        // get socket
+        tb_long_t                   fd = tb_poller_iouring_udata_fd(udata);
+        tb_poller_iouring_sock_t*   item = tb_poller_iouring_sock(poller, fd, tb_false);
+
+        // the stale completion of the removed poll operation?
+        tb_check_continue(item && item->gen == tb_poller_iouring_udata_gen(udata));
+
+        // the poll operation has been finished? re-arm it for the level trigger if not failed
+        if (!(flags & IORING_CQE_F_MORE))
+        {
+            item->armed = 0;
+            if (res >= 0 && !(item->events & TB_POLLER_EVENT_ONESHOT) && !tb_poller_iouring_poll_add(poller, fd, item)) return -1;
+        }
+
+        // the poll events, we mark it as error if failed
+        tb_uint32_t poll_events = res >= 0? (tb_uint32_t)res : POLLERR;
+        tb_socket_ref_t sock = tb_fd2sock(fd);
+
+        // spak?
+        if (sock == pair && (poll_events & POLLIN)) 
+        {
+            // read spak
+            tb_char_t spak = '\0';
+            if (1 != tb_socket_recv(pair, (tb_byte_t*)&spak, 1)) return -1;
+
+            // killed?
+            if (spak == 'k') return -1;
+
+            // continue it
+            continue ;
+        }
+
+        // skip spak
+        tb_check_continue(sock != pair);
+
+        // init events 
+        tb_size_t events = TB_POLLER_EVENT_NONE;
+        if (poll_events & POLLIN) events |= TB_POLLER_EVENT_RECV;
+        if (poll_events & POLLOUT) events |= TB_POLLER_EVENT_SEND;
+        if ((poll_events & (POLLHUP | POLLERR)) && !(events & (TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND))) 
+            events |= TB_POLLER_EVENT_RECV | TB_POLLER_EVENT_SEND;
+
+        // connection closed for the edge trigger?
+        if (poll_events & POLLRDHUP) events |= TB_POLLER_EVENT_EOF;
+
+        // call event function
+        func(self, sock, events, item->priv);
+
+        // update the events count
+        wait++;
+    }
+
+    // ok
+    return wait;
+}
@@ -0,0 +1,81 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ *
+ * @author      ruki
+ * @file        sched.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+#include "../sched.h"
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the futex word, it's the low 32-bits of the atomic value
+#if defined(TB_WORDS_BIGENDIAN) && TB_CPU_BIT64
+#   define tb_sched_futex_word(value)       ((tb_int32_t*)(value) + 1)
+#else
+#   define tb_sched_futex_word(value)       ((tb_int32_t*)(value))
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_bool_t tb_sched_wait(tb_atomic_t* value, tb_long_t expected, tb_long_t timeout)
+{
+    // check
+    tb_assert(value);
+
+    // init timeout
+    struct timespec t = {0};
+    if (timeout >= 0)
+    {
+        t.tv_sec  = timeout / 1000;
+        t.tv_nsec = (timeout % 1000) * 1000000;
+    }
+
+    // park it until it has been woken up or the value has been changed
+    if (!syscall(SYS_futex, tb_sched_futex_word(value), FUTEX_WAIT_PRIVATE, (tb_int32_t)expected, timeout >= 0? &t : tb_null, tb_null, 0)) 
+        return tb_true;
+
+    // interrupted? the caller will check it again
+    return errno == EINTR? tb_true : tb_false;
+}
+tb_size_t tb_sched_wake(tb_atomic_t* value, tb_size_t count)
+{
+    // check
+    tb_assert(value);
+
+    // wake up the parked threads
+    tb_long_t ok = syscall(SYS_futex, tb_sched_futex_word(value), FUTEX_WAKE_PRIVATE, (tb_int32_t)tb_min(count, TB_MAXS32), tb_null, tb_null, 0);
+    return ok > 0? (tb_size_t)ok : 0;
+}
@@ -42,13 +42,36 @@
  * macros
  */
 
-// the timer wheel maxn
+// the root wheel bits
 #ifdef __tb_small__
-#   define TB_LTIMER_WHEEL_MAXN             (4096)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (6)
 #else
-#   define TB_LTIMER_WHEEL_MAXN             (8192)
+#   define TB_LTIMER_WHEEL_ROOT_BITS        (8)
 #endif
 
+// the node wheel bits
+#define TB_LTIMER_WHEEL_NODE_BITS           (6)
+
+// the node wheel levels
+#define TB_LTIMER_WHEEL_NODE_LEVELS         (4)
+
+// the root wheel size
+#define TB_LTIMER_WHEEL_ROOT_SIZE           (1 << TB_LTIMER_WHEEL_ROOT_BITS)
+#define TB_LTIMER_WHEEL_ROOT_MASK           (TB_LTIMER_WHEEL_ROOT_SIZE - 1)
+
+// the node wheel size
+#define TB_LTIMER_WHEEL_NODE_SIZE           (1 << TB_LTIMER_WHEEL_NODE_BITS)
+#define TB_LTIMER_WHEEL_NODE_MASK           (TB_LTIMER_WHEEL_NODE_SIZE - 1)
+
+// the all wheel slots
+#define TB_LTIMER_WHEEL_MAXN                (TB_LTIMER_WHEEL_ROOT_SIZE + TB_LTIMER_WHEEL_NODE_SIZE * TB_LTIMER_WHEEL_NODE_LEVELS)
+
+// the max ticks of all wheels
+#define TB_LTIMER_WHEEL_TICKS               ((tb_hize_t)1 << (TB_LTIMER_WHEEL_ROOT_BITS + TB_LTIMER_WHEEL_NODE_BITS * TB_LTIMER_WHEEL_NODE_LEVELS))
+
+// the node wheel shift of the given level
+#define TB_LTIMER_WHEEL_NODE_SHIFT(level)   (TB_LTIMER_WHEEL_ROOT_BITS + (level) * TB_LTIMER_WHEEL_NODE_BITS)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -56,6 +79,9 @@
 // the timer task type
 typedef struct __tb_ltimer_task_t
 {
+    // the list entry
+    tb_list_entry_t             entry;
+
     // the func
     tb_ltimer_task_func_t       func;
 
@@ -77,7 +103,7 @@ typedef struct __tb_ltimer_task_t
     // the refn, <= 2
     tb_uint32_t                 refn    : 2;
 
-    // the wheel index
+    // the wheel index, -1: expired
     tb_uint32_t                 windx;
 
 }tb_ltimer_task_t;
@@ -86,16 +112,24 @@ typedef struct __tb_ltimer_task_t
  *
  * <pre>
  *
- * tick: 1s
+ * tick: 1ms
+ *
+ * root:  |----|----|----|----|---- ... ----|      <= 256 slots, 1 tick per slot, [ticks, ticks + 256)
+ *          ^
+ *        ticks
  *
- *           1s    1s   ..
- * wheel: |-----|-----|-----|-----|-----|-----|---- ... -----|  <= circle queue
- *                             timers
- *                 btime ==================> now
- *                       |     |     |
- *                       |     |     |
- *                       |     |     | => the same timeout timer_task list (vector)
- *                                   |
+ * node0: |----|----|---- ... ----|                 <= 64 slots, 256 ticks per slot
+ * node1: |----|----|---- ... ----|                 <= 64 slots, 256 * 64 ticks per slot
+ * node2: |----|----|---- ... ----|                 <= 64 slots, 256 * 64^2 ticks per slot
+ * node3: |----|----|---- ... ----|                 <= 64 slots, 256 * 64^3 ticks per slot
+ *
+ * the task list of every slot is an intrusive list, so inserting and removing task are O(1).
+ *
+ * the tasks in the root slot will be expired in batch when ticks reaches it,
+ * and the tasks in the node slot will be cascaded to the lower wheels when the lower wheel wraps around.
+ *
+ * the canceled tasks will be not removed from the wheel immediately,
+ * they will be reclaimed when they are cascaded or expired.
  *
  * </pre>
  */
@@ -110,7 +144,7 @@ typedef struct __tb_ltimer_t
     // is worked?
     tb_atomic_t                 work;
 
-    // the base time
+    // the base time of the tick zero
     tb_hong_t                   btime;
 
     // cache time?
@@ -119,6 +153,9 @@ typedef struct __tb_ltimer_t
     // the tick
     tb_size_t                   tick;
 
+    // the current ticks, all tasks before it have been expired
+    tb_hize_t                   ticks;
+
     // the lock
     tb_spinlock_t               lock;
 
@@ -126,13 +163,13 @@ typedef struct __tb_ltimer_t
     tb_fixed_pool_ref_t         pool;
 
     // the expired tasks
-    tb_vector_ref_t             expired;
+    tb_list_entry_head_t        expired;
 
-    // the wheel
-    tb_vector_ref_t             wheel[TB_LTIMER_WHEEL_MAXN];
+    // the cascaded tasks
+    tb_list_entry_head_t        cascade;
 
-    // the wheel base
-    tb_size_t                   wbase;
+    // the wheel slots, root + node0 + node1 + ...
+    tb_list_entry_head_t        wheel[TB_LTIMER_WHEEL_MAXN];
 
 }tb_ltimer_t;
 
@@ -161,131 +198,136 @@ static tb_bool_t tb_ltimer_add_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_
     // trace
     tb_trace_d("add: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // empty? move to the wheel head
-        if (!tb_fixed_pool_size(timer->pool)) 
-        {
-            timer->btime = tb_ltimer_now(timer);
-            timer->wbase = 0;
-        }
-
-        // trace
-        tb_trace_d("add: btime: %lld, wbase: %lu", timer->btime, timer->wbase);
-
-        // the timer difference
-        tb_hong_t tdiff = timer_task->when - timer->btime;
-        tb_assert_and_check_break(tdiff >= 0);
-
-        // trace
-        tb_trace_d("add: tdiff: %lld", tdiff);
-
-        // the wheel difference
-        tb_size_t wdiff = (tb_size_t)(tdiff / timer->tick);
-        tb_assert_and_check_break(wdiff < TB_LTIMER_WHEEL_MAXN);
+    // the expired tick, round up and never expire it early
+    tb_hong_t tdiff = timer_task->when - timer->btime;
+    tb_hize_t expire = tdiff > 0? (tb_hize_t)((tdiff + timer->tick - 1) / timer->tick) : 0;
 
-        // trace
-        tb_trace_d("add: wdiff: %lu", wdiff);
-
-        // the wheel index
-        tb_size_t windx = (timer->wbase + wdiff) & (TB_LTIMER_WHEEL_MAXN - 1);
+    // has been expired? expire it at the next tick
+    if (expire < timer->ticks) expire = timer->ticks;
 
-        // trace
-        tb_trace_d("add: windx: %lu", windx);
-
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[windx];
-        if (!wlist) wlist = timer->wheel[windx] = tb_vector_init(timer->grow, tb_element_ptr(tb_null, tb_null));
-        tb_assert_and_check_break(wlist);
+    // too far? put it to the farthest slot, it will be cascaded again
+    tb_hize_t wdiff = expire - timer->ticks;
+    if (wdiff >= TB_LTIMER_WHEEL_TICKS) 
+    {
+        wdiff = TB_LTIMER_WHEEL_TICKS - 1;
+        expire = timer->ticks + wdiff;
+    }
 
-        // save the wheel index
-        timer_task->windx = (tb_uint32_t)windx;
+    // the wheel index
+    tb_size_t windx = 0;
+    if (wdiff < TB_LTIMER_WHEEL_ROOT_SIZE) windx = (tb_size_t)(expire & TB_LTIMER_WHEEL_ROOT_MASK);
+    else
+    {
+        tb_size_t level = 0;
+        for (level = 0; level < TB_LTIMER_WHEEL_NODE_LEVELS - 1; level++)
+        {
+            if (wdiff < ((tb_hize_t)1 << TB_LTIMER_WHEEL_NODE_SHIFT(level + 1))) break;
+        }
+        windx = TB_LTIMER_WHEEL_ROOT_SIZE + level * TB_LTIMER_WHEEL_NODE_SIZE + (tb_size_t)((expire >> TB_LTIMER_WHEEL_NODE_SHIFT(level)) & TB_LTIMER_WHEEL_NODE_MASK);
+    }
 
-        // add task to the wheel list
-        tb_vector_insert_tail(wlist, timer_task);
+    // trace
+    tb_trace_d("add: ticks: %llu, expire: %llu, windx: %lu", timer->ticks, expire, windx);
 
-        // ok
-        ok = tb_true;
+    // add task to the wheel list
+    timer_task->windx = (tb_uint32_t)windx;
+    tb_list_entry_insert_tail(&timer->wheel[windx], &timer_task->entry);
 
-    } while (0);
-
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 static tb_bool_t tb_ltimer_del_task(tb_ltimer_t* timer, tb_ltimer_task_t* timer_task)
 {
     // check
     tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
     tb_assert_and_check_return_val(timer_task && timer_task->func && timer_task->refn && timer_task->when, tb_false);
+    tb_assert_and_check_return_val(timer_task->windx < tb_arrayn(timer->wheel), tb_false);
 
     // trace
     tb_trace_d("del: when: %lld, period: %u, refn: %u", timer_task->when, timer_task->period, timer_task->refn);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
-    {
-        // check
-        tb_assert_and_check_break(timer_task->windx != -1 && timer_task->windx < tb_arrayn(timer->wheel));
-
-        // the wheel list
-        tb_vector_ref_t wlist = timer->wheel[timer_task->windx];
-        tb_assert_and_check_break(wlist);
-
-        // find the task from the wheel list
-        tb_size_t itor = tb_find_all(wlist, timer_task);
-        tb_assert_and_check_break(itor != tb_iterator_tail(wlist));
-
-        // del the task from the wheel list
-        tb_vector_remove(wlist, itor);
+    // del the task from the wheel list
+    tb_list_entry_remove(&timer->wheel[timer_task->windx], &timer_task->entry);
 
-        // clear the wheel index
-        timer_task->windx = -1;
+    // clear the wheel index
+    timer_task->windx = -1;
 
-        // ok
-        ok = tb_true;
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_ltimer_cascade(tb_ltimer_t* timer, tb_size_t windx)
+{
+    // detach the slot list
+    tb_list_entry_splice_tail(&timer->cascade, &timer->wheel[windx]);
 
-    } while (0);
+    // re-add all tasks to the lower wheels
+    while (tb_list_entry_size(&timer->cascade))
+    {
+        // the task
+        tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry(&timer->cascade, tb_list_entry_head(&timer->cascade));
+        tb_list_entry_remove_head(&timer->cascade);
 
-    // ok?
-    return ok;
+        // has been canceled? reclaim it now
+        if (!timer_task->func)
+        {
+            tb_assert(timer_task->refn == 1);
+            tb_fixed_pool_free(timer->pool, timer_task);
+        }
+        // re-add it
+        else if (!tb_ltimer_add_task(timer, timer_task))
+        {
+            // trace
+            tb_trace_e("cascade timer_task failed");
+        }
+    }
 }
-static tb_bool_t tb_ltimer_expired_task_done(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+static tb_void_t tb_ltimer_expire(tb_ltimer_t* timer)
 {
-    // the task
-    tb_ltimer_task_t const* timer_task = (tb_ltimer_task_t const*)item;
-    
-    // done func
-    if (timer_task && timer_task->func) 
-    { 
-        // trace
-        tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
+    // the root index
+    tb_size_t indx = (tb_size_t)(timer->ticks & TB_LTIMER_WHEEL_ROOT_MASK);
+
+    // the root wheel wraps around? cascade the next slots of the node wheels
+    if (!indx)
+    {
+        tb_size_t level = 0;
+        for (level = 0; level < TB_LTIMER_WHEEL_NODE_LEVELS; level++)
+        {
+            // cascade the node slot
+            tb_size_t i = (tb_size_t)((timer->ticks >> TB_LTIMER_WHEEL_NODE_SHIFT(level)) & TB_LTIMER_WHEEL_NODE_MASK);
+            tb_ltimer_cascade(timer, TB_LTIMER_WHEEL_ROOT_SIZE + level * TB_LTIMER_WHEEL_NODE_SIZE + i);
 
-        // done
-        timer_task->func(timer_task->killed? tb_true : tb_false, timer_task->priv);
+            // this node wheel does not wrap around? stop it
+            tb_check_break(!i);
+        }
     }
 
-    // ok
-    return tb_true;
+    // the expired list
+    tb_list_entry_head_ref_t list = &timer->wheel[indx];
+    tb_check_return(tb_list_entry_size(list));
+
+    // mark these tasks as expired
+    tb_list_entry_ref_t itor = tb_list_entry_head(list);
+    tb_list_entry_ref_t tail = tb_list_entry_tail(list);
+    for (; itor != tail; itor = tb_list_entry_next(itor))
+        ((tb_ltimer_task_t*)tb_list_entry(list, itor))->windx = -1;
+
+    // detach the slot list to the expired tasks 
+    tb_list_entry_splice_tail(&timer->expired, list);
 }
-static tb_bool_t tb_ltimer_expired_task_exit(tb_iterator_ref_t iterator, tb_pointer_t item, tb_cpointer_t priv)
+static tb_void_t tb_ltimer_expired_exit(tb_ltimer_t* timer, tb_hong_t now)
 {
-    // check
-    tb_ltimer_t*    timer = priv? (tb_ltimer_t*)(((tb_pointer_t*)priv)[0]) : tb_null;
-    tb_hong_t*      now = priv? (tb_hong_t*)(((tb_pointer_t*)priv)[1]) : tb_null;
-    tb_assert_and_check_return_val(timer && now, tb_false);
-
-    // the task
-    tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)item;
-    if (timer_task)
+    // walk the expired tasks
+    while (tb_list_entry_size(&timer->expired))
     {
+        // the task
+        tb_ltimer_task_t* timer_task = (tb_ltimer_task_t*)tb_list_entry(&timer->expired, tb_list_entry_head(&timer->expired));
+        tb_list_entry_remove_head(&timer->expired);
+
         // repeat?
-        if (timer_task->repeat)
+        if (timer_task->repeat && timer_task->func)
         {
             // update when
-            timer_task->when = *now + timer_task->period;
+            timer_task->when = now + timer_task->period;
 
             // continue the task
             if (!tb_ltimer_add_task(timer, timer_task))
@@ -302,21 +344,6 @@ static tb_bool_t tb_ltimer_expired_task_exit(tb_iterator_ref_t iterator, tb_poin
             else tb_fixed_pool_free(timer->pool, timer_task);
         }
     }
-
-    // ok
-    return tb_true;
-}
-static tb_void_t tb_ltimer_expired_list_exit(tb_element_ref_t element, tb_pointer_t buff)
-{
-    // check
-    tb_vector_ref_t list = buff? *((tb_vector_ref_t*)buff) : tb_null;
-    tb_assert_and_check_return(list);
-
-    // exit list
-    tb_vector_exit(list);
-
-    // clear it
-    *((tb_pointer_t*)buff) = tb_null;
 }
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -325,7 +352,7 @@ static tb_void_t tb_ltimer_expired_list_exit(tb_element_ref_t element, tb_pointe
 tb_ltimer_ref_t tb_ltimer_init(tb_size_t grow, tb_size_t tick, tb_bool_t ctime)
 {
     // check
-    tb_assert_and_check_return_val(tick >= TB_LTIMER_TICK_100MS, tb_null);
+    tb_assert_and_check_return_val(tick >= TB_LTIMER_TICK_MS, tb_null);
 
     // done
     tb_bool_t       ok = tb_false;
@@ -349,9 +376,14 @@ tb_ltimer_ref_t tb_ltimer_init(tb_size_t grow, tb_size_t tick, tb_bool_t ctime)
         timer->pool         = tb_fixed_pool_init(tb_null, timer->grow, sizeof(tb_ltimer_task_t), tb_null, tb_null, tb_null);
         tb_assert_and_check_break(timer->pool);
 
-        // init the expired tasks
-        timer->expired      = tb_vector_init((TB_LTIMER_WHEEL_MAXN >> 3) + 8, tb_element_ptr(tb_ltimer_expired_list_exit, tb_null));
-        tb_assert_and_check_break(timer->expired);
+        // init the expired and cascaded tasks
+        tb_list_entry_init(&timer->expired, tb_ltimer_task_t, entry, tb_null);
+        tb_list_entry_init(&timer->cascade, tb_ltimer_task_t, entry, tb_null);
+
+        // init wheel
+        tb_size_t i = 0;
+        for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
+            tb_list_entry_init(&timer->wheel[i], tb_ltimer_task_t, entry, tb_null);
 
         // register lock profiler
 #ifdef TB_LOCK_PROFILER_ENABLE
@@ -396,27 +428,13 @@ tb_void_t tb_ltimer_exit(tb_ltimer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // exit wheel
-    {
-        tb_size_t i = 0;
-        for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-        {
-            if (timer->wheel[i]) tb_vector_exit(timer->wheel[i]);
-            timer->wheel[i] = tb_null;
-        }
-    }
-
-    // exit pool
+    // exit pool, all tasks in the wheel will be freed
     if (timer->pool) tb_fixed_pool_exit(timer->pool);
     timer->pool = tb_null;
 
     // leave
     tb_spinlock_leave(&timer->lock);
 
-    // exit the expired tasks
-    if (timer->expired) tb_vector_exit(timer->expired);
-    timer->expired = tb_null;
-
     // exit lock
     tb_spinlock_exit(&timer->lock);
 
@@ -442,16 +460,15 @@ tb_void_t tb_ltimer_clear(tb_ltimer_ref_t self)
 
         // move to the wheel head
         timer->btime = tb_ltimer_now(timer);
-        timer->wbase = 0;
+        timer->ticks = 0;
 
         // clear wheel
-        {
-            tb_size_t i = 0;
-            for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++)
-            {
-                if (timer->wheel[i]) tb_vector_clear(timer->wheel[i]);
-            }
-        }
+        tb_size_t i = 0;
+        for (i = 0; i < TB_LTIMER_WHEEL_MAXN; i++) tb_list_entry_clear(&timer->wheel[i]);
+
+        // clear the expired and cascaded tasks
+        tb_list_entry_clear(&timer->expired);
+        tb_list_entry_clear(&timer->cascade);
 
         // clear pool
         if (timer->pool) tb_fixed_pool_clear(timer->pool);
@@ -466,23 +483,55 @@ tb_size_t tb_ltimer_limit(tb_ltimer_ref_t self)
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
     tb_assert_and_check_return_val(timer, 0);
 
-    // the self limit
-    return (TB_LTIMER_WHEEL_MAXN * timer->tick);
+    // the self limit, the farther tasks will be cascaded again and it's not limited in fact
+    tb_hize_t limit = TB_LTIMER_WHEEL_TICKS * timer->tick;
+    return limit < TB_MAXU32? (tb_size_t)limit : TB_MAXU32;
 }
 tb_size_t tb_ltimer_delay(tb_ltimer_ref_t self)
 {
     // check
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
-    tb_assert_and_check_return_val(timer, -1);
+    tb_assert_and_check_return_val(timer && timer->pool, -1);
+
+    // enter
+    tb_spinlock_enter(&timer->lock);
+
+    // done
+    tb_size_t delay = -1; 
+    if (tb_fixed_pool_size(timer->pool))
+    {
+        /* find the next non-empty slot of the root wheel,
+         * or wait to the next cascading if the root wheel is empty
+         *
+         * @note the root wheel will be cascaded first if the current tick is at the wheel head
+         */
+        tb_hize_t ticks = timer->ticks;
+        if (ticks & TB_LTIMER_WHEEL_ROOT_MASK)
+        {
+            tb_hize_t limit = (ticks | TB_LTIMER_WHEEL_ROOT_MASK) + 1;
+            for (; ticks < limit; ticks++)
+            {
+                if (tb_list_entry_size(&timer->wheel[ticks & TB_LTIMER_WHEEL_ROOT_MASK])) break;
+            }
+        }
+
+        // the delay
+        tb_hong_t when = timer->btime + (tb_hong_t)(ticks * timer->tick);
+        tb_hong_t now = tb_ltimer_now(timer);
+        delay = when > now? (tb_size_t)(when - now) : 0;
+    }
+
+    // leave
+    tb_spinlock_leave(&timer->lock);
 
     // ok?
-    return timer->tick;
+    return delay;
 }
 tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
 {
     // check
     tb_ltimer_t* timer = (tb_ltimer_t*)self;
-    tb_assert_and_check_return_val(timer && timer->pool && timer->tick && timer->expired, tb_false);
+    tb_assert_and_check_return_val(timer && timer->pool && timer->tick, tb_false);
 
     // stoped?
     tb_check_return_val(!tb_atomic_get(&timer->stop), tb_false);
@@ -493,89 +542,56 @@ tb_bool_t tb_ltimer_spak(tb_ltimer_ref_t self)
     // enter
     tb_spinlock_enter(&timer->lock);
 
-    // done
-    tb_bool_t ok = tb_false;
-    do
+    // empty? move to the wheel head
+    if (!tb_fixed_pool_size(timer->pool))
     {
-        // less than one tick? continue to wait
-        if (now - timer->btime < timer->tick)
-        {
-            ok = tb_true;
-            break;
-        }
-
-        // empty? move to the wheel head
-        if (!tb_fixed_pool_size(timer->pool))
-        {
-            timer->btime = now;
-            timer->wbase = 0;
-            ok = tb_true;
-            break;
-        }
-
-        // the diff
-        tb_size_t diff = (tb_size_t)((now - timer->btime) / timer->tick);
+        timer->btime = now;
+        timer->ticks = 0;
+    }
+    else if (now >= timer->btime)
+    {
+        // the current tick
+        tb_hize_t ticks = (tb_hize_t)((now - timer->btime) / timer->tick);
 
         // trace
-        tb_trace_d("spak: btime: %lld, wbase: %lu, now: %lld, diff: %lu", timer->btime, timer->wbase, now, diff);
+        tb_trace_d("spak: btime: %lld, now: %lld, ticks: %llu => %llu", timer->btime, now, timer->ticks, ticks);
 
-        // walk the expired lists
-        tb_size_t i = 0;
-        tb_size_t n = tb_min(diff, TB_LTIMER_WHEEL_MAXN - 1);
-        for (i = 0; i <= n; i++)
+        // expire all tasks before the current tick
+        while (timer->ticks <= ticks)
         {
-            // the wheel index
-            tb_size_t indx = (timer->wbase + i) & (TB_LTIMER_WHEEL_MAXN - 1);
-
-            // the wheel list
-            tb_vector_ref_t list = timer->wheel[indx];
-            tb_check_continue(list && tb_vector_size(list));
-
-            // detach the wheel list to the expired tasks
-            tb_vector_insert_tail(timer->expired, list);
-            timer->wheel[indx] = tb_null;
+            tb_ltimer_expire(timer);
+            timer->ticks++;
         }
-
-        // update the base time
-        timer->btime = now;
-
-        // update the wheel base
-        timer->wbase = (timer->wbase + diff) & (TB_LTIMER_WHEEL_MAXN - 1);
-        
-        // ok
-        ok = tb_true;
-
-    } while (0);
+    }
 
     // leave
     tb_spinlock_leave(&timer->lock);
 
-    // ok? and exists expired tasks?
-    if (ok && tb_vector_size(timer->expired))
+    // exists expired tasks? 
+    if (tb_list_entry_size(&timer->expired))
     {
-        // done all expired list
-        tb_for_all_if (tb_vector_ref_t, list, timer->expired, list)
+        // done all expired tasks
+        tb_for_all_if (tb_ltimer_task_t*, timer_task, tb_list_entry_itor(&timer->expired), timer_task)
         {
-            // done the expired task 
-            tb_walk_all(list, tb_ltimer_expired_task_done, tb_null);
+            // trace
+            tb_trace_d("done: expired: when: %lld, period: %u, refn: %u, killed: %u", timer_task->when, timer_task->period, timer_task->refn, timer_task->killed);
 
-            // enter
-            tb_spinlock_enter(&timer->lock);
+            // done func
+            if (timer_task->func) timer_task->func(timer_task->killed? tb_true : tb_false, timer_task->priv);
+        }
 
-            // exit the expired task
-            tb_pointer_t data[2]; data[0] = (tb_pointer_t)self; data[1] = &now;
-            tb_walk_all(list, tb_ltimer_expired_task_exit, data);
+        // enter
+        tb_spinlock_enter(&timer->lock);
 
-            // leave
-            tb_spinlock_leave(&timer->lock);
-        }
-    }
+        // exit the expired tasks
+        tb_ltimer_expired_exit(timer, now);
 
-    // clear expired
-    tb_vector_clear(timer->expired);
+        // leave
+        tb_spinlock_leave(&timer->lock);
+    }
 
-    // ok?
-    return ok;
+    // ok
+    return tb_true;
 }
 tb_void_t tb_ltimer_loop(tb_ltimer_ref_t self)
 {
@@ -589,9 +605,9 @@ tb_void_t tb_ltimer_loop(tb_ltimer_ref_t self)
     // loop
     while (!tb_atomic_get(&timer->stop))
     {
-        // the delay
+        // wait one tick at most, the new tasks may be posted from other threads
         tb_size_t delay = tb_ltimer_delay(self);
-        tb_assert_and_check_break(delay != -1);
+        delay = tb_min(delay, timer->tick);
 
         // wait some time
         if (delay) tb_msleep(delay);
@@ -762,7 +778,7 @@ tb_void_t tb_ltimer_task_kill(tb_ltimer_ref_t self, tb_ltimer_task_ref_t task)
     do
     {
         // expired or removed?
-        tb_check_break(timer_task->refn == 2);
+        tb_check_break(timer_task->refn == 2 && timer_task->windx != -1);
 
         // del the task first
         if (!tb_ltimer_del_task(timer, timer_task))
@@ -44,7 +44,8 @@ __tb_extern_c_enter__
 /// the timer tick enum
 typedef enum __tb_ltimer_tick_e
 {
-    TB_LTIMER_TICK_100MS    = 100
+    TB_LTIMER_TICK_MS       = 1
+,   TB_LTIMER_TICK_100MS    = 100
 ,   TB_LTIMER_TICK_S        = 1000
 ,   TB_LTIMER_TICK_M        = 60000
 ,   TB_LTIMER_TICK_H        = 3600000
@@ -66,7 +67,8 @@ typedef __tb_typeref__(ltimer_task);
 
 /*! init timer
  *
- * lower tick and limit range, but faster
+ * the hierarchical timing wheel, inserting and removing task are O(1), 
+ * and the expired tasks will be done in batch, but the precision is limited to the tick.
  * 
  * @param grow          the timer grow
  * @param tick          the timer tick
@@ -95,6 +97,8 @@ tb_void_t               tb_ltimer_kill(tb_ltimer_ref_t timer);
 tb_void_t               tb_ltimer_clear(tb_ltimer_ref_t timer);
 
 /*! the timer limit
+ *
+ * the farther tasks will be cascaded again after the limit time
  *
  * @param timer         the timer 
  *
@@ -103,6 +107,8 @@ tb_void_t               tb_ltimer_clear(tb_ltimer_ref_t timer);
 tb_size_t               tb_ltimer_limit(tb_ltimer_ref_t timer);
 
 /*! the timer delay for spak 
+ *
+ * the time to the next expired tick or the next cascading tick
  *
  * @param timer         the timer 
  *
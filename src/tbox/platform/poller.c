@@ -46,7 +46,8 @@
 #   endif
 #elif defined(TB_CONFIG_POSIX_HAVE_EPOLL_CREATE) \
     && defined(TB_CONFIG_POSIX_HAVE_EPOLL_WAIT)
-#   include "linux/poller_epoll.c"
+#   include "linux/poller.c"
+#   define TB_POLLER_HAVE_TYPE
 #elif defined(TB_CONFIG_OS_MACOSX)
 #   include "mach/poller_kqueue.c"
 #elif defined(TB_CONFIG_POSIX_HAVE_POLL) && !defined(TB_CONFIG_MICRO_ENABLE) /* TODO remove vector for supporting the micro mode */
@@ -103,3 +104,15 @@ tb_long_t tb_poller_wait(tb_poller_ref_t poller, tb_poller_event_func_t func, tb
 }
 #endif
 
+// only the default poller and no posted operations for other platforms
+#ifndef TB_POLLER_HAVE_TYPE
+tb_poller_ref_t tb_poller_init_with_type(tb_cpointer_t priv, tb_size_t type)
+{
+    return tb_poller_init(priv);
+}
+tb_bool_t tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op)
+{
+    return tb_false;
+}
+#endif
+
@@ -49,6 +49,7 @@ typedef enum __tb_poller_type_e
 ,   TB_POLLER_TYPE_EPOLL        = 3
 ,   TB_POLLER_TYPE_KQUEUE       = 4
 ,   TB_POLLER_TYPE_SELECT       = 5
+,   TB_POLLER_TYPE_IOURING      = 6
 
 }tb_poller_type_e;
 
@@ -76,8 +77,56 @@ typedef enum __tb_poller_event_e
     /// socket error after waiting
 ,   TB_POLLER_EVENT_ERROR       = 0x0200
 
+    /*! the posted operation has been completed, the private data of the event function is the operation
+     *
+     * only for tb_poller_support() and tb_poller_wait(), we need not insert it
+     */
+,   TB_POLLER_EVENT_POST        = 0x0400
+
 }tb_poller_event_e;
 
+/// the poller operation code enum
+typedef enum __tb_poller_op_code_e
+{
+    TB_POLLER_OP_NONE           = 0
+,   TB_POLLER_OP_RECV           = 1
+,   TB_POLLER_OP_SEND           = 2
+,   TB_POLLER_OP_ACPT           = 3
+
+}tb_poller_op_code_e;
+
+/*! the poller operation type
+ *
+ * the operation is posted to the completion-based poller (e.g. io_uring),
+ * it will be done by the kernel directly and we need not wait the socket events and call recv/send again.
+ *
+ * @note the operation and its data must be valid until it has been completed
+ */
+typedef struct __tb_poller_op_t
+{
+    /// the operation code
+    tb_size_t                   code;
+
+    /// the socket
+    tb_socket_ref_t             sock;
+
+    /// the data for recv and send
+    tb_byte_t*                  data;
+
+    /// the data size for recv and send
+    tb_size_t                   size;
+
+    /// the result, recv and send: the real size, acpt: the accepted fd, < 0: the negative errno
+    tb_long_t                   result;
+
+    /// the accepted socket for acpt
+    tb_socket_ref_t             acpt;
+
+    /// the user private data
+    tb_cpointer_t               priv;
+
+}tb_poller_op_t, *tb_poller_op_ref_t;
+
 /// the poller ref type
 typedef __tb_typeref__(poller);
 
@@ -102,6 +151,17 @@ typedef tb_void_t   (*tb_poller_event_func_t)(tb_poller_ref_t poller, tb_socket_
  */
 tb_poller_ref_t     tb_poller_init(tb_cpointer_t priv);
 
+/*! init poller with the given type
+ *
+ * we will use the default poller if the given poller type is not supported
+ *
+ * @param priv      the user private data 
+ * @param type      the poller type, e.g. TB_POLLER_TYPE_IOURING
+ *
+ * @param poller    the poller
+ */
+tb_poller_ref_t     tb_poller_init_with_type(tb_cpointer_t priv, tb_size_t type);
+
 /*! exit poller
  *
  * @param poller    the poller
@@ -157,6 +217,9 @@ tb_bool_t           tb_poller_support(tb_poller_ref_t poller, tb_size_t events);
 tb_bool_t           tb_poller_insert(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
 
 /*! remove socket from poller
+ *
+ * the posted operations of this socket will be canceled and completed with the negative errno,
+ * so we need remove it before closing the socket if some operations have been posted.
  *
  * @param poller    the poller
  * @param aioo      the aioo
@@ -176,6 +239,19 @@ tb_bool_t           tb_poller_remove(tb_poller_ref_t poller, tb_socket_ref_t soc
  */
 tb_bool_t           tb_poller_modify(tb_poller_ref_t poller, tb_socket_ref_t sock, tb_size_t events, tb_cpointer_t priv);
 
+/*! post an operation to the completion-based poller
+ *
+ * the operation will be submitted in the next tb_poller_wait() and
+ * the event function will be called with TB_POLLER_EVENT_POST and this operation after it has been completed.
+ * only one recv (or acpt) and one send operation can be posted for each socket at the same time.
+ *
+ * @param poller    the poller
+ * @param op        the operation
+ *
+ * @return          tb_true or tb_false (not supported, please check tb_poller_support(poller, TB_POLLER_EVENT_POST))
+ */
+tb_bool_t           tb_poller_post(tb_poller_ref_t poller, tb_poller_op_ref_t op);
+
 /*! wait all sockets
  *
  * @param poller    the poller
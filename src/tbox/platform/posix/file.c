@@ -44,6 +44,10 @@
 #ifdef TB_CONFIG_POSIX_HAVE_SENDFILE
 #   include <sys/sendfile.h>
 #endif
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+#   include <sys/mman.h>
+#   include "../page.h"
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -386,6 +390,77 @@ tb_long_t tb_file_pwritv(tb_file_ref_t file, tb_iovec_t const* list, tb_size_t s
     return real;
 #endif
 }
+tb_byte_t const* tb_file_mmap(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return_val(pagesize, tb_null);
+
+    // the mapped offset must be aligned by the page size
+    tb_size_t   skip = (tb_size_t)(offset & (pagesize - 1));
+    tb_hize_t   base = offset - skip;
+
+    // map it
+    tb_pointer_t data = mmap(tb_null, size + skip, PROT_READ, MAP_SHARED, tb_file2fd(file), (off_t)base);
+    tb_check_return_val(data && data != MAP_FAILED, tb_null);
+
+    // give the access advice
+    if (advice != TB_FILE_ADVICE_NORMAL) tb_file_madvise((tb_byte_t const*)data + skip, size, advice);
+
+    // ok
+    return (tb_byte_t const*)data + skip;
+#else
+    return tb_null;
+#endif
+}
+tb_bool_t tb_file_munmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+#ifdef TB_CONFIG_POSIX_HAVE_MMAP
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return_val(pagesize, tb_false);
+
+    // unmap it from the aligned address
+    tb_size_t skip = (tb_size_t)data & (pagesize - 1);
+    return !munmap((tb_pointer_t)(data - skip), size + skip);
+#else
+    return tb_false;
+#endif
+}
+tb_bool_t tb_file_madvise(tb_byte_t const* data, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+#if defined(TB_CONFIG_POSIX_HAVE_MMAP) && defined(TB_CONFIG_POSIX_HAVE_MADVISE)
+    // the page size
+    tb_size_t pagesize = tb_page_size();
+    tb_assert_and_check_return_val(pagesize, tb_false);
+
+    // the advice
+    tb_int_t flag = MADV_NORMAL;
+    switch (advice)
+    {
+    case TB_FILE_ADVICE_SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+    case TB_FILE_ADVICE_RANDOM:     flag = MADV_RANDOM;     break;
+    case TB_FILE_ADVICE_WILLNEED:   flag = MADV_WILLNEED;   break;
+    default:                                                break;
+    }
+
+    // advise it from the aligned address
+    tb_size_t skip = (tb_size_t)data & (pagesize - 1);
+    return !madvise((tb_pointer_t)(data - skip), size + skip, flag);
+#else
+    return tb_false;
+#endif
+}
 tb_bool_t tb_file_copy(tb_char_t const* path, tb_char_t const* dest)
 {
     // check
@@ -96,6 +96,9 @@ tb_void_t tb_thread_local_exit(tb_thread_local_ref_t local)
     // check
     tb_assert(local);
 
+    // have been not initialized or exited?
+    tb_check_return(local->inited);
+
     // free the previous data first
     if (local->free && tb_thread_local_has(local))
         local->free(tb_thread_local_get(local));
@@ -103,6 +106,9 @@ tb_void_t tb_thread_local_exit(tb_thread_local_ref_t local)
     // exit it
     pthread_key_delete(((pthread_key_t*)local->priv)[0]);
     pthread_key_delete(((pthread_key_t*)local->priv)[1]);
+
+    // remove it from the thread local list
+    tb_thread_local_remove(local);
 }
 tb_bool_t tb_thread_local_has(tb_thread_local_ref_t local)
 {
@@ -43,3 +43,22 @@ tb_bool_t tb_sched_yield()
     return tb_false;
 }
 #endif
+
+#if defined(TB_CONFIG_OS_LINUX) || defined(TB_CONFIG_OS_ANDROID)
+#   include "linux/sched.c"
+#else
+tb_bool_t tb_sched_wait(tb_atomic_t* value, tb_long_t expected, tb_long_t timeout)
+{
+    // check
+    tb_assert(value);
+
+    // only yield the processor, the caller will check it again
+    tb_check_return_val(tb_atomic_get(value) == expected, tb_false);
+    return tb_sched_yield();
+}
+tb_size_t tb_sched_wake(tb_atomic_t* value, tb_size_t count)
+{
+    // no parked threads
+    return 0;
+}
+#endif
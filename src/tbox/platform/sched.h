@@ -31,6 +31,7 @@
  */
 #include "prefix.h"
 #include "time.h"
+#include "atomic.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
@@ -47,6 +48,30 @@ __tb_extern_c_enter__
  */
 tb_bool_t       tb_sched_yield(tb_noarg_t);
 
+/*! park the current thread if the value is still equal to the expected value
+ *
+ * it uses futex on linux and only yields the processor on the other platforms,
+ * so the caller need check the value again in a loop after it returns.
+ *
+ * @note only the low 32-bits of the value will be compared
+ *
+ * @param value     the waited value
+ * @param expected  the expected value
+ * @param timeout   the timeout (ms), infinity: -1
+ *
+ * @return          tb_true or tb_false (timeout or not equal to the expected value)
+ */
+tb_bool_t       tb_sched_wait(tb_atomic_t* value, tb_long_t expected, tb_long_t timeout);
+
+/*! wake up the threads parked on the given value 
+ *
+ * @param value     the waited value
+ * @param count     the maximum count of the woken threads
+ *
+ * @return          the woken count
+ */
+tb_size_t       tb_sched_wake(tb_atomic_t* value, tb_size_t count);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
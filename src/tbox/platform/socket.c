@@ -33,6 +33,7 @@
  * includes
  */
 #include "socket.h"
+#include "poller.h"
 #include "impl/socket.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -160,6 +161,35 @@ tb_long_t tb_socket_wait(tb_socket_ref_t sock, tb_size_t events, tb_long_t timeo
 }
 #endif
 
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+/* post the recv/send operation to the completion-based poller (e.g. io_uring) in coroutine
+ *
+ * @return      > 0: the real size, 0: not supported, -1: failed or closed
+ */
+static tb_long_t tb_socket_post(tb_socket_ref_t sock, tb_size_t code, tb_byte_t* data, tb_size_t size)
+{
+    // not in coroutine?
+    tb_check_return_val(tb_coroutine_self(), 0);
+
+    // post it
+    tb_poller_op_t op = {0};
+    op.code = code;
+    op.sock = sock;
+    op.data = data;
+    op.size = size;
+    if (!tb_coroutine_post(&op)) return 0;
+
+    // ok?
+    return op.result > 0? op.result : -1;
+}
+#else
+static __tb_inline__ tb_long_t tb_socket_post(tb_socket_ref_t sock, tb_size_t code, tb_byte_t* data, tb_size_t size)
+{
+    return 0;
+}
+#endif
+
 tb_bool_t tb_socket_brecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
 {
     // recv data
@@ -179,6 +209,15 @@ tb_bool_t tb_socket_brecv(tb_socket_ref_t sock, tb_byte_t* data, tb_size_t size)
         // no data? wait it
         else if (!real && !wait)
         {
+            // post it directly if the completion-based poller is used in coroutine
+            real = tb_socket_post(sock, TB_POLLER_OP_RECV, data + recv, size - recv);
+            if (real > 0)
+            {
+                recv += real;
+                continue;
+            }
+            else if (real < 0) break;
+
             // wait it
             wait = tb_socket_wait(sock, TB_SOCKET_EVENT_RECV, -1);
             tb_check_break(wait > 0);
@@ -207,6 +246,15 @@ tb_bool_t tb_socket_bsend(tb_socket_ref_t sock, tb_byte_t const* data, tb_size_t
         // no data? wait it
         else if (!real && !wait)
         {
+            // post it directly if the completion-based poller is used in coroutine
+            real = tb_socket_post(sock, TB_POLLER_OP_SEND, (tb_byte_t*)data + send, size - send);
+            if (real > 0)
+            {
+                send += real;
+                continue;
+            }
+            else if (real < 0) break;
+
             // wait it
             wait = tb_socket_wait(sock, TB_SOCKET_EVENT_SEND, -1);
             tb_check_break(wait > 0);
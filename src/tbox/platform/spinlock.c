@@ -0,0 +1,82 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ *
+ * @author      ruki
+ * @file        spinlock.c
+ * @ingroup     platform
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "spinlock.h"
+#include "barrier.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the spinning count before parking the current thread
+#define TB_SPINLOCK_SPIN_MAXN           (128)
+
+// relax the cpu when spinning
+#if defined(TB_ASSEMBLER_IS_GAS) && (defined(TB_ARCH_x86) || defined(TB_ARCH_x64))
+#   define tb_spinlock_relax()          __tb_asm__ __tb_volatile__ ("pause" ::: "memory")
+#elif defined(TB_ASSEMBLER_IS_GAS) && defined(TB_ARCH_ARM64)
+#   define tb_spinlock_relax()          __tb_asm__ __tb_volatile__ ("yield" ::: "memory")
+#else
+#   define tb_spinlock_relax()          tb_barrier()
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implementation
+ */
+tb_void_t tb_spinlock_enter_wait(tb_spinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+
+    // the lock value
+    tb_atomic_t* value = (tb_atomic_t*)lock;
+
+    /* spin it first, the lock is held only for a short time generally
+     *
+     * we only read the lock value before trying to lock it, 
+     * so the waiting threads will not bounce the cache line.
+     */
+    tb_size_t spin = TB_SPINLOCK_SPIN_MAXN;
+    while (spin--)
+    {
+        // relax the cpu
+        tb_spinlock_relax();
+
+        // try locking it if it has been released
+        if (!*((__tb_volatile__ tb_atomic_t*)value) && !tb_atomic_fetch_and_pset(value, 0, 1)) return ;
+    }
+
+    /* mark it as contended and park the current thread until it has been released
+     *
+     * we need not know how many threads are parked, 
+     * the lock holder will wake up one of them when leaving if the value is 2.
+     */
+    while (tb_atomic_fetch_and_set(value, 2)) tb_sched_wait(value, 2, -1);
+}
@@ -31,9 +31,15 @@
  */
 #include "prefix.h"
 #include "sched.h"
+#include "time.h"
 #include "atomic.h"
 #include "../utils/lock_profiler.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
  */
@@ -41,10 +47,29 @@
 // the initial value
 #define TB_SPINLOCK_INIT            (0)
 
+// enter spinlock, it will pass the call site to the lock profiler if be enabled
+#define tb_spinlock_enter(lock)                     tb_spinlock_enter_(lock __tb_lock_profiler_vals__)
+
+// try to enter spinlock
+#define tb_spinlock_enter_try(lock)                 tb_spinlock_enter_try_(lock __tb_lock_profiler_vals__)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
 
+/*! wait the spinlock if it has been occupied
+ *
+ * spin it with the cpu relax hint first, and park the current thread 
+ * on the lock value (futex) if it is still occupied.
+ *
+ * the lock value: 0: unlocked, 1: locked, 2: locked and maybe some threads are parked 
+ *
+ * @note it's the slow path of tb_spinlock_enter() and does not use the lock profiler
+ *
+ * @param lock      the lock
+ */
+tb_void_t           tb_spinlock_enter_wait(tb_spinlock_ref_t lock);
+
 /*! init spinlock 
  *
  * @param lock      the lock
@@ -80,48 +105,27 @@ static __tb_inline_force__ tb_void_t tb_spinlock_exit(tb_spinlock_ref_t lock)
  *
  * @param lock      the lock
  */
-static __tb_inline_force__ tb_void_t tb_spinlock_enter(tb_spinlock_ref_t lock)
+static __tb_inline_force__ tb_void_t tb_spinlock_enter_(tb_spinlock_ref_t lock __tb_lock_profiler_decl__)
 {
     // check
     tb_assert(lock);
 
-    // init tryn
-    tb_size_t tryn = 5;
-    
-    // init occupied
 #ifdef TB_LOCK_PROFILER_ENABLE
-    tb_bool_t occupied = tb_false;
-#endif
+    // lock it, wait it and get the waited time if be occupied
+    tb_hong_t wait = -1;
+    if (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
+    {
+        wait = tb_uclock();
+        tb_spinlock_enter_wait(lock);
+        wait = tb_uclock() - wait;
+    }
 
+    // profile it
+    tb_lock_profiler_enter(tb_lock_profiler(), (tb_pointer_t)lock, wait __tb_lock_profiler_args__);
+#else
     // lock it
-    while (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
-    {
-#ifdef TB_LOCK_PROFILER_ENABLE
-        // occupied
-        if (!occupied)
-        {
-            // occupied++
-            occupied = tb_true;
-            tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
-
-            // dump backtrace
-#if 0//def __tb_debug__
-            tb_backtrace_dump("spinlock", tb_null, 10);
+    if (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1)) tb_spinlock_enter_wait(lock);
 #endif
-        }
-#endif
-
-        // yield the processor
-        if (!tryn--)
-        {
-            // yield
-            tb_sched_yield();
-//          tb_usleep(1);
-
-            // reset tryn
-            tryn = 5;
-        }
-    }
 }
 
 /*! enter spinlock without the lock profiler
@@ -133,23 +137,8 @@ static __tb_inline_force__ tb_void_t tb_spinlock_enter_without_profiler(tb_spinl
     // check
     tb_assert(lock);
 
-    // init tryn
-    tb_size_t tryn = 5;
-    
     // lock it
-    while (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1))
-    {
-        // yield the processor
-        if (!tryn--)
-        {
-            // yield
-            tb_sched_yield();
-//          tb_usleep(1);
-
-            // reset tryn
-            tryn = 5;
-        }
-    }
+    if (tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1)) tb_spinlock_enter_wait(lock);
 }
 
 /*! try to enter spinlock
@@ -158,7 +147,7 @@ static __tb_inline_force__ tb_void_t tb_spinlock_enter_without_profiler(tb_spinl
  *
  * @return          tb_true or tb_false
  */
-static __tb_inline_force__ tb_bool_t tb_spinlock_enter_try(tb_spinlock_ref_t lock)
+static __tb_inline_force__ tb_bool_t tb_spinlock_enter_try_(tb_spinlock_ref_t lock __tb_lock_profiler_decl__)
 {
     // check
     tb_assert(lock);
@@ -170,8 +159,9 @@ static __tb_inline_force__ tb_bool_t tb_spinlock_enter_try(tb_spinlock_ref_t loc
     // try locking it
     tb_bool_t ok = !tb_atomic_fetch_and_pset((tb_atomic_t*)lock, 0, 1);
 
-    // occupied?
-    if (!ok) tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
+    // profile it
+    if (ok) tb_lock_profiler_enter(tb_lock_profiler(), (tb_pointer_t)lock, -1 __tb_lock_profiler_args__);
+    else tb_lock_profiler_occupied(tb_lock_profiler(), (tb_pointer_t)lock);
 
     // ok?
     return ok;
@@ -202,8 +192,31 @@ static __tb_inline_force__ tb_void_t tb_spinlock_leave(tb_spinlock_ref_t lock)
     // check
     tb_assert(lock);
 
-    // leave
-    *((tb_atomic_t*)lock) = 0;
+#ifdef TB_LOCK_PROFILER_ENABLE
+    // profile the hold time
+    tb_lock_profiler_leave(tb_lock_profiler(), (tb_pointer_t)lock);
+#endif
+
+    // leave it and wake up one parked thread if exists
+    if (tb_atomic_fetch_and_set((tb_atomic_t*)lock, 0) == 2) tb_sched_wake((tb_atomic_t*)lock, 1);
 }
 
+/*! leave spinlock without the lock profiler
+ *
+ * @param lock      the lock
+ */
+static __tb_inline_force__ tb_void_t tb_spinlock_leave_without_profiler(tb_spinlock_ref_t lock)
+{
+    // check
+    tb_assert(lock);
+
+    // leave it and wake up one parked thread if exists
+    if (tb_atomic_fetch_and_set((tb_atomic_t*)lock, 0) == 2) tb_sched_wake((tb_atomic_t*)lock, 1);
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
 #endif
@@ -51,6 +51,23 @@ static tb_spinlock_t                g_thread_local_lock = TB_SPINLOCK_INIT;
 /* //////////////////////////////////////////////////////////////////////////////////////
  * private implementation
  */
+static __tb_inline__ tb_void_t tb_thread_local_remove(tb_thread_local_ref_t local)
+{
+    // enter lock
+    tb_spinlock_enter(&g_thread_local_lock);
+
+    // remove it from the thread local list
+    tb_single_list_entry_ref_t prev = (tb_single_list_entry_ref_t)&g_thread_local_list;
+    while (prev->next && prev->next != &local->entry) prev = prev->next;
+    if (prev->next) tb_single_list_entry_remove_next(&g_thread_local_list, prev);
+
+    // leave lock
+    tb_spinlock_leave(&g_thread_local_lock);
+
+    // reset it, it can be initialized again after exiting
+    local->inited = tb_false;
+    tb_atomic_set0(&local->once);
+}
 tb_bool_t tb_thread_local_init_env()
 {
     // init lock
@@ -64,22 +81,22 @@ tb_bool_t tb_thread_local_init_env()
 }
 tb_void_t tb_thread_local_exit_env()
 {
-    // enter lock
-    tb_spinlock_enter(&g_thread_local_lock);
-
-    // exit all thread locals
-    tb_for_all_if (tb_thread_local_ref_t, local, tb_single_list_entry_itor(&g_thread_local_list), local)
+    // exit all thread locals, it will remove itself from the list with the lock
+    while (1)
     {
+        // get the head thread local
+        tb_spinlock_enter(&g_thread_local_lock);
+        tb_single_list_entry_ref_t entry = tb_single_list_entry_head(&g_thread_local_list);
+        tb_spinlock_leave(&g_thread_local_lock);
+        tb_check_break(entry);
+
         // exit it
-        tb_thread_local_exit(local);
+        tb_thread_local_exit((tb_thread_local_ref_t)tb_single_list_entry(&g_thread_local_list, entry));
     }
 
     // exit the thread local list
     tb_single_list_entry_exit(&g_thread_local_list);
 
-    // leave lock
-    tb_spinlock_leave(&g_thread_local_lock);
-
     // exit lock
     tb_spinlock_exit(&g_thread_local_lock);
 }
@@ -152,6 +152,21 @@ typedef struct __tb_thread_pool_worker_t
     // is stoped?
     tb_atomic_t                         bstoped;
 
+    // the local lock for the stealing mode
+    tb_spinlock_t                       local_lock;
+
+    // the local urgent jobs for the stealing mode
+    tb_list_entry_head_t                local_urgent;
+
+    // the local waiting jobs for the stealing mode
+    tb_list_entry_head_t                local_waiting;
+
+    // the local jobs count for peeking it without the local lock
+    tb_atomic_t                         local_size;
+
+    // the random seed for choosing the stealing victim
+    tb_uint32_t                         steal_seed;
+
     // the private data 
     tb_thread_pool_worker_priv_t        priv[TB_THREAD_POOL_WORKER_PRIV_MAXN];
 
@@ -166,6 +181,9 @@ typedef struct __tb_thread_pool_impl_t
     // the worker maxn
     tb_size_t                           worker_maxn;
 
+    // the scheduling mode
+    tb_size_t                           mode;
+
     // the lock
     tb_spinlock_t                       lock;
 
@@ -190,11 +208,27 @@ typedef struct __tb_thread_pool_impl_t
     // the worker size
     tb_size_t                           worker_size;
 
+    // the jobs count for the stealing mode
+    tb_atomic_t                         jobs_size;
+
+    // the next worker index for posting the outside jobs in the stealing mode
+    tb_atomic_t                         post_index;
+
+    // the idle workers count for the stealing mode
+    tb_atomic_t                         idle_size;
+
     // the worker list
     tb_thread_pool_worker_t             worker_list[TB_THREAD_POOL_WORKER_MAXN];
 
 }tb_thread_pool_impl_t;
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the current worker of the stealing mode
+static tb_thread_local_t g_worker_local = TB_THREAD_LOCAL_INIT;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -385,6 +419,33 @@ static tb_void_t tb_thread_pool_worker_post(tb_thread_pool_impl_t* impl, tb_size
     if (value >= 0 && (tb_size_t)value < post) 
         tb_semaphore_post(impl->semaphore, post - value);
 }
+static tb_void_t tb_thread_pool_worker_exit(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert_and_check_return(worker);
+
+    // trace
+    tb_trace_d("worker[%lu]: exit", worker->id);
+
+    // stoped
+    tb_atomic_set(&worker->bstoped, 1);
+
+    // exit all private data
+    tb_size_t i = 0;
+    tb_size_t n = tb_arrayn(worker->priv);
+    for (i = 0; i < n; i++)
+    {
+        // the private data
+        tb_thread_pool_worker_priv_t* priv = &worker->priv[n - i - 1];
+
+        // exit it
+        if (priv->exit) priv->exit((tb_thread_pool_worker_ref_t)worker, priv->priv);
+
+        // clear it
+        priv->exit = tb_null;
+        priv->priv = tb_null;
+    }
+}
 static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
 {
     // the worker
@@ -586,27 +647,8 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
     // exit worker
     if (worker)
     {
-        // trace
-        tb_trace_d("worker[%lu]: exit", worker->id);
-
-        // stoped
-        tb_atomic_set(&worker->bstoped, 1);
-
         // exit all private data
-        tb_size_t i = 0;
-        tb_size_t n = tb_arrayn(worker->priv);
-        for (i = 0; i < n; i++)
-        {
-            // the private data
-            tb_thread_pool_worker_priv_t* priv = &worker->priv[n - i - 1];
-
-            // exit it
-            if (priv->exit) priv->exit((tb_thread_pool_worker_ref_t)worker, priv->priv);
-
-            // clear it
-            priv->exit = tb_null;
-            priv->priv = tb_null;
-        }
+        tb_thread_pool_worker_exit(worker);
 
         // exit stats
         if (worker->stats) tb_hash_map_exit(worker->stats);
@@ -621,6 +663,455 @@ static tb_int_t tb_thread_pool_worker_loop(tb_cpointer_t priv)
     return 0;
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * stealing implementation
+ */
+static tb_void_t tb_thread_pool_stealing_wake(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // wake one idle worker if exists
+    if (tb_atomic_get(&impl->idle_size) > 0) tb_thread_pool_worker_post(impl, 1);
+}
+static tb_void_t tb_thread_pool_stealing_push(tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(worker && job);
+
+    // enter
+    tb_spinlock_enter(&worker->local_lock);
+
+    // push it to the local urgent or waiting jobs
+    tb_list_entry_insert_tail(job->task.urgent? &worker->local_urgent : &worker->local_waiting, &job->entry);
+
+    // update the local size
+    tb_atomic_fetch_and_inc(&worker->local_size);
+
+    // leave
+    tb_spinlock_leave(&worker->local_lock);
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_pop(tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(worker);
+
+    // empty? 
+    tb_check_return_val(tb_atomic_get(&worker->local_size), tb_null);
+
+    // enter
+    tb_spinlock_enter(&worker->local_lock);
+
+    // pop the first job from the local urgent jobs first and the local waiting jobs
+    tb_thread_pool_job_t*       job = tb_null;
+    tb_list_entry_head_ref_t    jobs = tb_list_entry_size(&worker->local_urgent)? &worker->local_urgent : &worker->local_waiting;
+    if (tb_list_entry_size(jobs))
+    {
+        // get it
+        job = (tb_thread_pool_job_t*)tb_list_entry(jobs, tb_list_entry_head(jobs));
+
+        // remove it
+        tb_list_entry_remove_head(jobs);
+
+        // update the local size
+        tb_atomic_fetch_and_dec(&worker->local_size);
+    }
+
+    // leave
+    tb_spinlock_leave(&worker->local_lock);
+
+    // ok?
+    return job;
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_steal(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker)
+{
+    // check
+    tb_assert(impl && worker);
+
+    // the worker size
+    tb_size_t worker_size = impl->worker_size;
+    tb_check_return_val(worker_size > 1, tb_null);
+
+    // choose a random victim to start, xorshift32
+    tb_uint32_t seed = worker->steal_seed;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    worker->steal_seed = seed;
+
+    // init the stolen jobs
+    tb_list_entry_head_t stolen;
+    tb_list_entry_init(&stolen, tb_thread_pool_job_t, entry, tb_null);
+
+    // steal jobs from other workers
+    tb_size_t               i = 0;
+    tb_bool_t               more = tb_false;
+    tb_thread_pool_job_t*   job = tb_null;
+    for (i = 0; i < worker_size && !job; i++)
+    {
+        // the victim
+        tb_thread_pool_worker_t* victim = &impl->worker_list[(seed + i) % worker_size];
+        tb_check_continue(victim != worker && tb_atomic_get(&victim->local_size));
+
+        // enter
+        tb_spinlock_enter(&victim->local_lock);
+
+        // steal one urgent job first
+        if (tb_list_entry_size(&victim->local_urgent))
+        {
+            // get it
+            job = (tb_thread_pool_job_t*)tb_list_entry(&victim->local_urgent, tb_list_entry_head(&victim->local_urgent));
+
+            // remove it
+            tb_list_entry_remove_head(&victim->local_urgent);
+
+            // update the local size
+            tb_atomic_fetch_and_dec(&victim->local_size);
+        }
+        // steal the older half of the waiting jobs
+        else if (tb_list_entry_size(&victim->local_waiting))
+        {
+            // get the first job
+            job = (tb_thread_pool_job_t*)tb_list_entry(&victim->local_waiting, tb_list_entry_head(&victim->local_waiting));
+            tb_list_entry_remove_head(&victim->local_waiting);
+
+            // move the others to the stolen jobs
+            tb_size_t count = tb_list_entry_size(&victim->local_waiting) >> 1;
+            while (count--)
+            {
+                tb_list_entry_ref_t entry = tb_list_entry_head(&victim->local_waiting);
+                tb_list_entry_remove_head(&victim->local_waiting);
+                tb_list_entry_insert_tail(&stolen, entry);
+            }
+
+            // update the local size
+            tb_atomic_fetch_and_sub(&victim->local_size, tb_list_entry_size(&stolen) + 1);
+        }
+
+        // have more jobs on this victim?
+        more = tb_atomic_get(&victim->local_size)? tb_true : tb_false;
+
+        // leave
+        tb_spinlock_leave(&victim->local_lock);
+    }
+
+    // move the stolen jobs to the local waiting jobs
+    if (tb_list_entry_size(&stolen))
+    {
+        // trace
+        tb_trace_d("worker[%lu]: steal: %lu jobs", worker->id, tb_list_entry_size(&stolen) + 1);
+
+        // enter
+        tb_spinlock_enter(&worker->local_lock);
+
+        // splice them
+        tb_size_t count = tb_list_entry_size(&stolen);
+        tb_list_entry_splice_tail(&worker->local_waiting, &stolen);
+        tb_atomic_fetch_and_add(&worker->local_size, count);
+
+        // leave
+        tb_spinlock_leave(&worker->local_lock);
+
+        // we have more jobs now
+        more = tb_true;
+    }
+
+    // wake another idle worker to steal the remaining jobs
+    if (job && more) tb_thread_pool_stealing_wake(impl);
+
+    // ok?
+    return job;
+}
+static tb_bool_t tb_thread_pool_stealing_empty(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // exists jobs?
+    tb_size_t i = 0;
+    tb_size_t n = impl->worker_size;
+    for (i = 0; i < n; i++)
+    {
+        if (tb_atomic_get(&impl->worker_list[i].local_size)) 
+            return tb_false;
+    }
+
+    // empty
+    return tb_true;
+}
+static tb_void_t tb_thread_pool_stealing_free(tb_thread_pool_impl_t* impl, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && job);
+
+    // refn--, free it if be the last reference
+    if (!tb_atomic_dec_and_fetch(&job->refn))
+    {
+        // exit it
+        tb_free(job);
+
+        // update the jobs size
+        tb_atomic_fetch_and_dec(&impl->jobs_size);
+    }
+}
+static tb_void_t tb_thread_pool_stealing_done(tb_thread_pool_impl_t* impl, tb_thread_pool_worker_t* worker, tb_thread_pool_job_t* job)
+{
+    // check
+    tb_assert(impl && worker && job && job->task.done);
+
+    // the job state
+    tb_size_t state = tb_atomic_fetch_and_pset(&job->state, TB_STATE_WAITING, TB_STATE_WORKING);
+
+    // the job is waiting? work it
+    if (state == TB_STATE_WAITING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: done: task[%p:%s]: ..", worker->id, job->task.done, job->task.name);
+
+        // done the job
+        job->task.done((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // exit the job
+        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_FINISHED);
+    }
+    // the job is killing? kill it
+    else if (state == TB_STATE_KILLING)
+    {
+        // trace
+        tb_trace_d("worker[%lu]: kill: task[%p:%s]", worker->id, job->task.done, job->task.name);
+
+        // exit the job
+        if (job->task.exit) job->task.exit((tb_thread_pool_worker_ref_t)worker, job->task.priv);
+
+        // update the job state
+        tb_atomic_set(&job->state, TB_STATE_KILLED);
+    }
+
+    // free the job
+    tb_thread_pool_stealing_free(impl, job);
+}
+static tb_void_t tb_thread_pool_stealing_kill_jobs(tb_list_entry_head_ref_t jobs)
+{
+    // check
+    tb_assert(jobs);
+
+    // kill all waiting jobs
+    tb_list_entry_ref_t entry = tb_list_entry_head(jobs);
+    tb_list_entry_ref_t tail = tb_list_entry_tail(jobs);
+    for (; entry != tail; entry = tb_list_entry_next(entry))
+    {
+        // the job
+        tb_thread_pool_job_t* job = (tb_thread_pool_job_t*)tb_list_entry(jobs, entry);
+
+        // trace
+        tb_trace_d("task[%p:%s]: kill: ..", job->task.done, job->task.name);
+
+        // kill it if be waiting
+        tb_atomic_pset(&job->state, TB_STATE_WAITING, TB_STATE_KILLING);
+    }
+}
+static tb_void_t tb_thread_pool_stealing_kill_all(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert(impl);
+
+    // kill all waiting jobs of all workers
+    tb_size_t i = 0;
+    tb_size_t n = impl->worker_size;
+    for (i = 0; i < n; i++)
+    {
+        // the worker
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // enter
+        tb_spinlock_enter(&worker->local_lock);
+
+        // kill jobs
+        tb_thread_pool_stealing_kill_jobs(&worker->local_urgent);
+        tb_thread_pool_stealing_kill_jobs(&worker->local_waiting);
+
+        // leave
+        tb_spinlock_leave(&worker->local_lock);
+    }
+}
+static tb_thread_pool_job_t* tb_thread_pool_stealing_post_task(tb_thread_pool_impl_t* impl, tb_thread_pool_task_t const* task, tb_size_t refn)
+{
+    // check
+    tb_assert_and_check_return_val(impl && task && task->done && impl->worker_size, tb_null);
+
+    // stoped?
+    tb_check_return_val(!impl->bstoped, tb_null);
+
+    // too many jobs?
+    tb_assert_and_check_return_val((tb_size_t)tb_atomic_get(&impl->jobs_size) + 1 < TB_THREAD_POOL_JOBS_WAITING_MAXN, tb_null);
+
+    // make job
+    tb_thread_pool_job_t* job = tb_malloc0_type(tb_thread_pool_job_t);
+    tb_assert_and_check_return_val(job, tb_null);
+
+    // init job
+    job->refn   = refn;
+    job->state  = TB_STATE_WAITING;
+    job->task   = *task;
+
+    // update the jobs size
+    tb_atomic_fetch_and_inc(&impl->jobs_size);
+
+    /* post it to the current worker if we are in the worker thread of this pool, 
+     * otherwise distribute it to all workers
+     */
+    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)tb_thread_local_get(&g_worker_local);
+    if (!worker || worker->pool != (tb_thread_pool_ref_t)impl)
+        worker = &impl->worker_list[(tb_size_t)tb_atomic_fetch_and_inc(&impl->post_index) % impl->worker_size];
+
+    // trace
+    tb_trace_d("task[%p:%s]: post to worker[%lu]: ..", task->done, task->name, worker->id);
+
+    // push it
+    tb_thread_pool_stealing_push(worker, job);
+
+    // wake an idle worker
+    tb_thread_pool_stealing_wake(impl);
+
+    // ok
+    return job;
+}
+static tb_int_t tb_thread_pool_stealing_loop(tb_cpointer_t priv);
+static tb_bool_t tb_thread_pool_stealing_start(tb_thread_pool_impl_t* impl)
+{
+    // check
+    tb_assert_and_check_return_val(impl && !impl->worker_size, tb_false);
+
+    // init the current worker
+    if (!tb_thread_local_init(&g_worker_local, tb_null)) return tb_false;
+
+    // init all workers first, because the workers will steal jobs from each other
+    tb_size_t i = 0;
+    tb_size_t n = impl->worker_maxn;
+    for (i = 0; i < n; i++)
+    {
+        // the worker 
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // clear worker
+        tb_memset(worker, 0, sizeof(tb_thread_pool_worker_t));
+
+        // init worker
+        worker->id          = i;
+        worker->pool        = (tb_thread_pool_ref_t)impl;
+        worker->steal_seed  = (tb_uint32_t)(i * 2654435761u + 1);
+
+        // init local jobs
+        tb_spinlock_init(&worker->local_lock);
+        tb_list_entry_init(&worker->local_urgent, tb_thread_pool_job_t, entry, tb_null);
+        tb_list_entry_init(&worker->local_waiting, tb_thread_pool_job_t, entry, tb_null);
+
+        // register lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+        tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&worker->local_lock, TB_TRACE_MODULE_NAME);
+#endif
+    }
+
+    // update the worker size
+    impl->worker_size = n;
+
+    // start all workers
+    tb_size_t started = 0;
+    for (i = 0; i < n; i++)
+    {
+        // the worker 
+        tb_thread_pool_worker_t* worker = &impl->worker_list[i];
+
+        // start it
+        worker->loop = tb_thread_init(__tb_lstring__("thread_pool"), tb_thread_pool_stealing_loop, worker, impl->stack);
+        tb_assert_and_check_continue(worker->loop);
+
+        // the jobs of the failed worker will be stolen by others
+        started++;
+    }
+
+    // ok?
+    return started? tb_true : tb_false;
+}
+static tb_int_t tb_thread_pool_stealing_loop(tb_cpointer_t priv)
+{
+    // the worker
+    tb_thread_pool_worker_t* worker = (tb_thread_pool_worker_t*)priv;
+
+    // trace
+    tb_trace_d("worker[%lu]: init", worker? worker->id : -1);
+
+    // done
+    do
+    {
+        // check
+        tb_assert_and_check_break(worker);
+
+        // the pool
+        tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)worker->pool;
+        tb_assert_and_check_break(impl && impl->semaphore);
+
+        // save the current worker
+        if (!tb_thread_local_set(&g_worker_local, worker)) break;
+
+        // loop
+        while (1)
+        {
+            // pop a job from the local jobs first or steal one from other workers
+            tb_thread_pool_job_t* job = tb_thread_pool_stealing_pop(worker);
+            if (!job) job = tb_thread_pool_stealing_steal(impl, worker);
+
+            // done it
+            if (job)
+            {
+                tb_thread_pool_stealing_done(impl, worker, job);
+                continue;
+            }
+
+            // killed?
+            tb_check_break(!tb_atomic_get(&worker->bstoped));
+
+            // idle now
+            tb_atomic_fetch_and_inc(&impl->idle_size);
+
+            // check it again before waiting, the posters will wake us if we are idle
+            if (!tb_thread_pool_stealing_empty(impl))
+            {
+                tb_atomic_fetch_and_dec(&impl->idle_size);
+                continue;
+            }
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ..", worker->id);
+
+            // wait some time
+            tb_long_t wait = tb_semaphore_wait(impl->semaphore, -1);
+
+            // busy now
+            tb_atomic_fetch_and_dec(&impl->idle_size);
+
+            // failed?
+            tb_assert_and_check_break(wait > 0);
+
+            // trace
+            tb_trace_d("worker[%lu]: wait: ok", worker->id);
+        }
+
+        // clear the current worker
+        tb_thread_local_set(&g_worker_local, tb_null);
+
+    } while (0);
+
+    // exit worker
+    if (worker) tb_thread_pool_worker_exit(worker);
+
+    // exit
+    return 0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * jobs implementation
  */
@@ -757,6 +1248,13 @@ tb_thread_pool_ref_t tb_thread_pool()
 }
 tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
 {
+    return tb_thread_pool_init_with_mode(worker_maxn, stack, TB_THREAD_POOL_MODE_SHARED);
+}
+tb_thread_pool_ref_t tb_thread_pool_init_with_mode(tb_size_t worker_maxn, tb_size_t stack, tb_size_t mode)
+{
+    // check
+    tb_assert_and_check_return_val(mode == TB_THREAD_POOL_MODE_SHARED || mode == TB_THREAD_POOL_MODE_STEALING, tb_null);
+
     // done
     tb_bool_t               ok = tb_false;
     tb_thread_pool_impl_t*  impl = tb_null;
@@ -769,20 +1267,32 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         // init lock
         if (!tb_spinlock_init(&impl->lock)) break;
 
-        // computate the default worker maxn if be zero
-        if (!worker_maxn) worker_maxn = tb_processor_count() << 2;
+        /* computate the default worker maxn if be zero
+         *
+         * the stealing workers are always running, so we need not more workers than processors
+         */
+        if (!worker_maxn) worker_maxn = mode == TB_THREAD_POOL_MODE_STEALING? tb_processor_count() : (tb_processor_count() << 2);
         tb_assert_and_check_break(worker_maxn);
 
+        // the worker list is static
+        if (worker_maxn > TB_THREAD_POOL_WORKER_MAXN) worker_maxn = TB_THREAD_POOL_WORKER_MAXN;
+
         // init thread stack
         impl->stack         = stack;
 
+        // init mode
+        impl->mode          = mode;
+
         // init workers
         impl->worker_size   = 0;
         impl->worker_maxn   = worker_maxn;
 
-        // init jobs pool
-        impl->jobs_pool     = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
-        tb_assert_and_check_break(impl->jobs_pool);
+        // init jobs pool, the stealing jobs are allocated without the pool lock
+        if (mode == TB_THREAD_POOL_MODE_SHARED)
+        {
+            impl->jobs_pool = tb_fixed_pool_init(tb_null, TB_THREAD_POOL_JOBS_POOL_GROW, sizeof(tb_thread_pool_job_t), tb_null, tb_null, tb_null);
+            tb_assert_and_check_break(impl->jobs_pool);
+        }
 
         // init jobs urgent
         tb_list_entry_init(&impl->jobs_urgent, tb_thread_pool_job_t, entry, tb_null);
@@ -802,6 +1312,9 @@ tb_thread_pool_ref_t tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack)
         tb_lock_profiler_register(tb_lock_profiler(), (tb_pointer_t)&impl->lock, TB_TRACE_MODULE_NAME);
 #endif
 
+        // start all workers for the stealing mode
+        if (mode == TB_THREAD_POOL_MODE_STEALING && !tb_thread_pool_stealing_start(impl)) break;
+
         // ok
         ok = tb_true;
 
@@ -866,6 +1379,12 @@ tb_bool_t tb_thread_pool_exit(tb_thread_pool_ref_t pool)
     }
     impl->worker_size = 0;
 
+    // exit the local lock of all stealing workers
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        for (i = 0; i < n; i++) tb_spinlock_exit(&impl->worker_list[i].local_lock);
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -927,6 +1446,7 @@ tb_void_t tb_thread_pool_kill(tb_thread_pool_ref_t pool)
 
         // kill all jobs
         if (impl->jobs_pool) tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+        else if (impl->mode == TB_THREAD_POOL_MODE_STEALING) tb_thread_pool_stealing_kill_all(impl);
 
         // post it
         post = impl->worker_size;
@@ -981,6 +1501,9 @@ tb_size_t tb_thread_pool_task_size(tb_thread_pool_ref_t pool)
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl, 0);
 
+    // the stealing task size
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING) return (tb_size_t)tb_atomic_get(&impl->jobs_size);
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -999,6 +1522,21 @@ tb_bool_t tb_thread_pool_task_post(tb_thread_pool_ref_t pool, tb_char_t const* n
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_false);
 
+    // post it to the local jobs of the worker for the stealing mode
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task
+        return tb_thread_pool_stealing_post_task(impl, &task, 1)? tb_true : tb_false;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1044,6 +1582,19 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && list, 0);
 
+    // post them to the local jobs of the workers for the stealing mode
+    tb_size_t ok = 0;
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        for (ok = 0; ok < size; ok++)
+        {
+            // post task
+            tb_thread_pool_job_t* job = tb_thread_pool_stealing_post_task(impl, &list[ok], 1);
+            tb_check_break(job);
+        }
+        return ok;
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1051,7 +1602,6 @@ tb_size_t tb_thread_pool_task_post_list(tb_thread_pool_ref_t pool, tb_thread_poo
     tb_spinlock_enter(&impl->lock);
 
     // done
-    tb_size_t ok = 0;
     if (!impl->bstoped)
     {
         for (ok = 0; ok < size; ok++)
@@ -1077,6 +1627,21 @@ tb_thread_pool_task_ref_t tb_thread_pool_task_init(tb_thread_pool_ref_t pool, tb
     tb_thread_pool_impl_t* impl = (tb_thread_pool_impl_t*)pool;
     tb_assert_and_check_return_val(impl && done, tb_null);
 
+    // post it to the local jobs of the worker for the stealing mode
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        // init task
+        tb_thread_pool_task_t task = {0};
+        task.name       = name;
+        task.done       = done;
+        task.exit       = exit;
+        task.priv       = priv;
+        task.urgent     = urgent;
+
+        // post task and refer it for the caller
+        return (tb_thread_pool_task_ref_t)tb_thread_pool_stealing_post_task(impl, &task, 2);
+    }
+
     // init the post size
     tb_size_t post_size = 0;
 
@@ -1146,6 +1711,8 @@ tb_void_t tb_thread_pool_task_kill_all(tb_thread_pool_ref_t pool)
     // kill all jobs
     if (!impl->bstoped && impl->jobs_pool) 
         tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_kill_all, tb_null);
+    else if (!impl->bstoped && impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        tb_thread_pool_stealing_kill_all(impl);
 
     // leave
     tb_spinlock_leave(&impl->lock);
@@ -1188,7 +1755,8 @@ tb_long_t tb_thread_pool_task_wait_all(tb_thread_pool_ref_t pool, tb_long_t time
         tb_spinlock_enter(&impl->lock);
 
         // the jobs count
-        size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
+        if (impl->mode == TB_THREAD_POOL_MODE_STEALING) size = (tb_size_t)tb_atomic_get(&impl->jobs_size);
+        else size = impl->jobs_pool? tb_fixed_pool_size(impl->jobs_pool) : 0;
 
         // trace
         tb_trace_d("wait: jobs: %lu, waiting: %lu, pending: %lu, urgent: %lu: .."
@@ -1227,6 +1795,13 @@ tb_void_t tb_thread_pool_task_exit(tb_thread_pool_ref_t pool, tb_thread_pool_tas
     // kill it first
     tb_thread_pool_task_kill(pool, task);
 
+    // release it for the stealing mode
+    if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+    {
+        tb_thread_pool_stealing_free(impl, job);
+        return ;
+    }
+
     // enter
     tb_spinlock_enter(&impl->lock);
 
@@ -1264,7 +1839,9 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
             tb_assert_and_check_break(worker);
 
             // dump worker
-            tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped));
+            if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+                tb_trace_i("    worker: id: %lu, stoped: %ld, local: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped), (tb_long_t)tb_atomic_get(&worker->local_size));
+            else tb_trace_i("    worker: id: %lu, stoped: %ld", worker->id, (tb_long_t)tb_atomic_get(&worker->bstoped));
         }
 
         // trace
@@ -1279,6 +1856,11 @@ tb_void_t tb_thread_pool_dump(tb_thread_pool_ref_t pool)
             // dump jobs
             tb_fixed_pool_walk(impl->jobs_pool, tb_thread_pool_jobs_walk_dump_all, tb_null);
         }
+        else if (impl->mode == TB_THREAD_POOL_MODE_STEALING)
+        {
+            // trace
+            tb_trace_i("jobs: size: %ld, idle workers: %ld", (tb_long_t)tb_atomic_get(&impl->jobs_size), (tb_long_t)tb_atomic_get(&impl->idle_size));
+        }
     }
 
     // leave
@@ -51,6 +51,14 @@ __tb_extern_c_enter__
  * types
  */
 
+/// the thread pool mode enum
+typedef enum __tb_thread_pool_mode_e
+{
+    TB_THREAD_POOL_MODE_SHARED          = 0 //!< all workers pull tasks from the shared queues under one lock
+,   TB_THREAD_POOL_MODE_STEALING        = 1 //!< every worker owns a local deque and the idle workers steal tasks from others
+
+}tb_thread_pool_mode_e;
+
 /// the thread pool ref type
 typedef __tb_typeref__(thread_pool);
 
@@ -108,6 +116,20 @@ tb_thread_pool_ref_t        tb_thread_pool(tb_noarg_t);
  */
 tb_thread_pool_ref_t        tb_thread_pool_init(tb_size_t worker_maxn, tb_size_t stack);
 
+/*! init thread pool with the given scheduling mode
+ *
+ * the stealing mode starts all workers at once and gives each of them a local deque,
+ * the tasks posted from a worker are pushed to its own deque and the others are distributed to all workers,
+ * the idle workers will steal tasks from other deques before waiting.
+ *
+ * @param worker_maxn       the thread worker max count, using the default count if be zero
+ * @param stack             the thread stack, using the default stack size if be zero 
+ * @param mode              the scheduling mode, .e.g TB_THREAD_POOL_MODE_SHARED, TB_THREAD_POOL_MODE_STEALING
+ *
+ * @return                  the thread pool 
+ */
+tb_thread_pool_ref_t        tb_thread_pool_init_with_mode(tb_size_t worker_maxn, tb_size_t stack, tb_size_t mode);
+
 /*! exit thread pool
  *
  * @param pool              the thread pool 
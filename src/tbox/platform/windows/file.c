@@ -355,6 +355,55 @@ tb_long_t tb_file_pwritv(tb_file_ref_t file, tb_iovec_t const* list, tb_size_t s
     // ok
     return real;
 }
+tb_byte_t const* tb_file_mmap(tb_file_ref_t file, tb_hize_t offset, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(file && size, tb_null);
+
+    // the allocation granularity
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    tb_size_t granularity = (tb_size_t)info.dwAllocationGranularity;
+    tb_assert_and_check_return_val(granularity, tb_null);
+
+    // the mapped offset must be aligned by the allocation granularity
+    tb_size_t   skip = (tb_size_t)(offset & (granularity - 1));
+    tb_hize_t   base = offset - skip;
+
+    // create the file mapping
+    HANDLE mapping = CreateFileMappingW((HANDLE)file, tb_null, PAGE_READONLY, 0, 0, tb_null);
+    tb_check_return_val(mapping, tb_null);
+
+    // map it, the view will hold the file mapping 
+    tb_pointer_t data = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(base >> 32), (DWORD)base, size + skip);
+    CloseHandle(mapping);
+    tb_check_return_val(data, tb_null);
+
+    // ok
+    return (tb_byte_t const*)data + skip;
+}
+tb_bool_t tb_file_munmap(tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // the allocation granularity
+    SYSTEM_INFO info = {0};
+    GetSystemInfo(&info);
+    tb_size_t granularity = (tb_size_t)info.dwAllocationGranularity;
+    tb_assert_and_check_return_val(granularity, tb_false);
+
+    // unmap it from the view address
+    return UnmapViewOfFile((LPCVOID)(data - ((tb_size_t)data & (granularity - 1))))? tb_true : tb_false;
+}
+tb_bool_t tb_file_madvise(tb_byte_t const* data, tb_size_t size, tb_size_t advice)
+{
+    // check
+    tb_assert_and_check_return_val(data && size, tb_false);
+
+    // not supported now
+    return advice == TB_FILE_ADVICE_NORMAL;
+}
 tb_bool_t tb_file_sync(tb_file_ref_t file)
 {
     // check
@@ -67,7 +67,7 @@ tb_bool_t tb_native_memory_init()
     } while (0);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return ok;
@@ -82,7 +82,7 @@ tb_void_t tb_native_memory_exit()
     g_heap = tb_null;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // exit lock
     tb_spinlock_exit(&g_lock);
@@ -102,7 +102,7 @@ tb_pointer_t tb_native_memory_malloc(tb_size_t size)
     if (g_heap) data = HeapAlloc((HANDLE)g_heap, 0, (SIZE_T)size);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return data;
@@ -122,7 +122,7 @@ tb_pointer_t tb_native_memory_malloc0(tb_size_t size)
     if (g_heap) data = HeapAlloc((HANDLE)g_heap, HEAP_ZERO_MEMORY, (SIZE_T)size);
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return data;
@@ -163,7 +163,7 @@ tb_pointer_t tb_native_memory_ralloc(tb_pointer_t data, tb_size_t size)
         if (g_heap) data = (tb_pointer_t)HeapReAlloc((HANDLE)g_heap, 0, data, (SIZE_T)size);
 
         // leave
-        tb_spinlock_leave(&g_lock);
+        tb_spinlock_leave_without_profiler(&g_lock);
 
         // ok?
         return data;
@@ -182,7 +182,7 @@ tb_bool_t tb_native_memory_free(tb_pointer_t data)
     if (g_heap) ok = HeapFree((HANDLE)g_heap, 0, data)? tb_true : tb_false;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return ok;
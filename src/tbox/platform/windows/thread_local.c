@@ -99,12 +99,19 @@ tb_void_t tb_thread_local_exit(tb_thread_local_ref_t local)
     // check
     tb_assert(local);
 
+    // have been not initialized or exited?
+    tb_check_return(local->inited);
+
     // free the previous data first
     if (local->free && tb_thread_local_has(local))
         local->free(tb_thread_local_get(local));
 
     // exit it
-    TlsFree(*((DWORD*)local->priv));
+    TlsFree(((DWORD*)local->priv)[0]);
+    TlsFree(((DWORD*)local->priv)[1]);
+
+    // remove it from the thread local list
+    tb_thread_local_remove(local);
 }
 tb_bool_t tb_thread_local_has(tb_thread_local_ref_t local)
 {
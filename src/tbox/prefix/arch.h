@@ -197,6 +197,11 @@
 #       undef TB_ARCH_STRING_2
 #       define TB_ARCH_STRING_2             "_sse3"
 #   endif
+#   if defined(__AVX2__)
+#       define TB_ARCH_AVX2
+#       undef TB_ARCH_STRING_2
+#       define TB_ARCH_STRING_2             "_avx2"
+#   endif
 #endif
 
 // vfp
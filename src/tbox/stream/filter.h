@@ -91,6 +91,21 @@ typedef __tb_typeref__(filter);
  */
 tb_filter_ref_t         tb_filter_init_from_zip(tb_size_t algo, tb_size_t action);
 
+/*! init filter from zip with the parallel deflate
+ *
+ * the input data will be split to blocks and deflated on the worker threads,
+ * the output is still a standard gzip or zlib stream.
+ *
+ * only the deflate of gzip and zlib supports it, the others will use the serial zip
+ *
+ * @param algo          the zip algorithm
+ * @param action        the zip action
+ * @param workers       the worker count, using the processor count if be zero
+ *
+ * @return              the filter
+ */
+tb_filter_ref_t         tb_filter_init_from_zip_parallel(tb_size_t algo, tb_size_t action, tb_size_t workers);
+
 /*! init filter from charset
  *
  * @param fr            the from charset
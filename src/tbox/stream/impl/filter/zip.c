@@ -28,11 +28,142 @@
  */
 #include "prefix.h"
 #include "../../../zip/zip.h"
+#include "../../../platform/platform.h"
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+#   include <zlib.h>
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the parallel deflate block size
+#ifdef __tb_small__
+#   define TB_FILTER_ZIP_PARALLEL_BLOCK         (64 * 1024)
+#else
+#   define TB_FILTER_ZIP_PARALLEL_BLOCK         (128 * 1024)
+#endif
+
+// the parallel deflate dictionary size, the deflate window size
+#define TB_FILTER_ZIP_PARALLEL_DICT             (32 * 1024)
+
+// the worker private data index of the cached zstream, the thread pool is owned by the filter
+#define TB_FILTER_ZIP_PARALLEL_PRIV_ZSTREAM     (0)
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+
+// the parallel deflate job type
+typedef struct __tb_filter_zip_job_t
+{
+    // the next job 
+    struct __tb_filter_zip_job_t*   next;
+
+    // the semaphore for notifying the filter
+    tb_semaphore_ref_t              semaphore;
+
+    // the input data: [dictionary][block data]
+    tb_byte_t*                      data;
+
+    // the dictionary size
+    tb_size_t                       dict_size;
+
+    // the block data size
+    tb_size_t                       size;
+
+    // the output data
+    tb_byte_t*                      zdata;
+
+    // the output data size
+    tb_size_t                       zsize;
+
+    // the output data maxn
+    tb_size_t                       zmaxn;
+
+    // the output position 
+    tb_size_t                       zpos;
+
+    // the crc32 or adler32 of the block data
+    tb_uint32_t                     check;
+
+    // is gzip? using crc32 
+    tb_uint8_t                      bgzip   : 1;
+
+    // is the last block?
+    tb_uint8_t                      blast   : 1;
+
+    // is failed?
+    tb_uint8_t                      bfailed : 1;
+
+    // is done?
+    tb_atomic_t                     done;
+
+}tb_filter_zip_job_t;
+
+// the parallel deflate type
+typedef struct __tb_filter_zip_parallel_t
+{
+    // the thread pool
+    tb_thread_pool_ref_t            pool;
+
+    // the semaphore, will be posted after one job has been done
+    tb_semaphore_ref_t              semaphore;
+
+    // the head job for outputting
+    tb_filter_zip_job_t*            head;
+
+    // the tail job
+    tb_filter_zip_job_t*            tail;
+
+    // the filling job
+    tb_filter_zip_job_t*            fill;
+
+    // the free jobs
+    tb_filter_zip_job_t*            free;
+
+    // the busy jobs count 
+    tb_size_t                       busy;
+
+    // the busy jobs maxn
+    tb_size_t                       busy_maxn;
+
+    // the window of the last input data, priming the dictionary of the next block
+    tb_byte_t                       window[TB_FILTER_ZIP_PARALLEL_DICT];
+
+    // the window size
+    tb_size_t                       window_size;
+
+    // the combined crc32 or adler32 
+    tb_uint32_t                     check;
+
+    // the total input size 
+    tb_hize_t                       total;
+
+    // the pending header or trailer data
+    tb_byte_t                       extra[16];
+
+    // the pending extra size
+    tb_size_t                       extra_size;
+
+    // the pending extra position
+    tb_size_t                       extra_pos;
+
+    // is gzip?
+    tb_uint8_t                      bgzip   : 1;
+
+    // the last block has been posted?
+    tb_uint8_t                      blast   : 1;
+
+    // is end? 
+    tb_uint8_t                      bend    : 1;
+
+}tb_filter_zip_parallel_t;
+
+#endif
+
 // the zip filter type
 typedef struct __tb_filter_zip_t
 {
@@ -45,9 +176,17 @@ typedef struct __tb_filter_zip_t
     // the action
     tb_size_t                   action;
 
+    // the workers count of the parallel deflate, disable it if be zero
+    tb_size_t                   workers;
+
     // the zip 
     tb_zip_ref_t                zip;
 
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // the parallel deflate
+    tb_filter_zip_parallel_t*   parallel;
+#endif
+
 }tb_filter_zip_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -59,12 +198,453 @@ static __tb_inline__ tb_filter_zip_t* tb_filter_zip_cast(tb_filter_t* filter)
     tb_assert_and_check_return_val(filter && filter->type == TB_FILTER_TYPE_ZIP, tb_null);
     return (tb_filter_zip_t*)filter;
 }
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+static tb_void_t tb_filter_zip_parallel_zstream_exit(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // exit zstream
+    z_stream* zstream = (z_stream*)priv;
+    if (zstream)
+    {
+        deflateEnd(zstream);
+        tb_free(zstream);
+    }
+}
+static z_stream* tb_filter_zip_parallel_zstream(tb_thread_pool_worker_ref_t worker)
+{
+    // reuse the cached zstream of this worker
+    z_stream* zstream = (z_stream*)tb_thread_pool_worker_getp(worker, TB_FILTER_ZIP_PARALLEL_PRIV_ZSTREAM);
+    if (zstream) return deflateReset(zstream) == Z_OK? zstream : tb_null;
+
+    // make zstream
+    zstream = tb_malloc0_type(z_stream);
+    tb_assert_and_check_return_val(zstream, tb_null);
+
+    // init the raw deflate, the header and trailer are written by the filter
+    if (deflateInit2(zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        tb_free(zstream);
+        return tb_null;
+    }
+
+    // cache it
+    tb_thread_pool_worker_setp(worker, TB_FILTER_ZIP_PARALLEL_PRIV_ZSTREAM, tb_filter_zip_parallel_zstream_exit, zstream);
+    return zstream;
+}
+static tb_void_t tb_filter_zip_parallel_job_done(tb_thread_pool_worker_ref_t worker, tb_cpointer_t priv)
+{
+    // check
+    tb_filter_zip_job_t* job = (tb_filter_zip_job_t*)priv;
+    tb_assert_and_check_return(job);
+
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // the zstream
+        z_stream* zstream = tb_filter_zip_parallel_zstream(worker);
+        tb_assert_and_check_break(zstream);
+
+        // prime the dictionary with the tail of the previous block
+        if (job->dict_size && deflateSetDictionary(zstream, job->data, (uInt)job->dict_size) != Z_OK) break;
+
+        // grow the output data, the sync marker and the empty final block need a few bytes
+        tb_size_t need = (tb_size_t)deflateBound(zstream, (uLong)job->size) + 16;
+        if (job->zmaxn < need)
+        {
+            job->zdata = (tb_byte_t*)tb_ralloc(job->zdata, need);
+            tb_assert_and_check_break(job->zdata);
+            job->zmaxn = need;
+        }
+
+        /* deflate it
+         *
+         * the middle blocks end with Z_SYNC_FLUSH for aligning the bits to the byte boundary,
+         * so these raw blocks can be concatenated to one deflate stream directly
+         */
+        zstream->next_in    = (Bytef*)job->data + job->dict_size;
+        zstream->avail_in   = (uInt)job->size;
+        zstream->next_out   = (Bytef*)job->zdata;
+        zstream->avail_out  = (uInt)job->zmaxn;
+        tb_int_t r = deflate(zstream, job->blast? Z_FINISH : Z_SYNC_FLUSH);
+        tb_assertf_and_check_break(job->blast? r == Z_STREAM_END : (r == Z_OK && !zstream->avail_in), "deflate failed: %d", r);
+        job->zsize = job->zmaxn - zstream->avail_out;
+        job->zpos = 0;
+
+        // compute the check of the block data
+        if (job->bgzip) job->check = (tb_uint32_t)crc32(crc32(0, Z_NULL, 0), job->data + job->dict_size, (uInt)job->size);
+        else job->check = (tb_uint32_t)adler32(adler32(0, Z_NULL, 0), job->data + job->dict_size, (uInt)job->size);
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok) job->bfailed = 1;
+
+    // notify the filter 
+    tb_atomic_set(&job->done, 1);
+    tb_semaphore_post(job->semaphore, 1);
+}
+static tb_filter_zip_job_t* tb_filter_zip_parallel_job_init(tb_filter_zip_parallel_t* parallel)
+{
+    // reuse the free job
+    tb_filter_zip_job_t* job = parallel->free;
+    if (job) parallel->free = job->next;
+    else
+    {
+        // make job
+        job = tb_malloc0_type(tb_filter_zip_job_t);
+        tb_assert_and_check_return_val(job, tb_null);
+
+        // make the input data
+        job->data = tb_malloc_bytes(TB_FILTER_ZIP_PARALLEL_DICT + TB_FILTER_ZIP_PARALLEL_BLOCK);
+        if (!job->data)
+        {
+            tb_free(job);
+            return tb_null;
+        }
+        job->semaphore  = parallel->semaphore;
+        job->bgzip      = parallel->bgzip;
+    }
+
+    // init job
+    job->next       = tb_null;
+    job->size       = 0;
+    job->zsize      = 0;
+    job->zpos       = 0;
+    job->blast      = 0;
+    job->bfailed    = 0;
+    tb_atomic_set0(&job->done);
+
+    // copy the dictionary from the window
+    job->dict_size = parallel->window_size;
+    if (job->dict_size) tb_memcpy(job->data, parallel->window, job->dict_size);
+
+    // ok
+    return job;
+}
+static tb_void_t tb_filter_zip_parallel_job_exit(tb_filter_zip_job_t* job)
+{
+    // exit it
+    if (job)
+    {
+        if (job->zdata) tb_free(job->zdata);
+        if (job->data) tb_free(job->data);
+        tb_free(job);
+    }
+}
+static tb_bool_t tb_filter_zip_parallel_post(tb_filter_zip_parallel_t* parallel, tb_bool_t blast)
+{
+    // the filling job, make an empty job for the final block if no data
+    tb_filter_zip_job_t* job = parallel->fill;
+    if (!job) job = tb_filter_zip_parallel_job_init(parallel);
+    tb_assert_and_check_return_val(job, tb_false);
+    parallel->fill = tb_null;
+
+    // update the window for the next block
+    tb_byte_t const*    data = job->data + job->dict_size;
+    tb_size_t           size = job->size;
+    if (size >= TB_FILTER_ZIP_PARALLEL_DICT)
+    {
+        tb_memcpy(parallel->window, data + size - TB_FILTER_ZIP_PARALLEL_DICT, TB_FILTER_ZIP_PARALLEL_DICT);
+        parallel->window_size = TB_FILTER_ZIP_PARALLEL_DICT;
+    }
+    else if (size)
+    {
+        tb_size_t keep = tb_min(parallel->window_size, TB_FILTER_ZIP_PARALLEL_DICT - size);
+        if (keep < parallel->window_size) tb_memmov(parallel->window, parallel->window + parallel->window_size - keep, keep);
+        tb_memcpy(parallel->window + keep, data, size);
+        parallel->window_size = keep + size;
+    }
+
+    // append it to the job queue
+    job->blast = blast? 1 : 0;
+    if (parallel->tail) parallel->tail->next = job;
+    else parallel->head = job;
+    parallel->tail = job;
+    parallel->busy++;
+
+    // the last block has been posted?
+    if (blast) parallel->blast = 1;
+
+    // post it
+    return tb_thread_pool_task_post(parallel->pool, "zip", tb_filter_zip_parallel_job_done, tb_null, job, tb_false);
+}
+static tb_void_t tb_filter_zip_parallel_wait(tb_filter_zip_parallel_t* parallel, tb_filter_zip_job_t* job)
+{
+    // wait it, the semaphore may be posted by other jobs, so check the done flag again
+    while (!tb_atomic_get(&job->done)) 
+    {
+        if (tb_semaphore_wait(parallel->semaphore, -1) < 0) break;
+    }
+}
+static tb_long_t tb_filter_zip_parallel_output(tb_filter_zip_parallel_t* parallel, tb_static_stream_ref_t ostream, tb_bool_t bwait)
+{
+    // the output stream
+    tb_byte_t*  op = ostream->p;
+    tb_byte_t*  oe = ostream->e;
+    tb_assert_and_check_return_val(op && op <= oe, -1);
+
+    // output the pending header or trailer
+    if (parallel->extra_pos < parallel->extra_size)
+    {
+        tb_size_t size = tb_min(parallel->extra_size - parallel->extra_pos, (tb_size_t)(oe - op));
+        tb_memcpy(op, parallel->extra + parallel->extra_pos, size);
+        parallel->extra_pos += size;
+        op += size;
+
+        // not finished?
+        if (parallel->extra_pos < parallel->extra_size) 
+        {
+            ostream->p = op;
+            return size;
+        }
+    }
+
+    // output the done jobs in order
+    tb_filter_zip_job_t* job = tb_null;
+    while (op < oe && (job = parallel->head))
+    {
+        // wait it if be not done?
+        if (!tb_atomic_get(&job->done))
+        {
+            if (!bwait) break;
+            tb_filter_zip_parallel_wait(parallel, job);
+        }
+        tb_assertf_and_check_return_val(!job->bfailed, -1, "deflate block failed!");
+
+        // output it
+        tb_size_t size = tb_min(job->zsize - job->zpos, (tb_size_t)(oe - op));
+        tb_memcpy(op, job->zdata + job->zpos, size);
+        job->zpos += size;
+        op += size;
+
+        // not finished?
+        if (job->zpos < job->zsize) break;
+
+        // combine the check
+        if (parallel->bgzip) parallel->check = (tb_uint32_t)crc32_combine(parallel->check, job->check, (z_off_t)job->size);
+        else parallel->check = (tb_uint32_t)adler32_combine(parallel->check, job->check, (z_off_t)job->size);
+        parallel->total += job->size;
+
+        // remove it from the job queue 
+        parallel->head = job->next;
+        if (!parallel->head) parallel->tail = tb_null;
+        parallel->busy--;
+
+        // the last block? make the trailer
+        if (job->blast)
+        {
+            tb_byte_t* p = parallel->extra;
+            if (parallel->bgzip)
+            {
+                tb_bits_set_u32_le(p, parallel->check); 
+                tb_bits_set_u32_le(p + 4, (tb_uint32_t)parallel->total);
+                parallel->extra_size = 8;
+            }
+            else
+            {
+                tb_bits_set_u32_be(p, parallel->check); 
+                parallel->extra_size = 4;
+            }
+            parallel->extra_pos = tb_min(parallel->extra_size, (tb_size_t)(oe - op));
+            tb_memcpy(op, parallel->extra, parallel->extra_pos);
+            op += parallel->extra_pos;
+            parallel->bend = 1;
+        }
+
+        // free it
+        job->next = parallel->free;
+        parallel->free = job;
+    }
+
+    // update the output stream
+    tb_long_t real = op - ostream->p;
+    ostream->p = op;
+    return real;
+}
+static tb_long_t tb_filter_zip_parallel_spak(tb_filter_zip_parallel_t* parallel, tb_static_stream_ref_t istream, tb_static_stream_ref_t ostream, tb_long_t sync)
+{
+    // the output position
+    tb_byte_t* op = ostream->p;
+
+    // output the done jobs first
+    if (tb_filter_zip_parallel_output(parallel, ostream, tb_false) < 0) return -1;
+
+    // fill the input data to the blocks
+    tb_byte_t const*    ip = istream->p;
+    tb_byte_t const*    ie = istream->e;
+    while (ip && ip < ie && !parallel->blast)
+    {
+        // too many busy jobs? wait the oldest job and output it 
+        if (parallel->busy >= parallel->busy_maxn)
+        {
+            if (ostream->p < ostream->e && tb_filter_zip_parallel_output(parallel, ostream, tb_true) < 0) return -1;
+
+            // the output stream is full? keep the left input data in the cache of the filter
+            if (parallel->busy >= parallel->busy_maxn) break;
+        }
+
+        // the filling job
+        if (!parallel->fill) parallel->fill = tb_filter_zip_parallel_job_init(parallel);
+        tb_filter_zip_job_t* job = parallel->fill;
+        tb_assert_and_check_return_val(job, -1);
+
+        // fill it
+        tb_size_t size = tb_min((tb_size_t)(ie - ip), TB_FILTER_ZIP_PARALLEL_BLOCK - job->size);
+        tb_memcpy(job->data + job->dict_size + job->size, ip, size);
+        job->size += size;
+        ip += size;
+
+        // full? post it
+        if (job->size == TB_FILTER_ZIP_PARALLEL_BLOCK && !tb_filter_zip_parallel_post(parallel, tb_false)) return -1;
+    }
+    istream->p = (tb_byte_t*)ip;
+
+    // sync it? 
+    if (sync && (!ip || ip == ie))
+    {
+        // post the last block if end, or post the filling block if flush
+        if (sync < 0 && !parallel->blast) 
+        {
+            if (!tb_filter_zip_parallel_post(parallel, tb_true)) return -1;
+        }
+        else if (sync > 0 && parallel->fill && parallel->fill->size) 
+        {
+            if (!tb_filter_zip_parallel_post(parallel, tb_false)) return -1;
+        }
+
+        // wait and output all jobs
+        if (tb_filter_zip_parallel_output(parallel, ostream, tb_true) < 0) return -1;
+    }
+
+    // end?
+    tb_long_t real = ostream->p - op;
+    return (!real && parallel->bend && parallel->extra_pos == parallel->extra_size)? -1 : real;
+}
+static tb_void_t tb_filter_zip_parallel_exit(tb_filter_zip_parallel_t* parallel)
+{
+    // check
+    tb_assert_and_check_return(parallel);
+
+    // wait all busy jobs
+    tb_filter_zip_job_t* job = parallel->head;
+    while (job)
+    {
+        tb_filter_zip_job_t* next = job->next;
+        tb_filter_zip_parallel_wait(parallel, job);
+        tb_filter_zip_parallel_job_exit(job);
+        job = next;
+    }
+
+    // exit the free jobs
+    job = parallel->free;
+    while (job)
+    {
+        tb_filter_zip_job_t* next = job->next;
+        tb_filter_zip_parallel_job_exit(job);
+        job = next;
+    }
+
+    // exit the filling job
+    tb_filter_zip_parallel_job_exit(parallel->fill);
+
+    // exit the thread pool
+    if (parallel->pool) tb_thread_pool_exit(parallel->pool);
+
+    // exit semaphore
+    if (parallel->semaphore) tb_semaphore_exit(parallel->semaphore);
+
+    // exit it
+    tb_free(parallel);
+}
+static tb_filter_zip_parallel_t* tb_filter_zip_parallel_init(tb_size_t algo, tb_size_t workers)
+{
+    // done
+    tb_bool_t                   ok = tb_false;
+    tb_filter_zip_parallel_t*   parallel = tb_null;
+    do
+    {
+        // make it
+        parallel = tb_malloc0_type(tb_filter_zip_parallel_t);
+        tb_assert_and_check_break(parallel);
+
+        // init semaphore
+        parallel->semaphore = tb_semaphore_init(0);
+        tb_assert_and_check_break(parallel->semaphore);
+
+        // init thread pool
+        parallel->pool = tb_thread_pool_init(workers, 0);
+        tb_assert_and_check_break(parallel->pool);
+
+        // keep two blocks for every worker, one is deflating and another is waiting
+        parallel->busy_maxn = workers << 1;
+        parallel->bgzip     = algo == TB_ZIP_ALGO_GZIP? 1 : 0;
+
+        // init the header and the initial check
+        tb_byte_t* p = parallel->extra;
+        if (parallel->bgzip)
+        {
+            // the gzip header: magic, deflate, no flags, no mtime, no extra flags, unix
+            p[0] = 0x1f; p[1] = 0x8b; p[2] = 8; p[3] = 0;
+            p[4] = 0; p[5] = 0; p[6] = 0; p[7] = 0;
+            p[8] = 0; p[9] = 3;
+            parallel->extra_size = 10;
+            parallel->check = (tb_uint32_t)crc32(0, Z_NULL, 0);
+        }
+        else
+        {
+            // the zlib header: 32K window, deflate, default level
+            p[0] = 0x78; p[1] = 0x9c;
+            parallel->extra_size = 2;
+            parallel->check = (tb_uint32_t)adler32(0, Z_NULL, 0);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (parallel) tb_filter_zip_parallel_exit(parallel);
+        parallel = tb_null;
+    }
+
+    // ok?
+    return parallel;
+}
+#endif
 static tb_bool_t tb_filter_zip_open(tb_filter_t* filter)
 {
     // check
     tb_filter_zip_t* zfilter = tb_filter_zip_cast(filter);
     tb_assert_and_check_return_val(zfilter && !zfilter->zip, tb_false);
 
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    /* init the parallel deflate for gzip and zlib 
+     *
+     * the inflate cannot be parallelized, so we use the serial zip for it
+     */
+    tb_assert_and_check_return_val(!zfilter->parallel, tb_false);
+    if (    zfilter->workers 
+        &&  zfilter->action == TB_ZIP_ACTION_DEFLATE
+        &&  (   zfilter->algo == TB_ZIP_ALGO_GZIP
+            ||  zfilter->algo == TB_ZIP_ALGO_ZLIB
+            ||  zfilter->algo == TB_ZIP_ALGO_ZLIBRAW))
+    {
+        // init parallel
+        zfilter->parallel = tb_filter_zip_parallel_init(zfilter->algo, zfilter->workers);
+        tb_assert_and_check_return_val(zfilter->parallel, tb_false);
+
+        // ok
+        return tb_true;
+    }
+#endif
+
     // init zip
     zfilter->zip = tb_zip_init(zfilter->algo, zfilter->action);
     tb_assert_and_check_return_val(zfilter->zip, tb_false);
@@ -81,14 +661,26 @@ static tb_void_t tb_filter_zip_clos(tb_filter_t* filter)
     // exit zip
     if (zfilter->zip) tb_zip_exit(zfilter->zip);
     zfilter->zip = tb_null;
+
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // exit parallel
+    if (zfilter->parallel) tb_filter_zip_parallel_exit(zfilter->parallel);
+    zfilter->parallel = tb_null;
+#endif
 }
 static tb_long_t tb_filter_zip_spak(tb_filter_t* filter, tb_static_stream_ref_t istream, tb_static_stream_ref_t ostream, tb_long_t sync)
 {
     // check
     tb_filter_zip_t* zfilter = tb_filter_zip_cast(filter);
-    tb_assert_and_check_return_val(zfilter && zfilter->zip && istream && ostream, -1);
+    tb_assert_and_check_return_val(zfilter && istream && ostream, -1);
+
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // spak it in parallel
+    if (zfilter->parallel) return tb_filter_zip_parallel_spak(zfilter->parallel, istream, ostream, sync);
+#endif
 
     // spak it
+    tb_assert_and_check_return_val(zfilter->zip, -1);
     return tb_zip_spak(zfilter->zip, istream, ostream, sync);
 }
 static tb_void_t tb_filter_zip_exit(tb_filter_t* filter)
@@ -100,6 +692,12 @@ static tb_void_t tb_filter_zip_exit(tb_filter_t* filter)
     // exit zip
     if (zfilter->zip) tb_zip_exit(zfilter->zip);
     zfilter->zip = tb_null;
+
+#ifdef TB_CONFIG_PACKAGE_HAVE_ZLIB
+    // exit parallel
+    if (zfilter->parallel) tb_filter_zip_parallel_exit(zfilter->parallel);
+    zfilter->parallel = tb_null;
+#endif
 }
 static tb_bool_t tb_filter_zip_ctrl(tb_filter_t* filter, tb_size_t ctrl, tb_va_list_t args)
 {
@@ -160,6 +758,10 @@ static tb_bool_t tb_filter_zip_ctrl(tb_filter_t* filter, tb_size_t ctrl, tb_va_l
  * interfaces
  */
 tb_filter_ref_t tb_filter_init_from_zip(tb_size_t algo, tb_size_t action)
+{
+    return tb_filter_init_from_zip_parallel(algo, action, 1);
+}
+tb_filter_ref_t tb_filter_init_from_zip_parallel(tb_size_t algo, tb_size_t action, tb_size_t workers)
 {
     // done
     tb_bool_t               ok = tb_false;
@@ -179,6 +781,10 @@ tb_filter_ref_t tb_filter_init_from_zip(tb_size_t algo, tb_size_t action)
         filter->base.ctrl   = tb_filter_zip_ctrl;
         filter->algo        = algo;
         filter->action      = action;
+        filter->workers     = workers? workers : tb_processor_count();
+
+        // only one worker? using the serial zip
+        if (filter->workers < 2) filter->workers = 0;
 
         // ok
         ok = tb_true;
@@ -113,6 +113,14 @@ typedef struct __tb_stream_t
     // kill
     tb_void_t           (*kill)(tb_stream_ref_t stream);
 
+    /* peek the data at the current offset directly without copying, optional
+     *
+     * only probe whether the stream can be peeked now if data is null
+     *
+     * @return          the real size (maybe less than the given size at the end), -1 if not supported now
+     */
+    tb_long_t           (*peek)(tb_stream_ref_t stream, tb_byte_t const** data, tb_size_t size);
+
 }tb_stream_t;
 
 
@@ -27,6 +27,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../stream.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
@@ -160,15 +161,36 @@ static tb_bool_t tb_stream_data_seek(tb_stream_ref_t stream, tb_hize_t offset)
     // ok
     return tb_true;
 }
+static tb_long_t tb_stream_data_peek(tb_stream_ref_t stream, tb_byte_t const** data, tb_size_t size)
+{
+    // check
+    tb_stream_data_t* stream_data = tb_stream_data_cast(stream);
+    tb_assert_and_check_return_val(stream_data && stream_data->data && stream_data->head, -1);
+
+    // only probe it?
+    tb_check_return_val(data, 0);
+
+    // the left
+    tb_size_t left = stream_data->data + stream_data->size - stream_data->head;
+
+    // the need
+    if (size > left) size = left;
+
+    // peek data
+    *data = stream_data->head;
+
+    // ok?
+    return (tb_long_t)(size);
+}
 static tb_long_t tb_stream_data_wait(tb_stream_ref_t stream, tb_size_t wait, tb_long_t timeout)
 {
     // check
     tb_stream_data_t* stream_data = tb_stream_data_cast(stream);
     tb_assert_and_check_return_val(stream_data && stream_data->head <= stream_data->data + stream_data->size, -1);
 
-    // wait 
+    // wait, the cached data of the stream has been read from here, so we only check the left data
     tb_long_t events = 0;
-    if (!tb_stream_beof((tb_stream_ref_t)stream))
+    if (stream_data->head < stream_data->data + stream_data->size)
     {
         if (wait & TB_STREAM_WAIT_READ) events |= TB_STREAM_WAIT_READ;
         if (wait & TB_STREAM_WAIT_WRIT) events |= TB_STREAM_WAIT_WRIT;
@@ -261,19 +283,27 @@ static tb_bool_t tb_stream_data_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
  */
 tb_stream_ref_t tb_stream_init_data()
 {
-    return tb_stream_init(  TB_STREAM_TYPE_DATA
-                        ,   sizeof(tb_stream_data_t)
-                        ,   0
-                        ,   tb_stream_data_open
-                        ,   tb_stream_data_clos
-                        ,   tb_stream_data_exit
-                        ,   tb_stream_data_ctrl
-                        ,   tb_stream_data_wait
-                        ,   tb_stream_data_read
-                        ,   tb_stream_data_writ
-                        ,   tb_stream_data_seek
-                        ,   tb_null
-                        ,   tb_null);
+    // init stream
+    tb_stream_ref_t stream = tb_stream_init(    TB_STREAM_TYPE_DATA
+                                            ,   sizeof(tb_stream_data_t)
+                                            ,   0
+                                            ,   tb_stream_data_open
+                                            ,   tb_stream_data_clos
+                                            ,   tb_stream_data_exit
+                                            ,   tb_stream_data_ctrl
+                                            ,   tb_stream_data_wait
+                                            ,   tb_stream_data_read
+                                            ,   tb_stream_data_writ
+                                            ,   tb_stream_data_seek
+                                            ,   tb_null
+                                            ,   tb_null);
+    tb_assert_and_check_return_val(stream, tb_null);
+
+    // init the peek function, the data can be accessed directly
+    tb_stream_cast(stream)->peek = tb_stream_data_peek;
+
+    // ok
+    return stream;
 }
 tb_stream_ref_t tb_stream_init_from_data(tb_byte_t const* data, tb_size_t size)
 {
@@ -27,6 +27,7 @@
  * includes
  */
 #include "prefix.h"
+#include "../stream.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -35,6 +36,16 @@
 // the file cache maxn
 #define TB_STREAM_FILE_CACHE_MAXN             TB_FILE_DIRECT_CSIZE
 
+// the mapped window maxn
+#if TB_CPU_BIT64
+#   define TB_STREAM_FILE_MMAP_MAXN           (1 << 30)
+#else
+#   define TB_STREAM_FILE_MMAP_MAXN           (1 << 25)
+#endif
+
+// the mapped window align
+#define TB_STREAM_FILE_MMAP_ALIGN             (1 << 16)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -54,6 +65,24 @@ typedef struct __tb_stream_file_t
     // is stream file?
     tb_bool_t           bstream;
 
+    // enable to map the file?
+    tb_bool_t           bmmap;
+
+    // the mapped data of the current window, it is the mapping mode if it is not null
+    tb_byte_t const*    map_data;
+
+    // the mapped size of the current window
+    tb_size_t           map_size;
+
+    // the file offset of the current window
+    tb_hize_t           map_offset;
+
+    // the file offset for the mapping mode
+    tb_hize_t           offset;
+
+    // the file size for the mapping mode
+    tb_hize_t           size;
+
 }tb_stream_file_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -67,6 +96,44 @@ static __tb_inline__ tb_stream_file_t* tb_stream_file_cast(tb_stream_ref_t strea
     // ok?
     return (tb_stream_file_t*)stream;
 }
+static tb_bool_t tb_stream_file_mmap(tb_stream_file_t* stream_file, tb_hize_t offset)
+{
+    // check
+    tb_assert_and_check_return_val(stream_file && stream_file->file && offset < stream_file->size, tb_false);
+
+    // unmap the previous window
+    if (stream_file->map_data) tb_file_munmap(stream_file->map_data, stream_file->map_size);
+    stream_file->map_data = tb_null;
+    stream_file->map_size = 0;
+
+    // the new window
+    tb_hize_t base = offset & ~((tb_hize_t)TB_STREAM_FILE_MMAP_ALIGN - 1);
+    tb_size_t size = (tb_size_t)tb_min(stream_file->size - base, TB_STREAM_FILE_MMAP_MAXN);
+
+    // map it
+    stream_file->map_data = tb_file_mmap(stream_file->file, base, size, TB_FILE_ADVICE_SEQUENTIAL);
+    tb_check_return_val(stream_file->map_data, tb_false);
+
+    // save the window
+    stream_file->map_size   = size;
+    stream_file->map_offset = base;
+
+    // ok
+    return tb_true;
+}
+static tb_void_t tb_stream_file_munmap(tb_stream_file_t* stream_file)
+{
+    // check
+    tb_assert_and_check_return(stream_file);
+
+    // unmap it
+    if (stream_file->map_data) tb_file_munmap(stream_file->map_data, stream_file->map_size);
+    stream_file->map_data   = tb_null;
+    stream_file->map_size   = 0;
+    stream_file->map_offset = 0;
+    stream_file->offset     = 0;
+    stream_file->size       = 0;
+}
 static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
 {
     // check
@@ -91,6 +158,14 @@ static tb_bool_t tb_stream_file_open(tb_stream_ref_t stream)
         return tb_false;
     }
 
+    // map the read-only and seekable file? we will use the buffered mode if failed
+    if (stream_file->bmmap && !stream_file->bstream && !(stream_file->mode & (TB_FILE_MODE_WO | TB_FILE_MODE_RW)))
+    {
+        stream_file->size = tb_file_size(stream_file->file);
+        if (stream_file->size && !tb_stream_file_mmap(stream_file, 0))
+            stream_file->size = 0;
+    }
+
     // ok
     return tb_true;
 }
@@ -100,6 +175,9 @@ static tb_bool_t tb_stream_file_clos(tb_stream_ref_t stream)
     tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
     tb_assert_and_check_return_val(stream_file, tb_false);
 
+    // unmap file
+    tb_stream_file_munmap(stream_file);
+
     // exit file
     if (stream_file->file && !tb_file_exit(stream_file->file)) return tb_false;
     stream_file->file = tb_null;
@@ -117,6 +195,29 @@ static tb_long_t tb_stream_file_read(tb_stream_ref_t stream, tb_byte_t* data, tb
     tb_check_return_val(data, -1);
     tb_check_return_val(size, 0);
 
+    // read it from the mapped window
+    if (stream_file->map_data)
+    {
+        // end?
+        tb_check_return_val(stream_file->offset < stream_file->size, 0);
+
+        // not in the current window? map the next window
+        if (stream_file->offset < stream_file->map_offset || stream_file->offset >= stream_file->map_offset + stream_file->map_size)
+        {
+            if (!tb_stream_file_mmap(stream_file, stream_file->offset)) return -1;
+        }
+
+        // copy it
+        tb_size_t skip = (tb_size_t)(stream_file->offset - stream_file->map_offset);
+        size = tb_min(size, stream_file->map_size - skip);
+        tb_memcpy_(data, stream_file->map_data + skip, size);
+        stream_file->offset += size;
+        stream_file->read = size;
+
+        // ok
+        return size;
+    }
+
     // read 
     stream_file->read = tb_file_read(stream_file->file, data, size);
 
@@ -159,9 +260,47 @@ static tb_bool_t tb_stream_file_seek(tb_stream_ref_t stream, tb_hize_t offset)
     // is stream file?
     tb_check_return_val(!stream_file->bstream, tb_false);
 
+    // seek it in the mapping mode
+    if (stream_file->map_data)
+    {
+        tb_check_return_val(offset <= stream_file->size, tb_false);
+        stream_file->offset = offset;
+        return tb_true;
+    }
+
     // seek
     return (tb_file_seek(stream_file->file, offset, TB_FILE_SEEK_BEG) == offset)? tb_true : tb_false;
 }
+static tb_long_t tb_stream_file_peek(tb_stream_ref_t stream, tb_byte_t const** data, tb_size_t size)
+{
+    // check
+    tb_stream_file_t* stream_file = tb_stream_file_cast(stream);
+    tb_assert_and_check_return_val(stream_file, -1);
+
+    // not the mapping mode? 
+    tb_check_return_val(stream_file->map_data, -1);
+
+    // only probe it?
+    tb_check_return_val(data, 0);
+
+    // the left size
+    size = (tb_size_t)tb_min(size, stream_file->size - stream_file->offset);
+    tb_check_return_val(size, 0);
+
+    // not in the current window? map the new window from the current offset
+    if (    stream_file->offset < stream_file->map_offset
+        ||  stream_file->offset + size > stream_file->map_offset + stream_file->map_size)
+    {
+        if (!tb_stream_file_mmap(stream_file, stream_file->offset)) return -1;
+
+        // too large?
+        tb_check_return_val(stream_file->offset + size <= stream_file->map_offset + stream_file->map_size, -1);
+    }
+
+    // ok
+    *data = stream_file->map_data + (tb_size_t)(stream_file->offset - stream_file->map_offset);
+    return size;
+}
 static tb_long_t tb_stream_file_wait(tb_stream_ref_t stream, tb_size_t wait, tb_long_t timeout)
 {
     // check
@@ -179,6 +318,9 @@ static tb_long_t tb_stream_file_wait(tb_stream_ref_t stream, tb_size_t wait, tb_
     // end?
     if (stream_file->bstream && events > 0 && !stream_file->read) events = -1;
 
+    // end for the mapping mode?
+    if (stream_file->map_data && events > 0 && stream_file->offset >= stream_file->size) events = -1;
+
     // ok?
     return events;
 }
@@ -229,6 +371,26 @@ static tb_bool_t tb_stream_file_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             // is stream
             stream_file->bstream = (tb_bool_t)tb_va_arg(args, tb_bool_t);
 
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_SET_MMAP:
+        {
+            // enable to map file
+            stream_file->bmmap = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+
+            // ok
+            return tb_true;
+        }
+    case TB_STREAM_CTRL_FILE_GET_MMAP:
+        {
+            // the pmmap
+            tb_bool_t* pmmap = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(pmmap, tb_false);
+
+            // is the mapping mode now?
+            *pmmap = stream_file->map_data? tb_true : tb_false;
+
             // ok
             return tb_true;
         }
@@ -266,9 +428,13 @@ tb_stream_ref_t tb_stream_init_file()
         // init it
         stream_file->mode      = TB_FILE_MODE_RO;
         stream_file->bstream   = tb_false;
+        stream_file->bmmap     = tb_false;
         stream_file->read      = 0;
     }
 
+    // init the peek function for the mapping mode
+    tb_stream_cast(stream)->peek = tb_stream_file_peek;
+
     // ok?
     return (tb_stream_ref_t)stream;
 }
@@ -187,8 +187,12 @@ static tb_long_t tb_stream_filter_read(tb_stream_ref_t stream, tb_byte_t* data,
         // spak data
         tb_byte_t const* odata = tb_null;
         if (real) real = tb_filter_spak(stream_filter->filter, data, real < 0? 0 : real, &odata, size, stream_filter->beof? -1 : 0);
-        // no data? try to sync it
-        if (!real) real = tb_filter_spak(stream_filter->filter, tb_null, 0, &odata, size, stream_filter->beof? -1 : 1);
+        /* no data? try to sync it
+         *
+         * only sync it if the input stream has no more data now, 
+         * otherwise the block filter (e.g. lz4) will be flushed too frequently
+         */
+        if (!real && stream_filter->last <= 0) real = tb_filter_spak(stream_filter->filter, tb_null, 0, &odata, size, stream_filter->beof? -1 : 1);
 
         // has data? save it
         if (real > 0 && odata) tb_memcpy(data, odata, real);
@@ -216,14 +220,17 @@ static tb_long_t tb_stream_filter_writ(tb_stream_ref_t stream, tb_byte_t const*
         tb_assert_and_check_return_val(stream_filter->mode == -1, -1);
 
         // spak data
-        tb_long_t real = tb_filter_spak(stream_filter->filter, data, size, &data, size, 0);
+        tb_byte_t const*    odata = tb_null;
+        tb_long_t           real = tb_filter_spak(stream_filter->filter, data, size, &odata, size, 0);
         tb_assert_and_check_return_val(real >= 0, -1);
 
-        // no data?
-        tb_check_return_val(real, 0);
-
-        // save size
-        size = real;
+        /* writ the output data
+         *
+         * @note the input data has been spaked or cached by the filter, 
+         * so we need return the input size even if no output data now
+         */
+        if (real && odata && !tb_stream_bwrit(stream_filter->stream, odata, real)) return -1;
+        return size;
     }
 
     // writ 
@@ -424,6 +431,10 @@ tb_stream_ref_t tb_stream_init_filter_from_null(tb_stream_ref_t stream)
 }
 #ifdef TB_CONFIG_MODULE_HAVE_ZIP
 tb_stream_ref_t tb_stream_init_filter_from_zip(tb_stream_ref_t stream, tb_size_t algo, tb_size_t action)
+{
+    return tb_stream_init_filter_from_zip_parallel(stream, algo, action, 1);
+}
+tb_stream_ref_t tb_stream_init_filter_from_zip_parallel(tb_stream_ref_t stream, tb_size_t algo, tb_size_t action, tb_size_t workers)
 {
     // check
     tb_assert_and_check_return_val(stream, tb_null);
@@ -442,7 +453,7 @@ tb_stream_ref_t tb_stream_init_filter_from_zip(tb_stream_ref_t stream, tb_size_t
 
         // set filter
         ((tb_stream_filter_t*)stream_filter)->bref = tb_false;
-        ((tb_stream_filter_t*)stream_filter)->filter = tb_filter_init_from_zip(algo, action);
+        ((tb_stream_filter_t*)stream_filter)->filter = tb_filter_init_from_zip_parallel(algo, action, workers);
         tb_assert_and_check_break(((tb_stream_filter_t*)stream_filter)->filter);
  
         // ok
@@ -488,6 +488,25 @@ static tb_bool_t tb_stream_http_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_GET_POST_LRATE, plrate);
         }
         break;
+    case TB_STREAM_CTRL_HTTP_SET_KEEP_ALIVE:
+        {
+            // balived
+            tb_bool_t balived = (tb_bool_t)tb_va_arg(args, tb_bool_t);
+
+            // set balived
+            return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_SET_KEEP_ALIVE, balived);
+        }
+        break;
+    case TB_STREAM_CTRL_HTTP_GET_KEEP_ALIVE:
+        {
+            // pbalived
+            tb_bool_t* pbalived = (tb_bool_t*)tb_va_arg(args, tb_bool_t*);
+            tb_assert_and_check_return_val(pbalived, tb_false);
+
+            // get balived
+            return tb_http_ctrl(stream_http->http, TB_HTTP_OPTION_GET_KEEP_ALIVE, pbalived);
+        }
+        break;
     case TB_STREAM_CTRL_HTTP_SET_AUTO_UNZIP:
         {
             // bunzip
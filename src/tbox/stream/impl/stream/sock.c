@@ -33,6 +33,12 @@
  * includes
  */
 #include "prefix.h"
+#if defined(TB_CONFIG_MODULE_HAVE_COROUTINE) \
+        && !defined(TB_CONFIG_MICRO_ENABLE)
+#   include "../../../coroutine/coroutine.h"
+#   include "../../../coroutine/impl/impl.h"
+#   define TB_STREAM_SOCK_HAVE_COROUTINE
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -58,6 +64,9 @@ typedef struct __tb_stream_sock_t
 #ifdef TB_SSL_ENABLE
     // the ssl 
     tb_ssl_ref_t            hssl;
+
+    // the ssl session for resuming it on the next connection
+    tb_ssl_session_ref_t    session;
 #endif
 
     // the sock type
@@ -91,6 +100,22 @@ static __tb_inline__ tb_stream_sock_t* tb_stream_sock_cast(tb_stream_ref_t strea
     // ok?
     return (tb_stream_sock_t*)stream;
 }
+static tb_bool_t tb_stream_sock_alived(tb_stream_sock_t* stream_sock, tb_url_ref_t url)
+{
+    // check
+    tb_assert_and_check_return_val(stream_sock && stream_sock->sock && url, tb_false);
+
+#ifdef TB_SSL_ENABLE
+    // the ssl connection has been closed?
+    if (tb_url_ssl(url) && !stream_sock->hssl) return tb_false;
+#endif
+
+    /* the idle connection has been closed by peer or has some unexpected data?
+     *
+     * it will be readable if the peer has sent fin, rst or the unread data
+     */
+    return !tb_socket_wait(stream_sock->sock, TB_SOCKET_EVENT_RECV, 0)? tb_true : tb_false;
+}
 static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
 {
     // check
@@ -120,6 +145,30 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
     }
 #endif
 
+    // keep-alive and the tcp connection is still alived? reuse it directly
+    if (stream_sock->balived && stream_sock->sock && stream_sock->type == TB_SOCKET_TYPE_TCP)
+    {
+        if (tb_stream_sock_alived(stream_sock, url))
+        {
+            // trace
+            tb_trace_d("sock(%p): reuse: %s", stream_sock->sock, tb_url_host(url));
+
+            // ok
+            tb_stream_state_set(stream, TB_STATE_OK);
+            return tb_true;
+        }
+
+#ifdef TB_SSL_ENABLE
+        // exit the broken ssl
+        if (stream_sock->hssl) tb_ssl_exit(stream_sock->hssl);
+        stream_sock->hssl = tb_null;
+#endif
+
+        // exit the broken connection and reconnect it
+        if (!tb_socket_exit(stream_sock->sock)) return tb_false;
+        stream_sock->sock = tb_null;
+    }
+
     // get address from the url
     tb_ipaddr_ref_t addr = tb_url_addr(url);
     tb_assert_and_check_return_val(addr, tb_false);
@@ -214,6 +263,14 @@ static tb_bool_t tb_stream_sock_open(tb_stream_ref_t stream)
                         if (!stream_sock->hssl) stream_sock->hssl = tb_ssl_init(tb_false);
                         tb_assert_and_check_break(stream_sock->hssl);
 
+                        // resume the ssl session of the last connection, it will be used only once
+                        if (stream_sock->session)
+                        {
+                            tb_ssl_session_set(stream_sock->hssl, stream_sock->session);
+                            tb_ssl_session_exit(stream_sock->session);
+                            stream_sock->session = tb_null;
+                        }
+
                         // init bio
                         tb_ssl_set_bio_sock(stream_sock->hssl, stream_sock->sock);
 
@@ -288,15 +345,30 @@ static tb_bool_t tb_stream_sock_clos(tb_stream_ref_t stream)
     tb_stream_sock_t* stream_sock = tb_stream_sock_cast(stream);
     tb_assert_and_check_return_val(stream_sock, tb_false);
 
+    // keep alive? not close the socket and ssl
+    if (stream_sock->balived)
+    {
+#ifdef TB_STREAM_SOCK_HAVE_COROUTINE
+        // the kept-alive socket may be reused by other coroutines or threads, cancel it from the poller of this coroutine
+        tb_co_scheduler_io_ref_t scheduler_io = tb_null;
+        if (stream_sock->sock && (scheduler_io = tb_co_scheduler_io_self()))
+            tb_co_scheduler_io_cancel(scheduler_io, stream_sock->sock);
+#endif
+        return tb_true;
+    }
+
 #ifdef TB_SSL_ENABLE
     // close ssl
     if (tb_url_ssl(tb_stream_url(stream)) && stream_sock->hssl)
+    {
+        // save the session of this connection for resuming it on the next connection
+        if (!stream_sock->session) stream_sock->session = tb_ssl_session_get(stream_sock->hssl);
+
+        // close it
         tb_ssl_clos(stream_sock->hssl);
+    }
 #endif
 
-    // keep alive? not close it
-    tb_check_return_val(!stream_sock->balived, tb_true);
-
     // exit sock
     if (stream_sock->sock && !tb_socket_exit(stream_sock->sock)) return tb_false;
     stream_sock->sock = tb_null;
@@ -320,6 +392,10 @@ static tb_void_t tb_stream_sock_exit(tb_stream_ref_t stream)
     // exit ssl
     if (stream_sock->hssl) tb_ssl_exit(stream_sock->hssl);
     stream_sock->hssl = tb_null;
+
+    // exit ssl session
+    if (stream_sock->session) tb_ssl_session_exit(stream_sock->session);
+    stream_sock->session = tb_null;
 #endif
 
     // exit sock
@@ -593,6 +669,45 @@ static tb_bool_t tb_stream_sock_ctrl(tb_stream_ref_t stream, tb_size_t ctrl, tb_
             stream_sock->balived = balived? 1 : 0;
             return tb_true;
         }
+    case TB_STREAM_CTRL_SOCK_GET_SSL_SESSION:
+        {
+            // the psession
+            tb_pointer_t* psession = (tb_pointer_t*)tb_va_arg(args, tb_pointer_t*);
+            tb_assert_and_check_return_val(psession, tb_false);
+
+#ifdef TB_SSL_ENABLE
+            // take the saved session of the last connection first
+            if (stream_sock->session) 
+            {
+                *psession = (tb_pointer_t)stream_sock->session;
+                stream_sock->session = tb_null;
+            }
+            // get a new session from the kept-alive ssl connection
+            else *psession = stream_sock->hssl? (tb_pointer_t)tb_ssl_session_get(stream_sock->hssl) : tb_null;
+            return *psession? tb_true : tb_false;
+#else
+            // not supported
+            *psession = tb_null;
+            return tb_false;
+#endif
+        }
+    case TB_STREAM_CTRL_SOCK_SET_SSL_SESSION:
+        {
+#ifdef TB_SSL_ENABLE
+            // the session, will be exited by the sock stream
+            tb_ssl_session_ref_t session = (tb_ssl_session_ref_t)tb_va_arg(args, tb_pointer_t);
+
+            // exit the previous session
+            if (stream_sock->session) tb_ssl_session_exit(stream_sock->session);
+
+            // save session and resume it on the next ssl connection
+            stream_sock->session = session;
+            return tb_true;
+#else
+            // not supported
+            return tb_false;
+#endif
+        }
     default:
         break;
     }
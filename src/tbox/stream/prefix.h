@@ -110,11 +110,15 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_FILE_GET_MODE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 1)
 ,   TB_STREAM_CTRL_FILE_SET_MODE            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 2)
 ,   TB_STREAM_CTRL_FILE_IS_STREAM           = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 3)
+,   TB_STREAM_CTRL_FILE_SET_MMAP            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 4)
+,   TB_STREAM_CTRL_FILE_GET_MMAP            = TB_STREAM_CTRL(TB_STREAM_TYPE_FILE, 5)
 
     // the stream for sock
 ,   TB_STREAM_CTRL_SOCK_GET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 1)
 ,   TB_STREAM_CTRL_SOCK_SET_TYPE            = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 2)
 ,   TB_STREAM_CTRL_SOCK_KEEP_ALIVE          = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 3)
+,   TB_STREAM_CTRL_SOCK_GET_SSL_SESSION     = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 4)
+,   TB_STREAM_CTRL_SOCK_SET_SSL_SESSION     = TB_STREAM_CTRL(TB_STREAM_TYPE_SOCK, 5)
 
     // the stream for http
 ,   TB_STREAM_CTRL_HTTP_GET_HEAD            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 1)
@@ -131,6 +135,7 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_HTTP_GET_POST_FUNC       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 12)
 ,   TB_STREAM_CTRL_HTTP_GET_POST_PRIV       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 13)
 ,   TB_STREAM_CTRL_HTTP_GET_POST_LRATE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 14)
+,   TB_STREAM_CTRL_HTTP_GET_KEEP_ALIVE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 15)
 
 ,   TB_STREAM_CTRL_HTTP_SET_HEAD            = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 20)
 ,   TB_STREAM_CTRL_HTTP_SET_RANGE           = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 21)
@@ -146,6 +151,7 @@ typedef enum __tb_stream_ctrl_e
 ,   TB_STREAM_CTRL_HTTP_SET_POST_FUNC       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 31)
 ,   TB_STREAM_CTRL_HTTP_SET_POST_PRIV       = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 32)
 ,   TB_STREAM_CTRL_HTTP_SET_POST_LRATE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 33)
+,   TB_STREAM_CTRL_HTTP_SET_KEEP_ALIVE      = TB_STREAM_CTRL(TB_STREAM_TYPE_HTTP, 34)
 
     // the stream for filter
 ,   TB_STREAM_CTRL_FLTR_GET_STREAM          = TB_STREAM_CTRL(TB_STREAM_TYPE_FLTR, 1)
@@ -682,6 +682,20 @@ tb_bool_t tb_stream_need(tb_stream_ref_t self, tb_byte_t** data, tb_size_t size)
     // check the cache mode, must be read cache
     tb_assert_and_check_return_val(!stream->bwrited, tb_false);
 
+    // no cached data? peek it from the stream directly, e.g. the mapped file
+    if (stream->peek && tb_queue_buffer_null(&stream->cache))
+    {
+        tb_byte_t const* peek = tb_null;
+        if (stream->peek(self, &peek, size) == (tb_long_t)size && peek)
+        {
+            // save data
+            *data = (tb_byte_t*)peek;
+
+            // ok
+            return tb_true;
+        }
+    }
+
     // not enough? grow the cache first
     if (tb_queue_buffer_maxn(&stream->cache) < size) tb_queue_buffer_resize(&stream->cache, size);
 
@@ -766,7 +780,14 @@ tb_long_t tb_stream_read(tb_stream_ref_t self, tb_byte_t* data, tb_size_t size)
     tb_long_t read = 0;
     do
     {
-        if (tb_queue_buffer_maxn(&stream->cache))
+        // no cached data and it can be peeked? read it directly, we need not copy it to the cache
+        if (stream->peek && !stream->bwrited && tb_queue_buffer_null(&stream->cache) && stream->peek(self, tb_null, 0) >= 0)
+        {
+            // read it directly
+            read = stream->read(self, data, size);
+            tb_check_return_val(read >= 0, -1);
+        }
+        else if (tb_queue_buffer_maxn(&stream->cache))
         {
             // switch to the read cache mode
             if (stream->bwrited && tb_queue_buffer_null(&stream->cache)) stream->bwrited = 0;
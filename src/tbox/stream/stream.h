@@ -373,6 +373,17 @@ tb_stream_ref_t         tb_stream_init_filter_from_null(tb_stream_ref_t stream);
  */
 tb_stream_ref_t         tb_stream_init_filter_from_zip(tb_stream_ref_t stream, tb_size_t algo, tb_size_t action);
 
+/*! init filter stream from zip with the parallel deflate
+ *
+ * @param stream        the stream
+ * @param algo          the zip algorithm
+ * @param action        the zip action
+ * @param workers       the worker count, using the processor count if be zero
+ *
+ * @return              the stream
+ */
+tb_stream_ref_t         tb_stream_init_filter_from_zip_parallel(tb_stream_ref_t stream, tb_size_t algo, tb_size_t action, tb_size_t workers);
+
 /*! init filter stream from cache
  *
  * @param stream        the stream
@@ -666,6 +677,8 @@ tb_bool_t               tb_stream_sync(tb_stream_ref_t stream, tb_bool_t bclosin
 
  * @endcode
  *
+ * @note the data maybe points to the mapped file directly (TB_STREAM_CTRL_FILE_SET_MMAP), do not modify it
+ *
  * @param stream        the stream
  * @param data          the data
  * @param size          the size
@@ -178,6 +178,9 @@ tb_bool_t tb_init_(tb_handle_t priv, tb_allocator_ref_t allocator, tb_size_t mod
     // init platform envirnoment
     if (!tb_platform_init_env(priv)) return tb_false;
 
+    // init the thread cache of memory after the thread local envirnoment
+    tb_memory_init_cache();
+
     // init libc envirnoment 
     if (!tb_libc_init_env()) return tb_false;
 
@@ -229,6 +232,11 @@ tb_void_t tb_exit()
     // exit libc envirnoment
     tb_libc_exit_env();
     
+    // exit the async trace, the flusher thread and event need the platform and memory envirnoment
+#ifndef TB_CONFIG_MICRO_ENABLE
+    tb_trace_async_exit();
+#endif
+
     // exit platform envirnoment
     tb_platform_exit_env();
     
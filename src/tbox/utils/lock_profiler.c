@@ -35,6 +35,8 @@
  */
 #include "lock_profiler.h"
 #include "singleton.h"
+#include "bits.h"
+#include "../libc/libc.h"
 #include "../platform/platform.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -48,22 +50,95 @@
 #   define TB_LOCK_PROFILER_MAXN            (512)
 #endif
 
+// the call site maxn
+#ifdef __tb_small__
+#   define TB_LOCK_PROFILER_SITE_MAXN       (128)
+#else
+#   define TB_LOCK_PROFILER_SITE_MAXN       (256)
+#endif
+
+// the probe maxn for the hash table
+#define TB_LOCK_PROFILER_PROBE_MAXN         (16)
+
+// the histogram maxn, [0] is < 1us and [i] is [2^(i - 1), 2^i) us
+#define TB_LOCK_PROFILER_HISTOGRAM_MAXN     (20)
+
+// the json line maxn
+#define TB_LOCK_PROFILER_JSON_LINE_MAXN     (512)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
 
+// the lock profiler time type
+typedef struct __tb_lock_profiler_time_t
+{
+    // the count
+    tb_atomic_t                     count;
+
+    // the total time (us)
+    tb_atomic_t                     total;
+
+    // the maximum time (us)
+    tb_atomic_t                     maxn;
+
+    // the log2 histogram
+    tb_atomic_t                     histogram[TB_LOCK_PROFILER_HISTOGRAM_MAXN];
+
+}tb_lock_profiler_time_t;
+
+// the lock profiler stat type
+typedef struct __tb_lock_profiler_stat_t
+{
+    // the acquired count
+    tb_atomic_t                     acquired;
+
+    // the occupied count
+    tb_atomic_t                     occupied;
+
+    // the wait time
+    tb_lock_profiler_time_t         wait;
+
+    // the hold time
+    tb_lock_profiler_time_t         hold;
+
+}tb_lock_profiler_stat_t;
+
+// the lock profiler site type
+typedef struct __tb_lock_profiler_site_t
+{
+    // the line, the site is unused if it is zero
+    tb_atomic_t                     line;
+
+    // the file name
+    tb_atomic_t                     file;
+
+    // the function name
+    tb_atomic_t                     func;
+
+    // the stat
+    tb_lock_profiler_stat_t         stat;
+
+}tb_lock_profiler_site_t;
+
 // the lock profiler item type
 typedef struct __tb_lock_profiler_item_t
 {
     // the lock address
     tb_atomic_t                     lock;
 
-    // the occupied count
-    tb_atomic_t                     size;
-
     // the lock name
     tb_atomic_t                     name;
 
+    // the acquired time (us), it is only accessed by the lock holder
+    tb_hong_t                       time;
+
+    // the acquired site, it is only accessed by the lock holder
+    tb_lock_profiler_site_t*        site;
+
+    // the stat
+    tb_lock_profiler_stat_t         stat;
+
 }tb_lock_profiler_item_t;
 
 // the lock profiler type
@@ -72,8 +147,35 @@ typedef struct __tb_lock_profiler_t
     // the list
     tb_lock_profiler_item_t         list[TB_LOCK_PROFILER_MAXN];
 
+    // the call sites
+    tb_lock_profiler_site_t         sites[TB_LOCK_PROFILER_SITE_MAXN];
+
 }tb_lock_profiler_t;
 
+// the lock profiler json writer type
+typedef struct __tb_lock_profiler_json_t
+{
+    // the file
+    tb_file_ref_t                   file;
+
+    // the buffer size
+    tb_size_t                       size;
+
+    // is failed?
+    tb_bool_t                       failed;
+
+    // the buffer
+    tb_char_t                       data[4096];
+
+}tb_lock_profiler_json_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+// the lock profiler has been exited? the memory allocators still use locks after exiting singletons
+static tb_atomic_t                  g_exited = 0;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * instance implementation
  */
@@ -83,6 +185,9 @@ static tb_handle_t tb_lock_profiler_instance_init(tb_cpointer_t* ppriv)
 }
 static tb_void_t tb_lock_profiler_instance_exit(tb_handle_t handle, tb_cpointer_t priv)
 {
+    // mark it as exited and do not re-create it
+    tb_atomic_set(&g_exited, 1);
+
     // dump it
     tb_lock_profiler_dump(handle);
 
@@ -90,11 +195,204 @@ static tb_void_t tb_lock_profiler_instance_exit(tb_handle_t handle, tb_cpointer_
     tb_lock_profiler_exit(handle);
 }
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_lock_profiler_item_t* tb_lock_profiler_item_find(tb_lock_profiler_t* profiler, tb_pointer_t lock, tb_bool_t bregister)
+{
+    // the lock address
+    tb_size_t addr = (tb_size_t)lock;
+
+    // compile the hash value
+    addr ^= (addr >> 8) ^ (addr >> 16);
+
+    // walk
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LOCK_PROFILER_PROBE_MAXN; i++, addr++)
+    {
+        // the item
+        tb_lock_profiler_item_t* item = &profiler->list[addr & (TB_LOCK_PROFILER_MAXN - 1)];
+
+        // is this lock?
+        tb_pointer_t item_lock = (tb_pointer_t)tb_atomic_get(&item->lock);
+        if (item_lock == lock) return item;
+
+        // the items will never be removed, so this lock has not been registered if we meet an empty item
+        if (!item_lock)
+        {
+            // only find it?
+            tb_check_break(bregister);
+
+            // try to register the lock, it may be registered by the other thread at the same time
+            item_lock = (tb_pointer_t)tb_atomic_fetch_and_pset(&item->lock, 0, (tb_long_t)lock);
+            if (!item_lock || item_lock == lock) return item;
+        }
+    }
+
+    // not found or full
+    return tb_null;
+}
+static tb_lock_profiler_site_t* tb_lock_profiler_site_find(tb_lock_profiler_t* profiler, tb_char_t const* func, tb_size_t line, tb_char_t const* file)
+{
+    // compile the hash value
+    tb_size_t hash = (tb_size_t)file;
+    hash ^= (hash >> 8) ^ (line * 2654435761ul);
+
+    // walk
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LOCK_PROFILER_PROBE_MAXN; i++, hash++)
+    {
+        // the site
+        tb_lock_profiler_site_t* site = &profiler->sites[hash & (TB_LOCK_PROFILER_SITE_MAXN - 1)];
+
+        // try to register this site if it is unused
+        tb_size_t site_line = (tb_size_t)tb_atomic_get(&site->line);
+        if (!site_line && !(site_line = (tb_size_t)tb_atomic_fetch_and_pset(&site->line, 0, (tb_long_t)line)))
+        {
+            // init the function name and the file name, the others will wait the file name 
+            tb_atomic_set(&site->func, (tb_long_t)func);
+            tb_atomic_set(&site->file, (tb_long_t)file);
+            return site;
+        }
+
+        // is this site?
+        if (site_line == line)
+        {
+            // wait the file name if this site is being registered by the other thread
+            tb_char_t const* site_file = tb_null;
+            while (!(site_file = (tb_char_t const*)tb_atomic_get(&site->file))) ;
+            if (site_file == file) return site;
+        }
+    }
+
+    // full
+    return tb_null;
+}
+static tb_void_t tb_lock_profiler_time_done(tb_lock_profiler_time_t* time, tb_hong_t value)
+{
+    // the time (us)
+    tb_long_t us = (tb_long_t)tb_max(value, 0);
+
+    // update the count and the total time
+    tb_atomic_fetch_and_inc(&time->count);
+    tb_atomic_fetch_and_add(&time->total, us);
+
+    // update the maximum time
+    tb_long_t maxn = 0;
+    while ((maxn = tb_atomic_get(&time->maxn)) < us && tb_atomic_fetch_and_pset(&time->maxn, maxn, us) != maxn) ;
+
+    // update the histogram
+    tb_size_t   index = 0;
+    tb_uint32_t value32 = (tb_uint32_t)tb_min(us, TB_MAXS32);
+    if (value32) index = 32 - tb_bits_cl0_u32_be(value32);
+    tb_atomic_fetch_and_inc(&time->histogram[tb_min(index, TB_LOCK_PROFILER_HISTOGRAM_MAXN - 1)]);
+}
+static tb_void_t tb_lock_profiler_stat_enter(tb_lock_profiler_stat_t* stat, tb_hong_t wait)
+{
+    // acquired++
+    tb_atomic_fetch_and_inc(&stat->acquired);
+
+    // occupied? update the wait time
+    if (wait >= 0)
+    {
+        tb_atomic_fetch_and_inc(&stat->occupied);
+        tb_lock_profiler_time_done(&stat->wait, wait);
+    }
+}
+static tb_void_t tb_lock_profiler_json_flush(tb_lock_profiler_json_t* json)
+{
+    // writ data
+    tb_byte_t const*    data = (tb_byte_t const*)json->data;
+    tb_size_t           size = json->size;
+    while (size && !json->failed)
+    {
+        tb_long_t real = tb_file_writ(json->file, data, size);
+        if (real > 0)
+        {
+            data += real;
+            size -= real;
+        }
+        else json->failed = tb_true;
+    }
+    json->size = 0;
+}
+static tb_void_t tb_lock_profiler_json_write(tb_lock_profiler_json_t* json, tb_char_t const* data, tb_size_t size)
+{
+    // flush it if the buffer is full
+    if (json->size + size > sizeof(json->data)) tb_lock_profiler_json_flush(json);
+
+    // append data
+    tb_assert_and_check_return(size <= sizeof(json->data));
+    tb_memcpy(json->data + json->size, data, size);
+    json->size += size;
+}
+static tb_void_t tb_lock_profiler_json_printf(tb_lock_profiler_json_t* json, tb_char_t const* fmt, ...)
+{
+    // format line
+    tb_long_t size = 0;
+    tb_char_t line[TB_LOCK_PROFILER_JSON_LINE_MAXN];
+    tb_vsnprintf_format(line, sizeof(line) - 1, fmt, &size);
+
+    // write it
+    if (size > 0) tb_lock_profiler_json_write(json, line, size);
+}
+static tb_void_t tb_lock_profiler_json_string(tb_lock_profiler_json_t* json, tb_char_t const* cstr)
+{
+    // null?
+    if (!cstr)
+    {
+        tb_lock_profiler_json_write(json, "null", 4);
+        return ;
+    }
+
+    // write the escaped string
+    tb_lock_profiler_json_write(json, "\"", 1);
+    for (; *cstr; cstr++)
+    {
+        tb_char_t ch = *cstr;
+        if (ch == '\"' || ch == '\\')
+        {
+            tb_char_t escaped[2] = {'\\', ch};
+            tb_lock_profiler_json_write(json, escaped, 2);
+        }
+        else if ((tb_byte_t)ch < 0x20) tb_lock_profiler_json_printf(json, "\\u%04x", (tb_uint_t)(tb_byte_t)ch);
+        else tb_lock_profiler_json_write(json, &ch, 1);
+    }
+    tb_lock_profiler_json_write(json, "\"", 1);
+}
+static tb_void_t tb_lock_profiler_json_time(tb_lock_profiler_json_t* json, tb_char_t const* name, tb_lock_profiler_time_t* time)
+{
+    // write the time
+    tb_lock_profiler_json_printf(json, ", \"%s\": {\"count\": %ld, \"total\": %ld, \"maxn\": %ld, \"histogram\": [", name, tb_atomic_get(&time->count), tb_atomic_get(&time->total), tb_atomic_get(&time->maxn));
+
+    // write the histogram
+    tb_size_t i = 0;
+    for (i = 0; i < TB_LOCK_PROFILER_HISTOGRAM_MAXN; i++)
+        tb_lock_profiler_json_printf(json, i? ", %ld" : "%ld", tb_atomic_get(&time->histogram[i]));
+    tb_lock_profiler_json_write(json, "]}", 2);
+}
+static tb_void_t tb_lock_profiler_json_stat(tb_lock_profiler_json_t* json, tb_lock_profiler_stat_t* stat)
+{
+    // write the stat
+    tb_lock_profiler_json_printf(json, ", \"acquired\": %ld, \"occupied\": %ld", tb_atomic_get(&stat->acquired), tb_atomic_get(&stat->occupied));
+    tb_lock_profiler_json_time(json, "wait", &stat->wait);
+    tb_lock_profiler_json_time(json, "hold", &stat->hold);
+}
+static tb_long_t tb_lock_profiler_time_avg(tb_lock_profiler_time_t* time)
+{
+    tb_long_t count = tb_atomic_get(&time->count);
+    return count? tb_atomic_get(&time->total) / count : 0;
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
 tb_handle_t tb_lock_profiler()
 {
+    // exited?
+    tb_check_return_val(!tb_atomic_get(&g_exited), tb_null);
+
+    // get it
     return tb_singleton_instance(TB_SINGLETON_TYPE_LOCK_PROFILER, tb_lock_profiler_instance_init, tb_lock_profiler_instance_exit, tb_null, tb_null);
 }
 tb_handle_t tb_lock_profiler_init()
@@ -116,7 +414,7 @@ tb_void_t tb_lock_profiler_dump(tb_handle_t handle)
     // trace
     tb_trace_i("");
 
-    // walk
+    // walk locks
     tb_size_t i = 0;
     tb_size_t n = tb_arrayn(profiler->list);
     for (i = 0; i < n; i++)
@@ -129,48 +427,131 @@ tb_void_t tb_lock_profiler_dump(tb_handle_t handle)
         if ((lock = (tb_pointer_t)tb_atomic_get(&item->lock)))
         {
             // dump lock
-            tb_trace_i("lock: %p, name: %s, occupied: %ld", lock, (tb_char_t const*)tb_atomic_get(&item->name), tb_atomic_get(&item->size));
+            tb_lock_profiler_stat_t* stat = &item->stat;
+            tb_trace_i("lock: %p, name: %s, acquired: %ld, occupied: %ld, wait: %ld/%ld us, hold: %ld/%ld us", lock, (tb_char_t const*)tb_atomic_get(&item->name)
+                ,   tb_atomic_get(&stat->acquired), tb_atomic_get(&stat->occupied)
+                ,   tb_lock_profiler_time_avg(&stat->wait), tb_atomic_get(&stat->wait.maxn)
+                ,   tb_lock_profiler_time_avg(&stat->hold), tb_atomic_get(&stat->hold.maxn));
+        }
+    }
+
+    // walk the occupied sites
+    n = tb_arrayn(profiler->sites);
+    for (i = 0; i < n; i++)
+    {
+        // the site
+        tb_lock_profiler_site_t*    site = &profiler->sites[i];
+        tb_lock_profiler_stat_t*    stat = &site->stat;
+        if (tb_atomic_get(&site->line) && tb_atomic_get(&stat->occupied))
+        {
+            // dump site
+            tb_trace_i("site: %s(): %s:%ld, acquired: %ld, occupied: %ld, wait: %ld/%ld us, hold: %ld/%ld us"
+                ,   (tb_char_t const*)tb_atomic_get(&site->func), (tb_char_t const*)tb_atomic_get(&site->file), tb_atomic_get(&site->line)
+                ,   tb_atomic_get(&stat->acquired), tb_atomic_get(&stat->occupied)
+                ,   tb_lock_profiler_time_avg(&stat->wait), tb_atomic_get(&stat->wait.maxn)
+                ,   tb_lock_profiler_time_avg(&stat->hold), tb_atomic_get(&stat->hold.maxn));
         }
     }
 }
-tb_void_t tb_lock_profiler_register(tb_handle_t handle, tb_pointer_t lock, tb_char_t const* name)
+tb_bool_t tb_lock_profiler_dump_json(tb_handle_t handle, tb_char_t const* path)
 {
     // check
     tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
-    tb_assert_and_check_return(profiler && lock);
+    tb_assert_and_check_return_val(profiler && path, tb_false);
 
-    // trace
-    tb_trace_d("register: lock: %p, name: %s: ..", lock, name);
+    // init json writer, the stack may be too small for it
+    tb_lock_profiler_json_t* json = (tb_lock_profiler_json_t*)tb_native_memory_malloc0(sizeof(tb_lock_profiler_json_t));
+    tb_assert_and_check_return_val(json, tb_false);
 
-    // the lock address
-    tb_size_t addr = (tb_size_t)lock;
+    // done
+    tb_bool_t ok = tb_false;
+    do
+    {
+        // open file
+        json->file = tb_file_init(path, TB_FILE_MODE_RW | TB_FILE_MODE_CREAT | TB_FILE_MODE_TRUNC);
+        tb_assert_and_check_break(json->file);
 
-    // compile the hash value
-    addr ^= (addr >> 8) ^ (addr >> 16);
+        // write locks
+        tb_size_t i = 0;
+        tb_size_t n = tb_arrayn(profiler->list);
+        tb_bool_t first = tb_true;
+        tb_lock_profiler_json_printf(json, "{\n    \"locks\": [");
+        for (i = 0; i < n; i++)
+        {
+            // the item
+            tb_lock_profiler_item_t* item = &profiler->list[i];
 
-    // walk
-    tb_size_t i = 0;
-    for (i = 0; i < 16; i++, addr++)
-    {
-        // the item
-        tb_lock_profiler_item_t* item = &profiler->list[addr & (TB_LOCK_PROFILER_MAXN - 1)];
+            // the lock
+            tb_pointer_t lock = (tb_pointer_t)tb_atomic_get(&item->lock);
+            tb_check_continue(lock);
 
-        // try to register the lock
-        if (!tb_atomic_fetch_and_pset(&item->lock, 0, (tb_long_t)lock))
+            // write lock
+            tb_lock_profiler_json_printf(json, "%s\n        {\"lock\": \"%p\", \"name\": ", first? "" : ",", lock);
+            tb_lock_profiler_json_string(json, (tb_char_t const*)tb_atomic_get(&item->name));
+            tb_lock_profiler_json_stat(json, &item->stat);
+            tb_lock_profiler_json_write(json, "}", 1);
+            first = tb_false;
+        }
+
+        // write sites
+        n = tb_arrayn(profiler->sites);
+        first = tb_true;
+        tb_lock_profiler_json_printf(json, "\n    ],\n    \"sites\": [");
+        for (i = 0; i < n; i++)
         {
-            // init name
-            tb_atomic_set(&item->name, (tb_long_t)name);
+            // the site
+            tb_lock_profiler_site_t* site = &profiler->sites[i];
 
-            // trace
-            tb_trace_d("register: lock: %p, name: %s, index: %lu: ok", lock, name, addr & (TB_LOCK_PROFILER_MAXN - 1));
+            // the line
+            tb_long_t line = tb_atomic_get(&site->line);
+            tb_check_continue(line);
 
-            // ok
-            break;
+            // write site
+            tb_lock_profiler_json_printf(json, "%s\n        {\"func\": ", first? "" : ",");
+            tb_lock_profiler_json_string(json, (tb_char_t const*)tb_atomic_get(&site->func));
+            tb_lock_profiler_json_write(json, ", \"file\": ", 10);
+            tb_lock_profiler_json_string(json, (tb_char_t const*)tb_atomic_get(&site->file));
+            tb_lock_profiler_json_printf(json, ", \"line\": %ld", line);
+            tb_lock_profiler_json_stat(json, &site->stat);
+            tb_lock_profiler_json_write(json, "}", 1);
+            first = tb_false;
         }
-    }
+        tb_lock_profiler_json_printf(json, "\n    ]\n}\n");
+
+        // flush it
+        tb_lock_profiler_json_flush(json);
+
+        // ok
+        ok = !json->failed;
+
+    } while (0);
+
+    // exit json writer
+    if (json->file) tb_file_exit(json->file);
+    tb_native_memory_free(json);
+    return ok;
+}
+tb_void_t tb_lock_profiler_register(tb_handle_t handle, tb_pointer_t lock, tb_char_t const* name)
+{
+    // check
+    tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
+    tb_assert_and_check_return(profiler && lock);
+
+    // trace
+    tb_trace_d("register: lock: %p, name: %s: ..", lock, name);
+
+    // register the lock, it may have been registered automatically
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item_find(profiler, lock, tb_true);
+    if (item)
+    {
+        // init name
+        tb_atomic_set(&item->name, (tb_long_t)name);
 
+        // trace
+        tb_trace_d("register: lock: %p, name: %s, index: %lu: ok", lock, name, item - profiler->list);
+    }
     // full?
-    if (i == 16)
+    else
     {
         // trace
         tb_trace_w("register: lock: %p, name: %s: no", lock, name);
@@ -182,28 +563,48 @@ tb_void_t tb_lock_profiler_occupied(tb_handle_t handle, tb_pointer_t lock)
     tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
     tb_check_return(profiler && lock);
 
-    // the lock address
-    tb_size_t addr = (tb_size_t)lock;
+    // occupied++
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item_find(profiler, lock, tb_false);
+    if (item) tb_atomic_fetch_and_inc(&item->stat.occupied);
+}
+tb_void_t tb_lock_profiler_enter(tb_handle_t handle, tb_pointer_t lock, tb_hong_t wait, tb_char_t const* func, tb_size_t line, tb_char_t const* file)
+{
+    // check
+    tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
+    tb_check_return(profiler && lock);
 
-    // compile the hash value
-    addr ^= (addr >> 8) ^ (addr >> 16);
+    // profile the call site
+    tb_lock_profiler_site_t* site = (line && file)? tb_lock_profiler_site_find(profiler, func, line, file) : tb_null;
+    if (site) tb_lock_profiler_stat_enter(&site->stat, wait);
 
-    // walk
-    tb_size_t i = 0;
-    for (i = 0; i < 16; i++, addr++)
+    // profile the lock, register it automatically if it has been occupied
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item_find(profiler, lock, wait >= 0);
+    if (item) 
     {
-        // the item
-        tb_lock_profiler_item_t* item = &profiler->list[addr & (TB_LOCK_PROFILER_MAXN - 1)];
+        // update stat
+        tb_lock_profiler_stat_enter(&item->stat, wait);
 
-        // is this lock?
-        if (lock == (tb_pointer_t)tb_atomic_get(&item->lock))
-        {
-            // occupied++
-            tb_atomic_fetch_and_inc(&item->size);
-
-            // ok
-            break;
-        }
+        // save the acquired time and site for the hold time, we are the lock holder now
+        item->site = site;
+        item->time = tb_uclock();
     }
 }
+tb_void_t tb_lock_profiler_leave(tb_handle_t handle, tb_pointer_t lock)
+{
+    // check
+    tb_lock_profiler_t* profiler = (tb_lock_profiler_t*)handle;
+    tb_check_return(profiler && lock);
+
+    // get the lock item
+    tb_lock_profiler_item_t* item = tb_lock_profiler_item_find(profiler, lock, tb_false);
+    tb_check_return(item && item->time);
 
+    // update the hold time
+    tb_hong_t hold = tb_uclock() - item->time;
+    tb_lock_profiler_time_done(&item->stat.hold, hold);
+    if (item->site) tb_lock_profiler_time_done(&item->site->stat.hold, hold);
+
+    // clear the acquired time and site
+    item->time = 0;
+    item->site = tb_null;
+}
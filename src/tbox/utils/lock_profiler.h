@@ -40,12 +40,23 @@ __tb_extern_c_enter__
  * macros
  */
 
-// enable lock profiler
+// enable lock profiler, it can be also enabled for the release mode by the config option: lock_profiler
 #undef TB_LOCK_PROFILER_ENABLE
-#if defined(__tb_debug__) && !defined(TB_CONFIG_MICRO_ENABLE)
+#if (defined(__tb_debug__) || defined(TB_CONFIG_LOCK_PROFILER_ENABLE)) && !defined(TB_CONFIG_MICRO_ENABLE)
 #   define TB_LOCK_PROFILER_ENABLE
 #endif
 
+// the call site arguments of the lock profiler
+#ifdef TB_LOCK_PROFILER_ENABLE
+#   define __tb_lock_profiler_decl__            , tb_char_t const* func_, tb_size_t line_, tb_char_t const* file_
+#   define __tb_lock_profiler_vals__            , __tb_func__, __tb_line__, __tb_file__
+#   define __tb_lock_profiler_args__            , func_, line_, file_
+#else
+#   define __tb_lock_profiler_decl__ 
+#   define __tb_lock_profiler_vals__ 
+#   define __tb_lock_profiler_args__ 
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -76,6 +87,27 @@ tb_void_t               tb_lock_profiler_exit(tb_handle_t profiler);
  */
 tb_void_t               tb_lock_profiler_dump(tb_handle_t profiler);
 
+/*! dump lock profiler to the given json file
+ *
+ * @code
+    {
+        "locks": [{"lock": "0x...", "name": "...", "acquired": n, "occupied": n, "wait": {..}, "hold": {..}}, ..],
+        "sites": [{"func": "...", "file": "...", "line": n, "acquired": n, "occupied": n, "wait": {..}, "hold": {..}}, ..]
+    }
+
+    wait/hold: {"total": us, "maxn": us, "histogram": [n, ..]}
+ * @endcode
+ *
+ * the histogram[0] is the count of < 1us, and histogram[i] is the count of [2^(i - 1), 2^i) us, 
+ * the last one contains all larger times.
+ *
+ * @param profiler      the lock profiler handle
+ * @param path          the json file path
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_lock_profiler_dump_json(tb_handle_t profiler, tb_char_t const* path);
+
 /*! register the lock to the lock profiler
  *
  * @param profiler      the lock profiler handle
@@ -91,6 +123,27 @@ tb_void_t               tb_lock_profiler_register(tb_handle_t profiler, tb_point
  */
 tb_void_t               tb_lock_profiler_occupied(tb_handle_t profiler, tb_pointer_t lock);
 
+/*! the lock has been acquired
+ *
+ * the unregistered lock will be registered automatically if it has been occupied,
+ * and we will record the hold time until tb_lock_profiler_leave() if the lock has been registered.
+ *
+ * @param profiler      the lock profiler handle
+ * @param lock          the lock address
+ * @param wait          the waited time (us), -1 if it was not occupied
+ * @param func          the function name of the call site
+ * @param line          the line number of the call site
+ * @param file          the file name of the call site
+ */
+tb_void_t               tb_lock_profiler_enter(tb_handle_t profiler, tb_pointer_t lock, tb_hong_t wait, tb_char_t const* func, tb_size_t line, tb_char_t const* file);
+
+/*! the lock will be released
+ *
+ * @param profiler      the lock profiler handle
+ * @param lock          the lock address
+ */
+tb_void_t               tb_lock_profiler_leave(tb_handle_t profiler, tb_pointer_t lock);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -28,6 +28,7 @@
  * includes
  */
 #include "trace.h"
+#include "bits.h"
 #include "../libc/libc.h"
 #include "../platform/platform.h"
 
@@ -46,6 +47,93 @@
 #   endif
 #endif
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+
+// the default ring buffer size of each thread for the async trace
+#   ifdef __tb_small__
+#       define TB_TRACE_ASYNC_RING_SIZE     (64 * 1024)
+#   else
+#       define TB_TRACE_ASYNC_RING_SIZE     (256 * 1024)
+#   endif
+
+// the flush interval (ms) of the async trace
+#   define TB_TRACE_ASYNC_INTERVAL          (100)
+
+// the iovec maximum count for each writv of the async trace
+#   define TB_TRACE_ASYNC_IOVEC_MAXN        (64)
+
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the cached time prefix type, we need not call localtime() for each line
+typedef struct __tb_trace_time_t
+{
+    // the time
+    tb_time_t                   time;
+
+    // the prefix size
+    tb_size_t                   size;
+
+    // the prefix data
+    tb_char_t                   data[64];
+
+}tb_trace_time_t;
+
+#ifndef TB_CONFIG_MICRO_ENABLE
+
+// the async trace state enum
+typedef enum __tb_trace_async_state_e
+{
+    TB_TRACE_ASYNC_STATE_NONE       = 0
+,   TB_TRACE_ASYNC_STATE_RUNNING    = 1
+,   TB_TRACE_ASYNC_STATE_STOPPING   = 2
+
+}tb_trace_async_state_e;
+
+/* the ring buffer type of the async trace
+ *
+ * it is a single-producer/single-consumer ring, 
+ * only the owner thread writes the lines and only the flusher (with g_lock) reads them.
+ */
+typedef struct __tb_trace_ring_t
+{
+    // the next ring
+    struct __tb_trace_ring_t*   next;
+
+    // the read position, only be modified by the flusher
+    tb_atomic_t                 head;
+
+    // the padding, avoid false sharing between head and tail
+    tb_byte_t                   padding[TB_SMP_CACHE_BYTES];
+
+    // the write position, only be modified by the owner thread
+    tb_atomic_t                 tail;
+
+    // the dropped lines count
+    tb_atomic_t                 dropped;
+
+    // the owner thread has been exited?
+    tb_atomic_t                 dead;
+
+    // the ring buffer size, must be power of 2
+    tb_size_t                   size;
+
+    // the ring buffer data
+    tb_byte_t*                  data;
+
+    // the cached time prefix
+    tb_trace_time_t             time;
+
+    // the line buffer for formatting
+    tb_char_t                   line[TB_TRACE_LINE_MAXN];
+
+}tb_trace_ring_t;
+
+#endif
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -64,9 +152,418 @@ static tb_bool_t        g_bref = tb_false;
 // the line
 static tb_char_t        g_line[TB_TRACE_LINE_MAXN];
 
+// the cached time prefix
+static tb_trace_time_t  g_time;
+
 // the lock
 static tb_spinlock_t    g_lock = TB_SPINLOCK_INIT; 
 
+#ifndef TB_CONFIG_MICRO_ENABLE
+// the async trace state
+static tb_atomic_t      g_async_state = TB_TRACE_ASYNC_STATE_NONE;
+
+// the async trace policy
+static tb_size_t        g_async_policy = TB_TRACE_ASYNC_POLICY_DROP;
+
+// the ring buffer size of the async trace
+static tb_size_t        g_async_size = TB_TRACE_ASYNC_RING_SIZE;
+
+// the ring buffers of all threads
+static tb_trace_ring_t* g_async_rings = tb_null;
+
+// the lock of the ring buffers list
+static tb_spinlock_t    g_async_lock = TB_SPINLOCK_INIT;
+
+// the ring buffer of the current thread
+static tb_thread_local_t g_async_local = TB_THREAD_LOCAL_INIT;
+
+// the flusher thread
+static tb_thread_ref_t  g_async_thread = tb_null;
+
+// the flusher event
+static tb_event_ref_t   g_async_event = tb_null;
+
+// the posting count of the flusher event
+static tb_atomic_t      g_async_posting = 0;
+
+// the count of the threads which are writing their ring buffers
+static tb_atomic_t      g_async_writing = 0;
+#endif
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * private implementation
+ */
+static tb_char_t* tb_trace_format(tb_char_t* p, tb_char_t* e, tb_char_t** pb, tb_trace_time_t* cache, tb_bool_t head, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    // print prefix to file
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if (head && (g_mode & TB_TRACE_MODE_FILE) && g_file) 
+    {
+        // update the cached time prefix
+        tb_tm_t     lt = {0};
+        tb_time_t   now = tb_time();
+        if (now != cache->time || !cache->size)
+        {
+            tb_long_t size = tb_localtime(now, &lt)? tb_snprintf(cache->data, sizeof(cache->data), "[%04ld-%02ld-%02ld %02ld:%02ld:%02ld]: ", lt.year, lt.month, lt.mday, lt.hour, lt.minute, lt.second) : 0;
+            cache->size = size > 0? tb_min(size, sizeof(cache->data) - 1) : 0;
+            cache->time = now;
+        }
+
+        // print time to file
+        if (p + cache->size < e)
+        {
+            tb_memcpy_(p, cache->data, cache->size);
+            p += cache->size;
+        }
+
+        // print self to file
+        if (p < e) p += tb_snprintf(p, e - p, "[%lx]: ", tb_thread_self());
+    }
+#endif
+
+    // append prefix
+    *pb = p;
+    if (prefix && p < e) p += tb_snprintf(p, e - p, "[%s]: ", prefix);
+
+    // append module
+    if (module && p < e) p += tb_snprintf(p, e - p, "[%s]: ", module);
+
+    // append format
+    if (p < e) p += tb_vsnprintf(p, e - p, format, args);
+
+    // append end
+    if (p < e) *p = '\0';
+    e[-1] = '\0';
+    return tb_min(p, e - 1);
+}
+#ifndef TB_CONFIG_MICRO_ENABLE
+static tb_void_t tb_trace_file_writ(tb_byte_t const* data, tb_size_t size)
+{
+    // done
+    tb_size_t writ = 0;
+    while (writ < size)
+    {
+        // writ it
+        tb_long_t real = tb_file_writ(g_file, data + writ, size - writ);
+        tb_check_break(real > 0);
+
+        // save size
+        writ += real;
+    }
+}
+static tb_void_t tb_trace_async_ring_free(tb_cpointer_t priv)
+{
+    // check
+    tb_trace_ring_t* ring = (tb_trace_ring_t*)priv;
+    tb_check_return(ring);
+
+    // the flusher is running? it will free this ring after all lines have been written
+    if (g_async_state == TB_TRACE_ASYNC_STATE_RUNNING)
+    {
+        tb_atomic_set(&ring->dead, 1);
+        return ;
+    }
+
+    // remove it from the rings list
+    tb_spinlock_enter_without_profiler(&g_lock);
+    tb_spinlock_enter_without_profiler(&g_async_lock);
+    tb_trace_ring_t** pring = &g_async_rings;
+    while (*pring && *pring != ring) pring = &(*pring)->next;
+    if (*pring) *pring = ring->next;
+    tb_spinlock_leave_without_profiler(&g_async_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
+
+    // free it
+    tb_native_memory_free(ring);
+}
+static tb_trace_ring_t* tb_trace_async_ring()
+{
+    // get the ring buffer of the current thread, the thread local has been initialized in tb_trace_async_init()
+    tb_trace_ring_t* ring = (tb_trace_ring_t*)tb_thread_local_get(&g_async_local);
+    tb_check_return_val(!ring, ring);
+
+    // make it
+    tb_size_t size = g_async_size;
+    ring = (tb_trace_ring_t*)tb_native_memory_malloc0(sizeof(tb_trace_ring_t) + size);
+    tb_check_return_val(ring, tb_null);
+
+    // init it
+    ring->size = size;
+    ring->data = (tb_byte_t*)(ring + 1);
+
+    // save it to the current thread
+    if (!tb_thread_local_set(&g_async_local, ring))
+    {
+        tb_native_memory_free(ring);
+        return tb_null;
+    }
+
+    // insert it to the rings list
+    tb_spinlock_enter_without_profiler(&g_async_lock);
+    ring->next = g_async_rings;
+    g_async_rings = ring;
+    tb_spinlock_leave_without_profiler(&g_async_lock);
+
+    // ok
+    return ring;
+}
+static tb_void_t tb_trace_async_post()
+{
+    // the flusher event will be exited after stopping, so we need mark it as posting first
+    tb_atomic_fetch_and_inc(&g_async_posting);
+    if (g_async_state == TB_TRACE_ASYNC_STATE_RUNNING) tb_event_post(g_async_event);
+    tb_atomic_fetch_and_dec(&g_async_posting);
+}
+static tb_void_t tb_trace_async_push(tb_trace_ring_t* ring, tb_byte_t const* data, tb_size_t size)
+{
+    // check
+    tb_assert(ring && data && size <= ring->size);
+
+    // wait the free space
+    tb_size_t tail = (tb_size_t)ring->tail;
+    tb_size_t used = tail - (tb_size_t)ring->head;
+    while (used + size > ring->size)
+    {
+        // drop this line?
+        if (g_async_policy == TB_TRACE_ASYNC_POLICY_DROP || g_async_state != TB_TRACE_ASYNC_STATE_RUNNING)
+        {
+            tb_atomic_fetch_and_inc(&ring->dropped);
+            return ;
+        }
+
+        // wake up the flusher and wait it
+        tb_trace_async_post();
+        tb_sched_yield();
+        used = tail - (tb_size_t)ring->head;
+    }
+
+    // copy data to the ring buffer
+    tb_size_t mask = ring->size - 1;
+    tb_size_t offset = tail & mask;
+    tb_size_t left = ring->size - offset;
+    if (size <= left) tb_memcpy_(ring->data + offset, data, size);
+    else
+    {
+        tb_memcpy_(ring->data + offset, data, left);
+        tb_memcpy_(ring->data, data + left, size - left);
+    }
+
+    // commit it
+    tb_barrier();
+    tb_atomic_set(&ring->tail, (tb_long_t)(tail + size));
+
+    // wake up the flusher only if the ring buffer becomes half full, it will flush all rings periodically
+    if (used < (ring->size >> 1) && used + size >= (ring->size >> 1)) 
+        tb_trace_async_post();
+}
+static tb_void_t tb_trace_async_writv(tb_iovec_t* list, tb_size_t size)
+{
+    // no file? discard them
+    tb_check_return(g_file);
+
+    // writ all data
+    while (size)
+    {
+        // writ it
+        tb_long_t real = tb_file_writv(g_file, list, size);
+        tb_check_break(real > 0);
+
+        // skip the written data
+        while (size && (tb_size_t)real >= list->size)
+        {
+            real -= list->size;
+            list++;
+            size--;
+        }
+        if (size && real)
+        {
+            list->data += real;
+            list->size -= real;
+        }
+    }
+}
+static tb_void_t tb_trace_async_flush()
+{
+    // the written rings
+    tb_size_t           count = 0;
+    tb_size_t           rings_count = 0;
+    tb_iovec_t          list[TB_TRACE_ASYNC_IOVEC_MAXN];
+    tb_trace_ring_t*    rings[TB_TRACE_ASYNC_IOVEC_MAXN];
+    tb_size_t           tails[TB_TRACE_ASYNC_IOVEC_MAXN];
+    tb_char_t           notes[TB_TRACE_ASYNC_IOVEC_MAXN][64];
+
+    /* walk all rings
+     *
+     * the new rings are only inserted to the list head and we are the only one which removes rings, 
+     * so we need not lock the list when walking it
+     */
+    tb_spinlock_enter_without_profiler(&g_async_lock);
+    tb_trace_ring_t* ring = g_async_rings;
+    tb_spinlock_leave_without_profiler(&g_async_lock);
+    for (; ring; ring = ring->next)
+    {
+        // the readable data
+        tb_size_t head = (tb_size_t)ring->head;
+        tb_size_t tail = (tb_size_t)ring->tail;
+        tb_barrier();
+
+        // the dropped lines
+        tb_size_t dropped = ring->dropped? (tb_size_t)tb_atomic_fetch_and_set0(&ring->dropped) : 0;
+        tb_check_continue(head != tail || dropped);
+
+        // the iovecs are full? writ them first
+        if (count + 3 > TB_TRACE_ASYNC_IOVEC_MAXN)
+        {
+            tb_trace_async_writv(list, count);
+            while (rings_count--) tb_atomic_set(&rings[rings_count]->head, (tb_long_t)tails[rings_count]);
+            count = 0;
+            rings_count = 0;
+        }
+
+        // append the dropped note
+        if (dropped)
+        {
+            tb_long_t n = tb_snprintf(notes[rings_count], sizeof(notes[0]), "[trace]: %lu lines have been dropped!" __tb_newline__, dropped);
+            if (n > 0)
+            {
+                list[count].data = (tb_byte_t*)notes[rings_count];
+                list[count].size = tb_min(n, sizeof(notes[0]) - 1);
+                count++;
+            }
+        }
+
+        // append the lines
+        if (head != tail)
+        {
+            tb_size_t mask = ring->size - 1;
+            tb_size_t offset = head & mask;
+            tb_size_t size = tail - head;
+            tb_size_t left = ring->size - offset;
+            list[count].data = ring->data + offset;
+            list[count].size = tb_min(size, left);
+            count++;
+            if (size > left)
+            {
+                list[count].data = ring->data;
+                list[count].size = size - left;
+                count++;
+            }
+        }
+
+        // save the new head
+        rings[rings_count] = ring;
+        tails[rings_count] = tail;
+        rings_count++;
+    }
+
+    // writ the left lines
+    if (count) tb_trace_async_writv(list, count);
+    while (rings_count--) tb_atomic_set(&rings[rings_count]->head, (tb_long_t)tails[rings_count]);
+
+    // free the empty rings of the exited threads
+    tb_spinlock_enter_without_profiler(&g_async_lock);
+    tb_trace_ring_t** pring = &g_async_rings;
+    while ((ring = *pring))
+    {
+        if (ring->dead && ring->head == ring->tail)
+        {
+            *pring = ring->next;
+            tb_native_memory_free(ring);
+        }
+        else pring = &ring->next;
+    }
+    tb_spinlock_leave_without_profiler(&g_async_lock);
+}
+static tb_int_t tb_trace_async_loop(tb_cpointer_t priv)
+{
+    // flush lines periodically or if some rings are half full 
+    while (g_async_state == TB_TRACE_ASYNC_STATE_RUNNING)
+    {
+        // wait it
+        tb_event_wait(g_async_event, TB_TRACE_ASYNC_INTERVAL);
+
+        // flush it
+        tb_spinlock_enter_without_profiler(&g_lock);
+        tb_trace_async_flush();
+        tb_spinlock_leave_without_profiler(&g_lock);
+    }
+    return 0;
+}
+static tb_bool_t tb_trace_async_done(tb_bool_t head, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    /* the ring buffers will be freed after stopping, so we need mark it as writing first
+     * and check the state again, we use the sync mode if it has been stopped
+     */
+    tb_atomic_fetch_and_inc(&g_async_writing);
+    if (g_async_state != TB_TRACE_ASYNC_STATE_RUNNING)
+    {
+        tb_atomic_fetch_and_dec(&g_async_writing);
+        return tb_false;
+    }
+
+    // get the ring buffer of the current thread, we use the sync mode if failed
+    tb_trace_ring_t* ring = tb_trace_async_ring();
+    if (!ring)
+    {
+        tb_atomic_fetch_and_dec(&g_async_writing);
+        return tb_false;
+    }
+
+    // format it to the line buffer of the current thread
+    tb_char_t* b = tb_null;
+    tb_char_t* p = tb_trace_format(ring->line, ring->line + sizeof(ring->line), &b, &ring->time, head, prefix, module, format, args);
+
+    // print it
+    if (g_mode & TB_TRACE_MODE_PRINT) tb_print(b);
+
+    // push it to the ring buffer, the flusher will write it to file
+    if ((g_mode & TB_TRACE_MODE_FILE) && g_file && p > ring->line) 
+        tb_trace_async_push(ring, (tb_byte_t const*)ring->line, p - ring->line);
+
+    // ok
+    tb_atomic_fetch_and_dec(&g_async_writing);
+    return tb_true;
+}
+#endif
+static tb_void_t tb_trace_done_impl(tb_bool_t head, tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    // check
+    tb_check_return(g_mode);
+
+    // done it in the async mode without the global lock
+#ifndef TB_CONFIG_MICRO_ENABLE
+    if (g_async_state == TB_TRACE_ASYNC_STATE_RUNNING && tb_trace_async_done(head, prefix, module, format, args)) return ;
+#endif
+
+    // enter
+    tb_spinlock_enter_without_profiler(&g_lock);
+
+    // done
+    do
+    {
+        // check
+        tb_check_break(g_mode);
+
+        // format it
+        tb_char_t* b = tb_null;
+        tb_char_t* p = tb_trace_format(g_line, g_line + sizeof(g_line), &b, &g_time, head, prefix, module, format, args);
+
+        // print it
+        if (g_mode & TB_TRACE_MODE_PRINT) tb_print(b);
+
+        // print it to file
+#ifndef TB_CONFIG_MICRO_ENABLE
+        if ((g_mode & TB_TRACE_MODE_FILE) && g_file) tb_trace_file_writ((tb_byte_t const*)g_line, p - g_line);
+#else
+        tb_used(p);
+#endif
+
+    } while (0);
+
+    // leave
+    tb_spinlock_leave_without_profiler(&g_lock);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -77,6 +574,11 @@ tb_bool_t tb_trace_init()
 }
 tb_void_t tb_trace_exit()
 {
+    // exit the async trace
+#ifndef TB_CONFIG_MICRO_ENABLE
+    tb_trace_async_exit();
+#endif
+
     // sync trace
     tb_trace_sync();
 
@@ -94,7 +596,7 @@ tb_void_t tb_trace_exit()
 #endif
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // exit lock
     tb_spinlock_exit(&g_lock);
@@ -108,7 +610,7 @@ tb_size_t tb_trace_mode()
     tb_size_t mode = g_mode;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return mode;
@@ -122,7 +624,7 @@ tb_bool_t tb_trace_mode_set(tb_size_t mode)
     g_mode = mode;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok
     return tb_true;
@@ -137,7 +639,7 @@ tb_file_ref_t tb_trace_file()
     tb_file_ref_t file = g_file;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return file;
@@ -150,6 +652,9 @@ tb_bool_t tb_trace_file_set(tb_file_ref_t file)
     // enter
     tb_spinlock_enter_without_profiler(&g_lock);
 
+    // write the pending lines of the async trace to the previous file
+    if (g_async_state != TB_TRACE_ASYNC_STATE_NONE) tb_trace_async_flush();
+
     // exit the previous file
     if (g_file && !g_bref) tb_file_exit(g_file);
 
@@ -158,7 +663,7 @@ tb_bool_t tb_trace_file_set(tb_file_ref_t file)
     g_bref = tb_true;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok
     return tb_true;
@@ -171,6 +676,9 @@ tb_bool_t tb_trace_file_set_path(tb_char_t const* path, tb_bool_t bappend)
     // enter
     tb_spinlock_enter_without_profiler(&g_lock);
 
+    // write the pending lines of the async trace to the previous file
+    if (g_async_state != TB_TRACE_ASYNC_STATE_NONE) tb_trace_async_flush();
+
     // exit the previous file
     if (g_file && !g_bref) tb_file_exit(g_file);
 
@@ -182,84 +690,112 @@ tb_bool_t tb_trace_file_set_path(tb_char_t const* path, tb_bool_t bappend)
     tb_bool_t ok = g_file? tb_true : tb_false;
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 
     // ok?
     return ok;
 }
-#endif
-tb_void_t tb_trace_done_with_args(tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+tb_bool_t tb_trace_async_init(tb_size_t size, tb_size_t policy)
 {
     // check
-    tb_check_return(format);
+    tb_assert_and_check_return_val(policy == TB_TRACE_ASYNC_POLICY_DROP || policy == TB_TRACE_ASYNC_POLICY_BLOCK, tb_false);
 
-    // enter
-    tb_spinlock_enter_without_profiler(&g_lock);
+    // the ring buffer size, it must be able to hold one line at least
+    if (!size) size = TB_TRACE_ASYNC_RING_SIZE;
+    size = tb_align_pow2(tb_max(size, TB_TRACE_LINE_MAXN << 1));
 
     // done
+    tb_bool_t ok = tb_false;
     do
     {
-        // check
-        tb_check_break(g_mode);
+        // has been started? we mark it as stopping before it has been initialized
+        if (tb_atomic_fetch_and_pset(&g_async_state, TB_TRACE_ASYNC_STATE_NONE, TB_TRACE_ASYNC_STATE_STOPPING) != TB_TRACE_ASYNC_STATE_NONE)
+            return tb_false;
 
-        // init
-        tb_char_t*      p = g_line;
-        tb_char_t*      e = g_line + sizeof(g_line);
+        // init the thread local of the ring buffer
+        if (!tb_thread_local_init(&g_async_local, tb_trace_async_ring_free)) break;
 
-        // print prefix to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file) 
-        {
-            // print time to file
-            tb_tm_t lt = {0};
-            if (p < e && tb_localtime(tb_time(), &lt))
-                p += tb_snprintf(p, e - p, "[%04ld-%02ld-%02ld %02ld:%02ld:%02ld]: ", lt.year, lt.month, lt.mday, lt.hour, lt.minute, lt.second);
+        // init the flusher event
+        g_async_event = tb_event_init();
+        tb_assert_and_check_break(g_async_event);
 
-            // print self to file
-            if (p < e) p += tb_snprintf(p, e - p, "[%lx]: ", tb_thread_self());
-        }
-#endif
+        // init the ring buffer size and policy, the new size is only used for the new threads
+        g_async_size    = size;
+        g_async_policy  = policy;
 
-        // append prefix
-        tb_char_t*      b = p;
-        if (prefix && p < e) p += tb_snprintf(p, e - p, "[%s]: ", prefix);
+        // start it
+        tb_atomic_set(&g_async_state, TB_TRACE_ASYNC_STATE_RUNNING);
 
-        // append module
-        if (module && p < e) p += tb_snprintf(p, e - p, "[%s]: ", module);
+        // init the flusher thread
+        g_async_thread = tb_thread_init("trace", tb_trace_async_loop, tb_null, 0);
+        tb_assert_and_check_break(g_async_thread);
 
-        // append format
-        if (p < e) p += tb_vsnprintf(p, e - p, format, args);
+        // ok
+        ok = tb_true;
 
-        // append end
-        if (p < e) *p = '\0';
-        e[-1] = '\0';
+    } while (0);
 
-        // print it
-        if (g_mode & TB_TRACE_MODE_PRINT) tb_print(b);
+    // failed?
+    if (!ok) tb_trace_async_exit();
 
-        // print it to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file) 
-        {
-            // done
-            tb_size_t size = p - g_line;
-            tb_size_t writ = 0;
-            while (writ < size)
-            {
-                // writ it
-                tb_long_t real = tb_file_writ(g_file, (tb_byte_t const*)g_line + writ, size - writ);
-                tb_check_break(real > 0);
+    // ok?
+    return ok;
+}
+tb_void_t tb_trace_async_exit()
+{
+    // stop it
+    tb_check_return(g_async_state != TB_TRACE_ASYNC_STATE_NONE);
+    tb_atomic_set(&g_async_state, TB_TRACE_ASYNC_STATE_STOPPING);
 
-                // save size
-                writ += real;
-            }
-        }
-#endif
+    // wait the flusher thread
+    if (g_async_thread)
+    {
+        tb_event_post(g_async_event);
+        tb_thread_wait(g_async_thread, -1, tb_null);
+        tb_thread_exit(g_async_thread);
+        g_async_thread = tb_null;
+    }
 
-    } while (0);
+    // wait the posting and writing threads
+    while (tb_atomic_get(&g_async_posting) || tb_atomic_get(&g_async_writing)) tb_sched_yield();
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // exit the flusher event
+    if (g_async_event) tb_event_exit(g_async_event);
+    g_async_event = tb_null;
+
+    // write all pending lines
+    tb_spinlock_enter_without_profiler(&g_lock);
+    tb_trace_async_flush();
+    tb_spinlock_leave_without_profiler(&g_lock);
+
+    // exit the thread local of the ring buffer, it frees the ring buffer of the current thread
+    tb_thread_local_exit(&g_async_local);
+
+    /* free the ring buffers of the other threads, all lines have been written
+     *
+     * these threads will not find them from the exited thread local and they will make the new ring buffers 
+     * if the async trace is started again.
+     */
+    tb_spinlock_enter_without_profiler(&g_lock);
+    tb_spinlock_enter_without_profiler(&g_async_lock);
+    while (g_async_rings)
+    {
+        tb_trace_ring_t* ring = g_async_rings;
+        g_async_rings = ring->next;
+        tb_native_memory_free(ring);
+    }
+    tb_spinlock_leave_without_profiler(&g_async_lock);
+    tb_atomic_set(&g_async_state, TB_TRACE_ASYNC_STATE_NONE);
+    tb_spinlock_leave_without_profiler(&g_lock);
+}
+#endif
+tb_void_t tb_trace_done_with_args(tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, tb_va_list_t args)
+{
+    // check
+    tb_check_return(format);
+
+    // done it
+    tb_trace_done_impl(tb_true, prefix, module, format, args);
 }
 tb_void_t tb_trace_done(tb_char_t const* prefix, tb_char_t const* module, tb_char_t const* format, ...)
 {
@@ -281,62 +817,38 @@ tb_void_t tb_trace_tail(tb_char_t const* format, ...)
     // check
     tb_check_return(format);
 
-    // enter
-    tb_spinlock_enter_without_profiler(&g_lock);
-
-    // done
-    do
-    {
-        // check
-        tb_check_break(g_mode);
-
-        // init
-        tb_va_list_t    l;
-        tb_char_t*      p = g_line;
-        tb_char_t*      e = g_line + sizeof(g_line);
-        tb_va_start(l, format);
-
-        // append format
-        if (p < e) p += tb_vsnprintf(p, e - p, format, l);
-
-        // append end
-        if (p < e) *p = '\0';
-        e[-1] = '\0';
-
-        // print it
-        if (g_mode & TB_TRACE_MODE_PRINT) tb_print(g_line);
-
-        // print it to file
-#ifndef TB_CONFIG_MICRO_ENABLE
-        if ((g_mode & TB_TRACE_MODE_FILE) && g_file) 
-        {
-            // done
-            tb_size_t size = p - g_line;
-            tb_size_t writ = 0;
-            while (writ < size)
-            {
-                // writ it
-                tb_long_t real = tb_file_writ(g_file, (tb_byte_t const*)g_line + writ, size - writ);
-                tb_check_break(real > 0);
-
-                // save size
-                writ += real;
-            }
-        }
-#endif
-
-        // exit
-        tb_va_end(l);
+    // init args
+    tb_va_list_t args;
+    tb_va_start(args, format);
 
-    } while (0);
+    // done it
+    tb_trace_done_impl(tb_false, tb_null, tb_null, format, args);
 
-    // leave
-    tb_spinlock_leave(&g_lock);
+    // exit args
+    tb_va_end(args);
 }
 tb_void_t tb_trace_sync()
 {
-    // enter
+    /* enter
+     *
+     * the crashed thread may be holding this lock in the async mode, 
+     * so we only try to enter it for a while to avoid deadlock
+     */
+#ifndef TB_CONFIG_MICRO_ENABLE
+    tb_bool_t async = g_async_state != TB_TRACE_ASYNC_STATE_NONE;
+    if (async)
+    {
+        tb_size_t tryn = 1000;
+        while (!tb_spinlock_enter_try_without_profiler(&g_lock) && tryn--) tb_msleep(1);
+        tb_check_return(tryn != (tb_size_t)-1);
+    }
+    else tb_spinlock_enter_without_profiler(&g_lock);
+
+    // write all pending lines of the async trace
+    if (async) tb_trace_async_flush();
+#else
     tb_spinlock_enter_without_profiler(&g_lock);
+#endif
 
     // sync it
     if (g_mode & TB_TRACE_MODE_PRINT) tb_print_sync();
@@ -347,5 +859,5 @@ tb_void_t tb_trace_sync()
 #endif
 
     // leave
-    tb_spinlock_leave(&g_lock);
+    tb_spinlock_leave_without_profiler(&g_lock);
 }
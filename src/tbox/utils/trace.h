@@ -50,6 +50,14 @@ typedef enum __tb_trace_mode_e
 
 }tb_trace_mode_e;
 
+/// the async trace policy enum, the policy when the ring buffer of the current thread is full
+typedef enum __tb_trace_async_policy_e
+{
+    TB_TRACE_ASYNC_POLICY_DROP      = 0 //!< drop the new lines and write the dropped count later
+,   TB_TRACE_ASYNC_POLICY_BLOCK     = 1 //!< wait the flusher until the ring buffer has enough space
+
+}tb_trace_async_policy_e;
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
  */
@@ -101,6 +109,24 @@ tb_bool_t           tb_trace_file_set(tb_file_ref_t file);
  */
 tb_bool_t           tb_trace_file_set_path(tb_char_t const* path, tb_bool_t bappend);
 
+/*! enable the async trace mode
+ *
+ * the lines will be formatted to the ring buffer of the current thread without any global lock,
+ * and a background thread will write them to the trace file in batches. 
+ *
+ * the print mode is not affected and the pending lines will be written by tb_trace_sync() and tb_exit().
+ *
+ * @param size      the ring buffer size of each thread, uses the default size if be zero
+ * @param policy    the policy when the ring buffer is full, e.g. TB_TRACE_ASYNC_POLICY_DROP
+ *
+ * @return          tb_true or tb_false
+ */
+tb_bool_t           tb_trace_async_init(tb_size_t size, tb_size_t policy);
+
+/*! disable the async trace mode and write all pending lines
+ */
+tb_void_t           tb_trace_async_exit(tb_noarg_t);
+
 /*! done trace with arguments
  *
  * @param prefix    the trace prefix
@@ -124,7 +150,7 @@ tb_void_t           tb_trace_done(tb_char_t const* prefix, tb_char_t const* modu
  */
 tb_void_t           tb_trace_tail(tb_char_t const* format, ...);
 
-/*! sync trace
+/*! sync trace, it will also write all pending lines of the async trace
  */
 tb_void_t           tb_trace_sync(tb_noarg_t);
 
@@ -37,7 +37,7 @@ target("tbox")
     add_packages("zlib", "mysql", "sqlite3")
 
     -- add options
-    add_options("info", "float", "wchar", "exception")
+    add_options("info", "float", "wchar", "exception", "lock_profiler")
 
     -- add modules
     add_options("xml", "zip", "hash", "regex", "coroutine", "object", "charset", "database")
@@ -52,7 +52,7 @@ target("tbox")
     add_files("memory/**.c") 
     add_files("string/**.c") 
     add_files("stream/**.c|**/charset.c|**/zip.c") 
-    add_files("network/**.c|impl/ssl/*.c") 
+    add_files("network/**.c|impl/ssl/*.c|http_server.c") 
     add_files("algorithm/**.c") 
     add_files("container/**.c|element/obj.c") 
     add_files("libm/impl/libm.c") 
@@ -89,6 +89,7 @@ target("tbox")
             add_files("platform/arch/context.S") 
         end
         add_files("coroutine/**.c") 
+        add_files("network/http_server.c") 
     end
 
     -- add the source files for the exception module
@@ -35,6 +35,301 @@
  */
 #include "node.h"
 
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the arena chunk size
+#ifdef __tb_small__
+#   define TB_XML_ARENA_CHUNK_SIZE          (1 << 14)
+#else
+#   define TB_XML_ARENA_CHUNK_SIZE          (1 << 16)
+#endif
+
+// the maximum name size for interning it on the stack
+#define TB_XML_ARENA_NAME_MAXN              (256)
+
+// the minimum childs count for indexing them
+#define TB_XML_ARENA_INDEX_CSIZE            (8)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the xml arena chunk type
+typedef struct __tb_xml_arena_chunk_t
+{
+    // the next chunk
+    struct __tb_xml_arena_chunk_t*  next;
+
+}tb_xml_arena_chunk_t;
+
+// the xml arena index key type
+typedef struct __tb_xml_arena_key_t
+{
+    // the parent node
+    tb_xml_node_ref_t               parent;
+
+    // the interned element name, tb_null: the childs of this parent have been indexed
+    tb_char_t const*                name;
+
+}tb_xml_arena_key_t;
+
+// the xml arena type
+typedef struct __tb_xml_arena_t
+{
+    // the chunks
+    tb_xml_arena_chunk_t*           chunks;
+
+    // the free space of the current chunk
+    tb_byte_t*                      head;
+    tb_byte_t*                      tail;
+
+    // the document node
+    tb_xml_node_ref_t               document;
+
+    // the interned names
+    tb_hash_set_ref_t               names;
+
+    // the childs index: (parent, name) => the first child element, optional
+    tb_hash_map_ref_t               index;
+
+}tb_xml_arena_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * arena
+ */
+static tb_void_t tb_xml_arena_exit(tb_xml_arena_t* arena)
+{
+    // check
+    tb_assert_and_check_return(arena);
+
+    // exit index
+    if (arena->index) tb_hash_map_exit(arena->index);
+    arena->index = tb_null;
+
+    // exit names
+    if (arena->names) tb_hash_set_exit(arena->names);
+    arena->names = tb_null;
+
+    // exit chunks
+    while (arena->chunks)
+    {
+        tb_xml_arena_chunk_t* next = arena->chunks->next;
+        tb_free(arena->chunks);
+        arena->chunks = next;
+    }
+
+    // exit it
+    tb_free(arena);
+}
+static tb_xml_arena_t* tb_xml_arena_init(tb_bool_t bindex)
+{
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_xml_arena_t* arena = tb_null;
+    do
+    {
+        // make arena
+        arena = tb_malloc0_type(tb_xml_arena_t);
+        tb_assert_and_check_break(arena);
+
+        // init names
+        arena->names = tb_hash_set_init(0, tb_element_str(tb_true));
+        tb_assert_and_check_break(arena->names);
+
+        // init index
+        if (bindex)
+        {
+            arena->index = tb_hash_map_init(0, tb_element_mem(sizeof(tb_xml_arena_key_t), tb_null, tb_null), tb_element_ptr(tb_null, tb_null));
+            tb_assert_and_check_break(arena->index);
+        }
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (arena) tb_xml_arena_exit(arena);
+        arena = tb_null;
+    }
+
+    // ok?
+    return arena;
+}
+static tb_pointer_t tb_xml_arena_malloc0(tb_xml_arena_t* arena, tb_size_t size)
+{
+    // check
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // align size
+    size = tb_align_cpu(size);
+
+    // the large data? alloc a single chunk for it and keep the current chunk
+    tb_byte_t* data = tb_null;
+    if (size > (TB_XML_ARENA_CHUNK_SIZE >> 2))
+    {
+        // make chunk
+        tb_xml_arena_chunk_t* chunk = (tb_xml_arena_chunk_t*)tb_malloc0(sizeof(tb_xml_arena_chunk_t) + size);
+        tb_assert_and_check_return_val(chunk, tb_null);
+
+        // insert it after the current chunk
+        if (arena->chunks)
+        {
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        }
+        else arena->chunks = chunk;
+
+        // ok
+        return (tb_pointer_t)(chunk + 1);
+    }
+
+    // no enough space? alloc a new chunk
+    if (arena->head + size > arena->tail)
+    {
+        // make chunk
+        tb_xml_arena_chunk_t* chunk = (tb_xml_arena_chunk_t*)tb_malloc_bytes(TB_XML_ARENA_CHUNK_SIZE);
+        tb_assert_and_check_return_val(chunk, tb_null);
+
+        // insert it to the head
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+
+        // the free space
+        arena->head = (tb_byte_t*)(chunk + 1);
+        arena->tail = (tb_byte_t*)chunk + TB_XML_ARENA_CHUNK_SIZE;
+    }
+
+    // alloc it
+    data = arena->head;
+    arena->head += size;
+
+    // clear it
+    tb_memset_(data, 0, size);
+
+    // ok
+    return (tb_pointer_t)data;
+}
+static tb_char_t const* tb_xml_arena_strndup(tb_xml_arena_t* arena, tb_char_t const* data, tb_size_t size)
+{
+    // make cstr
+    tb_char_t* cstr = (tb_char_t*)tb_xml_arena_malloc0(arena, size + 1);
+    tb_assert_and_check_return_val(cstr, tb_null);
+
+    // copy it, the tail has been cleared
+    if (size) tb_memcpy_(cstr, data, size);
+
+    // ok
+    return cstr;
+}
+static tb_char_t const* tb_xml_arena_intern(tb_xml_arena_t* arena, tb_char_t const* name, tb_size_t size, tb_bool_t binsert)
+{
+    // check
+    tb_assert_and_check_return_val(arena && arena->names && name, tb_null);
+
+    // make the null-terminated name, the large name is rare and copy it to the arena
+    tb_char_t           buff[TB_XML_ARENA_NAME_MAXN];
+    tb_char_t const*    cstr = buff;
+    if (size < sizeof(buff))
+    {
+        tb_memcpy_(buff, name, size);
+        buff[size] = '\0';
+    }
+    else cstr = tb_xml_arena_strndup(arena, name, size);
+    tb_assert_and_check_return_val(cstr, tb_null);
+
+    // find it first, the interned name will be replaced if we insert it again
+    tb_size_t itor = tb_hash_set_find(arena->names, cstr);
+    if (itor == tb_iterator_tail(arena->names))
+    {
+        // only find it?
+        tb_check_return_val(binsert, tb_null);
+
+        // insert it
+        itor = tb_hash_set_insert(arena->names, cstr);
+        tb_assert_and_check_return_val(itor != tb_iterator_tail(arena->names), tb_null);
+    }
+
+    // the interned name
+    return (tb_char_t const*)tb_iterator_item(arena->names, itor);
+}
+static tb_void_t tb_xml_arena_string(tb_string_ref_t string, tb_char_t const* cstr, tb_size_t size)
+{
+    /* refer to the arena data directly and mark it as readonly with the zero maxn, 
+     * it will be copied to the heap before modifying it, e.g. tb_string_cstrcpy()
+     */
+    string->data = (tb_byte_t*)cstr;
+    string->size = size + 1;
+    string->maxn = 0;
+}
+static tb_void_t tb_xml_arena_node_exit(tb_xml_node_ref_t node)
+{
+    // check
+    tb_assert_and_check_return(node);
+
+    // free the modified name & data, the readonly arena strings will not be freed
+    tb_string_exit(&node->name);
+    tb_string_exit(&node->data);
+
+    // free version & charset for document
+    if (node->type == TB_XML_NODE_TYPE_DOCUMENT)
+    {
+        tb_string_exit(&((tb_xml_document_t*)node)->version);
+        tb_string_exit(&((tb_xml_document_t*)node)->charset);
+    }
+
+    // free type
+    if (node->type == TB_XML_NODE_TYPE_DOCUMENT_TYPE)
+        tb_string_exit(&((tb_xml_document_type_t*)node)->type);
+
+    // free childs and attributes, the nodes will be released with the arena
+    tb_xml_node_ref_t next = node->chead;
+    for (; next; next = next->next) tb_xml_arena_node_exit(next);
+    for (next = node->ahead; next; next = next->next) tb_xml_arena_node_exit(next);
+}
+static tb_xml_node_ref_t tb_xml_arena_index_find(tb_xml_arena_t* arena, tb_xml_node_ref_t parent, tb_char_t const* name)
+{
+    // check
+    tb_assert_and_check_return_val(arena && arena->index && parent && name, tb_null);
+
+    // the childs of this parent have not been indexed? index them now
+    tb_xml_arena_key_t key;
+    key.parent  = parent;
+    key.name    = tb_null;
+    if (!tb_hash_map_get(arena->index, &key))
+    {
+        // index the first child element for each name
+        tb_xml_node_ref_t child = parent->chead;
+        for (; child; child = child->next)
+        {
+            if (child->type == TB_XML_NODE_TYPE_ELEMENT)
+            {
+                key.name = tb_string_cstr(&child->name);
+                if (key.name && !tb_hash_map_get(arena->index, &key)) tb_hash_map_insert(arena->index, &key, child);
+            }
+        }
+
+        // mark this parent as indexed
+        key.name = tb_null;
+        tb_hash_map_insert(arena->index, &key, parent);
+    }
+
+    // find it
+    key.name = name;
+    return (tb_xml_node_ref_t)tb_hash_map_get(arena->index, &key);
+}
+static tb_void_t tb_xml_arena_index_clear(tb_pointer_t self)
+{
+    // the childs have been changed, clear the index and reindex them lazily 
+    tb_xml_arena_t* arena = (tb_xml_arena_t*)self;
+    if (arena && arena->index && tb_hash_map_size(arena->index)) tb_hash_map_clear(arena->index);
+}
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
  */
@@ -156,8 +451,110 @@ tb_xml_node_ref_t tb_xml_node_init_document_type(tb_char_t const* type)
     // ok
     return node;
 }
+tb_xml_node_ref_t tb_xml_node_init_arena_document(tb_char_t const* version, tb_char_t const* charset, tb_bool_t bindex)
+{
+    // init arena
+    tb_xml_arena_t* arena = tb_xml_arena_init(bindex);
+    tb_assert_and_check_return_val(arena, tb_null);
+
+    // make node
+    tb_xml_node_ref_t node = (tb_xml_node_ref_t)tb_xml_arena_malloc0(arena, sizeof(tb_xml_document_t));
+    if (!node)
+    {
+        tb_xml_arena_exit(arena);
+        return tb_null;
+    }
+
+    // init 
+    if (!version) version = "2.0";
+    if (!charset) charset = "utf-8";
+    node->type = TB_XML_NODE_TYPE_DOCUMENT;
+    node->arena = arena;
+    tb_string_init(&node->data);
+    tb_xml_arena_string(&node->name, "#document", 9);
+    tb_xml_arena_string(&((tb_xml_document_t*)node)->version, tb_xml_arena_strndup(arena, version, tb_strlen(version)), tb_strlen(version));
+    tb_xml_arena_string(&((tb_xml_document_t*)node)->charset, tb_xml_arena_strndup(arena, charset, tb_strlen(charset)), tb_strlen(charset));
+
+    // save document
+    arena->document = node;
+
+    // ok
+    return node;
+}
+tb_xml_node_ref_t tb_xml_node_init_arena(tb_xml_node_ref_t document, tb_size_t type, tb_char_t const* name, tb_size_t nsize, tb_char_t const* data, tb_size_t dsize)
+{
+    // check
+    tb_xml_arena_t* arena = document? (tb_xml_arena_t*)document->arena : tb_null;
+    tb_assert_and_check_return_val(arena && arena->document == document, tb_null);
+
+    // make node
+    tb_xml_node_ref_t node = (tb_xml_node_ref_t)tb_xml_arena_malloc0(arena, type == TB_XML_NODE_TYPE_DOCUMENT_TYPE? sizeof(tb_xml_document_type_t) : sizeof(tb_xml_node_t));
+    tb_assert_and_check_return_val(node, tb_null);
+
+    // init type and arena
+    node->type = type;
+    node->arena = arena;
+
+    // init the empty strings, they can be modified later
+    tb_string_init(&node->name);
+    tb_string_init(&node->data);
+    if (type == TB_XML_NODE_TYPE_DOCUMENT_TYPE) tb_string_init(&((tb_xml_document_type_t*)node)->type);
+
+    // init name
+    switch (type)
+    {
+    case TB_XML_NODE_TYPE_ELEMENT:
+    case TB_XML_NODE_TYPE_ATTRIBUTE:
+        {
+            // intern name
+            tb_char_t const* cstr = name? tb_xml_arena_intern(arena, name, nsize, tb_true) : tb_null;
+            tb_assert_and_check_return_val(cstr || !name, tb_null);
+            if (cstr) tb_xml_arena_string(&node->name, cstr, nsize);
+        }
+        break;
+    case TB_XML_NODE_TYPE_TEXT:
+        tb_xml_arena_string(&node->name, "#text", 5);
+        break;
+    case TB_XML_NODE_TYPE_CDATA:
+        tb_xml_arena_string(&node->name, "#cdata", 6);
+        break;
+    case TB_XML_NODE_TYPE_COMMENT:
+        tb_xml_arena_string(&node->name, "#comment", 8);
+        break;
+    case TB_XML_NODE_TYPE_DOCUMENT_TYPE:
+        tb_xml_arena_string(&node->name, "#doctype", 8);
+        break;
+    default:
+        tb_assert_and_check_return_val(0, tb_null);
+        break;
+    }
+
+    // init data
+    if (data)
+    {
+        // copy data
+        tb_char_t const* cstr = tb_xml_arena_strndup(arena, data, dsize);
+        tb_assert_and_check_return_val(cstr, tb_null);
+
+        // save data
+        if (type == TB_XML_NODE_TYPE_DOCUMENT_TYPE) tb_xml_arena_string(&((tb_xml_document_type_t*)node)->type, cstr, dsize);
+        else tb_xml_arena_string(&node->data, cstr, dsize);
+    }
+
+    // ok
+    return node;
+}
 tb_void_t tb_xml_node_exit(tb_xml_node_ref_t node)
 {
+    // the arena node? free its modified strings and release the whole arena if it is the document
+    if (node && node->arena)
+    {
+        tb_xml_arena_t* arena = (tb_xml_arena_t*)node->arena;
+        tb_xml_arena_node_exit(node);
+        if (arena->document == node) tb_xml_arena_exit(arena);
+        return ;
+    }
+
     if (node)
     {
         // free name & data
@@ -250,7 +647,10 @@ tb_size_t tb_xml_node_asize(tb_xml_node_ref_t node)
 tb_void_t tb_xml_node_insert_next(tb_xml_node_ref_t node, tb_xml_node_ref_t next)
 {
     // check
-    tb_assert_and_check_return(node && next);
+    tb_assert_and_check_return(node && next && node->arena == next->arena);
+
+    // clear the childs index
+    tb_xml_arena_index_clear(node->arena);
 
     // init
     next->parent = node->parent;
@@ -264,6 +664,9 @@ tb_void_t tb_xml_node_remove_next(tb_xml_node_ref_t node)
     // check
     tb_assert_and_check_return(node);
 
+    // clear the childs index
+    tb_xml_arena_index_clear(node->arena);
+
     // next
     tb_xml_node_ref_t next = node->next;
 
@@ -279,7 +682,10 @@ tb_void_t tb_xml_node_remove_next(tb_xml_node_ref_t node)
 tb_void_t tb_xml_node_append_chead(tb_xml_node_ref_t node, tb_xml_node_ref_t child)
 {
     // check
-    tb_assert_and_check_return(node && child);
+    tb_assert_and_check_return(node && child && node->arena == child->arena);
+
+    // clear the childs index
+    tb_xml_arena_index_clear(node->arena);
 
     // init
     child->parent = node;
@@ -301,7 +707,10 @@ tb_void_t tb_xml_node_append_chead(tb_xml_node_ref_t node, tb_xml_node_ref_t chi
 tb_void_t tb_xml_node_append_ctail(tb_xml_node_ref_t node, tb_xml_node_ref_t child)
 {
     // check
-    tb_assert_and_check_return(node && child);
+    tb_assert_and_check_return(node && child && node->arena == child->arena);
+
+    // clear the childs index
+    tb_xml_arena_index_clear(node->arena);
 
     // init
     child->parent = node;
@@ -329,6 +738,9 @@ tb_void_t tb_xml_node_remove_chead(tb_xml_node_ref_t node)
     // null?
     tb_check_return(node->chead);
 
+    // clear the childs index
+    tb_xml_arena_index_clear(node->arena);
+
     // remove
     if (node->chead != node->ctail) 
     {
@@ -367,7 +779,7 @@ tb_void_t tb_xml_node_remove_ctail(tb_xml_node_ref_t node)
 tb_void_t tb_xml_node_append_ahead(tb_xml_node_ref_t node, tb_xml_node_ref_t attribute)
 {
     // check
-    tb_assert_and_check_return(node && attribute);
+    tb_assert_and_check_return(node && attribute && node->arena == attribute->arena);
 
     // init
     attribute->parent = node;
@@ -389,7 +801,7 @@ tb_void_t tb_xml_node_append_ahead(tb_xml_node_ref_t node, tb_xml_node_ref_t att
 tb_void_t tb_xml_node_append_atail(tb_xml_node_ref_t node, tb_xml_node_ref_t attribute)
 {
     // check
-    tb_assert_and_check_return(node && attribute);
+    tb_assert_and_check_return(node && attribute && node->arena == attribute->arena);
 
     // init
     attribute->parent = node;
@@ -423,6 +835,37 @@ tb_xml_node_ref_t tb_xml_node_goto(tb_xml_node_ref_t node, tb_char_t const* path
     // is self?
     if (!*p) return node;
 
+    // the arena node with the childs index and many childs? find the child elements from the index
+    tb_xml_arena_t* arena = (tb_xml_arena_t*)node->arena;
+    if (arena && arena->index && node->csize >= TB_XML_ARENA_INDEX_CSIZE)
+    {
+        // the name of this level
+        tb_char_t const* q = p; 
+        while (*q && *q != '/') q++;
+
+        // the interned name, no this child if not found
+        tb_char_t const* name = tb_xml_arena_intern(arena, p, q - p, tb_false);
+        tb_check_return_val(name, tb_null);
+
+        // walk the child elements with this name from the first one
+        for (node = tb_xml_arena_index_find(arena, node, name); node; node = node->next)
+        {
+            // is it? the interned names can be compared directly
+            if (node->type == TB_XML_NODE_TYPE_ELEMENT && tb_string_cstr(&node->name) == name)
+            {
+                // is it?
+                if (!*q) return node;
+
+                // goto the child node
+                tb_xml_node_ref_t c = tb_xml_node_goto(node, q);
+                if (c) return c;
+            }
+        }
+
+        // no
+        return tb_null;
+    }
+
     // size
     tb_size_t n = tb_strlen(p);
 
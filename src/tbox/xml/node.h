@@ -99,6 +99,9 @@ typedef struct __tb_xml_node_t
     /// the parent
     struct __tb_xml_node_t*     parent;
 
+    /// the arena of the arena document if this node is allocated from it, otherwise tb_null
+    tb_pointer_t                arena;
+
 }tb_xml_node_t;
 
 /// the xml element type
@@ -231,13 +234,47 @@ tb_xml_node_ref_t   tb_xml_node_init_document(tb_char_t const* version, tb_char_
  */
 tb_xml_node_ref_t   tb_xml_node_init_document_type(tb_char_t const* type);
 
+/*! init the arena document node 
+ *
+ * all nodes, names and texts of this document will be allocated from the document arena 
+ * and the element and attribute names are interned, so exiting the document releases them at once.
+ *
+ * @note the names and datas of the arena nodes refer to the arena and they are copied to the heap 
+ * before modifying them, e.g. tb_string_cstrcpy(&node->name, "name"), the copies will be freed with the node.
+ * the renamed elements will not be found by the names index of tb_xml_node_goto(), 
+ * and the heap nodes and the arena nodes cannot be mixed in the same tree
+ *
+ * @param version   the xml version
+ * @param encoding  the xml encoding
+ * @param bindex    index the child elements by names for tb_xml_node_goto()?
+ * @return          the document node
+ */
+tb_xml_node_ref_t   tb_xml_node_init_arena_document(tb_char_t const* version, tb_char_t const* encoding, tb_bool_t bindex);
+
+/*! init node from the arena of the given document
+ *
+ * @param document  the arena document node
+ * @param type      the node type
+ * @param name      the node name, uses the default name for the text, cdata, comment and document type node if be tb_null
+ * @param nsize     the name size
+ * @param data      the node data, the document type is passed by it for the document type node
+ * @param dsize     the data size
+ * @return          the node
+ */
+tb_xml_node_ref_t   tb_xml_node_init_arena(tb_xml_node_ref_t document, tb_size_t type, tb_char_t const* name, tb_size_t nsize, tb_char_t const* data, tb_size_t dsize);
+
 /*! exit the xml node 
+ *
+ * @note the arena nodes will be released with the arena document, 
+ * but the modified strings of the arena node need be freed by it if the node is not in the document tree
  *
  * @param node      the element node
  */
 tb_void_t           tb_xml_node_exit(tb_xml_node_ref_t node);
 
 /*! goto node by the gived path
+ *
+ * the child elements of the arena document will be indexed by names lazily if it has the index
  *
  * @param node      the root node
  * @return          the goto node
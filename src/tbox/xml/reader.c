@@ -35,6 +35,12 @@
  */
 #include "reader.h"
 #include "../charset/charset.h"
+#ifdef TB_ARCH_SSE2
+#   include <emmintrin.h>
+#endif
+#ifdef TB_ARCH_AVX2
+#   include <immintrin.h>
+#endif
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * macros
@@ -46,6 +52,17 @@
 #   define TB_XML_READER_ATTRIBUTES_MAXN        (128)
 #endif
 
+// the window size of the buffer mode
+#ifdef __tb_small__
+#   define TB_XML_READER_WINDOW_SIZE            (1 << 16)
+#else
+#   define TB_XML_READER_WINDOW_SIZE            (1 << 20)
+#endif
+
+// the swar mask of the matched bytes in the 64-bits data
+#define tb_xml_reader_swar_match(x, c)          tb_xml_reader_swar_zero((x) ^ (0x0101010101010101ULL * (tb_uint8_t)(c)))
+#define tb_xml_reader_swar_zero(x)              (((x) - 0x0101010101010101ULL) & ~(x) & 0x8080808080808080ULL)
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * types
  */
@@ -59,6 +76,9 @@ typedef struct __tb_xml_reader_impl_t
     // the level
     tb_size_t               level;
 
+    // the reader mode
+    tb_size_t               mode;
+
     // is bowner of the input stream?
     tb_bool_t               bowner;
     
@@ -95,6 +115,30 @@ typedef struct __tb_xml_reader_impl_t
     // the attributes
     tb_xml_attribute_t      attributes[TB_XML_READER_ATTRIBUTES_MAXN];
 
+    // the window head of the buffer mode, it is at the current stream offset
+    tb_char_t const*        wb;
+
+    // the parsed position of the window
+    tb_char_t const*        wp;
+
+    // the window end
+    tb_char_t const*        we;
+
+    // the left stream size from the window head
+    tb_hize_t               wl;
+
+    // the current token, it points into the window or the element and text string
+    tb_char_t const*        token;
+
+    // the current token size
+    tb_size_t               token_size;
+
+    // the decoded data of the slices
+    tb_buffer_t             decoded;
+
+    // the attribute slices
+    tb_xml_attribute_slice_t attribute_slices[TB_XML_READER_ATTRIBUTES_MAXN];
+
 }tb_xml_reader_impl_t;
 
 /* //////////////////////////////////////////////////////////////////////////////////////
@@ -142,6 +186,485 @@ static tb_char_t const* tb_xml_reader_text_parse(tb_xml_reader_impl_t* reader)
     }
     return tb_null;
 }
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * buffer parser implementation
+ */
+static __tb_inline__ tb_char_t const* tb_xml_reader_find(tb_char_t const* p, tb_char_t const* e, tb_char_t c0, tb_char_t c1, tb_char_t c2)
+{
+#if defined(TB_ARCH_AVX2)
+    // find the given characters, 32 bytes per step
+    __m256i x0 = _mm256_set1_epi8(c0);
+    __m256i x1 = _mm256_set1_epi8(c1);
+    __m256i x2 = _mm256_set1_epi8(c2);
+    while (p + 32 <= e)
+    {
+        __m256i     data = _mm256_loadu_si256((__m256i const*)p);
+        __m256i     mask = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(data, x0), _mm256_cmpeq_epi8(data, x1)), _mm256_cmpeq_epi8(data, x2));
+        tb_uint32_t bits = (tb_uint32_t)_mm256_movemask_epi8(mask);
+        if (bits) return p + tb_bits_fb1_u32_le(bits);
+        p += 32;
+    }
+#endif
+
+#if defined(TB_ARCH_SSE2)
+    // find the given characters, 16 bytes per step
+    __m128i y0 = _mm_set1_epi8(c0);
+    __m128i y1 = _mm_set1_epi8(c1);
+    __m128i y2 = _mm_set1_epi8(c2);
+    while (p + 16 <= e)
+    {
+        __m128i     data = _mm_loadu_si128((__m128i const*)p);
+        __m128i     mask = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(data, y0), _mm_cmpeq_epi8(data, y1)), _mm_cmpeq_epi8(data, y2));
+        tb_uint32_t bits = (tb_uint32_t)_mm_movemask_epi8(mask);
+        if (bits) return p + tb_bits_fb1_u32_le(bits);
+        p += 16;
+    }
+#else
+    /* find the given characters, 8 bytes per step
+     *
+     * the false positives only appear after the first matched byte, 
+     * so the lowest bit of the mask is always exact
+     */
+    while (p + 8 <= e)
+    {
+        tb_uint64_t data = tb_bits_get_u64_le(p);
+        tb_uint64_t mask = tb_xml_reader_swar_match(data, c0) | tb_xml_reader_swar_match(data, c1) | tb_xml_reader_swar_match(data, c2);
+        if (mask) return p + (tb_bits_fb1_u64_le(mask) >> 3);
+        p += 8;
+    }
+#endif
+
+    // find the left data
+    while (p < e && *p != c0 && *p != c1 && *p != c2) p++;
+    return p;
+}
+static tb_void_t tb_xml_reader_window_sync(tb_xml_reader_impl_t* reader)
+{
+    // skip the parsed data of the window
+    if (reader->wp > reader->wb) tb_stream_skip(reader->rstream, reader->wp - reader->wb);
+
+    // clear the window
+    reader->wb = tb_null;
+    reader->wp = tb_null;
+    reader->we = tb_null;
+    reader->wl = 0;
+}
+static tb_bool_t tb_xml_reader_window_fill(tb_xml_reader_impl_t* reader, tb_size_t size)
+{
+    // skip the parsed data first
+    tb_xml_reader_window_sync(reader);
+
+    // the stream size is unknown? we can not need the window data
+    tb_check_return_val(tb_stream_size(reader->rstream) >= 0, tb_false);
+
+    // end?
+    tb_hize_t left = tb_stream_left(reader->rstream);
+    tb_check_return_val(left, tb_true);
+
+    // need the window data, it will not be copied for the data and mapped file stream
+    tb_byte_t*  data = tb_null;
+    tb_size_t   need = (tb_size_t)tb_min(left, tb_max(size, TB_XML_READER_WINDOW_SIZE));
+    if (!tb_stream_need(reader->rstream, &data, need) || !data) return tb_false;
+
+    // save the window
+    reader->wb = (tb_char_t const*)data;
+    reader->wp = reader->wb;
+    reader->we = reader->wb + need;
+    reader->wl = left;
+    return tb_true;
+}
+static tb_hize_t tb_xml_reader_window_offset(tb_xml_reader_impl_t* reader)
+{
+    // the stream offset is at the window head
+    return tb_stream_offset(reader->rstream) + (reader->wp - reader->wb);
+}
+static tb_bool_t tb_xml_reader_window_seek(tb_xml_reader_impl_t* reader, tb_hize_t offset)
+{
+    // clear the window, the stream offset is at the window head
+    reader->wb = tb_null;
+    reader->wp = tb_null;
+    reader->we = tb_null;
+    reader->wl = 0;
+
+    // seek it
+    return tb_stream_seek(reader->rstream, offset);
+}
+static tb_void_t tb_xml_reader_document_done(tb_xml_reader_impl_t* reader)
+{
+    // done
+    do
+    {
+        // update version & charset
+        tb_xml_node_ref_t attr = (tb_xml_node_ref_t)tb_xml_reader_attributes((tb_xml_reader_ref_t)reader); 
+        for (; attr; attr = attr->next)
+        {
+            if (!tb_string_cstricmp(&attr->name, "version")) tb_string_strcpy(&reader->version, &attr->data);
+            if (!tb_string_cstricmp(&attr->name, "encoding")) tb_string_strcpy(&reader->charset, &attr->data);
+        }
+
+        // transform stream => utf-8
+        if (tb_string_cstricmp(&reader->charset, "utf-8") && tb_string_cstricmp(&reader->charset, "utf8"))
+        {
+            // charset
+            tb_size_t charset = TB_CHARSET_TYPE_UTF8;
+            if (!tb_string_cstricmp(&reader->charset, "gb2312") || !tb_string_cstricmp(&reader->charset, "gbk")) 
+                charset = TB_CHARSET_TYPE_GB2312;
+            else tb_trace_e("the charset: %s is not supported", tb_string_cstr(&reader->charset));
+
+            // init transform stream
+            if (charset != TB_CHARSET_TYPE_UTF8)
+            {
+#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
+                // skip the parsed data of the window, the filter stream will read the left data
+                tb_xml_reader_window_sync(reader);
+
+                // init the filter stream
+                if (!reader->fstream) reader->fstream = tb_stream_init_filter_from_charset(reader->istream, charset, TB_CHARSET_TYPE_UTF8);
+                else
+                {
+                    // ctrl stream
+                    if (!tb_stream_ctrl(reader->fstream, TB_STREAM_CTRL_FLTR_SET_STREAM, reader->istream)) break;
+
+                    // the filter
+                    tb_filter_ref_t filter = tb_null;
+                    if (!tb_stream_ctrl(reader->fstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) break;
+                    tb_assert_and_check_break(filter);
+
+                    // ctrl filter
+                    if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_CHARSET_SET_FTYPE, charset)) break;
+                }
+
+                // open the filter stream
+                if (reader->fstream && tb_stream_open(reader->fstream))
+                    reader->rstream = reader->fstream;
+                tb_string_cstrcpy(&reader->charset, "utf-8");
+#else
+                // trace
+                tb_trace_e("unicode type is not supported, please enable charset module config if you want to use it!");
+#endif
+            }
+        }
+
+    } while (0);
+}
+static tb_char_t const* tb_xml_reader_window_element(tb_char_t const* p, tb_char_t const* e)
+{
+    // is comment: <!-- text -->? find the first '>' after "--"
+    tb_char_t const* b = p;
+    if (e - p >= 3 && p[0] == '!' && p[1] == '-' && p[2] == '-')
+    {
+        for (p = tb_xml_reader_find(p + 3, e, '>', '>', '>'); p < e; p = tb_xml_reader_find(p + 1, e, '>', '>', '>'))
+            if (p[-1] == '-' && p[-2] == '-') return p;
+        return tb_null;
+    }
+
+    // is cdata: <![CDATA[ text ]]>? find the first '>' after "]]"
+    if (e - p >= 8 && !tb_strnicmp(p, "![CDATA[", 8))
+    {
+        for (p = tb_xml_reader_find(p + 8, e, '>', '>', '>'); p < e; p = tb_xml_reader_find(p + 1, e, '>', '>', '>'))
+            if (p - b >= 10 && p[-1] == ']' && p[-2] == ']') return p;
+        return tb_null;
+    }
+
+    // find the element end and skip the quoted attribute data
+    while (1)
+    {
+        p = tb_xml_reader_find(p, e, '>', '\"', '\'');
+        if (p == e) return tb_null;
+        else if (*p == '>') return p;
+
+        p = tb_xml_reader_find(p + 1, e, *p, *p, *p);
+        if (p == e) return tb_null;
+        p++;
+    }
+    return tb_null;
+}
+static tb_bool_t tb_xml_reader_window_next(tb_xml_reader_impl_t* reader)
+{
+    // done
+    while (!reader->event)
+    {
+        // no data? fill the window
+        if (reader->wp == reader->we)
+        {
+            if (!tb_xml_reader_window_fill(reader, 0)) return tb_false;
+            tb_check_break(reader->wp < reader->we);
+        }
+
+        // have all the left data in the window?
+        tb_char_t const*    p = reader->wp;
+        tb_char_t const*    e = reader->we;
+        tb_bool_t           bend = (tb_hize_t)(e - reader->wb) >= reader->wl;
+
+        // is element?
+        if (*p == '<')
+        {
+            // find the element end: <...>
+            tb_char_t const* q = tb_xml_reader_window_element(p + 1, e);
+            if (!q)
+            {
+                // grow the window and parse it again
+                if (!bend)
+                {
+                    if (!tb_xml_reader_window_fill(reader, (e - p) << 1)) return tb_false;
+                    continue;
+                }
+
+                // failed
+                tb_assertf(0, "invalid element: %.*s from %s", (tb_int_t)tb_min(e - p, 256), p, tb_url_cstr(tb_stream_url(reader->istream)));
+                reader->wp = e;
+                break;
+            }
+
+            // save the element
+            tb_char_t const*    element = p + 1;
+            tb_size_t           size = q - element;
+            reader->token       = element;
+            reader->token_size  = size;
+            reader->wp          = q + 1;
+
+            // is document begin: <?xml version="..." charset=".." ?>
+            if (size > 4 && !tb_strnicmp(element, "?xml", 4))
+            {
+                // update event
+                reader->event = TB_XML_READER_EVENT_DOCUMENT;
+
+                // update version & charset
+                tb_xml_reader_document_done(reader);
+            }
+            // is document type: <!DOCTYPE ... >
+            else if (size > 8 && !tb_strnicmp(element, "!DOCTYPE", 8))
+                reader->event = TB_XML_READER_EVENT_DOCUMENT_TYPE;
+            // is element end: </name>
+            else if (size > 1 && element[0] == '/')
+            {
+                // check
+                tb_check_break(reader->level);
+
+                // update event
+                reader->event = TB_XML_READER_EVENT_ELEMENT_END;
+
+                // leave
+                reader->level--;
+            }
+            // is comment: <!-- text -->
+            else if (size >= 3 && !tb_strncmp(element, "!--", 3))
+                reader->event = TB_XML_READER_EVENT_COMMENT;
+            // is cdata: <![CDATA[ text ]]>
+            else if (size >= 8 && !tb_strnicmp(element, "![CDATA[", 8))
+                reader->event = TB_XML_READER_EVENT_CDATA;
+            // is empty element: <name/>
+            else if (size > 1 && element[size - 1] == '/')
+                reader->event = TB_XML_READER_EVENT_ELEMENT_EMPTY;
+            // is element begin: <name>
+            else
+            {
+                // update event
+                reader->event = TB_XML_READER_EVENT_ELEMENT_BEG;
+
+                // enter
+                reader->level++;
+            }
+
+            // trace
+            tb_trace_d("<%.*s>", (tb_int_t)size, element);
+        }
+        // is text: <> text </>
+        else if (*p)
+        {
+            // find the text end
+            tb_char_t const* q = tb_xml_reader_find(p, e, '<', '<', '<');
+            if (q == e)
+            {
+                // grow the window and parse it again
+                if (!bend)
+                {
+                    if (!tb_xml_reader_window_fill(reader, (e - p) << 1)) return tb_false;
+                    continue;
+                }
+
+                // no element after the text, discard it
+                reader->wp = e;
+                continue;
+            }
+
+            // save the text
+            tb_size_t size      = q - p;
+            reader->token       = p;
+            reader->token_size  = size;
+            reader->wp          = q;
+
+            // update event
+            if (!(size == 2 && p[0] == '\r' && p[1] == '\n') && !(size == 1 && p[0] == '\n'))
+                reader->event = TB_XML_READER_EVENT_TEXT;
+
+            // trace
+            tb_trace_d("%.*s", (tb_int_t)size, p);
+        }
+        // skip the invalid character
+        else reader->wp++;
+    }
+
+    // ok
+    return tb_true;
+}
+static tb_size_t tb_xml_reader_entity_decode(tb_char_t* data, tb_char_t const* p, tb_size_t size)
+{
+    // done, the decoded data is always not larger than the input data
+    tb_char_t*          d = data;
+    tb_char_t const*    e = p + size;
+    while (p < e)
+    {
+        // copy the plain data
+        tb_char_t const* q = tb_xml_reader_find(p, e, '&', '&', '&');
+        if (q > p)
+        {
+            tb_memcpy_(d, p, q - p);
+            d += q - p;
+            p = q;
+        }
+        tb_check_break(p < e);
+
+        // find the entity end: &...;
+        for (q = p + 1; q < e && q - p < 12 && *q != ';'; q++) ;
+
+        // decode the entity
+        tb_uint32_t         ch = 0;
+        tb_char_t const*    b = p + 1;
+        tb_size_t           n = q - b;
+        if (q < e && *q == ';')
+        {
+            if (n == 2 && b[0] == 'l' && b[1] == 't') ch = '<';
+            else if (n == 2 && b[0] == 'g' && b[1] == 't') ch = '>';
+            else if (n == 3 && !tb_strncmp(b, "amp", 3)) ch = '&';
+            else if (n == 4 && !tb_strncmp(b, "quot", 4)) ch = '\"';
+            else if (n == 4 && !tb_strncmp(b, "apos", 4)) ch = '\'';
+            else if (n > 1 && b[0] == '#')
+            {
+                // &#xhhhh; or &#dddd;
+                tb_char_t const* c = b + 1;
+                if (*c == 'x' || *c == 'X')
+                {
+                    for (c++; c < q && tb_isdigit16(*c); c++) 
+                        ch = (ch << 4) + (tb_isdigit10(*c)? (*c - '0') : ((*c | 0x20) - 'a' + 10));
+                }
+                else for (; c < q && tb_isdigit10(*c); c++) ch = ch * 10 + (*c - '0');
+
+                // invalid?
+                if (c != q || ch > 0x10ffff) ch = 0;
+            }
+        }
+
+        // invalid entity? copy the '&' character
+        if (!ch)
+        {
+            *d++ = *p++;
+            continue;
+        }
+
+        // append the utf-8 character
+        if (ch < 0x80) *d++ = (tb_char_t)ch;
+        else if (ch < 0x800)
+        {
+            *d++ = (tb_char_t)(0xc0 | (ch >> 6));
+            *d++ = (tb_char_t)(0x80 | (ch & 0x3f));
+        }
+        else if (ch < 0x10000)
+        {
+            *d++ = (tb_char_t)(0xe0 | (ch >> 12));
+            *d++ = (tb_char_t)(0x80 | ((ch >> 6) & 0x3f));
+            *d++ = (tb_char_t)(0x80 | (ch & 0x3f));
+        }
+        else
+        {
+            *d++ = (tb_char_t)(0xf0 | (ch >> 18));
+            *d++ = (tb_char_t)(0x80 | ((ch >> 12) & 0x3f));
+            *d++ = (tb_char_t)(0x80 | ((ch >> 6) & 0x3f));
+            *d++ = (tb_char_t)(0x80 | (ch & 0x3f));
+        }
+        p = q + 1;
+    }
+
+    // ok
+    return d - data;
+}
+static tb_xml_attribute_slice_t const* tb_xml_reader_attribute_parse(tb_xml_reader_impl_t* impl, tb_size_t* psize, tb_bool_t bdecode)
+{
+    // check
+    tb_assert_and_check_return_val(impl && psize && impl->token && ( impl->event == TB_XML_READER_EVENT_DOCUMENT
+                                                                ||  impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                                ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                                ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
+
+    // init
+    tb_char_t const*    p = impl->token;
+    tb_char_t const*    e = p + impl->token_size;
+    tb_size_t           n = 0;
+    tb_size_t           decoded = 0;
+
+    // skip name
+    while (p < e && !tb_isspace(*p)) p++;
+
+    // parse attributes: name = "data" or name = 'data'
+    while (p < e && n < TB_XML_READER_ATTRIBUTES_MAXN)
+    {
+        // parse name
+        while (p < e && tb_isspace(*p)) p++;
+        tb_char_t const* b = p;
+        while (p < e && *p != '=' && !tb_isspace(*p)) p++;
+        tb_char_t const* q = p;
+
+        // skip '='
+        while (p < e && tb_isspace(*p)) p++;
+        tb_check_break(p < e && *p == '=' && q > b);
+        p++;
+        while (p < e && tb_isspace(*p)) p++;
+        tb_check_break(p < e && (*p == '\"' || *p == '\''));
+
+        // find the data end
+        tb_char_t const* d = p + 1;
+        p = tb_xml_reader_find(d, e, *p, *p, *p);
+        tb_check_break(p < e);
+
+        // save the attribute
+        tb_xml_attribute_slice_t* attr = &impl->attribute_slices[n++];
+        attr->name.data = b;
+        attr->name.size = q - b;
+        attr->data.data = d;
+        attr->data.size = p - d;
+
+        // has entities? 
+        if (bdecode && tb_xml_reader_find(d, p, '&', '&', '&') < p) decoded += p - d;
+        p++;
+    }
+
+    // decode the entities of the attribute data
+    if (decoded)
+    {
+        // make the decoded data, the data size will not be larger than the input size
+        tb_char_t* data = (tb_char_t*)tb_buffer_resize(&impl->decoded, decoded);
+        tb_assert_and_check_return_val(data, tb_null);
+
+        // decode them
+        tb_size_t i = 0;
+        for (i = 0; i < n; i++)
+        {
+            tb_xml_attribute_slice_t* attr = &impl->attribute_slices[i];
+            tb_char_t const* b = attr->data.data;
+            tb_char_t const* q = b + attr->data.size;
+            if (tb_xml_reader_find(b, q, '&', '&', '&') < q)
+            {
+                attr->data.size = tb_xml_reader_entity_decode(data, b, q - b);
+                attr->data.data = data;
+                data += attr->data.size;
+            }
+        }
+    }
+
+    // ok?
+    *psize = n;
+    return n? impl->attribute_slices : tb_null;
+}
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * implementation
@@ -163,6 +686,12 @@ tb_xml_reader_ref_t tb_xml_reader_init()
     tb_string_cstrcpy(&reader->version, "2.0");
     tb_string_cstrcpy(&reader->charset, "utf-8");
 
+    // init the decoded data
+    tb_buffer_init(&reader->decoded);
+
+    // init mode
+    reader->mode = TB_XML_READER_MODE_BUFFER;
+
     // init attributes
     tb_size_t i = 0;
     for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -208,6 +737,9 @@ tb_void_t tb_xml_reader_exit(tb_xml_reader_ref_t reader)
     // exit attribute data
     tb_string_exit(&impl->attribute_data);
 
+    // exit the decoded data
+    tb_buffer_exit(&impl->decoded);
+
     // exit attributes
     tb_long_t i = 0;
     for (i = 0; i < TB_XML_READER_ATTRIBUTES_MAXN; i++)
@@ -236,6 +768,16 @@ tb_bool_t tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream,
         // init level
         impl->level = 0;
 
+        // init window
+        impl->wb = tb_null;
+        impl->wp = tb_null;
+        impl->we = tb_null;
+        impl->wl = 0;
+
+        // init token
+        impl->token = tb_null;
+        impl->token_size = 0;
+
         // init owner
         impl->bowner = bowner;
         
@@ -289,6 +831,16 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
     tb_assert_and_check_return(impl);
 
+    // clear window
+    impl->wb = tb_null;
+    impl->wp = tb_null;
+    impl->we = tb_null;
+    impl->wl = 0;
+
+    // clear token
+    impl->token = tb_null;
+    impl->token_size = 0;
+
     // clos the reader stream
     if (impl->rstream) tb_stream_clos(impl->rstream);
     impl->rstream = tb_null;
@@ -327,12 +879,26 @@ tb_void_t tb_xml_reader_clos(tb_xml_reader_ref_t reader)
         tb_string_clear(&node->data);
     }
 }
+tb_void_t tb_xml_reader_mode_set(tb_xml_reader_ref_t reader, tb_size_t mode)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return(impl);
+
+    // skip the parsed data of the window if leave the buffer mode
+    if (mode != TB_XML_READER_MODE_BUFFER && impl->rstream) tb_xml_reader_window_sync(impl);
+
+    // save mode
+    impl->mode = mode;
+}
 tb_stream_ref_t tb_xml_reader_stream(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
     tb_assert_and_check_return_val(impl, tb_null);
 
+    // skip the parsed data of the window, the stream will be used directly
+    if (impl->rstream) tb_xml_reader_window_sync(impl);
     return impl->rstream;
 }
 tb_size_t tb_xml_reader_level(tb_xml_reader_ref_t reader)
@@ -352,6 +918,9 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
     // reset event
     impl->event = TB_XML_READER_EVENT_NONE;
 
+    // tokenize the buffered data directly if the stream size is known
+    if (impl->mode == TB_XML_READER_MODE_BUFFER && tb_xml_reader_window_next(impl)) return impl->event;
+
     // next
     while (!impl->event)
     {
@@ -366,60 +935,19 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             tb_char_t const* element = tb_xml_reader_element_parse(impl);
             tb_assert_and_check_break(element);
 
-            // is document begin: <?xml version="..." charset=".." ?>
+            // save the element token
             tb_size_t size = tb_string_size(&impl->element);
+            impl->token         = element;
+            impl->token_size    = size;
+
+            // is document begin: <?xml version="..." charset=".." ?>
             if (size > 4 && !tb_strnicmp(element, "?xml", 4))
             {
                 // update event
                 impl->event = TB_XML_READER_EVENT_DOCUMENT;
 
                 // update version & charset
-                tb_xml_node_ref_t attr = (tb_xml_node_ref_t)tb_xml_reader_attributes(reader); 
-                for (; attr; attr = attr->next)
-                {
-                    if (!tb_string_cstricmp(&attr->name, "version")) tb_string_strcpy(&impl->version, &attr->data);
-                    if (!tb_string_cstricmp(&attr->name, "encoding")) tb_string_strcpy(&impl->charset, &attr->data);
-                }
-
-                // transform stream => utf-8
-                if (tb_string_cstricmp(&impl->charset, "utf-8") && tb_string_cstricmp(&impl->charset, "utf8"))
-                {
-                    // charset
-                    tb_size_t charset = TB_CHARSET_TYPE_UTF8;
-                    if (!tb_string_cstricmp(&impl->charset, "gb2312") || !tb_string_cstricmp(&impl->charset, "gbk")) 
-                        charset = TB_CHARSET_TYPE_GB2312;
-                    else tb_trace_e("the charset: %s is not supported", tb_string_cstr(&impl->charset));
-
-                    // init transform stream
-                    if (charset != TB_CHARSET_TYPE_UTF8)
-                    {
-#ifdef TB_CONFIG_MODULE_HAVE_CHARSET
-                        // init the filter stream
-                        if (!impl->fstream) impl->fstream = tb_stream_init_filter_from_charset(impl->istream, charset, TB_CHARSET_TYPE_UTF8);
-                        else
-                        {
-                            // ctrl stream
-                            if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_SET_STREAM, impl->istream)) break;
-
-                            // the filter
-                            tb_filter_ref_t filter = tb_null;
-                            if (!tb_stream_ctrl(impl->fstream, TB_STREAM_CTRL_FLTR_GET_FILTER, &filter)) break;
-                            tb_assert_and_check_break(filter);
-
-                            // ctrl filter
-                            if (!tb_filter_ctrl(filter, TB_FILTER_CTRL_CHARSET_SET_FTYPE, charset)) break;
-                        }
-
-                        // open the filter stream
-                        if (impl->fstream && tb_stream_open(impl->fstream))
-                            impl->rstream = impl->fstream;
-                        tb_string_cstrcpy(&impl->charset, "utf-8");
-#else
-                        // trace
-                        tb_trace_e("unicode type is not supported, please enable charset module config if you want to use it!");
-#endif
-                    }
-                }
+                tb_xml_reader_document_done(impl);
             }
             // is document type: <!DOCTYPE ... >
             else if (size > 8 && !tb_strnicmp(element, "!DOCTYPE", 8))
@@ -516,6 +1044,10 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
                 impl->level++;
             }
 
+            // update the element token, the comment and cdata may be appended
+            impl->token         = tb_string_cstr(&impl->element);
+            impl->token_size    = tb_string_size(&impl->element);
+
             // trace
             tb_trace_d("<%s>", element);
         }
@@ -527,6 +1059,10 @@ tb_size_t tb_xml_reader_next(tb_xml_reader_ref_t reader)
             if (text && tb_string_cstrcmp(&impl->text, "\r\n") && tb_string_cstrcmp(&impl->text, "\n"))
                 impl->event = TB_XML_READER_EVENT_TEXT;
 
+            // save the text token
+            impl->token         = text;
+            impl->token_size    = tb_string_size(&impl->text);
+
             // trace
             tb_trace_d("%s", text);
         }
@@ -553,7 +1089,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
     impl->level = 0;
 
     // seek to the stream head
-    if (!tb_stream_seek(impl->rstream, 0)) return tb_false;
+    if (!tb_xml_reader_window_seek(impl, 0)) return tb_false;
 
     // init
     tb_static_string_t  s;
@@ -561,7 +1097,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
     if (!tb_static_string_init(&s, data, 8192)) return tb_false;
 
     // save the current offset
-    tb_hize_t save = tb_stream_offset(impl->rstream);
+    tb_hize_t save = tb_xml_reader_window_offset(impl);
 
     // done
     tb_bool_t ok = tb_false;
@@ -592,7 +1128,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
                 tb_static_string_strip(&s, n);
 
                 // restore
-                if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
+                if (ok) if (!(ok = tb_xml_reader_window_seek(impl, save))) leave = tb_true;
             }
             break;
         case TB_XML_READER_EVENT_ELEMENT_BEG: 
@@ -612,7 +1148,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
                 tb_trace_d("path: %s", tb_static_string_cstr(&s));
 
                 // restore
-                if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
+                if (ok) if (!(ok = tb_xml_reader_window_seek(impl, save))) leave = tb_true;
             }
             break;
         case TB_XML_READER_EVENT_ELEMENT_END: 
@@ -628,7 +1164,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
                 tb_trace_d("path: %s", tb_static_string_cstr(&s));
 
                 // restore
-                if (ok) if (!(ok = tb_stream_seek(impl->rstream, save))) leave = tb_true;
+                if (ok) if (!(ok = tb_xml_reader_window_seek(impl, save))) leave = tb_true;
             }
             break;
         default:
@@ -636,7 +1172,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
         }
 
         // save
-        save = tb_stream_offset(impl->rstream);
+        save = tb_xml_reader_window_offset(impl);
     }
 
     // exit string
@@ -646,7 +1182,7 @@ tb_bool_t tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t const* path)
     impl->level = 0;
 
     // failed? restore to the stream head
-    if (!ok) tb_stream_seek(impl->rstream, 0);
+    if (!ok) tb_xml_reader_window_seek(impl, 0);
 
     // ok?
     return ok;
@@ -778,6 +1314,131 @@ tb_xml_node_ref_t tb_xml_reader_load(tb_xml_reader_ref_t reader)
     // ok
     return node;
 }
+tb_xml_node_ref_t tb_xml_reader_load_arena(tb_xml_reader_ref_t reader, tb_bool_t bindex)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl, tb_null);
+
+    // done
+    tb_bool_t           ok = tb_true;
+    tb_xml_node_ref_t   node = tb_null;
+    tb_xml_node_ref_t   document = tb_null;
+    tb_xml_slice_t      slice;
+    tb_size_t           event = TB_XML_READER_EVENT_NONE;
+    while (ok && (event = tb_xml_reader_next(reader)))
+    {
+        // init document node
+        if (!document)
+        {
+            node = document = tb_xml_node_init_arena_document(tb_xml_reader_version(reader), tb_xml_reader_charset(reader), bindex);
+            tb_assert_and_check_break_state(document, ok, tb_false);
+        }
+
+        switch (event)
+        {
+        case TB_XML_READER_EVENT_DOCUMENT:
+            break;
+        case TB_XML_READER_EVENT_DOCUMENT_TYPE:
+            {
+                // init
+                tb_char_t const*    type = tb_xml_reader_doctype(reader);
+                tb_xml_node_ref_t   doctype = tb_xml_node_init_arena(document, TB_XML_NODE_TYPE_DOCUMENT_TYPE, tb_null, 0, type? type : "", type? tb_strlen(type) : 0);
+                tb_assert_and_check_break_state(doctype, ok, tb_false);
+                
+                // append
+                tb_xml_node_append_ctail(node, doctype); 
+                tb_assert_and_check_break_state(doctype->parent, ok, tb_false);
+            }
+            break;
+        case TB_XML_READER_EVENT_ELEMENT_EMPTY: 
+        case TB_XML_READER_EVENT_ELEMENT_BEG: 
+            {
+                // init
+                tb_assert_and_check_break_state(tb_xml_reader_element_slice(reader, &slice), ok, tb_false);
+                tb_xml_node_ref_t element = tb_xml_node_init_arena(document, TB_XML_NODE_TYPE_ELEMENT, slice.data, slice.size, tb_null, 0);
+                tb_assert_and_check_break_state(element, ok, tb_false);
+
+                // attributes, keep the entities of the attribute data like tb_xml_reader_load()
+                tb_size_t                       i = 0;
+                tb_size_t                       n = 0;
+                tb_xml_attribute_slice_t const* attrs = tb_xml_reader_attribute_parse(impl, &n, tb_false);
+                for (i = 0; i < n && ok; i++)
+                {
+                    tb_xml_node_ref_t attr = tb_xml_node_init_arena(document, TB_XML_NODE_TYPE_ATTRIBUTE, attrs[i].name.data, attrs[i].name.size, attrs[i].data.data, attrs[i].data.size);
+                    tb_assert_and_check_break_state(attr, ok, tb_false);
+                    tb_xml_node_append_atail(element, attr);
+                }
+                tb_check_break(ok);
+
+                // append
+                tb_xml_node_append_ctail(node, element); 
+                tb_assert_and_check_break_state(element->parent, ok, tb_false);
+
+                // enter
+                if (event == TB_XML_READER_EVENT_ELEMENT_BEG) node = element;
+            }
+            break;
+        case TB_XML_READER_EVENT_ELEMENT_END: 
+            {
+                // check
+                tb_assert_and_check_break_state(node, ok, tb_false);
+
+                // the parent node, ignore the unmatched element end
+                if (node != document) node = node->parent;
+            }
+            break;
+        case TB_XML_READER_EVENT_TEXT: 
+        case TB_XML_READER_EVENT_CDATA: 
+        case TB_XML_READER_EVENT_COMMENT: 
+            {
+                // the slice and node type
+                tb_size_t type = TB_XML_NODE_TYPE_NONE;
+                switch (event)
+                {
+                case TB_XML_READER_EVENT_TEXT:
+                    // keep the entities of the text like tb_xml_reader_load()
+                    type = TB_XML_NODE_TYPE_TEXT;
+                    slice.data = impl->token;
+                    slice.size = impl->token_size;
+                    ok = slice.data != tb_null;
+                    break;
+                case TB_XML_READER_EVENT_CDATA:
+                    type = TB_XML_NODE_TYPE_CDATA;
+                    ok = tb_xml_reader_cdata_slice(reader, &slice);
+                    break;
+                default:
+                    type = TB_XML_NODE_TYPE_COMMENT;
+                    ok = tb_xml_reader_comment_slice(reader, &slice);
+                    break;
+                }
+                tb_assert_and_check_break(ok);
+
+                // init
+                tb_xml_node_ref_t text = tb_xml_node_init_arena(document, type, tb_null, 0, slice.data, slice.size);
+                tb_assert_and_check_break_state(text, ok, tb_false);
+                
+                // append
+                tb_xml_node_append_ctail(node, text); 
+                tb_assert_and_check_break_state(text->parent, ok, tb_false);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (document) tb_xml_node_exit(document);
+        document = tb_null;
+    }
+
+    // ok
+    return document;
+}
 tb_char_t const* tb_xml_reader_version(tb_xml_reader_ref_t reader)
 {
     // check
@@ -803,8 +1464,8 @@ tb_char_t const* tb_xml_reader_comment(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_COMMENT, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
     tb_assert_and_check_return_val(p && n >= 6, tb_null);
 
     // comment
@@ -818,8 +1479,8 @@ tb_char_t const* tb_xml_reader_cdata(tb_xml_reader_ref_t reader)
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_CDATA, tb_null);
 
     // init
-    tb_char_t const*    p = tb_string_cstr(&impl->element);
-    tb_size_t           n = tb_string_size(&impl->element);
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
     tb_assert_and_check_return_val(p && n >= 11, tb_null);
 
     // comment
@@ -830,7 +1491,10 @@ tb_char_t const* tb_xml_reader_text(tb_xml_reader_ref_t reader)
 {
     // check
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
-    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT, tb_null);
+    tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_TEXT && impl->token, tb_null);
+
+    // copy the text from the window
+    if (impl->token != tb_string_cstr(&impl->text)) return tb_string_cstrncpy(&impl->text, impl->token, impl->token_size);
 
     // text
     return tb_string_cstr(&impl->text);
@@ -845,8 +1509,8 @@ tb_char_t const* tb_xml_reader_element(tb_xml_reader_ref_t reader)
 
     // init
     tb_char_t const* p = tb_null;
-    tb_char_t const* b = tb_string_cstr(&impl->element);
-    tb_char_t const* e = b + tb_string_size(&impl->element);
+    tb_char_t const* b = impl->token;
+    tb_char_t const* e = b + impl->token_size;
     tb_assert_and_check_return_val(b, tb_null);
 
     // </name> or <name ... />
@@ -862,6 +1526,9 @@ tb_char_t const* tb_xml_reader_doctype(tb_xml_reader_ref_t reader)
     tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
     tb_assert_and_check_return_val(impl && impl->event == TB_XML_READER_EVENT_DOCUMENT_TYPE, tb_null);
 
+    // copy the doctype from the window
+    if (impl->token != tb_string_cstr(&impl->element)) tb_string_cstrncpy(&impl->element, impl->token, impl->token_size);
+
     // doctype
     tb_char_t const* p = tb_string_cstr(&impl->element);
     tb_assert_and_check_return_val(p, tb_null);
@@ -879,8 +1546,9 @@ tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
                                             ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_null);
 
     // init
-    tb_char_t const* p = tb_string_cstr(&impl->element);
-    tb_char_t const* e = p + tb_string_size(&impl->element);
+    tb_char_t const* p = impl->token;
+    tb_char_t const* e = p + impl->token_size;
+    tb_assert_and_check_return_val(p, tb_null);
 
     // skip name
     while (p < e && *p && !tb_isspace(*p)) p++;
@@ -888,7 +1556,7 @@ tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
 
     // parse attributes
     tb_size_t n = 0;
-    while (p < e)
+    while (p < e && n < TB_XML_READER_ATTRIBUTES_MAXN)
     {
         // parse name
         tb_string_clear(&impl->attribute_name);
@@ -926,3 +1594,80 @@ tb_xml_node_ref_t tb_xml_reader_attributes(tb_xml_reader_ref_t reader)
     // ok?
     return n? (tb_xml_node_ref_t)&impl->attributes[0] : tb_null;
 }
+tb_bool_t tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && slice && impl->token && ( impl->event == TB_XML_READER_EVENT_ELEMENT_BEG
+                                                                ||  impl->event == TB_XML_READER_EVENT_ELEMENT_END
+                                                                ||  impl->event == TB_XML_READER_EVENT_ELEMENT_EMPTY), tb_false);
+
+    // init
+    tb_char_t const* p = tb_null;
+    tb_char_t const* b = impl->token;
+    tb_char_t const* e = b + impl->token_size;
+
+    // </name> or <name ... />
+    if (b < e && *b == '/') b++;
+    for (p = b; p < e && *p && !tb_isspace(*p) && *p != '/'; p++) ;
+    tb_check_return_val(p > b, tb_false);
+
+    // save the name
+    slice->data = b;
+    slice->size = p - b;
+    return tb_true;
+}
+tb_bool_t tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && slice && impl->token && impl->event == TB_XML_READER_EVENT_TEXT, tb_false);
+
+    // no entities? use the text data directly
+    tb_char_t const*    p = impl->token;
+    tb_size_t           n = impl->token_size;
+    if (tb_xml_reader_find(p, p + n, '&', '&', '&') == p + n)
+    {
+        slice->data = p;
+        slice->size = n;
+        return tb_true;
+    }
+
+    // make the decoded data
+    tb_char_t* data = (tb_char_t*)tb_buffer_resize(&impl->decoded, n);
+    tb_assert_and_check_return_val(data, tb_false);
+
+    // decode the entities
+    slice->data = data;
+    slice->size = tb_xml_reader_entity_decode(data, p, n);
+    return tb_true;
+}
+tb_bool_t tb_xml_reader_cdata_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && slice && impl->event == TB_XML_READER_EVENT_CDATA, tb_false);
+    tb_assert_and_check_return_val(impl->token && impl->token_size >= 11, tb_false);
+
+    // skip ![CDATA[ and ]]
+    slice->data = impl->token + 8;
+    slice->size = impl->token_size - 10;
+    return tb_true;
+}
+tb_bool_t tb_xml_reader_comment_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice)
+{
+    // check
+    tb_xml_reader_impl_t* impl = (tb_xml_reader_impl_t*)reader;
+    tb_assert_and_check_return_val(impl && slice && impl->event == TB_XML_READER_EVENT_COMMENT, tb_false);
+    tb_assert_and_check_return_val(impl->token && impl->token_size >= 6, tb_false);
+
+    // skip !-- and --
+    slice->data = impl->token + 3;
+    slice->size = impl->token_size - 5;
+    return tb_true;
+}
+tb_xml_attribute_slice_t const* tb_xml_reader_attribute_slices(tb_xml_reader_ref_t reader, tb_size_t* psize)
+{
+    // parse and decode attributes
+    return tb_xml_reader_attribute_parse((tb_xml_reader_impl_t*)reader, psize, tb_true);
+}
@@ -56,6 +56,40 @@ typedef enum __tb_xml_reader_event_t
 
 }tb_xml_reader_event_t;
 
+/// the xml reader mode enum
+typedef enum __tb_xml_reader_mode_e
+{
+    TB_XML_READER_MODE_STREAM                   = 0 //!< read characters from the stream one by one
+,   TB_XML_READER_MODE_BUFFER                   = 1 //!< tokenize the buffered data windows if the stream size is known, default
+
+}tb_xml_reader_mode_e;
+
+/*! the xml slice type
+ *
+ * it points into the input data or the decoded data of the reader 
+ * and it is valid until the next event, the data is not null-terminated
+ */
+typedef struct __tb_xml_slice_t
+{
+    /// the data
+    tb_char_t const*            data;
+
+    /// the size
+    tb_size_t                   size;
+
+}tb_xml_slice_t;
+
+/// the xml attribute slice type
+typedef struct __tb_xml_attribute_slice_t
+{
+    /// the name
+    tb_xml_slice_t              name;
+
+    /// the data
+    tb_xml_slice_t              data;
+
+}tb_xml_attribute_slice_t;
+
 /// the xml reader ref type
 typedef __tb_typeref__(xml_reader);
 
@@ -85,6 +119,15 @@ tb_void_t               tb_xml_reader_exit(tb_xml_reader_ref_t reader);
  */
 tb_bool_t               tb_xml_reader_open(tb_xml_reader_ref_t reader, tb_stream_ref_t stream, tb_bool_t bowner);
 
+/*! set the xml reader mode
+ *
+ * the buffer mode will fall back to the stream mode if the stream size is unknown
+ *
+ * @param reader        the xml reader
+ * @param mode          the reader mode
+ */
+tb_void_t               tb_xml_reader_mode_set(tb_xml_reader_ref_t reader, tb_size_t mode);
+
 /*! clos the xml reader
  *
  * @param reader        the xml reader
@@ -234,6 +277,18 @@ tb_bool_t               tb_xml_reader_goto(tb_xml_reader_ref_t reader, tb_char_t
  */
 tb_xml_node_ref_t       tb_xml_reader_load(tb_xml_reader_ref_t reader);
 
+/*! load the xml to the arena document
+ *
+ * all nodes and texts are allocated from the document arena and the names are interned,
+ * it is faster than tb_xml_reader_load() for the large document and tb_xml_node_exit(document) releases it at once
+ *
+ * @param reader        the xml reader
+ * @param bindex        index the child elements by names for tb_xml_node_goto()?
+ *
+ * @return              the xml document node
+ */
+tb_xml_node_ref_t       tb_xml_reader_load_arena(tb_xml_reader_ref_t reader, tb_bool_t bindex);
+
 /*! the xml version
  *
  * @param reader        the xml reader
@@ -290,6 +345,56 @@ tb_char_t const*        tb_xml_reader_doctype(tb_xml_reader_ref_t reader);
  */
 tb_xml_node_ref_t       tb_xml_reader_attributes(tb_xml_reader_ref_t reader);
 
+/*! the current xml element name slice
+ *
+ * @param reader        the xml reader
+ * @param slice         the element name slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_element_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice);
+
+/*! the current xml node text slice
+ *
+ * the predefined and numeric character entities will be decoded, 
+ * the text will be copied only if it has entities
+ *
+ * @param reader        the xml reader
+ * @param slice         the text slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_text_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice);
+
+/*! the current xml node cdata slice
+ *
+ * @param reader        the xml reader
+ * @param slice         the cdata slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_cdata_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice);
+
+/*! the current xml node comment slice
+ *
+ * @param reader        the xml reader
+ * @param slice         the comment slice
+ *
+ * @return              tb_true or tb_false
+ */
+tb_bool_t               tb_xml_reader_comment_slice(tb_xml_reader_ref_t reader, tb_xml_slice_t* slice);
+
+/*! the current xml node attribute slices
+ *
+ * the entities of the attribute values will be decoded
+ *
+ * @param reader        the xml reader
+ * @param psize         the attribute count
+ *
+ * @return              the attribute slices, tb_null if no attributes
+ */
+tb_xml_attribute_slice_t const* tb_xml_reader_attribute_slices(tb_xml_reader_ref_t reader, tb_size_t* psize);
+
 /* //////////////////////////////////////////////////////////////////////////////////////
  * extern
  */
@@ -0,0 +1,832 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        lz4.c
+ * @ingroup     zip
+ *
+ */
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * trace
+ */
+#define TB_TRACE_MODULE_NAME                "lz4"
+#define TB_TRACE_MODULE_DEBUG               (0)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "lz4.h"
+#include "../libc/libc.h"
+#include "../utils/utils.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the frame magic
+#define TB_ZIP_LZ4_MAGIC                    (0x184d2204)
+
+// the skippable frame magic: 0x184d2a50 - 0x184d2a5f
+#define TB_ZIP_LZ4_MAGIC_SKIP               (0x184d2a50)
+
+// the frame flags
+#define TB_ZIP_LZ4_FLAG_VERSION             (0x40)
+#define TB_ZIP_LZ4_FLAG_BLOCK_INDEP         (0x20)
+#define TB_ZIP_LZ4_FLAG_BLOCK_CHECKSUM      (0x10)
+#define TB_ZIP_LZ4_FLAG_CONTENT_SIZE        (0x08)
+#define TB_ZIP_LZ4_FLAG_CONTENT_CHECKSUM    (0x04)
+#define TB_ZIP_LZ4_FLAG_DICTID              (0x01)
+
+// the uncompressed block flag of the block size
+#define TB_ZIP_LZ4_BLOCK_RAW                (0x80000000)
+
+// the window size of the linked blocks
+#define TB_ZIP_LZ4_WINDOW                   (65536)
+
+// the minimum match size
+#define TB_ZIP_LZ4_MINMATCH                 (4)
+
+// the last bytes must be literals
+#define TB_ZIP_LZ4_LASTLITERALS             (5)
+
+// the last match must start before the end - mflimit
+#define TB_ZIP_LZ4_MFLIMIT                  (12)
+
+// search faster if no match is found for a long time 
+#define TB_ZIP_LZ4_SKIP_TRIGGER             (6)
+
+// the hash of the four bytes
+#define tb_zip_lz4_hash(p)                  ((tb_uint32_t)(tb_bits_get_u32_le(p) * 2654435761u) >> (32 - 13))
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the lz4 state type
+typedef enum __tb_zip_lz4_state_e
+{
+    TB_ZIP_LZ4_STATE_HEAD       = 0     //!< read the frame header
+,   TB_ZIP_LZ4_STATE_SIZE       = 1     //!< read the block size
+,   TB_ZIP_LZ4_STATE_DATA       = 2     //!< read the block data
+,   TB_ZIP_LZ4_STATE_SKIP_HEAD  = 3     //!< skip the data and read the next frame header
+,   TB_ZIP_LZ4_STATE_SKIP_SIZE  = 4     //!< skip the block checksum and read the next block size
+
+}tb_zip_lz4_state_e;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * block
+ */
+static __tb_inline__ tb_uint32_t tb_zip_lz4_xxh32(tb_byte_t const* data, tb_size_t size)
+{
+    // the xxhash32 with the zero seed for the small frame descriptor (< 16 bytes)
+    tb_uint32_t         h = 0x165667b1u + (tb_uint32_t)size;
+    tb_byte_t const*    e = data + size;
+    for (; data + 4 <= e; data += 4)
+    {
+        h += tb_bits_get_u32_le(data) * 0xc2b2ae3du;
+        h = ((h << 17) | (h >> 15)) * 0x27d4eb2fu;
+    }
+    for (; data < e; data++)
+    {
+        h += (*data) * 0x165667b1u;
+        h = ((h << 11) | (h >> 21)) * 0x9e3779b1u;
+    }
+    h ^= h >> 15;
+    h *= 0x85ebca77u;
+    h ^= h >> 13;
+    h *= 0xc2b2ae3du;
+    h ^= h >> 16;
+    return h;
+}
+static __tb_inline_force__ tb_void_t tb_zip_lz4_copy8(tb_byte_t* d, tb_byte_t const* s)
+{
+    tb_bits_set_u64_le(d, tb_bits_get_u64_le(s));
+}
+static __tb_inline__ tb_size_t tb_zip_lz4_count(tb_byte_t const* p, tb_byte_t const* m, tb_byte_t const* e)
+{
+    // compare eight bytes at once
+    tb_byte_t const* b = p;
+    while (p + 8 <= e)
+    {
+        tb_uint64_t diff = tb_bits_get_u64_le(p) ^ tb_bits_get_u64_le(m);
+        if (diff) return (p - b) + (tb_bits_cl0_u64_le(diff) >> 3);
+        p += 8;
+        m += 8;
+    }
+
+    // compare the left bytes
+    while (p < e && *p == *m) 
+    {
+        p++;
+        m++;
+    }
+    return p - b;
+}
+static __tb_inline__ tb_byte_t* tb_zip_lz4_put_length(tb_byte_t* op, tb_size_t length)
+{
+    for (; length >= 255; length -= 255) *op++ = 255;
+    *op++ = (tb_byte_t)length;
+    return op;
+}
+static tb_size_t tb_zip_lz4_block_compress(tb_uint16_t* table, tb_byte_t const* data, tb_size_t size, tb_byte_t* zdata, tb_size_t zmaxn)
+{
+    // check, the positions of the hash table are 16-bits
+    tb_assert_and_check_return_val(table && data && zdata && size <= TB_ZIP_LZ4_BLOCK_MAXN, 0);
+
+    // init
+    tb_byte_t const*    ip = data;
+    tb_byte_t const*    ie = data + size;
+    tb_byte_t const*    anchor = data;
+    tb_byte_t const*    mflimit = ie - TB_ZIP_LZ4_MFLIMIT;
+    tb_byte_t const*    mlimit = ie - TB_ZIP_LZ4_LASTLITERALS;
+    tb_byte_t*          op = zdata;
+    tb_byte_t*          oe = zdata + zmaxn;
+
+    // clear the hash table, the zero position is also a valid candidate
+    tb_memset(table, 0, TB_ZIP_LZ4_HASH_SIZE * sizeof(tb_uint16_t));
+
+    // compress the sequences
+    if (size > TB_ZIP_LZ4_MFLIMIT)
+    {
+        ip++;
+        tb_bool_t   end = tb_false;
+        tb_uint32_t h = tb_zip_lz4_hash(ip);
+        while (!end)
+        {
+            // find a match, skip faster if no match is found for a long time
+            tb_byte_t const*    match = tb_null;
+            tb_byte_t const*    next = ip;
+            tb_size_t           step = 1;
+            tb_size_t           search = 1 << TB_ZIP_LZ4_SKIP_TRIGGER;
+            do
+            {
+                ip = next;
+                next += step;
+                step = search++ >> TB_ZIP_LZ4_SKIP_TRIGGER;
+                if (next > mflimit) 
+                {
+                    end = tb_true;
+                    break;
+                }
+
+                match = data + table[h];
+                table[h] = (tb_uint16_t)(ip - data);
+                h = tb_zip_lz4_hash(next);
+
+            } while (tb_bits_get_u32_le(match) != tb_bits_get_u32_le(ip));
+            tb_check_break(!end);
+
+            // extend the match backward
+            while (ip > anchor && match > data && ip[-1] == match[-1]) 
+            {
+                ip--;
+                match--;
+            }
+
+            // no enough space?
+            tb_size_t   litn = ip - anchor;
+            tb_byte_t*  token = op++;
+            if (op + litn + (litn / 255) + 16 > oe) return 0;
+
+            // encode the literal length
+            if (litn >= 15)
+            {
+                *token = 15 << 4;
+                op = tb_zip_lz4_put_length(op, litn - 15);
+            }
+            else *token = (tb_byte_t)(litn << 4);
+
+            // copy the literals, it will not overflow because the literals are before mflimit
+            tb_byte_t* oend = op + litn;
+            for (; op < oend; op += 8, anchor += 8) tb_zip_lz4_copy8(op, anchor);
+            op = oend;
+
+            // encode the matches
+            while (1)
+            {
+                // encode the offset
+                tb_bits_set_u16_le(op, (tb_uint16_t)(ip - match));
+                op += 2;
+
+                // count the match length
+                tb_size_t matchn = tb_zip_lz4_count(ip + TB_ZIP_LZ4_MINMATCH, match + TB_ZIP_LZ4_MINMATCH, mlimit);
+                ip += matchn + TB_ZIP_LZ4_MINMATCH;
+
+                // no enough space?
+                if (op + (matchn / 255) + TB_ZIP_LZ4_LASTLITERALS + 2 > oe) return 0;
+
+                // encode the match length
+                if (matchn >= 15)
+                {
+                    *token += 15;
+                    op = tb_zip_lz4_put_length(op, matchn - 15);
+                }
+                else *token += (tb_byte_t)matchn;
+                anchor = ip;
+
+                // end?
+                if (ip > mflimit)
+                {
+                    end = tb_true;
+                    break;
+                }
+
+                // fill the hash table
+                table[tb_zip_lz4_hash(ip - 2)] = (tb_uint16_t)(ip - 2 - data);
+
+                // match the next position immediately?
+                h = tb_zip_lz4_hash(ip);
+                match = data + table[h];
+                table[h] = (tb_uint16_t)(ip - data);
+                tb_check_break(tb_bits_get_u32_le(match) == tb_bits_get_u32_le(ip));
+
+                // the next sequence without the literals
+                token = op++;
+                *token = 0;
+            }
+
+            // the next position
+            if (!end) 
+            {
+                ip++;
+                h = tb_zip_lz4_hash(ip);
+            }
+        }
+    }
+
+    // no enough space for the last literals?
+    tb_size_t litn = ie - anchor;
+    if (op + 1 + litn + (litn + 240) / 255 > oe) return 0;
+
+    // encode the last literals
+    if (litn >= 15)
+    {
+        *op++ = 15 << 4;
+        op = tb_zip_lz4_put_length(op, litn - 15);
+    }
+    else *op++ = (tb_byte_t)(litn << 4);
+    tb_memcpy(op, anchor, litn);
+    op += litn;
+
+    // ok
+    return op - zdata;
+}
+static tb_long_t tb_zip_lz4_block_decompress(tb_byte_t const* zdata, tb_size_t zsize, tb_byte_t* data, tb_size_t maxn, tb_size_t dictn)
+{
+    // init
+    tb_byte_t const*    ip = zdata;
+    tb_byte_t const*    ie = zdata + zsize;
+    tb_byte_t*          op = data;
+    tb_byte_t*          oe = data + maxn;
+    tb_byte_t const*    ob = data - dictn;
+
+    // decompress the sequences
+    while (ip < ie)
+    {
+        // the literal length
+        tb_size_t token = *ip++;
+        tb_size_t length = token >> 4;
+        if (length == 15)
+        {
+            tb_size_t n = 0;
+            do
+            {
+                tb_check_return_val(ip < ie, -1);
+                n = *ip++;
+                length += n;
+
+            } while (n == 255);
+        }
+        tb_check_return_val(length <= (tb_size_t)(ie - ip) && length <= (tb_size_t)(oe - op), -1);
+
+        // copy the literals
+        if (length + 8 <= (tb_size_t)(ie - ip) && length + 8 <= (tb_size_t)(oe - op))
+        {
+            tb_byte_t* e = op + length;
+            tb_byte_t const* p = ip;
+            for (; op < e; op += 8, p += 8) tb_zip_lz4_copy8(op, p);
+            op = e;
+        }
+        else
+        {
+            tb_memcpy(op, ip, length);
+            op += length;
+        }
+        ip += length;
+
+        // the last literals?
+        tb_check_break(ip < ie);
+
+        // the match offset
+        tb_check_return_val(ip + 2 <= ie, -1);
+        tb_size_t offset = tb_bits_get_u16_le(ip);
+        ip += 2;
+        tb_check_return_val(offset && offset <= (tb_size_t)(op - ob), -1);
+
+        // the match length
+        length = token & 15;
+        if (length == 15)
+        {
+            tb_size_t n = 0;
+            do
+            {
+                tb_check_return_val(ip < ie, -1);
+                n = *ip++;
+                length += n;
+
+            } while (n == 255);
+        }
+        length += TB_ZIP_LZ4_MINMATCH;
+        tb_check_return_val(length <= (tb_size_t)(oe - op), -1);
+
+        // copy the match
+        tb_byte_t const*    match = op - offset;
+        tb_byte_t*          e = op + length;
+        if (offset < 8)
+        {
+            /* the overlapped match with the small offset is periodic, 
+             * so we copy the first eight bytes one by one and use the multiple of the offset as the distance
+             */
+            if (length >= 8)
+            {
+                op[0] = match[0];
+                op[1] = match[1];
+                op[2] = match[2];
+                op[3] = match[3];
+                op[4] = match[4];
+                op[5] = match[5];
+                op[6] = match[6];
+                op[7] = match[7];
+                op += 8;
+                match = op - ((8 + offset - 1) / offset) * offset;
+            }
+            else while (op < e) *op++ = *match++;
+        }
+        if (e + 8 <= oe)
+        {
+            for (; op < e; op += 8, match += 8) tb_zip_lz4_copy8(op, match);
+        }
+        else
+        {
+            for (; op + 8 <= e; op += 8, match += 8) tb_zip_lz4_copy8(op, match);
+            while (op < e) *op++ = *match++;
+        }
+        op = e;
+    }
+
+    // ok
+    return op - data;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * implements
+ */
+static __tb_inline__ tb_zip_lz4_t* tb_zip_lz4_cast(tb_zip_ref_t zip)
+{
+    tb_assert_and_check_return_val(zip && zip->algo == TB_ZIP_ALGO_LZ4, tb_null);
+    return (tb_zip_lz4_t*)zip;
+}
+static tb_bool_t tb_zip_lz4_head_read(tb_zip_lz4_t* lz4, tb_static_stream_ref_t ist)
+{
+    // read the header data 
+    tb_size_t left = ist->p? ist->e - ist->p : 0;
+    tb_size_t size = tb_min(lz4->head_need - lz4->head_size, left);
+    if (size)
+    {
+        tb_memcpy(lz4->head + lz4->head_size, ist->p, size);
+        lz4->head_size += size;
+        ist->p += size;
+    }
+
+    // ok?
+    return lz4->head_size == lz4->head_need;
+}
+static tb_bool_t tb_zip_lz4_head_done(tb_zip_lz4_t* lz4)
+{
+    // check the version and the header checksum
+    tb_byte_t const* head = lz4->head;
+    tb_size_t flags = head[4];
+    tb_assert_and_check_return_val((flags & 0xc0) == TB_ZIP_LZ4_FLAG_VERSION, tb_false);
+    tb_assert_and_check_return_val(head[lz4->head_size - 1] == (tb_byte_t)(tb_zip_lz4_xxh32(head + 4, lz4->head_size - 5) >> 8), tb_false);
+
+    // the maximum block size: 64KB, 256KB, 1MB, 4MB
+    tb_size_t bd = (head[5] >> 4) & 0x7;
+    tb_assert_and_check_return_val(bd >= 4, tb_false);
+    tb_size_t block_maxn = 1 << (8 + (bd << 1));
+
+    // the window size, the previous 64KB data can be referenced by the linked blocks
+    tb_size_t omaxn = block_maxn;
+    if (!(flags & TB_ZIP_LZ4_FLAG_BLOCK_INDEP)) omaxn += TB_ZIP_LZ4_WINDOW;
+
+    // make the input data
+    if (lz4->imaxn < block_maxn)
+    {
+        lz4->idata = (tb_byte_t*)tb_ralloc(lz4->idata, block_maxn);
+        tb_assert_and_check_return_val(lz4->idata, tb_false);
+        lz4->imaxn = block_maxn;
+    }
+
+    // make the output data
+    if (lz4->omaxn < omaxn)
+    {
+        lz4->odata = (tb_byte_t*)tb_ralloc(lz4->odata, omaxn);
+        tb_assert_and_check_return_val(lz4->odata, tb_false);
+        lz4->omaxn = omaxn;
+    }
+
+    // init the frame
+    lz4->flags      = (tb_uint8_t)flags;
+    lz4->block_maxn = block_maxn;
+    lz4->opos       = 0;
+    lz4->osize      = 0;
+    return tb_true;
+}
+static tb_bool_t tb_zip_lz4_data_done(tb_zip_lz4_t* lz4, tb_byte_t const* data, tb_size_t size)
+{
+    // the independent blocks? 
+    tb_size_t dictn = 0;
+    if (lz4->flags & TB_ZIP_LZ4_FLAG_BLOCK_INDEP) lz4->osize = 0;
+    else
+    {
+        // keep the previous 64KB data as the dictionary if no enough space
+        if (lz4->osize + lz4->block_maxn > lz4->omaxn)
+        {
+            tb_size_t keep = tb_min(lz4->osize, TB_ZIP_LZ4_WINDOW);
+            tb_memmov(lz4->odata, lz4->odata + lz4->osize - keep, keep);
+            lz4->osize = keep;
+        }
+        dictn = lz4->osize;
+    }
+
+    // decompress it
+    tb_long_t real = -1;
+    if (lz4->braw)
+    {
+        tb_memcpy(lz4->odata + lz4->osize, data, size);
+        real = size;
+    }
+    else real = tb_zip_lz4_block_decompress(data, size, lz4->odata + lz4->osize, lz4->block_maxn, dictn);
+    tb_assertf_and_check_return_val(real >= 0, tb_false, "invalid lz4 block: %lu", size);
+    tb_trace_d("inflate: %lu => %ld, raw: %d", size, real, lz4->braw);
+
+    // save the pending data
+    lz4->opos = lz4->osize;
+    lz4->osize += real;
+    return tb_true;
+}
+static tb_long_t tb_zip_lz4_spak_inflate(tb_zip_ref_t zip, tb_static_stream_ref_t ist, tb_static_stream_ref_t ost, tb_long_t sync)
+{
+    // check
+    tb_zip_lz4_t* lz4 = tb_zip_lz4_cast(zip);
+    tb_assert_and_check_return_val(lz4 && ist && ost, -1);
+
+    // the output stream
+    tb_byte_t* op = ost->p;
+    tb_byte_t* oe = ost->e;
+    tb_assert_and_check_return_val(op && oe, -1);
+
+    // done
+    tb_bool_t ok = tb_true;
+    while (ok)
+    {
+        // flush the pending data
+        if (lz4->opos < lz4->osize)
+        {
+            tb_size_t size = tb_min(lz4->osize - lz4->opos, (tb_size_t)(oe - ost->p));
+            tb_memcpy(ost->p, lz4->odata + lz4->opos, size);
+            ost->p += size;
+            lz4->opos += size;
+            tb_check_break(lz4->opos == lz4->osize);
+        }
+
+        // no input data?
+        tb_size_t left = ist->p? ist->e - ist->p : 0;
+        tb_check_break(left);
+
+        // done
+        switch (lz4->state)
+        {
+        case TB_ZIP_LZ4_STATE_HEAD:
+            {
+                // start the next frame
+                lz4->bend = 0;
+
+                // read the header
+                tb_check_break(tb_zip_lz4_head_read(lz4, ist));
+
+                // the magic
+                tb_uint32_t magic = tb_bits_get_u32_le(lz4->head);
+                if (lz4->head_need == 4)
+                {
+                    // the lz4 frame or the skippable frame?
+                    if (magic == TB_ZIP_LZ4_MAGIC) lz4->head_need = 6;
+                    else if ((magic & 0xfffffff0) == TB_ZIP_LZ4_MAGIC_SKIP) lz4->head_need = 8;
+                    else 
+                    {
+                        tb_trace_e("invalid lz4 magic: %x", magic);
+                        ok = tb_false;
+                    }
+                }
+                // skip the skippable frame
+                else if (magic != TB_ZIP_LZ4_MAGIC)
+                {
+                    lz4->skip       = tb_bits_get_u32_le(lz4->head + 4);
+                    lz4->state      = TB_ZIP_LZ4_STATE_SKIP_HEAD;
+                    lz4->head_size  = 0;
+                    lz4->head_need  = 4;
+                }
+                // the full header size with the optional content size and dictionary id
+                else if (lz4->head_need == 6)
+                {
+                    lz4->head_need = 7;
+                    if (lz4->head[4] & TB_ZIP_LZ4_FLAG_CONTENT_SIZE) lz4->head_need += 8;
+                    if (lz4->head[4] & TB_ZIP_LZ4_FLAG_DICTID) lz4->head_need += 4;
+                }
+                // the header is finished
+                else
+                {
+                    ok = tb_zip_lz4_head_done(lz4);
+                    lz4->state      = TB_ZIP_LZ4_STATE_SIZE;
+                    lz4->head_size  = 0;
+                    lz4->head_need  = 4;
+                }
+            }
+            break;
+        case TB_ZIP_LZ4_STATE_SIZE:
+            {
+                // read the block size
+                tb_check_break(tb_zip_lz4_head_read(lz4, ist));
+                tb_uint32_t size = tb_bits_get_u32_le(lz4->head);
+                lz4->head_size = 0;
+
+                // the end of the frame?
+                if (!size)
+                {
+                    // skip the content checksum 
+                    lz4->bend = 1;
+                    lz4->skip = (lz4->flags & TB_ZIP_LZ4_FLAG_CONTENT_CHECKSUM)? 4 : 0;
+                    lz4->state = TB_ZIP_LZ4_STATE_SKIP_HEAD;
+                    break;
+                }
+
+                // the next block
+                lz4->braw       = (size & TB_ZIP_LZ4_BLOCK_RAW)? 1 : 0;
+                lz4->block_size = size & ~TB_ZIP_LZ4_BLOCK_RAW;
+                lz4->isize      = 0;
+                lz4->state      = TB_ZIP_LZ4_STATE_DATA;
+                if (!lz4->block_size) lz4->state = TB_ZIP_LZ4_STATE_SIZE;
+                else if (lz4->block_size > lz4->block_maxn)
+                {
+                    tb_trace_e("invalid lz4 block size: %lu", lz4->block_size);
+                    ok = tb_false;
+                }
+            }
+            break;
+        case TB_ZIP_LZ4_STATE_DATA:
+            {
+                // the block data
+                tb_byte_t const* data = tb_null;
+                if (!lz4->isize && left >= lz4->block_size)
+                {
+                    // using the input data directly
+                    data = ist->p;
+                    ist->p += lz4->block_size;
+                }
+                else
+                {
+                    // cache the input data
+                    tb_size_t size = tb_min(lz4->block_size - lz4->isize, left);
+                    tb_memcpy(lz4->idata + lz4->isize, ist->p, size);
+                    lz4->isize += size;
+                    ist->p += size;
+                    tb_check_break(lz4->isize == lz4->block_size);
+                    data = lz4->idata;
+                }
+
+                // decompress it
+                ok = tb_zip_lz4_data_done(lz4, data, lz4->block_size);
+
+                // skip the block checksum
+                lz4->skip = (lz4->flags & TB_ZIP_LZ4_FLAG_BLOCK_CHECKSUM)? 4 : 0;
+                lz4->state = TB_ZIP_LZ4_STATE_SKIP_SIZE;
+            }
+            break;
+        case TB_ZIP_LZ4_STATE_SKIP_HEAD:
+        case TB_ZIP_LZ4_STATE_SKIP_SIZE:
+            {
+                // skip data
+                tb_size_t size = tb_min(lz4->skip, left);
+                ist->p += size;
+                lz4->skip -= size;
+                tb_check_break(!lz4->skip);
+
+                // the next state
+                lz4->state      = lz4->state == TB_ZIP_LZ4_STATE_SKIP_HEAD? TB_ZIP_LZ4_STATE_HEAD : TB_ZIP_LZ4_STATE_SIZE;
+                lz4->head_size  = 0;
+                lz4->head_need  = 4;
+            }
+            break;
+        default:
+            ok = tb_false;
+            break;
+        }
+    }
+
+    // failed?
+    tb_check_return_val(ok, -1);
+
+    // end?
+    tb_long_t real = ost->p - op;
+    if (!real && sync < 0 && lz4->opos == lz4->osize && !(ist->p && ist->p < ist->e)) return -1;
+
+    // ok?
+    return real;
+}
+static tb_void_t tb_zip_lz4_deflate_block(tb_zip_lz4_t* lz4, tb_byte_t const* data, tb_size_t size)
+{
+    // compress it, store the raw data if it cannot be compressed 
+    tb_size_t real = tb_zip_lz4_block_compress(lz4->table, data, size, lz4->odata + 4, size);
+    if (real && real < size) tb_bits_set_u32_le(lz4->odata, (tb_uint32_t)real);
+    else
+    {
+        real = size;
+        tb_bits_set_u32_le(lz4->odata, (tb_uint32_t)size | TB_ZIP_LZ4_BLOCK_RAW);
+        tb_memcpy(lz4->odata + 4, data, size);
+    }
+    tb_trace_d("deflate: %lu => %lu", size, real);
+
+    // save the pending data
+    lz4->opos   = 0;
+    lz4->osize  = 4 + real;
+}
+static tb_long_t tb_zip_lz4_spak_deflate(tb_zip_ref_t zip, tb_static_stream_ref_t ist, tb_static_stream_ref_t ost, tb_long_t sync)
+{
+    // check
+    tb_zip_lz4_t* lz4 = tb_zip_lz4_cast(zip);
+    tb_assert_and_check_return_val(lz4 && ist && ost, -1);
+
+    // the output stream
+    tb_byte_t* op = ost->p;
+    tb_byte_t* oe = ost->e;
+    tb_assert_and_check_return_val(op && oe, -1);
+
+    // done
+    while (1)
+    {
+        // flush the pending data
+        if (lz4->opos < lz4->osize)
+        {
+            tb_size_t size = tb_min(lz4->osize - lz4->opos, (tb_size_t)(oe - ost->p));
+            tb_memcpy(ost->p, lz4->odata + lz4->opos, size);
+            ost->p += size;
+            lz4->opos += size;
+            tb_check_break(lz4->opos == lz4->osize);
+        }
+        lz4->opos   = 0;
+        lz4->osize  = 0;
+
+        // append the input data to the block
+        tb_size_t left = ist->p? ist->e - ist->p : 0;
+        if (left)
+        {
+            // compress the input data directly if it is enough for the whole block
+            if (!lz4->isize && left >= lz4->block_maxn)
+            {
+                tb_zip_lz4_deflate_block(lz4, ist->p, lz4->block_maxn);
+                ist->p += lz4->block_maxn;
+                continue;
+            }
+
+            // cache the input data
+            tb_size_t size = tb_min(lz4->block_maxn - lz4->isize, left);
+            tb_memcpy(lz4->idata + lz4->isize, ist->p, size);
+            lz4->isize += size;
+            ist->p += size;
+        }
+
+        // compress the full block or sync the partial block 
+        if (lz4->isize && (lz4->isize == lz4->block_maxn || sync))
+        {
+            tb_zip_lz4_deflate_block(lz4, lz4->idata, lz4->isize);
+            lz4->isize = 0;
+            continue;
+        }
+
+        // end? append the end mark
+        if (sync < 0 && !lz4->isize && !lz4->bend)
+        {
+            tb_bits_set_u32_le(lz4->odata, 0);
+            lz4->osize  = 4;
+            lz4->bend   = 1;
+            continue;
+        }
+        break;
+    }
+
+    // end?
+    tb_long_t real = ost->p - op;
+    if (!real && sync < 0 && lz4->bend && lz4->opos == lz4->osize) return -1;
+
+    // ok?
+    return real;
+}
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+tb_zip_ref_t tb_zip_lz4_init(tb_size_t action)
+{   
+    // done
+    tb_bool_t       ok = tb_false;
+    tb_zip_lz4_t*   zip = tb_null;
+    do
+    {
+        // make zip
+        zip = tb_malloc0_type(tb_zip_lz4_t);
+        tb_assert_and_check_break(zip);
+        
+        // init algo
+        zip->base.algo  = TB_ZIP_ALGO_LZ4;
+        zip->head_need  = 4;
+
+        // init action
+        if (action == TB_ZIP_ACTION_INFLATE)
+        {
+            // init spak
+            zip->base.spak = tb_zip_lz4_spak_inflate;
+        }
+        else if (action == TB_ZIP_ACTION_DEFLATE)
+        {
+            // init spak
+            zip->base.spak = tb_zip_lz4_spak_deflate;
+
+            // make data
+            zip->block_maxn = TB_ZIP_LZ4_BLOCK_MAXN;
+            zip->imaxn      = TB_ZIP_LZ4_BLOCK_MAXN;
+            zip->omaxn      = TB_ZIP_LZ4_BLOCK_MAXN + 8;
+            zip->idata      = tb_malloc_bytes(zip->imaxn);
+            zip->odata      = tb_malloc_bytes(zip->omaxn);
+            zip->table      = tb_nalloc_type(TB_ZIP_LZ4_HASH_SIZE, tb_uint16_t);
+            tb_assert_and_check_break(zip->idata && zip->odata && zip->table);
+
+            // make the frame header: magic, flags: version 1 and the independent blocks, block maxn: 64KB, header checksum
+            tb_byte_t* head = zip->odata;
+            tb_bits_set_u32_le(head, TB_ZIP_LZ4_MAGIC);
+            head[4] = TB_ZIP_LZ4_FLAG_VERSION | TB_ZIP_LZ4_FLAG_BLOCK_INDEP;
+            head[5] = 4 << 4;
+            head[6] = (tb_byte_t)(tb_zip_lz4_xxh32(head + 4, 2) >> 8);
+            zip->osize = 7;
+        }
+        else break;
+
+        // init action 
+        zip->base.action = (tb_uint16_t)action;
+
+        // ok
+        ok = tb_true;
+
+    } while (0);
+
+    // failed?
+    if (!ok)
+    {
+        // exit it
+        if (zip) tb_zip_lz4_exit((tb_zip_ref_t)zip);
+        zip = tb_null;
+    }
+
+    // ok?
+    return (tb_zip_ref_t)zip;
+}
+tb_void_t tb_zip_lz4_exit(tb_zip_ref_t zip)
+{
+    // check
+    tb_zip_lz4_t* lz4 = tb_zip_lz4_cast(zip);
+    tb_assert_and_check_return(lz4);
+
+    // exit data
+    if (lz4->idata) tb_free(lz4->idata);
+    if (lz4->odata) tb_free(lz4->odata);
+    if (lz4->table) tb_free(lz4->table);
+
+    // free it
+    tb_free(lz4);
+}
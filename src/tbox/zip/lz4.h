@@ -0,0 +1,143 @@
+/*!The Treasure Box Library
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * 
+ * Copyright (C) 2009 - 2018, TBOOX Open Source Group.
+ *
+ * @author      ruki
+ * @file        lz4.h
+ * @ingroup     zip
+ *
+ */
+#ifndef TB_ZIP_LZ4_H
+#define TB_ZIP_LZ4_H
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+#include "prefix.h"
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_enter__
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+// the maximum block size of the lz4 frame for deflating
+#define TB_ZIP_LZ4_BLOCK_MAXN           (65536)
+
+// the maximum compressed size of the lz4 block
+#define tb_zip_lz4_block_bound(size)    ((size) + ((size) / 255) + 16)
+
+// the hash table size for deflating
+#define TB_ZIP_LZ4_HASH_SIZE            (1 << 13)
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+// the lz4 zip type
+typedef struct __tb_zip_lz4_t
+{
+    // the zip base
+    tb_zip_t            base;
+
+    // the state
+    tb_uint8_t          state;
+
+    // the frame flags
+    tb_uint8_t          flags;
+
+    // the frame is finished?
+    tb_uint8_t          bend;
+
+    // the current block is uncompressed?
+    tb_uint8_t          braw;
+
+    // the header data
+    tb_byte_t           head[20];
+
+    // the header size
+    tb_size_t           head_size;
+
+    // the header need
+    tb_size_t           head_need;
+
+    // the maximum block size
+    tb_size_t           block_maxn;
+
+    // the current block size
+    tb_size_t           block_size;
+
+    // the skipped size
+    tb_size_t           skip;
+
+    // the input data, deflate: the raw block, inflate: the compressed block
+    tb_byte_t*          idata;
+
+    // the input size
+    tb_size_t           isize;
+
+    // the input maxn
+    tb_size_t           imaxn;
+
+    // the output data, deflate: the compressed block, inflate: the window with the history
+    tb_byte_t*          odata;
+
+    // the output maxn
+    tb_size_t           omaxn;
+
+    // the output position of the pending data
+    tb_size_t           opos;
+
+    // the output size of the pending data
+    tb_size_t           osize;
+
+    // the hash table for deflating
+    tb_uint16_t*        table;
+
+}tb_zip_lz4_t;
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * interfaces
+ */
+
+/* init lz4 
+ *
+ * the lz4 frame format is compatible with the lz4 command tool
+ *
+ * @param action    the action
+ *
+ * @return          the zip
+ */
+tb_zip_ref_t        tb_zip_lz4_init(tb_size_t action);
+
+/* exit lz4
+ *
+ * @param zip       the zip
+ */
+tb_void_t           tb_zip_lz4_exit(tb_zip_ref_t zip);
+
+/* //////////////////////////////////////////////////////////////////////////////////////
+ * extern
+ */
+__tb_extern_c_leave__
+
+#endif
@@ -52,6 +52,7 @@ typedef enum __tb_zip_algo_t
 ,   TB_ZIP_ALGO_ZLIBRAW     = 1     //!< zlib: raw inflate & deflate
 ,   TB_ZIP_ALGO_ZLIB        = 2     //!< zlib
 ,   TB_ZIP_ALGO_GZIP        = 3     //!< gnu zip
+,   TB_ZIP_ALGO_LZ4         = 4     //!< lz4 frame, fast and no dependence
 
 }tb_zip_algo_t;
 
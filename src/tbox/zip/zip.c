@@ -30,6 +30,7 @@
 #include "gzip.h"
 #include "zlib.h"
 #include "zlibraw.h"
+#include "lz4.h"
 
 /* //////////////////////////////////////////////////////////////////////////////////////
  * interfaces
@@ -50,6 +51,7 @@ tb_zip_ref_t tb_zip_init(tb_size_t algo, tb_size_t action)
     ,   tb_null
     ,   tb_null
 #endif
+    ,   tb_zip_lz4_init
     };
     tb_assert_and_check_return_val(algo < tb_arrayn(s_init) && s_init[algo], tb_null);
 
@@ -74,6 +76,7 @@ tb_void_t tb_zip_exit(tb_zip_ref_t zip)
     ,   tb_null
     ,   tb_null
 #endif
+    ,   tb_zip_lz4_exit
     };
     tb_assert_and_check_return(zip->algo < tb_arrayn(s_exit) && s_exit[zip->algo]);
 
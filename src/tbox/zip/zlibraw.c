@@ -66,7 +66,8 @@ static tb_long_t tb_zip_zlibraw_spak_deflate(tb_zip_ref_t zip, tb_static_stream_
 
     // deflate 
     tb_int_t r = deflate(&zlibraw->zstream, !sync? Z_NO_FLUSH : Z_SYNC_FLUSH);
-    tb_assertf_and_check_return_val(r == Z_OK || r == Z_STREAM_END, -1, "sync: %ld, error: %d", sync, r);
+    // @note Z_BUF_ERROR is not fatal, it means that no progress was possible, e.g. flush it again without the input data
+    tb_assertf_and_check_return_val(r == Z_OK || r == Z_STREAM_END || r == Z_BUF_ERROR, -1, "sync: %ld, error: %d", sync, r);
     tb_trace_d("deflate: %u => %u, sync: %ld", ie - ip, (tb_byte_t*)zlibraw->zstream.next_out - op, sync);
 
     // update 
@@ -62,6 +62,14 @@ option("exception")
     set_description("Enable or disable the exception.")
     add_defines_h("$(prefix)_EXCEPTION_ENABLE")
 
+-- option: lock_profiler
+option("lock_profiler")
+    set_default(false)
+    set_showmenu(true)
+    set_category("option")
+    set_description("Enable or disable the lock profiler for the release mode.")
+    add_defines_h("$(prefix)_LOCK_PROFILER_ENABLE")
+
 -- option: deprecated
 option("deprecated")
     set_default(false)
@@ -202,6 +210,7 @@ function check_interfaces()
     add_cfuncs("posix", nil,        "unistd.h",                         "fdatasync")
     add_cfuncs("posix", nil,        "copyfile.h",                       "copyfile")
     add_cfuncs("posix", nil,        "sys/sendfile.h",                   "sendfile")
+    add_cfuncs("posix", nil,        "sys/mman.h",                       "mmap", "madvise")
     add_cfuncs("posix", nil,        "sys/epoll.h",                      "epoll_create", "epoll_wait")
     add_cfuncs("posix", nil,        "spawn.h",                          "posix_spawnp")
     add_cfuncs("posix", nil,        "unistd.h",                         "execvp", "execvpe", "fork", "vfork")
@@ -210,6 +219,9 @@ function check_interfaces()
     add_cfuncs("posix", nil,        "sys/resource.h",                   "getrlimit")
     add_cfuncs("posix", nil,        "netdb.h",                          "getaddrinfo", "getnameinfo", "gethostbyname", "gethostbyaddr")
 
+    -- add the interfaces for linux
+    add_cfuncs("linux", nil,        {"unistd.h", "sys/syscall.h", "linux/io_uring.h"}, "io_uring_setup{syscall(__NR_io_uring_setup, 0, (void*)0); (void)IORING_ENTER_EXT_ARG;}")
+
     -- add the interfaces for systemv
     add_cfuncs("systemv", nil,      {"sys/sem.h", "sys/ipc.h"},         "semget", "semtimedop")
 